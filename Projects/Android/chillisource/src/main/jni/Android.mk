@@ -34,6 +34,7 @@ include $(CS_PROJECT_ROOT)/ChilliSource/Tools/Scripts/AndroidBuildConfig.mk
 CS_SOURCEFILES_CHILLISOURCE := $(shell 'python' '$(CS_SCRIPT_GETFILESWITHEXTENSIONS)' '--directory' '$(CS_PROJECT_ROOT)/ChilliSource/Source/ChilliSource/' '--extensions' 'cpp,c,cc')
 CS_SOURCEFILES_PLATFORM := $(shell 'python' '$(CS_SCRIPT_GETFILESWITHEXTENSIONS)' '--directory' '$(CS_PROJECT_ROOT)/ChilliSource/Source/CSBackend/Platform/Android/Main/JNI/' '--extensions' 'cpp,c,cc')
 CS_SOURCEFILES_RENDERING := $(shell 'python' '$(CS_SCRIPT_GETFILESWITHEXTENSIONS)' '--directory' '$(CS_PROJECT_ROOT)/ChilliSource/Source/CSBackend/Rendering/OpenGL/' '--extensions' 'cpp,c,cc')
+CS_SOURCEFILES_NETWORKING := $(shell 'python' '$(CS_SCRIPT_GETFILESWITHEXTENSIONS)' '--directory' '$(CS_PROJECT_ROOT)/ChilliSource/Source/CSBackend/Networking/POSIX/' '--extensions' 'cpp,c,cc')
 
 #add files for appropriate android skus
 ifeq ($(CS_FLAVOUR_SKU), googleplay)
@@ -46,7 +47,7 @@ endif
 include $(CLEAR_VARS)
 LOCAL_MODULE := ChilliSource
 LOCAL_CXXFLAGS := $(CS_CXXFLAGS)
-LOCAL_SRC_FILES := $(CS_SOURCEFILES_CHILLISOURCE) $(CS_SOURCEFILES_PLATFORM) $(CS_SOURCEFILES_RENDERING)
+LOCAL_SRC_FILES := $(CS_SOURCEFILES_CHILLISOURCE) $(CS_SOURCEFILES_PLATFORM) $(CS_SOURCEFILES_RENDERING) $(CS_SOURCEFILES_NETWORKING)
 LOCAL_C_INCLUDES := $(CS_C_INCLUDES)
 LOCAL_SHORT_COMMANDS := true
 include $(BUILD_STATIC_LIBRARY)
\ No newline at end of file
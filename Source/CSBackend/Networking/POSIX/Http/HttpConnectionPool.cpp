@@ -0,0 +1,304 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifdef CS_ENABLE_POSIXHTTP
+
+#include <CSBackend/Networking/POSIX/Http/HttpConnectionPool.h>
+
+#include <ChilliSource/Core/String/ToString.h>
+
+#include <algorithm>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace CSBackend
+{
+    namespace POSIX
+    {
+        namespace
+        {
+            /// The interval at which blocking socket operations check for cancellation.
+            ///
+            const s32 k_pollIntervalMS = 100;
+
+            /// Applies the options required of every connection: non-blocking IO, no Nagle
+            /// delay, and on platforms without MSG_NOSIGNAL, no SIGPIPE on writing to a closed
+            /// connection.
+            ///
+            /// @param in_socket
+            ///     The socket.
+            ///
+            /// @return Whether the options were applied.
+            ///
+            bool ConfigureSocket(s32 in_socket)
+            {
+                s32 flags = fcntl(in_socket, F_GETFL, 0);
+                if (flags == -1 || fcntl(in_socket, F_SETFL, flags | O_NONBLOCK) == -1)
+                {
+                    return false;
+                }
+
+                s32 enabled = 1;
+                setsockopt(in_socket, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+#ifdef SO_NOSIGPIPE
+                setsockopt(in_socket, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+#endif
+                return true;
+            }
+        }
+
+        //------------------------------------------------------------------------------
+        HttpConnectionPool::HttpConnectionPool(u32 in_maxIdlePerHost, u32 in_idleTimeoutSecs)
+            : m_maxIdlePerHost(in_maxIdlePerHost), m_idleTimeout(std::chrono::seconds(in_idleTimeoutSecs))
+        {
+        }
+
+        //------------------------------------------------------------------------------
+        HttpConnectionPool::Result HttpConnectionPool::Acquire(const std::string& in_host, u16 in_port, u32 in_timeoutSecs, const std::atomic<bool>& in_isCancelled, s32& out_socket, bool& out_isReused)
+        {
+            auto key = CreateKey(in_host, in_port);
+            auto now = Clock::now();
+
+            std::vector<s32> staleSockets;
+            out_socket = -1;
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            auto it = m_idleConnections.find(key);
+            if (it != m_idleConnections.end())
+            {
+                //the most recently released connections are at the back and are the least likely to have been closed by the server.
+                auto& idleConnections = it->second;
+                while (idleConnections.empty() == false && out_socket == -1)
+                {
+                    auto connection = idleConnections.back();
+                    idleConnections.pop_back();
+
+                    if (now - connection.m_releaseTime < m_idleTimeout && IsAlive(connection.m_socket) == true)
+                    {
+                        out_socket = connection.m_socket;
+                    }
+                    else
+                    {
+                        staleSockets.push_back(connection.m_socket);
+                    }
+                }
+            }
+            lock.unlock();
+
+            for (auto socket : staleSockets)
+            {
+                Close(socket);
+            }
+
+            if (out_socket != -1)
+            {
+                out_isReused = true;
+                return Result::k_success;
+            }
+
+            out_isReused = false;
+            return Connect(in_host, in_port, in_timeoutSecs, in_isCancelled, out_socket);
+        }
+
+        //------------------------------------------------------------------------------
+        void HttpConnectionPool::Release(const std::string& in_host, u16 in_port, s32 in_socket)
+        {
+            auto key = CreateKey(in_host, in_port);
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            auto& idleConnections = m_idleConnections[key];
+            if (idleConnections.size() < m_maxIdlePerHost)
+            {
+                idleConnections.push_back(IdleConnection { in_socket, Clock::now() });
+                return;
+            }
+            lock.unlock();
+
+            Close(in_socket);
+        }
+
+        //------------------------------------------------------------------------------
+        void HttpConnectionPool::Close(s32 in_socket)
+        {
+            CS_ASSERT(in_socket != -1, "Cannot close an invalid socket.");
+
+            ::close(in_socket);
+        }
+
+        //------------------------------------------------------------------------------
+        void HttpConnectionPool::CloseAll()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            auto idleConnections = std::move(m_idleConnections);
+            m_idleConnections.clear();
+            lock.unlock();
+
+            for (const auto& hostConnections : idleConnections)
+            {
+                for (const auto& connection : hostConnections.second)
+                {
+                    Close(connection.m_socket);
+                }
+            }
+        }
+
+        //------------------------------------------------------------------------------
+        std::string HttpConnectionPool::CreateKey(const std::string& in_host, u16 in_port)
+        {
+            return in_host + ":" + ChilliSource::ToString(u32(in_port));
+        }
+
+        //------------------------------------------------------------------------------
+        bool HttpConnectionPool::IsAlive(s32 in_socket)
+        {
+            //An idle connection should have nothing to read. If it is readable then the server has either closed it, or
+            //sent something unsolicited; neither of which can be recovered from.
+            pollfd descriptor { in_socket, POLLIN, 0 };
+            s32 result = poll(&descriptor, 1, 0);
+            if (result == 0)
+            {
+                return true;
+            }
+
+            if (result > 0 && (descriptor.revents & (POLLERR | POLLHUP | POLLNVAL)) == 0)
+            {
+                u8 byte;
+                ssize_t peeked = recv(in_socket, &byte, 1, MSG_PEEK);
+                return peeked < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+            }
+
+            return false;
+        }
+
+        //------------------------------------------------------------------------------
+        HttpConnectionPool::Result HttpConnectionPool::Connect(const std::string& in_host, u16 in_port, u32 in_timeoutSecs, const std::atomic<bool>& in_isCancelled, s32& out_socket)
+        {
+            addrinfo hints {};
+            hints.ai_family = AF_UNSPEC;
+            hints.ai_socktype = SOCK_STREAM;
+            hints.ai_protocol = IPPROTO_TCP;
+
+            addrinfo* addresses = nullptr;
+            auto port = ChilliSource::ToString(u32(in_port));
+            if (getaddrinfo(in_host.c_str(), port.c_str(), &hints, &addresses) != 0 || addresses == nullptr)
+            {
+                CS_LOG_ERROR("Http: Could not resolve host '" + in_host + "'.");
+                return Result::k_failed;
+            }
+
+            auto deadline = Clock::now() + std::chrono::seconds(in_timeoutSecs);
+            auto result = Result::k_failed;
+
+            for (auto address = addresses; address != nullptr && result == Result::k_failed; address = address->ai_next)
+            {
+                s32 socket = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+                if (socket == -1)
+                {
+                    continue;
+                }
+
+                if (ConfigureSocket(socket) == false)
+                {
+                    ::close(socket);
+                    continue;
+                }
+
+                if (connect(socket, address->ai_addr, address->ai_addrlen) == 0)
+                {
+                    out_socket = socket;
+                    result = Result::k_success;
+                    break;
+                }
+
+                if (errno != EINPROGRESS)
+                {
+                    ::close(socket);
+                    continue;
+                }
+
+                //Wait in short slices so that cancellation is noticed promptly.
+                while (true)
+                {
+                    if (in_isCancelled == true)
+                    {
+                        result = Result::k_cancelled;
+                        break;
+                    }
+
+                    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+                    if (remaining <= 0)
+                    {
+                        result = Result::k_timeout;
+                        break;
+                    }
+
+                    pollfd descriptor { socket, POLLOUT, 0 };
+                    s32 ready = poll(&descriptor, 1, s32(std::min<decltype(remaining)>(remaining, k_pollIntervalMS)));
+                    if (ready == 0 || (ready < 0 && errno == EINTR))
+                    {
+                        continue;
+                    }
+
+                    s32 error = 0;
+                    socklen_t errorSize = sizeof(error);
+                    if (ready > 0 && getsockopt(socket, SOL_SOCKET, SO_ERROR, &error, &errorSize) == 0 && error == 0)
+                    {
+                        out_socket = socket;
+                        result = Result::k_success;
+                    }
+                    break;
+                }
+
+                if (result != Result::k_success)
+                {
+                    ::close(socket);
+                }
+            }
+
+            freeaddrinfo(addresses);
+
+            if (result == Result::k_failed)
+            {
+                CS_LOG_ERROR("Http: Could not connect to '" + in_host + ":" + port + "'.");
+            }
+
+            return result;
+        }
+
+        //------------------------------------------------------------------------------
+        HttpConnectionPool::~HttpConnectionPool()
+        {
+            CloseAll();
+        }
+    }
+}
+
+#endif
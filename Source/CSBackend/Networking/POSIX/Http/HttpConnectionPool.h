@@ -0,0 +1,178 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifdef CS_ENABLE_POSIXHTTP
+
+#ifndef _CSBACKEND_NETWORKING_POSIX_HTTP_HTTPCONNECTIONPOOL_H_
+#define _CSBACKEND_NETWORKING_POSIX_HTTP_HTTPCONNECTIONPOOL_H_
+
+#include <ChilliSource/ChilliSource.h>
+
+#include <CSBackend/Networking/POSIX/ForwardDeclarations.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CSBackend
+{
+    namespace POSIX
+    {
+        /// A thread safe pool of keep-alive TCP connections, keyed by host and port. Sockets
+        /// are opened on demand and handed back once a response has been fully read, so that
+        /// subsequent requests to the same host can skip DNS resolution and the TCP handshake.
+        ///
+        /// Only a small number of idle sockets are kept per host and any that have been idle
+        /// for longer than the idle timeout, or that the server has since closed, are discarded
+        /// rather than reused.
+        ///
+        class HttpConnectionPool final
+        {
+        public:
+            CS_DECLARE_NOCOPY(HttpConnectionPool);
+
+            /// The result of trying to acquire a connection.
+            ///
+            enum class Result
+            {
+                k_success,
+                k_failed,
+                k_timeout,
+                k_cancelled
+            };
+
+            /// @param in_maxIdlePerHost
+            ///     The maximum number of idle connections kept open per host.
+            /// @param in_idleTimeoutSecs
+            ///     The time after which an idle connection will no longer be reused.
+            ///
+            HttpConnectionPool(u32 in_maxIdlePerHost, u32 in_idleTimeoutSecs);
+
+            /// Returns an open connection to the given host. A pooled idle connection is
+            /// preferred, otherwise a new one is opened. This blocks while connecting so
+            /// should only be called from a background thread.
+            ///
+            /// @param in_host
+            ///     The host name or address.
+            /// @param in_port
+            ///     The port.
+            /// @param in_timeoutSecs
+            ///     The time to wait for a new connection to be established.
+            /// @param in_isCancelled
+            ///     Polled while connecting. The connection attempt is abandoned when this is set.
+            /// @param out_socket
+            ///     The connected socket, if successful.
+            /// @param out_isReused
+            ///     Whether the socket came from the pool.
+            ///
+            /// @return The result of the attempt.
+            ///
+            Result Acquire(const std::string& in_host, u16 in_port, u32 in_timeoutSecs, const std::atomic<bool>& in_isCancelled, s32& out_socket, bool& out_isReused);
+
+            /// Hands a connection back to the pool for reuse. This should only be called once
+            /// the response on the connection has been read in full and the server has not asked
+            /// for the connection to be closed. If the pool for the host is full the connection
+            /// is closed instead.
+            ///
+            /// @param in_host
+            ///     The host name or address the connection was acquired for.
+            /// @param in_port
+            ///     The port the connection was acquired for.
+            /// @param in_socket
+            ///     The socket.
+            ///
+            void Release(const std::string& in_host, u16 in_port, s32 in_socket);
+
+            /// Closes a connection that can't be reused.
+            ///
+            /// @param in_socket
+            ///     The socket.
+            ///
+            void Close(s32 in_socket);
+
+            /// Closes all idle connections.
+            ///
+            void CloseAll();
+
+            ~HttpConnectionPool();
+
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            /// An idle connection and the time it was returned to the pool.
+            ///
+            struct IdleConnection
+            {
+                s32 m_socket;
+                Clock::time_point m_releaseTime;
+            };
+
+            /// @param in_host
+            ///     The host name or address.
+            /// @param in_port
+            ///     The port.
+            ///
+            /// @return The pool key for the given host and port.
+            ///
+            static std::string CreateKey(const std::string& in_host, u16 in_port);
+
+            /// @param in_socket
+            ///     The socket.
+            ///
+            /// @return Whether the idle socket is still open and has no unexpected data waiting.
+            ///
+            static bool IsAlive(s32 in_socket);
+
+            /// Resolves the host and opens a new connection to it.
+            ///
+            /// @param in_host
+            ///     The host name or address.
+            /// @param in_port
+            ///     The port.
+            /// @param in_timeoutSecs
+            ///     The time to wait for the connection to be established.
+            /// @param in_isCancelled
+            ///     Polled while connecting.
+            /// @param out_socket
+            ///     The connected socket, if successful.
+            ///
+            /// @return The result of the attempt.
+            ///
+            static Result Connect(const std::string& in_host, u16 in_port, u32 in_timeoutSecs, const std::atomic<bool>& in_isCancelled, s32& out_socket);
+
+            const u32 m_maxIdlePerHost;
+            const Clock::duration m_idleTimeout;
+
+            std::mutex m_mutex;
+            std::unordered_map<std::string, std::vector<IdleConnection>> m_idleConnections;
+        };
+    }
+}
+
+#endif
+
+#endif
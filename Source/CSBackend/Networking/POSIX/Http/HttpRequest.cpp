@@ -0,0 +1,889 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifdef CS_ENABLE_POSIXHTTP
+
+#include <CSBackend/Networking/POSIX/Http/HttpRequest.h>
+
+#include <CSBackend/Networking/POSIX/Http/HttpConnectionPool.h>
+
+#include <ChilliSource/Core/String/StringUtils.h>
+#include <ChilliSource/Core/String/ToString.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <unordered_map>
+
+#include <poll.h>
+#include <sys/socket.h>
+
+namespace CSBackend
+{
+    namespace POSIX
+    {
+        namespace
+        {
+            using Clock = std::chrono::steady_clock;
+
+            const u32 k_readBufferSize = 1024 * 16;
+            const u32 k_maxRedirects = 5;
+            const u32 k_maxHeaderLineLength = 1024 * 16;
+            const s32 k_pollIntervalMS = 100;
+
+#ifdef MSG_NOSIGNAL
+            const s32 k_sendFlags = MSG_NOSIGNAL;
+#else
+            const s32 k_sendFlags = 0;
+#endif
+
+            /// The parts of a url required to make a request.
+            ///
+            struct Url
+            {
+                std::string m_host;
+                u16 m_port = 80;
+                std::string m_path;
+            };
+
+            /// The outcome of a socket operation.
+            ///
+            enum class IOResult
+            {
+                k_success,
+                k_closed,
+                k_failed,
+                k_timeout,
+                k_cancelled
+            };
+
+            const std::string k_supportedScheme = "http://";
+
+            /// Only plain http urls are supported as there is no TLS implementation available to
+            /// this backend.
+            ///
+            /// @param in_url
+            ///     The url.
+            ///
+            /// @return Whether the url has a scheme this backend can request.
+            ///
+            bool IsSupportedScheme(const std::string& in_url)
+            {
+                return ChilliSource::StringUtils::StartsWith(in_url, k_supportedScheme, true);
+            }
+
+            /// Splits a http url into its host, port and path.
+            ///
+            /// @param in_url
+            ///     The url. This must have a supported scheme.
+            /// @param out_url
+            ///     The parsed url.
+            ///
+            /// @return Whether the url could be parsed.
+            ///
+            bool ParseUrl(const std::string& in_url, Url& out_url)
+            {
+                CS_ASSERT(IsSupportedScheme(in_url) == true, "Cannot parse a url with an unsupported scheme.");
+
+                auto authorityStart = k_supportedScheme.length();
+                auto pathStart = in_url.find_first_of("/?#", authorityStart);
+                auto authority = in_url.substr(authorityStart, pathStart == std::string::npos ? std::string::npos : pathStart - authorityStart);
+                out_url.m_path = (pathStart == std::string::npos) ? "/" : in_url.substr(pathStart, in_url.find('#', pathStart) - pathStart);
+                if (out_url.m_path.empty() || out_url.m_path[0] != '/')
+                {
+                    out_url.m_path = "/" + out_url.m_path;
+                }
+
+                //Drop any user info, then split off the port, allowing for bracketed IPv6 literals.
+                auto userInfoEnd = authority.rfind('@');
+                if (userInfoEnd != std::string::npos)
+                {
+                    authority = authority.substr(userInfoEnd + 1);
+                }
+
+                auto portStart = std::string::npos;
+                if (authority.empty() == false && authority[0] == '[')
+                {
+                    auto hostEnd = authority.find(']');
+                    if (hostEnd == std::string::npos)
+                    {
+                        CS_LOG_ERROR("Http: Malformed url '" + in_url + "'.");
+                        return false;
+                    }
+
+                    out_url.m_host = authority.substr(1, hostEnd - 1);
+                    if (hostEnd + 1 < authority.length() && authority[hostEnd + 1] == ':')
+                    {
+                        portStart = hostEnd + 2;
+                    }
+                }
+                else
+                {
+                    auto colon = authority.find(':');
+                    out_url.m_host = authority.substr(0, colon);
+                    if (colon != std::string::npos)
+                    {
+                        portStart = colon + 1;
+                    }
+                }
+
+                if (portStart != std::string::npos && portStart < authority.length())
+                {
+                    auto port = std::strtoul(authority.c_str() + portStart, nullptr, 10);
+                    if (port == 0 || port > 65535)
+                    {
+                        CS_LOG_ERROR("Http: Malformed url '" + in_url + "'.");
+                        return false;
+                    }
+                    out_url.m_port = u16(port);
+                }
+
+                if (out_url.m_host.empty() == true)
+                {
+                    CS_LOG_ERROR("Http: Malformed url '" + in_url + "'.");
+                    return false;
+                }
+
+                return true;
+            }
+
+            /// Resolves a redirect location against the url that was redirected.
+            ///
+            /// @param in_baseUrl
+            ///     The url that was redirected.
+            /// @param in_location
+            ///     The value of the Location header.
+            ///
+            /// @return The absolute url to redirect to.
+            ///
+            std::string ResolveRedirect(const std::string& in_baseUrl, const std::string& in_location)
+            {
+                if (in_location.find("://") != std::string::npos)
+                {
+                    return in_location;
+                }
+
+                auto authorityStart = in_baseUrl.find("://") + 3;
+                auto pathStart = in_baseUrl.find_first_of("/?#", authorityStart);
+                auto origin = in_baseUrl.substr(0, pathStart);
+
+                if (ChilliSource::StringUtils::StartsWith(in_location, "//", false) == true)
+                {
+                    return in_baseUrl.substr(0, authorityStart - 2) + in_location;
+                }
+
+                if (in_location.empty() == false && in_location[0] == '/')
+                {
+                    return origin + in_location;
+                }
+
+                //Relative to the directory of the current path
+                auto path = (pathStart == std::string::npos) ? std::string("/") : in_baseUrl.substr(pathStart, in_baseUrl.find_first_of("?#", pathStart) - pathStart);
+                return origin + path.substr(0, path.rfind('/') + 1) + in_location;
+            }
+
+            /// Buffered, non-blocking IO on a connected socket. Every wait is bounded by the
+            /// inactivity timeout and is done in short slices so that cancellation is noticed
+            /// promptly.
+            ///
+            class SocketStream final
+            {
+            public:
+                /// @param in_socket
+                ///     The connected socket.
+                /// @param in_timeoutSecs
+                ///     The time without progress after which an operation times out.
+                /// @param in_isCancelled
+                ///     Polled while waiting.
+                ///
+                SocketStream(s32 in_socket, u32 in_timeoutSecs, const std::atomic<bool>& in_isCancelled)
+                    : m_socket(in_socket), m_timeout(std::chrono::seconds(in_timeoutSecs)), m_isCancelled(in_isCancelled)
+                {
+                }
+
+                /// Writes all of the given data.
+                ///
+                /// @param in_data
+                ///     The data.
+                ///
+                /// @return The result.
+                ///
+                IOResult Write(const std::string& in_data)
+                {
+                    u64 offset = 0;
+                    while (offset < in_data.length())
+                    {
+                        ssize_t sent = send(m_socket, in_data.data() + offset, in_data.length() - offset, k_sendFlags);
+                        if (sent > 0)
+                        {
+                            offset += u64(sent);
+                            m_bytesSent += u64(sent);
+                            continue;
+                        }
+
+                        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+                        {
+                            auto result = Wait(POLLOUT);
+                            if (result != IOResult::k_success)
+                            {
+                                return result;
+                            }
+                            continue;
+                        }
+
+                        return IOResult::k_failed;
+                    }
+
+                    return IOResult::k_success;
+                }
+
+                /// Reads a CRLF or LF terminated line, without its terminator.
+                ///
+                /// @param out_line
+                ///     The line.
+                ///
+                /// @return The result. Reaching the end of the stream before the end of the line
+                ///     is k_closed.
+                ///
+                IOResult ReadLine(std::string& out_line)
+                {
+                    while (true)
+                    {
+                        auto lineEnd = m_buffer.find('\n', m_readOffset);
+                        if (lineEnd != std::string::npos)
+                        {
+                            auto length = lineEnd - m_readOffset;
+                            if (length > 0 && m_buffer[lineEnd - 1] == '\r')
+                            {
+                                --length;
+                            }
+                            out_line.assign(m_buffer, m_readOffset, length);
+                            m_readOffset = lineEnd + 1;
+                            return IOResult::k_success;
+                        }
+
+                        if (m_buffer.length() - m_readOffset > k_maxHeaderLineLength)
+                        {
+                            return IOResult::k_failed;
+                        }
+
+                        auto result = Fill();
+                        if (result != IOResult::k_success)
+                        {
+                            return result;
+                        }
+                    }
+                }
+
+                /// Reads whatever data is available, up to the given size, waiting if there is none.
+                ///
+                /// @param in_maxSize
+                ///     The maximum number of bytes to read.
+                /// @param out_data
+                ///     The start of the data read. This is valid until the next read.
+                /// @param out_size
+                ///     The number of bytes read.
+                ///
+                /// @return The result. Reaching the end of the stream is k_closed.
+                ///
+                IOResult Read(u64 in_maxSize, const s8*& out_data, u64& out_size)
+                {
+                    if (m_readOffset == m_buffer.length())
+                    {
+                        auto result = Fill();
+                        if (result != IOResult::k_success)
+                        {
+                            return result;
+                        }
+                    }
+
+                    out_size = std::min<u64>(in_maxSize, m_buffer.length() - m_readOffset);
+                    out_data = reinterpret_cast<const s8*>(m_buffer.data()) + m_readOffset;
+                    m_readOffset += out_size;
+                    return IOResult::k_success;
+                }
+
+                /// @return The total number of bytes sent.
+                ///
+                u64 GetBytesSent() const
+                {
+                    return m_bytesSent;
+                }
+
+                /// @return The total number of bytes received.
+                ///
+                u64 GetBytesReceived() const
+                {
+                    return m_bytesReceived;
+                }
+
+                /// @return Whether there is data that has been received but not yet read. Data
+                ///     left over after a response means the connection can't be reused.
+                ///
+                bool HasUnreadData() const
+                {
+                    return m_readOffset < m_buffer.length();
+                }
+
+            private:
+                /// Receives the next block of data into the buffer, discarding any data that
+                /// has already been read.
+                ///
+                /// @return The result.
+                ///
+                IOResult Fill()
+                {
+                    m_buffer.erase(0, m_readOffset);
+                    m_readOffset = 0;
+
+                    s8 readBuffer[k_readBufferSize];
+                    while (true)
+                    {
+                        ssize_t received = recv(m_socket, readBuffer, k_readBufferSize, 0);
+                        if (received > 0)
+                        {
+                            m_buffer.append(reinterpret_cast<const char*>(readBuffer), size_t(received));
+                            m_bytesReceived += u64(received);
+                            return IOResult::k_success;
+                        }
+
+                        if (received == 0)
+                        {
+                            return IOResult::k_closed;
+                        }
+
+                        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+                        {
+                            auto result = Wait(POLLIN);
+                            if (result != IOResult::k_success)
+                            {
+                                return result;
+                            }
+                            continue;
+                        }
+
+                        return IOResult::k_failed;
+                    }
+                }
+
+                /// Waits until the socket is ready for the given events.
+                ///
+                /// @param in_events
+                ///     The poll events to wait for.
+                ///
+                /// @return The result.
+                ///
+                IOResult Wait(s16 in_events)
+                {
+                    auto deadline = Clock::now() + m_timeout;
+                    while (true)
+                    {
+                        if (m_isCancelled == true)
+                        {
+                            return IOResult::k_cancelled;
+                        }
+
+                        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+                        if (remaining <= 0)
+                        {
+                            return IOResult::k_timeout;
+                        }
+
+                        pollfd descriptor { m_socket, in_events, 0 };
+                        s32 ready = poll(&descriptor, 1, s32(std::min<decltype(remaining)>(remaining, k_pollIntervalMS)));
+                        if (ready > 0)
+                        {
+                            //Errors and hang ups are reported by the following send or recv.
+                            return IOResult::k_success;
+                        }
+
+                        if (ready < 0 && errno != EINTR)
+                        {
+                            return IOResult::k_failed;
+                        }
+                    }
+                }
+
+                const s32 m_socket;
+                const Clock::duration m_timeout;
+                const std::atomic<bool>& m_isCancelled;
+
+                std::string m_buffer;
+                u64 m_readOffset = 0;
+                u64 m_bytesSent = 0;
+                u64 m_bytesReceived = 0;
+            };
+
+            /// @param in_result
+            ///     The result of a socket operation. Must not be success.
+            ///
+            /// @return The equivalent response result.
+            ///
+            ChilliSource::HttpResponse::Result ToResponseResult(IOResult in_result)
+            {
+                return in_result == IOResult::k_timeout ? ChilliSource::HttpResponse::Result::k_timeout : ChilliSource::HttpResponse::Result::k_failed;
+            }
+
+            /// @param in_start
+            ///     The start time.
+            ///
+            /// @return The seconds elapsed since the start time.
+            ///
+            f32 SecondsSince(Clock::time_point in_start)
+            {
+                return std::chrono::duration<f32>(Clock::now() - in_start).count();
+            }
+        }
+
+        //------------------------------------------------------------------------------
+        HttpRequest::HttpRequest(Type in_type, const std::string& in_url, const std::string& in_body, const ChilliSource::ParamDictionary& in_headers, u32 in_timeoutSecs,
+            u32 in_bufferFlushSize, const Delegate& in_delegate)
+            : m_type(in_type), m_url(in_url), m_body(in_body), m_headers(in_headers), m_completionDelegate(in_delegate), m_timeoutSecs(in_timeoutSecs),
+            m_bufferFlushSize(in_bufferFlushSize), m_isCancelled(false), m_expectedSize(0), m_downloadedBytes(0), m_responseCode(0)
+        {
+            CS_ASSERT(m_completionDelegate, "Http request cannot have null delegate");
+        }
+
+        //------------------------------------------------------------------------------
+        void HttpRequest::Perform(HttpConnectionPool* in_connectionPool)
+        {
+            auto startTime = Clock::now();
+            auto result = ChilliSource::HttpResponse::Result::k_failed;
+
+            auto type = m_type;
+            auto url = m_url;
+            while (m_isCancelled == false)
+            {
+                std::string redirectUrl;
+                result = PerformExchange(in_connectionPool, url, type, redirectUrl);
+
+                if (redirectUrl.empty() == true)
+                {
+                    break;
+                }
+
+                if (m_metrics.m_numRedirects >= k_maxRedirects)
+                {
+                    CS_LOG_ERROR("Http: Too many redirects requesting '" + m_url + "'.");
+                    result = ChilliSource::HttpResponse::Result::k_failed;
+                    break;
+                }
+
+                ++m_metrics.m_numRedirects;
+                url = ResolveRedirect(url, redirectUrl);
+            }
+
+            m_metrics.m_totalSecs = SecondsSince(startTime);
+
+            if (m_isCancelled == false)
+            {
+                CS_LOG_VERBOSE("Http: " + m_url + " - " + ChilliSource::ToString(u32(m_responseCode)) + " in " + ChilliSource::ToString(m_metrics.m_totalSecs, 3) + "s (connect " +
+                    ChilliSource::ToString(m_metrics.m_connectSecs, 3) + "s, first byte " + ChilliSource::ToString(m_metrics.m_timeToFirstByteSecs, 3) + "s, sent " +
+                    ChilliSource::ToString(m_metrics.m_bytesSent) + "B, received " + ChilliSource::ToString(m_metrics.m_bytesReceived) + "B" +
+                    (m_metrics.m_isConnectionReused ? ", reused connection)" : ")"));
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_requestResult = result;
+            m_isPerformComplete = true;
+        }
+
+        //------------------------------------------------------------------------------
+        ChilliSource::HttpResponse::Result HttpRequest::PerformExchange(HttpConnectionPool* in_connectionPool, const std::string& in_url, Type& inout_type, std::string& out_redirectUrl)
+        {
+            if (IsSupportedScheme(in_url) == false)
+            {
+                CS_LOG_ERROR("Http: Unsupported url '" + in_url + "'. Only http urls are supported by the POSIX backend.");
+                return ChilliSource::HttpResponse::Result::k_unsupported;
+            }
+
+            Url url;
+            if (ParseUrl(in_url, url) == false)
+            {
+                return ChilliSource::HttpResponse::Result::k_failed;
+            }
+
+            //Build the request
+            auto hostHeader = (url.m_host.find(':') != std::string::npos) ? "[" + url.m_host + "]" : url.m_host;
+            if (url.m_port != 80)
+            {
+                hostHeader += ":" + ChilliSource::ToString(u32(url.m_port));
+            }
+
+            const auto& body = (inout_type == Type::k_post) ? m_body : std::string();
+            std::string request = (inout_type == Type::k_post ? "POST " : "GET ") + url.m_path + " HTTP/1.1\r\n";
+            if (m_headers.HasKey("Host") == false)
+            {
+                request += "Host: " + hostHeader + "\r\n";
+            }
+            if (m_headers.HasKey("Connection") == false)
+            {
+                request += "Connection: keep-alive\r\n";
+            }
+            if (inout_type == Type::k_post && m_headers.HasKey("Content-Length") == false)
+            {
+                request += "Content-Length: " + ChilliSource::ToString(u64(body.length())) + "\r\n";
+            }
+            for (const auto& header : m_headers)
+            {
+                request += header.first + ": " + header.second + "\r\n";
+            }
+            request += "\r\n";
+            request += body;
+
+            //Send it, retrying once on a new connection if a pooled connection turns out to have been closed by the server.
+            auto exchangeStart = Clock::now();
+            s32 socket = -1;
+            std::unique_ptr<SocketStream> stream;
+            std::string statusLine;
+            for (u32 attempt = 0; attempt < 2; ++attempt)
+            {
+                auto connectStart = Clock::now();
+                bool isReused = false;
+                auto connectResult = in_connectionPool->Acquire(url.m_host, url.m_port, m_timeoutSecs, m_isCancelled, socket, isReused);
+                switch (connectResult)
+                {
+                    case HttpConnectionPool::Result::k_success:
+                        break;
+                    case HttpConnectionPool::Result::k_timeout:
+                        return ChilliSource::HttpResponse::Result::k_timeout;
+                    default:
+                        return ChilliSource::HttpResponse::Result::k_failed;
+                }
+
+                m_metrics.m_connectSecs = SecondsSince(connectStart);
+                m_metrics.m_isConnectionReused = isReused;
+
+                stream.reset(new SocketStream(socket, m_timeoutSecs, m_isCancelled));
+                auto ioResult = stream->Write(request);
+                if (ioResult == IOResult::k_success)
+                {
+                    ioResult = stream->ReadLine(statusLine);
+                }
+
+                m_metrics.m_bytesSent += stream->GetBytesSent();
+                if (ioResult == IOResult::k_success)
+                {
+                    m_metrics.m_timeToFirstByteSecs = SecondsSince(exchangeStart);
+                    break;
+                }
+
+                m_metrics.m_bytesReceived += stream->GetBytesReceived();
+                in_connectionPool->Close(socket);
+                stream.reset();
+
+                if (isReused == false || attempt > 0 || ioResult == IOResult::k_cancelled || ioResult == IOResult::k_timeout)
+                {
+                    return ToResponseResult(ioResult);
+                }
+            }
+
+            if (stream == nullptr)
+            {
+                return ChilliSource::HttpResponse::Result::k_failed;
+            }
+
+            //Read the status line and headers, skipping any interim 1xx responses.
+            std::unordered_map<std::string, std::string> responseHeaders;
+            ChilliSource::ParamDictionary originalResponseHeaders;
+            u32 responseCode = 0;
+            bool isHttp10 = false;
+            auto ioResult = IOResult::k_success;
+            while (ioResult == IOResult::k_success)
+            {
+                auto codeStart = statusLine.find(' ');
+                if (ChilliSource::StringUtils::StartsWith(statusLine, "HTTP/", false) == false || codeStart == std::string::npos)
+                {
+                    ioResult = IOResult::k_failed;
+                    break;
+                }
+                isHttp10 = ChilliSource::StringUtils::StartsWith(statusLine, "HTTP/1.0", false);
+                responseCode = u32(std::strtoul(statusLine.c_str() + codeStart + 1, nullptr, 10));
+
+                responseHeaders.clear();
+                originalResponseHeaders.clear();
+                std::string line;
+                while ((ioResult = stream->ReadLine(line)) == IOResult::k_success && line.empty() == false)
+                {
+                    auto separator = line.find(':');
+                    if (separator != std::string::npos)
+                    {
+                        auto key = line.substr(0, separator);
+                        auto value = line.substr(separator + 1);
+                        ChilliSource::StringUtils::Trim(value);
+                        originalResponseHeaders.SetValue(key, value);
+                        ChilliSource::StringUtils::ToLowerCase(key);
+                        responseHeaders[key] = value;
+                    }
+                }
+
+                if (ioResult != IOResult::k_success || responseCode >= 200 || responseCode < 100)
+                {
+                    break;
+                }
+
+                ioResult = stream->ReadLine(statusLine);
+            }
+
+            if (ioResult != IOResult::k_success)
+            {
+                m_metrics.m_bytesReceived += stream->GetBytesReceived();
+                in_connectionPool->Close(socket);
+                return ToResponseResult(ioResult);
+            }
+
+            auto getHeader = [&](const std::string& in_key) -> std::string
+            {
+                auto it = responseHeaders.find(in_key);
+                if (it == responseHeaders.end())
+                {
+                    return "";
+                }
+
+                auto value = it->second;
+                ChilliSource::StringUtils::ToLowerCase(value);
+                return value;
+            };
+
+            auto connection = getHeader("connection");
+            bool isKeepAlive = isHttp10 ? connection.find("keep-alive") != std::string::npos : connection.find("close") == std::string::npos;
+
+            bool isRedirect = (responseCode == 301 || responseCode == 302 || responseCode == 303 || responseCode == 307 || responseCode == 308) && responseHeaders.count("location") > 0;
+            if (isRedirect == false)
+            {
+                m_responseCode = responseCode;
+                m_responseHeaders = std::move(originalResponseHeaders);
+            }
+
+            //Read the body. A redirect's body is read and discarded so that its connection can be reused.
+            auto onBodyData = [&](const s8* in_data, u64 in_size)
+            {
+                if (isRedirect == false)
+                {
+                    AppendResponseData(in_data, in_size);
+                }
+            };
+
+            auto transferEncoding = getHeader("transfer-encoding");
+            auto contentLength = getHeader("content-length");
+            bool hasBody = (responseCode != 204 && responseCode != 304);
+
+            const s8* data = nullptr;
+            u64 size = 0;
+            if (hasBody == false)
+            {
+                if (isRedirect == false)
+                {
+                    m_expectedSize = 0;
+                }
+            }
+            else if (transferEncoding.find("chunked") != std::string::npos)
+            {
+                std::string line;
+                while ((ioResult = stream->ReadLine(line)) == IOResult::k_success)
+                {
+                    u64 chunkSize = std::strtoull(line.c_str(), nullptr, 16);
+                    if (chunkSize == 0)
+                    {
+                        //Skip the trailers
+                        while ((ioResult = stream->ReadLine(line)) == IOResult::k_success && line.empty() == false)
+                        {
+                        }
+                        break;
+                    }
+
+                    while (chunkSize > 0 && (ioResult = stream->Read(chunkSize, data, size)) == IOResult::k_success)
+                    {
+                        onBodyData(data, size);
+                        chunkSize -= size;
+                    }
+
+                    if (ioResult != IOResult::k_success || (ioResult = stream->ReadLine(line)) != IOResult::k_success)
+                    {
+                        break;
+                    }
+                }
+            }
+            else if (contentLength.empty() == false)
+            {
+                u64 remaining = std::strtoull(contentLength.c_str(), nullptr, 10);
+                if (isRedirect == false)
+                {
+                    m_expectedSize = remaining;
+                }
+
+                while (remaining > 0 && (ioResult = stream->Read(remaining, data, size)) == IOResult::k_success)
+                {
+                    onBodyData(data, size);
+                    remaining -= size;
+                }
+            }
+            else
+            {
+                //The body is delimited by the server closing the connection.
+                isKeepAlive = false;
+                while ((ioResult = stream->Read(k_readBufferSize, data, size)) == IOResult::k_success)
+                {
+                    onBodyData(data, size);
+                }
+
+                if (ioResult == IOResult::k_closed)
+                {
+                    ioResult = IOResult::k_success;
+                }
+            }
+
+            m_metrics.m_bytesReceived += stream->GetBytesReceived();
+
+            if (ioResult == IOResult::k_success && isKeepAlive == true && stream->HasUnreadData() == false)
+            {
+                in_connectionPool->Release(url.m_host, url.m_port, socket);
+            }
+            else
+            {
+                in_connectionPool->Close(socket);
+            }
+
+            if (ioResult != IOResult::k_success)
+            {
+                return ToResponseResult(ioResult);
+            }
+
+            if (isRedirect == true)
+            {
+                //Only 307 and 308 require the method and body to be preserved.
+                out_redirectUrl = responseHeaders["location"];
+                if (responseCode != 307 && responseCode != 308)
+                {
+                    inout_type = Type::k_get;
+                }
+            }
+
+            return ChilliSource::HttpResponse::Result::k_completed;
+        }
+
+        //------------------------------------------------------------------------------
+        void HttpRequest::AppendResponseData(const s8* in_data, u64 in_size)
+        {
+            m_downloadedBytes += in_size;
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_responseData.append(reinterpret_cast<const char*>(in_data), in_size);
+
+            if (m_bufferFlushSize != 0 && m_responseData.length() >= m_bufferFlushSize)
+            {
+                m_pendingFlushes.push_back(std::move(m_responseData));
+                m_responseData.clear();
+            }
+        }
+
+        //------------------------------------------------------------------------------
+        void HttpRequest::Update()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            auto pendingFlushes = std::move(m_pendingFlushes);
+            m_pendingFlushes.clear();
+            bool isPerformComplete = m_isPerformComplete;
+            lock.unlock();
+
+            for (const auto& flushedData : pendingFlushes)
+            {
+                if (m_isCancelled == true)
+                {
+                    break;
+                }
+
+                m_completionDelegate(this, ChilliSource::HttpResponse(ChilliSource::HttpResponse::Result::k_flushed, m_responseCode, flushedData));
+            }
+
+            //Once performed the worker thread no longer touches the request so the remaining state can be read without locking.
+            if (isPerformComplete == true)
+            {
+                m_isRequestComplete = true;
+
+                if (m_isCancelled == false)
+                {
+                    m_completionDelegate(this, ChilliSource::HttpResponse(m_requestResult, m_responseCode, m_responseData, m_responseHeaders));
+                }
+            }
+        }
+
+        //------------------------------------------------------------------------------
+        bool HttpRequest::HasCompleted() const
+        {
+            return m_isRequestComplete;
+        }
+
+        //------------------------------------------------------------------------------
+        void HttpRequest::Cancel()
+        {
+            m_isCancelled = true;
+        }
+
+        //------------------------------------------------------------------------------
+        HttpRequest::Type HttpRequest::GetType() const
+        {
+            return m_type;
+        }
+
+        //------------------------------------------------------------------------------
+        const std::string& HttpRequest::GetUrl() const
+        {
+            return m_url;
+        }
+
+        //------------------------------------------------------------------------------
+        const std::string& HttpRequest::GetBody() const
+        {
+            return m_body;
+        }
+
+        //------------------------------------------------------------------------------
+        const ChilliSource::ParamDictionary& HttpRequest::GetHeaders() const
+        {
+            return m_headers;
+        }
+
+        //------------------------------------------------------------------------------
+        u64 HttpRequest::GetExpectedSize() const
+        {
+            return m_expectedSize;
+        }
+
+        //------------------------------------------------------------------------------
+        u64 HttpRequest::GetDownloadedBytes() const
+        {
+            return m_downloadedBytes;
+        }
+
+        //------------------------------------------------------------------------------
+        const HttpRequest::Metrics& HttpRequest::GetMetrics() const
+        {
+            return m_metrics;
+        }
+    }
+}
+
+#endif
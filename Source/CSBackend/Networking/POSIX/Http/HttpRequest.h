@@ -0,0 +1,197 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifdef CS_ENABLE_POSIXHTTP
+
+#ifndef _CSBACKEND_NETWORKING_POSIX_HTTP_HTTPREQUEST_H_
+#define _CSBACKEND_NETWORKING_POSIX_HTTP_HTTPREQUEST_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Networking/Http/HttpRequest.h>
+#include <ChilliSource/Networking/Http/HttpResponse.h>
+
+#include <CSBackend/Networking/POSIX/ForwardDeclarations.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace CSBackend
+{
+    namespace POSIX
+    {
+        /// A plain HTTP/1.1 request performed over a BSD socket. Requests are performed by the
+        /// worker threads of the owning HttpRequestSystem on a pooled keep-alive connection,
+        /// while the completion delegate is always invoked on the main thread.
+        ///
+        /// The response body is decoded as it arrives, whether framed by Content-Length, chunked
+        /// transfer encoding or the connection closing. If the system has a max buffer size the
+        /// body is streamed to the delegate in k_flushed responses as each buffer fills.
+        ///
+        /// Only plain http is supported. A request for, or redirected to, any other scheme
+        /// completes with a k_unsupported result.
+        ///
+        class HttpRequest final : public ChilliSource::HttpRequest
+        {
+        public:
+            /// Timings and sizes recorded while the request was performed. These are only
+            /// complete once the final response has been delivered.
+            ///
+            struct Metrics
+            {
+                f32 m_connectSecs = 0.0f;
+                f32 m_timeToFirstByteSecs = 0.0f;
+                f32 m_totalSecs = 0.0f;
+                u64 m_bytesSent = 0;
+                u64 m_bytesReceived = 0;
+                u32 m_numRedirects = 0;
+                bool m_isConnectionReused = false;
+            };
+
+            /// @return The type of the request (POST or GET)
+            ///
+            Type GetType() const override;
+
+            /// @return The original url to which the request was sent
+            ///
+            const std::string& GetUrl() const override;
+
+            /// @return The body of the POST request (GET request will return empty)
+            ///
+            const std::string& GetBody() const override;
+
+            /// @return The original headers of the request as keys/values
+            ///
+            const ChilliSource::ParamDictionary& GetHeaders() const override;
+
+            /// Close the request. Note: The completion delegate is not invoked
+            ///
+            void Cancel() override;
+
+            /// @return The expected total size of the response body, or 0 if it is not known.
+            ///
+            u64 GetExpectedSize() const override;
+
+            /// @return The number of response body bytes received so far.
+            ///
+            u64 GetDownloadedBytes() const override;
+
+            /// @return The timings and sizes recorded for the request. This should only be
+            ///     read once the completion delegate has been invoked.
+            ///
+            const Metrics& GetMetrics() const;
+
+        private:
+            friend class HttpRequestSystem;
+
+            /// @param in_type
+            ///     Type (POST or GET)
+            /// @param in_url
+            ///     Url to send request to
+            /// @param in_body
+            ///     POST body
+            /// @param in_headers
+            ///     Headers
+            /// @param in_timeoutSecs
+            ///     The time without any progress, whether connecting, sending or receiving,
+            ///     after which the request times out.
+            /// @param in_bufferFlushSize
+            ///     Max buffer size before flush required. 0 disables flushing.
+            /// @param in_delegate
+            ///     Completion delegate
+            ///
+            HttpRequest(Type in_type, const std::string& in_url, const std::string& in_body, const ChilliSource::ParamDictionary& in_headers, u32 in_timeoutSecs,
+                u32 in_bufferFlushSize, const Delegate& in_delegate);
+
+            /// Performs the request, following redirects, and buffers the response. This blocks
+            /// until the request finishes, fails or is cancelled, so is called on a worker thread.
+            ///
+            /// @param in_connectionPool
+            ///     The pool from which connections are acquired and to which they are returned.
+            ///
+            void Perform(HttpConnectionPool* in_connectionPool);
+
+            /// Performs a single request and response exchange with the given url.
+            ///
+            /// @param in_connectionPool
+            ///     The connection pool.
+            /// @param in_url
+            ///     The url.
+            /// @param inout_type
+            ///     The type of request. This is changed to GET if a redirect requires it.
+            /// @param out_redirectUrl
+            ///     Set to the redirect location if the response was a redirect.
+            ///
+            /// @return The result of the exchange.
+            ///
+            ChilliSource::HttpResponse::Result PerformExchange(HttpConnectionPool* in_connectionPool, const std::string& in_url, Type& inout_type, std::string& out_redirectUrl);
+
+            /// Appends received body data to the response, moving it to the pending flushes
+            /// if the buffer flush size has been reached.
+            ///
+            /// @param in_data
+            ///     The data.
+            /// @param in_size
+            ///     The size of the data.
+            ///
+            void AppendResponseData(const s8* in_data, u64 in_size);
+
+            /// Delivers any pending flushed data and, once the request has been performed,
+            /// the final response. Called on the main thread.
+            ///
+            void Update();
+
+            /// @return Whether the request has completed - regardless of success or failure
+            ///
+            bool HasCompleted() const;
+
+            const Type m_type;
+            const std::string m_url;
+            const std::string m_body;
+            const ChilliSource::ParamDictionary m_headers;
+            const Delegate m_completionDelegate;
+            const u32 m_timeoutSecs;
+            const u32 m_bufferFlushSize;
+
+            std::atomic<bool> m_isCancelled;
+            std::atomic<u64> m_expectedSize;
+            std::atomic<u64> m_downloadedBytes;
+
+            std::mutex m_mutex;
+            std::string m_responseData;
+            std::vector<std::string> m_pendingFlushes;
+            std::atomic<u32> m_responseCode;
+            ChilliSource::ParamDictionary m_responseHeaders;
+            ChilliSource::HttpResponse::Result m_requestResult = ChilliSource::HttpResponse::Result::k_failed;
+            Metrics m_metrics;
+            bool m_isPerformComplete = false;
+
+            bool m_isRequestComplete = false;
+        };
+    }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,241 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifdef CS_ENABLE_POSIXHTTP
+
+#include <CSBackend/Networking/POSIX/Http/HttpRequestSystem.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Threading/TaskScheduler.h>
+
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <sys/socket.h>
+
+namespace CSBackend
+{
+    namespace POSIX
+    {
+        namespace
+        {
+            const u32 k_numWorkerThreads = 4;
+            const u32 k_maxIdleConnectionsPerHost = 4;
+            const u32 k_idleConnectionTimeoutSecs = 30;
+
+            /// @return Whether any network interface other than loopback is up, running and
+            ///     has an IPv4 or IPv6 address.
+            ///
+            bool HasActiveNetworkInterface()
+            {
+                ifaddrs* interfaces = nullptr;
+                if (getifaddrs(&interfaces) != 0)
+                {
+                    CS_LOG_ERROR("Http: Failed to list the network interfaces when checking reachability.");
+                    return false;
+                }
+
+                bool isReachable = false;
+                for (auto networkInterface = interfaces; networkInterface != nullptr && isReachable == false; networkInterface = networkInterface->ifa_next)
+                {
+                    if (networkInterface->ifa_addr == nullptr || (networkInterface->ifa_flags & IFF_LOOPBACK) != 0)
+                    {
+                        continue;
+                    }
+
+                    auto family = networkInterface->ifa_addr->sa_family;
+                    isReachable = (networkInterface->ifa_flags & IFF_UP) != 0 && (networkInterface->ifa_flags & IFF_RUNNING) != 0 && (family == AF_INET || family == AF_INET6);
+                }
+
+                freeifaddrs(interfaces);
+                return isReachable;
+            }
+        }
+
+        CS_DEFINE_NAMEDTYPE(HttpRequestSystem);
+
+        //------------------------------------------------------------------------------
+        bool HttpRequestSystem::IsA(ChilliSource::InterfaceIDType in_interfaceId) const
+        {
+            return in_interfaceId == ChilliSource::HttpRequestSystem::InterfaceID || in_interfaceId == HttpRequestSystem::InterfaceID;
+        }
+
+        //------------------------------------------------------------------------------
+        HttpRequest* HttpRequestSystem::MakeGetRequest(const std::string& in_url, const HttpRequest::Delegate& in_delegate, u32 in_timeoutSecs)
+        {
+            return MakeRequest(HttpRequest::Type::k_get, in_url, "", ChilliSource::ParamDictionary(), in_delegate, in_timeoutSecs);
+        }
+
+        //------------------------------------------------------------------------------
+        HttpRequest* HttpRequestSystem::MakeGetRequest(const std::string& in_url, const ChilliSource::ParamDictionary& in_headers, const HttpRequest::Delegate& in_delegate, u32 in_timeoutSecs)
+        {
+            return MakeRequest(HttpRequest::Type::k_get, in_url, "", in_headers, in_delegate, in_timeoutSecs);
+        }
+
+        //------------------------------------------------------------------------------
+        HttpRequest* HttpRequestSystem::MakePostRequest(const std::string& in_url, const std::string& in_body, const HttpRequest::Delegate& in_delegate, u32 in_timeoutSecs)
+        {
+            return MakeRequest(HttpRequest::Type::k_post, in_url, in_body, ChilliSource::ParamDictionary(), in_delegate, in_timeoutSecs);
+        }
+
+        //------------------------------------------------------------------------------
+        HttpRequest* HttpRequestSystem::MakePostRequest(const std::string& in_url, const std::string& in_body, const ChilliSource::ParamDictionary& in_headers, const HttpRequest::Delegate& in_delegate, u32 in_timeoutSecs)
+        {
+            return MakeRequest(HttpRequest::Type::k_post, in_url, in_body, in_headers, in_delegate, in_timeoutSecs);
+        }
+
+        //------------------------------------------------------------------------------
+        HttpRequest* HttpRequestSystem::MakeRequest(HttpRequest::Type in_type, const std::string& in_url, const std::string& in_body, const ChilliSource::ParamDictionary& in_headers, const HttpRequest::Delegate& in_delegate, u32 in_timeoutSecs)
+        {
+            CS_ASSERT(ChilliSource::Application::Get()->GetTaskScheduler()->IsMainThread() == true, "Http requests can currently only be made on the main thread");
+            CS_ASSERT(in_delegate != nullptr, "Cannot make an http request with a null delegate");
+            CS_ASSERT(in_url.empty() == false, "Cannot make an http request to a blank url");
+
+            HttpRequest* httpRequest = new HttpRequest(in_type, in_url, in_body, in_headers, in_timeoutSecs, GetMaxBufferSize(), in_delegate);
+            m_requests.push_back(httpRequest);
+
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queuedRequests.push_back(httpRequest);
+            lock.unlock();
+
+            m_queueCondition.notify_one();
+
+            return httpRequest;
+        }
+
+        //------------------------------------------------------------------------------
+        void HttpRequestSystem::CancelAllRequests()
+        {
+            CS_ASSERT(ChilliSource::Application::Get()->GetTaskScheduler()->IsMainThread() == true, "Http requests can currently only be made on the main thread");
+
+            for (auto request : m_requests)
+            {
+                request->Cancel();
+            }
+        }
+
+        //------------------------------------------------------------------------------
+        void HttpRequestSystem::CheckReachability(const ReachabilityResultDelegate& in_reachabilityDelegate) const
+        {
+            CS_ASSERT(in_reachabilityDelegate, "The reachability delegate should not be null.");
+
+            ChilliSource::Application::Get()->GetTaskScheduler()->ScheduleTask(ChilliSource::TaskType::k_system, [=](const ChilliSource::TaskContext&)
+            {
+                auto isReachable = HasActiveNetworkInterface();
+
+                ChilliSource::Application::Get()->GetTaskScheduler()->ScheduleTask(ChilliSource::TaskType::k_mainThread, [=](const ChilliSource::TaskContext&)
+                {
+                    in_reachabilityDelegate(isReachable);
+                });
+            });
+        }
+
+        //------------------------------------------------------------------------------
+        void HttpRequestSystem::ProcessRequests()
+        {
+            while (true)
+            {
+                std::unique_lock<std::mutex> lock(m_queueMutex);
+                m_queueCondition.wait(lock, [this]() { return m_isShuttingDown == true || m_queuedRequests.empty() == false; });
+
+                if (m_isShuttingDown == true)
+                {
+                    return;
+                }
+
+                HttpRequest* request = m_queuedRequests.front();
+                m_queuedRequests.pop_front();
+                lock.unlock();
+
+                //A request cancelled while queued is still "performed" so that it is marked complete and can be removed.
+                request->Perform(m_connectionPool.get());
+            }
+        }
+
+        //------------------------------------------------------------------------------
+        void HttpRequestSystem::OnInit()
+        {
+            m_connectionPool = HttpConnectionPoolUPtr(new HttpConnectionPool(k_maxIdleConnectionsPerHost, k_idleConnectionTimeoutSecs));
+
+            for (u32 i = 0; i < k_numWorkerThreads; ++i)
+            {
+                m_workerThreads.push_back(std::thread(&HttpRequestSystem::ProcessRequests, this));
+            }
+        }
+
+        //------------------------------------------------------------------------------
+        void HttpRequestSystem::OnUpdate(f32)
+        {
+            //We should do this in two loops incase anyone tries to insert into the requests from the completion callback
+            for (u32 i = 0; i < m_requests.size(); ++i)
+            {
+                m_requests[i]->Update();
+            }
+
+            for (auto it = m_requests.begin(); it != m_requests.end(); /*No increment*/)
+            {
+                if ((*it)->HasCompleted())
+                {
+                    CS_SAFEDELETE(*it);
+                    it = m_requests.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        //------------------------------------------------------------------------------
+        void HttpRequestSystem::OnDestroy()
+        {
+            CancelAllRequests();
+
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_isShuttingDown = true;
+            m_queuedRequests.clear();
+            lock.unlock();
+
+            m_queueCondition.notify_all();
+
+            //Cancelled requests notice within a poll interval, so this only waits on in-flight DNS lookups.
+            for (auto& thread : m_workerThreads)
+            {
+                thread.join();
+            }
+            m_workerThreads.clear();
+
+            for (auto request : m_requests)
+            {
+                CS_SAFEDELETE(request);
+            }
+
+            m_requests.clear();
+            m_requests.shrink_to_fit();
+
+            m_connectionPool.reset();
+        }
+    }
+}
+
+#endif
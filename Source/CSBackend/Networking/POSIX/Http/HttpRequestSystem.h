@@ -0,0 +1,206 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifdef CS_ENABLE_POSIXHTTP
+
+#ifndef _CSBACKEND_NETWORKING_POSIX_HTTP_HTTPREQUESTSYSTEM_H_
+#define _CSBACKEND_NETWORKING_POSIX_HTTP_HTTPREQUESTSYSTEM_H_
+
+#ifdef CS_TARGETPLATFORM_WINDOWS
+#error "The POSIX http backend is not supported on Windows."
+#endif
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Networking/Http/HttpRequestSystem.h>
+
+#include <CSBackend/Networking/POSIX/ForwardDeclarations.h>
+#include <CSBackend/Networking/POSIX/Http/HttpConnectionPool.h>
+#include <CSBackend/Networking/POSIX/Http/HttpRequest.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CSBackend
+{
+    namespace POSIX
+    {
+        /// A portable implementation of the http request system built on BSD sockets. This is
+        /// used in place of the platform backend when CS_ENABLE_POSIXHTTP is defined.
+        ///
+        /// Requests are performed by a fixed size pool of worker threads, so a burst of requests
+        /// queues rather than spawning a thread each. Connections are kept alive and pooled per
+        /// host so that consecutive requests to the same server reuse them. Only plain http is
+        /// supported; requests for https urls complete with a k_unsupported result.
+        ///
+        class HttpRequestSystem final : public ChilliSource::HttpRequestSystem
+        {
+        public:
+            CS_DECLARE_NAMEDTYPE(HttpRequestSystem);
+
+            /// @param in_interfaceId
+            ///     Interface ID
+            ///
+            /// @return Whether object if of argument type
+            ///
+            bool IsA(ChilliSource::InterfaceIDType in_interfaceId) const override;
+
+            /// Causes the system to issue an Http GET request.
+            ///
+            /// @param in_url
+            ///     URL
+            /// @param in_delegate
+            ///     Delegate that is called on request completed. Completion can be failure as well as success
+            /// @param in_timeoutSecs
+            ///     Request timeout in seconds
+            ///
+            /// @return A pointer to the request. The system owns this pointer.
+            ///
+            HttpRequest* MakeGetRequest(const std::string& in_url, const HttpRequest::Delegate& in_delegate, u32 in_timeoutSecs = k_defaultTimeoutSecs) override;
+
+            /// Causes the system to issue an Http GET request.
+            ///
+            /// @param in_url
+            ///     URL
+            /// @param in_headers
+            ///     Key value headers to attach to the request
+            /// @param in_delegate
+            ///     Delegate that is called on request completed. Completion can be failure as well as success
+            /// @param in_timeoutSecs
+            ///     Request timeout in seconds
+            ///
+            /// @return A pointer to the request. The system owns this pointer.
+            ///
+            HttpRequest* MakeGetRequest(const std::string& in_url, const ChilliSource::ParamDictionary& in_headers, const HttpRequest::Delegate& in_delegate, u32 in_timeoutSecs = k_defaultTimeoutSecs) override;
+
+            /// Causes the system to issue an Http POST request with the given body.
+            ///
+            /// @param in_url
+            ///     URL
+            /// @param in_body
+            ///     POST body
+            /// @param in_delegate
+            ///     Delegate that is called on request completed. Completion can be failure as well as success
+            /// @param in_timeoutSecs
+            ///     Request timeout in seconds
+            ///
+            /// @return A pointer to the request. The system owns this pointer.
+            ///
+            HttpRequest* MakePostRequest(const std::string& in_url, const std::string& in_body, const HttpRequest::Delegate& in_delegate, u32 in_timeoutSecs = k_defaultTimeoutSecs) override;
+
+            /// Causes the system to issue an Http POST request with the given body.
+            ///
+            /// @param in_url
+            ///     URL
+            /// @param in_body
+            ///     POST body
+            /// @param in_headers
+            ///     Key value headers to attach to the request
+            /// @param in_delegate
+            ///     Delegate that is called on request completed. Completion can be failure as well as success
+            /// @param in_timeoutSecs
+            ///     Request timeout in seconds
+            ///
+            /// @return A pointer to the request. The system owns this pointer.
+            ///
+            HttpRequest* MakePostRequest(const std::string& in_url, const std::string& in_body, const ChilliSource::ParamDictionary& in_headers, const HttpRequest::Delegate& in_delegate, u32 in_timeoutSecs = k_defaultTimeoutSecs) override;
+
+            /// Equivalent to calling cancel on every incomplete request in progress.
+            ///
+            void CancelAllRequests() override;
+
+            /// Checks if the device is internet ready, which is the case if any network interface
+            /// other than loopback is up and has an address. The check is performed on a system
+            /// thread and the delegate is called on the main thread.
+            ///
+            /// @param in_reachabilityDelegate
+            ///     Delegate to call when reachability is determined
+            ///
+            void CheckReachability(const ReachabilityResultDelegate& in_reachabilityDelegate) const override;
+
+        private:
+            friend ChilliSource::HttpRequestSystemUPtr ChilliSource::HttpRequestSystem::Create();
+
+            /// Private constructor to force use of factory method
+            ///
+            HttpRequestSystem() = default;
+
+            /// Concrete method to which all MakeRequest overloads feed.
+            ///
+            /// @param in_type
+            ///     Type (POST or GET)
+            /// @param in_url
+            ///     Url
+            /// @param in_body
+            ///     Body (POST only)
+            /// @param in_headers
+            ///     Headers
+            /// @param in_delegate
+            ///     Completion delegate
+            /// @param in_timeoutSecs
+            ///     Request timeout in seconds
+            ///
+            /// @return Request. Owned by the system.
+            ///
+            HttpRequest* MakeRequest(HttpRequest::Type in_type, const std::string& in_url, const std::string& in_body, const ChilliSource::ParamDictionary& in_headers, const HttpRequest::Delegate& in_delegate, u32 in_timeoutSecs);
+
+            /// The body of each worker thread. Performs queued requests until the system is
+            /// destroyed.
+            ///
+            void ProcessRequests();
+
+            /// Creates the connection pool and starts the worker threads.
+            ///
+            void OnInit() override;
+
+            /// Delivers the responses of any requests that have made progress and removes
+            /// those that have completed.
+            ///
+            /// @param in_timeSinceLastUpdate
+            ///     Time since last update in seconds
+            ///
+            void OnUpdate(f32 in_timeSinceLastUpdate) override;
+
+            /// Cancels all requests, stops the worker threads and closes all connections.
+            ///
+            void OnDestroy() override;
+
+            std::vector<HttpRequest*> m_requests;
+
+            HttpConnectionPoolUPtr m_connectionPool;
+            std::vector<std::thread> m_workerThreads;
+
+            std::mutex m_queueMutex;
+            std::condition_variable m_queueCondition;
+            std::deque<HttpRequest*> m_queuedRequests;
+            bool m_isShuttingDown = false;
+        };
+    }
+}
+
+#endif
+
+#endif
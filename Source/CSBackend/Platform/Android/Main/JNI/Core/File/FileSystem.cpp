@@ -31,15 +31,16 @@
 #include <CSBackend/Platform/Android/Main/JNI/Core/File/FileSystem.h>
 
 #include <CSBackend/Platform/Android/Main/JNI/Core/Base/CoreJavaInterface.h>
-#include <CSBackend/Platform/Android/Main/JNI/Core/File/VirtualTextInputStream.h>
 #include <CSBackend/Platform/Android/Main/JNI/Core/Java/JavaInterfaceManager.h>
 #include <CSBackend/Platform/Android/Main/JNI/Core/Java/JavaStaticClass.h>
 #include <ChilliSource/Core/Base/Application.h>
 #include <ChilliSource/Core/String/StringUtils.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <dirent.h>
 #include <errno.h>
+#include <limits>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -56,6 +57,7 @@ namespace CSBackend
 			const char k_cachePath[] = "cache/Cache/";
 			const char k_packagePath[] = "AppResources/";
 			const char k_chilliSourcePath[] = "CSResources/";
+			const char k_packedArchiveFileName[] = "Package.cspack";
 
             //------------------------------------------------------------------------------
 			/// @author Ian Copland
@@ -346,6 +348,27 @@ namespace CSBackend
             {
             	CS_LOG_FATAL("File system cannot read Package.");
             }
+
+            //If the package contains an uncompressed packed archive, it is read directly from its offset
+            //within the zip. This allows package files to be looked up from the archive's hash index and
+            //read concurrently, rather than serialising access through the zip.
+            ZippedFileSystem::FileInfo packedArchiveInfo;
+            if (m_zippedFileSystem->TryGetFileInfo(k_packedArchiveFileName, packedArchiveInfo) == true)
+            {
+            	if (packedArchiveInfo.m_isCompressed == false)
+            	{
+            		m_packedArchive = ChilliSource::PackedArchiveUPtr(new ChilliSource::PackedArchive(m_zipFilePath, packedArchiveInfo.m_offset));
+            		if (m_packedArchive->IsValid() == false)
+            		{
+            			CS_LOG_ERROR("File System: Failed to read '" + std::string(k_packedArchiveFileName) + "', falling back to the zip.");
+            			m_packedArchive.reset();
+            		}
+            	}
+            	else
+            	{
+            		CS_LOG_ERROR("File System: '" + std::string(k_packedArchiveFileName) + "' must be stored uncompressed, falling back to the zip.");
+            	}
+            }
 		}
 		//------------------------------------------------------------------------------
 		//------------------------------------------------------------------------------
@@ -365,7 +388,7 @@ namespace CSBackend
 				case ChilliSource::StorageLocation::k_chilliSource:
 				{
 					auto absFilePath = GetAbsolutePathToStorageLocation(in_storageLocation) + ChilliSource::StringUtils::StandardiseFilePath(in_filePath);
-                    textInputStream = m_zippedFileSystem->CreateTextInputStream(absFilePath);
+                    textInputStream = CreatePackageTextInputStream(absFilePath);
 
 					break;
 				}
@@ -379,7 +402,7 @@ namespace CSBackend
 					else
 					{
 						auto absFilePath = GetAbsolutePathToStorageLocation(ChilliSource::StorageLocation::k_package) + ChilliSource::StringUtils::StandardiseFilePath(in_filePath);
-                        textInputStream = m_zippedFileSystem->CreateTextInputStream(absFilePath);
+                        textInputStream = CreatePackageTextInputStream(absFilePath);
 					}
 					break;
 				}
@@ -412,7 +435,7 @@ namespace CSBackend
         		case ChilliSource::StorageLocation::k_chilliSource:
         		{
         			auto absFilePath = GetAbsolutePathToStorageLocation(in_storageLocation) + ChilliSource::StringUtils::StandardiseFilePath(in_filePath);
-                    binaryInputStream = m_zippedFileSystem->CreateBinaryInputStream(absFilePath);
+                    binaryInputStream = CreatePackageBinaryInputStream(absFilePath);
         			break;
         		}
         		case ChilliSource::StorageLocation::k_DLC:
@@ -425,7 +448,7 @@ namespace CSBackend
         			else
         			{
         				auto absFilePath = GetAbsolutePathToStorageLocation(ChilliSource::StorageLocation::k_package) + ChilliSource::StringUtils::StandardiseFilePath(in_filePath);
-                        binaryInputStream = m_zippedFileSystem->CreateBinaryInputStream(absFilePath);
+                        binaryInputStream = CreatePackageBinaryInputStream(absFilePath);
         			}
         			break;
         		}
@@ -589,7 +612,7 @@ namespace CSBackend
                     }
 
                     u32 index = 0;
-					return m_zippedFileSystem->ExtractFiles(sourceFiles, [&](const std::string& in_filePath, std::unique_ptr<const u8[]> in_fileContents, u32 in_fileSize) -> bool
+					return ExtractPackageFiles(sourceFiles, [&](const std::string& in_filePath, std::unique_ptr<const u8[]> in_fileContents, u32 in_fileSize) -> bool
 					{
                         const auto& destination = destinationFiles[index++];
                         return WriteFile(in_destinationStorageLocation, destination, reinterpret_cast<const s8*>(in_fileContents.get()), in_fileSize);
@@ -625,7 +648,7 @@ namespace CSBackend
                     if (sourceFiles.empty() == false)
                     {
 						u32 index = 0;
-						return m_zippedFileSystem->ExtractFiles(sourceFiles, [&](const std::string& in_filePath, std::unique_ptr<const u8[]> in_fileContents, u32 in_fileSize) -> bool
+						return ExtractPackageFiles(sourceFiles, [&](const std::string& in_filePath, std::unique_ptr<const u8[]> in_fileContents, u32 in_fileSize) -> bool
 						{
 							const auto& destination = destinationFiles[index++];
 							return WriteFile(in_destinationStorageLocation, destination, reinterpret_cast<const s8*>(in_fileContents.get()), in_fileSize);
@@ -661,6 +684,23 @@ namespace CSBackend
                 return false;
             }
 
+            return true;
+		}
+		//------------------------------------------------------------------------------
+		//------------------------------------------------------------------------------
+		bool FileSystem::RenameFile(ChilliSource::StorageLocation in_storageLocation, const std::string& in_sourceFilePath, const std::string& in_destinationFilePath) const
+		{
+			CS_ASSERT(IsStorageLocationWritable(in_storageLocation) == true, "Cannot rename file in read-only storage location.");
+
+            std::string storageLocationPath = GetAbsolutePathToStorageLocation(in_storageLocation);
+            std::string sourceFilePath = storageLocationPath + ChilliSource::StringUtils::StandardiseFilePath(in_sourceFilePath);
+            std::string destinationFilePath = storageLocationPath + ChilliSource::StringUtils::StandardiseFilePath(in_destinationFilePath);
+            s32 error = rename(sourceFilePath.c_str(), destinationFilePath.c_str());
+            if (error != 0)
+            {
+                return false;
+            }
+
             return true;
 		}
 		//------------------------------------------------------------------------------
@@ -681,12 +721,12 @@ namespace CSBackend
 			    case ChilliSource::StorageLocation::k_package:
 			    case ChilliSource::StorageLocation::k_chilliSource:
 			    {
-			        return m_zippedFileSystem->GetFilePaths(GetAbsolutePathToStorageLocation(in_storageLocation) + ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath), in_recursive);
+			        return GetPackageFilePaths(GetAbsolutePathToStorageLocation(in_storageLocation) + ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath), in_recursive);
 			    }
 			    case ChilliSource::StorageLocation::k_DLC:
 			    {
                     auto absPackageDirectoryPath = GetAbsolutePathToStorageLocation(ChilliSource::StorageLocation::k_package) + GetPackageDLCPath() + ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath);
-                    auto filePaths = m_zippedFileSystem->GetFilePaths(absPackageDirectoryPath, in_recursive);
+                    auto filePaths = GetPackageFilePaths(absPackageDirectoryPath, in_recursive);
 
                     auto absCacheDirectoryPath = GetAbsolutePathToStorageLocation(in_storageLocation) + ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath);
                     if (CSBackend::Android::DoesDirectoryExist(absCacheDirectoryPath) == true && GetPaths(filePaths, absCacheDirectoryPath, false, in_recursive) == false)
@@ -720,12 +760,12 @@ namespace CSBackend
                 case ChilliSource::StorageLocation::k_package:
                 case ChilliSource::StorageLocation::k_chilliSource:
                 {
-                    return m_zippedFileSystem->GetDirectoryPaths(GetAbsolutePathToStorageLocation(in_storageLocation) + ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath), in_recursive);
+                    return GetPackageDirectoryPaths(GetAbsolutePathToStorageLocation(in_storageLocation) + ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath), in_recursive);
                 }
                 case ChilliSource::StorageLocation::k_DLC:
                 {
                     auto absPackageDirectoryPath = GetAbsolutePathToStorageLocation(ChilliSource::StorageLocation::k_package) + GetPackageDLCPath() + ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath);
-                    auto subDirectoryPaths = m_zippedFileSystem->GetDirectoryPaths(absPackageDirectoryPath, in_recursive);
+                    auto subDirectoryPaths = GetPackageDirectoryPaths(absPackageDirectoryPath, in_recursive);
 
                     auto absCacheDirectoryPath = GetAbsolutePathToStorageLocation(in_storageLocation) + ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath);
                     if (CSBackend::Android::DoesDirectoryExist(absCacheDirectoryPath) == true && GetPaths(subDirectoryPaths, absCacheDirectoryPath, true, in_recursive) == false)
@@ -759,7 +799,7 @@ namespace CSBackend
 				case ChilliSource::StorageLocation::k_package:
 				case ChilliSource::StorageLocation::k_chilliSource:
 				{
-					return m_zippedFileSystem->DoesFileExist(GetAbsolutePathToStorageLocation(in_storageLocation) + ChilliSource::StringUtils::StandardiseFilePath(in_filePath));
+					return DoesPackageFileExist(GetAbsolutePathToStorageLocation(in_storageLocation) + ChilliSource::StringUtils::StandardiseFilePath(in_filePath));
 				}
 				case ChilliSource::StorageLocation::k_DLC:
 				{
@@ -792,7 +832,7 @@ namespace CSBackend
 				case ChilliSource::StorageLocation::k_package:
                 case ChilliSource::StorageLocation::k_chilliSource:
                 {
-                	return m_zippedFileSystem->DoesDirectoryExist(GetAbsolutePathToStorageLocation(in_storageLocation) + ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath));
+                	return DoesPackageDirectoryExist(GetAbsolutePathToStorageLocation(in_storageLocation) + ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath));
                 }
                 case ChilliSource::StorageLocation::k_DLC:
                 {
@@ -873,7 +913,7 @@ namespace CSBackend
 			}
 
 			ZippedFileSystem::FileInfo info;
-			if (m_zippedFileSystem->TryGetFileInfo(filePath, info) == false)
+			if (TryGetPackageFileInfo(filePath, info) == false)
 			{
 				return false;
 			}
@@ -884,6 +924,137 @@ namespace CSBackend
 			out_zippedFileInfo.m_isCompressed = info.m_isCompressed;
 			return true;
 		}
+		//------------------------------------------------------------------------------
+		//------------------------------------------------------------------------------
+		ChilliSource::ITextInputStreamUPtr FileSystem::CreatePackageTextInputStream(const std::string& in_filePath) const
+		{
+			if (m_packedArchive != nullptr && m_packedArchive->DoesFileExist(in_filePath) == true)
+			{
+				return m_packedArchive->CreateTextInputStream(in_filePath);
+			}
+
+			return m_zippedFileSystem->CreateTextInputStream(in_filePath);
+		}
+		//------------------------------------------------------------------------------
+		//------------------------------------------------------------------------------
+		ChilliSource::IBinaryInputStreamUPtr FileSystem::CreatePackageBinaryInputStream(const std::string& in_filePath) const
+		{
+			if (m_packedArchive != nullptr && m_packedArchive->DoesFileExist(in_filePath) == true)
+			{
+				return m_packedArchive->CreateBinaryInputStream(in_filePath);
+			}
+
+			return m_zippedFileSystem->CreateBinaryInputStream(in_filePath);
+		}
+		//------------------------------------------------------------------------------
+		//------------------------------------------------------------------------------
+		bool FileSystem::ExtractPackageFiles(const std::vector<std::string>& in_filePaths, const ZippedFileSystem::FileReadDelegate& in_delegate) const
+		{
+			if (m_packedArchive == nullptr)
+			{
+				return m_zippedFileSystem->ExtractFiles(in_filePaths, in_delegate);
+			}
+
+			//Files which aren't in the packed archive, for example those added to the APK after it was built, are read from the zip.
+			std::vector<std::string> packedFilePaths;
+			std::vector<std::string> zippedFilePaths;
+			for (const auto& filePath : in_filePaths)
+			{
+				if (m_packedArchive->DoesFileExist(filePath) == true)
+				{
+					packedFilePaths.push_back(filePath);
+				}
+				else
+				{
+					zippedFilePaths.push_back(filePath);
+				}
+			}
+
+			if (packedFilePaths.empty() == false && m_packedArchive->ExtractFiles(packedFilePaths, in_delegate) == false)
+			{
+				return false;
+			}
+
+			return (zippedFilePaths.empty() == true || m_zippedFileSystem->ExtractFiles(zippedFilePaths, in_delegate) == true);
+		}
+		//------------------------------------------------------------------------------
+		//------------------------------------------------------------------------------
+		std::vector<std::string> FileSystem::GetPackageFilePaths(const std::string& in_directoryPath, bool in_recursive) const
+		{
+			auto output = m_zippedFileSystem->GetFilePaths(in_directoryPath, in_recursive);
+
+			if (m_packedArchive != nullptr)
+			{
+				auto packedFilePaths = m_packedArchive->GetFilePaths(in_directoryPath, in_recursive);
+				output.insert(output.end(), packedFilePaths.begin(), packedFilePaths.end());
+
+				std::sort(output.begin(), output.end());
+				output.erase(std::unique(output.begin(), output.end()), output.end());
+			}
+
+			return output;
+		}
+		//------------------------------------------------------------------------------
+		//------------------------------------------------------------------------------
+		std::vector<std::string> FileSystem::GetPackageDirectoryPaths(const std::string& in_directoryPath, bool in_recursive) const
+		{
+			auto output = m_zippedFileSystem->GetDirectoryPaths(in_directoryPath, in_recursive);
+
+			if (m_packedArchive != nullptr)
+			{
+				auto packedDirectoryPaths = m_packedArchive->GetDirectoryPaths(in_directoryPath, in_recursive);
+				output.insert(output.end(), packedDirectoryPaths.begin(), packedDirectoryPaths.end());
+
+				std::sort(output.begin(), output.end());
+				output.erase(std::unique(output.begin(), output.end()), output.end());
+			}
+
+			return output;
+		}
+		//------------------------------------------------------------------------------
+		//------------------------------------------------------------------------------
+		bool FileSystem::DoesPackageFileExist(const std::string& in_filePath) const
+		{
+			if (m_packedArchive != nullptr && m_packedArchive->DoesFileExist(in_filePath) == true)
+			{
+				return true;
+			}
+
+			return m_zippedFileSystem->DoesFileExist(in_filePath);
+		}
+		//------------------------------------------------------------------------------
+		//------------------------------------------------------------------------------
+		bool FileSystem::DoesPackageDirectoryExist(const std::string& in_directoryPath) const
+		{
+			if (m_packedArchive != nullptr && m_packedArchive->DoesDirectoryExist(in_directoryPath) == true)
+			{
+				return true;
+			}
+
+			return m_zippedFileSystem->DoesDirectoryExist(in_directoryPath);
+		}
+		//------------------------------------------------------------------------------
+		//------------------------------------------------------------------------------
+		bool FileSystem::TryGetPackageFileInfo(const std::string& in_filePath, ZippedFileSystem::FileInfo& out_fileInfo) const
+		{
+			if (m_packedArchive != nullptr)
+			{
+				ChilliSource::PackedArchive::FileInfo packedFileInfo;
+				if (m_packedArchive->TryGetFileInfo(in_filePath, packedFileInfo) == false)
+				{
+					return m_zippedFileSystem->TryGetFileInfo(in_filePath, out_fileInfo);
+				}
+
+				CS_ASSERT(packedFileInfo.m_offset <= std::numeric_limits<u32>::max(), "Packed file offset is out of range.");
+				out_fileInfo.m_offset = u32(packedFileInfo.m_offset);
+				out_fileInfo.m_size = packedFileInfo.m_size;
+				out_fileInfo.m_uncompressedSize = packedFileInfo.m_uncompressedSize;
+				out_fileInfo.m_isCompressed = packedFileInfo.m_isCompressed;
+				return true;
+			}
+
+			return m_zippedFileSystem->TryGetFileInfo(in_filePath, out_fileInfo);
+		}
 
 	}
 }
@@ -40,6 +40,7 @@
 #include <ChilliSource/Core/File/FileStream/TextInputStream.h>
 #include <ChilliSource/Core/File/FileStream/TextOutputStream.h>
 #include <ChilliSource/Core/File/FileSystem.h>
+#include <ChilliSource/Core/File/PackedArchive.h>
 
 namespace CSBackend
 {
@@ -197,6 +198,19 @@ namespace CSBackend
 			//------------------------------------------------------------------------------
 			bool DeleteFile(ChilliSource::StorageLocation in_storageLocation, const std::string& in_filePath) const override;
 			//------------------------------------------------------------------------------
+			/// Renames the given file, atomically replacing the destination if it already
+			/// exists.
+            ///
+            /// This is thread-safe.
+			///
+			/// @param in_storageLocation - The storage location.
+			/// @param in_sourceFilePath - The file path of the file to rename.
+			/// @param in_destinationFilePath - The new file path.
+			///
+			/// @return Whether or not the file was successfully renamed.
+			//------------------------------------------------------------------------------
+			bool RenameFile(ChilliSource::StorageLocation in_storageLocation, const std::string& in_sourceFilePath, const std::string& in_destinationFilePath) const override;
+			//------------------------------------------------------------------------------
 			/// Deletes a directory and all its contents.
             ///
             /// This is thread-safe.
@@ -358,10 +372,94 @@ namespace CSBackend
             /// @author S Downie
             //------------------------------------------------------------------------------
             FileSystem();
+			//------------------------------------------------------------------------------
+			/// Creates a text input stream to a file in the package zip. If the package
+			/// contains a packed archive which includes the file, it is read from the
+			/// archive instead.
+			///
+			/// This is thread-safe.
+			///
+			/// @param in_filePath - The path to the file, relative to the zip root.
+			///
+			/// @return The new stream, or null if the file could not be opened.
+			//------------------------------------------------------------------------------
+			ChilliSource::ITextInputStreamUPtr CreatePackageTextInputStream(const std::string& in_filePath) const;
+			//------------------------------------------------------------------------------
+			/// Creates a binary input stream to a file in the package zip. If the package
+			/// contains a packed archive which includes the file, it is read from the
+			/// archive instead.
+			///
+			/// This is thread-safe.
+			///
+			/// @param in_filePath - The path to the file, relative to the zip root.
+			///
+			/// @return The new stream, or null if the file could not be opened.
+			//------------------------------------------------------------------------------
+			ChilliSource::IBinaryInputStreamUPtr CreatePackageBinaryInputStream(const std::string& in_filePath) const;
+			//------------------------------------------------------------------------------
+			/// Reads each of the given files from the package, passing the contents to
+			/// the delegate.
+			///
+			/// This is thread-safe.
+			///
+			/// @param in_filePaths - The paths to the files, relative to the zip root.
+			/// @param in_delegate - The delegate called with the contents of each file.
+			///
+			/// @return Whether or not all files were successfully read.
+			//------------------------------------------------------------------------------
+			bool ExtractPackageFiles(const std::vector<std::string>& in_filePaths, const ZippedFileSystem::FileReadDelegate& in_delegate) const;
+			//------------------------------------------------------------------------------
+			/// This is thread-safe.
+			///
+			/// @param in_directoryPath - The directory path, relative to the zip root.
+			/// @param in_recursive - Whether or not to include files in sub-directories.
+			///
+			/// @return The paths of all files in the given package directory.
+			//------------------------------------------------------------------------------
+			std::vector<std::string> GetPackageFilePaths(const std::string& in_directoryPath, bool in_recursive) const;
+			//------------------------------------------------------------------------------
+			/// This is thread-safe.
+			///
+			/// @param in_directoryPath - The directory path, relative to the zip root.
+			/// @param in_recursive - Whether or not to include nested sub-directories.
+			///
+			/// @return The paths of all sub-directories in the given package directory.
+			//------------------------------------------------------------------------------
+			std::vector<std::string> GetPackageDirectoryPaths(const std::string& in_directoryPath, bool in_recursive) const;
+			//------------------------------------------------------------------------------
+			/// This is thread-safe.
+			///
+			/// @param in_filePath - The file path, relative to the zip root.
+			///
+			/// @return Whether or not the file exists in the package.
+			//------------------------------------------------------------------------------
+			bool DoesPackageFileExist(const std::string& in_filePath) const;
+			//------------------------------------------------------------------------------
+			/// This is thread-safe.
+			///
+			/// @param in_directoryPath - The directory path, relative to the zip root.
+			///
+			/// @return Whether or not the directory exists in the package.
+			//------------------------------------------------------------------------------
+			bool DoesPackageDirectoryExist(const std::string& in_directoryPath) const;
+			//------------------------------------------------------------------------------
+			/// Calculates the location of a file within the package zip. Files in a packed
+			/// archive report their offset within the zip, so can still be read directly.
+			///
+			/// This is thread-safe.
+			///
+			/// @param in_filePath - The file path, relative to the zip root.
+			/// @param out_fileInfo - [Out] Information on the file. This is only set if
+			/// the method is successful.
+			///
+			/// @return Whether or not this was successful.
+			//------------------------------------------------------------------------------
+			bool TryGetPackageFileInfo(const std::string& in_filePath, ZippedFileSystem::FileInfo& out_fileInfo) const;
 
 			std::string m_storagePath;
 			std::string m_zipFilePath;
 			ZippedFileSystemUPtr m_zippedFileSystem;
+			ChilliSource::PackedArchiveUPtr m_packedArchive;
 		};
 	}
 }
@@ -28,11 +28,10 @@
 
 #include <CSBackend/Platform/Android/Main/JNI/Core/File/ZippedFileSystem.h>
 
-#include <CSBackend/Platform/Android/Main/JNI/Core/File/VirtualBinaryInputStream.h>
-#include <CSBackend/Platform/Android/Main/JNI/Core/File/VirtualTextInputStream.h>
-
 #include <ChilliSource/Core/File/FileStream/IBinaryInputStream.h>
 #include <ChilliSource/Core/File/FileStream/ITextInputStream.h>
+#include <ChilliSource/Core/File/FileStream/VirtualBinaryInputStream.h>
+#include <ChilliSource/Core/File/FileStream/VirtualTextInputStream.h>
 #include <ChilliSource/Core/String/StringUtils.h>
 #include <ChilliSource/Core/Cryptographic/HashCRC32.h>
 
@@ -92,7 +91,7 @@ namespace CSBackend
                 return nullptr;
             }
 
-            auto output = ChilliSource::ITextInputStreamUPtr(new VirtualTextInputStream(std::move(buffer), bytesRead));
+            auto output = ChilliSource::ITextInputStreamUPtr(new ChilliSource::VirtualTextInputStream(std::move(buffer), bytesRead));
             if (output->IsValid() == false)
             {
                 output = nullptr;
@@ -114,7 +113,7 @@ namespace CSBackend
                 return nullptr;
             }
 
-            auto output = ChilliSource::IBinaryInputStreamUPtr(new VirtualBinaryInputStream(std::move(buffer), bytesRead));
+            auto output = ChilliSource::IBinaryInputStreamUPtr(new ChilliSource::VirtualBinaryInputStream(std::move(buffer), bytesRead));
             if (output->IsValid() == false)
             {
                 output = nullptr;
@@ -172,7 +171,7 @@ namespace CSBackend
             unzCloseCurrentFile(unzipper);
             unzClose(unzipper);
 
-            return std::move(buffer);
+            return buffer;
         }
         //------------------------------------------------------------------------------
         //------------------------------------------------------------------------------
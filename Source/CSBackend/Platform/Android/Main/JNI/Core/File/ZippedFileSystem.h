@@ -35,6 +35,7 @@
 
 #include <minizip/unzip.h>
 
+#include <functional>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -70,8 +70,10 @@ extern "C"
     /// @param in_data - Data
     /// @param in_dataLength - Length of partial data
     /// @param in_responseCode - Response code
+    /// @param in_headerKeys - Response header names. May be null.
+    /// @param in_headerValues - Response header values. May be null.
     //-----------------------------------------------------------------------
-    void Java_com_chilliworks_chillisource_networking_HttpRequest_onComplete(JNIEnv* in_env, jobject in_this, jobject in_objectPointer, jint in_resultCode, jbyteArray in_data, jint in_dataLength, jint in_responseCode);
+    void Java_com_chilliworks_chillisource_networking_HttpRequest_onComplete(JNIEnv* in_env, jobject in_this, jobject in_objectPointer, jint in_resultCode, jbyteArray in_data, jint in_dataLength, jint in_responseCode, jobjectArray in_headerKeys, jobjectArray in_headerValues);
 }
 //-----------------------------------------------------------------------
 //-----------------------------------------------------------------------
@@ -89,16 +91,30 @@ void Java_com_chilliworks_chillisource_networking_HttpRequest_onBufferFlushed(JN
 }
 //-----------------------------------------------------------------------
 //-----------------------------------------------------------------------
-void Java_com_chilliworks_chillisource_networking_HttpRequest_onComplete(JNIEnv* in_env, jobject in_this, jobject in_objectPointer, jint in_resultCode, jbyteArray in_data, jint in_dataLength, jint in_responseCode)
+void Java_com_chilliworks_chillisource_networking_HttpRequest_onComplete(JNIEnv* in_env, jobject in_this, jobject in_objectPointer, jint in_resultCode, jbyteArray in_data, jint in_dataLength, jint in_responseCode, jobjectArray in_headerKeys, jobjectArray in_headerValues)
 {
 	CSBackend::Android::JavaClassSPtr javaBoxedPointer = CSBackend::Android::JavaClassSPtr(new CSBackend::Android::JavaClass(in_objectPointer, CSBackend::Android::BoxedPointer::GetBoxedPointerClassDef()));
 
 	CSBackend::Android::HttpRequest* httpRequest = CSBackend::Android::BoxedPointer::Unbox<CSBackend::Android::HttpRequest>(javaBoxedPointer.get());
 	std::string data = CSBackend::Android::JavaUtils::CreateSTDStringFromJByteArray(in_data, in_dataLength);
 
+	ChilliSource::ParamDictionary headers;
+	if (in_headerKeys != nullptr && in_headerValues != nullptr)
+	{
+		jsize numHeaders = in_env->GetArrayLength(in_headerKeys);
+		for (jsize i = 0; i < numHeaders; ++i)
+		{
+			jstring key = (jstring)in_env->GetObjectArrayElement(in_headerKeys, i);
+			jstring value = (jstring)in_env->GetObjectArrayElement(in_headerValues, i);
+			headers.SetValue(CSBackend::Android::JavaUtils::CreateSTDStringFromJString(key), CSBackend::Android::JavaUtils::CreateSTDStringFromJString(value));
+			in_env->DeleteLocalRef(key);
+			in_env->DeleteLocalRef(value);
+		}
+	}
+
 	ChilliSource::Application::Get()->GetTaskScheduler()->ScheduleTask(ChilliSource::TaskType::k_mainThread, [=](const ChilliSource::TaskContext&)
 	{
-		httpRequest->OnComplete((u32)in_resultCode, data, (u32)in_responseCode);
+		httpRequest->OnComplete((u32)in_resultCode, data, (u32)in_responseCode, headers);
 	});
 }
 
@@ -177,11 +193,11 @@ namespace CSBackend
 		}
 		//--------------------------------------------------------------------------------------
 		//--------------------------------------------------------------------------------------
-		void HttpRequest::OnComplete(u32 in_resultCode, const std::string& in_data, u32 in_responseCode)
+		void HttpRequest::OnComplete(u32 in_resultCode, const std::string& in_data, u32 in_responseCode, const ChilliSource::ParamDictionary& in_headers)
 		{
 			if(m_isRequestCancelled == false && m_completionDelegate)
 			{
-				m_completionDelegate(this, ChilliSource::HttpResponse((ChilliSource::HttpResponse::Result)in_resultCode, in_responseCode, in_data));
+				m_completionDelegate(this, ChilliSource::HttpResponse((ChilliSource::HttpResponse::Result)in_resultCode, in_responseCode, in_data, in_headers));
 			}
 		}
 		//----------------------------------------------------------------------------------------
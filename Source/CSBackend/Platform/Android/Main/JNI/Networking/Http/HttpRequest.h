@@ -110,8 +110,9 @@ namespace CSBackend
 			/// @param in_resultCode - Result code
 			/// @param in_data - Data
 			/// @param in_responseCode - Response code for request
+			/// @param in_headers - Response headers
 			//--------------------------------------------------------------------------------------
-		    void OnComplete(u32 in_resultCode, const std::string& in_data, u32 in_responseCode);
+		    void OnComplete(u32 in_resultCode, const std::string& in_data, u32 in_responseCode, const ChilliSource::ParamDictionary& in_headers);
 
 		private:
 
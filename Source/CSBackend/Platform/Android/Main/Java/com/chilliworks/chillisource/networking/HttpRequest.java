@@ -44,6 +44,9 @@ import java.net.HttpURLConnection;
 import java.net.SocketTimeoutException;
 import java.net.URL;
 import java.net.UnknownHostException;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
 
 import javax.net.ssl.HostnameVerifier;
 import javax.net.ssl.HttpsURLConnection;
@@ -94,9 +97,11 @@ public final class HttpRequest
      * @param in_data - The partial response data that has been flushed
      * @param in_dataLength - The length of the partial response data
      * @param in_responseCode - The http reponse code
+     * @param in_headerKeys - The response header names. May be null.
+     * @param in_headerValues - The response header values. May be null.
      * @param in_objectPointer - The pointer information of the owning native object
      */
-    private static native void onComplete(BoxedPointer in_objectPointer, int in_resultCode, byte[] in_data, int in_dataLength, int in_responseCode);
+    private static native void onComplete(BoxedPointer in_objectPointer, int in_resultCode, byte[] in_data, int in_dataLength, int in_responseCode, String[] in_headerKeys, String[] in_headerValues);
 
     /**
      * Constructor
@@ -358,7 +363,20 @@ public final class HttpRequest
                 reader.close();
             }
 
-            onComplete(m_owner, SUCCESS, byteContainer.getInternalBuffer(), byteContainer.getByteCount(), in_responseCode);
+            List<String> headerKeys = new ArrayList<String>();
+            List<String> headerValues = new ArrayList<String>();
+            for (Map.Entry<String, List<String>> header : in_connection.getHeaderFields().entrySet())
+            {
+                //The status line is reported with a null key.
+                if (header.getKey() != null && header.getValue() != null && header.getValue().isEmpty() == false)
+                {
+                    headerKeys.add(header.getKey());
+                    headerValues.add(header.getValue().get(header.getValue().size() - 1));
+                }
+            }
+
+            onComplete(m_owner, SUCCESS, byteContainer.getInternalBuffer(), byteContainer.getByteCount(), in_responseCode,
+                    headerKeys.toArray(new String[headerKeys.size()]), headerValues.toArray(new String[headerValues.size()]));
         }
         catch(IOException eIOException)
         {
@@ -378,7 +396,7 @@ public final class HttpRequest
      */
     private void onFailed(int in_result, int in_respose)
     {
-        onComplete(m_owner, in_result, null, 0, in_respose);
+        onComplete(m_owner, in_result, null, 0, in_respose, null, null);
     }
     /**
      * Used to safely append downloaded bytes to the total downloaded data
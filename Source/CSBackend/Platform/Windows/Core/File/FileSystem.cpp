@@ -455,6 +455,22 @@ namespace CSBackend
 		}
 		//--------------------------------------------------------------
 		//--------------------------------------------------------------
+		bool FileSystem::RenameFile(ChilliSource::StorageLocation in_storageLocation, const std::string& in_sourceFilePath, const std::string& in_destinationFilePath) const
+		{
+			CS_ASSERT(IsStorageLocationWritable(in_storageLocation), "File System: Trying to rename a file in a read only storage location.");
+
+			std::string storageLocationPath = GetAbsolutePathToStorageLocation(in_storageLocation);
+			std::wstring sourceFilePath = WindowsStringUtils::ConvertStandardPathToWindows(storageLocationPath + in_sourceFilePath);
+			std::wstring destinationFilePath = WindowsStringUtils::ConvertStandardPathToWindows(storageLocationPath + in_destinationFilePath);
+			if (WindowsFileUtils::WindowsMoveFile(sourceFilePath.c_str(), destinationFilePath.c_str()) == FALSE)
+			{
+				return false;
+			}
+
+			return true;
+		}
+		//--------------------------------------------------------------
+		//--------------------------------------------------------------
 		bool FileSystem::DeleteDirectory(ChilliSource::StorageLocation in_storageLocation, const std::string& in_directoryPath) const
 		{
 			CS_ASSERT(IsStorageLocationWritable(in_storageLocation), "File System: Trying to delete from a read only storage location.");
@@ -167,6 +167,17 @@ namespace CSBackend
 			//--------------------------------------------------------------
 			bool DeleteFile(ChilliSource::StorageLocation in_storageLocation, const std::string& in_filepath) const override;
 			//--------------------------------------------------------------
+			/// Renames the given file, replacing the destination if it
+			/// already exists.
+			///
+			/// @param The storage location.
+			/// @param The file path of the file to rename.
+			/// @param The new file path.
+			///
+			/// @return Whether or not the file was successfully renamed.
+			//--------------------------------------------------------------
+			bool RenameFile(ChilliSource::StorageLocation in_storageLocation, const std::string& in_sourceFilePath, const std::string& in_destinationFilePath) const override;
+			//--------------------------------------------------------------
 			/// Deletes a directory and all its contents.
 			///
 			/// @author Ian Copland
@@ -56,6 +56,12 @@ namespace CSBackend
 			}
 			//--------------------------------------------------------
 			//--------------------------------------------------------
+			BOOL WindowsMoveFile(LPCTSTR in_sourceFilename, LPCTSTR in_destinationFilename)
+			{
+				return MoveFileEx(in_sourceFilename, in_destinationFilename, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+			}
+			//--------------------------------------------------------
+			//--------------------------------------------------------
 			BOOL WindowsRemoveDirectory(LPCTSTR in_directory)
 			{
 				return RemoveDirectory(in_directory);
@@ -79,6 +79,15 @@ namespace CSBackend
 			//--------------------------------------------------------
 			BOOL WindowsDeleteFile(LPCTSTR in_filename);
 			//--------------------------------------------------------
+			/// Moves a file using the windows API, replacing the
+			/// destination if it already exists.
+			///
+			/// @param the source location.
+			/// @param The destination location.
+			/// @return Whether or not the file was moved.
+			//--------------------------------------------------------
+			BOOL WindowsMoveFile(LPCTSTR in_sourceFilename, LPCTSTR in_destinationFilename);
+			//--------------------------------------------------------
 			/// Deletes a directory using the windows API.
 			///
 			/// @author Ian Copland
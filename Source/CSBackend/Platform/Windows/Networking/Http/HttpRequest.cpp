@@ -194,7 +194,7 @@ namespace CSBackend
 
 				if (m_isRequestCancelled == false)
 				{
-					m_completionDelegate(this, ChilliSource::HttpResponse(m_requestResult, m_responseCode, m_responseData));
+					m_completionDelegate(this, ChilliSource::HttpResponse(m_requestResult, m_responseCode, m_responseData, m_responseHeaders));
 				}
 			}
 		}
@@ -272,6 +272,7 @@ namespace CSBackend
 			WinHttpQueryHeaders(in_requestHandle, WINHTTP_QUERY_STATUS_CODE | WINHTTP_QUERY_FLAG_NUMBER, nullptr, &responseCode, &headerSize, nullptr);
 			
 			ChilliSource::ParamDictionary headers = GetRequestHeaders(in_requestHandle);
+			m_responseHeaders = headers;
 			std::string expectedSize;
 			headers.TryGetValue("Content-Length", expectedSize);
 			m_expectedSize = ChilliSource::ParseU32(expectedSize);
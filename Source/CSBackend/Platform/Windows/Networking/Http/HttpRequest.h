@@ -167,6 +167,7 @@ namespace CSBackend
 
 			std::string m_responseData;
 			u32 m_responseCode = 0;
+			ChilliSource::ParamDictionary m_responseHeaders;
 			ChilliSource::HttpResponse::Result m_requestResult = ChilliSource::HttpResponse::Result::k_failed;
 
 			u64 m_totalBytesRead = 0;
@@ -34,6 +34,7 @@
 
 #import <ChilliSource/Core/String/StringUtils.h>
 
+#import <cstdio>
 #import <iostream>
 #import <UIKit/UIKit.h>
 #import <sys/types.h>
@@ -521,6 +522,19 @@ namespace CSBackend
         }
         //--------------------------------------------------------------
         //--------------------------------------------------------------
+        bool FileSystem::RenameFile(ChilliSource::StorageLocation in_storageLocation, const std::string& in_sourceFilePath, const std::string& in_destinationFilePath) const
+        {
+            CS_ASSERT(IsStorageLocationWritable(in_storageLocation), "File System: Trying to rename a file in a read only storage location.");
+            
+            //NSFileManager will not replace an existing file, so use rename() which replaces the destination atomically.
+            std::string storageLocationPath = GetAbsolutePathToStorageLocation(in_storageLocation);
+            std::string sourceFilePath = storageLocationPath + in_sourceFilePath;
+            std::string destinationFilePath = storageLocationPath + in_destinationFilePath;
+            
+            return (rename(sourceFilePath.c_str(), destinationFilePath.c_str()) == 0);
+        }
+        //--------------------------------------------------------------
+        //--------------------------------------------------------------
         bool FileSystem::DeleteDirectory(ChilliSource::StorageLocation in_storageLocation, const std::string& in_directoryPath) const
         {
             CS_ASSERT(IsStorageLocationWritable(in_storageLocation), "File System: Trying to delete from a read only storage location.");
@@ -61,8 +61,9 @@ typedef std::function<void(ChilliSource::HttpResponse::Result in_result, u32 in_
 /// @param in_result - The result.
 /// @param in_responseCode - The response code.
 /// @param in_data - The data in string form.
+/// @param in_headers - The response headers.
 //--------------------------------------------------------------------------------------------------
-typedef std::function<void(ChilliSource::HttpResponse::Result in_result, u32 in_responseCode, const std::string& in_data)> CompleteDelegate;
+typedef std::function<void(ChilliSource::HttpResponse::Result in_result, u32 in_responseCode, const std::string& in_data, const ChilliSource::ParamDictionary& in_headers)> CompleteDelegate;
 
 
 //--------------------------------------------------------------------------------------------------
@@ -75,6 +76,7 @@ typedef std::function<void(ChilliSource::HttpResponse::Result in_result, u32 in_
 {
     u32 m_responseCode;
     u32 m_maxBufferSize;
+    ChilliSource::ParamDictionary m_responseHeaders;
     
     ConnectionEstablishedDelegate m_connectionEstablishedDelegate;
     FlushedDelegate m_flushedDelegate;
@@ -93,7 +95,7 @@ typedef std::function<void(ChilliSource::HttpResponse::Result in_result, u32 in_
 /// @param in_completeDelegate - Delegate to call when connection is completed.
 /// @param in_bufferSize - The buffer size of the request in bytes after which we flush
 //--------------------------------------------------------------------------------------------------
-- (id) initWithConnectionDelegate:(const ConnectionEstablishedDelegate&)in_connectionEstablishedDelegate andFlushedDelegate:(const FlushedDelegate&)in_flushedDelegate andCompleteDelegate:(const FlushedDelegate&)in_completeDelegate andMaxBufferSize:(u32) in_bufferSize;
+- (id) initWithConnectionDelegate:(const ConnectionEstablishedDelegate&)in_connectionEstablishedDelegate andFlushedDelegate:(const FlushedDelegate&)in_flushedDelegate andCompleteDelegate:(const CompleteDelegate&)in_completeDelegate andMaxBufferSize:(u32) in_bufferSize;
 //--------------------------------------------------------------------------------------------------
 /// Cleans up the delegate.
 ///
@@ -37,7 +37,7 @@
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
-- (id) initWithConnectionDelegate:(const ConnectionEstablishedDelegate&)in_connectionEstablishedDelegate andFlushedDelegate:(const FlushedDelegate&)in_flushedDelegate andCompleteDelegate:(const FlushedDelegate&)in_completeDelegate andMaxBufferSize:(u32) in_bufferSize
+- (id) initWithConnectionDelegate:(const ConnectionEstablishedDelegate&)in_connectionEstablishedDelegate andFlushedDelegate:(const FlushedDelegate&)in_flushedDelegate andCompleteDelegate:(const CompleteDelegate&)in_completeDelegate andMaxBufferSize:(u32) in_bufferSize
 {
     if (self = [super init])
     {
@@ -77,6 +77,15 @@
     
     m_responseCode = static_cast<u32>(((NSHTTPURLResponse*)in_response).statusCode);
     
+    m_responseHeaders.clear();
+    NSDictionary* headerFields = ((NSHTTPURLResponse*)in_response).allHeaderFields;
+    for (NSString* key in headerFields)
+    {
+        NSString* value = [headerFields objectForKey:key];
+        m_responseHeaders.SetValue([NSStringUtils newUTF8StringWithNSString:key], [NSStringUtils newUTF8StringWithNSString:value]);
+    }
+    
+    
     if(m_connectionEstablishedDelegate)
     {
         m_connectionEstablishedDelegate(in_response.expectedContentLength);
@@ -125,7 +134,7 @@
     [m_data release];
     m_data = nil;
     
-    m_completeDelegate(ChilliSource::HttpResponse::Result::k_completed, m_responseCode, data);
+    m_completeDelegate(ChilliSource::HttpResponse::Result::k_completed, m_responseCode, data, m_responseHeaders);
 }
 //-----------------------------------------------------------------------------
 /// Called if a connection fails.
@@ -140,7 +149,7 @@
     std::string errorMessage = [NSStringUtils newUTF8StringWithNSString:[in_error localizedDescription]];
     CS_LOG_VERBOSE("HTTP Request error: " + errorMessage);
 
-    m_completeDelegate(ChilliSource::HttpResponse::Result::k_failed, m_responseCode, "");
+    m_completeDelegate(ChilliSource::HttpResponse::Result::k_failed, m_responseCode, "", ChilliSource::ParamDictionary());
 }
 //-----------------------------------------------------------------------------
 /// Called to check how a response should be cached. We don't want to cache
@@ -103,7 +103,7 @@ namespace CSBackend
                         });
                     };
                     
-                    auto connectionCompleteDelegate = [=](ChilliSource::HttpResponse::Result in_result, u32 in_responseCode, const std::string& in_data)
+                    auto connectionCompleteDelegate = [=](ChilliSource::HttpResponse::Result in_result, u32 in_responseCode, const std::string& in_data, const ChilliSource::ParamDictionary& in_headers)
                     {
                         ChilliSource::Application::Get()->GetTaskScheduler()->ScheduleTask(ChilliSource::TaskType::k_mainThread, [=](const ChilliSource::TaskContext& taskContext)
                         {
@@ -113,7 +113,7 @@ namespace CSBackend
                                 *complete = true;
                                 m_downloadedBytes += in_data.length();
                                 
-                                m_completionDelegate(this, ChilliSource::HttpResponse(in_result, in_responseCode, in_data));
+                                m_completionDelegate(this, ChilliSource::HttpResponse(in_result, in_responseCode, in_data, in_headers));
                             }
                         });
                     };
@@ -60,6 +60,7 @@
 #include <ChilliSource/Rendering/RenderCommand/Commands/LoadCubemapRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/LoadTextureRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/RenderInstanceRenderCommand.h>
+#include <ChilliSource/Rendering/RenderCommand/Commands/RenderInstancesRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/RestoreMeshRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/RestoreRenderTargetGroupCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/RestoreCubemapRenderCommand.h>
@@ -71,11 +72,17 @@
 #include <ChilliSource/Rendering/RenderCommand/Commands/UnloadCubemapRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/UnloadTextureRenderCommand.h>
 
+#include <cstring>
+
 #ifdef CS_TARGETPLATFORM_IOS
 #   import <CSBackend/Platform/iOS/Core/Base/CSAppDelegate.h>
 #   import <CSBackend/Platform/iOS/Core/Base/CSGLViewController.h>
 #endif
 
+#ifdef CS_TARGETPLATFORM_ANDROID
+#   include <EGL/egl.h>
+#endif
+
 namespace CSBackend
 {
     namespace OpenGL
@@ -86,6 +93,7 @@ namespace CSBackend
             const std::string k_uniformWorldMat = "u_worldMat";
             const std::string k_uniformViewMat = "u_viewMat";
             const std::string k_uniformNormalMat = "u_normalMat";
+            const std::string k_uniformViewProjMat = "u_viewProjMat";
             
             /// Converts from a ChilliSource polygon type to a OpenGL polygon type.
             ///
@@ -128,6 +136,119 @@ namespace CSBackend
                         return GL_UNSIGNED_SHORT;
                 }
             }
+            
+#if defined CS_TARGETPLATFORM_ANDROID
+            PFNGLVERTEXATTRIBDIVISOREXTPROC g_vertexAttribDivisor = nullptr;
+            PFNGLDRAWELEMENTSINSTANCEDEXTPROC g_drawElementsInstanced = nullptr;
+            PFNGLDRAWARRAYSINSTANCEDEXTPROC g_drawArraysInstanced = nullptr;
+            
+            /// Looks up the instanced array entry points with the given name suffix, which is empty
+            /// for the core GLES 3.0 functions and "EXT" for the GL_EXT_instanced_arrays extension.
+            /// These are not exported by libGLESv2 on all devices, so are queried through EGL.
+            ///
+            /// @param suffix
+            ///     The entry point name suffix.
+            ///
+            /// @return Whether or not all of the entry points were found.
+            ///
+            bool LoadInstancingEntryPoints(const std::string& suffix) noexcept
+            {
+                g_vertexAttribDivisor = reinterpret_cast<PFNGLVERTEXATTRIBDIVISOREXTPROC>(eglGetProcAddress(("glVertexAttribDivisor" + suffix).c_str()));
+                g_drawElementsInstanced = reinterpret_cast<PFNGLDRAWELEMENTSINSTANCEDEXTPROC>(eglGetProcAddress(("glDrawElementsInstanced" + suffix).c_str()));
+                g_drawArraysInstanced = reinterpret_cast<PFNGLDRAWARRAYSINSTANCEDEXTPROC>(eglGetProcAddress(("glDrawArraysInstanced" + suffix).c_str()));
+                
+                return (g_vertexAttribDivisor != nullptr && g_drawElementsInstanced != nullptr && g_drawArraysInstanced != nullptr);
+            }
+#endif
+            
+            /// Calculates whether or not the current OpenGL context supports instanced arrays. This
+            /// requires OpenGL 3.3 on Windows, the GL_EXT_instanced_arrays extension on iOS, and either
+            /// an OpenGL ES 3.0 context or the GL_EXT_instanced_arrays extension on Android.
+            ///
+            /// @return Whether or not instanced arrays are supported.
+            ///
+            bool IsInstancingSupported() noexcept
+            {
+#if defined CS_TARGETPLATFORM_WINDOWS
+                return GLEW_VERSION_3_3 == GL_TRUE;
+#elif defined CS_TARGETPLATFORM_IOS
+                auto extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+                return (extensions && strstr(extensions, "GL_EXT_instanced_arrays"));
+#elif defined CS_TARGETPLATFORM_ANDROID
+                auto version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+                if (version && strncmp(version, "OpenGL ES 3", strlen("OpenGL ES 3")) == 0 && LoadInstancingEntryPoints(""))
+                {
+                    return true;
+                }
+                
+                auto extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+                return (extensions && strstr(extensions, "GL_EXT_instanced_arrays") && LoadInstancingEntryPoints("EXT"));
+#else
+                return false;
+#endif
+            }
+            
+            constexpr u32 k_numMatrixColumns = 4;
+            
+            /// Sets the rate at which the given vertex attribute advances during instanced rendering.
+            ///
+            /// @param index
+            ///     The index of the vertex attribute.
+            /// @param divisor
+            ///     The number of instances that will pass between updates of the attribute.
+            ///
+            void VertexAttribDivisor(GLuint index, GLuint divisor) noexcept
+            {
+#if defined CS_TARGETPLATFORM_IOS
+                glVertexAttribDivisorEXT(index, divisor);
+#elif defined CS_TARGETPLATFORM_ANDROID
+                g_vertexAttribDivisor(index, divisor);
+#else
+                glVertexAttribDivisor(index, divisor);
+#endif
+            }
+            
+            /// Renders multiple instances of the given indexed geometry.
+            ///
+            /// @param mode
+            ///     The OpenGL polygon type.
+            /// @param count
+            ///     The number of indices.
+            /// @param type
+            ///     The OpenGL index type.
+            /// @param numInstances
+            ///     The number of instances to render.
+            ///
+            void DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, GLsizei numInstances) noexcept
+            {
+#if defined CS_TARGETPLATFORM_IOS
+                glDrawElementsInstancedEXT(mode, count, type, 0, numInstances);
+#elif defined CS_TARGETPLATFORM_ANDROID
+                g_drawElementsInstanced(mode, count, type, 0, numInstances);
+#else
+                glDrawElementsInstanced(mode, count, type, 0, numInstances);
+#endif
+            }
+            
+            /// Renders multiple instances of the given non-indexed geometry.
+            ///
+            /// @param mode
+            ///     The OpenGL polygon type.
+            /// @param count
+            ///     The number of vertices.
+            /// @param numInstances
+            ///     The number of instances to render.
+            ///
+            void DrawArraysInstanced(GLenum mode, GLsizei count, GLsizei numInstances) noexcept
+            {
+#if defined CS_TARGETPLATFORM_IOS
+                glDrawArraysInstancedEXT(mode, 0, count, numInstances);
+#elif defined CS_TARGETPLATFORM_ANDROID
+                g_drawArraysInstanced(mode, 0, count, numInstances);
+#else
+                glDrawArraysInstanced(mode, 0, count, numInstances);
+#endif
+            }
         }
         
         //------------------------------------------------------------------------------
@@ -211,6 +332,9 @@ namespace CSBackend
                         case ChilliSource::RenderCommand::Type::k_renderInstance:
                             RenderInstance(static_cast<const ChilliSource::RenderInstanceRenderCommand*>(renderCommand));
                             break;
+                        case ChilliSource::RenderCommand::Type::k_renderInstances:
+                            RenderInstances(static_cast<const ChilliSource::RenderInstancesRenderCommand*>(renderCommand));
+                            break;
                         case ChilliSource::RenderCommand::Type::k_end:
                             End();
                             break;
@@ -247,6 +371,8 @@ namespace CSBackend
             {
                 m_glDynamicMesh->Invalidate();
             }
+            
+            m_instanceBufferHandle = 0;
         }
         
         //------------------------------------------------------------------------------
@@ -263,6 +389,7 @@ namespace CSBackend
         {
             m_textureUnitManager = GLTextureUnitManagerUPtr(new GLTextureUnitManager());
             m_glDynamicMesh = GLDynamicMeshUPtr(new GLDynamicMesh(ChilliSource::RenderDynamicMesh::k_maxVertexDataSize, ChilliSource::RenderDynamicMesh::k_maxIndexDataSize));
+            m_isInstancingSupported = IsInstancingSupported();
             
             ResetCache();
         }
@@ -595,36 +722,72 @@ namespace CSBackend
             CS_ASSERT(m_currentMaterial, "A material must be applied before rendering a mesh.");
             CS_ASSERT(m_currentShader, "A shader must be applied before rendering a mesh.");
             
+            DrawInstance(renderCommand->GetWorldMatrix());
+        }
+        
+        //------------------------------------------------------------------------------
+        void RenderCommandProcessor::RenderInstances(const ChilliSource::RenderInstancesRenderCommand* renderCommand) noexcept
+        {
+            CS_ASSERT(m_currentMaterial, "A material must be applied before rendering a mesh.");
+            CS_ASSERT(m_currentShader, "A shader must be applied before rendering a mesh.");
+            CS_ASSERT(m_currentMesh, "A static mesh must be applied before rendering instances.");
+            
+            auto worldMatrices = renderCommand->GetWorldMatrices();
+            auto numInstances = renderCommand->GetNumInstances();
+            
             auto glShader = static_cast<GLShader*>(m_currentShader->GetExtraData());
-            glShader->SetUniform(k_uniformWorldMat, renderCommand->GetWorldMatrix(), GLShader::FailurePolicy::k_silent);
-            glShader->SetUniform(k_uniformViewMat, m_currentCamera.GetViewMatrix(), GLShader::FailurePolicy::k_silent);
-            glShader->SetUniform(k_uniformWVPMat, renderCommand->GetWorldMatrix() * m_currentCamera.GetViewProjectionMatrix(), GLShader::FailurePolicy::k_silent);
-            glShader->SetUniform(k_uniformNormalMat, ChilliSource::Matrix4::Transpose(ChilliSource::Matrix4::Inverse(renderCommand->GetWorldMatrix())), GLShader::FailurePolicy::k_silent);
+            auto attributeHandle = glShader->GetAttributeHandle(GLShader::k_attributeInstanceWorldMat);
             
-            if (m_currentMesh)
+            if (m_isInstancingSupported && attributeHandle >= 0)
             {
-                if (m_currentMesh->GetNumIndices() > 0)
+                glShader->SetUniform(k_uniformViewMat, m_currentCamera.GetViewMatrix(), GLShader::FailurePolicy::k_silent);
+                glShader->SetUniform(k_uniformViewProjMat, m_currentCamera.GetViewProjectionMatrix(), GLShader::FailurePolicy::k_silent);
+                
+                if (m_instanceBufferHandle == 0)
                 {
-                    glDrawElements(ToGLPolygonType(m_currentMesh->GetPolygonType()), m_currentMesh->GetNumIndices(), ToGLIndexType(m_currentMesh->GetIndexFormat()), 0);
+                    glGenBuffers(1, &m_instanceBufferHandle);
+                    CS_ASSERT(m_instanceBufferHandle != 0, "Invalid instance buffer.");
                 }
-                else
+                
+                glBindBuffer(GL_ARRAY_BUFFER, m_instanceBufferHandle);
+                glBufferData(GL_ARRAY_BUFFER, sizeof(ChilliSource::Matrix4) * numInstances, worldMatrices, GL_STREAM_DRAW);
+                
+                // A matrix attribute occupies one attribute location per column.
+                for (u32 i = 0; i < k_numMatrixColumns; ++i)
                 {
-                    glDrawArrays(ToGLPolygonType(m_currentMesh->GetPolygonType()), 0, m_currentMesh->GetNumVertices());
+                    auto location = GLuint(attributeHandle) + i;
+                    auto offset = reinterpret_cast<const GLvoid*>(sizeof(f32) * 4 * i);
+                    
+                    glEnableVertexAttribArray(location);
+                    glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(ChilliSource::Matrix4), offset);
+                    VertexAttribDivisor(location, 1);
                 }
-            }
-            else
-            {
-                if (m_glDynamicMesh->GetNumIndices() > 0)
+                
+                if (m_currentMesh->GetNumIndices() > 0)
                 {
-                    glDrawElements(ToGLPolygonType(m_glDynamicMesh->GetPolygonType()), m_glDynamicMesh->GetNumIndices(), ToGLIndexType(m_glDynamicMesh->GetIndexFormat()), 0);
+                    DrawElementsInstanced(ToGLPolygonType(m_currentMesh->GetPolygonType()), m_currentMesh->GetNumIndices(), ToGLIndexType(m_currentMesh->GetIndexFormat()), numInstances);
                 }
                 else
                 {
-                    glDrawArrays(ToGLPolygonType(m_glDynamicMesh->GetPolygonType()), 0, m_glDynamicMesh->GetNumVertices());
+                    DrawArraysInstanced(ToGLPolygonType(m_currentMesh->GetPolygonType()), m_currentMesh->GetNumVertices(), numInstances);
+                }
+                
+                for (u32 i = 0; i < k_numMatrixColumns; ++i)
+                {
+                    auto location = GLuint(attributeHandle) + i;
+                    
+                    VertexAttribDivisor(location, 0);
+                    glDisableVertexAttribArray(location);
                 }
+                
+                CS_ASSERT_NOGLERROR("An OpenGL error occurred while rendering instances.");
+                return;
             }
             
-            CS_ASSERT_NOGLERROR("An OpenGL error occurred while rendering an instance.");
+            for (u32 i = 0; i < numInstances; ++i)
+            {
+                DrawInstance(worldMatrices[i]);
+            }
         }
         
         //------------------------------------------------------------------------------
@@ -705,6 +868,57 @@ namespace CSBackend
             CS_SAFEDELETE(glTargetGroup);
         }
         
+        //------------------------------------------------------------------------------
+        void RenderCommandProcessor::DrawInstance(const ChilliSource::Matrix4& worldMatrix) noexcept
+        {
+            auto glShader = static_cast<GLShader*>(m_currentShader->GetExtraData());
+            glShader->SetUniform(k_uniformWorldMat, worldMatrix, GLShader::FailurePolicy::k_silent);
+            glShader->SetUniform(k_uniformViewMat, m_currentCamera.GetViewMatrix(), GLShader::FailurePolicy::k_silent);
+            glShader->SetUniform(k_uniformWVPMat, worldMatrix * m_currentCamera.GetViewProjectionMatrix(), GLShader::FailurePolicy::k_silent);
+            glShader->SetUniform(k_uniformNormalMat, ChilliSource::Matrix4::Transpose(ChilliSource::Matrix4::Inverse(worldMatrix)), GLShader::FailurePolicy::k_silent);
+            
+            // Shaders written for instancing read the world matrix from a vertex attribute, so when drawing a
+            // single instance it is supplied as a constant attribute value instead.
+            auto instanceAttributeHandle = glShader->GetAttributeHandle(GLShader::k_attributeInstanceWorldMat);
+            if (instanceAttributeHandle >= 0)
+            {
+                glShader->SetUniform(k_uniformViewProjMat, m_currentCamera.GetViewProjectionMatrix(), GLShader::FailurePolicy::k_silent);
+                
+                for (u32 i = 0; i < k_numMatrixColumns; ++i)
+                {
+                    auto location = GLuint(instanceAttributeHandle) + i;
+                    
+                    glDisableVertexAttribArray(location);
+                    glVertexAttrib4fv(location, worldMatrix.m + 4 * i);
+                }
+            }
+            
+            if (m_currentMesh)
+            {
+                if (m_currentMesh->GetNumIndices() > 0)
+                {
+                    glDrawElements(ToGLPolygonType(m_currentMesh->GetPolygonType()), m_currentMesh->GetNumIndices(), ToGLIndexType(m_currentMesh->GetIndexFormat()), 0);
+                }
+                else
+                {
+                    glDrawArrays(ToGLPolygonType(m_currentMesh->GetPolygonType()), 0, m_currentMesh->GetNumVertices());
+                }
+            }
+            else
+            {
+                if (m_glDynamicMesh->GetNumIndices() > 0)
+                {
+                    glDrawElements(ToGLPolygonType(m_glDynamicMesh->GetPolygonType()), m_glDynamicMesh->GetNumIndices(), ToGLIndexType(m_glDynamicMesh->GetIndexFormat()), 0);
+                }
+                else
+                {
+                    glDrawArrays(ToGLPolygonType(m_glDynamicMesh->GetPolygonType()), 0, m_glDynamicMesh->GetNumVertices());
+                }
+            }
+            
+            CS_ASSERT_NOGLERROR("An OpenGL error occurred while rendering an instance.");
+        }
+        
         //------------------------------------------------------------------------------
         void RenderCommandProcessor::ResetCache() noexcept
         {
@@ -726,6 +940,17 @@ namespace CSBackend
             // However, if this is called the context is about to be lost anyway so it doesn't need to be
             // cleaned up, so we can just invalidate it.
             m_glDynamicMesh->Invalidate();
+            
+#if defined CS_TARGETPLATFORM_WINDOWS || defined CS_TARGETPLATFORM_IOS
+            // Windows and iOS render on the main thread, so the context is still current and the instance
+            // buffer can be released. On Android the context is owned by the render thread and is lost
+            // along with the buffer.
+            if (m_instanceBufferHandle != 0)
+            {
+                glDeleteBuffers(1, &m_instanceBufferHandle);
+                m_instanceBufferHandle = 0;
+            }
+#endif
         }
     }
 }
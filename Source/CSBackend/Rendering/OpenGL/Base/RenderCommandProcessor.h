@@ -27,6 +27,7 @@
 
 #include <CSBackend/Rendering/OpenGL/ForwardDeclarations.h>
 
+#include <CSBackend/Rendering/OpenGL/Base/GLIncludes.h>
 #include <CSBackend/Rendering/OpenGL/Camera/GLCamera.h>
 #include <CSBackend/Rendering/OpenGL/Lighting/GLLight.h>
 #include <CSBackend/Rendering/OpenGL/Model/GLDynamicMesh.h>
@@ -233,6 +234,17 @@ namespace CSBackend
             ///
             void RenderInstance(const ChilliSource::RenderInstanceRenderCommand* renderCommand) noexcept;
             
+            /// Renders multiple instances of the static mesh described by the current OpenGL context
+            /// state. If the platform supports instanced arrays and the current shader declares the
+            /// per-instance world matrix attribute, such as the stock Static-UnlitInstanced shader, this
+            /// will be performed using a single instanced draw call, otherwise each instance is drawn in
+            /// turn. A camera, material and mesh must all currently be applied to the context.
+            ///
+            /// @param renderCommand
+            ///     The render command
+            ///
+            void RenderInstances(const ChilliSource::RenderInstancesRenderCommand* renderCommand) noexcept;
+            
             /// Ends rendering to the current render target.
             ///
             void End() noexcept;
@@ -272,14 +284,26 @@ namespace CSBackend
             ///
             void UnloadTargetGroup(const ChilliSource::UnloadTargetGroupRenderCommand* renderCommand) noexcept;
             
+            /// Draws a single instance of the mesh described by the current OpenGL context state with
+            /// the given world matrix. If the current shader declares the per-instance world matrix
+            /// attribute, the matrix is also supplied as the constant value of that attribute so that
+            /// instanced shaders can be used whether or not instancing is available.
+            ///
+            /// @param worldMatrix
+            ///     The world matrix of the instance.
+            ///
+            void DrawInstance(const ChilliSource::Matrix4& worldMatrix) noexcept;
+            
             /// Resets the cached values back to thier original state.
             ///
             void ResetCache() noexcept;
             
             bool m_initRequired = true;
+            bool m_isInstancingSupported = false;
             
             GLTextureUnitManagerUPtr m_textureUnitManager;
             GLDynamicMeshUPtr m_glDynamicMesh;
+            GLuint m_instanceBufferHandle = 0;
             
             GLCamera m_currentCamera;
             GLLightUPtr m_currentLight;
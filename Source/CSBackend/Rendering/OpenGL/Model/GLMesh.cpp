@@ -30,6 +30,8 @@
 #include <CSBackend/Rendering/OpenGL/Model/GLMeshUtils.h>
 #include <CSBackend/Rendering/OpenGL/Shader/GLShader.h>
 
+#include <cstring>
+
 namespace CSBackend
 {
     namespace OpenGL
@@ -47,7 +49,7 @@ namespace CSBackend
         
         //------------------------------------------------------------------------------
         GLMesh::GLMesh(const u8* vertexData, u32 vertexDataSize, const u8* indexData, u32 indexDataSize, ChilliSource::RenderMesh* renderMesh) noexcept
-            : m_vertexDataSize(vertexDataSize), m_indexDataSize(indexDataSize), m_renderMesh(renderMesh)
+            : m_indexDataSize(indexDataSize), m_vertexDataSize(vertexDataSize), m_renderMesh(renderMesh)
         {
             BuildMesh(vertexData, vertexDataSize, indexData, indexDataSize);
             
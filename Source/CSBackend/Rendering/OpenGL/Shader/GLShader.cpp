@@ -125,6 +125,7 @@ namespace CSBackend
         const std::string GLShader::k_attributeColour = "a_colour";
         const std::string GLShader::k_attributeWeights = "a_weights";
         const std::string GLShader::k_attributeJointIndices = "a_jointIndices";
+        const std::string GLShader::k_attributeInstanceWorldMat = "a_instanceWorldMat";
     
         //------------------------------------------------------------------------------
         GLShader::GLShader(const std::string& vertexShader, const std::string& fragmentShader) noexcept
@@ -253,17 +254,30 @@ namespace CSBackend
             CS_ASSERT_NOGLERROR("An OpenGL error occurred while setting attribute.");
         }
         
+        //------------------------------------------------------------------------------
+        GLint GLShader::GetAttributeHandle(const std::string& name) const noexcept
+        {
+            auto it = m_attributeHandles.find(name);
+            if(it == m_attributeHandles.end())
+            {
+                return -1;
+            }
+            
+            return it->second;
+        }
+        
         //------------------------------------------------------------------------------
         void GLShader::BuildAttributeHandleMap() noexcept
         {
-            static const std::array<std::string, 6> attribNames =
+            static const std::array<std::string, 7> attribNames =
             {{
                 k_attributePosition,
                 k_attributeNormal,
                 k_attributeTexCoord,
                 k_attributeColour,
                 k_attributeWeights,
-                k_attributeJointIndices
+                k_attributeJointIndices,
+                k_attributeInstanceWorldMat
             }};
             
             for(const auto& name : attribNames)
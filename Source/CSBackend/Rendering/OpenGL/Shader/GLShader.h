@@ -59,6 +59,12 @@ namespace CSBackend
             static const std::string k_attributeWeights;
             static const std::string k_attributeJointIndices;
             
+            /// The per-instance world matrix attribute. Shaders which declare this will be rendered
+            /// using a single instanced draw call for runs of identical static meshes, where the
+            /// platform supports it.
+            ///
+            static const std::string k_attributeInstanceWorldMat;
+            
             /// An enum describing the different types of failure policy. This is used when setting
             /// uniforms to judge if an assertion should occur when the uniform doesn't exist.
             ///
@@ -197,6 +203,14 @@ namespace CSBackend
             ///
             void SetAttribute(const std::string& name, GLint size, GLenum type, GLboolean isNormalised, GLsizei stride, const GLvoid* offset) noexcept;
             
+            /// @param name
+            ///     The name of the attribute.
+            ///
+            /// @return The handle of the attribute with the given name, or -1 if it doesn't exist
+            ///     in the shader.
+            ///
+            GLint GetAttributeHandle(const std::string& name) const noexcept;
+            
             /// Called when graphics memory is lost, usually through the GLContext being destroyed
             /// on Android. Function will set a flag to handle safe destructing of this object, preventing
             /// us from trying to delete invalid memory.
@@ -111,7 +111,7 @@ namespace CSBackend
         
         //------------------------------------------------------------------------------
         GLCubemap::GLCubemap(const std::array<std::unique_ptr<const u8[]>, 6>& textureData, u32 dataSize, const ChilliSource::RenderTexture* renderTexture) noexcept
-        : m_imageDataSize(dataSize), m_renderTexture(renderTexture)
+        : m_renderTexture(renderTexture), m_imageDataSize(dataSize)
         {
 #ifdef CS_ENABLE_DEBUG
             auto renderCapabilities = ChilliSource::Application::Get()->GetSystem<ChilliSource::RenderCapabilities>();
@@ -122,7 +122,7 @@ namespace CSBackend
             
             if(k_shouldBackupMeshDataFromMemory && renderTexture->ShouldBackupData())
             {
-                for(auto i=0; i<textureData.size(); ++i)
+                for(u32 i=0; i<textureData.size(); ++i)
                 {
                     u8* imageDataCopy = new u8[dataSize];
                     memcpy(imageDataCopy, textureData[i].get(), dataSize);
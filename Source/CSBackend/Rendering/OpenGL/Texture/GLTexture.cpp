@@ -103,7 +103,7 @@ namespace CSBackend
         
         //------------------------------------------------------------------------------
         GLTexture::GLTexture(const u8* data, u32 dataSize, const ChilliSource::RenderTexture* renderTexture) noexcept
-            :m_imageDataSize(dataSize), m_renderTexture(renderTexture)
+            :m_renderTexture(renderTexture), m_imageDataSize(dataSize)
         {
 #ifdef CS_ENABLE_DEBUG
             auto renderCapabilities = ChilliSource::Application::Get()->GetSystem<ChilliSource::RenderCapabilities>();
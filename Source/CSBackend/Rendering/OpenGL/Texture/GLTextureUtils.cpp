@@ -92,6 +92,7 @@ namespace CSBackend
             void UploadImageDataPVR2(GLenum target, ChilliSource::ImageFormat format, const ChilliSource::Integer2& dimensions, const u8* imageData, u32 imageDataSize)
             {
 #ifndef CS_TARGETPLATFORM_IOS
+                (void)target; (void)format; (void)dimensions; (void)imageData; (void)imageDataSize;
                 CS_LOG_FATAL("PVR compression is only supported on iOS");
 #endif
                 
@@ -116,6 +117,7 @@ namespace CSBackend
             void UploadImageDataPVR4(GLenum target, ChilliSource::ImageFormat format, const ChilliSource::Integer2& dimensions, const u8* imageData, u32 imageDataSize)
             {
 #ifndef CS_TARGETPLATFORM_IOS
+                (void)target; (void)format; (void)dimensions; (void)imageData; (void)imageDataSize;
                 CS_LOG_FATAL("PVR compression is only supported on iOS");
 #endif
                 
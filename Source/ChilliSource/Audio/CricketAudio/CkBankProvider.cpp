@@ -172,7 +172,6 @@ namespace ChilliSource
     {
         if(m_asyncRequests.empty() == false)
         {
-            m_asyncRequests.lock();
             for (auto it = m_asyncRequests.begin(); it != m_asyncRequests.end();)
             {
                 if (it->m_bank->isLoaded() == true)
@@ -200,7 +199,6 @@ namespace ChilliSource
                     ++it;
                 }
             }
-            m_asyncRequests.unlock();
         }
     }
 }
\ No newline at end of file
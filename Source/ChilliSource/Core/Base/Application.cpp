@@ -34,6 +34,7 @@
 #include <ChilliSource/Core/Base/PlatformSystem.h>
 #include <ChilliSource/Core/Base/Screen.h>
 #include <ChilliSource/Core/DialogueBox/DialogueBoxSystem.h>
+#include <ChilliSource/Core/Event/EventQueue.h>
 #include <ChilliSource/Core/File/AppDataStore.h>
 #include <ChilliSource/Core/File/TaggedFilePathResolver.h>
 #include <ChilliSource/Core/Image/CSImageProvider.h>
@@ -133,7 +134,7 @@ namespace ChilliSource
 
     //------------------------------------------------------------------------------
     Application::Application(ChilliSource::SystemInfoCUPtr systemInfo) noexcept
-        : m_updateInterval(k_defaultUpdateInterval), m_frameIndex(0), m_systemInfo(std::move(systemInfo))
+        : m_systemInfo(std::move(systemInfo)), m_frameIndex(0), m_updateInterval(k_defaultUpdateInterval)
     {
         m_appVersion = m_systemInfo->GetAppVersion();
     }
@@ -477,6 +478,9 @@ namespace ChilliSource
         //Create all application systems.
         m_isSystemCreationAllowed = true;
         CreateDefaultSystems();
+#ifdef CS_ENABLE_LOGTOFILE
+        Logging::Get()->CreateLogFile();
+#endif
         CreateSystems();
         m_isSystemCreationAllowed = false;
         
@@ -573,6 +577,8 @@ namespace ChilliSource
         
         m_taskScheduler->ExecuteMainThreadTasks();
         
+        EventQueue::Dispatch();
+        
         ProcessRenderSnapshotEvent();
         
         ++m_frameIndex;
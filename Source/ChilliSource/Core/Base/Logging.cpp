@@ -31,17 +31,15 @@
 #include <ChilliSource/Core/Base/Application.h>
 #include <ChilliSource/Core/File/FileSystem.h>
 
+#ifdef CS_ENABLE_LOGTOFILE
+#include <ChilliSource/Core/File/FileStream/TextOutputStream.h>
+#endif
+
 #include <iostream>
 
 #ifdef CS_TARGETPLATFORM_ANDROID
 #include <android/log.h>
 #include <cstdlib>
-extern "C"
-{
-#define CS_ANDROID_LOG_VERBOSE(...) __android_log_print(ANDROID_LOG_DEBUG, "Chilli Source", "%s", __VA_ARGS__)
-#define CS_ANDROID_LOG_WARNING(...) __android_log_print(ANDROID_LOG_WARN, "Chilli Source", "%s", __VA_ARGS__)
-#define CS_ANDROID_LOG_ERROR(...) __android_log_print(ANDROID_LOG_ERROR, "Chilli Source", "%s", __VA_ARGS__)
-}
 #endif
 
 #ifdef CS_TARGETPLATFORM_WINDOWS
@@ -67,9 +65,42 @@ namespace ChilliSource
     namespace
     {
 #ifdef CS_ENABLE_LOGTOFILE
-        const u32 k_maxLogBufferSize = 2048;
         const std::string k_logFileName = "ChilliSourceLog.txt";
 #endif
+        
+        /// The number of messages which can be queued. This must be a power of two.
+        ///
+        /// Every thread pushes to this one bounded queue rather than to a buffer of its
+        /// own. Messages have to be output in the order they were logged across threads,
+        /// which per-thread buffers could only provide by timestamping and merging them,
+        /// and the threads that log include platform threads the engine doesn't own, so
+        /// buffers couldn't be registered and released reliably, or drained by a fatal
+        /// error on another thread. Queuing costs a single compare-exchange per message;
+        /// LoggingBenchmark in Tests measures it with contended task pool threads.
+        const u32 k_queueCapacity = 1024;
+        const u32 k_queueMask = k_queueCapacity - 1;
+        
+        /// @param in_logLevel
+        ///     The logging level.
+        ///
+        /// @return The prefix which should be output before messages of the given level.
+        ///
+        const char* GetPrefix(Logging::LogLevel in_logLevel)
+        {
+            switch (in_logLevel)
+            {
+                case Logging::LogLevel::k_verbose:
+                    return "";
+                case Logging::LogLevel::k_warning:
+                    return "WARNING: ";
+                case Logging::LogLevel::k_error:
+                    return "ERROR: ";
+                case Logging::LogLevel::k_fatal:
+                    return "FATAL: ";
+            }
+            
+            return "";
+        }
     }
     
     Logging* Logging::s_logging = nullptr;
@@ -94,42 +125,76 @@ namespace ChilliSource
     //----------------------------------------------
     //----------------------------------------------
     Logging::Logging()
-#ifdef CS_ENABLE_LOGTOFILE
-        : m_isFirstLog(true)
-#endif
+        : m_logLevel(LogLevel::k_verbose), m_entries(new LogEntry[k_queueCapacity]), m_enqueuePosition(0), m_dequeuePosition(0), m_isWriterWaiting(false), m_drainingThreadId(std::thread::id())
     {
+        for (u32 i = 0; i < k_queueCapacity; ++i)
+        {
+            m_entries[i].m_sequence.store(i, std::memory_order_relaxed);
+        }
+        
+        m_writerThread = std::thread(&Logging::WriterThreadMain, this);
+    }
+    //----------------------------------------------
+    //----------------------------------------------
+    void Logging::SetLogLevel(LogLevel in_logLevel) noexcept
+    {
+        m_logLevel.store(in_logLevel, std::memory_order_relaxed);
+    }
+    //----------------------------------------------
+    //----------------------------------------------
+    Logging::LogLevel Logging::GetLogLevel() const noexcept
+    {
+        return m_logLevel.load(std::memory_order_relaxed);
     }
     //----------------------------------------------
     //----------------------------------------------
-    void Logging::LogVerbose(const std::string &in_message)
+    void Logging::LogVerbose(std::string in_message)
     {
 #if defined CS_LOGLEVEL_VERBOSE
-        LogMessage(LogLevel::k_verbose, in_message);
+        if (IsLogLevelEnabled(LogLevel::k_verbose))
+        {
+            LogMessage(LogLevel::k_verbose, std::move(in_message));
+        }
 #endif
     }
     //----------------------------------------------
     //----------------------------------------------
-    void Logging::LogWarning(const std::string &in_message)
+    void Logging::LogWarning(std::string in_message)
     {
 #if defined CS_LOGLEVEL_VERBOSE || defined CS_LOGLEVEL_WARNING
-        LogMessage(LogLevel::k_warning, "WARNING: " + in_message);
+        if (IsLogLevelEnabled(LogLevel::k_warning))
+        {
+            LogMessage(LogLevel::k_warning, std::move(in_message));
+        }
 #endif
     }
     //----------------------------------------------
     //----------------------------------------------
-    void Logging::LogError(const std::string &in_message)
+    void Logging::LogError(std::string in_message)
     {
 #if defined CS_LOGLEVEL_VERBOSE || defined CS_LOGLEVEL_WARNING || defined CS_LOGLEVEL_ERROR
-        LogMessage(LogLevel::k_error, "ERROR: " + in_message);
+        if (IsLogLevelEnabled(LogLevel::k_error))
+        {
+            LogMessage(LogLevel::k_error, std::move(in_message));
+        }
 #endif
     }
     //----------------------------------------------
     //----------------------------------------------
-    void Logging::LogFatal(const std::string &in_message)
+    void Logging::LogFatal(std::string in_message)
     {
 #if defined CS_LOGLEVEL_VERBOSE || defined CS_LOGLEVEL_WARNING || defined CS_LOGLEVEL_ERROR || defined CS_LOGLEVEL_FATAL
-        LogMessage(LogLevel::k_error, "FATAL: " + in_message);
-        LogMessage(LogLevel::k_error, "Chilli Source is exiting...");
+        LogMessage(LogLevel::k_fatal, std::move(in_message));
+        Flush();
+        
+        if (m_drainingThreadId.load() != std::this_thread::get_id())
+        {
+            std::unique_lock<std::mutex> lock(m_writerMutex);
+            OutputMessage(LogLevel::k_fatal, "", "Chilli Source is exiting...");
+#ifdef CS_ENABLE_LOGTOFILE
+            LogToFile();
+#endif
+        }
 #endif
 
 #ifdef CS_TARGETPLATFORM_ANDROID
@@ -140,75 +205,205 @@ namespace ChilliSource
 #endif
 #endif
     }
+    //----------------------------------------------
+    //----------------------------------------------
+    void Logging::Flush() noexcept
+    {
+        //if this is called while outputting messages, such as from an assertion, the messages are already being drained.
+        if (m_drainingThreadId.load() == std::this_thread::get_id())
+        {
+            return;
+        }
+        
+        std::unique_lock<std::mutex> lock(m_writerMutex);
+        DrainQueue();
+    }
     //-----------------------------------------------------
     //-----------------------------------------------------
     void Logging::Destroy()
     {
+        {
+            std::unique_lock<std::mutex> lock(s_logging->m_writerMutex);
+            s_logging->m_isShuttingDown = true;
+        }
+        
+        s_logging->m_writerCondition.notify_one();
+        s_logging->m_writerThread.join();
+        s_logging->Flush();
+        
         CS_SAFEDELETE(s_logging);
     }
     //-----------------------------------------------------
     //-----------------------------------------------------
-    void Logging::LogMessage(LogLevel in_logLevel, const std::string& in_message)
+    void Logging::LogMessage(LogLevel in_logLevel, std::string in_message)
+    {
+        //messages logged while outputting messages are output immediately, as the queue can't be drained re-entrantly.
+        if (m_drainingThreadId.load() == std::this_thread::get_id())
+        {
+            OutputMessage(in_logLevel, GetPrefix(in_logLevel), in_message);
+            return;
+        }
+        
+        while (!TryQueueMessage(in_logLevel, in_message))
+        {
+            //the queue is full, so make space by outputting the queued messages on this thread.
+            Flush();
+        }
+        
+        //the writer only needs waking if it's waiting for messages. This fence pairs with the one in WriterThreadMain(),
+        //so either the writer sees the message before it waits, or this sees that it's waiting.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_isWriterWaiting.load(std::memory_order_relaxed))
+        {
+            //the writer holds the mutex until it is waiting, so locking it here ensures the notification isn't missed.
+            std::unique_lock<std::mutex> lock(m_writerMutex);
+            m_writerCondition.notify_one();
+        }
+    }
+    //-----------------------------------------------------
+    //-----------------------------------------------------
+    bool Logging::TryQueueMessage(LogLevel in_logLevel, std::string& io_message)
+    {
+        u32 position = m_enqueuePosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+            LogEntry& entry = m_entries[position & k_queueMask];
+            s32 difference = s32(entry.m_sequence.load(std::memory_order_acquire) - position);
+            
+            if (difference == 0)
+            {
+                if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    entry.m_logLevel = in_logLevel;
+                    entry.m_message = std::move(io_message);
+                    entry.m_sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = m_enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    //-----------------------------------------------------
+    //-----------------------------------------------------
+    bool Logging::HasQueuedMessages() const
+    {
+        u32 position = m_dequeuePosition.load(std::memory_order_relaxed);
+        const LogEntry& entry = m_entries[position & k_queueMask];
+        return (s32(entry.m_sequence.load(std::memory_order_acquire) - (position + 1)) >= 0);
+    }
+    //-----------------------------------------------------
+    //-----------------------------------------------------
+    void Logging::DrainQueue()
+    {
+        m_drainingThreadId.store(std::this_thread::get_id());
+        
+        u32 position = m_dequeuePosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+            LogEntry& entry = m_entries[position & k_queueMask];
+            if (s32(entry.m_sequence.load(std::memory_order_acquire) - (position + 1)) < 0)
+            {
+                break;
+            }
+            
+            OutputMessage(entry.m_logLevel, GetPrefix(entry.m_logLevel), entry.m_message);
+            entry.m_message.clear();
+            
+            entry.m_sequence.store(position + k_queueCapacity, std::memory_order_release);
+            m_dequeuePosition.store(++position, std::memory_order_relaxed);
+        }
+        
+#ifdef CS_ENABLE_LOGTOFILE
+        LogToFile();
+#endif
+        
+        m_drainingThreadId.store(std::thread::id());
+    }
+    //-----------------------------------------------------
+    //-----------------------------------------------------
+    void Logging::OutputMessage(LogLevel in_logLevel, const char* in_prefix, const std::string& in_message)
     {
 #ifdef CS_TARGETPLATFORM_ANDROID
         switch (in_logLevel)
         {
             case LogLevel::k_verbose:
-                CS_ANDROID_LOG_VERBOSE(in_message.c_str());
+                __android_log_print(ANDROID_LOG_DEBUG, "Chilli Source", "%s%s", in_prefix, in_message.c_str());
                 break;
             case LogLevel::k_warning:
-                CS_ANDROID_LOG_WARNING(in_message.c_str());
+                __android_log_print(ANDROID_LOG_WARN, "Chilli Source", "%s%s", in_prefix, in_message.c_str());
                 break;
             case LogLevel::k_error:
-                CS_ANDROID_LOG_ERROR(in_message.c_str());
+            case LogLevel::k_fatal:
+                __android_log_print(ANDROID_LOG_ERROR, "Chilli Source", "%s%s", in_prefix, in_message.c_str());
                 break;
-            
         }
 #elif defined (CS_TARGETPLATFORM_IOS)
-        NSString* message = [NSStringUtils newNSStringWithUTF8String:in_message];
-        NSLog(@"[Chilli Source] %@", message);
-        [message release];
+        @autoreleasepool
+        {
+            NSString* message = [NSStringUtils newNSStringWithUTF8String:in_message];
+            NSLog(@"[Chilli Source] %s%@", in_prefix, message);
+            [message release];
+        }
 #elif defined (CS_TARGETPLATFORM_WINDOWS)
-        OutputDebugString(CSBackend::Windows::WindowsStringUtils::UTF8ToUTF16("[Chilli Source] " + in_message + "\n").c_str());
+        OutputDebugString(CSBackend::Windows::WindowsStringUtils::UTF8ToUTF16("[Chilli Source] " + (in_prefix + in_message) + "\n").c_str());
 #endif
         
 #ifdef CS_ENABLE_LOGTOFILE
-        LogToFile(in_message);
+        m_logBuffer.append("\n");
+        m_logBuffer.append(in_prefix);
+        m_logBuffer.append(in_message);
 #endif
     }
+    //-----------------------------------------------------
+    //-----------------------------------------------------
+    void Logging::WriterThreadMain()
+    {
+        std::unique_lock<std::mutex> lock(m_writerMutex);
+        while (!m_isShuttingDown)
+        {
+            m_isWriterWaiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            m_writerCondition.wait(lock, [this]() { return m_isShuttingDown || HasQueuedMessages(); });
+            m_isWriterWaiting.store(false, std::memory_order_relaxed);
+            
+            DrainQueue();
+        }
+    }
     
 #ifdef CS_ENABLE_LOGTOFILE
     //-----------------------------------------------
     //-----------------------------------------------
     void Logging::CreateLogFile()
     {
-        FileStreamUPtr stream = Application::Get()->GetFileSystem()->CreateFileStream(StorageLocation::k_cache, k_logFileName, FileMode::k_write);
-        stream->Write("Chilli Source Log");
+        auto logFile = Application::Get()->GetFileSystem()->CreateTextOutputStream(StorageLocation::k_cache, k_logFileName);
+        if (logFile == nullptr)
+        {
+            return;
+        }
+        
+        logFile->Write("Chilli Source Log");
+        
+        std::unique_lock<std::mutex> lock(m_writerMutex);
+        m_logFile = std::move(logFile);
+        LogToFile();
     }
     //-----------------------------------------------
     //-----------------------------------------------
-    void Logging::LogToFile(const std::string& in_message)
+    void Logging::LogToFile()
     {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_logBuffer += "\n" + in_message;
-        
-        FileSystem* fileSystem = Application::Get()->GetFileSystem();
-        if(fileSystem != nullptr && m_logBuffer.length() > k_maxLogBufferSize)
+        //messages are kept in the buffer until the log file has been created.
+        if (m_logFile != nullptr && !m_logBuffer.empty())
         {
-            if (m_isFirstLog == true)
-            {
-                FileStreamUPtr stream = Application::Get()->GetFileSystem()->CreateFileStream(StorageLocation::k_cache, k_logFileName, FileMode::k_write);
-                stream->Write("Chilli Source Log");
-                stream->Write(m_logBuffer);
-                m_logBuffer.clear();
-                m_isFirstLog = false;
-            }
-            else
-            {
-                FileStreamUPtr stream = Application::Get()->GetFileSystem()->CreateFileStream(StorageLocation::k_cache, k_logFileName, FileMode::k_writeAppend);
-                stream->Write(m_logBuffer);
-                m_logBuffer.clear();
-            }
+            m_logFile->Write(m_logBuffer);
+            m_logFile->Flush();
+            m_logBuffer.clear();
         }
     }
 #endif
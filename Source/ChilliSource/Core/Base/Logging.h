@@ -31,13 +31,14 @@
 
 #include <ChilliSource/ChilliSource.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 
-#ifdef CS_ENABLE_LOGTOFILE
-#include <mutex>
-#endif
-
 namespace ChilliSource
 {
     //------------------------------------------------------------
@@ -46,6 +47,16 @@ namespace ChilliSource
     /// implements the singleton pattern but does not inherit
     /// from singleton. This is because singleton uses Logging.
     ///
+    /// Logging is asynchronous: messages are pushed to a lock-free
+    /// queue and output by a background writer thread, so logging
+    /// never blocks on platform output or file IO. Fatal messages
+    /// are flushed before the application exits.
+    ///
+    /// Messages can be filtered at compile time, by declaring one of
+    /// the CS_LOGLEVEL_ preprocessor macros, and at runtime using
+    /// SetLogLevel(). The CS_LOG_ macros check both before building
+    /// the message, so filtered messages cost almost nothing.
+    ///
     /// @author S Downie
     //------------------------------------------------------------
     class Logging final
@@ -53,12 +64,51 @@ namespace ChilliSource
     public:
         CS_DECLARE_NOCOPY(Logging);
         //-----------------------------------------------------
+        /// An enum describing the various logging levels.
+        ///
+        /// @author Ian Copland
+        //-----------------------------------------------------
+        enum class LogLevel
+        {
+            k_verbose,
+            k_warning,
+            k_error,
+            k_fatal
+        };
+        //-----------------------------------------------------
         /// @author Ian Copland
         ///
         /// @return The singleton instance of the Logger.
         //-----------------------------------------------------
         static Logging* Get();
         //-----------------------------------------------------
+        /// Sets the minimum level of message which will be
+        /// logged at runtime. This can only further restrict
+        /// the level set at compile time. Fatal messages are
+        /// always logged.
+        ///
+        /// This is thread-safe.
+        ///
+        /// @param The minimum logging level.
+        //-----------------------------------------------------
+        void SetLogLevel(LogLevel in_logLevel) noexcept;
+        //-----------------------------------------------------
+        /// This is thread-safe.
+        ///
+        /// @return The minimum level of message which will be
+        /// logged at runtime.
+        //-----------------------------------------------------
+        LogLevel GetLogLevel() const noexcept;
+        //-----------------------------------------------------
+        /// This is thread-safe.
+        ///
+        /// @param The logging level.
+        ///
+        /// @return Whether or not messages of the given level
+        /// are currently logged at runtime.
+        //-----------------------------------------------------
+        bool IsLogLevelEnabled(LogLevel in_logLevel) const noexcept;
+        //-----------------------------------------------------
         /// Used to output messages while the logging
         /// level is set to verbose. Declare the preprocessor
         /// macro CS_LOGLEVEL_VERBOSE to set the logging
@@ -69,7 +119,7 @@ namespace ChilliSource
         ///
         /// @param The message to log.
         //-----------------------------------------------------
-        void LogVerbose(const std::string& in_message);
+        void LogVerbose(std::string in_message);
         //-----------------------------------------------------
         /// Used to output messages while the logging level is set
         /// to warning or higher. Declare the preprocessor
@@ -81,7 +131,7 @@ namespace ChilliSource
         ///
         /// @param The message to log.
         //-----------------------------------------------------
-        void LogWarning(const std::string& in_message);
+        void LogWarning(std::string in_message);
         //-----------------------------------------------------
         /// Used to output messages while the logging level is set to
         /// error or higher. Declare the preprocessor macro
@@ -95,7 +145,7 @@ namespace ChilliSource
         ///
         /// @param The message to log.
         //-----------------------------------------------------
-        void LogError(const std::string& in_message);
+        void LogError(std::string in_message);
         //-----------------------------------------------------
         /// Used to output messages whle the logging level is set to
         /// fatal or higher and ends the application. Declare the
@@ -108,7 +158,13 @@ namespace ChilliSource
         ///
         /// @param The message to log.
         //-----------------------------------------------------
-        void LogFatal(const std::string& in_message);
+        void LogFatal(std::string in_message);
+        //-----------------------------------------------------
+        /// Blocks until all queued messages have been output.
+        ///
+        /// This is thread-safe.
+        //-----------------------------------------------------
+        void Flush() noexcept;
         
         ///
         /// Used to output messages while the logging level is set to verbose. Declare the preprocessor
@@ -169,15 +225,15 @@ namespace ChilliSource
         friend class Application;
         
         //-----------------------------------------------------
-        /// An enum describing the various logging levels.
-        ///
-        /// @author Ian Copland
+        /// A single queued message. The sequence number is
+        /// used to coordinate access between the threads
+        /// queuing messages and the writer thread.
         //-----------------------------------------------------
-        enum class LogLevel
+        struct LogEntry final
         {
-            k_verbose,
-            k_warning,
-            k_error
+            std::atomic<u32> m_sequence;
+            LogLevel m_logLevel;
+            std::string m_message;
         };
         //-----------------------------------------------------
         /// Creates the singleton instance of the Logger.
@@ -188,7 +244,8 @@ namespace ChilliSource
         //-----------------------------------------------------
         static void Create();
         //-----------------------------------------------------
-        /// Destroys the Logger.
+        /// Destroys the Logger. All queued messages are output
+        /// before the writer thread is stopped.
         ///
         /// @author Ian Copland
         //-----------------------------------------------------
@@ -200,15 +257,54 @@ namespace ChilliSource
         //-----------------------------------------------------
         Logging();
         //-----------------------------------------------------
-        /// Logs the given message to file. How this is logged
-        /// is dependant on platform.
+        /// Queues the given message to be output by the writer
+        /// thread. If the queue is full, the queue is drained
+        /// on the calling thread.
         ///
-        /// @author Ian Copland
+        /// @param The logging level.
+        /// @param The message to log.
+        //-----------------------------------------------------
+        void LogMessage(LogLevel in_logLevel, std::string in_message);
+        //-----------------------------------------------------
+        /// Attempts to push the given message to the queue
+        /// without blocking.
+        ///
+        /// @param The logging level.
+        /// @param [In/Out] The message to log. This is moved
+        /// from if successful.
+        ///
+        /// @return Whether or not there was space in the queue.
+        //-----------------------------------------------------
+        bool TryQueueMessage(LogLevel in_logLevel, std::string& io_message);
+        //-----------------------------------------------------
+        /// This must be called while the writer mutex is
+        /// locked.
+        ///
+        /// @return Whether or not there are messages waiting
+        /// to be output.
+        //-----------------------------------------------------
+        bool HasQueuedMessages() const;
+        //-----------------------------------------------------
+        /// Outputs all queued messages. This must be called
+        /// while the writer mutex is locked.
+        //-----------------------------------------------------
+        void DrainQueue();
+        //-----------------------------------------------------
+        /// Outputs the given message. How this is output is
+        /// dependant on platform. This must be called while
+        /// the writer mutex is locked.
         ///
         /// @param The logging level.
+        /// @param The prefix to output before the message.
         /// @param The message to log.
         //-----------------------------------------------------
-        void LogMessage(LogLevel in_logLevel, const std::string& in_message);
+        void OutputMessage(LogLevel in_logLevel, const char* in_prefix, const std::string& in_message);
+        //-----------------------------------------------------
+        /// The entry point for the writer thread. This sleeps
+        /// until a message is queued, then outputs every
+        /// message in the queue.
+        //-----------------------------------------------------
+        void WriterThreadMain();
         
         ///
         /// Method that can be overloaded to printf complex objects.
@@ -250,40 +346,60 @@ namespace ChilliSource
         
 #ifdef CS_ENABLE_LOGTOFILE
         //-----------------------------------------------------
-        /// Creates a new Log file.
+        /// Creates a new Log file. This is called once the
+        /// file system has been created; messages logged prior
+        /// to this are written once the file is created.
         ///
         /// @author Ian Copland
         //-----------------------------------------------------
         void CreateLogFile();
         //-----------------------------------------------------
-        /// Adds the message to to the log file.
+        /// Writes all messages output since the last call to
+        /// the log file. This must be called while the writer
+        /// mutex is locked.
         ///
         /// @author Ian Copland
-        ///
-        /// @param The message to log.
         //-----------------------------------------------------
-        void LogToFile(const std::string& in_message);
+        void LogToFile();
         
-        bool m_isFirstLog;
+        TextOutputStreamUPtr m_logFile;
         std::string m_logBuffer;
-        std::mutex m_mutex;
 #endif
+        std::atomic<LogLevel> m_logLevel;
+        
+        std::unique_ptr<LogEntry[]> m_entries;
+        std::atomic<u32> m_enqueuePosition;
+        std::atomic<u32> m_dequeuePosition;
+        
+        std::mutex m_writerMutex;
+        std::condition_variable m_writerCondition;
+        std::thread m_writerThread;
+        std::atomic<bool> m_isWriterWaiting;
+        std::atomic<std::thread::id> m_drainingThreadId;
+        bool m_isShuttingDown = false;
+        
         static Logging* s_logging;
     };
     
+    //------------------------------------------------------------------------------
+    inline bool Logging::IsLogLevelEnabled(LogLevel in_logLevel) const noexcept
+    {
+        return (in_logLevel >= m_logLevel.load(std::memory_order_relaxed));
+    }
+    
     //------------------------------------------------------------------------------
     template <typename... TArgs> std::string Logging::CreateFormattedMessage(char const * const format, TArgs&&... args) noexcept
     {
-        auto bufferSize = snprintf(NULL, 0, format, ToPrintfFormat(args)...) + 1;
-        char* buffer = new char[bufferSize];
-#ifdef CS_TARGETPLATFORM_WINDOWS
-        sprintf_s(buffer, bufferSize, format, ToPrintfFormat(args)...);
-#else
-        sprintf(buffer, format, ToPrintfFormat(args)...);
-#endif
+        auto messageSize = snprintf(NULL, 0, format, ToPrintfFormat(args)...);
+        if (messageSize <= 0)
+        {
+            return std::string();
+        }
         
-        std::string result(buffer);
-        delete [] buffer;
+        //format directly into the string to avoid allocating an intermediate buffer.
+        std::string result(std::size_t(messageSize) + 1, '\0');
+        snprintf(&result[0], result.size(), format, ToPrintfFormat(args)...);
+        result.resize(std::size_t(messageSize));
         return result;
     }
     
@@ -291,7 +407,10 @@ namespace ChilliSource
     template <typename... TArgs> void Logging::LogVerboseFormatted(char const * const format, TArgs&&... args) noexcept
     {
 #if defined CS_LOGLEVEL_VERBOSE
-        LogVerbose(CreateFormattedMessage(format, std::forward<TArgs>(args)...));
+        if (IsLogLevelEnabled(LogLevel::k_verbose))
+        {
+            LogVerbose(CreateFormattedMessage(format, std::forward<TArgs>(args)...));
+        }
 #endif
     }
     
@@ -299,7 +418,10 @@ namespace ChilliSource
     template <typename... TArgs> void Logging::LogWarningFormatted(char const * const format, TArgs&&... args) noexcept
     {
 #if defined CS_LOGLEVEL_VERBOSE || defined CS_LOGLEVEL_WARNING
-        LogWarning(CreateFormattedMessage(format, std::forward<TArgs>(args)...));
+        if (IsLogLevelEnabled(LogLevel::k_warning))
+        {
+            LogWarning(CreateFormattedMessage(format, std::forward<TArgs>(args)...));
+        }
 #endif
     }
     
@@ -307,7 +429,10 @@ namespace ChilliSource
     template <typename... TArgs> void Logging::LogErrorFormatted(char const * const format, TArgs&&... args) noexcept
     {
 #if defined CS_LOGLEVEL_VERBOSE || defined CS_LOGLEVEL_WARNING || defined CS_LOGLEVEL_ERROR
-        LogError(CreateFormattedMessage(format, std::forward<TArgs>(args)...));
+        if (IsLogLevelEnabled(LogLevel::k_error))
+        {
+            LogError(CreateFormattedMessage(format, std::forward<TArgs>(args)...));
+        }
 #endif
     }
     
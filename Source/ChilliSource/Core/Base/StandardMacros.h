@@ -35,16 +35,39 @@
 #define CS_SAFEDELETE(in_object)        {if(in_object) delete(in_object); in_object = nullptr;}
 #define CS_SAFEDELETE_ARRAY(in_object)  {if(in_object) delete[] (in_object); in_object = nullptr;}
 //------------------------------------------------------------
-/// Logging macros
+/// Logging macros. Messages below the compile time logging
+/// level are compiled out, and messages below the runtime
+/// logging level are skipped. In both cases the message is
+/// never built. Fatal messages are never skipped.
 //------------------------------------------------------------
-#define CS_LOG_VERBOSE(message)      (ChilliSource::Logging::Get()->LogVerbose(message))
-#define CS_LOG_WARNING(message)      (ChilliSource::Logging::Get()->LogWarning(message))
-#define CS_LOG_ERROR(message)        (ChilliSource::Logging::Get()->LogError(message))
-#define CS_LOG_FATAL(message)        (ChilliSource::Logging::Get()->LogFatal(message))
+#define CS_LOG_ISENABLED(in_level)   (ChilliSource::Logging::Get()->IsLogLevelEnabled(ChilliSource::Logging::LogLevel::in_level))
+#define CS_LOG_DISCARD(in_expression) ((void)sizeof((in_expression, 0)))
+
+#if defined CS_LOGLEVEL_VERBOSE
+#define CS_LOG_VERBOSE(message)      (CS_LOG_ISENABLED(k_verbose) ? ChilliSource::Logging::Get()->LogVerbose(message) : (void)0)
+#define CS_LOG_VERBOSE_FMT(message, ...)  (CS_LOG_ISENABLED(k_verbose) ? ChilliSource::Logging::Get()->LogVerboseFormatted(message, __VA_ARGS__) : (void)0)
+#else
+#define CS_LOG_VERBOSE(message)      CS_LOG_DISCARD(ChilliSource::Logging::Get()->LogVerbose(message))
+#define CS_LOG_VERBOSE_FMT(message, ...)  CS_LOG_DISCARD(ChilliSource::Logging::Get()->LogVerboseFormatted(message, __VA_ARGS__))
+#endif
 
-#define CS_LOG_VERBOSE_FMT(message, ...)  (ChilliSource::Logging::Get()->LogVerboseFormatted(message, __VA_ARGS__))
-#define CS_LOG_WARNING_FMT(message, ...)  (ChilliSource::Logging::Get()->LogWarningFormatted(message, __VA_ARGS__))
-#define CS_LOG_ERROR_FMT(message, ...)  (ChilliSource::Logging::Get()->LogErrorFormatted(message, __VA_ARGS__))
+#if defined CS_LOGLEVEL_VERBOSE || defined CS_LOGLEVEL_WARNING
+#define CS_LOG_WARNING(message)      (CS_LOG_ISENABLED(k_warning) ? ChilliSource::Logging::Get()->LogWarning(message) : (void)0)
+#define CS_LOG_WARNING_FMT(message, ...)  (CS_LOG_ISENABLED(k_warning) ? ChilliSource::Logging::Get()->LogWarningFormatted(message, __VA_ARGS__) : (void)0)
+#else
+#define CS_LOG_WARNING(message)      CS_LOG_DISCARD(ChilliSource::Logging::Get()->LogWarning(message))
+#define CS_LOG_WARNING_FMT(message, ...)  CS_LOG_DISCARD(ChilliSource::Logging::Get()->LogWarningFormatted(message, __VA_ARGS__))
+#endif
+
+#if defined CS_LOGLEVEL_VERBOSE || defined CS_LOGLEVEL_WARNING || defined CS_LOGLEVEL_ERROR
+#define CS_LOG_ERROR(message)        (CS_LOG_ISENABLED(k_error) ? ChilliSource::Logging::Get()->LogError(message) : (void)0)
+#define CS_LOG_ERROR_FMT(message, ...)  (CS_LOG_ISENABLED(k_error) ? ChilliSource::Logging::Get()->LogErrorFormatted(message, __VA_ARGS__) : (void)0)
+#else
+#define CS_LOG_ERROR(message)        CS_LOG_DISCARD(ChilliSource::Logging::Get()->LogError(message))
+#define CS_LOG_ERROR_FMT(message, ...)  CS_LOG_DISCARD(ChilliSource::Logging::Get()->LogErrorFormatted(message, __VA_ARGS__))
+#endif
+
+#define CS_LOG_FATAL(message)        (ChilliSource::Logging::Get()->LogFatal(message))
 #define CS_LOG_FATAL_FMT(message, ...)  (ChilliSource::Logging::Get()->LogFatalFormatted(message, __VA_ARGS__))
 //------------------------------------------------------------
 /// Assertion macros
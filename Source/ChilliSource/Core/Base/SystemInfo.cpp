@@ -27,7 +27,7 @@ namespace ChilliSource
 {
     //----------------------------------------------------------------
     SystemInfo::SystemInfo(const DeviceInfo& deviceInfo, const ScreenInfo& screenInfo, const RenderInfo& renderInfo, const std::string& appVersion) noexcept
-        : m_deviceInfo(deviceInfo), m_screenInfo(screenInfo), m_renderInfo(renderInfo), m_appVersion(appVersion)
+        : m_deviceInfo(deviceInfo), m_renderInfo(renderInfo), m_screenInfo(screenInfo), m_appVersion(appVersion)
     {   
     }
 
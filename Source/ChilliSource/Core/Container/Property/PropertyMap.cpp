@@ -28,6 +28,7 @@
 
 #include <ChilliSource/Core/Container/Property/PropertyMap.h>
 
+#include <ChilliSource/Core/Base/ConstMethodCast.h>
 #include <ChilliSource/Core/Container/Property/PropertyType.h>
 #include <ChilliSource/Core/Json/JsonUtils.h>
 #include <ChilliSource/Core/Math/Vector2.h>
@@ -37,59 +38,95 @@
 
 #include <json/json.h>
 
+#include <algorithm>
+
 namespace ChilliSource
 {
+    namespace
+    {
+        //----------------------------------------------------------------------------------------
+        /// Orders lookup entries by hash.
+        ///
+        /// @param The lookup entry.
+        /// @param The hash to compare with.
+        ///
+        /// @return Whether or not the entry is ordered before the hash.
+        //----------------------------------------------------------------------------------------
+        template <typename TLookupEntry> bool IsBeforeHash(const TLookupEntry& in_entry, std::size_t in_hash)
+        {
+            return in_entry.m_hash < in_hash;
+        }
+        //----------------------------------------------------------------------------------------
+        /// Orders id lookup entries by id.
+        ///
+        /// @param The lookup entry.
+        /// @param The id to compare with.
+        ///
+        /// @return Whether or not the entry is ordered before the id.
+        //----------------------------------------------------------------------------------------
+        template <typename TIdLookupEntry> bool IsBeforeId(const TIdLookupEntry& in_entry, u32 in_id)
+        {
+            return in_entry.m_id < in_id;
+        }
+    }
+    
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
     PropertyMap::PropertyMap(const std::vector<PropertyDesc>& in_propertyDefs)
     {
+        m_properties.reserve(in_propertyDefs.size());
+        m_lookup.reserve(in_propertyDefs.size());
+        
         for(const auto& propertyDef : in_propertyDefs)
         {
-            CS_ASSERT(m_properties.find(propertyDef.m_name) == m_properties.end(), "Duplicate property name in property map descs: " + propertyDef.m_name);
+            CS_ASSERT(FindProperty(propertyDef.m_name) == nullptr, "Duplicate property name in property map descs: " + propertyDef.m_name);
             
             std::string lowerName = propertyDef.m_name;
             StringUtils::ToLowerCase(lowerName);
             
             PropertyContainer container;
+            container.m_name = InternedString(propertyDef.m_name);
+            container.m_lowerCaseName = InternedString(lowerName);
             container.m_initialised = false;
             container.m_property = propertyDef.m_type->CreateProperty();
-            m_properties.insert(std::make_pair(lowerName, std::move(container)));
             
-            m_propertyKeys.push_back(propertyDef.m_name);
+            //Lookup entries are kept sorted by inserting in place, which is fine for the small number of properties in a map.
+            //Both the declared and lower case names are added so that names in either case are found without converting them.
+            AddLookupEntries(container.m_name, u32(m_properties.size()));
+            if (container.m_lowerCaseName != container.m_name)
+            {
+                AddLookupEntries(container.m_lowerCaseName, u32(m_properties.size()));
+            }
+            
+            m_properties.push_back(std::move(container));
         }
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
     PropertyMap::PropertyMap(PropertyMap&& in_move)
-    : m_properties(std::move(in_move.m_properties)), m_propertyKeys(std::move(in_move.m_propertyKeys))
+    : m_properties(std::move(in_move.m_properties)), m_lookup(std::move(in_move.m_lookup)), m_idLookup(std::move(in_move.m_idLookup))
     {
-        in_move.m_propertyKeys.clear();
         in_move.m_properties.clear();
+        in_move.m_lookup.clear();
+        in_move.m_idLookup.clear();
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
     PropertyMap::PropertyMap(const PropertyMap& in_copy)
     {
-        for(const auto& pair : in_copy.m_properties)
-        {
-            PropertyContainer container;
-            container.m_initialised = pair.second.m_initialised;
-            container.m_property = pair.second.m_property->GetType()->CreateProperty();
-            container.m_property->Set(pair.second.m_property.get());
-            m_properties.insert(std::make_pair(pair.first, std::move(container)));
-        }
-        
-        m_propertyKeys = in_copy.m_propertyKeys;
+        *this = in_copy;
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
     PropertyMap& PropertyMap::operator=(PropertyMap&& in_move)
     {
         m_properties = std::move(in_move.m_properties);
-        m_propertyKeys = std::move(in_move.m_propertyKeys);
+        m_lookup = std::move(in_move.m_lookup);
+        m_idLookup = std::move(in_move.m_idLookup);
         
         in_move.m_properties.clear();
-        in_move.m_propertyKeys.clear();
+        in_move.m_lookup.clear();
+        in_move.m_idLookup.clear();
         
         return *this;
     }
@@ -97,51 +134,93 @@ namespace ChilliSource
     //----------------------------------------------------------------------------------------
     PropertyMap& PropertyMap::operator=(const PropertyMap& in_copy)
     {
+        if (this == &in_copy)
+        {
+            return *this;
+        }
+        
         m_properties.clear();
+        m_properties.reserve(in_copy.m_properties.size());
         
-        for(auto& pair : in_copy.m_properties)
+        for(const auto& sourceContainer : in_copy.m_properties)
         {
             PropertyContainer container;
-            container.m_initialised = pair.second.m_initialised;
-            container.m_property = pair.second.m_property->GetType()->CreateProperty();
-            container.m_property->Set(pair.second.m_property.get());
-            m_properties.insert(std::make_pair(pair.first, std::move(container)));
+            container.m_name = sourceContainer.m_name;
+            container.m_lowerCaseName = sourceContainer.m_lowerCaseName;
+            container.m_initialised = sourceContainer.m_initialised;
+            container.m_property = sourceContainer.m_property->GetType()->CreateProperty();
+            container.m_property->Set(sourceContainer.m_property.get());
+            m_properties.push_back(std::move(container));
         }
         
-        m_propertyKeys = in_copy.m_propertyKeys;
+        m_lookup = in_copy.m_lookup;
+        m_idLookup = in_copy.m_idLookup;
         
         return *this;
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
-    const std::vector<std::string>& PropertyMap::GetKeys() const
+    std::vector<std::string> PropertyMap::GetKeys() const
+    {
+        std::vector<std::string> keys;
+        keys.reserve(m_properties.size());
+        
+        for (const auto& container : m_properties)
+        {
+            keys.push_back(container.m_name.GetString());
+        }
+        
+        return keys;
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    void PropertyMap::ForEachValue(const ValueDelegate& in_delegate) const
     {
-        return m_propertyKeys;
+        for (const auto& container : m_properties)
+        {
+            if (container.m_initialised == true)
+            {
+                in_delegate(container.m_name.GetString(), container.m_property.get());
+            }
+        }
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
     bool PropertyMap::HasKey(const std::string& in_name) const
     {
-        std::string lowerCaseName = in_name;
-        StringUtils::ToLowerCase(lowerCaseName);
-        
-        return m_properties.find(lowerCaseName) != m_properties.end();
+        return FindProperty(in_name) != nullptr;
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    bool PropertyMap::HasKey(const InternedString& in_name) const
+    {
+        return FindProperty(in_name) != nullptr;
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
     bool PropertyMap::HasValue(const std::string& in_name) const
     {
-        std::string lowerCaseName = in_name;
-        StringUtils::ToLowerCase(lowerCaseName);
+        auto entry = FindProperty(in_name);
+        if (entry == nullptr)
+        {
+            CS_LOG_FATAL("Querying whether a non-existant property has a value.");
+            return false;
+        }
         
-        auto it = m_properties.find(lowerCaseName);
-        if (it == m_properties.end())
+        return entry->m_initialised;
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    bool PropertyMap::HasValue(const InternedString& in_name) const
+    {
+        auto entry = FindProperty(in_name);
+        if (entry == nullptr)
         {
             CS_LOG_FATAL("Querying whether a non-existant property has a value.");
             return false;
         }
         
-        return it->second.m_initialised;
+        return entry->m_initialised;
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
@@ -153,15 +232,12 @@ namespace ChilliSource
     //----------------------------------------------------------------------------------------
     void PropertyMap::ParseProperty(const std::string& in_name, const std::string& in_value)
     {
-        std::string lowerCaseName = in_name;
-        StringUtils::ToLowerCase(lowerCaseName);
+        auto entry = FindProperty(in_name);
+        CS_ASSERT(entry != nullptr, "No property in property map with name: " + in_name);
         
-        auto entry = m_properties.find(lowerCaseName);
-        CS_ASSERT(entry != m_properties.end(), "No property in property map with name: " + in_name);
-        
-        IProperty* property = entry->second.m_property.get();
+        IProperty* property = entry->m_property.get();
         property->Parse(in_value);
-        entry->second.m_initialised = true;
+        entry->m_initialised = true;
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
@@ -173,39 +249,124 @@ namespace ChilliSource
     //----------------------------------------------------------------------------------------
     const IPropertyType* PropertyMap::GetType(const std::string& in_name) const
     {
-        std::string lowerCaseName = in_name;
-        StringUtils::ToLowerCase(lowerCaseName);
-        
-        auto entry = m_properties.find(lowerCaseName);
-        CS_ASSERT(entry != m_properties.end(), "No property with name: " + in_name);
-        return entry->second.m_property->GetType();
+        auto entry = FindProperty(in_name);
+        CS_ASSERT(entry != nullptr, "No property with name: " + in_name);
+        return entry->m_property->GetType();
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
     IProperty* PropertyMap::GetPropertyObject(const std::string& in_name)
     {
-        std::string lowerCaseName = in_name;
-        StringUtils::ToLowerCase(lowerCaseName);
-        
-        auto entry = m_properties.find(lowerCaseName);
-        CS_ASSERT(entry != m_properties.end(), "No property with name: " + in_name);
-        return entry->second.m_property.get();
+        auto entry = FindProperty(in_name);
+        CS_ASSERT(entry != nullptr, "No property with name: " + in_name);
+        return entry->m_property.get();
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
     const IProperty* PropertyMap::GetPropertyObject(const std::string& in_name) const
     {
+        auto entry = FindProperty(in_name);
+        CS_ASSERT(entry != nullptr, "No property with name: " + in_name);
+        return entry->m_property.get();
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    IProperty* PropertyMap::GetPropertyObject(const InternedString& in_name)
+    {
+        auto entry = FindProperty(in_name);
+        CS_ASSERT(entry != nullptr, "No property with name: " + in_name.GetString());
+        return entry->m_property.get();
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    const IProperty* PropertyMap::GetPropertyObject(const InternedString& in_name) const
+    {
+        auto entry = FindProperty(in_name);
+        CS_ASSERT(entry != nullptr, "No property with name: " + in_name.GetString());
+        return entry->m_property.get();
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    const PropertyMap::PropertyContainer* PropertyMap::FindProperty(const std::string& in_name) const
+    {
+        //Names are usually given in either their declared or lower case form, both of which are in the lookup, so the
+        //name is only converted to lower case if it isn't found as is.
+        auto entry = FindPropertyWithExactName(in_name);
+        if (entry != nullptr)
+        {
+            return entry;
+        }
+        
         std::string lowerCaseName = in_name;
         StringUtils::ToLowerCase(lowerCaseName);
+        if (lowerCaseName == in_name)
+        {
+            return nullptr;
+        }
+        
+        return FindPropertyWithExactName(lowerCaseName);
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    const PropertyMap::PropertyContainer* PropertyMap::FindProperty(const InternedString& in_name) const
+    {
+        auto it = std::lower_bound(m_idLookup.begin(), m_idLookup.end(), in_name.GetId(), IsBeforeId<IdLookupEntry>);
+        if (it != m_idLookup.end() && it->m_id == in_name.GetId())
+        {
+            return &m_properties[it->m_index];
+        }
+        
+        //the name may still match in a case other than the declared or lower case name.
+        return FindProperty(in_name.GetString());
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    const PropertyMap::PropertyContainer* PropertyMap::FindPropertyWithExactName(const std::string& in_name) const
+    {
+        auto hash = InternedString::CalculateHash(in_name);
+        for (auto it = std::lower_bound(m_lookup.begin(), m_lookup.end(), hash, IsBeforeHash<LookupEntry>); it != m_lookup.end() && it->m_hash == hash; ++it)
+        {
+            const auto& container = m_properties[it->m_index];
+            if (container.m_name.GetString() == in_name || container.m_lowerCaseName.GetString() == in_name)
+            {
+                return &container;
+            }
+        }
+        
+        return nullptr;
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    void PropertyMap::AddLookupEntries(const InternedString& in_name, u32 in_index)
+    {
+        LookupEntry lookupEntry;
+        lookupEntry.m_hash = in_name.GetHash();
+        lookupEntry.m_index = in_index;
+        m_lookup.insert(std::lower_bound(m_lookup.begin(), m_lookup.end(), lookupEntry.m_hash, IsBeforeHash<LookupEntry>), lookupEntry);
         
-        auto entry = m_properties.find(lowerCaseName);
-        CS_ASSERT(entry != m_properties.end(), "No property with name: " + in_name);
-        return entry->second.m_property.get();
+        IdLookupEntry idLookupEntry;
+        idLookupEntry.m_id = in_name.GetId();
+        idLookupEntry.m_index = in_index;
+        m_idLookup.insert(std::lower_bound(m_idLookup.begin(), m_idLookup.end(), idLookupEntry.m_id, IsBeforeId<IdLookupEntry>), idLookupEntry);
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    PropertyMap::PropertyContainer* PropertyMap::FindProperty(const std::string& in_name)
+    {
+        return const_cast<PropertyContainer*>(static_cast<const PropertyMap*>(this)->FindProperty(in_name));
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    PropertyMap::PropertyContainer* PropertyMap::FindProperty(const InternedString& in_name)
+    {
+        return const_cast<PropertyContainer*>(static_cast<const PropertyMap*>(this)->FindProperty(in_name));
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
     PropertyMap::PropertyContainer::PropertyContainer(PropertyContainer&& in_move)
     {
+        m_name = in_move.m_name;
+        m_lowerCaseName = in_move.m_lowerCaseName;
         m_initialised = in_move.m_initialised;
         m_property = std::move(in_move.m_property);
 
@@ -215,6 +376,8 @@ namespace ChilliSource
     //----------------------------------------------------------------------------------------
     PropertyMap::PropertyContainer& PropertyMap::PropertyContainer::operator=(PropertyContainer&& in_move)
     {
+        m_name = in_move.m_name;
+        m_lowerCaseName = in_move.m_lowerCaseName;
         m_initialised = in_move.m_initialised;
         m_property = std::move(in_move.m_property);
 
@@ -31,12 +31,12 @@
 
 #include <ChilliSource/ChilliSource.h>
 #include <ChilliSource/Core/Cryptographic/HashCRC32.h>
-#include <ChilliSource/Core/Cryptographic/HashCRC32.h>
+#include <ChilliSource/Core/String/InternedString.h>
 #include <ChilliSource/Core/String/StringUtils.h>
 #include <ChilliSource/Core/Container/Property/Property.h>
 
 #include <cassert>
-#include <unordered_map>
+#include <functional>
 #include <vector>
 
 namespace ChilliSource
@@ -50,6 +50,18 @@ namespace ChilliSource
     /// a property after SetProperty() has been called for it. HasValue() can be used
     /// to check if a value has been set.
     ///
+    /// Property names are interned, and the properties are held in a flat array with
+    /// sorted lookup tables keyed on the precomputed hash and the id of both the declared
+    /// and lower case names. This keeps copying a property map, which happens frequently
+    /// when creating widgets, free of string copies and allocations other than for the
+    /// property values.
+    ///
+    /// Properties can be looked up by string or by InternedString. Looking up by string
+    /// hashes the name, and only converts it to lower case if it isn't given in either
+    /// its declared or lower case form. Looking up by InternedString binary searches on
+    /// the id, so code which accesses the same properties repeatedly should intern the
+    /// names once and use those.
+    ///
     /// @author S Downie
     //---------------------------------------------------------------------------------
     class PropertyMap final
@@ -66,6 +78,13 @@ namespace ChilliSource
             std::string m_name;
         };
         //----------------------------------------------------------------------------------------
+        /// A delegate called for each property which has a value.
+        ///
+        /// @param The property name.
+        /// @param The property.
+        //----------------------------------------------------------------------------------------
+        using ValueDelegate = std::function<void(const std::string& in_name, const IProperty* in_property)>;
+        //----------------------------------------------------------------------------------------
         /// Constructor. Creates a property map with no keys.
         ///
         /// @author S Downie
@@ -118,9 +137,17 @@ namespace ChilliSource
         //----------------------------------------------------------------------------------------
         /// @author Ian Copland
         ///
-        /// @return The list of keys in the property map.
+        /// @return The list of keys in the property map, in the order they were declared.
         //----------------------------------------------------------------------------------------
-        const std::vector<std::string>& GetKeys() const;
+        std::vector<std::string> GetKeys() const;
+        //----------------------------------------------------------------------------------------
+        /// Calls the given delegate for each property which has been given a value, in the order
+        /// the properties were declared. This should be preferred over calling GetKeys() and
+        /// then looking up each property by name.
+        ///
+        /// @param The delegate.
+        //----------------------------------------------------------------------------------------
+        void ForEachValue(const ValueDelegate& in_delegate) const;
         //----------------------------------------------------------------------------------------
         /// @author S Downie
         ///
@@ -130,6 +157,12 @@ namespace ChilliSource
         //----------------------------------------------------------------------------------------
         bool HasKey(const std::string& in_name) const;
         //----------------------------------------------------------------------------------------
+        /// @param Property name
+        ///
+        /// @return Whether the property key exists
+        //----------------------------------------------------------------------------------------
+        bool HasKey(const InternedString& in_name) const;
+        //----------------------------------------------------------------------------------------
         /// @author Ian Copland
         ///
         /// @param The property name
@@ -139,6 +172,13 @@ namespace ChilliSource
         //----------------------------------------------------------------------------------------
         bool HasValue(const std::string& in_name) const;
         //----------------------------------------------------------------------------------------
+        /// @param The property name
+        ///
+        /// @return Whether or not property with the given key has a value. This will error if the
+        /// property doesn't exist.
+        //----------------------------------------------------------------------------------------
+        bool HasValue(const InternedString& in_name) const;
+        //----------------------------------------------------------------------------------------
         /// Set the value of the property with the given name. If no property exists with the
         /// name then it will assert.
         ///
@@ -149,6 +189,14 @@ namespace ChilliSource
         //----------------------------------------------------------------------------------------
         template<typename TType> void SetProperty(const std::string& in_name, TType&& in_value);
         //----------------------------------------------------------------------------------------
+        /// Set the value of the property with the given name. If no property exists with the
+        /// name then it will assert.
+        ///
+        /// @param Name
+        /// @param Value
+        //----------------------------------------------------------------------------------------
+        template<typename TType> void SetProperty(const InternedString& in_name, TType&& in_value);
+        //----------------------------------------------------------------------------------------
         /// Specialisation to store property value for const char* as a std::string
         ///
         /// @author S Downie
@@ -181,6 +229,15 @@ namespace ChilliSource
         //----------------------------------------------------------------------------------------
         template<typename TType> TType GetProperty(const std::string& in_name) const;
         //----------------------------------------------------------------------------------------
+        /// Get the value of the property with the given name. If no property exists with the name
+        /// or the property doesn't yet have a value, with the name then it will assert.
+        ///
+        /// @param Name
+        ///
+        /// @return Value
+        //----------------------------------------------------------------------------------------
+        template<typename TType> TType GetProperty(const InternedString& in_name) const;
+        //----------------------------------------------------------------------------------------
         /// Get the value of the property with the given name. If the property has not been set
         /// the default will be returned instead. If the property doesn't exist it will assert.
         ///
@@ -192,6 +249,15 @@ namespace ChilliSource
         //----------------------------------------------------------------------------------------
         template<typename TType> TType GetPropertyOrDefault(const std::string& in_name, TType&& in_default) const;
         //----------------------------------------------------------------------------------------
+        /// Get the value of the property with the given name. If the property has not been set
+        /// the default will be returned instead. If the property doesn't exist it will assert.
+        ///
+        /// @param Name
+        ///
+        /// @return Value (or default)
+        //----------------------------------------------------------------------------------------
+        template<typename TType> TType GetPropertyOrDefault(const InternedString& in_name, TType&& in_default) const;
+        //----------------------------------------------------------------------------------------
         /// Specialisation to return property value for const char* which is stored as a std::string
         ///
         /// @author S Downie
@@ -228,6 +294,20 @@ namespace ChilliSource
         /// there is no property with the given name, or the property has no value this will assert.
         //----------------------------------------------------------------------------------------
         const IProperty* GetPropertyObject(const std::string& in_name) const;
+        //----------------------------------------------------------------------------------------
+        /// @param The property name.
+        ///
+        /// @return The underlying property object for the given key. If there is no property
+        /// with the given name, or the property has no value this will assert.
+        //----------------------------------------------------------------------------------------
+        IProperty* GetPropertyObject(const InternedString& in_name);
+        //----------------------------------------------------------------------------------------
+        /// @param The property name.
+        ///
+        /// @return A constant version of the underlying property object for the given key. If
+        /// there is no property with the given name, or the property has no value this will assert.
+        //----------------------------------------------------------------------------------------
+        const IProperty* GetPropertyObject(const InternedString& in_name) const;
         
     private:
         //----------------------------------------------------------------------------------------
@@ -266,12 +346,70 @@ namespace ChilliSource
             //----------------------------------------------------------------------------------------
             PropertyContainer& operator=(PropertyContainer&& in_move);
 
+            InternedString m_name;
+            InternedString m_lowerCaseName;
             bool m_initialised = false;
             IPropertyUPtr m_property;
         };
+        //----------------------------------------------------------------------------------------
+        /// An entry in the lookup table.
+        //----------------------------------------------------------------------------------------
+        struct LookupEntry
+        {
+            std::size_t m_hash;
+            u32 m_index;
+        };
+        //----------------------------------------------------------------------------------------
+        /// An entry in the id lookup table.
+        //----------------------------------------------------------------------------------------
+        struct IdLookupEntry
+        {
+            u32 m_id;
+            u32 m_index;
+        };
+        //----------------------------------------------------------------------------------------
+        /// @param The property name. This is case insensitive.
+        ///
+        /// @return The container for the property with the given name, or null if there isn't one.
+        //----------------------------------------------------------------------------------------
+        const PropertyContainer* FindProperty(const std::string& in_name) const;
+        //----------------------------------------------------------------------------------------
+        /// @param The property name. This is case insensitive.
+        ///
+        /// @return The container for the property with the given name, or null if there isn't one.
+        //----------------------------------------------------------------------------------------
+        PropertyContainer* FindProperty(const std::string& in_name);
+        //----------------------------------------------------------------------------------------
+        /// @param The property name. This is case insensitive, but is fastest when given in its
+        /// declared or lower case form.
+        ///
+        /// @return The container for the property with the given name, or null if there isn't one.
+        //----------------------------------------------------------------------------------------
+        const PropertyContainer* FindProperty(const InternedString& in_name) const;
+        //----------------------------------------------------------------------------------------
+        /// @param The property name. This is case insensitive, but is fastest when given in its
+        /// declared or lower case form.
+        ///
+        /// @return The container for the property with the given name, or null if there isn't one.
+        //----------------------------------------------------------------------------------------
+        PropertyContainer* FindProperty(const InternedString& in_name);
+        //----------------------------------------------------------------------------------------
+        /// @param The property name, in either its declared or lower case form.
+        ///
+        /// @return The container for the property with the given name, or null if there isn't one.
+        //----------------------------------------------------------------------------------------
+        const PropertyContainer* FindPropertyWithExactName(const std::string& in_name) const;
+        //----------------------------------------------------------------------------------------
+        /// Adds the given name to the hash and id lookup tables, keeping them sorted.
+        ///
+        /// @param The name.
+        /// @param The index of the property.
+        //----------------------------------------------------------------------------------------
+        void AddLookupEntries(const InternedString& in_name, u32 in_index);
 
-        std::vector<std::string> m_propertyKeys;
-        std::unordered_map<std::string, PropertyContainer> m_properties;
+        std::vector<PropertyContainer> m_properties;
+        std::vector<LookupEntry> m_lookup;
+        std::vector<IdLookupEntry> m_idLookup;
     };
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
@@ -279,15 +417,25 @@ namespace ChilliSource
     {
         typedef typename std::decay<TType>::type TValueType;
         
-        std::string lowerCaseName = in_name;
-        StringUtils::ToLowerCase(lowerCaseName);
+        auto entry = FindProperty(in_name);
+        CS_ASSERT(entry != nullptr, "No property in property map with name: " + in_name);
+
+        Property<TValueType>* property = CS_SMARTCAST(Property<TValueType>*, entry->m_property.get(), "Wrong type for property with name: " + in_name);
+        property->Set(std::forward<TType>(in_value));
+        entry->m_initialised = true;
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    template<typename TType> void PropertyMap::SetProperty(const InternedString& in_name, TType&& in_value)
+    {
+        typedef typename std::decay<TType>::type TValueType;
         
-        auto entry = m_properties.find(lowerCaseName);
-        CS_ASSERT(entry != m_properties.end(), "No property in property map with name: " + in_name);
+        auto entry = FindProperty(in_name);
+        CS_ASSERT(entry != nullptr, "No property in property map with name: " + in_name.GetString());
 
-        Property<TValueType>* property = CS_SMARTCAST(Property<TValueType>*, entry->second.m_property.get(), "Wrong type for property with name: " + in_name);
+        Property<TValueType>* property = CS_SMARTCAST(Property<TValueType>*, entry->m_property.get(), "Wrong type for property with name: " + in_name.GetString());
         property->Set(std::forward<TType>(in_value));
-        entry->second.m_initialised = true;
+        entry->m_initialised = true;
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
@@ -295,14 +443,24 @@ namespace ChilliSource
     {
         typedef typename std::decay<TType>::type TValueType;
         
-        std::string lowerCaseName = in_name;
-        StringUtils::ToLowerCase(lowerCaseName);
+        auto entry = FindProperty(in_name);
+        CS_ASSERT(entry != nullptr, "No property in property map with name: " + in_name);
+        CS_ASSERT(entry->m_initialised == true, "Cannot get the value for an uninitialised property.");
+        
+        Property<TValueType>* property = CS_SMARTCAST(Property<TValueType>*, entry->m_property.get(), "Wrong type for property with name: " + in_name);
+        return property->Get();
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    template<typename TType> TType PropertyMap::GetProperty(const InternedString& in_name) const
+    {
+        typedef typename std::decay<TType>::type TValueType;
         
-        auto entry = m_properties.find(lowerCaseName);
-        CS_ASSERT(entry != m_properties.end(), "No property in property map with name: " + in_name);
-        CS_ASSERT(entry->second.m_initialised == true, "Cannot get the value for an uninitialised property.");
+        auto entry = FindProperty(in_name);
+        CS_ASSERT(entry != nullptr, "No property in property map with name: " + in_name.GetString());
+        CS_ASSERT(entry->m_initialised == true, "Cannot get the value for an uninitialised property.");
         
-        Property<TValueType>* property = CS_SMARTCAST(Property<TValueType>*, entry->second.m_property.get(), "Wrong type for property with name: " + in_name);
+        Property<TValueType>* property = CS_SMARTCAST(Property<TValueType>*, entry->m_property.get(), "Wrong type for property with name: " + in_name.GetString());
         return property->Get();
     }
     //----------------------------------------------------------------------------------------
@@ -311,14 +469,28 @@ namespace ChilliSource
     {
         typedef typename std::decay<TType>::type TValueType;
         
-        std::string lowerCaseName = in_name;
-        StringUtils::ToLowerCase(lowerCaseName);
+        auto entry = FindProperty(in_name);
+        CS_ASSERT(entry != nullptr, "No property in property map with name: " + in_name);
+        
+        Property<TValueType>* property = CS_SMARTCAST(Property<TValueType>*, entry->m_property.get(), "Wrong type for property with name: " + in_name);
+        if (entry->m_initialised == true)
+        {
+            return property->Get();
+        }
+        
+        return in_default;
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    template<typename TType> TType PropertyMap::GetPropertyOrDefault(const InternedString& in_name, TType&& in_default) const
+    {
+        typedef typename std::decay<TType>::type TValueType;
         
-        auto entry = m_properties.find(lowerCaseName);
-        CS_ASSERT(entry != m_properties.end(), "No property in property map with name: " + in_name);
+        auto entry = FindProperty(in_name);
+        CS_ASSERT(entry != nullptr, "No property in property map with name: " + in_name.GetString());
         
-        Property<TValueType>* property = CS_SMARTCAST(Property<TValueType>*, entry->second.m_property.get(), "Wrong type for property with name: " + in_name);
-        if (entry->second.m_initialised == true)
+        Property<TValueType>* property = CS_SMARTCAST(Property<TValueType>*, entry->m_property.get(), "Wrong type for property with name: " + in_name.GetString());
+        if (entry->m_initialised == true)
         {
             return property->Get();
         }
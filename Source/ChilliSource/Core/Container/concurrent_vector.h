@@ -34,7 +34,10 @@
 #include <ChilliSource/Core/Container/concurrent_vector_forward_iterator.h>
 #include <ChilliSource/Core/Container/concurrent_vector_reverse_iterator.h>
 
+#include <algorithm>
 #include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace ChilliSource
@@ -44,6 +47,13 @@ namespace ChilliSource
     /// It presevers the integrity of the array when accessing from different
     /// threads and also from changes to the array while iterating
     ///
+    /// Iterators walk an immutable snapshot of the array, so iterating takes
+    /// a single lock when the iterator is created rather than one per element.
+    /// Elements can be added or removed while iterating: existing iterators
+    /// don't see additions and skip removals. The first change after an
+    /// iterator has been created copies the slot pointers into a new snapshot,
+    /// further changes are made in place.
+    ///
     /// NOTE: This class syntax mimics STL and therefore doe not use the CS coding
     /// standards.
     ///
@@ -169,7 +179,10 @@ namespace ChilliSource
         //--------------------------------------------------------------------
         const TType& at(size_type in_index) const;
         //--------------------------------------------------------------------
-        /// Lock the array which prevents its contents being modified unsafely.
+        /// Lock the array which prevents other threads accessing or
+        /// modifying it until it is unlocked. The locking thread can still
+        /// use the array, so this can be used to make a series of operations
+        /// atomic. Iterating doesn't require the array to be locked.
         ///
         /// @author S Downie
         //--------------------------------------------------------------------
@@ -317,81 +330,130 @@ namespace ChilliSource
         
     private:
         
+        using slot = concurrent_vector_slot<TType>;
+        using snapshot = concurrent_vector_snapshot<TType>;
+        
+        //--------------------------------------------------------------------
+        /// @return The current snapshot of the array
         //--------------------------------------------------------------------
-        /// Cleanup any elements that are marked for removal
+        std::shared_ptr<const snapshot> get_snapshot() const;
+        //--------------------------------------------------------------------
+        /// The current snapshot is only changed in place if it has not been
+        /// given to an iterator, otherwise it is replaced by a copy. This must
+        /// be called while holding the mutex.
         ///
-        /// @author S Downie
+        /// @return The current snapshot, safe to modify.
+        //--------------------------------------------------------------------
+        snapshot& get_mutable_snapshot();
         //--------------------------------------------------------------------
-        void garbage_collect();
+        /// Flags the given slot as removed and takes it out of the array if
+        /// it hasn't already been removed.
+        ///
+        /// @param The slot to remove
+        //--------------------------------------------------------------------
+        void remove_slot(const std::shared_ptr<slot>& in_slot);
+        //--------------------------------------------------------------------
+        /// Flags all slots in the current snapshot as removed and replaces
+        /// it with the given snapshot. This must be called while holding the
+        /// mutex.
+        ///
+        /// @param The new snapshot
+        //--------------------------------------------------------------------
+        void replace_snapshot(std::shared_ptr<snapshot> in_snapshot);
         
     private:
         
-        std::vector<std::pair<TType, bool>> m_container;
-        
+        std::shared_ptr<snapshot> m_snapshot;
+        mutable bool m_isSnapshotShared = false;
         std::atomic<size_type> m_size;
-        bool m_isLocked = false;
-        bool m_requiresGC = false;
         
-        std::recursive_mutex m_mutex;
-        std::unique_lock<std::recursive_mutex> m_lock;
-        s32 m_lockCount = 0;
+        mutable std::recursive_mutex m_mutex;
     };
     
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> concurrent_vector<TType>::concurrent_vector()
-    : m_lock(m_mutex, std::defer_lock), m_size(0)
+    : m_snapshot(std::make_shared<snapshot>()), m_size(0)
     {
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> concurrent_vector<TType>::concurrent_vector(std::initializer_list<TType>&& in_initialObjects)
-    : m_lock(m_mutex, std::defer_lock), m_size(0)
+    : m_snapshot(std::make_shared<snapshot>()), m_size(0)
     {
         m_size = in_initialObjects.size();
-        m_container.reserve(m_size);
+        m_snapshot->reserve(m_size);
         
         for(const auto& object : in_initialObjects)
         {
-            m_container.push_back(std::make_pair(object, false));
+            m_snapshot->push_back(std::make_shared<slot>(object));
         }
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> concurrent_vector<TType>::concurrent_vector(const concurrent_vector& in_toCopy)
+    : m_snapshot(std::make_shared<snapshot>()), m_size(0)
     {
-        m_size = in_toCopy.m_size.load();
-        m_container = in_toCopy.m_container;
+        *this = in_toCopy;
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> concurrent_vector<TType>& concurrent_vector<TType>::operator=(const concurrent_vector<TType>& in_toCopy)
     {
-        m_size = in_toCopy.m_size.load();
-        m_container = in_toCopy.m_container;
+        if(this != &in_toCopy)
+        {
+            auto toCopy = in_toCopy.get_snapshot();
+            auto copy = std::make_shared<snapshot>();
+            copy->reserve(toCopy->size());
+            
+            for(const auto& objectSlot : *toCopy)
+            {
+                if(objectSlot->m_isRemoved == false)
+                {
+                    copy->push_back(std::make_shared<slot>(objectSlot->m_object));
+                }
+            }
+            
+            std::unique_lock<std::recursive_mutex> scopedLock(m_mutex);
+            replace_snapshot(std::move(copy));
+        }
+        
+        return *this;
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> concurrent_vector<TType>::concurrent_vector(concurrent_vector&& in_toMove)
+    : m_snapshot(std::make_shared<snapshot>()), m_size(0)
     {
-        m_size = in_toMove.m_size.load();
-        in_toMove.m_size = 0;
-        m_container = std::move(in_toMove.m_container);
+        *this = std::move(in_toMove);
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> concurrent_vector<TType>& concurrent_vector<TType>::operator=(concurrent_vector<TType>&& in_toMove)
     {
-        m_size = in_toMove.m_size.load();
-        in_toMove.m_size = 0;
-        m_container = std::move(in_toMove.m_container);
+        if(this != &in_toMove)
+        {
+            std::unique_lock<std::recursive_mutex> toMoveLock(in_toMove.m_mutex);
+            auto moved = std::move(in_toMove.m_snapshot);
+            in_toMove.m_snapshot = std::make_shared<snapshot>();
+            in_toMove.m_size = 0;
+            toMoveLock.unlock();
+            
+            std::unique_lock<std::recursive_mutex> scopedLock(m_mutex);
+            replace_snapshot(std::move(moved));
+            
+            //Iterators of the moved vector may still be walking the snapshot.
+            m_isSnapshotShared = true;
+        }
+        
+        return *this;
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> void concurrent_vector<TType>::push_back(TType&& in_object)
     {
         std::unique_lock<std::recursive_mutex> scopedLock(m_mutex);
-        m_container.push_back(std::make_pair(std::forward<TType>(in_object), false));
+        get_mutable_snapshot().push_back(std::make_shared<slot>(std::forward<TType>(in_object)));
         m_size++;
     }
     //--------------------------------------------------------------------
@@ -399,7 +461,7 @@ namespace ChilliSource
     template <typename TType> void concurrent_vector<TType>::push_back(const TType& in_object)
     {
         std::unique_lock<std::recursive_mutex> scopedLock(m_mutex);
-        m_container.push_back(std::make_pair(in_object, false));
+        get_mutable_snapshot().push_back(std::make_shared<slot>(in_object));
         m_size++;
     }
     //--------------------------------------------------------------------
@@ -431,87 +493,26 @@ namespace ChilliSource
     template <typename TType> TType& concurrent_vector<TType>::at(size_type in_index)
     {
         std::unique_lock<std::recursive_mutex> scopedLock(m_mutex);
-        if(m_requiresGC == false)
-        {
-            return m_container.at(in_index).first;
-        }
-        else
-        {
-            size_type size = m_container.size();
-            difference_type count = -1;
-            size_type index = 0;
-            for(size_type i=0; i<size; ++i)
-            {
-                if(m_container[i].second == false)
-                {
-                    if(++count == in_index)
-                    {
-                        index = i;
-                        break;
-                    }
-                }
-            }
-            
-            return m_container[index].first;
-        }
+        return m_snapshot->at(in_index)->m_object;
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> const TType& concurrent_vector<TType>::at(size_type in_index) const
     {
         std::unique_lock<std::recursive_mutex> scopedLock(m_mutex);
-        if(m_requiresGC == false)
-        {
-            return m_container.at(in_index).first;
-        }
-        else
-        {
-            size_type size = m_container.size();
-            difference_type count = -1;
-            size_type index = 0;
-            for(size_type i=0; i<size; ++i)
-            {
-                if(m_container[i].second == false)
-                {
-                    if(++count == in_index)
-                    {
-                        index = i;
-                        break;
-                    }
-                }
-            }
-            
-            return m_container[index].first;
-        }
+        return m_snapshot->at(in_index)->m_object;
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> void concurrent_vector<TType>::lock()
     {
-        std::unique_lock<std::recursive_mutex> scopedLock(m_mutex);
-        
-        if (m_lockCount == 0)
-        {
-            m_lock.lock();
-        }
-        
-        m_lockCount++;
-        m_isLocked = true;
+        m_mutex.lock();
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> void concurrent_vector<TType>::unlock()
     {
-        std::unique_lock<std::recursive_mutex> scopedLock(m_mutex);
-        
-        m_isLocked = false;
-        m_lockCount--;
-        
-        if (m_lockCount == 0)
-        {
-            garbage_collect();
-            m_lock.unlock();
-        }
+        m_mutex.unlock();
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
@@ -529,73 +530,73 @@ namespace ChilliSource
     //--------------------------------------------------------------------
     template <typename TType> typename concurrent_vector<TType>::iterator concurrent_vector<TType>::begin()
     {
-        return iterator(&m_container, &m_mutex);
+        return iterator(get_snapshot());
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> typename concurrent_vector<TType>::iterator concurrent_vector<TType>::end()
     {
-        return iterator(&m_container, &m_mutex) + size();
+        return iterator();
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> typename concurrent_vector<TType>::const_iterator concurrent_vector<TType>::begin() const
     {
-        return const_iterator(&m_container, const_cast<std::recursive_mutex*>(&m_mutex));
+        return const_iterator(get_snapshot());
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> typename concurrent_vector<TType>::const_iterator concurrent_vector<TType>::end() const
     {
-        return const_iterator(&m_container, const_cast<std::recursive_mutex*>(&m_mutex)) + size();
+        return const_iterator();
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> typename concurrent_vector<TType>::const_iterator concurrent_vector<TType>::cbegin() const
     {
-        return const_iterator(&m_container, const_cast<std::recursive_mutex*>(&m_mutex));
+        return const_iterator(get_snapshot());
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> typename concurrent_vector<TType>::const_iterator concurrent_vector<TType>::cend() const
     {
-        return const_iterator(&m_container, const_cast<std::recursive_mutex*>(&m_mutex)) + size();
+        return const_iterator();
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> typename concurrent_vector<TType>::reverse_iterator concurrent_vector<TType>::rbegin()
     {
-        return reverse_iterator(&m_container, &m_mutex);
+        return reverse_iterator(get_snapshot());
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> typename concurrent_vector<TType>::reverse_iterator concurrent_vector<TType>::rend()
     {
-        return reverse_iterator(&m_container, &m_mutex) + size();
+        return reverse_iterator();
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> typename concurrent_vector<TType>::const_reverse_iterator concurrent_vector<TType>::rbegin() const
     {
-        return const_reverse_iterator(&m_container, const_cast<std::recursive_mutex*>(&m_mutex));
+        return const_reverse_iterator(get_snapshot());
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> typename concurrent_vector<TType>::const_reverse_iterator concurrent_vector<TType>::rend() const
     {
-        return const_reverse_iterator(&m_container, const_cast<std::recursive_mutex*>(&m_mutex)) + size();
+        return const_reverse_iterator();
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> typename concurrent_vector<TType>::const_reverse_iterator concurrent_vector<TType>::crbegin() const
     {
-        return const_reverse_iterator(&m_container, const_cast<std::recursive_mutex*>(&m_mutex));
+        return const_reverse_iterator(get_snapshot());
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
     template <typename TType> typename concurrent_vector<TType>::const_reverse_iterator concurrent_vector<TType>::crend() const
     {
-        return const_reverse_iterator(&m_container, const_cast<std::recursive_mutex*>(&m_mutex)) + size();
+        return const_reverse_iterator();
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
@@ -613,40 +614,17 @@ namespace ChilliSource
     //--------------------------------------------------------------------
     template <typename TType> concurrent_vector_forward_iterator<TType>  concurrent_vector<TType>::erase(const concurrent_vector_forward_iterator<TType>& in_itErase)
     {
-        std::unique_lock<std::recursive_mutex> scopedLock(m_mutex);
-        if(m_isLocked == false)
-        {
-            m_container.erase(m_container.begin() + in_itErase.get_index());
-        }
-        else
-        {
-            m_container[in_itErase.get_index()].second = true;
-            m_requiresGC = true;
-        }
-        
-        m_size--;
+        remove_slot(in_itErase.get_slot());
         
         auto itCopy = in_itErase;
         ++itCopy;
         return itCopy;
     }
     //--------------------------------------------------------------------
-    /// This uses the 
     //--------------------------------------------------------------------
     template <typename TType> concurrent_vector_reverse_iterator<TType> concurrent_vector<TType>::erase(const concurrent_vector_reverse_iterator<TType>& in_itErase)
     {
-        std::unique_lock<std::recursive_mutex> scopedLock(m_mutex);
-        if(m_isLocked == false)
-        {
-            m_container.erase(m_container.begin() + in_itErase.get_index());
-        }
-        else
-        {
-            m_container[in_itErase.get_index()].second = true;
-            m_requiresGC = true;
-        }
-        
-        m_size--;
+        remove_slot(in_itErase.get_slot());
         
         auto itCopy = in_itErase;
         ++itCopy;
@@ -657,40 +635,60 @@ namespace ChilliSource
     template <typename TType> void concurrent_vector<TType>::clear()
     {
         std::unique_lock<std::recursive_mutex> scopedLock(m_mutex);
-        if(m_isLocked == false)
+        replace_snapshot(std::make_shared<snapshot>());
+    }
+    //--------------------------------------------------------------------
+    //--------------------------------------------------------------------
+    template <typename TType> std::shared_ptr<const typename concurrent_vector<TType>::snapshot> concurrent_vector<TType>::get_snapshot() const
+    {
+        std::unique_lock<std::recursive_mutex> scopedLock(m_mutex);
+        m_isSnapshotShared = true;
+        return m_snapshot;
+    }
+    //--------------------------------------------------------------------
+    //--------------------------------------------------------------------
+    template <typename TType> typename concurrent_vector<TType>::snapshot& concurrent_vector<TType>::get_mutable_snapshot()
+    {
+        //The use count can't be relied on here as it gives no ordering with the reads of an iterator which has just
+        //let go of the snapshot, so any snapshot which has been handed out is treated as in use.
+        if(m_isSnapshotShared == true)
         {
-            m_container.clear();
-            
+            m_snapshot = std::make_shared<snapshot>(*m_snapshot);
+            m_isSnapshotShared = false;
         }
-        else
+        
+        return *m_snapshot;
+    }
+    //--------------------------------------------------------------------
+    //--------------------------------------------------------------------
+    template <typename TType> void concurrent_vector<TType>::remove_slot(const std::shared_ptr<slot>& in_slot)
+    {
+        std::unique_lock<std::recursive_mutex> scopedLock(m_mutex);
+        if(in_slot->m_isRemoved.exchange(true) == true)
         {
-            for(auto& object : m_container)
-            {
-                object.second = true;
-            }
-            
-            m_requiresGC = true;
+            return;
         }
         
-        m_size = 0;
+        auto& objects = get_mutable_snapshot();
+        auto it = std::find(objects.begin(), objects.end(), in_slot);
+        if(it != objects.end())
+        {
+            objects.erase(it);
+            m_size--;
+        }
     }
     //--------------------------------------------------------------------
     //--------------------------------------------------------------------
-    template <typename TType> void concurrent_vector<TType>::garbage_collect()
+    template <typename TType> void concurrent_vector<TType>::replace_snapshot(std::shared_ptr<snapshot> in_snapshot)
     {
-        for(auto it = m_container.begin(); it != m_container.end(); )
+        for(const auto& objectSlot : *m_snapshot)
         {
-            if(it->second == true)
-            {
-                it = m_container.erase(it);
-            }
-            else
-            {
-                ++it;
-            }
+            objectSlot->m_isRemoved = true;
         }
         
-        m_requiresGC = false;
+        m_snapshot = std::move(in_snapshot);
+        m_isSnapshotShared = false;
+        m_size = m_snapshot->size();
     }
 }
 
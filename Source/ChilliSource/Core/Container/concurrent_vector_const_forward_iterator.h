@@ -25,18 +25,23 @@
 //  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 //  THE SOFTWARE.
 //
-
 #ifndef _CHILLISOURCE_CORE_CONTAINER_CONCURRENTVECTORCONSTFORWARDITERATOR_H_
 #define _CHILLISOURCE_CORE_CONTAINER_CONCURRENTVECTORCONSTFORWARDITERATOR_H_
 
-#include <mutex>
-#include <vector>
+#include <ChilliSource/Core/Container/concurrent_vector_snapshot.h>
+
+#include <algorithm>
+#include <limits>
 
 namespace ChilliSource
 {
     //------------------------------------------------------------------------
     /// Forward iterator for the concurrent vector class that is read only
     ///
+    /// The iterator holds the snapshot of the vector that was current when
+    /// it was created, so it never locks and is unaffected by elements added
+    /// during iteration. Elements erased during iteration are skipped.
+    ///
     /// @author S Downie
     //------------------------------------------------------------------------
     template <typename TType> class concurrent_vector_const_forward_iterator
@@ -45,16 +50,19 @@ namespace ChilliSource
         
         using difference_type = typename std::iterator<std::forward_iterator_tag, TType>::difference_type;
         
+        //------------------------------------------------------------------------
+        /// Constructs an iterator pointing to the end of any vector.
+        //------------------------------------------------------------------------
+        concurrent_vector_const_forward_iterator() = default;
         //------------------------------------------------------------------------
         /// Constructor
         ///
         /// @author S Downie
         ///
-        /// @param Data structure to iterate over
-        /// @param Mutex used to protect the underlying iterable
+        /// @param Snapshot of the vector to iterate over
         //------------------------------------------------------------------------
-        concurrent_vector_const_forward_iterator(const std::vector<std::pair<TType, bool>>* in_iterable, std::recursive_mutex* in_iterableMutex)
-        : m_iterable(in_iterable), m_iterableMutex(in_iterableMutex)
+        concurrent_vector_const_forward_iterator(const std::shared_ptr<const concurrent_vector_snapshot<TType>>& in_snapshot)
+        : m_snapshot(in_snapshot)
         {
             m_iterableIndex = find_next_occupied_index(0);
         }
@@ -65,10 +73,7 @@ namespace ChilliSource
         ///
         /// @param iterator to copy
         //--------------------------------------------------------------------
-        concurrent_vector_const_forward_iterator(const concurrent_vector_const_forward_iterator& in_toCopy)
-        : m_iterableIndex(in_toCopy.m_iterableIndex), m_iterable(in_toCopy.m_iterable), m_iterableMutex(in_toCopy.m_iterableMutex)
-        {
-        }
+        concurrent_vector_const_forward_iterator(const concurrent_vector_const_forward_iterator& in_toCopy) = default;
         //--------------------------------------------------------------------
         /// Copy assignment that creates this as a copy of the given iterator
         ///
@@ -78,14 +83,7 @@ namespace ChilliSource
         ///
         /// @return This as a copy
         //--------------------------------------------------------------------
-        concurrent_vector_const_forward_iterator& operator=(const concurrent_vector_const_forward_iterator& in_toCopy)
-        {
-            m_iterableIndex = in_toCopy.m_iterableIndex;
-            m_iterable = in_toCopy.m_iterable;
-            m_iterableMutex = in_toCopy.m_iterableMutex;
-            
-            return *this;
-        }
+        concurrent_vector_const_forward_iterator& operator=(const concurrent_vector_const_forward_iterator& in_toCopy) = default;
         //--------------------------------------------------------------------
         /// Move constructor that transfers ownership from the given iterator
         ///
@@ -94,11 +92,9 @@ namespace ChilliSource
         /// @param iterator to move
         //--------------------------------------------------------------------
         concurrent_vector_const_forward_iterator(concurrent_vector_const_forward_iterator&& in_toMove)
-        : m_iterableIndex(in_toMove.m_iterableIndex), m_iterable(in_toMove.m_iterable), m_iterableMutex(in_toMove.m_iterableMutex)
+        : m_snapshot(std::move(in_toMove.m_snapshot)), m_iterableIndex(in_toMove.m_iterableIndex)
         {
             in_toMove.m_iterableIndex = 0;
-            in_toMove.m_iterable = nullptr;
-            in_toMove.m_iterableMutex = nullptr;
         }
         //--------------------------------------------------------------------
         /// Move assignment that transfers ownership from the given iterator
@@ -113,10 +109,7 @@ namespace ChilliSource
         {
             m_iterableIndex = in_toMove.m_iterableIndex;
             in_toMove.m_iterableIndex = 0;
-            m_iterable = in_toMove.m_iterable;
-            in_toMove.m_iterable = nullptr;
-            m_iterableMutex = in_toMove.m_iterableMutex;
-            in_toMove.m_iterableMutex = nullptr;
+            m_snapshot = std::move(in_toMove.m_snapshot);
             
             return *this;
         }
@@ -144,7 +137,7 @@ namespace ChilliSource
         //------------------------------------------------------------------------
         concurrent_vector_const_forward_iterator& operator+=(difference_type in_stride)
         {
-            m_iterableIndex = find_next_occupied_index(m_iterableIndex + in_stride);
+            m_iterableIndex = find_occupied_index_at_stride(m_iterableIndex, in_stride);
             return *this;
         }
         //------------------------------------------------------------------------
@@ -157,10 +150,10 @@ namespace ChilliSource
         ///
         /// @return New iterator
         //------------------------------------------------------------------------
-        concurrent_vector_const_forward_iterator operator+(difference_type in_stride)
+        concurrent_vector_const_forward_iterator operator+(difference_type in_stride) const
         {
-            auto iterableIndex = find_next_occupied_index(m_iterableIndex + in_stride);
-            return concurrent_vector_const_forward_iterator(m_iterable, m_iterableMutex, iterableIndex);
+            auto iterableIndex = find_occupied_index_at_stride(m_iterableIndex, in_stride);
+            return concurrent_vector_const_forward_iterator(m_snapshot, iterableIndex);
         }
         //------------------------------------------------------------------------
         /// @author S Downie
@@ -169,8 +162,7 @@ namespace ChilliSource
         //------------------------------------------------------------------------
         const TType* operator->() const
         {
-            std::unique_lock<std::recursive_mutex> scopedLock(*m_iterableMutex);
-            return &((*m_iterable)[m_iterableIndex].first);
+            return &((*m_snapshot)[m_iterableIndex]->m_object);
         }
         //------------------------------------------------------------------------
         /// @author S Downie
@@ -179,8 +171,7 @@ namespace ChilliSource
         //------------------------------------------------------------------------
         const TType& operator*() const
         {
-            std::unique_lock<std::recursive_mutex> scopedLock(*m_iterableMutex);
-            return (*m_iterable)[m_iterableIndex].first;
+            return (*m_snapshot)[m_iterableIndex]->m_object;
         }
         //------------------------------------------------------------------------
         /// @author S Downie
@@ -191,7 +182,7 @@ namespace ChilliSource
         //------------------------------------------------------------------------
         bool operator==(const concurrent_vector_const_forward_iterator& in_toCompare) const
         {
-            return m_iterableIndex == in_toCompare.m_iterableIndex;
+            return get_position() == in_toCompare.get_position();
         }
         //------------------------------------------------------------------------
         /// @author S Downie
@@ -202,7 +193,7 @@ namespace ChilliSource
         //------------------------------------------------------------------------
         bool operator!=(const concurrent_vector_const_forward_iterator& in_toCompare) const
         {
-            return m_iterableIndex != in_toCompare.m_iterableIndex;
+            return get_position() != in_toCompare.get_position();
         }
         //------------------------------------------------------------------------
         /// @author S Downie
@@ -213,7 +204,7 @@ namespace ChilliSource
         //------------------------------------------------------------------------
         bool operator>(const concurrent_vector_const_forward_iterator& in_toCompare) const
         {
-            return m_iterableIndex > in_toCompare.m_iterableIndex;
+            return get_position() > in_toCompare.get_position();
         }
         //------------------------------------------------------------------------
         /// @author S Downie
@@ -224,7 +215,7 @@ namespace ChilliSource
         //------------------------------------------------------------------------
         bool operator>=(const concurrent_vector_const_forward_iterator& in_toCompare) const
         {
-            return m_iterableIndex >= in_toCompare.m_iterableIndex;
+            return get_position() >= in_toCompare.get_position();
         }
         //------------------------------------------------------------------------
         /// @author S Downie
@@ -235,7 +226,7 @@ namespace ChilliSource
         //------------------------------------------------------------------------
         bool operator<(const concurrent_vector_const_forward_iterator& in_toCompare) const
         {
-            return m_iterableIndex < in_toCompare.m_iterableIndex;
+            return get_position() < in_toCompare.get_position();
         }
         //------------------------------------------------------------------------
         /// @author S Downie
@@ -246,19 +237,17 @@ namespace ChilliSource
         //------------------------------------------------------------------------
         bool operator<=(const concurrent_vector_const_forward_iterator& in_toCompare) const
         {
-            return m_iterableIndex <= in_toCompare.m_iterableIndex;
+            return get_position() <= in_toCompare.get_position();
         }
         //------------------------------------------------------------------------
-        /// NOTE: This is an internal method used to query the element index
-        /// pointed to by the iterator
+        /// NOTE: This is an internal method used to query the element pointed
+        /// to by the iterator
         ///
-        /// @author S Downie
-        ///
-        /// @param Element index that the iterate currently points to
+        /// @return The slot holding the element the iterator currently points to
         //------------------------------------------------------------------------
-        difference_type get_index() const
+        const std::shared_ptr<concurrent_vector_slot<TType>>& get_slot() const
         {
-            return m_iterableIndex;
+            return (*m_snapshot)[m_iterableIndex];
         }
         
     private:
@@ -267,12 +256,11 @@ namespace ChilliSource
         ///
         /// @author S Downie
         ///
-        /// @param Data structure to iterate over
-        /// @param Mutex used to protect the underlying iterable
+        /// @param Snapshot of the vector to iterate over
         /// @param Initial index
         //------------------------------------------------------------------------
-        concurrent_vector_const_forward_iterator(const std::vector<std::pair<TType, bool>>* in_iterable, std::recursive_mutex* in_iterableMutex, difference_type in_initialIndex)
-        : m_iterable(in_iterable), m_iterableMutex(in_iterableMutex), m_iterableIndex(in_initialIndex)
+        concurrent_vector_const_forward_iterator(const std::shared_ptr<const concurrent_vector_snapshot<TType>>& in_snapshot, difference_type in_initialIndex)
+        : m_snapshot(in_snapshot), m_iterableIndex(in_initialIndex)
         {
             
         }
@@ -280,20 +268,21 @@ namespace ChilliSource
         /// Find the next element index (inclusive of given index) that is not
         /// flagged for removal
         ///
-        /// @author S Downie
-        ///
         /// @param Index to begin at (inclusive)
         ///
         /// @return Index of next element (or end if none)
         //------------------------------------------------------------------------
         difference_type find_next_occupied_index(difference_type in_beginIndex) const
         {
-            std::unique_lock<std::recursive_mutex> scopedLock(*m_iterableMutex);
-            auto size = m_iterable->size();
+            if(m_snapshot == nullptr)
+            {
+                return 0;
+            }
             
-            for(std::size_t i = in_beginIndex; i < size; ++i)
+            auto size = difference_type(m_snapshot->size());
+            for(auto i = in_beginIndex; i < size; ++i)
             {
-                if((*m_iterable)[i].second == false)
+                if((*m_snapshot)[i]->m_isRemoved.load(std::memory_order_acquire) == false)
                 {
                     return i;
                 }
@@ -301,12 +290,43 @@ namespace ChilliSource
             
             return size;
         }
+        //------------------------------------------------------------------------
+        /// Steps over the given number of elements that are not flagged for
+        /// removal, so that removed elements don't count towards the stride.
+        ///
+        /// @param Index to begin at
+        /// @param Number of elements to step over
+        ///
+        /// @return Index of the element at the stride (or end if none)
+        //------------------------------------------------------------------------
+        difference_type find_occupied_index_at_stride(difference_type in_beginIndex, difference_type in_stride) const
+        {
+            auto index = in_beginIndex;
+            for(difference_type i = 0; i < in_stride; ++i)
+            {
+                index = find_next_occupied_index(index + 1);
+            }
+            
+            return index;
+        }
+        //------------------------------------------------------------------------
+        /// @return The position of the iterator in iteration order. The end
+        /// position is larger than any other.
+        //------------------------------------------------------------------------
+        difference_type get_position() const
+        {
+            if(m_snapshot == nullptr || m_iterableIndex >= difference_type(m_snapshot->size()))
+            {
+                return std::numeric_limits<difference_type>::max();
+            }
+            
+            return m_iterableIndex;
+        }
         
     private:
         
+        std::shared_ptr<const concurrent_vector_snapshot<TType>> m_snapshot;
         difference_type m_iterableIndex = 0;
-        const std::vector<std::pair<TType, bool>>* m_iterable;
-        std::recursive_mutex* m_iterableMutex;
     };
 }
 
@@ -0,0 +1,71 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_CORE_CONTAINER_CONCURRENTVECTORSNAPSHOT_H_
+#define _CHILLISOURCE_CORE_CONTAINER_CONCURRENTVECTORSNAPSHOT_H_
+
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace ChilliSource
+{
+    //------------------------------------------------------------------------
+    /// A single element of a concurrent vector. Slots are shared between
+    /// every snapshot of the vector that contains them, so flagging a slot
+    /// as removed is seen by all iterators regardless of which snapshot they
+    /// are walking.
+    ///
+    /// NOTE: This is an internal type used by the concurrent vector and its
+    /// iterators.
+    //------------------------------------------------------------------------
+    template <typename TType> struct concurrent_vector_slot final
+    {
+        //--------------------------------------------------------------------
+        /// Constructor
+        ///
+        /// @param The object to store in the slot
+        //--------------------------------------------------------------------
+        template <typename TObject> explicit concurrent_vector_slot(TObject&& in_object)
+        : m_object(std::forward<TObject>(in_object))
+        {
+        }
+        
+        TType m_object;
+        std::atomic<bool> m_isRemoved{false};
+    };
+    
+    //------------------------------------------------------------------------
+    /// An immutable view of the contents of a concurrent vector at a point
+    /// in time. Once a snapshot has been handed to an iterator it is never
+    /// modified; changes to the vector are made to a copy instead.
+    ///
+    /// NOTE: This is an internal type used by the concurrent vector and its
+    /// iterators.
+    //------------------------------------------------------------------------
+    template <typename TType> using concurrent_vector_snapshot = std::vector<std::shared_ptr<concurrent_vector_slot<TType>>>;
+}
+
+#endif
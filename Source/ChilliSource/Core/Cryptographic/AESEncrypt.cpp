@@ -30,6 +30,7 @@
 
 #include <aes/aes.h>
 
+#include <cstring>
 #include <limits>
 
 namespace ChilliSource
@@ -99,7 +100,7 @@ namespace ChilliSource
                 dwBytesRemaining -= k_aesBlockSize;
             }
             
-            return std::move(output);
+            return output;
         }
         //---------------------------------------------------
         //---------------------------------------------------
@@ -129,7 +130,7 @@ namespace ChilliSource
                 dwBytesRemaining -= k_aesBlockSize;
             }
             
-            return std::move(output);
+            return output;
         }
         //---------------------------------------------------
         //---------------------------------------------------
@@ -173,7 +174,7 @@ namespace ChilliSource
             }
             AES_encrypt(finalBlock.get(), writeData, &privateKey);
             
-            return std::move(output);
+            return output;
         }
         //---------------------------------------------------
         //---------------------------------------------------
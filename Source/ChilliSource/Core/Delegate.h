@@ -32,7 +32,9 @@
 #include <ChilliSource/ChilliSource.h>
 #include <ChilliSource/Core/Delegate/ConnectableDelegate.h>
 #include <ChilliSource/Core/Delegate/DelegateConnection.h>
+#include <ChilliSource/Core/Delegate/InlineDelegate.h>
 #include <ChilliSource/Core/Delegate/MakeConnectableDelegate.h>
 #include <ChilliSource/Core/Delegate/MakeDelegate.h>
+#include <ChilliSource/Core/Delegate/MakeInlineDelegate.h>
 
 #endif
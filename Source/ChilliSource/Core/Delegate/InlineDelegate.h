@@ -0,0 +1,159 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#ifndef _CHILLISOURCE_CORE_DELEGATE_INLINEDELEGATE_H_
+#define _CHILLISOURCE_CORE_DELEGATE_INLINEDELEGATE_H_
+
+#include <ChilliSource/ChilliSource.h>
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ChilliSource
+{
+    //------------------------------------------------------------------
+    /// A lightweight alternative to std::function for delegates which
+    /// are invoked at a high frequency. The callable is stored inline in
+    /// a small fixed size buffer and called through a single function
+    /// pointer, so constructing, copying and invoking the delegate never
+    /// allocates.
+    ///
+    /// In exchange only small callables with trivial destructors can be
+    /// stored, for example free functions, the result of
+    /// MakeInlineDelegate(), or lambdas which capture a few pointers or
+    /// values. Storing a larger callable or one that owns resources is a
+    /// compile error; std::function should be used for those instead.
+    ///
+    /// An InlineDelegate can be used as the delegate type of an Event or
+    /// QueuedEvent.
+    //------------------------------------------------------------------
+    template <typename TReturnType, typename... TArgTypes> class InlineDelegate<TReturnType(TArgTypes...)> final
+    {
+    public:
+        //------------------------------------------------------------------
+        /// The maximum size of a callable which can be stored in the
+        /// delegate. This is large enough for an object pointer and a
+        /// member function pointer on all supported platforms.
+        //------------------------------------------------------------------
+        static constexpr std::size_t k_maxCallableSize = 4 * sizeof(void*);
+        //------------------------------------------------------------------
+        /// Constructs a null delegate.
+        //------------------------------------------------------------------
+        InlineDelegate() = default;
+        //------------------------------------------------------------------
+        /// Constructs a null delegate.
+        ///
+        /// @param Null ptr
+        //------------------------------------------------------------------
+        InlineDelegate(std::nullptr_t in_null)
+        {
+        }
+        //------------------------------------------------------------------
+        /// Constructs the delegate from the given callable, which is
+        /// copied into the delegate's inline storage.
+        ///
+        /// @param The callable. This can be a function pointer, or any
+        /// functor which fits within k_maxCallableSize and has a trivial
+        /// destructor.
+        //------------------------------------------------------------------
+        template <typename TCallable, typename = typename std::enable_if<!std::is_same<typename std::decay<TCallable>::type, InlineDelegate>::value>::type>
+        InlineDelegate(TCallable&& in_callable)
+        {
+            using Callable = typename std::decay<TCallable>::type;
+            
+            static_assert(sizeof(Callable) <= k_maxCallableSize, "Callable is too large to store in an InlineDelegate.");
+            static_assert(alignof(Callable) <= alignof(Storage), "Callable alignment is too strict to store in an InlineDelegate.");
+            static_assert(std::is_trivially_destructible<Callable>::value, "Only callables with trivial destructors can be stored in an InlineDelegate.");
+            
+            new (&m_storage) Callable(std::forward<TCallable>(in_callable));
+            m_invoker = &Invoke<Callable>;
+        }
+        //------------------------------------------------------------------
+        /// Invokes the stored callable. The delegate must not be null.
+        ///
+        /// @param Variadic - matches the delegate signature
+        ///
+        /// @return TReturnType - matches the delegate signature
+        //------------------------------------------------------------------
+        TReturnType operator()(TArgTypes... in_args) const
+        {
+            CS_ASSERT(m_invoker != nullptr, "Cannot invoke a null delegate.");
+            
+            return m_invoker(&m_storage, std::forward<TArgTypes>(in_args)...);
+        }
+        //------------------------------------------------------------------
+        /// @param Nullptr
+        ///
+        /// @return Whether the delegate is null
+        //------------------------------------------------------------------
+        bool operator==(std::nullptr_t in_null) const
+        {
+            return m_invoker == nullptr;
+        }
+        //------------------------------------------------------------------
+        /// @param Nullptr
+        ///
+        /// @return Whether the delegate is NOT null
+        //------------------------------------------------------------------
+        bool operator!=(std::nullptr_t in_null) const
+        {
+            return m_invoker != nullptr;
+        }
+        //------------------------------------------------------------------
+        /// @return Whether the delegate is NOT null
+        //------------------------------------------------------------------
+        explicit operator bool() const
+        {
+            return m_invoker != nullptr;
+        }
+        
+    private:
+        //------------------------------------------------------------------
+        /// Calls the callable of the given type stored in the given
+        /// buffer. A pointer to the instantiation for the stored type is
+        /// held by the delegate.
+        ///
+        /// @param The inline storage containing the callable
+        /// @param Variadic - matches the delegate signature
+        ///
+        /// @return TReturnType - matches the delegate signature
+        //------------------------------------------------------------------
+        template <typename TCallable> static TReturnType Invoke(const void* in_storage, TArgTypes... in_args)
+        {
+            auto& callable = *const_cast<TCallable*>(static_cast<const TCallable*>(in_storage));
+            return callable(std::forward<TArgTypes>(in_args)...);
+        }
+        
+        using Storage = typename std::aligned_storage<k_maxCallableSize, alignof(void*)>::type;
+        using Invoker = TReturnType (*)(const void*, TArgTypes...);
+        
+        Storage m_storage;
+        Invoker m_invoker = nullptr;
+    };
+}
+
+#endif
@@ -0,0 +1,77 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#ifndef _CHILLISOURCE_CORE_DELEGATE_MAKEINLINEDELEGATE_H_
+#define _CHILLISOURCE_CORE_DELEGATE_MAKEINLINEDELEGATE_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Delegate/InlineDelegate.h>
+
+namespace ChilliSource
+{
+    //------------------------------------------------------------------
+    /// Constructs an inline delegate to a free function with a signature
+    /// that matches the given return and parameter types.
+    ///
+    /// @param Function ptr
+    ///
+    /// @return Delegate
+    //------------------------------------------------------------------
+    template <typename TReturnType, typename... TArgTypes>
+    InlineDelegate<TReturnType(TArgTypes...)> MakeInlineDelegate(TReturnType (*in_func)(TArgTypes...))
+    {
+        return InlineDelegate<TReturnType(TArgTypes...)>(in_func);
+    }
+    //------------------------------------------------------------------
+    /// Constructs an inline delegate to a member function with a
+    /// signature that matches the given return and parameter types.
+    ///
+    /// @param Instance whose function to call
+    /// @param Member function ptr
+    ///
+    /// @return Delegate
+    //------------------------------------------------------------------
+    template <typename TDelegate, typename TSender, typename TReturnType, typename... TArgTypes>
+    InlineDelegate<TReturnType(TArgTypes...)> MakeInlineDelegate(TSender* in_sender, TReturnType (TDelegate::*in_func)(TArgTypes...))
+    {
+        return InlineDelegate<TReturnType(TArgTypes...)>([=](TArgTypes... in_args) -> TReturnType { return (in_sender->*in_func)(std::forward<TArgTypes>(in_args)...); });
+    }
+    //------------------------------------------------------------------
+    /// Constructs an inline delegate to a const member function with a
+    /// signature that matches the given return and parameter types.
+    ///
+    /// @param Instance whose function to call
+    /// @param Const member function ptr
+    ///
+    /// @return Delegate
+    //------------------------------------------------------------------
+    template <typename TDelegate, typename TSender, typename TReturnType, typename... TArgTypes>
+    InlineDelegate<TReturnType(TArgTypes...)> MakeInlineDelegate(const TSender* in_sender, TReturnType (TDelegate::*in_func)(TArgTypes...) const)
+    {
+        return InlineDelegate<TReturnType(TArgTypes...)>([=](TArgTypes... in_args) -> TReturnType { return (in_sender->*in_func)(std::forward<TArgTypes>(in_args)...); });
+    }
+}
+
+#endif
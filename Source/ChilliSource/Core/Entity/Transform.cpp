@@ -603,6 +603,12 @@ namespace ChilliSource
         return mTransformChangedEvent;
     }
     //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    IConnectableEvent<Transform::QueuedTransformChangedDelegate>& Transform::GetQueuedTransformChangedEvent()
+    {
+        return mQueuedTransformChangedEvent;
+    }
+    //----------------------------------------------------------------
     /// On Transform Changed 
     ///
     /// Triggered when our transform changes so we can 
@@ -618,6 +624,7 @@ namespace ChilliSource
         }
         
         mTransformChangedEvent.NotifyConnections();
+        mQueuedTransformChangedEvent.QueueNotification();
     }
     //----------------------------------------------------------------
     /// On Parent Transform Changed 
@@ -643,5 +650,6 @@ namespace ChilliSource
         mpParentTransform = nullptr;
         mChildTransforms.clear();
         mTransformChangedEvent.CloseAllConnections();
+        mQueuedTransformChangedEvent.CloseAllConnections();
     }
 }
@@ -30,7 +30,9 @@
 #define _CHILLISOURCE_CORE_TRANSFORM_H_
 
 #include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Delegate/InlineDelegate.h>
 #include <ChilliSource/Core/Event/Event.h>
+#include <ChilliSource/Core/Event/QueuedEvent.h>
 #include <ChilliSource/Core/Math/Matrix4.h>
 #include <ChilliSource/Core/Math/Vector3.h>
 #include <ChilliSource/Core/Math/Quaternion.h>
@@ -43,6 +45,7 @@ namespace ChilliSource
     {
     public:
         typedef std::function<void()> TransformChangedDelegate;
+        typedef InlineDelegate<void()> QueuedTransformChangedDelegate;
         
         Transform();
         //----------------------------------------------------------
@@ -328,9 +331,30 @@ namespace ChilliSource
         /// Subscribe to this event for notifications of when this
         /// transform is invalidated
         ///
+        /// This is notified immediately on every change to this
+        /// transform or any of its parents, so should only be used by
+        /// listeners which need to invalidate state before the next
+        /// query, such as cached bounds. Listeners which can wait until
+        /// the end of the frame should use the queued transform changed
+        /// event instead.
+        ///
         /// @return TransformChangedDelegate event
         //----------------------------------------------------------------
         IConnectableEvent<TransformChangedDelegate>& GetTransformChangedEvent();
+        //----------------------------------------------------------------
+        /// Subscribe to this event to be notified at most once per frame
+        /// that this transform has been invalidated, however many times
+        /// it changed during the frame. Notifications are dispatched by
+        /// the EventQueue after the application has updated.
+        ///
+        /// This is considerably cheaper than the transform changed event
+        /// for transforms which change many times per frame, and should
+        /// be preferred by listeners which don't need to react to each
+        /// change immediately.
+        ///
+        /// @return The queued transform changed event.
+        //----------------------------------------------------------------
+        IConnectableEvent<QueuedTransformChangedDelegate>& GetQueuedTransformChangedEvent();
         
         //----------------------------------------------------------------
         /// Resets the transform back to identity and removes any
@@ -371,6 +395,7 @@ namespace ChilliSource
         mutable Quaternion mqWorldOrientation;
         
         Event<TransformChangedDelegate> mTransformChangedEvent;
+        QueuedEvent<QueuedTransformChangedDelegate> mQueuedTransformChangedEvent;
         
         Transform* mpParentTransform;
         
@@ -32,7 +32,10 @@
 #include <ChilliSource/ChilliSource.h>
 #include <ChilliSource/Core/Event/Event.h>
 #include <ChilliSource/Core/Event/EventConnection.h>
+#include <ChilliSource/Core/Event/EventQueue.h>
 #include <ChilliSource/Core/Event/IConnectableEvent.h>
 #include <ChilliSource/Core/Event/IDisconnectableEvent.h>
+#include <ChilliSource/Core/Event/IQueuedEvent.h>
+#include <ChilliSource/Core/Event/QueuedEvent.h>
 
 #endif
\ No newline at end of file
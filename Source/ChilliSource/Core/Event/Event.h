@@ -35,6 +35,7 @@
 #include <ChilliSource/Core/Event/IConnectableEvent.h>
 #include <ChilliSource/Core/Event/IDisconnectableEvent.h>
 
+#include <algorithm>
 #include <vector>
 
 namespace ChilliSource
@@ -45,6 +46,12 @@ namespace ChilliSource
     /// Objects should though expose the IConnectableEvent interface
     /// to prevent other objects invoking the event.
     ///
+    /// Closing a connection only flags it as closed; closed connections
+    /// are removed in a single pass once the event is no longer being
+    /// notified, or once they make up the majority of the list. This
+    /// keeps closing a connection cheap and makes it safe to do from
+    /// within a notification, including nested notifications.
+    ///
     /// @author S Downie
     //-----------------------------------------------------------------
     template <typename TDelegateType> class Event final : public IConnectableEvent<TDelegateType>, public IDisconnectableEvent
@@ -86,8 +93,10 @@ namespace ChilliSource
         {
             CloseAllConnections();
 
-            m_isNotifying = in_moveFrom.m_isNotifying;
+            m_notifyDepth = in_moveFrom.m_notifyDepth;
+            m_numClosedConnections = in_moveFrom.m_numClosedConnections;
             m_connections = std::move(in_moveFrom.m_connections);
+            in_moveFrom.m_numClosedConnections = 0;
             for (auto& connectionContainer : m_connections)
             {
                 connectionContainer.m_connection->SetOwningEvent(this);
@@ -108,8 +117,10 @@ namespace ChilliSource
         {
             CloseAllConnections();
 
-            m_isNotifying = in_moveFrom.m_isNotifying;
+            m_notifyDepth = in_moveFrom.m_notifyDepth;
+            m_numClosedConnections = in_moveFrom.m_numClosedConnections;
             m_connections = std::move(in_moveFrom.m_connections);
+            in_moveFrom.m_numClosedConnections = 0;
             for (auto& connectionContainer : m_connections)
             {
                 connectionContainer.m_connection->SetOwningEvent(this);
@@ -129,6 +140,13 @@ namespace ChilliSource
         //-------------------------------------------------------------
         EventConnectionUPtr OpenConnection(const TDelegateType& in_delegate) override
         {
+            //Events which are rarely notified would otherwise never drop their closed
+            //connections, so compact here once they outnumber the open ones.
+            if (m_notifyDepth == 0 && m_numClosedConnections > m_connections.size() / 2)
+            {
+                RemoveClosedConnections();
+            }
+            
             EventConnectionUPtr connection(new EventConnection());
             connection->SetOwningEvent(this);
         
@@ -141,7 +159,8 @@ namespace ChilliSource
         }
         //-------------------------------------------------------------
         /// Close connection to the event. The connection will
-        /// no longer be notified of the event
+        /// no longer be notified of the event. The connection is
+        /// flagged as closed and removed from the list later.
         ///
         /// @author S Downie
         ///
@@ -154,15 +173,8 @@ namespace ChilliSource
                 ConnectionDesc& desc = m_connections[i];
                 if(desc.m_connection == in_connection)
                 {
-                    if(m_isNotifying == false)
-                    {
-                        m_connections.erase(m_connections.begin() + i);
-                    }
-                    else
-                    {
-                        desc.m_connection = nullptr;
-                    }
-                    
+                    desc.m_connection = nullptr;
+                    ++m_numClosedConnections;
                     return;
                 }
             }
@@ -176,7 +188,7 @@ namespace ChilliSource
         //-------------------------------------------------------------
         template <typename... TArgTypes> void NotifyConnections(TArgTypes&&... in_args)
         {
-            m_isNotifying = true;
+            ++m_notifyDepth;
             
             //Take a snapshot of the number of delegates so any new ones added
             //during the notify loop aren't notified themseleves.
@@ -189,12 +201,24 @@ namespace ChilliSource
                 }
             }
             
-            m_isNotifying = false;
+            --m_notifyDepth;
             
-            RemoveClosedConnections();
+            if (m_notifyDepth == 0 && m_numClosedConnections > 0)
+            {
+                RemoveClosedConnections();
+            }
+        }
+        //-------------------------------------------------------------
+        /// @return Whether or not the event has any open connections.
+        //-------------------------------------------------------------
+        bool HasConnections() const
+        {
+            return m_connections.size() > m_numClosedConnections;
         }
         //-------------------------------------------------------------
-        /// Closes all the currently open connections
+        /// Closes all the currently open connections. If the event is
+        /// currently being notified the connections are flagged as
+        /// closed rather than removed.
         ///
         /// @author S Downie
         //-------------------------------------------------------------
@@ -205,10 +229,19 @@ namespace ChilliSource
                 if(m_connections[i].m_connection != nullptr)
                 {
                     m_connections[i].m_connection->SetOwningEvent(nullptr);
+                    m_connections[i].m_connection = nullptr;
                 }
             }
             
-            m_connections.clear();
+            if (m_notifyDepth == 0)
+            {
+                m_connections.clear();
+                m_numClosedConnections = 0;
+            }
+            else
+            {
+                m_numClosedConnections = u32(m_connections.size());
+            }
         }
 
     private:
@@ -220,17 +253,8 @@ namespace ChilliSource
         //-------------------------------------------------------------------------
         void RemoveClosedConnections()
         {
-            for(typename ConnectionList::iterator it = m_connections.begin(); it != m_connections.end(); )
-            {
-                if(it->m_connection == nullptr)
-                {
-                    it = m_connections.erase(it);
-                }
-                else
-                {
-                    ++it;
-                }
-            }
+            m_connections.erase(std::remove_if(m_connections.begin(), m_connections.end(), [](const ConnectionDesc& in_desc) { return in_desc.m_connection == nullptr; }), m_connections.end());
+            m_numClosedConnections = 0;
         }
 
     private:
@@ -244,7 +268,8 @@ namespace ChilliSource
         typedef std::vector<ConnectionDesc> ConnectionList;
         ConnectionList m_connections;
     
-        bool m_isNotifying = false;
+        u32 m_notifyDepth = 0;
+        u32 m_numClosedConnections = 0;
     };
 }
 
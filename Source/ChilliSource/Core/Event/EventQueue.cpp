@@ -0,0 +1,96 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Core/Event/EventQueue.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Event/IQueuedEvent.h>
+#include <ChilliSource/Core/Threading/TaskScheduler.h>
+
+#include <vector>
+
+namespace ChilliSource
+{
+    namespace
+    {
+        std::vector<IQueuedEvent*> g_pendingEvents;
+        std::vector<IQueuedEvent*> g_dispatchingEvents;
+        bool g_isDispatching = false;
+    }
+    
+    constexpr u32 EventQueue::k_notQueued;
+    
+    //------------------------------------------------------------------------------
+    u32 EventQueue::Enqueue(IQueuedEvent* in_event)
+    {
+        CS_ASSERT(in_event != nullptr, "Cannot queue a null event.");
+        CS_ASSERT(Application::Get() == nullptr || Application::Get()->GetTaskScheduler()->IsMainThread(), "Events can only be queued on the main thread.");
+        
+        g_pendingEvents.push_back(in_event);
+        return u32(g_pendingEvents.size() - 1);
+    }
+    
+    //------------------------------------------------------------------------------
+    void EventQueue::Dequeue(IQueuedEvent* in_event, u32 in_index)
+    {
+        //An event queued during a flush lives in the pending list, while one waiting
+        //to be dispatched by the current flush lives in the dispatching list, so the
+        //pointer is used to tell which list the index refers to.
+        if (in_index < g_pendingEvents.size() && g_pendingEvents[in_index] == in_event)
+        {
+            g_pendingEvents[in_index] = nullptr;
+        }
+        else if (g_isDispatching && in_index < g_dispatchingEvents.size() && g_dispatchingEvents[in_index] == in_event)
+        {
+            g_dispatchingEvents[in_index] = nullptr;
+        }
+        else
+        {
+            CS_LOG_FATAL("Cannot dequeue an event which is not in the event queue.");
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    void EventQueue::Dispatch()
+    {
+        CS_ASSERT(!g_isDispatching, "The event queue cannot be flushed recursively.");
+        
+        //Swap the lists rather than copying so both keep their capacity between frames.
+        std::swap(g_pendingEvents, g_dispatchingEvents);
+        g_isDispatching = true;
+        
+        for (std::size_t i = 0; i < g_dispatchingEvents.size(); ++i)
+        {
+            //Dispatching can destroy events later in the list, which clears their slot.
+            if (g_dispatchingEvents[i] != nullptr)
+            {
+                g_dispatchingEvents[i]->DispatchQueued();
+            }
+        }
+        
+        g_dispatchingEvents.clear();
+        g_isDispatching = false;
+    }
+}
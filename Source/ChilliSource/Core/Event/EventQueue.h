@@ -0,0 +1,85 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#ifndef _CHILLISOURCE_CORE_EVENT_EVENTQUEUE_H_
+#define _CHILLISOURCE_CORE_EVENT_EVENTQUEUE_H_
+
+#include <ChilliSource/ChilliSource.h>
+
+#include <limits>
+
+namespace ChilliSource
+{
+    //-----------------------------------------------------------------
+    /// The queue of pending QueuedEvent notifications. The queue is
+    /// flushed once per frame by the Application, after systems and
+    /// states have been updated and before the render snapshot is
+    /// taken, so each queued event notifies its connections at most
+    /// once per frame regardless of how many times it fired.
+    ///
+    /// Events which are queued while the queue is being flushed are
+    /// dispatched during the next flush.
+    ///
+    /// The queue is not thread-safe and should only be used from the
+    /// main thread.
+    //-----------------------------------------------------------------
+    class EventQueue final
+    {
+    public:
+        //-------------------------------------------------------------
+        /// The index used by events which are not currently queued.
+        //-------------------------------------------------------------
+        static constexpr u32 k_notQueued = std::numeric_limits<u32>::max();
+        //-------------------------------------------------------------
+        /// Adds the given event to the queue. The event must not
+        /// already be queued.
+        ///
+        /// @param The event to queue.
+        ///
+        /// @return The index of the event in the queue. This must be
+        /// passed to Dequeue() if the event is destroyed before it is
+        /// dispatched.
+        //-------------------------------------------------------------
+        static u32 Enqueue(IQueuedEvent* in_event);
+        //-------------------------------------------------------------
+        /// Removes the given event from the queue without dispatching
+        /// it. The slot is cleared rather than erased, so this is
+        /// constant time.
+        ///
+        /// @param The event to remove.
+        /// @param The index returned by Enqueue().
+        //-------------------------------------------------------------
+        static void Dequeue(IQueuedEvent* in_event, u32 in_index);
+        
+    private:
+        friend class Application; //Only application can flush the queue
+        //-------------------------------------------------------------
+        /// Dispatches all events which were queued prior to the call.
+        //-------------------------------------------------------------
+        static void Dispatch();
+    };
+}
+
+#endif
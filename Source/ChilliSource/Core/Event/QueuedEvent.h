@@ -0,0 +1,192 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#ifndef _CHILLISOURCE_CORE_EVENT_QUEUEDEVENT_H_
+#define _CHILLISOURCE_CORE_EVENT_QUEUEDEVENT_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Event/Event.h>
+#include <ChilliSource/Core/Event/EventQueue.h>
+#include <ChilliSource/Core/Event/IConnectableEvent.h>
+#include <ChilliSource/Core/Event/IQueuedEvent.h>
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ChilliSource
+{
+    //-----------------------------------------------------------------
+    /// A QueuedEvent is an event whose notifications are deferred to
+    /// the EventQueue and dispatched in bulk once per frame, rather
+    /// than invoking every connection each time the event fires.
+    /// Repeated notifications within a frame are collapsed into a
+    /// single notification which is passed the arguments of the most
+    /// recent one.
+    ///
+    /// This suits high frequency "something changed" style events
+    /// where listeners only need to react once per frame. Listeners
+    /// which must observe every change as it happens should use an
+    /// Event instead.
+    ///
+    /// The delegate type must have a void return type; any delegate
+    /// template taking a function signature can be used, such as
+    /// std::function or InlineDelegate. Arguments are stored by value
+    /// until the event is dispatched.
+    ///
+    /// Notifications are ignored while the event has no connections,
+    /// so an unobserved QueuedEvent costs very little to fire.
+    //-----------------------------------------------------------------
+    template <typename TDelegateType> class QueuedEvent;
+    
+    template <template <typename> class TDelegate, typename... TArgTypes> class QueuedEvent<TDelegate<void(TArgTypes...)>> final : public IConnectableEvent<TDelegate<void(TArgTypes...)>>, private IQueuedEvent
+    {
+    public:
+        using DelegateType = TDelegate<void(TArgTypes...)>;
+        
+        //-------------------------------------------------------------
+        /// Constructor
+        //-------------------------------------------------------------
+        QueuedEvent() = default;
+        //-------------------------------------------------------------
+        /// Queued events refer to themselves from the event queue so
+        /// cannot be copied or moved. Hold a pointer to share them.
+        //-------------------------------------------------------------
+        QueuedEvent(const QueuedEvent&) = delete;
+        QueuedEvent& operator= (const QueuedEvent&) = delete;
+        QueuedEvent(QueuedEvent&&) = delete;
+        QueuedEvent& operator= (QueuedEvent&&) = delete;
+        //-------------------------------------------------------------
+        /// Opens a new connection to the event. While this connection
+        /// remains in scope the delegate will be notified of events
+        ///
+        /// @param Delegate to notify
+        ///
+        /// @return Scoped connection
+        //-------------------------------------------------------------
+        EventConnectionUPtr OpenConnection(const DelegateType& in_delegate) override
+        {
+            return m_event.OpenConnection(in_delegate);
+        }
+        //-------------------------------------------------------------
+        /// Queues a notification of the event. If a notification is
+        /// already queued its arguments are replaced with the given
+        /// ones, otherwise the event is added to the EventQueue.
+        ///
+        /// @param Arguments to pass to the connection delegates when
+        /// the event is dispatched
+        //-------------------------------------------------------------
+        template <typename... TQueuedArgTypes> void QueueNotification(TQueuedArgTypes&&... in_args)
+        {
+            if (m_event.HasConnections() == false)
+            {
+                return;
+            }
+            
+            m_queuedArgs = ArgsTuple(std::forward<TQueuedArgTypes>(in_args)...);
+            
+            if (m_queueIndex == EventQueue::k_notQueued)
+            {
+                m_queueIndex = EventQueue::Enqueue(this);
+            }
+        }
+        //-------------------------------------------------------------
+        /// @return Whether or not a notification is currently queued.
+        //-------------------------------------------------------------
+        bool IsNotificationQueued() const
+        {
+            return m_queueIndex != EventQueue::k_notQueued;
+        }
+        //-------------------------------------------------------------
+        /// Discards any queued notification without notifying the
+        /// connections.
+        //-------------------------------------------------------------
+        void CancelNotification()
+        {
+            if (m_queueIndex != EventQueue::k_notQueued)
+            {
+                EventQueue::Dequeue(this, m_queueIndex);
+                m_queueIndex = EventQueue::k_notQueued;
+            }
+        }
+        //-------------------------------------------------------------
+        /// Closes all the currently open connections and discards any
+        /// queued notification.
+        //-------------------------------------------------------------
+        void CloseAllConnections()
+        {
+            CancelNotification();
+            m_event.CloseAllConnections();
+        }
+        //-------------------------------------------------------------
+        /// Destructor. Closes all open connections and removes the
+        /// event from the queue.
+        //-------------------------------------------------------------
+        ~QueuedEvent()
+        {
+            CloseAllConnections();
+        }
+        
+    private:
+        using ArgsTuple = std::tuple<typename std::decay<TArgTypes>::type...>;
+        
+        //-------------------------------------------------------------
+        /// Notifies the connections with the most recently queued
+        /// arguments.
+        //-------------------------------------------------------------
+        void DispatchQueued() override
+        {
+            m_queueIndex = EventQueue::k_notQueued;
+            
+            //Copy the arguments so the event can be queued again from within a
+            //connection without changing the arguments of this notification.
+            ArgsTuple args(m_queuedArgs);
+            Notify(args, typename MakeIndices<sizeof...(TArgTypes)>::Type());
+        }
+        //-------------------------------------------------------------
+        /// Compile time sequence of indices used to unpack the stored
+        /// argument tuple.
+        //-------------------------------------------------------------
+        template <std::size_t... TIndices> struct Indices {};
+        template <std::size_t TCount, std::size_t... TIndices> struct MakeIndices : MakeIndices<TCount - 1, TCount - 1, TIndices...> {};
+        template <std::size_t... TIndices> struct MakeIndices<0, TIndices...> { using Type = Indices<TIndices...>; };
+        //-------------------------------------------------------------
+        /// Notifies the connections with the given arguments.
+        ///
+        /// @param The arguments
+        /// @param The indices of the arguments within the tuple
+        //-------------------------------------------------------------
+        template <std::size_t... TIndices> void Notify(ArgsTuple& in_args, Indices<TIndices...>)
+        {
+            m_event.NotifyConnections(std::get<TIndices>(in_args)...);
+        }
+        
+        Event<DelegateType> m_event;
+        ArgsTuple m_queuedArgs;
+        u32 m_queueIndex = EventQueue::k_notQueued;
+    };
+}
+
+#endif
@@ -34,6 +34,7 @@
 #include <ChilliSource/Core/File/CSBinaryChunk.h>
 #include <ChilliSource/Core/File/CSBinaryInputStream.h>
 #include <ChilliSource/Core/File/FileSystem.h>
+#include <ChilliSource/Core/File/PackedArchive.h>
 #include <ChilliSource/Core/File/StorageLocation.h>
 #include <ChilliSource/Core/File/TaggedFilePathResolver.h>
 #include <ChilliSource/Core/File/FileStream/BinaryInputStream.h>
@@ -43,5 +44,7 @@
 #include <ChilliSource/Core/File/FileStream/ITextInputStream.h>
 #include <ChilliSource/Core/File/FileStream/TextInputStream.h>
 #include <ChilliSource/Core/File/FileStream/TextOutputStream.h>
+#include <ChilliSource/Core/File/FileStream/VirtualBinaryInputStream.h>
+#include <ChilliSource/Core/File/FileStream/VirtualTextInputStream.h>
 
 #endif
\ No newline at end of file
@@ -29,19 +29,370 @@
 #include <ChilliSource/Core/File/AppDataStore.h>
 
 #include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Container/ParamDictionary.h>
 #include <ChilliSource/Core/Container/ParamDictionarySerialiser.h>
 #include <ChilliSource/Core/Cryptographic/AESEncrypt.h>
-#include <ChilliSource/Core/Cryptographic/HashSHA1.h>
-#include <ChilliSource/Core/Delegate/MakeDelegate.h>
+#include <ChilliSource/Core/Cryptographic/HashCRC32.h>
+#include <ChilliSource/Core/File/FileSystem.h>
 #include <ChilliSource/Core/String/StringParser.h>
+#include <ChilliSource/Core/Threading/TaskScheduler.h>
 #include <ChilliSource/Core/XML/XMLUtils.h>
 
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#ifdef CS_TARGETPLATFORM_WINDOWS
+#include <CSBackend/Platform/Windows/Core/String/WindowsStringUtils.h>
+
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace ChilliSource
 {
     namespace
     {
-        const std::string k_filename = "App.ads";
+        const std::string k_legacyFilename = "App.ads";
+        const std::string k_snapshotFilename = "App.adb";
+        const std::string k_tempSnapshotFilename = "App.adb.tmp";
+        const std::string k_journalFilename = "App.adj";
         const std::string k_privateKey = "aV0r71^jX01}pXMk";
+        
+        const u32 k_snapshotId = 0x42444143; //"CADB"
+        const u32 k_journalId = 0x4a444143; //"CADJ"
+        const u32 k_formatVersion = 1;
+        const u32 k_frameHeaderSize = 5 * sizeof(u32);
+        
+        /// The journal is compacted into a new snapshot once it grows larger than the
+        /// snapshot, or this size, whichever is larger.
+        const u32 k_minCompactionSize = 16 * 1024;
+        
+        /// The types of record which can be stored in a snapshot or journal frame.
+        ///
+        enum class RecordType : u8
+        {
+            k_set,
+            k_erase,
+            k_clear
+        };
+        
+        /// Reads primitives from a block of encoded records, failing rather than reading
+        /// past the end of the data.
+        ///
+        class RecordReader final
+        {
+        public:
+            RecordReader(const u8* in_data, u32 in_size)
+                : m_data(in_data), m_remaining(in_size)
+            {
+            }
+            
+            template <typename TType> bool Read(TType& out_value)
+            {
+                if (m_remaining < sizeof(TType))
+                {
+                    return false;
+                }
+                
+                memcpy(&out_value, m_data, sizeof(TType));
+                m_data += sizeof(TType);
+                m_remaining -= sizeof(TType);
+                return true;
+            }
+            
+            bool ReadString(std::string& out_value)
+            {
+                u32 length = 0;
+                if (!Read(length) || length > m_remaining)
+                {
+                    return false;
+                }
+                
+                out_value.assign(reinterpret_cast<const s8*>(m_data), length);
+                m_data += length;
+                m_remaining -= length;
+                return true;
+            }
+            
+            bool IsEmpty() const
+            {
+                return (m_remaining == 0);
+            }
+            
+        private:
+            const u8* m_data;
+            u32 m_remaining;
+        };
+        
+        /// Appends the bytes of the given primitive to the output data.
+        ///
+        /// @param in_value
+        ///     The value to write.
+        /// @param out_data
+        ///     The data to append to.
+        ///
+        template <typename TType> void WritePrimitive(TType in_value, std::vector<u8>& out_data)
+        {
+            const u8* bytes = reinterpret_cast<const u8*>(&in_value);
+            out_data.insert(out_data.end(), bytes, bytes + sizeof(TType));
+        }
+        
+        /// Appends the given string, prefixed by its length, to the output data.
+        ///
+        /// @param in_value
+        ///     The value to write.
+        /// @param out_data
+        ///     The data to append to.
+        ///
+        void WriteString(const std::string& in_value, std::vector<u8>& out_data)
+        {
+            WritePrimitive(u32(in_value.size()), out_data);
+            out_data.insert(out_data.end(), in_value.begin(), in_value.end());
+        }
+        
+        /// Parses the given string as the given numeric type. This is used for values
+        /// which were stored as strings by older versions of the data store.
+        ///
+        /// @param in_string
+        ///     The string to parse.
+        ///
+        /// @return The parsed value.
+        ///
+        template <typename TType> TType ParseNumeric(const std::string& in_string)
+        {
+            if (std::is_floating_point<TType>::value)
+            {
+                return static_cast<TType>(ParseF32(in_string));
+            }
+            else if (std::is_signed<TType>::value)
+            {
+                return static_cast<TType>(ParseS64(in_string));
+            }
+            
+            return static_cast<TType>(ParseU64(in_string));
+        }
+        
+        /// Builds an encrypted frame from the given records. The records are prefixed
+        /// with a header describing the frame and its checksum, then padded to the AES
+        /// block size and encrypted.
+        ///
+        /// @param in_id
+        ///     The id of the type of file the frame is for.
+        /// @param in_generation
+        ///     The snapshot generation the records belong to.
+        /// @param in_records
+        ///     The records.
+        ///
+        /// @return The encrypted frame.
+        ///
+        AESEncrypt::Data EncryptFrame(u32 in_id, u32 in_generation, const std::vector<u8>& in_records)
+        {
+            std::vector<u8> data;
+            data.reserve(AESEncrypt::CalculateAlignedSize(k_frameHeaderSize + u32(in_records.size())));
+            
+            WritePrimitive(in_id, data);
+            WritePrimitive(k_formatVersion, data);
+            WritePrimitive(in_generation, data);
+            WritePrimitive(HashCRC32::GenerateHashCode(reinterpret_cast<const s8*>(in_records.data()), u32(in_records.size())), data);
+            WritePrimitive(u32(in_records.size()), data);
+            data.insert(data.end(), in_records.begin(), in_records.end());
+            data.resize(AESEncrypt::CalculateAlignedSize(u32(data.size())), 0);
+            
+            return AESEncrypt::EncryptBinary(data.data(), u32(data.size()), k_privateKey);
+        }
+        
+        /// Decrypts and validates a frame built with EncryptFrame().
+        ///
+        /// @param in_id
+        ///     The expected id of the frame.
+        /// @param in_data
+        ///     The encrypted frame.
+        /// @param in_size
+        ///     The size of the encrypted frame.
+        /// @param out_generation
+        ///     (Out) The snapshot generation the records belong to.
+        /// @param out_records
+        ///     (Out) The records.
+        ///
+        /// @return Whether or not the frame was valid.
+        ///
+        bool DecryptFrame(u32 in_id, const u8* in_data, u32 in_size, u32& out_generation, std::vector<u8>& out_records)
+        {
+            if (in_size < k_frameHeaderSize || AESEncrypt::CalculateAlignedSize(in_size) != in_size)
+            {
+                return false;
+            }
+            
+            auto decrypted = AESEncrypt::DecryptBinary(in_data, in_size, k_privateKey);
+            
+            RecordReader reader(decrypted.m_data.get(), decrypted.m_size);
+            u32 id = 0, version = 0, checksum = 0, recordsSize = 0;
+            reader.Read(id);
+            reader.Read(version);
+            reader.Read(out_generation);
+            reader.Read(checksum);
+            reader.Read(recordsSize);
+            
+            if (id != in_id || version != k_formatVersion || recordsSize > decrypted.m_size - k_frameHeaderSize)
+            {
+                return false;
+            }
+            
+            const u8* records = decrypted.m_data.get() + k_frameHeaderSize;
+            if (HashCRC32::GenerateHashCode(reinterpret_cast<const s8*>(records), recordsSize) != checksum)
+            {
+                return false;
+            }
+            
+            out_records.assign(records, records + recordsSize);
+            return true;
+        }
+        
+        /// Reads the entire contents of the given save data file.
+        ///
+        /// @param in_fileSystem
+        ///     The file system.
+        /// @param in_filePath
+        ///     The file path.
+        /// @param out_size
+        ///     (Out) The size of the file.
+        ///
+        /// @return The contents of the file, or null if it could not be read.
+        ///
+        std::unique_ptr<u8[]> ReadSaveDataFile(FileSystem* in_fileSystem, const std::string& in_filePath, u32& out_size)
+        {
+            if (!in_fileSystem->DoesFileExist(StorageLocation::k_saveData, in_filePath))
+            {
+                return nullptr;
+            }
+            
+            auto fileStream = in_fileSystem->CreateBinaryInputStream(StorageLocation::k_saveData, in_filePath);
+            if (fileStream == nullptr)
+            {
+                return nullptr;
+            }
+            
+            out_size = u32(fileStream->GetLength());
+            std::unique_ptr<u8[]> data(new u8[out_size]);
+            fileStream->Read(data.get(), out_size);
+            
+            return data;
+        }
+        
+        /// Appends the given records to the journal as a single frame.
+        ///
+        /// @param in_generation
+        ///     The snapshot generation the records belong to.
+        /// @param in_records
+        ///     The records.
+        ///
+        /// @return Whether or not the frame was successfully written.
+        ///
+        bool WriteJournalFrame(u32 in_generation, const std::vector<u8>& in_records)
+        {
+            auto frame = EncryptFrame(k_journalId, in_generation, in_records);
+            
+            FileSystem* fileSystem = Application::Get()->GetFileSystem();
+            auto fileStream = fileSystem->CreateBinaryOutputStream(StorageLocation::k_saveData, k_journalFilename, FileWriteMode::k_append);
+            if (fileStream == nullptr)
+            {
+                CS_LOG_ERROR("App Data Store: Failed to open journal for writing.");
+                return false;
+            }
+            
+            fileStream->Write(frame.m_size);
+            fileStream->Write(frame.m_data.get(), frame.m_size);
+            return true;
+        }
+        
+        /// Blocks until the contents of the given file have been written to
+        /// the storage device.
+        ///
+        /// @param in_absFilePath
+        ///     The absolute path to the file.
+        ///
+        /// @return Whether or not the file was successfully synced.
+        ///
+        bool SyncFile(const std::string& in_absFilePath)
+        {
+#ifdef CS_TARGETPLATFORM_WINDOWS
+            s32 fileDescriptor = _wopen(CSBackend::Windows::WindowsStringUtils::UTF8ToUTF16(in_absFilePath).c_str(), _O_RDWR | _O_BINARY);
+            if (fileDescriptor == -1)
+            {
+                return false;
+            }
+            
+            bool success = (_commit(fileDescriptor) == 0);
+            _close(fileDescriptor);
+            return success;
+#else
+            s32 fileDescriptor = open(in_absFilePath.c_str(), O_RDWR);
+            if (fileDescriptor == -1)
+            {
+                return false;
+            }
+            
+            bool success = (fsync(fileDescriptor) == 0);
+            close(fileDescriptor);
+            return success;
+#endif
+        }
+        
+        /// Writes a new snapshot containing the given records. The snapshot is first
+        /// written to a temporary file which then atomically replaces the previous
+        /// snapshot, after which the journal and any legacy data are deleted.
+        ///
+        /// @param in_generation
+        ///     The generation of the new snapshot.
+        /// @param in_records
+        ///     The records.
+        ///
+        /// @return Whether or not the snapshot was successfully written.
+        ///
+        bool WriteSnapshot(u32 in_generation, const std::vector<u8>& in_records)
+        {
+            auto frame = EncryptFrame(k_snapshotId, in_generation, in_records);
+            
+            FileSystem* fileSystem = Application::Get()->GetFileSystem();
+            auto fileStream = fileSystem->CreateBinaryOutputStream(StorageLocation::k_saveData, k_tempSnapshotFilename);
+            if (fileStream == nullptr)
+            {
+                CS_LOG_ERROR("App Data Store: Failed to open snapshot for writing.");
+                return false;
+            }
+            
+            fileStream->Write(frame.m_data.get(), frame.m_size);
+            fileStream.reset();
+            
+            //the snapshot must be on disk before it replaces the previous one, otherwise a power loss could leave neither.
+            if (!SyncFile(fileSystem->GetAbsolutePathToStorageLocation(StorageLocation::k_saveData) + k_tempSnapshotFilename))
+            {
+                CS_LOG_ERROR("App Data Store: Failed to sync snapshot to disk.");
+                return false;
+            }
+            
+            if (!fileSystem->RenameFile(StorageLocation::k_saveData, k_tempSnapshotFilename, k_snapshotFilename))
+            {
+                CS_LOG_ERROR("App Data Store: Failed to replace snapshot.");
+                return false;
+            }
+            
+            if (fileSystem->DoesFileExist(StorageLocation::k_saveData, k_journalFilename))
+            {
+                fileSystem->DeleteFile(StorageLocation::k_saveData, k_journalFilename);
+            }
+            
+            if (fileSystem->DoesFileExist(StorageLocation::k_saveData, k_legacyFilename))
+            {
+                fileSystem->DeleteFile(StorageLocation::k_saveData, k_legacyFilename);
+            }
+            
+            return true;
+        }
     }
     
     CS_DEFINE_NAMEDTYPE(AppDataStore);
@@ -54,7 +405,6 @@ namespace ChilliSource
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     AppDataStore::AppDataStore()
-    : m_needsSynchonised(false)
     {
         RefreshFromFile();
     }
@@ -69,14 +419,40 @@ namespace ChilliSource
     bool AppDataStore::Contains(const std::string& in_key)
     {
         std::unique_lock<std::mutex> lock(m_mutex);
-        return m_dictionary.HasKey(in_key);
+        return (m_values.find(in_key) != m_values.end());
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     bool AppDataStore::TryGetValue(const std::string& in_key, std::string& out_value) const
     {
         std::unique_lock<std::mutex> lock(m_mutex);
-        return m_dictionary.TryGetValue(in_key, out_value);
+        
+        auto it = m_values.find(in_key);
+        if (it == m_values.end())
+        {
+            return false;
+        }
+        
+        const Value& value = it->second;
+        switch (value.m_type)
+        {
+            case ValueType::k_string:
+                out_value = value.m_string;
+                break;
+            case ValueType::k_bool:
+                out_value = ToString(value.m_bool);
+                break;
+            case ValueType::k_unsigned:
+                out_value = ToString(value.m_unsigned);
+                break;
+            case ValueType::k_signed:
+                out_value = ToString(value.m_signed);
+                break;
+            case ValueType::k_float:
+                out_value = ToString(value.m_float);
+                break;
+        }
+        return true;
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
@@ -84,120 +460,83 @@ namespace ChilliSource
     {
         std::unique_lock<std::mutex> lock(m_mutex);
         
-        std::string strTempValue;
-        bool bSuccess = m_dictionary.TryGetValue(in_key, strTempValue);
-        if(bSuccess)
+        auto it = m_values.find(in_key);
+        if (it == m_values.end())
+        {
+            return false;
+        }
+        
+        const Value& value = it->second;
+        switch (value.m_type)
         {
-            out_value = ParseBool(strTempValue);
+            case ValueType::k_string:
+                out_value = ParseBool(value.m_string);
+                break;
+            case ValueType::k_bool:
+                out_value = value.m_bool;
+                break;
+            case ValueType::k_unsigned:
+                out_value = (value.m_unsigned != 0);
+                break;
+            case ValueType::k_signed:
+                out_value = (value.m_signed != 0);
+                break;
+            case ValueType::k_float:
+                out_value = (value.m_float != 0.0f);
+                break;
         }
-        return bSuccess;
+        return true;
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     bool AppDataStore::TryGetValue(const std::string& in_key, u16& out_value) const
     {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        
-        std::string strTempValue;
-        bool bSuccess = m_dictionary.TryGetValue(in_key, strTempValue);
-        if(bSuccess)
-        {
-            out_value = static_cast<u16>(ParseU32(strTempValue));
-        }
-        return bSuccess;			
+        return TryGetNumericValue(in_key, out_value);
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     bool AppDataStore::TryGetValue(const std::string& in_key, s16& out_value) const
     {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        
-        std::string strTempValue;
-        bool bSuccess = m_dictionary.TryGetValue(in_key, strTempValue);
-        if(bSuccess)
-        {
-            out_value = static_cast<s16>(ParseS32(strTempValue));
-        }
-        return bSuccess;
+        return TryGetNumericValue(in_key, out_value);
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     bool AppDataStore::TryGetValue(const std::string& in_key, u32& out_value) const
     {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        
-        std::string strTempValue;
-        bool bSuccess = m_dictionary.TryGetValue(in_key, strTempValue);
-        if(bSuccess)
-        {
-            out_value = static_cast<u32>(ParseU32(strTempValue));
-        }
-        return bSuccess;			
+        return TryGetNumericValue(in_key, out_value);
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     bool AppDataStore::TryGetValue(const std::string& in_key, s32& out_value) const
     {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        
-        std::string strTempValue;
-        bool bSuccess = m_dictionary.TryGetValue(in_key, strTempValue);
-        if(bSuccess)
-        {
-            out_value = static_cast<s32>(ParseS32(strTempValue));
-        }
-        return bSuccess;			
+        return TryGetNumericValue(in_key, out_value);
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     bool AppDataStore::TryGetValue(const std::string& in_key, u64& out_value) const
     {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        
-        std::string strTempValue;
-        bool bSuccess = m_dictionary.TryGetValue(in_key, strTempValue);
-        if(bSuccess)
-        {
-            out_value = static_cast<u64>(ParseU64(strTempValue));
-        }
-        return bSuccess;			
+        return TryGetNumericValue(in_key, out_value);
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     bool AppDataStore::TryGetValue(const std::string& in_key, s64& out_value) const
     {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        
-        std::string strTempValue;
-        bool bSuccess = m_dictionary.TryGetValue(in_key, strTempValue);
-        if(bSuccess)
-        {
-            out_value = static_cast<s64>(ParseS64(strTempValue));
-        }
-        return bSuccess;			
+        return TryGetNumericValue(in_key, out_value);
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     bool AppDataStore::TryGetValue(const std::string& in_key, f32& out_value) const
     {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        
-        std::string strTempValue;
-        bool bSuccess = m_dictionary.TryGetValue(in_key, strTempValue);
-        if(bSuccess)
-        {
-            out_value = ParseF32(strTempValue);
-        }
-        return bSuccess;		
-    }		
+        return TryGetNumericValue(in_key, out_value);
+    }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     void AppDataStore::SetValue(const std::string& in_key, const std::string& in_value)
     {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        
-        m_dictionary[in_key] = in_value;
-        m_needsSynchonised = true;
+        Value value;
+        value.m_type = ValueType::k_string;
+        value.m_string = in_value;
+        StoreValue(in_key, std::move(value));
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
@@ -209,49 +548,61 @@ namespace ChilliSource
     //--------------------------------------------------------------
     void AppDataStore::SetValue(const std::string& in_key, bool in_value)
     {
-        SetValue(in_key, ToString(in_value));
+        Value value;
+        value.m_type = ValueType::k_bool;
+        value.m_bool = in_value;
+        StoreValue(in_key, std::move(value));
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     void AppDataStore::SetValue(const std::string& in_key, u16 in_value)
     {
-        SetValue(in_key, ToString(in_value));
+        SetValue(in_key, u64(in_value));
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     void AppDataStore::SetValue(const std::string& in_key, s16 in_value)
     {
-        SetValue(in_key, ToString(in_value));
+        SetValue(in_key, s64(in_value));
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     void AppDataStore::SetValue(const std::string& in_key, u32 in_value)
     {
-        SetValue(in_key, ToString(in_value));
+        SetValue(in_key, u64(in_value));
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     void AppDataStore::SetValue(const std::string& in_key, s32 in_value)
     {
-        SetValue(in_key, ToString(in_value));
+        SetValue(in_key, s64(in_value));
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     void AppDataStore::SetValue(const std::string& in_key, u64 in_value)
     {
-        SetValue(in_key, ToString(in_value));
+        Value value;
+        value.m_type = ValueType::k_unsigned;
+        value.m_unsigned = in_value;
+        StoreValue(in_key, std::move(value));
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     void AppDataStore::SetValue(const std::string& in_key, s64 in_value)
     {
-        SetValue(in_key, ToString(in_value));
+        Value value;
+        value.m_type = ValueType::k_signed;
+        value.m_signed = in_value;
+        StoreValue(in_key, std::move(value));
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
-    void AppDataStore::SetValue(const std::string& in_key, f32 infValue)
+    void AppDataStore::SetValue(const std::string& in_key, f32 in_value)
     {
-        SetValue(in_key, ToString(infValue));
+        Value value;
+        value.m_type = ValueType::k_float;
+        value.m_float = in_value;
+        StoreValue(in_key, std::move(value));
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
@@ -259,14 +610,17 @@ namespace ChilliSource
     {
         std::unique_lock<std::mutex> lock(m_mutex);
         
-        ParamDictionary::iterator pEntry = m_dictionary.find(in_key);
-        if(m_dictionary.end() != pEntry)
+        auto it = m_values.find(in_key);
+        if (it == m_values.end())
         {
-            m_dictionary.erase(pEntry);
-            return true;
+            return false;
         }
         
-        return false;
+        m_values.erase(it);
+        
+        WritePrimitive(RecordType::k_erase, m_pendingRecords);
+        WriteString(in_key, m_pendingRecords);
+        return true;
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
@@ -274,8 +628,13 @@ namespace ChilliSource
     {
         std::unique_lock<std::mutex> lock(m_mutex);
         
-        m_dictionary.clear();
-        m_needsSynchonised = true;
+        m_values.clear();
+        m_pendingRecords.clear();
+        
+        //the clear is recorded in case the snapshot which replaces the previous one fails to be written.
+        WritePrimitive(RecordType::k_clear, m_pendingRecords);
+        WriteString("", m_pendingRecords);
+        m_isCompactionRequired = true;
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
@@ -283,64 +642,372 @@ namespace ChilliSource
     {
         std::unique_lock<std::mutex> lock(m_mutex);
         
-        if(m_needsSynchonised == true)
+        if (m_pendingRecords.empty() && !m_isCompactionRequired)
         {
-            // Convert to XML
-            XML::Document doc;
-            XML::Node* rootNode = doc.allocate_node(rapidxml::node_type::node_element);
-            doc.append_node(rootNode);
-            ParamDictionarySerialiser::ToXml(m_dictionary, rootNode);
+            return;
+        }
+        
+        FlushJob job;
+        job.m_records = std::move(m_pendingRecords);
+        m_pendingRecords.clear();
+        
+        if (m_isCompactionRequired || m_journalSize + u32(job.m_records.size()) > std::max(k_minCompactionSize, m_snapshotSize))
+        {
+            job.m_isSnapshot = true;
+            job.m_snapshot = SerialiseSnapshot();
             
-            // Encrypt
-            std::string strDocToBeEncrypted = XMLUtils::ToString(&doc);
-            AESEncrypt::Data encryptedData = AESEncrypt::EncryptString(strDocToBeEncrypted, k_privateKey);
-
-            // Write to disk
-            FileSystem* pFileSystem = Application::Get()->GetFileSystem();
-            auto fileStream = pFileSystem->CreateBinaryOutputStream(StorageLocation::k_saveData, k_filename);
-            if(fileStream != nullptr)
+            m_snapshotSize = u32(job.m_snapshot.size());
+            m_journalSize = 0;
+            m_isCompactionRequired = false;
+        }
+        else
+        {
+            job.m_isSnapshot = false;
+            m_journalSize += u32(job.m_records.size());
+        }
+        
+        //the job is queued while the data lock is held so that jobs are queued in the order they were created.
+        std::unique_lock<std::mutex> flushLock(m_flushMutex);
+        m_flushJobs.push_back(std::move(job));
+        
+        //once the task scheduler has been destroyed, for example when saving from a state or system OnDestroy, the
+        //jobs are written inline. Any task scheduled before then may have been dropped, so this doesn't wait on it.
+        if (Application::Get()->GetTaskScheduler()->IsDestroyed())
+        {
+            m_isFlushScheduled = true;
+            flushLock.unlock();
+            lock.unlock();
+            
+            ProcessFlushJobs();
+        }
+        else if (!m_isFlushScheduled)
+        {
+            m_isFlushScheduled = true;
+            flushLock.unlock();
+            lock.unlock();
+            
+            Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_file, [=](const TaskContext&)
+            {
+                ProcessFlushJobs();
+            });
+        }
+    }
+    //--------------------------------------------------------------
+    //--------------------------------------------------------------
+    template <typename TType> bool AppDataStore::TryGetNumericValue(const std::string& in_key, TType& out_value) const
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        auto it = m_values.find(in_key);
+        if (it == m_values.end())
+        {
+            return false;
+        }
+        
+        const Value& value = it->second;
+        switch (value.m_type)
+        {
+            case ValueType::k_string:
+                out_value = ParseNumeric<TType>(value.m_string);
+                break;
+            case ValueType::k_bool:
+                out_value = static_cast<TType>(value.m_bool ? 1 : 0);
+                break;
+            case ValueType::k_unsigned:
+                out_value = static_cast<TType>(value.m_unsigned);
+                break;
+            case ValueType::k_signed:
+                out_value = static_cast<TType>(value.m_signed);
+                break;
+            case ValueType::k_float:
+                out_value = static_cast<TType>(value.m_float);
+                break;
+        }
+        return true;
+    }
+    //--------------------------------------------------------------
+    //--------------------------------------------------------------
+    void AppDataStore::StoreValue(const std::string& in_key, Value in_value)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        WriteValueRecord(in_key, in_value, m_pendingRecords);
+        m_values[in_key] = std::move(in_value);
+    }
+    //--------------------------------------------------------------
+    //--------------------------------------------------------------
+    void AppDataStore::WriteValueRecord(const std::string& in_key, const Value& in_value, std::vector<u8>& out_records)
+    {
+        WritePrimitive(RecordType::k_set, out_records);
+        WriteString(in_key, out_records);
+        WritePrimitive(in_value.m_type, out_records);
+        
+        switch (in_value.m_type)
+        {
+            case ValueType::k_string:
+                WriteString(in_value.m_string, out_records);
+                break;
+            case ValueType::k_bool:
+                WritePrimitive(u8(in_value.m_bool ? 1 : 0), out_records);
+                break;
+            case ValueType::k_unsigned:
+                WritePrimitive(in_value.m_unsigned, out_records);
+                break;
+            case ValueType::k_signed:
+                WritePrimitive(in_value.m_signed, out_records);
+                break;
+            case ValueType::k_float:
+                WritePrimitive(in_value.m_float, out_records);
+                break;
+        }
+    }
+    //--------------------------------------------------------------
+    //--------------------------------------------------------------
+    bool AppDataStore::ApplyRecords(const u8* in_data, u32 in_size)
+    {
+        RecordReader reader(in_data, in_size);
+        while (!reader.IsEmpty())
+        {
+            RecordType recordType;
+            std::string key;
+            if (!reader.Read(recordType) || !reader.ReadString(key))
+            {
+                return false;
+            }
+            
+            if (recordType == RecordType::k_erase)
+            {
+                m_values.erase(key);
+                continue;
+            }
+            
+            if (recordType == RecordType::k_clear)
+            {
+                m_values.clear();
+                continue;
+            }
+            
+            Value value;
+            if (recordType != RecordType::k_set || !reader.Read(value.m_type))
+            {
+                return false;
+            }
+            
+            bool success = false;
+            switch (value.m_type)
+            {
+                case ValueType::k_string:
+                    success = reader.ReadString(value.m_string);
+                    break;
+                case ValueType::k_bool:
+                {
+                    u8 boolValue = 0;
+                    success = reader.Read(boolValue);
+                    value.m_bool = (boolValue != 0);
+                    break;
+                }
+                case ValueType::k_unsigned:
+                    success = reader.Read(value.m_unsigned);
+                    break;
+                case ValueType::k_signed:
+                    success = reader.Read(value.m_signed);
+                    break;
+                case ValueType::k_float:
+                    success = reader.Read(value.m_float);
+                    break;
+            }
+            
+            if (!success)
             {
-                fileStream->Write(reinterpret_cast<const u8*>(encryptedData.m_data.get()), encryptedData.m_size);
-                fileStream.reset();
+                return false;
             }
             
-            m_needsSynchonised = false;
+            m_values[key] = std::move(value);
         }
+        
+        return true;
+    }
+    //--------------------------------------------------------------
+    //--------------------------------------------------------------
+    std::vector<u8> AppDataStore::SerialiseSnapshot() const
+    {
+        std::vector<u8> records;
+        records.reserve(m_snapshotSize);
+        
+        for (const auto& entry : m_values)
+        {
+            WriteValueRecord(entry.first, entry.second, records);
+        }
+        
+        return records;
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     void AppDataStore::RefreshFromFile()
     {
-        FileSystem* pFileSystem = Application::Get()->GetFileSystem();
-        if(pFileSystem->DoesFileExist(StorageLocation::k_saveData, k_filename) == true)
+        FileSystem* fileSystem = Application::Get()->GetFileSystem();
+        
+        u32 snapshotSize = 0;
+        auto snapshot = ReadSaveDataFile(fileSystem, k_snapshotFilename, snapshotSize);
+        if (snapshot != nullptr)
+        {
+            std::vector<u8> records;
+            if (!DecryptFrame(k_snapshotId, snapshot.get(), snapshotSize, m_generation, records) || !ApplyRecords(records.data(), u32(records.size())))
+            {
+                CS_LOG_ERROR("App Data Store: The saved data is corrupt and has been discarded.");
+                
+                m_values.clear();
+                m_isCompactionRequired = true;
+                return;
+            }
+            
+            m_snapshotSize = u32(records.size());
+        }
+        else if (fileSystem->DoesFileExist(StorageLocation::k_saveData, k_legacyFilename))
+        {
+            RefreshFromLegacyFile();
+            m_isCompactionRequired = true;
+        }
+        
+        u32 journalSize = 0;
+        auto journal = ReadSaveDataFile(fileSystem, k_journalFilename, journalSize);
+        if (journal != nullptr)
         {
-            auto fileStream = pFileSystem->CreateBinaryInputStream(StorageLocation::k_saveData, k_filename);
-            if (fileStream != nullptr)
+            u32 offset = 0;
+            while (offset < journalSize)
             {
-                u32 encryptedDataSize = u32(fileStream->GetLength());
+                u32 frameSize = 0;
+                u32 generation = 0;
+                std::vector<u8> records;
                 
-                std::unique_ptr<u8[]> encryptedData(new u8[encryptedDataSize]);
-                fileStream->Read(encryptedData.get(), encryptedDataSize);
-                fileStream.reset();
+                if (journalSize - offset < sizeof(u32))
+                {
+                    m_isCompactionRequired = true;
+                    break;
+                }
                 
-                std::string decrypted = AESEncrypt::DecryptString(reinterpret_cast<const u8*>(encryptedData.get()), encryptedDataSize, k_privateKey);
-
-                XMLUPtr xml = XMLUtils::ParseDocument(decrypted);
-                XML::Node* root = XMLUtils::GetFirstChildElement(xml->GetDocument());
-                if(nullptr != root)
+                memcpy(&frameSize, journal.get() + offset, sizeof(u32));
+                offset += sizeof(u32);
+                
+                //a frame which is truncated or corrupt was most likely interrupted while being written, so it and anything after it is discarded.
+                if (frameSize > journalSize - offset || !DecryptFrame(k_journalId, journal.get() + offset, frameSize, generation, records))
+                {
+                    m_isCompactionRequired = true;
+                    break;
+                }
+                
+                offset += frameSize;
+                
+                //frames from before the last snapshot can remain if the journal failed to be deleted.
+                if (generation != m_generation)
                 {
-                    m_dictionary = ParamDictionarySerialiser::FromXml(root);
+                    m_isCompactionRequired = true;
+                    continue;
                 }
+                
+                if (!ApplyRecords(records.data(), u32(records.size())))
+                {
+                    m_isCompactionRequired = true;
+                    break;
+                }
+                
+                m_journalSize += u32(records.size());
             }
         }
+    }
+    //--------------------------------------------------------------
+    //--------------------------------------------------------------
+    void AppDataStore::RefreshFromLegacyFile()
+    {
+        u32 encryptedDataSize = 0;
+        auto encryptedData = ReadSaveDataFile(Application::Get()->GetFileSystem(), k_legacyFilename, encryptedDataSize);
+        if (encryptedData == nullptr)
+        {
+            return;
+        }
+        
+        std::string decrypted = AESEncrypt::DecryptString(encryptedData.get(), encryptedDataSize, k_privateKey);
         
-        m_needsSynchonised = false;
+        XMLUPtr xml = XMLUtils::ParseDocument(decrypted);
+        XML::Node* root = XMLUtils::GetFirstChildElement(xml->GetDocument());
+        if (root != nullptr)
+        {
+            ParamDictionary dictionary = ParamDictionarySerialiser::FromXml(root);
+            for (const auto& entry : dictionary)
+            {
+                Value value;
+                value.m_type = ValueType::k_string;
+                value.m_string = entry.second;
+                m_values[entry.first] = std::move(value);
+            }
+        }
+    }
+    //--------------------------------------------------------------
+    //--------------------------------------------------------------
+    void AppDataStore::ProcessFlushJobs()
+    {
+        while (true)
+        {
+            std::unique_lock<std::mutex> flushLock(m_flushMutex);
+            if (m_flushJobs.empty())
+            {
+                m_isFlushScheduled = false;
+                flushLock.unlock();
+                
+                m_flushCondition.notify_all();
+                return;
+            }
+            
+            FlushJob job = std::move(m_flushJobs.front());
+            m_flushJobs.pop_front();
+            flushLock.unlock();
+            
+            if (job.m_isSnapshot)
+            {
+                if (WriteSnapshot(m_generation + 1, job.m_snapshot))
+                {
+                    ++m_generation;
+                    continue;
+                }
+            }
+            else if (WriteJournalFrame(m_generation, job.m_records))
+            {
+                continue;
+            }
+            
+            //the records in the failed job would otherwise be lost, so they are written with the next job. A failed journal
+            //write may also have left a torn frame, which would hide any frames after it, so a new snapshot is written too.
+            std::unique_lock<std::mutex> lock(m_mutex);
+            flushLock.lock();
+            
+            std::vector<u8>& nextRecords = m_flushJobs.empty() ? m_pendingRecords : m_flushJobs.front().m_records;
+            nextRecords.insert(nextRecords.begin(), job.m_records.begin(), job.m_records.end());
+            m_isCompactionRequired = true;
+        }
+    }
+    //--------------------------------------------------------------
+    //--------------------------------------------------------------
+    void AppDataStore::WaitForFlush()
+    {
+        std::unique_lock<std::mutex> flushLock(m_flushMutex);
+        m_flushCondition.wait(flushLock, [=]()
+        {
+            return !m_isFlushScheduled;
+        });
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     void AppDataStore::OnSuspend()
     {
         Save();
+        WaitForFlush();
+    }
+    //--------------------------------------------------------------
+    //--------------------------------------------------------------
+    void AppDataStore::OnDestroy()
+    {
+        //the task scheduler has been destroyed at this point, so this writes any changes made since suspend inline.
+        Save();
     }
 }
 
@@ -30,10 +30,13 @@
 #define _CHILLISOURCE_CORE_FILE_LOCALDATASTORE_H_
 
 #include <ChilliSource/ChilliSource.h>
-#include <ChilliSource/Core/Container/ParamDictionary.h>
 #include <ChilliSource/Core/System/AppSystem.h>
 
+#include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace ChilliSource
 {
@@ -49,6 +52,12 @@ namespace ChilliSource
     /// Note that keys beginning with an underscore '_' are reserved for
     /// internal engine use.
     ///
+    /// Values are stored in a typed binary format. Changes are appended
+    /// to a journal when saved, and the journal is periodically compacted
+    /// into a full snapshot which atomically replaces the previous one.
+    /// All encryption and file IO is performed on a background file task
+    /// so saving never stalls the calling thread.
+    ///
     /// The ADS is thread-safe and is initialised prior to the OnInit()
     /// lifecycle event.
     ///
@@ -324,7 +333,11 @@ namespace ChilliSource
         //--------------------------------------------------------------
         void Clear();
         //--------------------------------------------------------------
-        /// Writes the current state of the data store to disk.
+        /// Writes all changes made since the last save to disk. This
+        /// only queues the changes; they are encrypted and written on a
+        /// background file task, so this returns almost immediately.
+        /// After the task scheduler has been destroyed they are written
+        /// before this returns.
         ///
         /// @author R Henning
         //--------------------------------------------------------------
@@ -332,6 +345,48 @@ namespace ChilliSource
     
     private:
         friend class Application;
+        
+        //--------------------------------------------------------------
+        /// The type of a stored value. Numeric values are stored at the
+        /// widest width of their kind so they can be read back as any
+        /// type of the same kind.
+        //--------------------------------------------------------------
+        enum class ValueType : u8
+        {
+            k_string,
+            k_bool,
+            k_unsigned,
+            k_signed,
+            k_float
+        };
+        //--------------------------------------------------------------
+        /// A single typed value.
+        //--------------------------------------------------------------
+        struct Value final
+        {
+            ValueType m_type;
+            union
+            {
+                bool m_bool;
+                u64 m_unsigned;
+                s64 m_signed;
+                f32 m_float;
+            };
+            std::string m_string;
+        };
+        //--------------------------------------------------------------
+        /// A pending write to disk. This is either a frame of records
+        /// to append to the journal, or a full snapshot which replaces
+        /// the previous snapshot and journal. Either way it holds the
+        /// records changed since the previous job, so they can be
+        /// passed on to the next job if this one fails.
+        //--------------------------------------------------------------
+        struct FlushJob final
+        {
+            bool m_isSnapshot;
+            std::vector<u8> m_records;
+            std::vector<u8> m_snapshot;
+        };
         //--------------------------------------------------------------
         /// Factory create method called by application to create a new
         /// instance of the system.
@@ -348,24 +403,107 @@ namespace ChilliSource
         //--------------------------------------------------------------
         AppDataStore();
         //--------------------------------------------------------------
+        /// Attempts to get the value for the given key as the given
+        /// numeric type, converting from the stored type if needed.
+        ///
+        /// @param Key to attempt to retrieve the value for.
+        /// @param [Out] The output value.
+        ///
+        /// @return Whether or not the value was successfully retreived.
+        //--------------------------------------------------------------
+        template <typename TType> bool TryGetNumericValue(const std::string& in_key, TType& out_value) const;
+        //--------------------------------------------------------------
+        /// Sets the value for the given key and records the change in
+        /// the pending journal records.
+        ///
+        /// @param The key.
+        /// @param The value.
+        //--------------------------------------------------------------
+        void StoreValue(const std::string& in_key, Value in_value);
+        //--------------------------------------------------------------
+        /// Encodes a record which sets the given key to the given value.
+        ///
+        /// @param The key.
+        /// @param The value.
+        /// @param [Out] The records the record should be appended to.
+        //--------------------------------------------------------------
+        static void WriteValueRecord(const std::string& in_key, const Value& in_value, std::vector<u8>& out_records);
+        //--------------------------------------------------------------
+        /// Applies the given encoded records to the stored values.
+        ///
+        /// @param The record data.
+        /// @param The size of the record data.
+        ///
+        /// @return Whether or not all records were valid.
+        //--------------------------------------------------------------
+        bool ApplyRecords(const u8* in_data, u32 in_size);
+        //--------------------------------------------------------------
+        /// @return The records describing all stored values. This must
+        /// be called while the mutex is locked.
+        //--------------------------------------------------------------
+        std::vector<u8> SerialiseSnapshot() const;
+        //--------------------------------------------------------------
         /// Loads the saved data from disk into the current data store.
+        /// The snapshot is read first, followed by any journal frames
+        /// written since it. Data saved in the legacy XML format is
+        /// migrated on the next save.
         ///
         /// @author R Henning
         //--------------------------------------------------------------
         void RefreshFromFile();
         //--------------------------------------------------------------
+        /// Loads the data store from the legacy XML format.
+        //--------------------------------------------------------------
+        void RefreshFromLegacyFile();
+        //--------------------------------------------------------------
+        /// Processes all queued flush jobs. This is run as a file task,
+        /// or inline once the task scheduler has been destroyed.
+        ///
+        /// The generation is only advanced once a snapshot has replaced
+        /// the previous one, so journal frames always carry the
+        /// generation of the snapshot on disk. If a job fails its
+        /// records are passed on to the next job, or back to the
+        /// pending records if there is none.
+        //--------------------------------------------------------------
+        void ProcessFlushJobs();
+        //--------------------------------------------------------------
+        /// Blocks until all queued flush jobs have been written to disk.
+        //--------------------------------------------------------------
+        void WaitForFlush();
+        //--------------------------------------------------------------
         /// Called when the application is suspended. This is also called
         /// when the application is exiting just prior to calling On
         /// Destroy. System suspend is called in the reverse order to
         /// which they were created.
         ///
+        /// Pending changes are saved and written to disk before this
+        /// returns.
+        ///
         /// @author Ian Copland
         //--------------------------------------------------------------
         void OnSuspend() override;
+        //--------------------------------------------------------------
+        /// Called when the application is being destroyed. Any changes
+        /// made since suspend, such as those made in a state's
+        /// OnDestroy, are written to disk inline, as the task scheduler
+        /// is no longer available.
+        //--------------------------------------------------------------
+        void OnDestroy() override;
         
         mutable std::mutex m_mutex;
-        bool m_needsSynchonised;
-        ParamDictionary m_dictionary;
+        std::unordered_map<std::string, Value> m_values;
+        std::vector<u8> m_pendingRecords;
+        bool m_isCompactionRequired = false;
+        u32 m_snapshotSize = 0;
+        u32 m_journalSize = 0;
+        
+        std::mutex m_flushMutex;
+        std::condition_variable m_flushCondition;
+        std::deque<FlushJob> m_flushJobs;
+        bool m_isFlushScheduled = false;
+        
+        //the generation of the snapshot on disk. This is only accessed on load and while processing flush jobs.
+        u32 m_generation = 0;
     };
 }
 
@@ -31,6 +31,8 @@
 
 #include <ChilliSource/ChilliSource.h>
 
+#include <cstring>
+
 namespace ChilliSource
 {
     //----------------------------------------------------------------------
@@ -127,8 +129,10 @@ namespace ChilliSource
     //----------------------------------------------------------------
     template <typename TType> TType CSBinaryChunk::Read()
     {
+        //chunk data is packed, so values may not be aligned.
         const u8* data = Read(sizeof(TType));
-        const TType output = *reinterpret_cast<const TType*>(data);
+        TType output;
+        memcpy(&output, data, sizeof(TType));
         return output;
     }
 }
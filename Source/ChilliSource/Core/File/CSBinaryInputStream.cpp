@@ -32,33 +32,48 @@
 #include <ChilliSource/Core/File/CSBinaryChunk.h>
 #include <ChilliSource/Core/File/FileSystem.h>
 
+#include <cstring>
+
 namespace ChilliSource
 {
     namespace
     {
+        const u32 k_headerSize = 20;
+        const u32 k_chunkEntrySize = 12;
+        
+        //--------------------------------------------------------------
+        /// Reads a little endian u32 from the given position in the data.
+        /// The data may not be aligned.
+        ///
+        /// @param The data.
+        /// @param The offset to read from.
+        ///
+        /// @return The value.
+        //--------------------------------------------------------------
+        u32 ReadU32(const u8* in_data, u32 in_offset)
+        {
+            u32 value;
+            memcpy(&value, in_data + in_offset, sizeof(u32));
+            return value;
+        }
         //--------------------------------------------------------------
         /// Reads the Chilli Source "Chunked" binary file header.
         ///
         /// @param Ian Copland
         ///
-        /// @param The file stream.
+        /// @param The file contents.
+        /// @param The file path. This is only used for error messages.
         /// @param [Out] The file format Id.
         /// @param [Out] The file format version.
         /// @param [Out] The number of entries in the chunk table.
         ///
         /// @return Whether reading the header was successful or not.
         //--------------------------------------------------------------
-        bool ReadHeader(IBinaryInputStream* in_fileStream, const std::string& in_filePath, u32& out_fileFormatId, u32& out_fileFormatVersion, u32& out_numChunkTableEntries)
+        bool ReadHeader(const ByteBuffer& in_fileContents, const std::string& in_filePath, u32& out_fileFormatId, u32& out_fileFormatVersion, u32& out_numChunkTableEntries)
         {
-            CS_ASSERT(in_fileStream != nullptr, "File stream cannot be null.");
-            
-            //read the header data
-            const u32 k_headerSize = 20;
-            std::unique_ptr<u8[]> headerData(new u8[k_headerSize]);
-            in_fileStream->Read(headerData.get(), k_headerSize);
-            
             //test file id.
-            if (headerData[0] != 'C' || headerData[1] != 'S' || headerData[2] != 'C' || headerData[3] != 'S')
+            const u8* headerData = in_fileContents.GetData();
+            if (in_fileContents.GetLength() < k_headerSize || headerData[0] != 'C' || headerData[1] != 'S' || headerData[2] != 'C' || headerData[3] != 'S')
             {
                 CS_LOG_ERROR("Invalid Chilli Source file identifier in file: " + in_filePath);
                 return false;
@@ -66,7 +81,7 @@ namespace ChilliSource
             
             //test file endianness.
             const u32 k_endiannessCheckFlagOffset = 4;
-            u32 endiannessCheckFlag = *reinterpret_cast<const u32*>(headerData.get() + k_endiannessCheckFlagOffset);
+            u32 endiannessCheckFlag = ReadU32(headerData, k_endiannessCheckFlagOffset);
             if (endiannessCheckFlag != 9999)
             {
                 CS_LOG_ERROR("File is big endian, only little endian is currently supported: " + in_filePath);
@@ -75,15 +90,15 @@ namespace ChilliSource
             
             //read the file type
             const u32 k_fileFormatIdOffset = 8;
-            out_fileFormatId = *reinterpret_cast<const u32*>(headerData.get() + k_fileFormatIdOffset);
+            out_fileFormatId = ReadU32(headerData, k_fileFormatIdOffset);
             
             //read the file version
             const u32 k_fileFormatVersionOffset = 12;
-            out_fileFormatVersion = *reinterpret_cast<const u32*>(headerData.get() + k_fileFormatVersionOffset);
+            out_fileFormatVersion = ReadU32(headerData, k_fileFormatVersionOffset);
             
             //read the number of chunk table entries
             const u32 k_numChunkTableEntriesOffset = 16;
-            out_numChunkTableEntries = *reinterpret_cast<const u32*>(headerData.get() + k_numChunkTableEntriesOffset);
+            out_numChunkTableEntries = ReadU32(headerData, k_numChunkTableEntriesOffset);
             
             return true;
         }
@@ -96,20 +111,24 @@ namespace ChilliSource
         FileSystem* fileSystem = Application::Get()->GetFileSystem();
         CS_ASSERT(fileSystem != nullptr, "CSBinaryInputStream missing required system: FileSystem.");
         
-        m_fileStream = fileSystem->CreateBinaryInputStream(in_storageLocation, in_filePath);
-        if (m_fileStream != nullptr)
+        auto fileStream = fileSystem->CreateBinaryInputStream(in_storageLocation, in_filePath);
+        if (fileStream == nullptr)
         {
-            u32 numChunkTableEntries;
-            if (ReadHeader(m_fileStream.get(), in_filePath, m_fileFormatId, m_fileFormatVersion, numChunkTableEntries) == false)
-            {
-                m_fileStream.reset();
-                return;
-            }
-            
-            ReadChunkTable(numChunkTableEntries);
-            
-            m_isValid = true;
+            return;
         }
+        
+        //the whole file is read up front so that all chunk reads are served from memory.
+        m_fileContents = fileStream->ReadAll();
+        fileStream.reset();
+        
+        u32 numChunkTableEntries;
+        if (ReadHeader(*m_fileContents, in_filePath, m_fileFormatId, m_fileFormatVersion, numChunkTableEntries) == false || ReadChunkTable(numChunkTableEntries, in_filePath) == false)
+        {
+            m_fileContents.reset();
+            return;
+        }
+        
+        m_isValid = true;
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
@@ -138,11 +157,8 @@ namespace ChilliSource
         auto chunkInfoIt = m_chunkInfoMap.find(in_chunkId);
         if (chunkInfoIt != m_chunkInfoMap.end())
         {
-            m_fileStream->SetReadPosition(chunkInfoIt->second.m_offset);
-            CS_ASSERT(m_fileStream->GetReadPosition() == chunkInfoIt->second.m_offset, "Seek failed.");
-            
             std::unique_ptr<u8[]> chunkData(new u8[chunkInfoIt->second.m_size]);
-            m_fileStream->Read(chunkData.get(), chunkInfoIt->second.m_size);
+            memcpy(chunkData.get(), m_fileContents->GetData() + chunkInfoIt->second.m_offset, chunkInfoIt->second.m_size);
             
             return CSBinaryChunkUPtr(new CSBinaryChunk(std::move(chunkData), chunkInfoIt->second.m_size));
         }
@@ -151,14 +167,17 @@ namespace ChilliSource
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
-    void CSBinaryInputStream::ReadChunkTable(u32 in_numEntries)
+    bool CSBinaryInputStream::ReadChunkTable(u32 in_numEntries, const std::string& in_filePath)
     {
-        const u32 k_chunkEntrySize = 12;
+        const u64 fileSize = m_fileContents->GetLength();
         
-        //read the chunk table
-        const u32 chunkTableDataSize = k_chunkEntrySize * in_numEntries;
-        std::unique_ptr<u8[]> chunkTableData(new u8[chunkTableDataSize]);
-        m_fileStream->Read(chunkTableData.get(), chunkTableDataSize);
+        if (k_headerSize + u64(k_chunkEntrySize) * in_numEntries > fileSize)
+        {
+            CS_LOG_ERROR("Chunk table is truncated in file: " + in_filePath);
+            return false;
+        }
+        
+        const u8* chunkTableData = m_fileContents->GetData() + k_headerSize;
         
         //iterate over the chunks
         for (u32 i = 0; i < in_numEntries; ++i)
@@ -167,19 +186,27 @@ namespace ChilliSource
             
             //get the chunk identifier
             const u32 k_chunkIdSize = 4;
-            std::string chunkId(reinterpret_cast<const s8*>(chunkTableData.get() + chunkOffset), k_chunkIdSize);
+            std::string chunkId(reinterpret_cast<const s8*>(chunkTableData + chunkOffset), k_chunkIdSize);
             
             ChunkInfo info;
             
             //get the chunk offset.
             const u32 k_offsetOffset = 4;
-            info.m_offset = *reinterpret_cast<const u32*>(chunkTableData.get() + chunkOffset + k_offsetOffset);
+            info.m_offset = ReadU32(chunkTableData, chunkOffset + k_offsetOffset);
             
             //get the chunk size.
             const u32 k_sizeOffset = 8;
-            info.m_size = *reinterpret_cast<const u32*>(chunkTableData.get() + chunkOffset + k_sizeOffset);
+            info.m_size = ReadU32(chunkTableData, chunkOffset + k_sizeOffset);
+            
+            if (u64(info.m_offset) + info.m_size > fileSize)
+            {
+                CS_LOG_ERROR("Chunk '" + chunkId + "' extends past the end of file: " + in_filePath);
+                return false;
+            }
             
             m_chunkInfoMap.emplace(chunkId, info);
         }
+        
+        return true;
     }
 }
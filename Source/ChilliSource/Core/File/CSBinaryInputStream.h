@@ -30,7 +30,7 @@
 #define _CHILLISOURCE_CORE_FILE_CSBINARYINPUTSTREAM_H_
 
 #include <ChilliSource/ChilliSource.h>
-#include <ChilliSource/Core/File/FileStream/IBinaryInputStream.h>
+#include <ChilliSource/Core/Base/ByteBuffer.h>
 
 #include <unordered_map>
 
@@ -38,8 +38,9 @@ namespace ChilliSource
 {
     //----------------------------------------------------------------------
     /// A file input stream for reading files that use Chilli Source's
-    /// "Chunked" binary file format. The input stream wraps around a
-    /// standard file stream and provides an easy and efficient API for
+    /// "Chunked" binary file format. The whole file is read into memory
+    /// with a single read when the stream is created, after which chunks
+    /// are served from memory, providing an easy and efficient API for
     /// loading files.
     ///
     /// The Chilli Source "Chunked" file format has 3 sections. The header,
@@ -152,10 +153,13 @@ namespace ChilliSource
         /// @author Ian Copland
         ///
         /// @param The number of entries in the chunk table.
+        /// @param The file path. This is only used for error messages.
+        ///
+        /// @return Whether or not the chunk table was valid.
         //--------------------------------------------------------------
-        void ReadChunkTable(u32 in_numEntries);
+        bool ReadChunkTable(u32 in_numEntries, const std::string& in_filePath);
         
-        IBinaryInputStreamUPtr m_fileStream;
+        ByteBufferUPtr m_fileContents;
         bool m_isValid = false;
         u32 m_fileFormatId = 0;
         u32 m_fileFormatVersion = 0;
@@ -45,6 +45,12 @@ namespace ChilliSource
         CS_ASSERT(!m_fileStream.fail(), "Unexpected error occured writing to the stream.");
     }
     //------------------------------------------------------------------------------
+    void TextOutputStream::Flush() noexcept
+    {
+        CS_ASSERT(IsValid(), "Trying to use an invalid FileStream.");
+        m_fileStream.flush();
+    }
+    //------------------------------------------------------------------------------
     TextOutputStream::~TextOutputStream() noexcept
     {
         if(m_fileStream.is_open())
@@ -36,7 +36,7 @@ namespace ChilliSource
     /// Class to provide textual write functionality for a file.
 	///
 	/// Calling Write() on this stream will not cause a flush to disk, this will
-	/// only occur when the destructer is called.
+	/// only occur when Flush() or the destructer is called.
 	///
 	/// If a TextOutputStream is created with an existing file, that file will
     /// be overwritten, regardless of whether or not a Write() was carried out, unless
@@ -82,6 +82,11 @@ namespace ChilliSource
         ///
         void Write(const std::string& data) noexcept;
         
+        /// Writes any pending data written to this stream to disk, without closing
+        /// the stream.
+        ///
+        void Flush() noexcept;
+        
         /// This will write any pending data written to this stream to disk
         /// and close the stream
         ///
@@ -212,6 +212,21 @@ namespace ChilliSource
         //------------------------------------------------------------------------------
         virtual bool DeleteFile(StorageLocation in_storageLocation, const std::string& in_filePath) const = 0;
         //------------------------------------------------------------------------------
+        /// Renames the given file, replacing the destination if it already exists. Where
+        /// the platform allows, the destination is replaced atomically, so it will always
+        /// contain either the previous file or the new one, never a partially written
+        /// file. Both files must be in the same storage location.
+        ///
+        /// This is thread-safe.
+        ///
+        /// @param in_storageLocation - The storage location.
+        /// @param in_sourceFilePath - The file path of the file to rename.
+        /// @param in_destinationFilePath - The new file path.
+        ///
+        /// @return Whether or not the file was successfully renamed.
+        //------------------------------------------------------------------------------
+        virtual bool RenameFile(StorageLocation in_storageLocation, const std::string& in_sourceFilePath, const std::string& in_destinationFilePath) const = 0;
+        //------------------------------------------------------------------------------
         /// Deletes a directory and all its contents.
         ///
         /// This is thread-safe.
@@ -0,0 +1,464 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Core/File/PackedArchive.h>
+
+#include <ChilliSource/Core/Cryptographic/HashCRC32.h>
+#include <ChilliSource/Core/File/FileStream/VirtualBinaryInputStream.h>
+#include <ChilliSource/Core/File/FileStream/VirtualTextInputStream.h>
+#include <ChilliSource/Core/String/StringUtils.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <limits>
+
+#if defined(CS_TARGETPLATFORM_WINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ChilliSource
+{
+    namespace
+    {
+        const u8 k_magic[4] = { 'C', 'S', 'P', 'K' };
+        const u32 k_version = 1;
+        const u32 k_headerSize = 24;
+        const u32 k_entrySize = 32;
+        
+        const u32 k_flagDirectory = 1 << 0;
+        const u32 k_flagCompressed = 1 << 1;
+        
+        /// @param data
+        ///     The data to read from. Must be at least 4 bytes.
+        ///
+        /// @return The little endian u32 at the start of the data.
+        ///
+        u32 ReadU32(const u8* data) noexcept
+        {
+            return u32(data[0]) | (u32(data[1]) << 8) | (u32(data[2]) << 16) | (u32(data[3]) << 24);
+        }
+        
+        /// @param data
+        ///     The data to read from. Must be at least 8 bytes.
+        ///
+        /// @return The little endian u64 at the start of the data.
+        ///
+        u64 ReadU64(const u8* data) noexcept
+        {
+            return u64(ReadU32(data)) | (u64(ReadU32(data + 4)) << 32);
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    PackedArchive::PackedArchive(const std::string& archiveFilePath, u64 archiveOffset) noexcept
+        : m_filePath(archiveFilePath), m_archiveOffset(archiveOffset)
+    {
+#if defined(CS_TARGETPLATFORM_WINDOWS)
+        HANDLE fileHandle = CreateFileA(m_filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            return;
+        }
+        m_fileHandle = fileHandle;
+#else
+        m_fileDescriptor = open(m_filePath.c_str(), O_RDONLY);
+        if (m_fileDescriptor < 0)
+        {
+            return;
+        }
+#endif
+        
+        m_isValid = ReadIndex();
+    }
+    
+    //------------------------------------------------------------------------------
+    bool PackedArchive::IsValid() const noexcept
+    {
+        return m_isValid;
+    }
+    
+    //------------------------------------------------------------------------------
+    ITextInputStreamUPtr PackedArchive::CreateTextInputStream(const std::string& filePath) const noexcept
+    {
+        u32 fileSize = 0;
+        auto fileContents = ReadFile(filePath, fileSize);
+        if (!fileContents)
+        {
+            return nullptr;
+        }
+        
+        ITextInputStreamUPtr output(new VirtualTextInputStream(std::move(fileContents), fileSize));
+        if (!output->IsValid())
+        {
+            return nullptr;
+        }
+        
+        return output;
+    }
+    
+    //------------------------------------------------------------------------------
+    IBinaryInputStreamUPtr PackedArchive::CreateBinaryInputStream(const std::string& filePath) const noexcept
+    {
+        u32 fileSize = 0;
+        auto fileContents = ReadFile(filePath, fileSize);
+        if (!fileContents)
+        {
+            return nullptr;
+        }
+        
+        IBinaryInputStreamUPtr output(new VirtualBinaryInputStream(std::move(fileContents), fileSize));
+        if (!output->IsValid())
+        {
+            return nullptr;
+        }
+        
+        return output;
+    }
+    
+    //------------------------------------------------------------------------------
+    std::unique_ptr<u8[]> PackedArchive::ReadFile(const std::string& filePath, u32& fileSize) const noexcept
+    {
+        CS_ASSERT(IsValid(), "Calling into an invalid PackedArchive.");
+        
+        auto entry = FindEntry(StringUtils::StandardiseFilePath(filePath));
+        if (!entry || (entry->m_flags & k_flagDirectory) != 0)
+        {
+            return nullptr;
+        }
+        
+        //Empty files still exist, so they are given a non-null buffer which the virtual streams accept with a size of zero.
+        if (entry->m_uncompressedSize == 0)
+        {
+            fileSize = 0;
+            return std::unique_ptr<u8[]>(new u8[1]);
+        }
+        
+        std::unique_ptr<u8[]> storedData(new u8[entry->m_storedSize]);
+        if (!ReadBytes(entry->m_dataOffset, storedData.get(), entry->m_storedSize))
+        {
+            return nullptr;
+        }
+        
+        if ((entry->m_flags & k_flagCompressed) == 0)
+        {
+            fileSize = entry->m_storedSize;
+            return storedData;
+        }
+        
+        std::unique_ptr<u8[]> uncompressedData(new u8[entry->m_uncompressedSize]);
+        uLongf uncompressedSize = entry->m_uncompressedSize;
+        if (uncompress(reinterpret_cast<Bytef*>(uncompressedData.get()), &uncompressedSize, reinterpret_cast<const Bytef*>(storedData.get()), uLong(entry->m_storedSize)) != Z_OK
+            || uncompressedSize != entry->m_uncompressedSize)
+        {
+            CS_LOG_ERROR("PackedArchive: Failed to decompress '" + filePath + "'.");
+            return nullptr;
+        }
+        
+        fileSize = entry->m_uncompressedSize;
+        return uncompressedData;
+    }
+    
+    //------------------------------------------------------------------------------
+    bool PackedArchive::ExtractFiles(const std::vector<std::string>& filePaths, const FileReadDelegate& delegate) const noexcept
+    {
+        CS_ASSERT(IsValid(), "Calling into an invalid PackedArchive.");
+        
+        for (const auto& filePath : filePaths)
+        {
+            u32 fileSize = 0;
+            std::unique_ptr<const u8[]> fileContents = ReadFile(filePath, fileSize);
+            if (!fileContents && !DoesFileExist(filePath))
+            {
+                return false;
+            }
+            
+            if (!delegate(filePath, std::move(fileContents), fileSize))
+            {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+    
+    //------------------------------------------------------------------------------
+    bool PackedArchive::DoesFileExist(const std::string& filePath) const noexcept
+    {
+        CS_ASSERT(IsValid(), "Calling into an invalid PackedArchive.");
+        
+        auto entry = FindEntry(StringUtils::StandardiseFilePath(filePath));
+        return (entry && (entry->m_flags & k_flagDirectory) == 0);
+    }
+    
+    //------------------------------------------------------------------------------
+    bool PackedArchive::DoesDirectoryExist(const std::string& directoryPath) const noexcept
+    {
+        CS_ASSERT(IsValid(), "Calling into an invalid PackedArchive.");
+        
+        auto entry = FindEntry(StringUtils::StandardiseDirectoryPath(directoryPath));
+        return (entry && (entry->m_flags & k_flagDirectory) != 0);
+    }
+    
+    //------------------------------------------------------------------------------
+    std::vector<std::string> PackedArchive::GetFilePaths(const std::string& directoryPath, bool recursive) const noexcept
+    {
+        CS_ASSERT(IsValid(), "Calling into an invalid PackedArchive.");
+        
+        std::vector<std::string> output;
+        auto standardisedDirectoryPath = StringUtils::StandardiseDirectoryPath(directoryPath);
+        for (const auto& entry : m_entries)
+        {
+            if ((entry.m_flags & k_flagDirectory) == 0 && entry.m_pathLength > standardisedDirectoryPath.length()
+                && m_pathTable.compare(entry.m_pathOffset, standardisedDirectoryPath.length(), standardisedDirectoryPath) == 0)
+            {
+                auto relativeFilePath = m_pathTable.substr(entry.m_pathOffset + standardisedDirectoryPath.length(), entry.m_pathLength - standardisedDirectoryPath.length());
+                if (recursive || relativeFilePath.find('/') == std::string::npos)
+                {
+                    output.push_back(std::move(relativeFilePath));
+                }
+            }
+        }
+        
+        return output;
+    }
+    
+    //------------------------------------------------------------------------------
+    std::vector<std::string> PackedArchive::GetDirectoryPaths(const std::string& directoryPath, bool recursive) const noexcept
+    {
+        CS_ASSERT(IsValid(), "Calling into an invalid PackedArchive.");
+        
+        std::vector<std::string> output;
+        auto standardisedDirectoryPath = StringUtils::StandardiseDirectoryPath(directoryPath);
+        for (const auto& entry : m_entries)
+        {
+            if ((entry.m_flags & k_flagDirectory) != 0 && entry.m_pathLength > standardisedDirectoryPath.length()
+                && m_pathTable.compare(entry.m_pathOffset, standardisedDirectoryPath.length(), standardisedDirectoryPath) == 0)
+            {
+                auto relativeDirectoryPath = m_pathTable.substr(entry.m_pathOffset + standardisedDirectoryPath.length(), entry.m_pathLength - standardisedDirectoryPath.length());
+                if (recursive || relativeDirectoryPath.find('/') == relativeDirectoryPath.length() - 1)
+                {
+                    output.push_back(std::move(relativeDirectoryPath));
+                }
+            }
+        }
+        
+        return output;
+    }
+    
+    //------------------------------------------------------------------------------
+    bool PackedArchive::TryGetFileInfo(const std::string& filePath, FileInfo& fileInfo) const noexcept
+    {
+        CS_ASSERT(IsValid(), "Calling into an invalid PackedArchive.");
+        
+        auto entry = FindEntry(StringUtils::StandardiseFilePath(filePath));
+        if (!entry || (entry->m_flags & k_flagDirectory) != 0)
+        {
+            return false;
+        }
+        
+        fileInfo.m_offset = m_archiveOffset + entry->m_dataOffset;
+        fileInfo.m_size = entry->m_storedSize;
+        fileInfo.m_uncompressedSize = entry->m_uncompressedSize;
+        fileInfo.m_isCompressed = (entry->m_flags & k_flagCompressed) != 0;
+        return true;
+    }
+    
+    //------------------------------------------------------------------------------
+    bool PackedArchive::ReadIndex() noexcept
+    {
+        u8 header[k_headerSize];
+        if (!ReadBytes(0, header, k_headerSize) || !std::equal(k_magic, k_magic + 4, header))
+        {
+            CS_LOG_ERROR("PackedArchive: '" + m_filePath + "' is not a packed archive.");
+            return false;
+        }
+        
+        if (ReadU32(header + 4) != k_version)
+        {
+            CS_LOG_ERROR("PackedArchive: '" + m_filePath + "' has an unsupported version.");
+            return false;
+        }
+        
+        u32 numEntries = ReadU32(header + 8);
+        u32 pathTableSize = ReadU32(header + 16);
+        
+        //The sizes are checked against the archive before anything is allocated so a corrupt header can't cause a huge allocation.
+        u64 archiveSize = GetArchiveSize();
+        u64 indexSize = u64(numEntries) * k_entrySize;
+        if (archiveSize < k_headerSize || indexSize > std::numeric_limits<u32>::max() || indexSize > archiveSize - k_headerSize || pathTableSize > archiveSize - k_headerSize - indexSize)
+        {
+            CS_LOG_ERROR("PackedArchive: '" + m_filePath + "' has a corrupt header.");
+            return false;
+        }
+        
+        std::vector<u8> index(static_cast<std::size_t>(indexSize));
+        if (!index.empty() && !ReadBytes(k_headerSize, index.data(), u32(indexSize)))
+        {
+            CS_LOG_ERROR("PackedArchive: Failed to read the index of '" + m_filePath + "'.");
+            return false;
+        }
+        
+        m_pathTable.resize(pathTableSize);
+        if (pathTableSize > 0 && !ReadBytes(k_headerSize + indexSize, reinterpret_cast<u8*>(&m_pathTable[0]), pathTableSize))
+        {
+            CS_LOG_ERROR("PackedArchive: Failed to read the path table of '" + m_filePath + "'.");
+            return false;
+        }
+        
+        m_entries.resize(numEntries);
+        for (u32 i = 0; i < numEntries; ++i)
+        {
+            const u8* entryData = index.data() + std::size_t(i) * k_entrySize;
+            
+            auto& entry = m_entries[i];
+            entry.m_pathHash = ReadU32(entryData);
+            entry.m_pathOffset = ReadU32(entryData + 4);
+            entry.m_pathLength = ReadU32(entryData + 8);
+            entry.m_flags = ReadU32(entryData + 12);
+            entry.m_dataOffset = ReadU64(entryData + 16);
+            entry.m_storedSize = ReadU32(entryData + 24);
+            entry.m_uncompressedSize = ReadU32(entryData + 28);
+            
+            if (u64(entry.m_pathOffset) + entry.m_pathLength > pathTableSize || entry.m_dataOffset > archiveSize || entry.m_storedSize > archiveSize - entry.m_dataOffset)
+            {
+                CS_LOG_ERROR("PackedArchive: '" + m_filePath + "' has a corrupt index.");
+                return false;
+            }
+            
+            //Lookups binary search on the path hash, so an unsorted index would silently fail to find files.
+            if (i > 0 && m_entries[i - 1].m_pathHash > entry.m_pathHash)
+            {
+                CS_LOG_ERROR("PackedArchive: '" + m_filePath + "' has an index which isn't sorted by path hash.");
+                return false;
+            }
+        }
+        
+        return true;
+    }
+    
+    //------------------------------------------------------------------------------
+    u64 PackedArchive::GetArchiveSize() const noexcept
+    {
+        u64 fileSize = 0;
+        
+#if defined(CS_TARGETPLATFORM_WINDOWS)
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(static_cast<HANDLE>(m_fileHandle), &size) == FALSE)
+        {
+            return 0;
+        }
+        fileSize = u64(size.QuadPart);
+#else
+        struct stat fileStats;
+        if (fstat(m_fileDescriptor, &fileStats) != 0)
+        {
+            return 0;
+        }
+        fileSize = u64(fileStats.st_size);
+#endif
+        
+        return (fileSize > m_archiveOffset) ? fileSize - m_archiveOffset : 0;
+    }
+    
+    //------------------------------------------------------------------------------
+    bool PackedArchive::ReadBytes(u64 offset, u8* buffer, u32 size) const noexcept
+    {
+        u64 fileOffset = m_archiveOffset + offset;
+        
+#if defined(CS_TARGETPLATFORM_WINDOWS)
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = DWORD(fileOffset & 0xffffffff);
+        overlapped.OffsetHigh = DWORD(fileOffset >> 32);
+        
+        DWORD numBytesRead = 0;
+        return (::ReadFile(static_cast<HANDLE>(m_fileHandle), buffer, DWORD(size), &numBytesRead, &overlapped) != FALSE && numBytesRead == size);
+#else
+        u32 totalBytesRead = 0;
+        while (totalBytesRead < size)
+        {
+            auto numBytesRead = pread(m_fileDescriptor, buffer + totalBytesRead, size - totalBytesRead, off_t(fileOffset + totalBytesRead));
+            if (numBytesRead <= 0)
+            {
+                return false;
+            }
+            
+            totalBytesRead += u32(numBytesRead);
+        }
+        
+        return true;
+#endif
+    }
+    
+    //------------------------------------------------------------------------------
+    const PackedArchive::Entry* PackedArchive::FindEntry(const std::string& path) const noexcept
+    {
+        u32 pathHash = HashCRC32::GenerateHashCode(path);
+        
+        auto it = std::lower_bound(m_entries.begin(), m_entries.end(), pathHash, [](const Entry& entry, u32 hash)
+        {
+            return entry.m_pathHash < hash;
+        });
+        
+        //Avoid collisions by checking the path of each entry with a matching hash.
+        while (it != m_entries.end() && it->m_pathHash == pathHash)
+        {
+            if (it->m_pathLength == path.length() && m_pathTable.compare(it->m_pathOffset, it->m_pathLength, path) == 0)
+            {
+                return &(*it);
+            }
+            
+            ++it;
+        }
+        
+        return nullptr;
+    }
+    
+    //------------------------------------------------------------------------------
+    std::string PackedArchive::GetEntryPath(const Entry& entry) const noexcept
+    {
+        return m_pathTable.substr(entry.m_pathOffset, entry.m_pathLength);
+    }
+    
+    //------------------------------------------------------------------------------
+    PackedArchive::~PackedArchive() noexcept
+    {
+#if defined(CS_TARGETPLATFORM_WINDOWS)
+        if (m_fileHandle)
+        {
+            CloseHandle(static_cast<HANDLE>(m_fileHandle));
+        }
+#else
+        if (m_fileDescriptor >= 0)
+        {
+            close(m_fileDescriptor);
+        }
+#endif
+    }
+}
@@ -0,0 +1,263 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#ifndef _CHILLISOURCE_CORE_FILE_PACKEDARCHIVE_H_
+#define _CHILLISOURCE_CORE_FILE_PACKEDARCHIVE_H_
+
+#include <ChilliSource/ChilliSource.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ChilliSource
+{
+    /// Provides read-only access to the contents of a packed asset archive, as produced
+    /// by Tools/Scripts/pack_archive.py. This offers the same operations as a zip based file
+    /// system - creation of (virtual) file streams, extracting files and listing the
+    /// contents of directories - but is designed for fast, concurrent access.
+    ///
+    /// The archive consists of a header, an index of all files and directories sorted by
+    /// the CRC32 hash of their path, a table of path strings and finally the file data.
+    /// Each file is either stored as is or individually compressed with zlib, and the data
+    /// for each file starts on an aligned boundary. All values are little endian.
+    ///
+    /// The index is read once on construction and is immutable afterwards. File data is
+    /// read using positional reads rather than a shared file cursor, so any number of
+    /// threads can read from the archive at the same time without locking.
+    ///
+    /// The archive may be embedded within another file, for example an uncompressed entry
+    /// inside an Android Apk, by supplying the offset of the archive within the file.
+    ///
+    /// Building an archive is not part of the standard build scripts; pack_archive.py must
+    /// be run by hand, and on Android a Package.cspack is only used if it has been added
+    /// to the Apk.
+    ///
+    class PackedArchive final
+    {
+    public:
+        CS_DECLARE_NOCOPY(PackedArchive);
+        
+        /// Describes the location of a single file within the archive. This can be used
+        /// to manually access the file data.
+        ///
+        struct FileInfo final
+        {
+            u64 m_offset = 0;
+            u32 m_size = 0;
+            u32 m_uncompressedSize = 0;
+            bool m_isCompressed = false;
+        };
+        
+        /// A delegate called by ExtractFiles() as each file is read from the archive.
+        ///
+        /// @param filePath
+        ///     The path to the file which this callback refers to.
+        /// @param fileContents
+        ///     The entire, decompressed, contents of the file.
+        /// @param fileSize
+        ///     The size of the file.
+        ///
+        /// @return False if an error has occurred and ExtractFiles() should stop.
+        ///
+        using FileReadDelegate = std::function<bool(const std::string& filePath, std::unique_ptr<const u8[]> fileContents, u32 fileSize)>;
+        
+        /// Opens the archive and reads its index. IsValid() should be checked before the
+        /// archive is used.
+        ///
+        /// @param archiveFilePath
+        ///     The absolute path to the file containing the archive.
+        /// @param archiveOffset
+        ///     The offset of the archive within the file. Defaults to the start of the file.
+        ///
+        PackedArchive(const std::string& archiveFilePath, u64 archiveOffset = 0) noexcept;
+        
+        /// @return Whether or not the archive was successfully opened and is ready for use.
+        ///
+        bool IsValid() const noexcept;
+        
+        /// Creates a new "virtual" text stream to a file within the archive. The file is read
+        /// in full and stored in memory.
+        ///
+        /// @param filePath
+        ///     The path to the file within the archive.
+        ///
+        /// @return The new stream, or null if the file doesn't exist or couldn't be read.
+        ///
+        ITextInputStreamUPtr CreateTextInputStream(const std::string& filePath) const noexcept;
+        
+        /// Creates a new "virtual" binary stream to a file within the archive. The file is
+        /// read in full and stored in memory.
+        ///
+        /// @param filePath
+        ///     The path to the file within the archive.
+        ///
+        /// @return The new stream, or null if the file doesn't exist or couldn't be read.
+        ///
+        IBinaryInputStreamUPtr CreateBinaryInputStream(const std::string& filePath) const noexcept;
+        
+        /// Reads the entire contents of a file within the archive, decompressing it if
+        /// required.
+        ///
+        /// @param filePath
+        ///     The path to the file within the archive.
+        /// @param fileSize
+        ///     [Out] The size of the file. This is only set if successful.
+        ///
+        /// @return The contents of the file, or null if it doesn't exist or couldn't be
+        ///     read. An empty file returns a non-null buffer with a size of zero.
+        ///
+        std::unique_ptr<u8[]> ReadFile(const std::string& filePath, u32& fileSize) const noexcept;
+        
+        /// Reads a series of files, passing the contents of each to the given delegate.
+        ///
+        /// @param filePaths
+        ///     The paths to the files within the archive.
+        /// @param delegate
+        ///     Called as each file is read.
+        ///
+        /// @return Whether or not all files were successfully read and processed.
+        ///
+        bool ExtractFiles(const std::vector<std::string>& filePaths, const FileReadDelegate& delegate) const noexcept;
+        
+        /// @param filePath
+        ///     The path to the file within the archive.
+        ///
+        /// @return Whether or not the file exists.
+        ///
+        bool DoesFileExist(const std::string& filePath) const noexcept;
+        
+        /// @param directoryPath
+        ///     The path to the directory within the archive.
+        ///
+        /// @return Whether or not the directory exists.
+        ///
+        bool DoesDirectoryExist(const std::string& directoryPath) const noexcept;
+        
+        /// @param directoryPath
+        ///     The path to the directory within the archive.
+        /// @param recursive
+        ///     Whether or not to recurse into sub-directories.
+        ///
+        /// @return The paths of all files in the directory, relative to the directory.
+        ///
+        std::vector<std::string> GetFilePaths(const std::string& directoryPath, bool recursive) const noexcept;
+        
+        /// @param directoryPath
+        ///     The path to the directory within the archive.
+        /// @param recursive
+        ///     Whether or not to recurse into sub-directories.
+        ///
+        /// @return The paths of all sub-directories in the directory, relative to the
+        ///     directory.
+        ///
+        std::vector<std::string> GetDirectoryPaths(const std::string& directoryPath, bool recursive) const noexcept;
+        
+        /// Gets the location of a single file within the archive. The offset is relative to
+        /// the start of the file containing the archive, rather than the archive itself.
+        ///
+        /// @param filePath
+        ///     The path to the file within the archive.
+        /// @param fileInfo
+        ///     [Out] The file info. This is only set if successful.
+        ///
+        /// @return Whether or not the file exists.
+        ///
+        bool TryGetFileInfo(const std::string& filePath, FileInfo& fileInfo) const noexcept;
+        
+        ~PackedArchive() noexcept;
+        
+    private:
+        /// A single file or directory within the archive index.
+        ///
+        struct Entry final
+        {
+            u32 m_pathHash = 0;
+            u32 m_pathOffset = 0;
+            u32 m_pathLength = 0;
+            u32 m_flags = 0;
+            u64 m_dataOffset = 0;
+            u32 m_storedSize = 0;
+            u32 m_uncompressedSize = 0;
+        };
+        
+        /// Reads the header, index and path table from the archive. This must only be
+        /// called during construction as the archive must be immutable afterwards.
+        ///
+        /// @return Whether or not the index was successfully read.
+        ///
+        bool ReadIndex() noexcept;
+        
+        /// @return The number of bytes from the start of the archive to the end of the
+        ///     file containing it, or zero if the size couldn't be determined.
+        ///
+        u64 GetArchiveSize() const noexcept;
+        
+        /// Reads bytes from the given position in the archive. This doesn't modify any shared
+        /// state, so can be called from multiple threads at once.
+        ///
+        /// @param offset
+        ///     The offset from the start of the archive.
+        /// @param buffer
+        ///     The buffer to read into.
+        /// @param size
+        ///     The number of bytes to read.
+        ///
+        /// @return Whether or not all bytes were read.
+        ///
+        bool ReadBytes(u64 offset, u8* buffer, u32 size) const noexcept;
+        
+        /// Looks up the entry with the given standardised path.
+        ///
+        /// @param path
+        ///     The file or directory path. Directory paths must end with a slash.
+        ///
+        /// @return The entry, or null if there is none.
+        ///
+        const Entry* FindEntry(const std::string& path) const noexcept;
+        
+        /// @param entry
+        ///     The entry.
+        ///
+        /// @return The path of the given entry.
+        ///
+        std::string GetEntryPath(const Entry& entry) const noexcept;
+        
+        std::string m_filePath;
+        u64 m_archiveOffset = 0;
+        bool m_isValid = false;
+        
+#if defined(CS_TARGETPLATFORM_WINDOWS)
+        void* m_fileHandle = nullptr;
+#else
+        s32 m_fileDescriptor = -1;
+#endif
+        
+        std::vector<Entry> m_entries;
+        std::string m_pathTable;
+    };
+}
+
+#endif
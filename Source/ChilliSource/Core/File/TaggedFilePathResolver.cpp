@@ -40,6 +40,41 @@ namespace ChilliSource
 {
     namespace
     {
+        //--------------------------------------------------------------
+        /// @param in_location - The storage location.
+        ///
+        /// @return Whether or not paths in the given storage location
+        /// are indexed. Only locations whose contents are fixed, or
+        /// change in a controlled manner, are indexed.
+        //--------------------------------------------------------------
+        bool IsIndexedLocation(StorageLocation in_location)
+        {
+            return in_location == StorageLocation::k_package || in_location == StorageLocation::k_chilliSource || in_location == StorageLocation::k_DLC;
+        }
+        //--------------------------------------------------------------
+        /// Filter the list of file paths based on those that end with
+        /// the given extension, ignoring case.
+        ///
+        /// @param List to filter
+        /// @param Extension, without the leading dot
+        ///
+        /// @return Filtered list
+        //--------------------------------------------------------------
+        std::vector<std::string> FilterExtension(const std::vector<std::string>& in_list, const std::string& in_extension)
+        {
+            std::string extension = "." + in_extension;
+            
+            std::vector<std::string> result;
+            for(const auto& string : in_list)
+            {
+                if(StringUtils::EndsWith(string, extension, true) == true)
+                {
+                    result.push_back(string);
+                }
+            }
+            
+            return result;
+        }
         //--------------------------------------------------------------
         /// Filter the list of file paths based on those that contain
         /// the names that start with the given text
@@ -309,6 +344,8 @@ namespace ChilliSource
             }
         }
 #endif
+        
+        ClearResolvedPaths();
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
@@ -335,6 +372,8 @@ namespace ChilliSource
                 break;
             }
         }
+        
+        ClearResolvedPaths();
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
@@ -343,11 +382,52 @@ namespace ChilliSource
         std::string filePath, fileName, fileExtension;
         StringUtils::SplitFullFilename(in_basePath, fileName, fileExtension, filePath);
         
-        //Look for all files in the given folder with the given name and extension
-        std::vector<std::string> pathsContaining = m_fileSystem->GetFilePathsWithExtension(in_location, filePath, false, fileExtension);
+        if(IsIndexedLocation(in_location) == false)
+        {
+            //Look for all files in the given folder with the given name and extension
+            std::vector<std::string> pathsContaining = m_fileSystem->GetFilePathsWithExtension(in_location, filePath, false, fileExtension);
+            return SelectTaggedFilePath(in_basePath, filePath, fileName, pathsContaining);
+        }
         
+        std::unique_lock<std::mutex> lock(m_indexMutex);
+        
+        auto& index = m_locationIndices[(u32)in_location];
+        auto resolvedIt = index.m_resolvedPaths.find(in_basePath);
+        if(resolvedIt != index.m_resolvedPaths.end())
+        {
+            return resolvedIt->second;
+        }
+        
+        auto directoryIt = index.m_directoryFiles.find(filePath);
+        if(directoryIt == index.m_directoryFiles.end())
+        {
+            directoryIt = index.m_directoryFiles.emplace(filePath, m_fileSystem->GetFilePaths(in_location, filePath, false)).first;
+        }
+        
+        auto resolvedPath = SelectTaggedFilePath(in_basePath, filePath, fileName, FilterExtension(directoryIt->second, fileExtension));
+        index.m_resolvedPaths.emplace(in_basePath, resolvedPath);
+        
+        return resolvedPath;
+    }
+    //--------------------------------------------------------------
+    //--------------------------------------------------------------
+    void TaggedFilePathResolver::InvalidateIndex(StorageLocation in_location)
+    {
+        if(IsIndexedLocation(in_location) == true)
+        {
+            std::unique_lock<std::mutex> lock(m_indexMutex);
+            
+            auto& index = m_locationIndices[(u32)in_location];
+            index.m_directoryFiles.clear();
+            index.m_resolvedPaths.clear();
+        }
+    }
+    //--------------------------------------------------------------
+    //--------------------------------------------------------------
+    std::string TaggedFilePathResolver::SelectTaggedFilePath(const std::string& in_basePath, const std::string& in_directoryPath, const std::string& in_fileName, const std::vector<std::string>& in_candidates) const
+    {
         //Filter on the filename
-        pathsContaining = FilterFileNameStartsWith(pathsContaining, fileName + ".");
+        std::vector<std::string> pathsContaining = FilterFileNameStartsWith(in_candidates, in_fileName + ".");
         
         if(pathsContaining.empty() == true)
         {
@@ -382,7 +462,18 @@ namespace ChilliSource
             }
         }
 
-        return finalPaths.empty() == false ? filePath + finalPaths[0] : in_basePath;
+        return finalPaths.empty() == false ? in_directoryPath + finalPaths[0] : in_basePath;
+    }
+    //--------------------------------------------------------------
+    //--------------------------------------------------------------
+    void TaggedFilePathResolver::ClearResolvedPaths()
+    {
+        std::unique_lock<std::mutex> lock(m_indexMutex);
+        
+        for(auto& index : m_locationIndices)
+        {
+            index.m_resolvedPaths.clear();
+        }
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
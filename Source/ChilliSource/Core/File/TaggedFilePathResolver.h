@@ -30,10 +30,14 @@
 #define _CHILLISOURCE_CORE_FILE_TAGGEDFILEPATHRESOLVER_H_
 
 #include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/File/StorageLocation.h>
 #include <ChilliSource/Core/System/AppSystem.h>
 
 #include <json/json.h>
 
+#include <mutex>
+#include <unordered_map>
+
 namespace ChilliSource
 {
     //-----------------------------------------------------------------
@@ -60,6 +64,15 @@ namespace ChilliSource
     /// NOTE: Only the rules and tags for resolution and ratio are
     /// configurable as the platform and language are fixed.
     ///
+    /// Paths in the package, ChilliSource and DLC storage locations are
+    /// resolved using an index: each directory is listed at most once
+    /// and each resolved path is remembered, so repeat lookups don't
+    /// touch the file system. The index for a location must be refreshed
+    /// using InvalidateIndex() if its contents change; the
+    /// ContentManagementSystem does this after installing DLC.
+    ///
+    /// This is thread-safe.
+    ///
     /// @author S Downie
     //-----------------------------------------------------------------
     class TaggedFilePathResolver : public AppSystem
@@ -167,6 +180,15 @@ namespace ChilliSource
         //--------------------------------------------------------------
         std::string ResolveFilePath(StorageLocation in_location, const std::string& in_basePath) const;
         //--------------------------------------------------------------
+        /// Discards the directory listings and resolved paths which have
+        /// been indexed for the given storage location. This should be
+        /// called whenever files are added to or removed from the
+        /// location, for example after DLC has been installed.
+        ///
+        /// @param in_location - The storage location to refresh.
+        //--------------------------------------------------------------
+        void InvalidateIndex(StorageLocation in_location);
+        //--------------------------------------------------------------
         /// Returns the active tag for the given Tag Group.
         ///
         /// @author Ian Copland
@@ -207,9 +229,38 @@ namespace ChilliSource
         /// @param Screen size
         //--------------------------------------------------------------
         void DetermineScreenDependentTags(const Vector2& in_size);
+        //--------------------------------------------------------------
+        /// Picks the best-fit path for the current device tags from the
+        /// given list of candidate files.
+        ///
+        /// @param in_basePath - The base file path.
+        /// @param in_directoryPath - The directory of the base file path.
+        /// @param in_fileName - The file name, without extension.
+        /// @param in_candidates - The file names in the directory with
+        /// the same extension as the base path.
+        ///
+        /// @return The best-fit file path.
+        //--------------------------------------------------------------
+        std::string SelectTaggedFilePath(const std::string& in_basePath, const std::string& in_directoryPath, const std::string& in_fileName, const std::vector<std::string>& in_candidates) const;
+        //--------------------------------------------------------------
+        /// Discards all resolved paths, leaving the directory listings
+        /// intact. This is called whenever the active tags or priority
+        /// change.
+        //--------------------------------------------------------------
+        void ClearResolvedPaths();
         
     private:
         
+        //--------------------------------------------------------------
+        /// The cached directory listings and resolved paths for a single
+        /// storage location.
+        //--------------------------------------------------------------
+        struct LocationIndex
+        {
+            std::unordered_map<std::string, std::vector<std::string>> m_directoryFiles;
+            std::unordered_map<std::string, std::string> m_resolvedPaths;
+        };
+        
         FileSystem* m_fileSystem = nullptr;
         Screen* m_screen = nullptr;
         
@@ -220,6 +271,9 @@ namespace ChilliSource
         std::string m_activeTags[(u32)TagGroup::k_total];
         
         u32 m_priorityIndices[(u32)TagGroup::k_total];
+        
+        mutable std::mutex m_indexMutex;
+        mutable LocationIndex m_locationIndices[(u32)StorageLocation::k_chilliSource + 1];
     };
 }
 
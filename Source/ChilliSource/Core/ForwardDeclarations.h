@@ -73,6 +73,7 @@ namespace ChilliSource
     //---------------------------------------------------------
     template <typename TReturnType, typename... TArgTypes> class ConnectableDelegate;
     template <typename TReturnType, typename... TArgTypes> class DelegateConnection;
+    template <typename TSignature> class InlineDelegate;
     //---------------------------------------------------------
     /// Dialogue
     //---------------------------------------------------------
@@ -89,8 +90,11 @@ namespace ChilliSource
     //---------------------------------------------------------
     template <typename TDelegateType> class Event;
     template <typename TDelegateType> class IConnectableEvent;
+    template <typename TDelegateType> class QueuedEvent;
     CS_FORWARDDECLARE_CLASS(IDisconnectableEvent);
+    CS_FORWARDDECLARE_CLASS(IQueuedEvent);
     CS_FORWARDDECLARE_CLASS(EventConnection);
+    CS_FORWARDDECLARE_CLASS(EventQueue);
     //---------------------------------------------------------
     /// File
     //---------------------------------------------------------
@@ -100,7 +104,10 @@ namespace ChilliSource
     CS_FORWARDDECLARE_CLASS(ITextInputStream);
     CS_FORWARDDECLARE_CLASS(TextInputStream);
     CS_FORWARDDECLARE_CLASS(TextOutputStream);
+    CS_FORWARDDECLARE_CLASS(VirtualBinaryInputStream);
+    CS_FORWARDDECLARE_CLASS(VirtualTextInputStream);
     CS_FORWARDDECLARE_CLASS(FileSystem);
+    CS_FORWARDDECLARE_CLASS(PackedArchive);
     CS_FORWARDDECLARE_CLASS(AppDataStore);
     CS_FORWARDDECLARE_CLASS(TaggedFilePathResolver);
     CS_FORWARDDECLARE_CLASS(CSBinaryInputStream);
@@ -206,6 +213,7 @@ namespace ChilliSource
     //---------------------------------------------------------
     /// String
     //---------------------------------------------------------
+    CS_FORWARDDECLARE_CLASS(InternedString);
     CS_FORWARDDECLARE_CLASS(StringMarkupParser);
     //---------------------------------------------------------
     /// System
@@ -28,223 +28,525 @@
 
 #include <ChilliSource/Core/Image/ImageFormatConverter.h>
 
-#include <ChilliSource/Core/Base/ByteColour.h>
 #include <ChilliSource/Core/Image/ImageCompression.h>
 #include <ChilliSource/Core/Image/ImageFormat.h>
+#include <ChilliSource/Core/Threading/TaskContext.h>
+
+#include <algorithm>
+
+//Defining CS_IMAGEFORMATCONVERTER_DISABLE_SIMD builds only the scalar conversions, which the SIMD kernels are tested and benchmarked against.
+#if defined(CS_IMAGEFORMATCONVERTER_DISABLE_SIMD)
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define CS_IMAGEFORMATCONVERTER_SSE2
+#   include <emmintrin.h>
+#   if defined(__SSSE3__)
+#       define CS_IMAGEFORMATCONVERTER_SSSE3
+#       include <tmmintrin.h>
+#   endif
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#   define CS_IMAGEFORMATCONVERTER_NEON
+#   include <arm_neon.h>
+#endif
 
 namespace ChilliSource
 {
     namespace ImageFormatConverter
     {
+        namespace
+        {
+            const u32 k_inputBytesPerPixel = 4;
+            const u32 k_minPixelsPerTask = 64 * 1024;
+            const u32 k_ditherBlockSize = 256;
+            
+            const u8 k_bayerMatrix[4][4] =
+            {
+                { 0, 8, 2, 10 },
+                { 12, 4, 14, 6 },
+                { 3, 11, 1, 9 },
+                { 15, 7, 13, 5 }
+            };
+            
+            using ConversionKernel = void(*)(const u8* in_source, u8* out_destination, u32 in_numPixels);
+            
+            //---------------------------------------------------
+            /// Describes a conversion from RGBA8888 to another
+            /// format: the kernel which performs it, the size of
+            /// an output pixel and, for the 16-bit formats, the
+            /// number of bits each colour channel is reduced to.
+            //---------------------------------------------------
+            struct Conversion final
+            {
+                ImageFormat m_format;
+                ConversionKernel m_kernel;
+                u32 m_outputBytesPerPixel;
+                u32 m_channelBits[3];
+            };
+#if defined(CS_IMAGEFORMATCONVERTER_SSE2)
+            //---------------------------------------------------
+            /// Packs 8 pixels, held as one per 32-bit lane across
+            /// two registers, whose lanes contain values no
+            /// greater than 0xFFFF, into 8 16-bit values. SSE2
+            /// only provides a signed saturating pack, so the
+            /// lanes are sign extended first.
+            //---------------------------------------------------
+            __m128i Pack32To16(__m128i in_a, __m128i in_b)
+            {
+                in_a = _mm_srai_epi32(_mm_slli_epi32(in_a, 16), 16);
+                in_b = _mm_srai_epi32(_mm_slli_epi32(in_b, 16), 16);
+                return _mm_packs_epi32(in_a, in_b);
+            }
+#endif
+            //---------------------------------------------------
+            //---------------------------------------------------
+            void ConvertToRGB888(const u8* in_source, u8* out_destination, u32 in_numPixels)
+            {
+                u32 i = 0;
+                
+#if defined(CS_IMAGEFORMATCONVERTER_SSSE3)
+                const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+                for (; i + 16 <= in_numPixels; i += 16, in_source += 64, out_destination += 48)
+                {
+                    __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in_source + 0)), shuffle);
+                    __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in_source + 16)), shuffle);
+                    __m128i c = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in_source + 32)), shuffle);
+                    __m128i d = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in_source + 48)), shuffle);
+                    
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out_destination + 0), _mm_or_si128(a, _mm_slli_si128(b, 12)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out_destination + 16), _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out_destination + 32), _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+                }
+#elif defined(CS_IMAGEFORMATCONVERTER_NEON)
+                for (; i + 16 <= in_numPixels; i += 16, in_source += 64, out_destination += 48)
+                {
+                    uint8x16x4_t rgba = vld4q_u8(in_source);
+                    uint8x16x3_t rgb;
+                    rgb.val[0] = rgba.val[0];
+                    rgb.val[1] = rgba.val[1];
+                    rgb.val[2] = rgba.val[2];
+                    vst3q_u8(out_destination, rgb);
+                }
+#endif
+                
+                for (; i < in_numPixels; ++i, in_source += 4, out_destination += 3)
+                {
+                    out_destination[0] = in_source[0];
+                    out_destination[1] = in_source[1];
+                    out_destination[2] = in_source[2];
+                }
+            }
+            //---------------------------------------------------
+            //---------------------------------------------------
+            void ConvertToRGBA4444(const u8* in_source, u8* out_destination, u32 in_numPixels)
+            {
+                u16* pixel16 = reinterpret_cast<u16*>(out_destination);
+                u32 i = 0;
+                
+#if defined(CS_IMAGEFORMATCONVERTER_SSE2)
+                const __m128i maskR = _mm_set1_epi32(0xF0);
+                const __m128i maskG = _mm_set1_epi32(0xF00);
+                const __m128i maskB = _mm_set1_epi32(0xF0);
+                for (; i + 8 <= in_numPixels; i += 8, in_source += 32, pixel16 += 8)
+                {
+                    __m128i packed[2];
+                    for (u32 half = 0; half < 2; ++half)
+                    {
+                        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_source + half * 16));
+                        __m128i r = _mm_slli_epi32(_mm_and_si128(pixels, maskR), 8);
+                        __m128i g = _mm_and_si128(_mm_srli_epi32(pixels, 4), maskG);
+                        __m128i b = _mm_and_si128(_mm_srli_epi32(pixels, 16), maskB);
+                        __m128i a = _mm_srli_epi32(pixels, 28);
+                        packed[half] = _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a));
+                    }
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(pixel16), Pack32To16(packed[0], packed[1]));
+                }
+#elif defined(CS_IMAGEFORMATCONVERTER_NEON)
+                for (; i + 8 <= in_numPixels; i += 8, in_source += 32, pixel16 += 8)
+                {
+                    uint8x8x4_t rgba = vld4_u8(in_source);
+                    uint16x8_t result = vshll_n_u8(rgba.val[0], 8);
+                    result = vsriq_n_u16(result, vshll_n_u8(rgba.val[1], 8), 4);
+                    result = vsriq_n_u16(result, vshll_n_u8(rgba.val[2], 8), 8);
+                    result = vsriq_n_u16(result, vshll_n_u8(rgba.val[3], 8), 12);
+                    vst1q_u16(pixel16, result);
+                }
+#endif
+                
+                for (; i < in_numPixels; ++i, in_source += 4, ++pixel16)
+                {
+                    *pixel16 = u16(((in_source[0] >> 4) << 12) | // R
+                        ((in_source[1] >> 4) << 8) | // G
+                        ((in_source[2] >> 4) << 4) | // B
+                        ((in_source[3] >> 4) << 0)); // A
+                }
+            }
+            //---------------------------------------------------
+            //---------------------------------------------------
+            void ConvertToRGB565(const u8* in_source, u8* out_destination, u32 in_numPixels)
+            {
+                u16* pixel16 = reinterpret_cast<u16*>(out_destination);
+                u32 i = 0;
+                
+#if defined(CS_IMAGEFORMATCONVERTER_SSE2)
+                const __m128i maskR = _mm_set1_epi32(0xF8);
+                const __m128i maskG = _mm_set1_epi32(0x7E0);
+                const __m128i maskB = _mm_set1_epi32(0x1F);
+                for (; i + 8 <= in_numPixels; i += 8, in_source += 32, pixel16 += 8)
+                {
+                    __m128i packed[2];
+                    for (u32 half = 0; half < 2; ++half)
+                    {
+                        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_source + half * 16));
+                        __m128i r = _mm_slli_epi32(_mm_and_si128(pixels, maskR), 8);
+                        __m128i g = _mm_and_si128(_mm_srli_epi32(pixels, 5), maskG);
+                        __m128i b = _mm_and_si128(_mm_srli_epi32(pixels, 19), maskB);
+                        packed[half] = _mm_or_si128(_mm_or_si128(r, g), b);
+                    }
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(pixel16), Pack32To16(packed[0], packed[1]));
+                }
+#elif defined(CS_IMAGEFORMATCONVERTER_NEON)
+                for (; i + 8 <= in_numPixels; i += 8, in_source += 32, pixel16 += 8)
+                {
+                    uint8x8x4_t rgba = vld4_u8(in_source);
+                    uint16x8_t result = vshll_n_u8(rgba.val[0], 8);
+                    result = vsriq_n_u16(result, vshll_n_u8(rgba.val[1], 8), 5);
+                    result = vsriq_n_u16(result, vshll_n_u8(rgba.val[2], 8), 11);
+                    vst1q_u16(pixel16, result);
+                }
+#endif
+                
+                for (; i < in_numPixels; ++i, in_source += 4, ++pixel16)
+                {
+                    *pixel16 = u16(((in_source[0] >> 3) << 11) |
+                        ((in_source[1] >> 2) << 5) |
+                        ((in_source[2] >> 3) << 0));
+                }
+            }
+            //---------------------------------------------------
+            //---------------------------------------------------
+            void ConvertToLumA88(const u8* in_source, u8* out_destination, u32 in_numPixels)
+            {
+                u32 i = 0;
+                
+#if defined(CS_IMAGEFORMATCONVERTER_SSE2)
+                const __m128i maskL = _mm_set1_epi32(0xFF);
+                const __m128i maskA = _mm_set1_epi32(0xFF00);
+                for (; i + 8 <= in_numPixels; i += 8, in_source += 32, out_destination += 16)
+                {
+                    __m128i packed[2];
+                    for (u32 half = 0; half < 2; ++half)
+                    {
+                        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_source + half * 16));
+                        packed[half] = _mm_or_si128(_mm_and_si128(pixels, maskL), _mm_and_si128(_mm_srli_epi32(pixels, 16), maskA));
+                    }
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out_destination), Pack32To16(packed[0], packed[1]));
+                }
+#elif defined(CS_IMAGEFORMATCONVERTER_NEON)
+                for (; i + 16 <= in_numPixels; i += 16, in_source += 64, out_destination += 32)
+                {
+                    uint8x16x4_t rgba = vld4q_u8(in_source);
+                    uint8x16x2_t la;
+                    la.val[0] = rgba.val[0];
+                    la.val[1] = rgba.val[3];
+                    vst2q_u8(out_destination, la);
+                }
+#endif
+                
+                for (; i < in_numPixels; ++i, in_source += 4, out_destination += 2)
+                {
+                    out_destination[0] = in_source[0]; // L
+                    out_destination[1] = in_source[3]; // A
+                }
+            }
+            //---------------------------------------------------
+            //---------------------------------------------------
+            void ConvertToLum8(const u8* in_source, u8* out_destination, u32 in_numPixels)
+            {
+                u32 i = 0;
+                
+#if defined(CS_IMAGEFORMATCONVERTER_SSE2)
+                const __m128i maskL = _mm_set1_epi32(0xFF);
+                for (; i + 16 <= in_numPixels; i += 16, in_source += 64, out_destination += 16)
+                {
+                    __m128i a = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in_source + 0)), maskL);
+                    __m128i b = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in_source + 16)), maskL);
+                    __m128i c = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in_source + 32)), maskL);
+                    __m128i d = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in_source + 48)), maskL);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out_destination), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+                }
+#elif defined(CS_IMAGEFORMATCONVERTER_NEON)
+                for (; i + 16 <= in_numPixels; i += 16, in_source += 64, out_destination += 16)
+                {
+                    uint8x16x4_t rgba = vld4q_u8(in_source);
+                    vst1q_u8(out_destination, rgba.val[0]);
+                }
+#endif
+                
+                for (; i < in_numPixels; ++i, in_source += 4, ++out_destination)
+                {
+                    *out_destination = in_source[0];
+                }
+            }
+            //---------------------------------------------------
+            /// Adds a repeating 16 byte dither pattern to the
+            /// given RGBA8888 pixels, saturating at 255.
+            //---------------------------------------------------
+            void AddDitherPattern(const u8* in_source, const u8* in_pattern, u8* out_destination, u32 in_numPixels)
+            {
+                const u32 numBytes = in_numPixels * k_inputBytesPerPixel;
+                u32 i = 0;
+                
+#if defined(CS_IMAGEFORMATCONVERTER_SSE2)
+                const __m128i pattern = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_pattern));
+                for (; i + 16 <= numBytes; i += 16)
+                {
+                    __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_source + i));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out_destination + i), _mm_adds_epu8(pixels, pattern));
+                }
+#elif defined(CS_IMAGEFORMATCONVERTER_NEON)
+                const uint8x16_t pattern = vld1q_u8(in_pattern);
+                for (; i + 16 <= numBytes; i += 16)
+                {
+                    vst1q_u8(out_destination + i, vqaddq_u8(vld1q_u8(in_source + i), pattern));
+                }
+#endif
+                
+                for (; i < numBytes; ++i)
+                {
+                    out_destination[i] = u8(std::min(u32(in_source[i]) + u32(in_pattern[i % 16]), 255u));
+                }
+            }
+            //---------------------------------------------------
+            /// Builds the dither pattern for 4 consecutive pixels
+            /// on the given row starting at the given column. The
+            /// Bayer threshold is scaled to the quantisation step
+            /// of each colour channel.
+            //---------------------------------------------------
+            void BuildDitherPattern(const Conversion& in_conversion, u32 in_x, u32 in_y, u8* out_pattern)
+            {
+                for (u32 pixel = 0; pixel < 4; ++pixel)
+                {
+                    u8 threshold = k_bayerMatrix[in_y % 4][(in_x + pixel) % 4];
+                    for (u32 channel = 0; channel < 3; ++channel)
+                    {
+                        out_pattern[pixel * 4 + channel] = u8(threshold >> (in_conversion.m_channelBits[channel] - 4));
+                    }
+                    out_pattern[pixel * 4 + 3] = 0;
+                }
+            }
+            //---------------------------------------------------
+            /// Converts a range of pixels. If dithering is
+            /// requested each row segment is biased by the dither
+            /// pattern in small blocks before being passed
+            /// through the standard kernel.
+            //---------------------------------------------------
+            void ConvertRange(const Conversion& in_conversion, const u8* in_source, u8* out_destination, u32 in_width, u32 in_firstPixel, u32 in_numPixels, Dithering in_dithering)
+            {
+                const u8* source = in_source + in_firstPixel * k_inputBytesPerPixel;
+                u8* destination = out_destination + in_firstPixel * in_conversion.m_outputBytesPerPixel;
+                
+                if (in_dithering == Dithering::k_none || in_conversion.m_channelBits[0] == 0)
+                {
+                    in_conversion.m_kernel(source, destination, in_numPixels);
+                    return;
+                }
+                
+                CS_ASSERT(in_width > 0, "Cannot dither image data without knowing its width.");
+                
+                u8 ditheredPixels[k_ditherBlockSize * k_inputBytesPerPixel];
+                u8 pattern[16];
+                
+                const u32 endPixel = in_firstPixel + in_numPixels;
+                for (u32 pixel = in_firstPixel; pixel < endPixel;)
+                {
+                    u32 x = pixel % in_width;
+                    u32 y = pixel / in_width;
+                    u32 rowCount = std::min(in_width - x, endPixel - pixel);
+                    
+                    BuildDitherPattern(in_conversion, x, y, pattern);
+                    
+                    //The block size is a multiple of 4 so the pattern stays in phase between blocks.
+                    for (u32 blockStart = 0; blockStart < rowCount; blockStart += k_ditherBlockSize)
+                    {
+                        u32 blockCount = std::min(k_ditherBlockSize, rowCount - blockStart);
+                        AddDitherPattern(source, pattern, ditheredPixels, blockCount);
+                        in_conversion.m_kernel(ditheredPixels, destination, blockCount);
+                        
+                        source += blockCount * k_inputBytesPerPixel;
+                        destination += blockCount * in_conversion.m_outputBytesPerPixel;
+                    }
+                    
+                    pixel += rowCount;
+                }
+            }
+            //---------------------------------------------------
+            /// Converts the given RGBA8888 data into a new buffer.
+            /// If a task context is provided large images are
+            /// split into chunks of whole rows and converted as
+            /// child tasks.
+            //---------------------------------------------------
+            ImageBuffer ConvertBuffer(const TaskContext* in_taskContext, const Conversion& in_conversion, const u8* in_imageData, u32 in_imageDataSize, u32 in_width, Dithering in_dithering)
+            {
+                CS_ASSERT(in_imageDataSize > 0 && in_imageDataSize % k_inputBytesPerPixel == 0, "Invalid input image data size.");
+                
+                const u32 area = in_imageDataSize / k_inputBytesPerPixel;
+                
+                ImageBuffer outputBuffer;
+                outputBuffer.m_size = area * in_conversion.m_outputBytesPerPixel;
+                outputBuffer.m_data = std::unique_ptr<u8[]>(new u8[outputBuffer.m_size]);
+                
+                u8* outputData = outputBuffer.m_data.get();
+                if (in_taskContext == nullptr || area < 2 * k_minPixelsPerTask)
+                {
+                    ConvertRange(in_conversion, in_imageData, outputData, in_width, 0, area, in_dithering);
+                    return outputBuffer;
+                }
+                
+                u32 rowLength = (in_width > 0) ? in_width : 1;
+                u32 pixelsPerTask = std::max(1u, k_minPixelsPerTask / rowLength) * rowLength;
+                u32 numTasks = (area + pixelsPerTask - 1) / pixelsPerTask;
+                
+                std::vector<Task> tasks;
+                for (u32 taskIndex = 0; taskIndex < numTasks; ++taskIndex)
+                {
+                    tasks.push_back([=, &in_conversion](const TaskContext&)
+                    {
+                        u32 firstPixel = taskIndex * pixelsPerTask;
+                        u32 numPixels = std::min(pixelsPerTask, area - firstPixel);
+                        ConvertRange(in_conversion, in_imageData, outputData, in_width, firstPixel, numPixels, in_dithering);
+                    });
+                }
+                
+                in_taskContext->ProcessChildTasks(tasks);
+                
+                return outputBuffer;
+            }
+            //---------------------------------------------------
+            /// Replaces the contents of the given RGBA8888 image
+            /// with the converted data.
+            //---------------------------------------------------
+            void ConvertImage(const TaskContext* in_taskContext, const Conversion& in_conversion, Image* in_image, Dithering in_dithering)
+            {
+                CS_ASSERT(in_image->GetFormat() == ImageFormat::k_RGBA8888 && in_image->GetCompression() == ImageCompression::k_none, "Cannot convert an image that is not in uncompressed RGBA8888 format.");
+                
+                ImageBuffer rawBuffer = ConvertBuffer(in_taskContext, in_conversion, in_image->GetData(), in_image->GetDataSize(), in_image->GetWidth(), in_dithering);
+                
+                Image::Descriptor desc;
+                desc.m_width = in_image->GetWidth();
+                desc.m_height = in_image->GetHeight();
+                desc.m_dataSize = rawBuffer.m_size;
+                desc.m_compression = in_image->GetCompression();
+                desc.m_format = in_conversion.m_format;
+                in_image->Build(desc, std::move(rawBuffer.m_data));
+            }
+            
+            const Conversion k_toRGB888 = { ImageFormat::k_RGB888, &ConvertToRGB888, 3, { 0, 0, 0 } };
+            const Conversion k_toRGBA4444 = { ImageFormat::k_RGBA4444, &ConvertToRGBA4444, 2, { 4, 4, 4 } };
+            const Conversion k_toRGB565 = { ImageFormat::k_RGB565, &ConvertToRGB565, 2, { 5, 6, 5 } };
+            const Conversion k_toLumA88 = { ImageFormat::k_LumA88, &ConvertToLumA88, 2, { 0, 0, 0 } };
+            const Conversion k_toLum8 = { ImageFormat::k_Lum8, &ConvertToLum8, 1, { 0, 0, 0 } };
+        }
+        
         //---------------------------------------------------
         //---------------------------------------------------
         void RGBA8888ToRGB888(Image* in_image)
         {
-            CS_ASSERT(in_image->GetFormat() == ImageFormat::k_RGBA8888 && in_image->GetCompression() == ImageCompression::k_none, "Cannot convert an image that is not in uncompressed RGBA8888 format.");
-            
-            ImageBuffer rawBuffer = RGBA8888ToRGB888(in_image->GetData(), in_image->GetDataSize());
-        
-            Image::Descriptor desc;
-            desc.m_width = in_image->GetWidth();
-            desc.m_height = in_image->GetHeight();
-            desc.m_dataSize = rawBuffer.m_size;
-            desc.m_compression = in_image->GetCompression();
-            desc.m_format = ImageFormat::k_RGB888;
-            in_image->Build(desc, std::move(rawBuffer.m_data));
+            ConvertImage(nullptr, k_toRGB888, in_image, Dithering::k_none);
         }
         //---------------------------------------------------
         //---------------------------------------------------
-        void RGBA8888ToRGBA4444(Image* in_image)
+        void RGBA8888ToRGBA4444(Image* in_image, Dithering in_dithering)
         {
-            CS_ASSERT(in_image->GetFormat() == ImageFormat::k_RGBA8888 && in_image->GetCompression() == ImageCompression::k_none, "Cannot convert an image that is not in uncompressed RGBA8888 format.");
-            
-            ImageBuffer rawBuffer = RGBA8888ToRGBA4444(in_image->GetData(), in_image->GetDataSize());
-
-            Image::Descriptor desc;
-            desc.m_width = in_image->GetWidth();
-            desc.m_height = in_image->GetHeight();
-            desc.m_dataSize = rawBuffer.m_size;
-            desc.m_compression = in_image->GetCompression();
-            desc.m_format = ImageFormat::k_RGBA4444;
-            in_image->Build(desc, std::move(rawBuffer.m_data));
+            ConvertImage(nullptr, k_toRGBA4444, in_image, in_dithering);
         }
         //---------------------------------------------------
         //---------------------------------------------------
-        void RGBA8888ToRGB565(Image* in_image)
+        void RGBA8888ToRGB565(Image* in_image, Dithering in_dithering)
         {
-            CS_ASSERT(in_image->GetFormat() == ImageFormat::k_RGBA8888 && in_image->GetCompression() == ImageCompression::k_none, "Cannot convert an image that is not in uncompressed RGBA8888 format.");
-            
-            ImageBuffer rawBuffer = RGBA8888ToRGB565(in_image->GetData(), in_image->GetDataSize());
-
-            Image::Descriptor desc;
-            desc.m_width = in_image->GetWidth();
-            desc.m_height = in_image->GetHeight();
-            desc.m_dataSize = rawBuffer.m_size;
-            desc.m_compression = in_image->GetCompression();
-            desc.m_format = ImageFormat::k_RGB565;
-            in_image->Build(desc, std::move(rawBuffer.m_data));
+            ConvertImage(nullptr, k_toRGB565, in_image, in_dithering);
         }
         //---------------------------------------------------
         //---------------------------------------------------
         void RGBA8888ToLumA88(Image* in_image)
         {
-            CS_ASSERT(in_image->GetFormat() == ImageFormat::k_RGBA8888 && in_image->GetCompression() == ImageCompression::k_none, "Cannot convert an image that is not in uncompressed RGBA8888 format.");
-            
-            ImageBuffer rawBuffer = RGBA8888ToLumA88(in_image->GetData(), in_image->GetDataSize());
-
-            Image::Descriptor desc;
-            desc.m_width = in_image->GetWidth();
-            desc.m_height = in_image->GetHeight();
-            desc.m_dataSize = rawBuffer.m_size;
-            desc.m_compression = in_image->GetCompression();
-            desc.m_format = ImageFormat::k_LumA88;
-            in_image->Build(desc, std::move(rawBuffer.m_data));
+            ConvertImage(nullptr, k_toLumA88, in_image, Dithering::k_none);
         }
         //---------------------------------------------------
         //---------------------------------------------------
         void RGBA8888ToLum8(Image* in_image)
         {
-            CS_ASSERT(in_image->GetFormat() == ImageFormat::k_RGBA8888 && in_image->GetCompression() == ImageCompression::k_none, "Cannot convert an image that is not in uncompressed RGBA8888 format.");
-            
-            ImageBuffer rawBuffer = RGBA8888ToLum8(in_image->GetData(), in_image->GetDataSize());
-
-            Image::Descriptor desc;
-            desc.m_width = in_image->GetWidth();
-            desc.m_height = in_image->GetHeight();
-            desc.m_dataSize = rawBuffer.m_size;
-            desc.m_compression = in_image->GetCompression();
-            desc.m_format = ImageFormat::k_Lum8;
-            in_image->Build(desc, std::move(rawBuffer.m_data));
+            ConvertImage(nullptr, k_toLum8, in_image, Dithering::k_none);
+        }
+        //---------------------------------------------------
+        //---------------------------------------------------
+        void RGBA8888ToRGB888(const TaskContext& in_taskContext, Image* in_image)
+        {
+            ConvertImage(&in_taskContext, k_toRGB888, in_image, Dithering::k_none);
+        }
+        //---------------------------------------------------
+        //---------------------------------------------------
+        void RGBA8888ToRGBA4444(const TaskContext& in_taskContext, Image* in_image, Dithering in_dithering)
+        {
+            ConvertImage(&in_taskContext, k_toRGBA4444, in_image, in_dithering);
+        }
+        //---------------------------------------------------
+        //---------------------------------------------------
+        void RGBA8888ToRGB565(const TaskContext& in_taskContext, Image* in_image, Dithering in_dithering)
+        {
+            ConvertImage(&in_taskContext, k_toRGB565, in_image, in_dithering);
+        }
+        //---------------------------------------------------
+        //---------------------------------------------------
+        void RGBA8888ToLumA88(const TaskContext& in_taskContext, Image* in_image)
+        {
+            ConvertImage(&in_taskContext, k_toLumA88, in_image, Dithering::k_none);
+        }
+        //---------------------------------------------------
+        //---------------------------------------------------
+        void RGBA8888ToLum8(const TaskContext& in_taskContext, Image* in_image)
+        {
+            ConvertImage(&in_taskContext, k_toLum8, in_image, Dithering::k_none);
+        }
+        //---------------------------------------------------
+        //---------------------------------------------------
+        ImageBuffer RGBA8888ToRGBA4444(const u8* in_imageData, u32 in_imageDataSize, u32 in_width, Dithering in_dithering)
+        {
+            return ConvertBuffer(nullptr, k_toRGBA4444, in_imageData, in_imageDataSize, in_width, in_dithering);
+        }
+        //---------------------------------------------------
+        //---------------------------------------------------
+        ImageBuffer RGBA8888ToRGB565(const u8* in_imageData, u32 in_imageDataSize, u32 in_width, Dithering in_dithering)
+        {
+            return ConvertBuffer(nullptr, k_toRGB565, in_imageData, in_imageDataSize, in_width, in_dithering);
         }
         //---------------------------------------------------
         //---------------------------------------------------
         ImageBuffer RGBA8888ToRGB888(const u8* in_imageData, u32 in_imageDataSize)
         {
-            CS_ASSERT(in_imageDataSize > 0 && in_imageDataSize % 4 == 0, "Invalid input image data size.");
-
-            struct PixelRGB888
-            {
-                u8 m_r;
-                u8 m_g;
-                u8 m_b;
-            };
-
-            const u32 k_outputBytesPerPixel = 3;
-            const u32 area = in_imageDataSize / 4;
-
-            ImageBuffer outputBuffer;
-            outputBuffer.m_size = area * k_outputBytesPerPixel;
-            outputBuffer.m_data = std::unique_ptr<u8[]>(new u8[outputBuffer.m_size]);
-
-            const ByteColour* pixel32 = reinterpret_cast<const ByteColour*>(in_imageData);
-            PixelRGB888* pixel24 = reinterpret_cast<PixelRGB888*>(outputBuffer.m_data.get());
-
-            for(u32 i = 0; i < area; ++i, ++pixel32, ++pixel24)
-            {
-                pixel24->m_r = pixel32->r;
-                pixel24->m_g = pixel32->g;
-                pixel24->m_b = pixel32->b;
-            }
-
-            return std::move(outputBuffer);
+            return ConvertBuffer(nullptr, k_toRGB888, in_imageData, in_imageDataSize, 0, Dithering::k_none);
         }
         //---------------------------------------------------
         //---------------------------------------------------
         ImageBuffer RGBA8888ToRGBA4444(const u8* in_imageData, u32 in_imageDataSize)
         {
-            CS_ASSERT(in_imageDataSize > 0 && in_imageDataSize % 4 == 0, "Invalid input image data size.");
-
-            const u32 k_outputBytesPerPixel = 2;
-            const u32 area = in_imageDataSize / 4;
-
-            ImageBuffer outputBuffer;
-            outputBuffer.m_size = area * k_outputBytesPerPixel;
-            outputBuffer.m_data = std::unique_ptr<u8[]>(new u8[outputBuffer.m_size]);
-
-            const u32* pixel32 = reinterpret_cast<const u32*>(in_imageData);
-            u16* pixel16 = reinterpret_cast<u16*>(outputBuffer.m_data.get());
-
-            for(u32 i = 0; i < area; ++i, ++pixel32, ++pixel16)
-            {
-                *pixel16 = ((((*pixel32 >> 0) & 0xFF) >> 4) << 12) | // R
-                    ((((*pixel32 >> 8) & 0xFF) >> 4) << 8) | // G
-                    ((((*pixel32 >> 16) & 0xFF) >> 4) << 4) | // B
-                    ((((*pixel32 >> 24) & 0xFF) >> 4) << 0); // A
-            }
-
-            return std::move(outputBuffer);
+            return ConvertBuffer(nullptr, k_toRGBA4444, in_imageData, in_imageDataSize, 0, Dithering::k_none);
         }
         //---------------------------------------------------
         //---------------------------------------------------
         ImageBuffer RGBA8888ToRGB565(const u8* in_imageData, u32 in_imageDataSize)
         {
-            CS_ASSERT(in_imageDataSize > 0 && in_imageDataSize % 4 == 0, "Invalid input image data size.");
-
-            const u32 k_outputBytesPerPixel = 2;
-            const u32 area = in_imageDataSize / 4;
-
-            ImageBuffer outputBuffer;
-            outputBuffer.m_size = area * k_outputBytesPerPixel;
-            outputBuffer.m_data = std::unique_ptr<u8[]>(new u8[outputBuffer.m_size]);
-
-            const u32* pixel32 = reinterpret_cast<const u32*>(in_imageData);
-            u16* pixel16 = reinterpret_cast<u16*>(outputBuffer.m_data.get());
-
-            for(u32 i = 0; i < area; ++i, ++pixel32, ++pixel16)
-            {
-                *pixel16 = ((((*pixel32 >> 0) & 0xFF) >> 3) << 11) |
-                    ((((*pixel32 >> 8) & 0xFF) >> 2) << 5) |
-                    ((((*pixel32 >> 16) & 0xFF) >> 3) << 0);
-            }
-
-            return std::move(outputBuffer);
+            return ConvertBuffer(nullptr, k_toRGB565, in_imageData, in_imageDataSize, 0, Dithering::k_none);
         }
         //---------------------------------------------------
         //---------------------------------------------------
         ImageBuffer RGBA8888ToLumA88(const u8* in_imageData, u32 in_imageDataSize)
         {
-            CS_ASSERT(in_imageDataSize > 0 && in_imageDataSize % 4 == 0, "Invalid input image data size.");
-
-            const u32 k_outputBytesPerPixel = 2;
-            const u32 area = in_imageDataSize / 4;
-
-            ImageBuffer outputBuffer;
-            outputBuffer.m_size = area * k_outputBytesPerPixel;
-            outputBuffer.m_data = std::unique_ptr<u8[]>(new u8[outputBuffer.m_size]);
-
-            const u32* pixel32 = reinterpret_cast<const u32*>(in_imageData);
-            u16* pixel16 = reinterpret_cast<u16*>(outputBuffer.m_data.get());
-
-            for(u32 i = 0; i < area; ++i, ++pixel32, ++pixel16)
-            {
-                *pixel16 = ((*pixel32) & 0xFF) | // L
-                    ((*pixel32 >> 16) & 0xFF00); // A
-            }
-
-            return std::move(outputBuffer);
+            return ConvertBuffer(nullptr, k_toLumA88, in_imageData, in_imageDataSize, 0, Dithering::k_none);
         }
         //---------------------------------------------------
         //---------------------------------------------------
         ImageBuffer RGBA8888ToLum8(const u8* in_imageData, u32 in_imageDataSize)
         {
-            CS_ASSERT(in_imageDataSize > 0 && in_imageDataSize % 4 == 0, "Invalid input image data size.");
-
-            const u32 k_outputBytesPerPixel = 1;
-            const u32 area = in_imageDataSize / 4;
-
-            ImageBuffer outputBuffer;
-            outputBuffer.m_size = area * k_outputBytesPerPixel;
-            outputBuffer.m_data = std::unique_ptr<u8[]>(new u8[outputBuffer.m_size]);
-
-            const u32* pixel32 = reinterpret_cast<const u32*>(in_imageData);
-            u8* pixel8 = outputBuffer.m_data.get();
-
-            for(u32 i = 0; i < area; ++i, ++pixel32, ++pixel8)
-            {
-                *pixel8 = ((*pixel32)& 0xFF);
-            }
-
-            return std::move(outputBuffer);
+            return ConvertBuffer(nullptr, k_toLum8, in_imageData, in_imageDataSize, 0, Dithering::k_none);
         }
     }
 }
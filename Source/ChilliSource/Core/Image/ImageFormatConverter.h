@@ -54,6 +54,19 @@ namespace ChilliSource
             u32 m_size = 0;
         };
         //---------------------------------------------------
+        /// The dithering that should be applied when
+        /// reducing the colour depth of an image to one of
+        /// the 16-bit formats. Ordered dithering uses a 4x4
+        /// Bayer matrix to break up the banding that simple
+        /// truncation produces in gradients. Alpha is never
+        /// dithered.
+        //---------------------------------------------------
+        enum class Dithering
+        {
+            k_none,
+            k_ordered
+        };
+        //---------------------------------------------------
         /// Converts an Image in format RGBA8888 to RGB888
         /// format. This will allocate a new buffer for the
         /// target format data and release the previous
@@ -73,8 +86,10 @@ namespace ChilliSource
         /// @author Ian Copland
         ///
         /// @param A pointer to the image to convert.
+        /// @param [Optional] The dithering to apply. Defaults
+        /// to none.
         //---------------------------------------------------
-        void RGBA8888ToRGBA4444(Image* in_image);
+        void RGBA8888ToRGBA4444(Image* in_image, Dithering in_dithering = Dithering::k_none);
         //---------------------------------------------------
         /// Converts an Image in format RGBA8888 to RGB565
         /// format. This will allocate a new buffer for the
@@ -84,8 +99,10 @@ namespace ChilliSource
         /// @author Ian Copland
         ///
         /// @param A pointer to the image to convert.
+        /// @param [Optional] The dithering to apply. Defaults
+        /// to none.
         //---------------------------------------------------
-        void RGBA8888ToRGB565(Image* in_image);
+        void RGBA8888ToRGB565(Image* in_image, Dithering in_dithering = Dithering::k_none);
         //---------------------------------------------------
         /// Converts an Image in format RGBA8888 to LumA88
         /// format. This will allocate a new buffer for the
@@ -109,6 +126,91 @@ namespace ChilliSource
         //---------------------------------------------------
         void RGBA8888ToLum8(Image* in_image);
         //---------------------------------------------------
+        /// Converts an Image in format RGBA8888 to RGB888
+        /// format. Large images are split into row chunks
+        /// which are converted as child tasks of the given
+        /// task context.
+        ///
+        /// @param The context of the task performing the
+        /// conversion.
+        /// @param A pointer to the image to convert.
+        //---------------------------------------------------
+        void RGBA8888ToRGB888(const TaskContext& in_taskContext, Image* in_image);
+        //---------------------------------------------------
+        /// Converts an Image in format RGBA8888 to RGBA4444
+        /// format. Large images are split into row chunks
+        /// which are converted as child tasks of the given
+        /// task context.
+        ///
+        /// @param The context of the task performing the
+        /// conversion.
+        /// @param A pointer to the image to convert.
+        /// @param [Optional] The dithering to apply. Defaults
+        /// to none.
+        //---------------------------------------------------
+        void RGBA8888ToRGBA4444(const TaskContext& in_taskContext, Image* in_image, Dithering in_dithering = Dithering::k_none);
+        //---------------------------------------------------
+        /// Converts an Image in format RGBA8888 to RGB565
+        /// format. Large images are split into row chunks
+        /// which are converted as child tasks of the given
+        /// task context.
+        ///
+        /// @param The context of the task performing the
+        /// conversion.
+        /// @param A pointer to the image to convert.
+        /// @param [Optional] The dithering to apply. Defaults
+        /// to none.
+        //---------------------------------------------------
+        void RGBA8888ToRGB565(const TaskContext& in_taskContext, Image* in_image, Dithering in_dithering = Dithering::k_none);
+        //---------------------------------------------------
+        /// Converts an Image in format RGBA8888 to LumA88
+        /// format. Large images are split into row chunks
+        /// which are converted as child tasks of the given
+        /// task context.
+        ///
+        /// @param The context of the task performing the
+        /// conversion.
+        /// @param A pointer to the image to convert.
+        //---------------------------------------------------
+        void RGBA8888ToLumA88(const TaskContext& in_taskContext, Image* in_image);
+        //---------------------------------------------------
+        /// Converts an Image in format RGBA8888 to Lum8
+        /// format. Large images are split into row chunks
+        /// which are converted as child tasks of the given
+        /// task context.
+        ///
+        /// @param The context of the task performing the
+        /// conversion.
+        /// @param A pointer to the image to convert.
+        //---------------------------------------------------
+        void RGBA8888ToLum8(const TaskContext& in_taskContext, Image* in_image);
+        //---------------------------------------------------
+        /// Creates new RGBA4444 image data from RGBA8888 image
+        /// data, applying the requested dithering.
+        ///
+        /// @param The input RGBA8888 image data buffer.
+        /// @param The size of the RGBA8888 image data buffer.
+        /// @param The width of the image in pixels. This is
+        /// needed to position the dither pattern.
+        /// @param The dithering to apply.
+        ///
+        /// @return The output RGBA4444 image data.
+        //---------------------------------------------------
+        ImageBuffer RGBA8888ToRGBA4444(const u8* in_imageData, u32 in_imageDataSize, u32 in_width, Dithering in_dithering);
+        //---------------------------------------------------
+        /// Creates new RGB565 image data from RGBA8888 image
+        /// data, applying the requested dithering.
+        ///
+        /// @param The input RGBA8888 image data buffer.
+        /// @param The size of the RGBA8888 image data buffer.
+        /// @param The width of the image in pixels. This is
+        /// needed to position the dither pattern.
+        /// @param The dithering to apply.
+        ///
+        /// @return The output RGB565 image data.
+        //---------------------------------------------------
+        ImageBuffer RGBA8888ToRGB565(const u8* in_imageData, u32 in_imageDataSize, u32 in_width, Dithering in_dithering);
+        //---------------------------------------------------
         /// Creates new RGB888 image data from RGBA8888 image
         /// data.
         ///
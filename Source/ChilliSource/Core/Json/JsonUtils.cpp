@@ -29,15 +29,197 @@
 #include <ChilliSource/Core/Json/JsonUtils.h>
 
 #include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Base/ByteBuffer.h>
 #include <ChilliSource/Core/File/FileSystem.h>
-
+#include <ChilliSource/Core/File/FileStream/IBinaryInputStream.h>
 
 #include <json/json.h>
 
+#include <cstring>
+
 namespace ChilliSource
 {
     namespace JsonUtils
     {
+        namespace
+        {
+            const u8 k_binaryJsonMagic[] = { 'C', 'S', 'B', 'J' };
+            const u32 k_binaryJsonVersion = 1;
+            
+            //---------------------------------------------------------------
+            /// The type tags used in binary json. These must match those
+            /// in compile_json.py.
+            //---------------------------------------------------------------
+            enum class BinaryJsonType : u8
+            {
+                k_null,
+                k_false,
+                k_true,
+                k_int,
+                k_uint,
+                k_double,
+                k_string,
+                k_array,
+                k_object
+            };
+            //---------------------------------------------------------------
+            /// Reads a value of the given type from the binary json data,
+            /// advancing the read position.
+            ///
+            /// @param [In/Out] The current read position.
+            /// @param The end of the data.
+            /// @param [Out] The value read.
+            ///
+            /// @return Whether or not there was enough data to read the
+            /// value.
+            //---------------------------------------------------------------
+            template <typename TType> bool ReadBinaryValue(const u8*& io_data, const u8* in_dataEnd, TType& out_value)
+            {
+                if (u64(in_dataEnd - io_data) < sizeof(TType))
+                {
+                    return false;
+                }
+                
+                std::memcpy(&out_value, io_data, sizeof(TType));
+                io_data += sizeof(TType);
+                return true;
+            }
+            //---------------------------------------------------------------
+            /// Reads a length prefixed string from the binary json data,
+            /// advancing the read position.
+            ///
+            /// @param [In/Out] The current read position.
+            /// @param The end of the data.
+            /// @param [Out] The string read.
+            ///
+            /// @return Whether or not there was enough data to read the
+            /// string.
+            //---------------------------------------------------------------
+            bool ReadBinaryString(const u8*& io_data, const u8* in_dataEnd, std::string& out_string)
+            {
+                u32 length = 0;
+                if (ReadBinaryValue(io_data, in_dataEnd, length) == false || u64(in_dataEnd - io_data) < length)
+                {
+                    return false;
+                }
+                
+                out_string.assign(reinterpret_cast<const char*>(io_data), length);
+                io_data += length;
+                return true;
+            }
+            //---------------------------------------------------------------
+            /// Recursively reads a json value from the binary json data,
+            /// advancing the read position.
+            ///
+            /// @param [In/Out] The current read position.
+            /// @param The end of the data.
+            /// @param [Out] The json value read.
+            ///
+            /// @return Whether or not the value could be read.
+            //---------------------------------------------------------------
+            bool ReadBinaryJsonValue(const u8*& io_data, const u8* in_dataEnd, Json::Value& out_value)
+            {
+                u8 type = 0;
+                if (ReadBinaryValue(io_data, in_dataEnd, type) == false)
+                {
+                    return false;
+                }
+                
+                switch (BinaryJsonType(type))
+                {
+                    case BinaryJsonType::k_null:
+                        out_value = Json::Value(Json::nullValue);
+                        return true;
+                    case BinaryJsonType::k_false:
+                        out_value = Json::Value(false);
+                        return true;
+                    case BinaryJsonType::k_true:
+                        out_value = Json::Value(true);
+                        return true;
+                    case BinaryJsonType::k_int:
+                    {
+                        s32 value = 0;
+                        if (ReadBinaryValue(io_data, in_dataEnd, value) == false)
+                        {
+                            return false;
+                        }
+                        out_value = Json::Value(Json::Int(value));
+                        return true;
+                    }
+                    case BinaryJsonType::k_uint:
+                    {
+                        u32 value = 0;
+                        if (ReadBinaryValue(io_data, in_dataEnd, value) == false)
+                        {
+                            return false;
+                        }
+                        out_value = Json::Value(Json::UInt(value));
+                        return true;
+                    }
+                    case BinaryJsonType::k_double:
+                    {
+                        f64 value = 0.0;
+                        if (ReadBinaryValue(io_data, in_dataEnd, value) == false)
+                        {
+                            return false;
+                        }
+                        out_value = Json::Value(value);
+                        return true;
+                    }
+                    case BinaryJsonType::k_string:
+                    {
+                        std::string value;
+                        if (ReadBinaryString(io_data, in_dataEnd, value) == false)
+                        {
+                            return false;
+                        }
+                        out_value = Json::Value(value);
+                        return true;
+                    }
+                    case BinaryJsonType::k_array:
+                    {
+                        u32 count = 0;
+                        if (ReadBinaryValue(io_data, in_dataEnd, count) == false)
+                        {
+                            return false;
+                        }
+                        
+                        out_value = Json::Value(Json::arrayValue);
+                        out_value.resize(count);
+                        for (u32 i = 0; i < count; ++i)
+                        {
+                            if (ReadBinaryJsonValue(io_data, in_dataEnd, out_value[i]) == false)
+                            {
+                                return false;
+                            }
+                        }
+                        return true;
+                    }
+                    case BinaryJsonType::k_object:
+                    {
+                        u32 count = 0;
+                        if (ReadBinaryValue(io_data, in_dataEnd, count) == false)
+                        {
+                            return false;
+                        }
+                        
+                        out_value = Json::Value(Json::objectValue);
+                        std::string key;
+                        for (u32 i = 0; i < count; ++i)
+                        {
+                            if (ReadBinaryString(io_data, in_dataEnd, key) == false || ReadBinaryJsonValue(io_data, in_dataEnd, out_value[key]) == false)
+                            {
+                                return false;
+                            }
+                        }
+                        return true;
+                    }
+                }
+                
+                return false;
+            }
+        }
+        
         //---------------------------------------------------------------
         //---------------------------------------------------------------
         Json::Value ParseJson(const std::string& in_jsonString)
@@ -83,6 +265,63 @@ namespace ChilliSource
                 CS_LOG_FATAL("Could not parse json file: " + in_filePath);
             }
             
+            return true;
+        }
+        //---------------------------------------------------------------
+        //---------------------------------------------------------------
+        Json::Value ParseBinaryJson(const u8* in_data, u64 in_dataSize)
+        {
+            const u8* data = in_data;
+            const u8* dataEnd = in_data + in_dataSize;
+            
+            u32 version = 0;
+            if (in_dataSize < sizeof(k_binaryJsonMagic) || std::memcmp(data, k_binaryJsonMagic, sizeof(k_binaryJsonMagic)) != 0)
+            {
+                CS_LOG_FATAL("Could not parse binary json: data is not binary json.");
+            }
+            data += sizeof(k_binaryJsonMagic);
+            
+            if (ReadBinaryValue(data, dataEnd, version) == false || version != k_binaryJsonVersion)
+            {
+                CS_LOG_FATAL("Could not parse binary json: unsupported version.");
+            }
+            
+            Json::Value output;
+            if (ReadBinaryJsonValue(data, dataEnd, output) == false || data != dataEnd)
+            {
+                CS_LOG_FATAL("Could not parse binary json: data is malformed.");
+            }
+            
+            return output;
+        }
+        //---------------------------------------------------------------
+        //---------------------------------------------------------------
+        bool ReadBinaryJson(StorageLocation in_storageLocation, const std::string& in_filePath, Json::Value& out_jsonValue)
+        {
+            auto fileStream = Application::Get()->GetFileSystem()->CreateBinaryInputStream(in_storageLocation, in_filePath);
+            
+            if (fileStream == nullptr)
+            {
+                CS_LOG_ERROR("Could not open binary json file: " + in_filePath);
+                return false;
+            }
+            
+            auto fileContents = fileStream->ReadAll();
+            fileStream.reset();
+            
+            if (fileContents == nullptr)
+            {
+                CS_LOG_ERROR("Could not read binary json file: " + in_filePath);
+                return false;
+            }
+            
+            out_jsonValue = ParseBinaryJson(fileContents->GetData(), fileContents->GetLength());
+            
+            if (out_jsonValue.isNull())
+            {
+                CS_LOG_FATAL("Could not parse binary json file: " + in_filePath);
+            }
+            
             return true;
         }
     }
@@ -71,6 +71,35 @@ namespace ChilliSource
         /// @return The new json object.
         //---------------------------------------------------------------
         bool ReadJson(StorageLocation in_storageLocation, const std::string& in_filePath, Json::Value& out_jsonValue);
+        //---------------------------------------------------------------
+        /// Creates a new Json object from the given binary encoded json.
+        /// Binary json contains exactly the same data as the equivalent
+        /// json text, but can be read without any text parsing. It can
+        /// be produced from json text files using the compile_json.py
+        /// script in Tools/Scripts. If the data is not valid binary
+        /// json the app is considered to be in an irrecoverable state
+        /// and will terminate.
+        ///
+        /// @param The binary json data.
+        /// @param The size of the data in bytes.
+        ///
+        /// @return The new json object.
+        //---------------------------------------------------------------
+        Json::Value ParseBinaryJson(const u8* in_data, u64 in_dataSize);
+        //---------------------------------------------------------------
+        /// Creates a new Json object from the contents of the binary
+        /// json file at the given path. If the file cannot be read this
+        /// will return false, but if the file can be read but it is not
+        /// valid binary json the app is considered to be in an
+        /// irrecoverable state and will terminate.
+        ///
+        /// @param The storage location of the file.
+        /// @param The file path.
+        /// @param [Out] The new json object.
+        ///
+        /// @return Whether or not the file could be read.
+        //---------------------------------------------------------------
+        bool ReadBinaryJson(StorageLocation in_storageLocation, const std::string& in_filePath, Json::Value& out_jsonValue);
     }
 }
 
@@ -615,14 +615,14 @@ namespace ChilliSource
     //-----------------------------------------------------
     template <typename TType> TType& GenericMatrix3<TType>::operator()(u32 in_row, u32 in_column)
     {
-        CS_ASSERT(in_row >= 0 && in_row < 3 && in_column >= 0 && in_column < 3, "Trying to access matrix value at [" + ToString(in_row) + ", " + ToString(in_column) + "]");
+        CS_ASSERT(in_row < 3 && in_column < 3, "Trying to access matrix value at [" + ToString(in_row) + ", " + ToString(in_column) + "]");
         return m[in_column + in_row * 3];
     }
     //-----------------------------------------------------
     //-----------------------------------------------------
     template <typename TType> TType GenericMatrix3<TType>::operator()(u32 in_row, u32 in_column) const
     {
-        CS_ASSERT(in_row >= 0 && in_row < 3 && in_column >= 0 && in_column < 3, "Trying to access matrix value at [" + ToString(in_row) + ", " + ToString(in_column) + "]");
+        CS_ASSERT(in_row < 3 && in_column < 3, "Trying to access matrix value at [" + ToString(in_row) + ", " + ToString(in_column) + "]");
         return m[in_column + in_row * 3];
     }
     //------------------------------------------------------
@@ -85,9 +85,6 @@ namespace ChilliSource
         //---------------------------------
         // Operators
         //---------------------------------
-        UnifiedVector2& operator=(const UnifiedVector2 &Vec)
-        {this->vRelative = Vec.vRelative; this->vAbsolute = Vec.vAbsolute; return *this;}
-
         UnifiedVector2 operator+(const UnifiedVector2 &Vec) const
         {UnifiedVector2 Result; Result.vRelative = this->vRelative + Vec.vRelative; Result.vAbsolute = this->vAbsolute + Vec.vAbsolute; return Result;}
         
@@ -55,6 +55,12 @@ namespace ChilliSource
     }
     //-------------------------------------------------------
     //-------------------------------------------------------
+    u64 Resource::GetMemoryUsage() const
+    {
+        return 0;
+    }
+    //-------------------------------------------------------
+    //-------------------------------------------------------
     void Resource::SetFilePath(const std::string& in_filePath)
     {
         m_filePath = in_filePath;
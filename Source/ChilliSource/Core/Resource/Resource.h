@@ -132,6 +132,16 @@ namespace ChilliSource
         //-------------------------------------------------------
         LoadState GetLoadState() const;
         //-------------------------------------------------------
+        /// Used by the resource pool to account for the memory
+        /// used by each type of resource. Resources which own
+        /// significant amounts of memory, such as textures and
+        /// meshes, override this.
+        ///
+        /// @return An estimate of the memory, in bytes, used by
+        /// the resource including any memory held by the GPU.
+        //-------------------------------------------------------
+        virtual u64 GetMemoryUsage() const;
+        //-------------------------------------------------------
         /// Virtual desctructor
         ///
         /// @author S Downie
@@ -198,6 +208,7 @@ namespace ChilliSource
         std::string m_filePath;
         std::string m_name;
         StorageLocation m_location;
+        u32 m_lastUsedFrame = 0;
         ResourceId m_id;
     
         std::atomic<LoadState> m_loadState;
@@ -30,6 +30,8 @@
 
 #include <ChilliSource/Core/Resource/ResourceProvider.h>
 
+#include <algorithm>
+
 namespace ChilliSource
 {
     CS_DEFINE_NAMEDTYPE(ResourcePool);
@@ -172,6 +174,112 @@ namespace ChilliSource
         }
     }
     //------------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------------
+    void ResourcePool::SetMemoryBudget(InterfaceIDType in_resourceType, u64 in_budget)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        //The descriptor may not exist yet if the budget is set before any resources of the type are created.
+        m_descriptors[in_resourceType].m_memoryBudget = in_budget;
+    }
+    //------------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------------
+    u64 ResourcePool::GetMemoryBudget(InterfaceIDType in_resourceType) const
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        auto itDescriptor = m_descriptors.find(in_resourceType);
+        if(itDescriptor == m_descriptors.end())
+        {
+            return 0;
+        }
+        
+        return itDescriptor->second.m_memoryBudget;
+    }
+    //------------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------------
+    u64 ResourcePool::GetMemoryUsage(InterfaceIDType in_resourceType) const
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        auto itDescriptor = m_descriptors.find(in_resourceType);
+        if(itDescriptor == m_descriptors.end())
+        {
+            return 0;
+        }
+        
+        u64 memoryUsage = 0;
+        for(const auto& resourceEntry : itDescriptor->second.m_cachedResources)
+        {
+            memoryUsage += resourceEntry.second->GetMemoryUsage();
+        }
+        
+        return memoryUsage;
+    }
+    //------------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------------
+    void ResourcePool::OnUpdate(f32)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        ++m_frameIndex;
+        
+        for(auto& descEntry : m_descriptors)
+        {
+            if(descEntry.second.m_memoryBudget > 0)
+            {
+                EnforceMemoryBudget(descEntry.second);
+            }
+        }
+    }
+    //------------------------------------------------------------------------------------
+    /// Only resources which are solely owned by the pool and have finished loading can be
+    /// released. Resources that are still in use are stamped with the current frame, so
+    /// the unused resources that were in use least recently are released first.
+    //------------------------------------------------------------------------------------
+    void ResourcePool::EnforceMemoryBudget(PoolDesc& in_desc)
+    {
+        u64 memoryUsage = 0;
+        std::vector<std::pair<u32, Resource::ResourceId>> releasable;
+        
+        for(auto& resourceEntry : in_desc.m_cachedResources)
+        {
+            Resource* resource = resourceEntry.second.get();
+            memoryUsage += resource->GetMemoryUsage();
+            
+            if(resourceEntry.second.use_count() > 1 || resource->m_lastUsedFrame == 0)
+            {
+                resource->m_lastUsedFrame = m_frameIndex;
+            }
+            else if(resource->GetLoadState() != Resource::LoadState::k_loading)
+            {
+                releasable.push_back(std::make_pair(resource->m_lastUsedFrame, resourceEntry.first));
+            }
+        }
+        
+        if(memoryUsage <= in_desc.m_memoryBudget)
+        {
+            return;
+        }
+        
+        std::sort(releasable.begin(), releasable.end());
+        
+        for(const auto& entry : releasable)
+        {
+            if(memoryUsage <= in_desc.m_memoryBudget)
+            {
+                break;
+            }
+            
+            auto itResource = in_desc.m_cachedResources.find(entry.second);
+            CS_ASSERT(itResource != in_desc.m_cachedResources.end(), "Releasable resource must be cached.");
+            
+            memoryUsage -= itResource->second->GetMemoryUsage();
+            CS_LOG_VERBOSE("Releasing resource from pool to meet memory budget " + itResource->second->GetName());
+            in_desc.m_cachedResources.erase(itResource);
+        }
+    }
+    //------------------------------------------------------------------------------------
     /// At this stage in the app lifecycle all app and system references to resource
     /// should have been released. If the resource pool still has resources then this
     /// indicated leaks.
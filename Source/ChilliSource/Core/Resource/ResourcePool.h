@@ -243,6 +243,33 @@ namespace ChilliSource
         /// @param Resource to release
         //-------------------------------------------------------------------------------------
         void Release(const Resource* in_resource);
+        //-------------------------------------------------------------------------------------
+        /// Sets the memory budget for resources of the given type. Once per update the pool
+        /// totals the memory used by the cached resources of the type and, if the budget is
+        /// exceeded, releases unused resources, least recently used first, until it is back
+        /// under budget. Resources that are still in use are never released so the budget
+        /// can still be exceeded. A budget of zero, the default, disables this.
+        ///
+        /// @param The budget in bytes.
+        //-------------------------------------------------------------------------------------
+        template <typename TResourceType> void SetMemoryBudget(u64 in_budget);
+        //-------------------------------------------------------------------------------------
+        /// @return The memory budget for resources of the given type in bytes, or zero if
+        /// there is no budget.
+        //-------------------------------------------------------------------------------------
+        template <typename TResourceType> u64 GetMemoryBudget() const;
+        //-------------------------------------------------------------------------------------
+        /// @return An estimate of the memory, in bytes, used by all cached resources of the
+        /// given type, including those that are no longer in use.
+        //-------------------------------------------------------------------------------------
+        template <typename TResourceType> u64 GetMemoryUsage() const;
+        //------------------------------------------------------------------------------------
+        /// Called every frame. Releases unused resources of any type that is over its
+        /// memory budget.
+        ///
+        /// @param Time since last update in seconds
+        //------------------------------------------------------------------------------------
+        void OnUpdate(f32 in_deltaTime) override;
         //------------------------------------------------------------------------------------
         /// Called when the system is destroyed after the system lifecycle destroy.
         /// Flushes the resource caches and errors if any resources are still in use
@@ -262,6 +289,7 @@ namespace ChilliSource
         {
             std::vector<ResourceProvider*> m_providers;
             std::unordered_map<Resource::ResourceId, ResourceSPtr> m_cachedResources;
+            u64 m_memoryBudget = 0;
         };
         //------------------------------------------------------------------------------------
         /// @author S Downie
@@ -290,14 +318,58 @@ namespace ChilliSource
         /// @return Unique ID based on the location and path
         //------------------------------------------------------------------------------------
         Resource::ResourceId GenerateResourceId(const std::string& in_uniqueId) const;
+        //------------------------------------------------------------------------------------
+        /// @param Interface ID of the resource type
+        /// @param The budget in bytes, or zero for no budget.
+        //------------------------------------------------------------------------------------
+        void SetMemoryBudget(InterfaceIDType in_resourceType, u64 in_budget);
+        //------------------------------------------------------------------------------------
+        /// @param Interface ID of the resource type
+        ///
+        /// @return The budget in bytes, or zero if there is no budget.
+        //------------------------------------------------------------------------------------
+        u64 GetMemoryBudget(InterfaceIDType in_resourceType) const;
+        //------------------------------------------------------------------------------------
+        /// @param Interface ID of the resource type
+        ///
+        /// @return The memory used by all cached resources of the type in bytes.
+        //------------------------------------------------------------------------------------
+        u64 GetMemoryUsage(InterfaceIDType in_resourceType) const;
+        //------------------------------------------------------------------------------------
+        /// Marks the resources in the descriptor which are still in use as used this frame
+        /// and, if the descriptor is over budget, releases the least recently used unused
+        /// resources until it is back under budget. The mutex must be locked.
+        ///
+        /// @param Descriptor
+        //------------------------------------------------------------------------------------
+        void EnforceMemoryBudget(PoolDesc& in_desc);
         
     private:
         
         std::unordered_map<InterfaceIDType, PoolDesc> m_descriptors;
         mutable std::mutex m_mutex;
+        u32 m_frameIndex = 0;
     };
     //------------------------------------------------------------------------------------
     //-------------------------------------------------------------------------------------
+    template <typename TResourceType> void ResourcePool::SetMemoryBudget(u64 in_budget)
+    {
+        SetMemoryBudget(TResourceType::InterfaceID, in_budget);
+    }
+    //------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------
+    template <typename TResourceType> u64 ResourcePool::GetMemoryBudget() const
+    {
+        return GetMemoryBudget(TResourceType::InterfaceID);
+    }
+    //------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------
+    template <typename TResourceType> u64 ResourcePool::GetMemoryUsage() const
+    {
+        return GetMemoryUsage(TResourceType::InterfaceID);
+    }
+    //------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------
     template <typename TResourceType> std::shared_ptr<const TResourceType> ResourcePool::GetResource(const std::string& in_uniqueId) const
     {
         CS_ASSERT(in_uniqueId.empty() == false, "Cannot find resource with empty unique Id");
@@ -307,7 +307,7 @@ namespace ChilliSource
         ///
         /// @param Time since last update (Secs)
         //-----------------------------------------
-        virtual void OnUpdate(f32 in_deltaTime){};
+        virtual void OnUpdate(f32){};
         //-----------------------------------------
         /// Triggered each update loop at a fixed
         /// interval while the state is the active
@@ -317,7 +317,7 @@ namespace ChilliSource
         ///
         /// @param Fixed time since last update (Secs)
         //-----------------------------------------
-        virtual void OnFixedUpdate(f32 in_deltaTime){};
+        virtual void OnFixedUpdate(f32){};
         
         /// The render snapshot event can be implemented by a state to allow it to
         /// snapshot any data which pertains to the renderer.
@@ -331,7 +331,7 @@ namespace ChilliSource
         /// @param frameAllocator
         ///     Use this to allocate any memory required for this frame
         ///
-        virtual void OnRenderSnapshot(TargetType targetType, class RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) noexcept {};
+        virtual void OnRenderSnapshot(TargetType, class RenderSnapshot&, IAllocator*) noexcept {};
         
         //-----------------------------------------
         /// Triggered when a state is the
@@ -0,0 +1,178 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/String/InternedString.h>
+
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+namespace ChilliSource
+{
+    namespace
+    {
+        /// The number of interned strings beyond which the table is assumed to be growing with
+        /// strings built at runtime. A warning is logged when the table reaches this size, and
+        /// again each time it doubles.
+        ///
+        constexpr u32 k_warningNumEntries = 16384;
+        
+        /// The global intern table. Entries are held in a deque so that their addresses are
+        /// stable as the table grows, and are never removed.
+        ///
+        class InternTable final
+        {
+        public:
+            /// @param string
+            ///     The string to look up.
+            /// @param isAddAllowed
+            ///     Whether or not the string should be added to the table if it doesn't exist.
+            ///
+            /// @return The entry for the string, or null if it doesn't exist and wasn't added.
+            ///
+            const InternedString::Entry* Find(const std::string& string, bool isAddAllowed) noexcept
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                
+                auto it = m_lookup.find(string);
+                if (it != m_lookup.end())
+                {
+                    return it->second;
+                }
+                
+                if (!isAddAllowed)
+                {
+                    return nullptr;
+                }
+                
+                CS_ASSERT(m_entries.size() < std::numeric_limits<u32>::max(), "Too many interned strings.");
+                
+                InternedString::Entry entry;
+                entry.m_string = string;
+                entry.m_hash = InternedString::CalculateHash(string);
+                entry.m_id = u32(m_entries.size()) + 1;
+                m_entries.push_back(std::move(entry));
+                
+                const auto* output = &m_entries.back();
+                m_lookup.emplace(output->m_string, output);
+                
+                u32 numEntries = u32(m_entries.size());
+                if (numEntries >= k_warningNumEntries && (numEntries & (numEntries - 1)) == 0)
+                {
+                    CS_LOG_WARNING_FMT("%u strings have been interned. Only static identifiers should be interned, as interned strings are never freed. The latest is '%s'.", numEntries, output->m_string.c_str());
+                }
+                
+                return output;
+            }
+            
+            /// @return The number of entries in the table.
+            ///
+            u32 GetNumEntries() noexcept
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                return u32(m_entries.size());
+            }
+            
+        private:
+            std::mutex m_mutex;
+            std::deque<InternedString::Entry> m_entries;
+            std::unordered_map<std::string, const InternedString::Entry*> m_lookup;
+        };
+        
+        /// @return The global intern table, which is created on first use so that strings can
+        ///     be interned during static initialisation.
+        ///
+        InternTable& GetInternTable() noexcept
+        {
+            static InternTable s_internTable;
+            return s_internTable;
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    InternedString::InternedString(const std::string& string) noexcept
+    {
+        if (string.empty() == false)
+        {
+            m_entry = GetInternTable().Find(string, true);
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    bool InternedString::TryGet(const std::string& string, InternedString& out_internedString) noexcept
+    {
+        if (string.empty() == true)
+        {
+            out_internedString = InternedString();
+            return true;
+        }
+        
+        auto entry = GetInternTable().Find(string, false);
+        if (entry == nullptr)
+        {
+            return false;
+        }
+        
+        out_internedString.m_entry = entry;
+        return true;
+    }
+    
+    //------------------------------------------------------------------------------
+    std::size_t InternedString::CalculateHash(const std::string& string) noexcept
+    {
+#if defined(CS_INTERNEDSTRING_HASH_MASK)
+        //Used by the tests to force hash collisions between strings.
+        return std::hash<std::string>()(string) & std::size_t(CS_INTERNEDSTRING_HASH_MASK);
+#else
+        return std::hash<std::string>()(string);
+#endif
+    }
+    
+    //------------------------------------------------------------------------------
+    u32 InternedString::GetNumInternedStrings() noexcept
+    {
+        return GetInternTable().GetNumEntries();
+    }
+    
+    //------------------------------------------------------------------------------
+    u32 InternedString::GetId() const noexcept
+    {
+        return (m_entry != nullptr) ? m_entry->m_id : 0;
+    }
+    
+    //------------------------------------------------------------------------------
+    std::size_t InternedString::GetHash() const noexcept
+    {
+        static const std::size_t s_emptyHash = CalculateHash(std::string());
+        return (m_entry != nullptr) ? m_entry->m_hash : s_emptyHash;
+    }
+    
+    //------------------------------------------------------------------------------
+    const std::string& InternedString::GetString() const noexcept
+    {
+        static const std::string s_emptyString;
+        return (m_entry != nullptr) ? m_entry->m_string : s_emptyString;
+    }
+}
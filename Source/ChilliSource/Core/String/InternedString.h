@@ -0,0 +1,146 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_CORE_STRING_INTERNEDSTRING_H_
+#define _CHILLISOURCE_CORE_STRING_INTERNEDSTRING_H_
+
+#include <ChilliSource/ChilliSource.h>
+
+#include <functional>
+#include <string>
+
+namespace ChilliSource
+{
+    /// A handle to a string stored in a global intern table. Each distinct string is stored
+    /// once, along with a stable integer id and a precomputed hash, so interned strings can be
+    /// copied, compared and hashed at the cost of a pointer rather than the string contents.
+    ///
+    /// Interning a string takes a lock on the table and hashes the string, so it is intended for
+    /// keys drawn from a fixed vocabulary, such as property names, which are interned once and
+    /// then compared many times.
+    ///
+    /// Interned strings are never freed, so only static identifiers should be interned. Strings
+    /// built at runtime, such as user input, file contents or formatted values, must not be, as
+    /// the table would grow for as long as the application runs. TryGet() and CalculateHash() can
+    /// be used to look such strings up without adding them. A warning is logged each time the
+    /// table doubles in size beyond the number of strings a fixed vocabulary is expected to need.
+    ///
+    /// The default constructed interned string is the empty string, which always has an id
+    /// of 0. Ids are only stable for the lifetime of the application, and should not be
+    /// serialised.
+    ///
+    /// This is thread-safe.
+    ///
+    class InternedString final
+    {
+    public:
+        /// Creates an interned empty string.
+        ///
+        InternedString() = default;
+        
+        /// Interns the given string, adding it to the intern table if it hasn't been seen before.
+        ///
+        /// @param string
+        ///     The string to intern.
+        ///
+        explicit InternedString(const std::string& string) noexcept;
+        
+        /// Looks up the given string in the intern table without adding it.
+        ///
+        /// @param string
+        ///     The string to look up.
+        /// @param out_internedString
+        ///     (Out) The interned string, if it exists.
+        ///
+        /// @return Whether or not the string has previously been interned.
+        ///
+        static bool TryGet(const std::string& string, InternedString& out_internedString) noexcept;
+        
+        /// Calculates the hash of the given string. This is the same hash which is precomputed for
+        /// interned strings, so can be used to find an interned string in a container keyed on
+        /// its hash without interning the search string.
+        ///
+        /// @param string
+        ///     The string to hash.
+        ///
+        /// @return The hash.
+        ///
+        static std::size_t CalculateHash(const std::string& string) noexcept;
+        
+        /// @return The number of strings which have been interned, not including the empty string.
+        ///
+        static u32 GetNumInternedStrings() noexcept;
+        
+        /// @return The unique id of the string. This is stable for the lifetime of the application.
+        ///
+        u32 GetId() const noexcept;
+        
+        /// @return The precomputed hash of the string.
+        ///
+        std::size_t GetHash() const noexcept;
+        
+        /// @return The string. This reference remains valid for the lifetime of the application.
+        ///
+        const std::string& GetString() const noexcept;
+        
+        /// @return Whether or not this is the empty string.
+        ///
+        bool IsEmpty() const noexcept { return m_entry == nullptr; }
+        
+        bool operator==(const InternedString& other) const noexcept { return m_entry == other.m_entry; }
+        bool operator!=(const InternedString& other) const noexcept { return m_entry != other.m_entry; }
+        
+        /// Orders interned strings by id rather than alphabetically.
+        ///
+        bool operator<(const InternedString& other) const noexcept { return GetId() < other.GetId(); }
+        
+        /// An entry in the intern table.
+        ///
+        struct Entry
+        {
+            std::string m_string;
+            std::size_t m_hash;
+            u32 m_id;
+        };
+        
+    private:
+        const Entry* m_entry = nullptr;
+    };
+}
+
+namespace std
+{
+    /// Allows interned strings to be used as keys in unordered containers, using the
+    /// precomputed hash.
+    ///
+    template <> struct hash<ChilliSource::InternedString>
+    {
+        std::size_t operator()(const ChilliSource::InternedString& internedString) const noexcept
+        {
+            return internedString.GetHash();
+        }
+    };
+}
+
+#endif
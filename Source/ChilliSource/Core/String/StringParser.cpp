@@ -48,7 +48,7 @@ namespace ChilliSource
         ///
         /// @return The number of items.
         //------------------------------------------------------------
-        static const u32 EnumerateItems(const std::string& in_stringList)
+        static u32 EnumerateItems(const std::string& in_stringList)
         {
             u32 itemCount = 0;
             std::size_t i = 0;
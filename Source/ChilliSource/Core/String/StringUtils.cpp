@@ -788,9 +788,9 @@ namespace ChilliSource
         {
             u8 ubyDig1 = (inubyDec&0xF0) >> 4;
             u8 ubyDig2 = (inubyDec&0x0F);
-            if ( 0 <= ubyDig1 && ubyDig1 <= 9) ubyDig1 += 48;    		// 0,48 in ASCII
+            if (ubyDig1 <= 9) ubyDig1 += 48;    		// 0,48 in ASCII
             if (10 <= ubyDig1 && ubyDig1 <=15) ubyDig1 += 65 - 10; 		// A,65 in ASCII
-            if ( 0 <= ubyDig2 && ubyDig2 <= 9) ubyDig2 += 48;
+            if (ubyDig2 <= 9) ubyDig2 += 48;
             if (10 <= ubyDig2 && ubyDig2 <=15) ubyDig2 += 65 - 10;
             
             std::string strResult;
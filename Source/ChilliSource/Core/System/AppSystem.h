@@ -96,7 +96,7 @@ namespace ChilliSource
         ///
         /// @param The delta time.
         //------------------------------------------------
-        virtual void OnUpdate(f32 in_deltaTime) {};
+        virtual void OnUpdate(f32) {};
         //------------------------------------------------
         /// An update method called at a fixed interval.
         /// The time between fixed updates is defined in
@@ -107,7 +107,7 @@ namespace ChilliSource
         ///
         /// @param The delta time.
         //------------------------------------------------
-        virtual void OnFixedUpdate(f32 in_deltaTime) {};
+        virtual void OnFixedUpdate(f32) {};
         //------------------------------------------------
         /// The render snapshot event can be implemented
         /// by a system to allow it to snapshot any data
@@ -122,7 +122,7 @@ namespace ChilliSource
         /// @param frameAllocator - Allocate memory for
         /// this render frame from here
         //------------------------------------------------
-        virtual void OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) noexcept {};
+        virtual void OnRenderSnapshot(TargetType, RenderSnapshot&, IAllocator*) noexcept {};
         //------------------------------------------------
         /// Called when the application transitions from
         /// being active app into the background. This
@@ -99,7 +99,7 @@ namespace ChilliSource
         ///
         /// @param The delta time.
         //------------------------------------------------
-        virtual void OnUpdate(f32 in_deltaTime) {};
+        virtual void OnUpdate(f32) {};
         //------------------------------------------------
         /// An update method called at a fixed interval
         /// while the owning state is active. The time between
@@ -109,7 +109,7 @@ namespace ChilliSource
         ///
         /// @author Ian Copland
         //------------------------------------------------
-        virtual void OnFixedUpdate(f32 in_deltaTime) {};
+        virtual void OnFixedUpdate(f32) {};
         //------------------------------------------------
         /// The render snapshot event can be implemented
         /// by a system to allow it to snapshot any data
@@ -124,7 +124,7 @@ namespace ChilliSource
         /// @param frameAllocator - Allocate memory required
         /// for rendering this frame from here
         //------------------------------------------------
-        virtual void OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) noexcept {};
+        virtual void OnRenderSnapshot(TargetType, RenderSnapshot&, IAllocator*) noexcept {};
         //------------------------------------------------
         /// Called when the state transitions from
         /// being active app into the background. This
@@ -42,7 +42,7 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
     TaskPool::TaskPool(TaskType in_taskType, u32 in_numThreads) noexcept
-        : m_numThreads(in_numThreads), m_taskContext(in_taskType, this), m_isFinished(false), m_taskCountHeuristic(0)
+        : m_numThreads(in_numThreads), m_taskContext(in_taskType, this), m_taskCountHeuristic(0), m_isFinished(false)
     {
         CS_ASSERT(in_taskType == TaskType::k_small || in_taskType == TaskType::k_large, "Task type must be small or large");
         
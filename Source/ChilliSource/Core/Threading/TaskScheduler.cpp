@@ -47,7 +47,7 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
     TaskScheduler::TaskScheduler() noexcept
-        : m_gameLogicTaskCount(0)
+        : m_gameLogicTaskCount(0), m_isDestroyed(false)
     {
     }
     //------------------------------------------------------------------------------
@@ -64,6 +64,12 @@ namespace ChilliSource
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
+    bool TaskScheduler::IsDestroyed() const noexcept
+    {
+        return m_isDestroyed;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
     void TaskScheduler::ScheduleTask(TaskType in_taskType, const Task& in_task) noexcept
     {
         std::vector<Task> tasks = { in_task };
@@ -189,7 +195,7 @@ namespace ChilliSource
         std::vector<Task> tasks;
         tasks.reserve(1);
 
-        tasks.push_back([=](const TaskContext& in_taskContext)
+        tasks.push_back([=](const TaskContext&)
         {
             in_task(TaskContext(TaskType::k_file));
             
@@ -234,6 +240,8 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     void TaskScheduler::Destroy() noexcept
     {
+        m_isDestroyed = true;
+        
         m_smallTaskPool.reset();
         m_largeTaskPool.reset();
         m_mainThreadTaskPool.reset();
@@ -73,6 +73,11 @@ namespace ChilliSource
         //------------------------------------------------------------------------------
         bool IsMainThread() const noexcept;
         //------------------------------------------------------------------------------
+        /// @return Whether or not the scheduler has been destroyed. Once it has, tasks
+        /// can no longer be scheduled and any work must be performed inline.
+        //------------------------------------------------------------------------------
+        bool IsDestroyed() const noexcept;
+        //------------------------------------------------------------------------------
         /// Schedules a single task which will be executed in a manner dependant on the
         /// task type.
         ///
@@ -190,6 +195,7 @@ namespace ChilliSource
         std::deque<Task> m_fileTaskQueue;
 
         std::thread::id m_mainThreadId;
+        std::atomic<bool> m_isDestroyed;
     };
 }
 
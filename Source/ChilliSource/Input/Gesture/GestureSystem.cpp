@@ -51,7 +51,6 @@ namespace ChilliSource
         //-------------------------------------------------------
         bool GestureExists(concurrent_vector<GestureSPtr>& in_gestureList, const Gesture* in_gesture)
         {
-            in_gestureList.lock();
             for (const auto& gesturePair : in_gestureList)
             {
                 if (gesturePair.get() == in_gesture)
@@ -59,7 +58,6 @@ namespace ChilliSource
                     return true;
                 }
             }
-            in_gestureList.unlock();
             return false;
         }
     }
@@ -91,7 +89,6 @@ namespace ChilliSource
     void GestureSystem::RemoveGesture(const Gesture* in_gesture)
     {
         std::unique_lock<std::recursive_mutex> lock(m_mutex);
-        m_gestures.lock();
         
         CS_ASSERT(GestureExists(m_gestures, in_gesture) == true, "Cannot remove a gesture that hasn't been added to the Gesture System.");
         
@@ -108,8 +105,6 @@ namespace ChilliSource
                 ++it;
             }
         }
-        
-        m_gestures.unlock();
     }
     //--------------------------------------------------------
     //--------------------------------------------------------
@@ -123,7 +118,6 @@ namespace ChilliSource
     bool GestureSystem::ResolveConflicts(Gesture* in_gesture)
     {
         std::unique_lock<std::recursive_mutex> lock(m_mutex);
-        m_gestures.lock();
         
         bool canActivate = true;
         
@@ -154,7 +148,6 @@ namespace ChilliSource
             }
         }
         
-        m_gestures.unlock();
         return canActivate;
     }
     //--------------------------------------------------------
@@ -162,14 +155,11 @@ namespace ChilliSource
     void GestureSystem::ResetAll()
     {
         std::unique_lock<std::recursive_mutex> lock(m_mutex);
-        m_gestures.lock();
         
         for (const auto& gesture : m_gestures)
         {
             gesture->Reset();
         }
-        
-        m_gestures.unlock();
     }
     //--------------------------------------------------------
     //--------------------------------------------------------
@@ -188,14 +178,11 @@ namespace ChilliSource
     void GestureSystem::OnUpdate(f32 in_deltaTime)
     {
         std::unique_lock<std::recursive_mutex> lock(m_mutex);
-        m_gestures.lock();
         
         for (const auto& gesture : m_gestures)
         {
             gesture->OnUpdate(in_deltaTime);
         }
-        
-        m_gestures.unlock();
     }
     //--------------------------------------------------------
     //--------------------------------------------------------
@@ -204,14 +191,11 @@ namespace ChilliSource
         if (in_filter.IsFiltered() == false)
         {
             std::unique_lock<std::recursive_mutex> lock(m_mutex);
-            m_gestures.lock();
             
             for (const auto& gesture : m_gestures)
             {
                 gesture->OnPointerDown(in_pointer, in_timestamp, in_inputType);
             }
-            
-            m_gestures.unlock();
         }
     }
     //--------------------------------------------------------
@@ -219,28 +203,22 @@ namespace ChilliSource
     void GestureSystem::OnPointerMoved(const Pointer& in_pointer, f64 in_timestamp)
     {
         std::unique_lock<std::recursive_mutex> lock(m_mutex);
-        m_gestures.lock();
         
         for (const auto& gesture : m_gestures)
         {
             gesture->OnPointerMoved(in_pointer, in_timestamp);
         }
-        
-        m_gestures.unlock();
     }
     //--------------------------------------------------------
     //--------------------------------------------------------
     void GestureSystem::OnPointerUp(const Pointer& in_pointer, f64 in_timestamp, Pointer::InputType in_inputType)
     {
         std::unique_lock<std::recursive_mutex> lock(m_mutex);
-        m_gestures.lock();
         
         for (const auto& gesture : m_gestures)
         {
             gesture->OnPointerUp(in_pointer, in_timestamp, in_inputType);
         }
-        
-        m_gestures.unlock();
     }
     //--------------------------------------------------------
     //--------------------------------------------------------
@@ -249,14 +227,11 @@ namespace ChilliSource
         if (in_filter.IsFiltered() == false)
         {
             std::unique_lock<std::recursive_mutex> lock(m_mutex);
-            m_gestures.lock();
             
             for (const auto& gesture : m_gestures)
             {
                 gesture->OnPointerScrolled(in_pointer, in_timestamp, in_delta);
             }
-            
-            m_gestures.unlock();
         }
     }
     //-------------------------------------------------------
@@ -282,7 +257,6 @@ namespace ChilliSource
     void GestureSystem::OnDestroy()
     {
         std::unique_lock<std::recursive_mutex> lock(m_mutex);
-        m_gestures.lock();
         
         m_conflictResolutionDelegate = nullptr;
         
@@ -291,7 +265,5 @@ namespace ChilliSource
             gesture->SetGestureSystem(nullptr);
         }
         m_gestures.clear();
-        
-        m_gestures.unlock();
     }
 }
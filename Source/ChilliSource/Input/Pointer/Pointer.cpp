@@ -47,7 +47,7 @@ namespace ChilliSource
     //----------------------------------------------------
     //----------------------------------------------------
     Pointer::Pointer(Id in_uniqueId, u32 in_index, const Vector2& in_initialPosition)
-    : m_uniqueId(in_uniqueId), m_index(in_index), m_position(in_initialPosition), m_previousPosition(in_initialPosition)
+    : m_position(in_initialPosition), m_previousPosition(in_initialPosition), m_uniqueId(in_uniqueId), m_index(in_index)
     {
     }
     //----------------------------------------------------
@@ -35,11 +35,17 @@
 #include <ChilliSource/Core/Cryptographic/HashMD5.h>
 #include <ChilliSource/Core/File/FileSystem.h>
 #include <ChilliSource/Core/File/AppDataStore.h>
+#include <ChilliSource/Core/File/TaggedFilePathResolver.h>
+#include <ChilliSource/Core/String/StringParser.h>
 #include <ChilliSource/Core/String/StringUtils.h>
+#include <ChilliSource/Core/Threading/TaskContext.h>
 #include <ChilliSource/Core/Threading/TaskScheduler.h>
 
 #include <minizip/unzip.h>
 
+#include <sstream>
+#include <sys/stat.h>
+
 namespace ChilliSource
 {
     namespace
@@ -51,6 +57,14 @@ namespace ChilliSource
         const char k_tempManifestFile[] = "ContentManifestTemp.moman";
         const char k_packageExtension[] = "packzip";
         const char k_packageExtensionFull[] = ".packzip";
+        const char k_checksumCacheFile[] = "ContentChecksumCache.cache";
+        
+        const u32 k_sha1Length = 20;
+        const u32 k_hashChunkSize = 64 * 1024;
+        const u32 k_filesPerVerificationBatch = 16;
+        const u32 k_maxFilesPerExtractionBatch = 32;
+        const u64 k_maxBytesPerExtractionBatch = 1024 * 1024;
+        const u32 k_extractionChunkSize = 64 * 1024;
         
         const std::string k_tempManifestFilePath = std::string(k_tempDirectory) + k_tempManifestFile;
         
@@ -131,6 +145,175 @@ namespace ChilliSource
             return XMLUtils::WriteDocument(doc->GetDocument(), StorageLocation::k_DLC, in_filePath);
         }
         //-----------------------------------------------------------
+        /// @param in_packageId - The package id.
+        ///
+        /// @return The path to the temp file a package is downloaded
+        /// to, relative to the DLC storage location.
+        //-----------------------------------------------------------
+        std::string GetTempPackageFilePath(const std::string& in_packageId)
+        {
+            return k_tempDirectory + in_packageId + k_packageExtensionFull;
+        }
+        //-----------------------------------------------------------
+        /// Converts a SHA1 hex string into the format used for
+        /// checksums in the manifest: lower case, base 64 encoded
+        /// and with the trailing '=' removed.
+        ///
+        /// @param in_sha1Hex - The SHA1 hex string.
+        ///
+        /// @return The checksum.
+        //-----------------------------------------------------------
+        std::string EncodeChecksum(std::string in_sha1Hex)
+        {
+            StringUtils::ToLowerCase(in_sha1Hex);
+            std::string base64Encoded = BaseEncoding::Base64Encode(in_sha1Hex);
+            StringUtils::ChopTrailingChars(base64Encoded, '=');
+            return base64Encoded;
+        }
+        //-----------------------------------------------------------
+        /// @param in_hash - A finalised SHA1 hash.
+        ///
+        /// @return The hash as a hex string.
+        //-----------------------------------------------------------
+        std::string ToHexString(const CSHA1& in_hash)
+        {
+            const char k_hexDigits[] = "0123456789abcdef";
+            
+            u8 digest[k_sha1Length];
+            in_hash.GetHash(digest);
+            
+            std::string output;
+            output.reserve(k_sha1Length * 2);
+            for (u32 i = 0; i < k_sha1Length; ++i)
+            {
+                output += k_hexDigits[digest[i] >> 4];
+                output += k_hexDigits[digest[i] & 0x0f];
+            }
+            
+            return output;
+        }
+        //-----------------------------------------------------------
+        /// Feeds the contents of a partially downloaded package into
+        /// the given hash so that the download can be resumed.
+        ///
+        /// @param in_filePath - The path to the file in DLC.
+        /// @param out_hash - [Out] The hash to update.
+        ///
+        /// @return The number of bytes read, or 0 if the file
+        /// couldn't be read.
+        //-----------------------------------------------------------
+        u64 HashExistingData(const std::string& in_filePath, CSHA1& out_hash)
+        {
+            auto fileStream = Application::Get()->GetFileSystem()->CreateBinaryInputStream(StorageLocation::k_DLC, in_filePath);
+            if (fileStream == nullptr)
+            {
+                return 0;
+            }
+            
+            u64 length = fileStream->GetLength();
+            std::unique_ptr<u8[]> buffer(new u8[k_hashChunkSize]);
+            
+            u64 remaining = length;
+            while (remaining > 0)
+            {
+                u32 chunkSize = u32(std::min(remaining, u64(k_hashChunkSize)));
+                if (fileStream->Read(buffer.get(), chunkSize) == false)
+                {
+                    return 0;
+                }
+                
+                out_hash.Update(buffer.get(), chunkSize);
+                remaining -= chunkSize;
+            }
+            
+            return length;
+        }
+        //-----------------------------------------------------------
+        /// @param in_filePath - The file path.
+        /// @param in_checkOnlyBundle - Whether the file is checked in
+        /// the bundle rather than DLC.
+        ///
+        /// @return The key for the verified result of the file.
+        //-----------------------------------------------------------
+        std::string GetFileCheckKey(const std::string& in_filePath, bool in_checkOnlyBundle)
+        {
+            return (in_checkOnlyBundle ? "package:" : "dlc:") + in_filePath;
+        }
+        //-----------------------------------------------------------
+        /// @param in_location - The storage location.
+        /// @param in_filePath - The file path.
+        ///
+        /// @return The key for the file in the checksum cache.
+        //-----------------------------------------------------------
+        std::string GetChecksumCacheKey(StorageLocation in_location, const std::string& in_filePath)
+        {
+            return ToString(u32(in_location)) + ":" + in_filePath;
+        }
+        //-----------------------------------------------------------
+        /// A single file entry in a package zip which is to be
+        /// extracted.
+        //-----------------------------------------------------------
+        struct PackageEntry final
+        {
+            unz_file_pos m_position;
+            std::string m_filePath;
+            u64 m_size = 0;
+        };
+        //-----------------------------------------------------------
+        /// Extracts the given entries from the zip, streaming each
+        /// to its output file in chunks rather than reading the
+        /// whole file into memory. The zip is opened separately so
+        /// this can be called from multiple threads at once.
+        ///
+        /// @param in_zipFilePath - The absolute path to the zip.
+        /// @param in_entries - The entries to extract.
+        //-----------------------------------------------------------
+        void ExtractPackageEntries(const std::string& in_zipFilePath, const std::vector<PackageEntry>& in_entries)
+        {
+            unzFile zippedFile = unzOpen(in_zipFilePath.c_str());
+            if(!zippedFile)
+            {
+                CS_LOG_ERROR("CMS: Cannot unzip content package: " + in_zipFilePath);
+                return;
+            }
+            
+            auto fileSystem = Application::Get()->GetFileSystem();
+            std::unique_ptr<u8[]> buffer(new u8[k_extractionChunkSize]);
+            
+            for(const auto& entry : in_entries)
+            {
+                unz_file_pos position = entry.m_position;
+                if(unzGoToFilePos(zippedFile, &position) != UNZ_OK || unzOpenCurrentFile(zippedFile) != UNZ_OK)
+                {
+                    CS_LOG_ERROR("CMS: Cannot read package entry: " + entry.m_filePath);
+                    continue;
+                }
+                
+                auto fileStream = fileSystem->CreateBinaryOutputStream(StorageLocation::k_DLC, "/" + entry.m_filePath);
+                if(fileStream == nullptr)
+                {
+                    CS_LOG_ERROR("CMS: Cannot write package entry: " + entry.m_filePath);
+                    unzCloseCurrentFile(zippedFile);
+                    continue;
+                }
+                
+                s32 bytesRead = 0;
+                while((bytesRead = unzReadCurrentFile(zippedFile, buffer.get(), k_extractionChunkSize)) > 0)
+                {
+                    fileStream->Write(buffer.get(), u64(bytesRead));
+                }
+                
+                if(bytesRead < 0)
+                {
+                    CS_LOG_ERROR("CMS: Failed to inflate package entry: " + entry.m_filePath);
+                }
+                
+                unzCloseCurrentFile(zippedFile);
+            }
+            
+            unzClose(zippedFile);
+        }
+        //-----------------------------------------------------------
         /// Deletes a directory from the DLC Storage Location.
         ///
         /// @author S Downie
@@ -160,8 +343,8 @@ namespace ChilliSource
     //-----------------------------------------------------------
     //-----------------------------------------------------------
     ContentManagementSystem::ContentManagementSystem(IContentDownloader* in_contentDownloader)
-    :m_contentDownloader(in_contentDownloader)
-    ,m_serverManifest(nullptr)
+    :m_serverManifest(nullptr)
+    ,m_contentDownloader(in_contentDownloader)
     {
     }
     //------------------------------------------------------------
@@ -169,6 +352,8 @@ namespace ChilliSource
     void ContentManagementSystem::OnInit()
     {
         m_contentDirectory = Application::Get()->GetFileSystem()->GetAbsolutePathToStorageLocation(StorageLocation::k_DLC);
+        
+        LoadChecksumCache();
     }
     //-----------------------------------------------------------
     //-----------------------------------------------------------
@@ -211,11 +396,107 @@ namespace ChilliSource
             return m_checksumDelegate(in_location, in_filePath);
         }
         
-        std::string checksum = Application::Get()->GetFileSystem()->GetFileChecksumSHA1(in_location, in_filePath);
-        StringUtils::ToLowerCase(checksum);
-        std::string base64Encoded = BaseEncoding::Base64Encode(checksum);
-        StringUtils::ChopTrailingChars(base64Encoded, '=');
-        return base64Encoded;
+        return EncodeChecksum(Application::Get()->GetFileSystem()->GetFileChecksumSHA1(in_location, in_filePath));
+    }
+    //-----------------------------------------------------------
+    //-----------------------------------------------------------
+    std::string ContentManagementSystem::CalculateCachedChecksum(StorageLocation in_location, const std::string& in_filePath) const
+    {
+        //Custom checksums can't be assumed to be stable, so aren't cached.
+        if(m_checksumDelegate)
+        {
+            return CalculateChecksum(in_location, in_filePath);
+        }
+        
+        //Files which can't be stat'd, such as those inside the Android apk, aren't cached.
+        std::string absoluteFilePath = Application::Get()->GetFileSystem()->GetAbsolutePathToStorageLocation(in_location) + in_filePath;
+        struct stat fileStat;
+        if(stat(absoluteFilePath.c_str(), &fileStat) != 0)
+        {
+            return CalculateChecksum(in_location, in_filePath);
+        }
+        
+        std::string key = GetChecksumCacheKey(in_location, in_filePath);
+        {
+            std::unique_lock<std::mutex> lock(m_checksumCacheMutex);
+            auto it = m_checksumCache.find(key);
+            if(it != m_checksumCache.end() && it->second.m_size == u64(fileStat.st_size) && it->second.m_modifiedTime == s64(fileStat.st_mtime))
+            {
+                return it->second.m_checksum;
+            }
+        }
+        
+        ChecksumCacheEntry entry;
+        entry.m_size = u64(fileStat.st_size);
+        entry.m_modifiedTime = s64(fileStat.st_mtime);
+        entry.m_checksum = CalculateChecksum(in_location, in_filePath);
+        
+        std::unique_lock<std::mutex> lock(m_checksumCacheMutex);
+        m_checksumCache[key] = entry;
+        m_checksumCacheDirty = true;
+        return entry.m_checksum;
+    }
+    //-----------------------------------------------------------
+    //-----------------------------------------------------------
+    void ContentManagementSystem::InvalidateCachedChecksum(StorageLocation in_location, const std::string& in_filePath) const
+    {
+        std::unique_lock<std::mutex> lock(m_checksumCacheMutex);
+        if(m_checksumCache.erase(GetChecksumCacheKey(in_location, in_filePath)) > 0)
+        {
+            m_checksumCacheDirty = true;
+        }
+    }
+    //-----------------------------------------------------------
+    //-----------------------------------------------------------
+    void ContentManagementSystem::LoadChecksumCache()
+    {
+        std::string contents;
+        if(Application::Get()->GetFileSystem()->DoesFileExist(StorageLocation::k_DLC, k_checksumCacheFile) == false ||
+           Application::Get()->GetFileSystem()->ReadFile(StorageLocation::k_DLC, k_checksumCacheFile, contents) == false)
+        {
+            return;
+        }
+        
+        //Each line is: size, modified time, checksum and key separated by tabs. The key is last
+        //as it is the only value which could contain spaces.
+        std::unique_lock<std::mutex> lock(m_checksumCacheMutex);
+        std::istringstream stream(contents);
+        std::string line;
+        while(std::getline(stream, line))
+        {
+            std::istringstream lineStream(line);
+            std::string size, modifiedTime, checksum, key;
+            if(std::getline(lineStream, size, '\t') && std::getline(lineStream, modifiedTime, '\t') && std::getline(lineStream, checksum, '\t') && std::getline(lineStream, key))
+            {
+                ChecksumCacheEntry entry;
+                entry.m_size = ParseU64(size);
+                entry.m_modifiedTime = ParseS64(modifiedTime);
+                entry.m_checksum = checksum;
+                m_checksumCache[key] = entry;
+            }
+        }
+    }
+    //-----------------------------------------------------------
+    //-----------------------------------------------------------
+    void ContentManagementSystem::SaveChecksumCache()
+    {
+        std::string contents;
+        {
+            std::unique_lock<std::mutex> lock(m_checksumCacheMutex);
+            if(m_checksumCacheDirty == false)
+            {
+                return;
+            }
+            
+            for(const auto& entryPair : m_checksumCache)
+            {
+                contents += ToString(entryPair.second.m_size) + "\t" + ToString(entryPair.second.m_modifiedTime) + "\t" + entryPair.second.m_checksum + "\t" + entryPair.first + "\n";
+            }
+            
+            m_checksumCacheDirty = false;
+        }
+        
+        Application::Get()->GetFileSystem()->WriteFile(StorageLocation::k_DLC, k_checksumCacheFile, contents);
     }
     //-----------------------------------------------------------
     //-----------------------------------------------------------
@@ -223,19 +504,30 @@ namespace ChilliSource
     {
         //Clear the old crap
         m_serverManifest.reset();
+        m_localManifest.reset();
+        m_verifiedFiles.clear();
         m_removePackageIds.clear();
         m_packageDetails.clear();
         m_cachedPackageDetails.clear();
+        
+        //Any downloads still in flight refer to the cleared packages, so are abandoned.
+        m_downloadGeneration++;
+        m_activePackageDownloads.clear();
+        m_downloadInProgress = false;
     }
     //-----------------------------------------------------------
     //-----------------------------------------------------------
     void ContentManagementSystem::CheckForUpdates(const ContentManagementSystem::CheckForUpdateDelegate& in_delegate)
     {
         CS_ASSERT(Application::Get()->GetTaskScheduler()->IsMainThread() == true, "This can only be called on the main thread.");
+        CS_ASSERT(!m_installInProgress, "Cannot call CheckForUpdates while updates are being installed!");
         
         //Clear any stale data from last update check
         ClearDownloadData();
         
+        //Any verification still in progress from a previous check is ignored.
+        m_updateCheckGeneration++;
+        
         m_onUpdateCheckCompleteDelegate = in_delegate;
         
         //Have the downloader request the manifest in its own way
@@ -248,11 +540,17 @@ namespace ChilliSource
         CS_ASSERT(Application::Get()->GetTaskScheduler()->IsMainThread() == true, "This can only be called on the main thread.");
         
         CS_ASSERT(!m_downloadInProgress, "Cannot call DownloadUpdates while updates are being downloaded!");
+        CS_ASSERT(!m_installInProgress, "Cannot call DownloadUpdates while updates are being installed!");
 
         m_onDownloadCompleteDelegate = in_delegate;
         m_onDownloadProgressDelegate = in_progressDelegate;
         
-        m_currentPackageDownload = 0;
+        //Responses from any previous, abandoned, downloads are ignored.
+        m_downloadGeneration++;
+        m_activePackageDownloads.clear();
+        m_packageDownloadProgress.assign(m_packageDetails.size(), 0.0f);
+        m_nextPackageDownload = 0;
+        m_numPackagesDownloaded = 0;
         m_downloadInProgress = true;
 
         if(!m_packageDetails.empty())
@@ -260,53 +558,111 @@ namespace ChilliSource
             //Add a temp directory so that the packages are stored atomically and only overwrite
             //the originals on full success
             Application::Get()->GetFileSystem()->CreateDirectoryPath(StorageLocation::k_DLC, k_tempDirectory);
-            DownloadPackage(m_currentPackageDownload);
-        }
-        else
-        {
-            m_downloadInProgress = false;
-            m_onDownloadCompleteDelegate(Result::k_succeeded);
         }
+        
+        StartPackageDownloads();
     }
     //-----------------------------------------------------------
     //-----------------------------------------------------------
-    void ContentManagementSystem::DownloadNextPackage()
+    void ContentManagementSystem::StartPackageDownloads()
     {
-        m_currentPackageDownload++;
-        DownloadPackage(m_currentPackageDownload);
+        u32 maxConcurrentDownloads = m_contentDownloader->SupportsConcurrentDownloads() ? m_maxConcurrentDownloads : 1;
+        
+        while(m_downloadInProgress && m_activePackageDownloads.size() < maxConcurrentDownloads && m_nextPackageDownload < m_packageDetails.size())
+        {
+            DownloadPackage(m_nextPackageDownload++);
+        }
+        
+        //Don't overwrite the old manifest until all the content has been downloaded
+        if(m_downloadInProgress && m_numPackagesDownloaded == m_packageDetails.size())
+        {
+            m_downloadInProgress = false;
+            m_onDownloadCompleteDelegate(Result::k_succeeded);
+        }
     }
     //-----------------------------------------------------------
     //-----------------------------------------------------------
-    void ContentManagementSystem::DownloadPackage(u32 in_packageIndex, bool in_checkCached)
+    void ContentManagementSystem::DownloadPackage(u32 in_packageIndex)
     {
         CS_ASSERT(in_packageIndex < m_packageDetails.size(), "Package index out of range");
         
         const auto& package = m_packageDetails[in_packageIndex];
-        bool existsInCache = VectorUtils::Contains<PackageDetails>(m_cachedPackageDetails, package);
         
-        if(in_checkCached && existsInCache)
+        if(VectorUtils::Contains<PackageDetails>(m_cachedPackageDetails, package))
         {
             //We call the progress function for this index
-            OnContentDownloadProgress(package.m_url, 1.0f);
+            OnContentDownloadProgress(m_downloadGeneration, in_packageIndex, 1.0f);
             
             m_runningDownloadedTotal += package.m_size;
-            
-            //Check if this is the last download
-            if(in_packageIndex >= (m_packageDetails.size() - 1))
-            {
-                m_downloadInProgress = false;
-                m_onDownloadCompleteDelegate(Result::k_succeeded);
-            }
-            else
+            m_numPackagesDownloaded++;
+            return;
+        }
+        
+        auto fileSystem = Application::Get()->GetFileSystem();
+        std::string filePath = GetTempPackageFilePath(package.m_id);
+        
+        std::unique_ptr<PackageDownload> download(new PackageDownload());
+        download->m_hash.Reset();
+        
+        //If part of the package was downloaded previously, resume from the end of it. The
+        //existing data is fed into the hash so the completed package can still be validated
+        //without re-reading it.
+        if(fileSystem->DoesFileExist(StorageLocation::k_DLC, filePath))
+        {
+            download->m_bytesWritten = HashExistingData(filePath, download->m_hash);
+            if(download->m_bytesWritten == 0 || download->m_bytesWritten >= package.m_size)
             {
-                //Else move on to next package
-                DownloadNextPackage();
+                fileSystem->DeleteFile(StorageLocation::k_DLC, filePath);
+                download->m_hash.Reset();
+                download->m_bytesWritten = 0;
             }
         }
+        
+        FileWriteMode writeMode = (download->m_bytesWritten > 0) ? FileWriteMode::k_append : FileWriteMode::k_overwrite;
+        download->m_fileStream = fileSystem->CreateBinaryOutputStream(StorageLocation::k_DLC, filePath, writeMode);
+        if(download->m_fileStream == nullptr)
+        {
+            CS_LOG_ERROR("CMS: " + package.m_id + " Couldn't write package.");
+            FailDownload();
+            return;
+        }
+        
+        u64 offset = download->m_bytesWritten;
+        m_activePackageDownloads.emplace(in_packageIndex, std::move(download));
+        
+        u32 generation = m_downloadGeneration;
+        auto completionDelegate = [=](IContentDownloader::Result in_result, const std::string& in_data)
+        {
+            OnContentDownloadComplete(generation, in_packageIndex, in_result, in_data);
+        };
+        auto progressDelegate = [=](const std::string&, f32 in_progress)
+        {
+            OnContentDownloadProgress(generation, in_packageIndex, in_progress);
+        };
+        
+        if(offset > 0)
+        {
+            m_contentDownloader->ResumePackageDownload(package.m_url, offset, completionDelegate, progressDelegate);
+        }
         else
         {
-            m_contentDownloader->DownloadPackage(package.m_url, MakeDelegate(this, &ContentManagementSystem::OnContentDownloadComplete),
-                                                 MakeDelegate(this, &ContentManagementSystem::OnContentDownloadProgress));
+            m_contentDownloader->DownloadPackage(package.m_url, completionDelegate, progressDelegate);
+        }
+    }
+    //-----------------------------------------------------------
+    //-----------------------------------------------------------
+    void ContentManagementSystem::FailDownload()
+    {
+        //Partially downloaded packages are left in the temp directory so they can be resumed.
+        m_activePackageDownloads.clear();
+        
+        if(m_downloadInProgress)
+        {
+            m_downloadInProgress = false;
+            if(m_onDownloadCompleteDelegate)
+            {
+                m_onDownloadCompleteDelegate(Result::k_failed);
+            }
         }
     }
     //-----------------------------------------------------------
@@ -314,50 +670,73 @@ namespace ChilliSource
     void ContentManagementSystem::InstallUpdates(const CompleteDelegate& inDelegate)
     {
         CS_ASSERT(Application::Get()->GetTaskScheduler()->IsMainThread() == true, "This can only be called on the main thread.");
+        CS_ASSERT(!m_installInProgress, "Cannot call InstallUpdates while updates are being installed!");
         
         if(!m_packageDetails.empty() || !m_removePackageIds.empty())
         {
-            if(!m_packageDetails.empty())
-            {
-                //Unzip all the files and overwrite the old manifest
-                for (const auto& details : m_packageDetails)
-                {
-                    ExtractFilesFromPackage(details);
-                }
-            }
-            
-            //Remove the temp zips
-            ClearTempDownloadFolder();
+            m_installInProgress = true;
             
-            m_packageDetails.clear();
-        
-            if(!m_removePackageIds.empty())
+            //Unzip all the packages in the background, then finish on the main thread.
+            auto packageDetails = m_packageDetails;
+            auto taskScheduler = Application::Get()->GetTaskScheduler();
+            taskScheduler->ScheduleTask(TaskType::k_large, [=](const TaskContext& in_taskContext)
             {
-                //Remove any unused files from the documents
-                for (const auto& packageId : m_removePackageIds)
+                for (const auto& details : packageDetails)
                 {
-                    DeleteDirectory(packageId);
+                    ExtractFilesFromPackage(in_taskContext, details);
                 }
-            }
-            
-            //Save the new content manifest
-            XMLUtils::WriteDocument(m_serverManifest->GetDocument(), StorageLocation::k_DLC, k_manifestFile);
-            
-            m_dlcCachePurged = false;
-            
-            //Store that we have DLC cached. If there is no DLC on next check then 
-            //we know the cache has been purged and we have to block on download
-            AppDataStore* ads = Application::Get()->GetSystem<AppDataStore>();
-            ads->SetValue(k_adsKeyHasCached, true);
-            
-            //Tell the delegate all is good
-            inDelegate(Result::k_succeeded);
+                
+                taskScheduler->ScheduleTask(TaskType::k_mainThread, [=](const TaskContext&)
+                {
+                    CompleteInstall(inDelegate);
+                });
+            });
         }
         else
         {
             //Tell the delegate all is bad
             inDelegate(Result::k_failed);
+            
+            ClearDownloadData();
         }
+    }
+    //-----------------------------------------------------------
+    //-----------------------------------------------------------
+    void ContentManagementSystem::CompleteInstall(const CompleteDelegate& in_delegate)
+    {
+        m_installInProgress = false;
+        
+        //Remove the temp zips
+        ClearTempDownloadFolder();
+        
+        m_packageDetails.clear();
+    
+        if(!m_removePackageIds.empty())
+        {
+            //Remove any unused files from the documents
+            for (const auto& packageId : m_removePackageIds)
+            {
+                DeleteDirectory(packageId);
+            }
+        }
+        
+        //Save the new content manifest
+        XMLUtils::WriteDocument(m_serverManifest->GetDocument(), StorageLocation::k_DLC, k_manifestFile);
+        
+        //The DLC contents have changed so any tagged paths resolved against them are stale
+        Application::Get()->GetTaggedFilePathResolver()->InvalidateIndex(StorageLocation::k_DLC);
+        
+        m_dlcCachePurged = false;
+        
+        //Store that we have DLC cached. If there is no DLC on next check then 
+        //we know the cache has been purged and we have to block on download
+        AppDataStore* ads = Application::Get()->GetSystem<AppDataStore>();
+        ads->SetValue(k_adsKeyHasCached, true);
+        
+        SaveChecksumCache();
+        
+        //Tell the delegate all is good
+        in_delegate(Result::k_succeeded);
         
         ClearDownloadData();
     }
@@ -375,56 +754,67 @@ namespace ChilliSource
             case IContentDownloader::Result::k_failed:
                 m_serverManifestData.clear();
                 m_dlcCachePurged ? m_onUpdateCheckCompleteDelegate(CheckForUpdatesResult::k_checkFailedBlocking) : m_onUpdateCheckCompleteDelegate(CheckForUpdatesResult::k_checkFailed);
+                
+                //Reset the listener
+                m_onUpdateCheckCompleteDelegate = nullptr;
                 break;
             case IContentDownloader::Result::k_flushed:
                 m_serverManifestData += in_manifest;
                 break;
         };
         
-        if(in_result != IContentDownloader::Result::k_flushed)
-        {
-            //Reset the listener
-            m_onUpdateCheckCompleteDelegate = nullptr;
-        }
+        //On success the listener is kept, as the download list is completed once the files
+        //have been verified in the background.
     }
     //-----------------------------------------------------------
     //-----------------------------------------------------------
-    void ContentManagementSystem::OnContentDownloadComplete(IContentDownloader::Result in_result, const std::string& in_data)
+    void ContentManagementSystem::OnContentDownloadComplete(u32 in_generation, u32 in_packageIndex, IContentDownloader::Result in_result, const std::string& in_data)
     {
+        if(in_generation != m_downloadGeneration || !m_downloadInProgress)
+        {
+            return;
+        }
+        
+        auto it = m_activePackageDownloads.find(in_packageIndex);
+        CS_ASSERT(it != m_activePackageDownloads.end(), "Received data for a package which isn't downloading.");
+        
+        PackageDownload& download = *it->second;
+        
+        if(in_result != IContentDownloader::Result::k_failed && in_data.empty() == false)
+        {
+            download.m_fileStream->Write(reinterpret_cast<const u8*>(in_data.data()), u64(in_data.size()));
+            download.m_hash.Update(reinterpret_cast<const u8*>(in_data.data()), u32(in_data.size()));
+            download.m_bytesWritten += in_data.size();
+        }
+        
         switch(in_result)
         {
             case IContentDownloader::Result::k_succeeded:
             {
-                if(SavePackageToFile(m_packageDetails[m_currentPackageDownload], in_data, true))
+                const auto& package = m_packageDetails[in_packageIndex];
+                bool isValid = ValidateDownloadedPackage(package, download);
+                m_activePackageDownloads.erase(it);
+                
+                if(isValid == false)
                 {
-                    m_runningDownloadedTotal += m_packageDetails[m_currentPackageDownload].m_size;
-                    
-                    //Don't overwrite the old manifest until all the content has been downloaded 
-                    if(m_currentPackageDownload >= (m_packageDetails.size() - 1))
-                    {
-                        m_downloadInProgress = false;
-                        m_onDownloadCompleteDelegate(Result::k_succeeded);
-                    }
-                    else
-                    {
-                        DownloadNextPackage();
-                    }
-                    
+                    //The package is corrupt so shouldn't be resumed.
+                    Application::Get()->GetFileSystem()->DeleteFile(StorageLocation::k_DLC, GetTempPackageFilePath(package.m_id));
+                    FailDownload();
                     break;
                 }
+                
+                m_runningDownloadedTotal += package.m_size;
+                m_numPackagesDownloaded++;
+                StartPackageDownloads();
+                break;
             }
             case IContentDownloader::Result::k_failed:
             {
-                if(m_onDownloadCompleteDelegate)
-                {
-                    m_downloadInProgress = false;
-                    m_onDownloadCompleteDelegate(Result::k_failed);
-                }
+                FailDownload();
                 break;
             }
             case IContentDownloader::Result::k_flushed:
             {
-                SavePackageToFile(m_packageDetails[m_currentPackageDownload], in_data, false);
                 break;
             }
         }
@@ -459,7 +849,117 @@ namespace ChilliSource
             return;
         }
         
-        XMLUPtr currentManifest = LoadLocalManifest();
+        m_localManifest = LoadLocalManifest();
+        
+        //Checksumming every file is slow, so all the files which will be checked are verified in
+        //parallel before the manifests are compared.
+        VerifyFilesAndCompleteDownloadList(GatherFileChecks(serverManifestRootNode));
+    }
+    //-----------------------------------------------------------
+    //-----------------------------------------------------------
+    std::vector<ContentManagementSystem::FileCheck> ContentManagementSystem::GatherFileChecks(XML::Node* in_serverManifestRootNode) const
+    {
+        //Packages which are unchanged since the local manifest are checked in DLC, anything
+        //else is checked in the bundle. This mirrors the comparison in CompleteDownloadList().
+        std::unordered_map<std::string, std::string> localPackageChecksums;
+        XML::Node* localRoot = (m_localManifest != nullptr) ? XMLUtils::GetFirstChildElement(m_localManifest->GetDocument()) : nullptr;
+        if(localRoot != nullptr)
+        {
+            XML::Node* localPackageEl = XMLUtils::GetFirstChildElement(localRoot, "Package");
+            while(localPackageEl)
+            {
+                localPackageChecksums.emplace(XMLUtils::GetAttributeValue<std::string>(localPackageEl, "ID", ""), XMLUtils::GetAttributeValue<std::string>(localPackageEl, "Checksum", ""));
+                localPackageEl = XMLUtils::GetNextSiblingElement(localPackageEl, "Package");
+            }
+        }
+        
+        std::vector<FileCheck> fileChecks;
+        XML::Node* serverPackageEl = XMLUtils::GetFirstChildElement(in_serverManifestRootNode, "Package");
+        while(serverPackageEl)
+        {
+            std::string packageId = XMLUtils::GetAttributeValue<std::string>(serverPackageEl, "ID", "");
+            std::string packageChecksum = XMLUtils::GetAttributeValue<std::string>(serverPackageEl, "Checksum", "");
+            
+            auto it = localPackageChecksums.find(packageId);
+            bool checkOnlyBundle = (localRoot == nullptr || it == localPackageChecksums.end() || it->second != packageChecksum);
+            
+            XML::Node* fileEl = XMLUtils::GetFirstChildElement(serverPackageEl, "File");
+            while(fileEl)
+            {
+                std::string location = XMLUtils::GetAttributeValue<std::string>(fileEl, "Location", "");
+                
+                FileCheck fileCheck;
+                fileCheck.m_filePath = location.empty() ? packageId + "/" + XMLUtils::GetAttributeValue<std::string>(fileEl, "Name", "") : location;
+                fileCheck.m_checksum = XMLUtils::GetAttributeValue<std::string>(fileEl, "Checksum", "");
+                fileCheck.m_checkOnlyBundle = checkOnlyBundle;
+                fileChecks.push_back(std::move(fileCheck));
+                
+                fileEl = XMLUtils::GetNextSiblingElement(fileEl, "File");
+            }
+            
+            serverPackageEl = XMLUtils::GetNextSiblingElement(serverPackageEl, "Package");
+        }
+        
+        return fileChecks;
+    }
+    //-----------------------------------------------------------
+    //-----------------------------------------------------------
+    void ContentManagementSystem::VerifyFilesAndCompleteDownloadList(std::vector<FileCheck> in_fileChecks)
+    {
+        auto fileChecks = std::make_shared<std::vector<FileCheck>>(std::move(in_fileChecks));
+        auto results = std::make_shared<std::vector<u8>>(fileChecks->size(), 0);
+        u32 generation = m_updateCheckGeneration;
+        
+        auto taskScheduler = Application::Get()->GetTaskScheduler();
+        taskScheduler->ScheduleTask(TaskType::k_large, [=](const TaskContext& in_taskContext)
+        {
+            u32 numFileChecks = u32(fileChecks->size());
+            u32 numTasks = (numFileChecks + k_filesPerVerificationBatch - 1) / k_filesPerVerificationBatch;
+            
+            //Each batch writes to its own range of the results, so no locking is needed.
+            std::vector<Task> tasks;
+            for (u32 taskIndex = 0; taskIndex < numTasks; ++taskIndex)
+            {
+                tasks.push_back([=](const TaskContext&)
+                {
+                    u32 batchStart = taskIndex * k_filesPerVerificationBatch;
+                    u32 batchEnd = std::min(batchStart + k_filesPerVerificationBatch, numFileChecks);
+                    for (u32 index = batchStart; index < batchEnd; ++index)
+                    {
+                        (*results)[index] = CheckFile((*fileChecks)[index]) ? 1 : 0;
+                    }
+                });
+            }
+            
+            if(tasks.empty() == false)
+            {
+                in_taskContext.ProcessChildTasks(tasks);
+            }
+            
+            taskScheduler->ScheduleTask(TaskType::k_mainThread, [=](const TaskContext&)
+            {
+                if(generation != m_updateCheckGeneration)
+                {
+                    return;
+                }
+                
+                for (u32 index = 0; index < numFileChecks; ++index)
+                {
+                    const auto& fileCheck = (*fileChecks)[index];
+                    m_verifiedFiles[GetFileCheckKey(fileCheck.m_filePath, fileCheck.m_checkOnlyBundle)] = ((*results)[index] != 0);
+                }
+                
+                SaveChecksumCache();
+                CompleteDownloadList();
+            });
+        });
+    }
+    //-----------------------------------------------------------
+    //-----------------------------------------------------------
+    void ContentManagementSystem::CompleteDownloadList()
+    {
+        XML::Node* serverManifestRootNode = XMLUtils::GetFirstChildElement(m_serverManifest->GetDocument());
+        XMLUPtr currentManifest = std::move(m_localManifest);
         
         //If we have not successfully loaded a manifest from file we need to check if any of the assets 
         //are in the bundle and pull down the others
@@ -588,6 +1088,8 @@ namespace ChilliSource
             RefreshIncompleteDownloadInfo();
         }
         
+        m_verifiedFiles.clear();
+        
         if(bRequiresUpdating && m_dlcCachePurged)
         {
             m_onUpdateCheckCompleteDelegate(CheckForUpdatesResult::k_availableBlocking);
@@ -646,41 +1148,35 @@ namespace ChilliSource
     }
     //-----------------------------------------------------------
     //-----------------------------------------------------------
-    bool ContentManagementSystem::SavePackageToFile(const PackageDetails& in_packageDetails, const std::string& in_zippedPackage, bool in_fullyDownloaded)
+    bool ContentManagementSystem::ValidateDownloadedPackage(const PackageDetails& in_packageDetails, PackageDownload& in_download) const
     {
-        std::string strFile = k_tempDirectory + in_packageDetails.m_id + k_packageExtensionFull;
-
-        //Append to the file as it can take multiple writes
-        auto pFileStream = Application::Get()->GetFileSystem()->CreateBinaryOutputStream(StorageLocation::k_DLC, strFile, CS::FileWriteMode::k_append);
-        if (pFileStream == nullptr)
+        in_download.m_fileStream.reset();
+        
+        std::string checksum;
+        if(m_checksumDelegate)
         {
-            CS_LOG_ERROR("CMS: " + in_packageDetails.m_id + " Couldn't write package.");
-            return false;
+            checksum = CalculateChecksum(StorageLocation::k_DLC, GetTempPackageFilePath(in_packageDetails.m_id));
+        }
+        else
+        {
+            in_download.m_hash.Final();
+            checksum = EncodeChecksum(ToHexString(in_download.m_hash));
         }
-
-        pFileStream->Write(reinterpret_cast<const u8*>(in_zippedPackage.data()), (s32)in_zippedPackage.size());
-        pFileStream.reset();
         
-        //Check if the full file has been written and perform a checksum validation 
-        if(in_fullyDownloaded)
+        if(checksum != in_packageDetails.m_checksum)
         {
-            std::string strChecksum = CalculateChecksum(StorageLocation::k_DLC, strFile);
-            if(strChecksum != in_packageDetails.m_checksum)
-            {
-                CS_LOG_ERROR("CMS: " + in_packageDetails.m_id + " Package download corrupted");
-                return false;
-            }
+            CS_LOG_ERROR("CMS: " + in_packageDetails.m_id + " Package download corrupted");
+            return false;
         }
         
         return true;
     }
-
     //-----------------------------------------------------------
     //-----------------------------------------------------------
-    void ContentManagementSystem::ExtractFilesFromPackage(const ContentManagementSystem::PackageDetails& in_packageDetails) const
+    void ContentManagementSystem::ExtractFilesFromPackage(const TaskContext& in_taskContext, const ContentManagementSystem::PackageDetails& in_packageDetails) const
     {
         //Open zip
-        std::string strZipFilePath(m_contentDirectory + "/" + k_tempDirectory + in_packageDetails.m_id + k_packageExtensionFull);
+        std::string strZipFilePath(m_contentDirectory + "/" + GetTempPackageFilePath(in_packageDetails.m_id));
         
         unzFile ZippedFile = unzOpen(strZipFilePath.c_str());
         if(!ZippedFile)
@@ -692,28 +1188,19 @@ namespace ChilliSource
         //Remove old content before installing the new stuff
         DeleteDirectory(in_packageDetails.m_id);
         
-        //Go to the first file in the zip
+        //Gather the entries and create the directory structure up front, so the entries
+        //themselves can be extracted independently.
         const u64 uddwFilenameLength = 256;
         s8 byaFileName[uddwFilenameLength];
         
+        std::vector<PackageEntry> entries;
         s32 dwStatus = unzGoToFirstFile(ZippedFile);
-        
         while(dwStatus == UNZ_OK)
         {
-            //Open the next file
-            if (unzOpenCurrentFile(ZippedFile) != UNZ_OK)
-                break;
-            
-            //Get file information
             unz_file_info FileInfo;
             unzGetCurrentFileInfo(ZippedFile, &FileInfo, byaFileName, uddwFilenameLength, nullptr, 0, nullptr, 0);
             CS_ASSERT(FileInfo.uncompressed_size < static_cast<uLong>(std::numeric_limits<u32>::max()), "File is too large. It cannot exceed " + ToString(std::numeric_limits<u32>::max()) + " bytes.");
             
-            //Load the file into memory and then save it out to the directory
-            s8* pbyDataBuffer =  new s8[FileInfo.uncompressed_size];
-            unzReadCurrentFile(ZippedFile, pbyDataBuffer, static_cast<unsigned>(FileInfo.uncompressed_size));
-            
-            //Create new stuff
             std::string strFilePath = std::string(byaFileName);
             if(ContainsDirectoryPath(strFilePath))
             {
@@ -724,17 +1211,55 @@ namespace ChilliSource
             
             if(IsFile(strFilePath))
             {
-                Application::Get()->GetFileSystem()->WriteFile(StorageLocation::k_DLC, "/" + strFilePath, pbyDataBuffer, static_cast<u32>(FileInfo.uncompressed_size));
+                PackageEntry entry;
+                unzGetFilePos(ZippedFile, &entry.m_position);
+                entry.m_filePath = strFilePath;
+                entry.m_size = u64(FileInfo.uncompressed_size);
+                entries.push_back(std::move(entry));
+                
+                InvalidateCachedChecksum(StorageLocation::k_DLC, strFilePath);
             }
             
-            //Close current file and jump to the next
-            CS_SAFEDELETE_ARRAY(pbyDataBuffer);
-            unzCloseCurrentFile(ZippedFile);
             dwStatus = unzGoToNextFile(ZippedFile);
         }
         
         //Close the zip
         unzClose(ZippedFile);
+        
+        //Batch the entries by size so that many small files don't each pay the cost of opening
+        //the zip, while large files are spread across tasks.
+        std::vector<Task> tasks;
+        std::vector<PackageEntry> batch;
+        u64 batchSize = 0;
+        for(auto& entry : entries)
+        {
+            batchSize += entry.m_size;
+            batch.push_back(std::move(entry));
+            
+            if(batch.size() >= k_maxFilesPerExtractionBatch || batchSize >= k_maxBytesPerExtractionBatch)
+            {
+                tasks.push_back([=](const TaskContext&)
+                {
+                    ExtractPackageEntries(strZipFilePath, batch);
+                });
+                
+                batch.clear();
+                batchSize = 0;
+            }
+        }
+        
+        if(batch.empty() == false)
+        {
+            tasks.push_back([=](const TaskContext&)
+            {
+                ExtractPackageEntries(strZipFilePath, batch);
+            });
+        }
+        
+        if(tasks.empty() == false)
+        {
+            in_taskContext.ProcessChildTasks(tasks);
+        }
     }
     //-----------------------------------------------------------
     //-----------------------------------------------------------
@@ -762,24 +1287,56 @@ namespace ChilliSource
     }
     //-----------------------------------------------------------
     //-----------------------------------------------------------
+    void ContentManagementSystem::SetMaxConcurrentDownloads(u32 in_maxConcurrentDownloads)
+    {
+        CS_ASSERT(in_maxConcurrentDownloads > 0, "Must allow at least one download.");
+        m_maxConcurrentDownloads = in_maxConcurrentDownloads;
+    }
+    //-----------------------------------------------------------
+    //-----------------------------------------------------------
+    u32 ContentManagementSystem::GetMaxConcurrentDownloads() const
+    {
+        return m_maxConcurrentDownloads;
+    }
+    //-----------------------------------------------------------
+    //-----------------------------------------------------------
     bool ContentManagementSystem::DoesFileExist(const std::string& in_filename, const std::string in_checksum, bool in_checkOnlyBundle) const
     {
-        if(in_checkOnlyBundle)
+        //Use the result of the parallel verification if the file has already been checked.
+        auto it = m_verifiedFiles.find(GetFileCheckKey(in_filename, in_checkOnlyBundle));
+        if(it != m_verifiedFiles.end())
         {
-            if(Application::Get()->GetFileSystem()->DoesFileExist(StorageLocation::k_package, Application::Get()->GetFileSystem()->GetPackageDLCPath() + in_filename))
+            return it->second;
+        }
+        
+        FileCheck fileCheck;
+        fileCheck.m_filePath = in_filename;
+        fileCheck.m_checksum = in_checksum;
+        fileCheck.m_checkOnlyBundle = in_checkOnlyBundle;
+        return CheckFile(fileCheck);
+    }
+    //-----------------------------------------------------------
+    //-----------------------------------------------------------
+    bool ContentManagementSystem::CheckFile(const FileCheck& in_fileCheck) const
+    {
+        auto fileSystem = Application::Get()->GetFileSystem();
+        if(in_fileCheck.m_checkOnlyBundle)
+        {
+            std::string filePath = fileSystem->GetPackageDLCPath() + in_fileCheck.m_filePath;
+            if(fileSystem->DoesFileExist(StorageLocation::k_package, filePath))
             {
                 //Check if the file has become corrupted
-                return (CalculateChecksum(StorageLocation::k_package, Application::Get()->GetFileSystem()->GetPackageDLCPath() + in_filename) == in_checksum);
+                return (CalculateCachedChecksum(StorageLocation::k_package, filePath) == in_fileCheck.m_checksum);
             }
             
             return false;
         }
         else
         {
-            if(Application::Get()->GetFileSystem()->DoesFileExist(StorageLocation::k_DLC, in_filename))
+            if(fileSystem->DoesFileExist(StorageLocation::k_DLC, in_fileCheck.m_filePath))
             {
                 //Check if the file has become corrupted
-                return (CalculateChecksum(StorageLocation::k_DLC, in_filename) == in_checksum);
+                return (CalculateCachedChecksum(StorageLocation::k_DLC, in_fileCheck.m_filePath) == in_fileCheck.m_checksum);
             }
             
             return false;
@@ -787,17 +1344,28 @@ namespace ChilliSource
     }
     //-----------------------------------------------------------
     //-----------------------------------------------------------
-    void ContentManagementSystem::OnContentDownloadProgress(const std::string& in_url, f32 in_progress)
+    void ContentManagementSystem::OnContentDownloadProgress(u32 in_generation, u32 in_packageIndex, f32 in_progress)
     {
+        if(in_generation != m_downloadGeneration)
+        {
+            return;
+        }
+        
+        CS_ASSERT(m_packageDownloadProgress.size() > in_packageIndex,
+                  "Package index out of range - " + ToString(in_packageIndex) + ", " + ToString((u32)m_packageDownloadProgress.size()));
+        
+        m_packageDownloadProgress[in_packageIndex] = in_progress;
+        
         if(m_onDownloadProgressDelegate)
         {
-            CS_ASSERT(m_packageDetails.size() > m_currentPackageDownload,
-                      "Current package index out of range - " + ToString(m_currentPackageDownload) + ", " + ToString((u32)m_packageDetails.size()));
-            
-            f32 increment = 1.0f / m_packageDetails.size();
-            f32 totalProgress = m_currentPackageDownload * increment + (in_progress * increment);
+            f32 totalProgress = 0.0f;
+            for(f32 packageProgress : m_packageDownloadProgress)
+            {
+                totalProgress += packageProgress;
+            }
+            totalProgress /= m_packageDownloadProgress.size();
             
-            m_onDownloadProgressDelegate(m_packageDetails[m_currentPackageDownload].m_id, totalProgress);
+            m_onDownloadProgressDelegate(m_packageDetails[in_packageIndex].m_id, totalProgress);
         }
     }
     //-----------------------------------------------------------
@@ -888,8 +1456,17 @@ namespace ChilliSource
                     }
                     else
                     {
-                        //Cached package is corrupt/incomplete, remove it
-                        Application::Get()->GetFileSystem()->DeleteFile(StorageLocation::k_DLC, cachedFilePath);
+                        //Incomplete packages are kept so the download can be resumed, anything
+                        //else is corrupt and is removed.
+                        u32 packageSize = XMLUtils::GetAttributeValue<u32>(serverPackageEl, "Size", 0);
+                        auto cachedFileStream = Application::Get()->GetFileSystem()->CreateBinaryInputStream(StorageLocation::k_DLC, cachedFilePath);
+                        bool isIncomplete = (cachedFileStream != nullptr && cachedFileStream->GetLength() < packageSize);
+                        cachedFileStream.reset();
+                        
+                        if(isIncomplete == false)
+                        {
+                            Application::Get()->GetFileSystem()->DeleteFile(StorageLocation::k_DLC, cachedFilePath);
+                        }
                     }
                 }
             }
@@ -35,6 +35,11 @@
 #include <ChilliSource/Core/XML/XMLUtils.h>
 #include <ChilliSource/Networking/ContentDownload/IContentDownloader.h>
 
+#include <SHA1/SHA1.h>
+
+#include <mutex>
+#include <unordered_map>
+
 namespace ChilliSource
 {
     //---------------------------------------------------------------
@@ -162,7 +167,9 @@ namespace ChilliSource
         void DownloadUpdates(const CompleteDelegate& in_delegate, const DownloadProgressDelegate& in_progressDelegate);
         //-----------------------------------------------------------
         /// Having downloaded the update packages this method
-        /// unzips the packages and overwrites any old assets
+        /// unzips the packages and overwrites any old assets.
+        /// Extraction is performed in the background, the
+        /// delegate is called on the main thread once complete.
         ///
         /// @author S Downie
         ///
@@ -170,9 +177,11 @@ namespace ChilliSource
         //-----------------------------------------------------------
         void InstallUpdates(const CompleteDelegate& in_delegate);
         //-----------------------------------------------------------
-        /// Data is cached in memory and only written to disc
-        /// when the download is successful; at which point
-        /// we can clear the data and delete any temp files
+        /// Packages are streamed to a temp directory as they
+        /// download and only installed once all have succeeded;
+        /// at which point we can clear the data. Any downloads
+        /// in progress are abandoned, though partially downloaded
+        /// packages are kept so they can be resumed.
         ///
         /// @author S Downie
         //-----------------------------------------------------------
@@ -210,11 +219,30 @@ namespace ChilliSource
         //-----------------------------------------------------------
         IContentDownloader* GetContentDownloader() const;
         //-----------------------------------------------------------
+        /// Sets a custom checksum calculation. As files are verified
+        /// in parallel this may be called from multiple background
+        /// threads at once so must be thread-safe.
+        ///
         /// @author N Tanda
         ///
         /// @param The checksum calculation delegate
         //-----------------------------------------------------------
         void SetChecksumDelegate(const ChecksumDelegate& in_delegate);
+        //-----------------------------------------------------------
+        /// Sets the maximum number of packages which will be
+        /// downloaded at the same time. This is only used if the
+        /// content downloader supports concurrent downloads,
+        /// otherwise packages are downloaded one at a time.
+        ///
+        /// @param The maximum number of concurrent downloads. Must
+        /// be at least one.
+        //-----------------------------------------------------------
+        void SetMaxConcurrentDownloads(u32 in_maxConcurrentDownloads);
+        //-----------------------------------------------------------
+        /// @return The maximum number of packages which will be
+        /// downloaded at the same time.
+        //-----------------------------------------------------------
+        u32 GetMaxConcurrentDownloads() const;
         
     private:
         //-----------------------------------------------------------
@@ -250,6 +278,38 @@ namespace ChilliSource
                 return false;
             }
         };
+        //-----------------------------------------------------------
+        /// The state of a package which is currently downloading.
+        /// Data is streamed to the temp package file as it arrives
+        /// and the SHA1 hash is updated incrementally, so the file
+        /// doesn't need to be re-read to validate it.
+        //-----------------------------------------------------------
+        struct PackageDownload final
+        {
+            BinaryOutputStreamUPtr m_fileStream;
+            CSHA1 m_hash;
+            u64 m_bytesWritten = 0;
+        };
+        //-----------------------------------------------------------
+        /// A file in the manifest which needs to be checked against
+        /// its checksum, either in the bundle or in DLC.
+        //-----------------------------------------------------------
+        struct FileCheck final
+        {
+            std::string m_filePath;
+            std::string m_checksum;
+            bool m_checkOnlyBundle = false;
+        };
+        //-----------------------------------------------------------
+        /// A cached checksum for a file, which is valid for as long
+        /// as the file's size and modification time are unchanged.
+        //-----------------------------------------------------------
+        struct ChecksumCacheEntry final
+        {
+            u64 m_size = 0;
+            s64 m_modifiedTime = 0;
+            std::string m_checksum;
+        };
         //------------------------------------------------------------
         /// Initialisation method called at a time when all App Systems
         /// have been created. System initialisation occurs in the order
@@ -287,14 +347,18 @@ namespace ChilliSource
         //-----------------------------------------------------------
         void OnContentManifestDownloadComplete(IContentDownloader::Result in_result, const std::string& in_manifest);
         //-----------------------------------------------------------
-        /// The file has downloaded we can now save it to the cache
+        /// Called as each chunk of a package is downloaded. The data
+        /// is streamed to the temp package file and validated once
+        /// the download has completed.
         ///
         /// @author S Downie
         ///
+        /// @param The download generation the request belongs to
+        /// @param Index of the package in m_packageDetails
         /// @param Request result
         /// @param Request response
         //-----------------------------------------------------------
-        void OnContentDownloadComplete(IContentDownloader::Result in_result, const std::string& in_data);
+        void OnContentDownloadComplete(u32 in_generation, u32 in_packageIndex, IContentDownloader::Result in_result, const std::string& in_data);
         //-----------------------------------------------------------
         /// Check if an existing content manifest exists and
         /// construct a list of the files that require updating
@@ -306,6 +370,28 @@ namespace ChilliSource
         //-----------------------------------------------------------
         void BuildDownloadList(const std::string& in_serverManifest);
         //-----------------------------------------------------------
+        /// Builds the list of all files the download list will need
+        /// to check, so they can be verified in parallel up front.
+        ///
+        /// @param in_serverManifestRootNode - The server manifest root
+        ///
+        /// @return The file checks.
+        //-----------------------------------------------------------
+        std::vector<FileCheck> GatherFileChecks(XML::Node* in_serverManifestRootNode) const;
+        //-----------------------------------------------------------
+        /// Verifies the given files in parallel on the large task
+        /// pool, then completes the download list on the main thread.
+        ///
+        /// @param in_fileChecks - The files to verify.
+        //-----------------------------------------------------------
+        void VerifyFilesAndCompleteDownloadList(std::vector<FileCheck> in_fileChecks);
+        //-----------------------------------------------------------
+        /// Compares the server manifest with the local manifest
+        /// using the verified file results, and notifies the update
+        /// check delegate.
+        //-----------------------------------------------------------
+        void CompleteDownloadList();
+        //-----------------------------------------------------------
         /// The package may be outdated in documents but are
         /// all the files in bundle up to date
         ///
@@ -315,25 +401,33 @@ namespace ChilliSource
         //-----------------------------------------------------------
         void AddToDownloadListIfNotInBundle(XML::Node* in_packageEl);
         //-----------------------------------------------------------
-        /// Save the zip file to documents directory
-        ///
-        /// @author S Downie
+        /// Closes the temp package file and checks it against the
+        /// checksum in the manifest.
         ///
         /// @param Package details
-        /// @param Binary zip
-        /// @param Whether the file has finished downloading
-        /// @return Success
+        /// @param The package download
+        ///
+        /// @return Whether the package is valid
         //-----------------------------------------------------------
-        bool SavePackageToFile(const PackageDetails& in_packageDetails, const std::string& in_zippedPackage, bool in_fullyDownloaded);
+        bool ValidateDownloadedPackage(const PackageDetails& in_packageDetails, PackageDownload& in_download) const;
         //-----------------------------------------------------------
         /// Unzip the package and save all the files to the
-        /// documents directory
+        /// documents directory. Independent entries are extracted in parallel, each
+        /// streamed straight to its output file.
         ///
         /// @author S Downie
         ///
+        /// @param The large task context
         /// @param Zipped package
         //-----------------------------------------------------------
-        void ExtractFilesFromPackage(const PackageDetails& in_packageDetails) const;
+        void ExtractFilesFromPackage(const TaskContext& in_taskContext, const PackageDetails& in_packageDetails) const;
+        //-----------------------------------------------------------
+        /// Removes the temp packages, writes the new manifest and
+        /// notifies the delegate once all packages are extracted.
+        ///
+        /// @param The install complete delegate
+        //-----------------------------------------------------------
+        void CompleteInstall(const CompleteDelegate& in_delegate);
         //-----------------------------------------------------------
         /// Checks whether the file is within the application and if the
         /// the checksums match
@@ -348,6 +442,15 @@ namespace ChilliSource
         //-----------------------------------------------------------
         bool DoesFileExist(const std::string& in_filename, const std::string in_checksum, bool in_checkOnlyBundle) const;
         //-----------------------------------------------------------
+        /// Performs the file check, ignoring any verified results.
+        /// This is thread-safe.
+        ///
+        /// @param in_fileCheck - The file check.
+        ///
+        /// @return Whether the file exists with the correct checksum
+        //-----------------------------------------------------------
+        bool CheckFile(const FileCheck& in_fileCheck) const;
+        //-----------------------------------------------------------
         /// Calculate a checksum for the file. Will call the custom
         /// checksum delegate if provided. Otherwise, will perform an
         /// SHA1 hash of the file and convert that to base 64 encoded
@@ -361,29 +464,62 @@ namespace ChilliSource
         //-----------------------------------------------------------
         std::string CalculateChecksum(StorageLocation in_location, const std::string& in_filePath) const;
         //-----------------------------------------------------------
-        /// Perform the HTTP request for the next DLC package.
+        /// As CalculateChecksum(), but uses the checksum cache when
+        /// the file's size and modification time haven't changed
+        /// since it was last calculated. This is thread-safe.
         ///
-        /// @author S Downie
+        /// @param File location
+        /// @param File path
+        /// @return Checksum string
+        //-----------------------------------------------------------
+        std::string CalculateCachedChecksum(StorageLocation in_location, const std::string& in_filePath) const;
         //-----------------------------------------------------------
-        void DownloadNextPackage();
+        /// Removes a file from the checksum cache. This is thread-
+        /// safe.
+        ///
+        /// @param File location
+        /// @param File path
+        //-----------------------------------------------------------
+        void InvalidateCachedChecksum(StorageLocation in_location, const std::string& in_filePath) const;
+        //-----------------------------------------------------------
+        /// Loads the persisted checksum cache from DLC.
+        //-----------------------------------------------------------
+        void LoadChecksumCache();
+        //-----------------------------------------------------------
+        /// Persists the checksum cache to DLC if it has changed.
+        //-----------------------------------------------------------
+        void SaveChecksumCache();
         //-----------------------------------------------------------
-        /// Perform the HTTP request for a DLC package.
+        /// Starts downloading packages until either the maximum
+        /// number of concurrent downloads is reached or there are
+        /// no more packages to download. Completes the download if
+        /// all packages have been downloaded.
+        //-----------------------------------------------------------
+        void StartPackageDownloads();
+        //-----------------------------------------------------------
+        /// Perform the HTTP request for a DLC package. If part of
+        /// the package has already been downloaded the download is
+        /// resumed from the end of the existing data.
         ///
         /// @author HMcLaughlin
         ///
         /// @param in_packageIndex - Index in m_packageDetails
-        /// @param in_checkCached - [Optional] Check if already cached
         //-----------------------------------------------------------
-        void DownloadPackage(u32 in_packageIndex, bool in_checkCached = true);
+        void DownloadPackage(u32 in_packageIndex);
+        //-----------------------------------------------------------
+        /// Fails the current download, notifying the delegate.
+        //-----------------------------------------------------------
+        void FailDownload();
         //-----------------------------------------------------------
         /// Callback for package download progress
         ///
         /// @author HMcLaughlin
         ///
-        /// @param in_url - Url of downloading package
+        /// @param in_generation - The download generation
+        /// @param in_packageIndex - Index in m_packageDetails
         /// @param in_progress - Progress through download (0.0f - 1.0f)
         //-----------------------------------------------------------
-        void OnContentDownloadProgress(const std::string& in_url, f32 in_progress);
+        void OnContentDownloadProgress(u32 in_generation, u32 in_packageIndex, f32 in_progress);
         //-----------------------------------------------------------
         /// Checks if there is any incomplete downloads and refresh
         /// the temporary data
@@ -423,10 +559,24 @@ namespace ChilliSource
         std::string m_serverManifestData;
         std::string m_contentDirectory;
         
-        u32 m_currentPackageDownload = 0;
+        std::unordered_map<u32, std::unique_ptr<PackageDownload>> m_activePackageDownloads;
+        std::vector<f32> m_packageDownloadProgress;
+        u32 m_nextPackageDownload = 0;
+        u32 m_numPackagesDownloaded = 0;
+        u32 m_maxConcurrentDownloads = 3;
+        u32 m_downloadGeneration = 0;
+        
+        XMLUPtr m_localManifest;
+        std::unordered_map<std::string, bool> m_verifiedFiles;
+        u32 m_updateCheckGeneration = 0;
+        
+        mutable std::mutex m_checksumCacheMutex;
+        mutable std::unordered_map<std::string, ChecksumCacheEntry> m_checksumCache;
+        mutable bool m_checksumCacheDirty = false;
         
         bool m_dlcCachePurged = false;
         bool m_downloadInProgress = false;
+        bool m_installInProgress = false;
     };
 }
 
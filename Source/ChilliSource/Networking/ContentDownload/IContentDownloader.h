@@ -31,7 +31,9 @@
 
 #include <ChilliSource/ChilliSource.h>
 
+#include <algorithm>
 #include <functional>
+#include <memory>
 
 namespace ChilliSource
 {
@@ -59,7 +61,13 @@ namespace ChilliSource
         };
         //----------------------------------------------------------
         /// A delegate that can be used to get the response from a
-        /// download request.
+        /// download request. Any number of k_flushed results may be
+        /// followed by a single k_succeeded or k_failed result.
+        ///
+        /// A response with a status other than 2xx is reported as
+        /// k_failed, with no data, as its body is an error rather
+        /// than the requested content. Nothing further is reported
+        /// for the request after that.
         ///
         /// @param The result of the request
         /// @param The response string.
@@ -97,6 +105,46 @@ namespace ChilliSource
         //---------------------------------------------------------
         virtual void DownloadPackage(const std::string& in_url, const Delegate& in_delegate, const DownloadProgressDelegate& in_progressDelegate) = 0;
         //---------------------------------------------------------
+        /// Resumes the download of a partially downloaded package
+        /// from the given byte offset. The delegate only receives
+        /// the data following the offset.
+        ///
+        /// The default implementation downloads the full package
+        /// and discards the data preceding the offset. Downloaders
+        /// which can make ranged requests should override this.
+        ///
+        /// @param URL string
+        /// @param The number of bytes already downloaded.
+        /// @param Delegate
+        /// @param Download Progress Delegate
+        //---------------------------------------------------------
+        virtual void ResumePackageDownload(const std::string& in_url, u64 in_offset, const Delegate& in_delegate, const DownloadProgressDelegate& in_progressDelegate)
+        {
+            auto bytesToSkip = std::make_shared<u64>(in_offset);
+            DownloadPackage(in_url, [=](Result in_result, const std::string& in_data)
+            {
+                if (*bytesToSkip == 0 || in_result == Result::k_failed)
+                {
+                    in_delegate(in_result, in_data);
+                    return;
+                }
+                
+                u64 skipped = std::min(*bytesToSkip, u64(in_data.size()));
+                *bytesToSkip -= skipped;
+                in_delegate(in_result, in_data.substr(std::size_t(skipped)));
+            }, in_progressDelegate);
+        }
+        //---------------------------------------------------------
+        /// Whether or not DownloadPackage() can be called again
+        /// before previous package downloads have completed. If
+        /// not, the Content Management System will download one
+        /// package at a time.
+        ///
+        /// @return Whether concurrent package downloads are
+        /// supported.
+        //---------------------------------------------------------
+        virtual bool SupportsConcurrentDownloads() const { return false; }
+        //---------------------------------------------------------
         /// The destructor.
         ///
         /// @author S Downie
@@ -35,14 +35,37 @@
 
 #include <json/json.h>
 
+#include <algorithm>
+
 namespace ChilliSource
 {
     const f32 k_downloadProgressUpdateIntervalDefault = 1.0f / 30.0f;
     
+    namespace
+    {
+        //----------------------------------------------------------------
+        /// @param The response.
+        ///
+        /// @return Whether the response was received with a status other
+        /// than 2xx, in which case its body is an error rather than the
+        /// requested content.
+        //----------------------------------------------------------------
+        bool IsErrorStatus(const HttpResponse& in_response)
+        {
+            auto result = in_response.GetResult();
+            if (result != HttpResponse::Result::k_completed && result != HttpResponse::Result::k_flushed)
+            {
+                return false;
+            }
+            
+            return in_response.GetCode() < 200 || in_response.GetCode() >= 300;
+        }
+    }
+    
     //----------------------------------------------------------------
     //----------------------------------------------------------------
     MoContentDownloader::MoContentDownloader(HttpRequestSystem* inpRequestSystem, const std::string& instrAssetServerURL, const std::vector<std::string>& inastrTags)
-    : mpHttpRequestSystem(inpRequestSystem), mstrAssetServerURL(instrAssetServerURL), mastrTags(inastrTags)
+    : mastrTags(inastrTags), mstrAssetServerURL(instrAssetServerURL), mpHttpRequestSystem(inpRequestSystem)
     {
         m_downloadProgressUpdateTimer = TimerSPtr(new Timer());
     }
@@ -80,7 +103,7 @@ namespace ChilliSource
                 JDeviceData["Tags"] = JTags;
                 
                 Json::FastWriter JWriter;
-                mpHttpRequestSystem->MakePostRequest(mstrAssetServerURL, JWriter.write(JDeviceData), MakeDelegate(this, &MoContentDownloader::OnContentManifestDownloadComplete));
+                m_manifestRequest = mpHttpRequestSystem->MakePostRequest(mstrAssetServerURL, JWriter.write(JDeviceData), MakeDelegate(this, &MoContentDownloader::OnContentManifestDownloadComplete));
             }
         });
     }
@@ -88,138 +111,237 @@ namespace ChilliSource
     //----------------------------------------------------------------
     void MoContentDownloader::DownloadPackage(const std::string& in_url, const Delegate& in_completiondelegate, const DownloadProgressDelegate& in_progressDelegate)
     {
-        mOnContentDownloadCompleteDelegate = in_completiondelegate;
-        mpCurrentRequest = mpHttpRequestSystem->MakeGetRequest(in_url, MakeDelegate(this, &MoContentDownloader::OnContentDownloadComplete));
+        StartPackageDownload(in_url, 0, in_completiondelegate, in_progressDelegate);
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void MoContentDownloader::ResumePackageDownload(const std::string& in_url, u64 in_offset, const Delegate& in_completiondelegate, const DownloadProgressDelegate& in_progressDelegate)
+    {
+        StartPackageDownload(in_url, in_offset, in_completiondelegate, in_progressDelegate);
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void MoContentDownloader::StartPackageDownload(const std::string& in_url, u64 in_offset, const Delegate& in_completiondelegate, const DownloadProgressDelegate& in_progressDelegate)
+    {
+        u32 downloadId = m_nextPackageDownloadId++;
+        
+        PackageDownload& download = m_packageDownloads[downloadId];
+        download.m_url = in_url;
+        download.m_completionDelegate = in_completiondelegate;
+        download.m_progressDelegate = in_progressDelegate;
+        download.m_offset = in_offset;
         
-        //Reset the timer
-        m_downloadProgressUpdateTimer->Reset();
-        m_downloadProgressEventConnection = m_downloadProgressUpdateTimer->OpenConnection(k_downloadProgressUpdateIntervalDefault, [=]()
+        auto responseDelegate = [=](const HttpRequest*, const HttpResponse& in_response)
         {
-            if(in_progressDelegate)
-            {
-                in_progressDelegate(in_url, GetDownloadProgress());
-            }
-        });
+            OnContentDownloadComplete(downloadId, in_response);
+        };
         
-        m_downloadProgressUpdateTimer->Start();
+        HttpRequest* request = nullptr;
+        if (in_offset > 0)
+        {
+            ParamDictionary headers;
+            headers.SetValue("Range", "bytes=" + ToString(in_offset) + "-");
+            request = mpHttpRequestSystem->MakeGetRequest(in_url, headers, responseDelegate);
+        }
+        else
+        {
+            request = mpHttpRequestSystem->MakeGetRequest(in_url, responseDelegate);
+        }
+        
+        //The request may have already completed and been removed.
+        auto it = m_packageDownloads.find(downloadId);
+        if (it != m_packageDownloads.end())
+        {
+            it->second.m_request = request;
+        }
+        
+        //A single timer reports the progress of all active downloads.
+        if (m_downloadProgressEventConnection == nullptr && m_packageDownloads.empty() == false)
+        {
+            m_downloadProgressUpdateTimer->Reset();
+            m_downloadProgressEventConnection = m_downloadProgressUpdateTimer->OpenConnection(k_downloadProgressUpdateIntervalDefault, MakeDelegate(this, &MoContentDownloader::OnDownloadProgressUpdate));
+            m_downloadProgressUpdateTimer->Start();
+        }
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    void MoContentDownloader::OnContentManifestDownloadComplete(const HttpRequest* in_request, const HttpResponse& in_response)
+    void MoContentDownloader::OnContentManifestDownloadComplete(const HttpRequest*, const HttpResponse& in_response)
     {
+        if(IsErrorStatus(in_response))
+        {
+            CS_LOG_ERROR("Content manifest request failed with status " + ToString(in_response.GetCode()) + ".");
+            
+            //Only the first part of a flushed error is reported.
+            if(in_response.GetResult() == HttpResponse::Result::k_flushed)
+            {
+                m_manifestRequest->Cancel();
+            }
+            m_manifestRequest = nullptr;
+            
+            mOnContentManifestDownloadCompleteDelegate(Result::k_failed, "");
+            return;
+        }
+        
         switch(in_response.GetResult())
         {
             case HttpResponse::Result::k_completed:
             {
-                //Check the response code for errors
-                switch(in_response.GetCode())
-                {
-                    default:   //OK 
-                    case HttpResponseCode::k_ok:
-                    {
-                        mOnContentManifestDownloadCompleteDelegate(Result::k_succeeded, in_response.GetDataAsString());
-                        break;
-                    }
-                    case HttpResponseCode::k_error:      //Error
-                    case HttpResponseCode::k_unavailable://Temporary error try again later
-                    case HttpResponseCode::k_notFound:   //End point doesn't exist
-                    {
-                        mOnContentManifestDownloadCompleteDelegate(Result::k_failed, in_response.GetDataAsString());
-                        break;
-                    }
-                }
+                m_manifestRequest = nullptr;
+                mOnContentManifestDownloadCompleteDelegate(Result::k_succeeded, in_response.GetDataAsString());
                 break;
             }
             case HttpResponse::Result::k_timeout:
             case HttpResponse::Result::k_failed:
+            case HttpResponse::Result::k_unsupported:
             {
-                mOnContentManifestDownloadCompleteDelegate(Result::k_failed, in_response.GetDataAsString());
+                m_manifestRequest = nullptr;
+                mOnContentManifestDownloadCompleteDelegate(Result::k_failed, "");
                 break;
             }
             case HttpResponse::Result::k_flushed:
             {
-                //Check the response code for errors
-                switch(in_response.GetCode())
-                {
-                    default:   //OK 
-                    case HttpResponseCode::k_ok:
-                    {
-                        mOnContentManifestDownloadCompleteDelegate(Result::k_flushed, in_response.GetDataAsString());
-                        break;
-                    }
-                    case HttpResponseCode::k_error:      //Error
-                    case HttpResponseCode::k_unavailable://Temporary error try again later
-                    case HttpResponseCode::k_notFound:   //End point doesn't exist
-                    {
-                        mOnContentManifestDownloadCompleteDelegate(Result::k_failed, in_response.GetDataAsString());
-                        break;
-                    }
-                }
+                mOnContentManifestDownloadCompleteDelegate(Result::k_flushed, in_response.GetDataAsString());
                 break;
             }
         }
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    void MoContentDownloader::OnContentDownloadComplete(const HttpRequest* in_request, const HttpResponse& in_response)
+    void MoContentDownloader::OnContentDownloadComplete(u32 in_downloadId, const HttpResponse& in_response)
     {
-        if(in_response.GetResult() != HttpResponse::Result::k_flushed)
+        auto it = m_packageDownloads.find(in_downloadId);
+        if(it == m_packageDownloads.end())
+        {
+            return;
+        }
+        
+        PackageDownload& download = it->second;
+        
+        //An error status means the body is an error page rather than package data, so none of it is
+        //passed on. The request is cancelled if more of it would follow.
+        bool isErrorStatus = IsErrorStatus(in_response);
+        if(isErrorStatus)
         {
-            if(mpCurrentRequest == in_request)
+            CS_LOG_ERROR("Package download '" + download.m_url + "' failed with status " + ToString(in_response.GetCode()) + ".");
+            
+            if(in_response.GetResult() == HttpResponse::Result::k_flushed && download.m_request)
             {
-                mpCurrentRequest = nullptr;
+                download.m_request->Cancel();
             }
+        }
         
-            if(m_downloadProgressUpdateTimer)
+        //If the server ignored the range of a resumed download the full package
+        //is being sent, so the data we already have must be skipped.
+        if(download.m_receivedResponse == false && isErrorStatus == false && (in_response.GetResult() == HttpResponse::Result::k_completed || in_response.GetResult() == HttpResponse::Result::k_flushed))
+        {
+            download.m_receivedResponse = true;
+            download.m_isPartialContent = (in_response.GetCode() == HttpResponseCode::k_partialContent);
+            if(download.m_offset > 0 && download.m_isPartialContent == false)
+            {
+                download.m_bytesToSkip = download.m_offset;
+            }
+        }
+        
+        const std::string* outputData = &in_response.GetDataAsString();
+        std::string remainingData;
+        if(download.m_bytesToSkip > 0)
+        {
+            u64 skipped = std::min(download.m_bytesToSkip, u64(outputData->size()));
+            download.m_bytesToSkip -= skipped;
+            remainingData = outputData->substr(std::size_t(skipped));
+            outputData = &remainingData;
+        }
+        
+        //Take a copy of the delegate as it may start a new download, invalidating the reference.
+        Delegate completionDelegate = download.m_completionDelegate;
+        if(in_response.GetResult() != HttpResponse::Result::k_flushed || isErrorStatus)
+        {
+            m_packageDownloads.erase(it);
+        
+            if(m_packageDownloads.empty() && m_downloadProgressUpdateTimer)
             {
                 m_downloadProgressEventConnection.reset();
                 m_downloadProgressUpdateTimer->Stop();
             }
         }
         
+        if(isErrorStatus)
+        {
+            completionDelegate(Result::k_failed, "");
+            return;
+        }
+        
         switch(in_response.GetResult())
         {
             case HttpResponse::Result::k_completed:
             {
-                // Check the response code for errors
-                switch(in_response.GetCode())
-                {
-                    default:   //OK
-                    case HttpResponseCode::k_ok:
-                        mOnContentDownloadCompleteDelegate(Result::k_succeeded, in_response.GetDataAsString());
-                        break;
-                }
+                completionDelegate(Result::k_succeeded, *outputData);
                 break;
             }
             case HttpResponse::Result::k_timeout:
             case HttpResponse::Result::k_failed:
+            case HttpResponse::Result::k_unsupported:
             {
-                mOnContentDownloadCompleteDelegate(Result::k_failed, in_response.GetDataAsString());
+                completionDelegate(Result::k_failed, "");
                 break;
             }
             case HttpResponse::Result::k_flushed:
             {
-                mOnContentDownloadCompleteDelegate(Result::k_flushed, in_response.GetDataAsString());
+                completionDelegate(Result::k_flushed, *outputData);
                 break;
             }
         }
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
+    void MoContentDownloader::OnDownloadProgressUpdate()
+    {
+        //Copy the delegates first as they may modify the active downloads.
+        std::vector<std::pair<DownloadProgressDelegate, std::pair<std::string, f32>>> progressUpdates;
+        for(const auto& downloadPair : m_packageDownloads)
+        {
+            const PackageDownload& download = downloadPair.second;
+            if(download.m_progressDelegate && download.m_request)
+            {
+                f32 progress = 0.0f;
+                u64 expectedSize = download.m_request->GetExpectedSize();
+                if(expectedSize > 0)
+                {
+                    //A ranged request only reports the size of the remaining data.
+                    u64 resumedBytes = download.m_isPartialContent ? download.m_offset : 0;
+                    progress = f32(resumedBytes + download.m_request->GetDownloadedBytes()) / f32(resumedBytes + expectedSize);
+                }
+                
+                progressUpdates.push_back(std::make_pair(download.m_progressDelegate, std::make_pair(download.m_url, progress)));
+            }
+        }
+        
+        for(const auto& update : progressUpdates)
+        {
+            update.first(update.second.first, update.second.second);
+        }
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
     f32 MoContentDownloader::GetDownloadProgress() const
     {
-        f32 progress = 0.0f;
+        u64 expectedSize = 0;
+        u64 downloadedBytes = 0;
         
-        // Check if there is an active request
-        if(mpCurrentRequest)
+        for(const auto& downloadPair : m_packageDownloads)
         {
-            if(mpCurrentRequest->GetExpectedSize() > 0)
+            if(downloadPair.second.m_request)
             {
-                // Calculate current scene download progress
-                progress = (f32)mpCurrentRequest->GetDownloadedBytes() / (f32)mpCurrentRequest->GetExpectedSize();
+                expectedSize += downloadPair.second.m_request->GetExpectedSize();
+                downloadedBytes += downloadPair.second.m_request->GetDownloadedBytes();
             }
         }
         
-        return progress;
+        if(expectedSize > 0)
+        {
+            return (f32)downloadedBytes / (f32)expectedSize;
+        }
+        
+        return 0.0f;
     }
-}
\ No newline at end of file
+}
@@ -34,6 +34,8 @@
 #include <ChilliSource/Networking/ContentDownload/IContentDownloader.h>
 #include <ChilliSource/Networking/Http/HttpRequestSystem.h>
 
+#include <unordered_map>
+
 namespace ChilliSource
 {
     class MoContentDownloader final : public IContentDownloader
@@ -65,7 +67,22 @@ namespace ChilliSource
         /// @param in_completiondelegate - Delegate to call on completion
         /// @param in_progressDelegate - Download Progress Delegate
         //----------------------------------------------------------------
-        void DownloadPackage(const std::string& in_url, const Delegate& in_completiondelegate, const DownloadProgressDelegate& in_progressDelegate);
+        void DownloadPackage(const std::string& in_url, const Delegate& in_completiondelegate, const DownloadProgressDelegate& in_progressDelegate) override;
+        //----------------------------------------------------------------
+        /// Resumes a package download from the given offset using a
+        /// ranged request. If the server ignores the range the data
+        /// preceding the offset is discarded.
+        ///
+        /// @param in_url - Url to download
+        /// @param in_offset - The number of bytes already downloaded
+        /// @param in_completiondelegate - Delegate to call on completion
+        /// @param in_progressDelegate - Download Progress Delegate
+        //----------------------------------------------------------------
+        void ResumePackageDownload(const std::string& in_url, u64 in_offset, const Delegate& in_completiondelegate, const DownloadProgressDelegate& in_progressDelegate) override;
+        //----------------------------------------------------------------
+        /// @return True, each package download tracks its own state.
+        //----------------------------------------------------------------
+        bool SupportsConcurrentDownloads() const override { return true; }
         //----------------------------------------------------------------
         /// Get Tags
         ///
@@ -81,11 +98,35 @@ namespace ChilliSource
         //------------------------------------------------------------
         /// @author HMcLaughlin
         ///
-        /// @return The progress of the current package
+        /// @return The combined progress of all active package
+        /// downloads.
         //------------------------------------------------------------
         f32 GetDownloadProgress() const;
         
     private:
+        //----------------------------------------------------------------
+        /// The state of a single in flight package download.
+        //----------------------------------------------------------------
+        struct PackageDownload final
+        {
+            std::string m_url;
+            Delegate m_completionDelegate;
+            DownloadProgressDelegate m_progressDelegate;
+            HttpRequest* m_request = nullptr;
+            u64 m_offset = 0;
+            u64 m_bytesToSkip = 0;
+            bool m_receivedResponse = false;
+            bool m_isPartialContent = false;
+        };
+        //----------------------------------------------------------------
+        /// Starts a package download, optionally from an offset.
+        ///
+        /// @param in_url - Url to download
+        /// @param in_offset - The number of bytes already downloaded
+        /// @param in_completiondelegate - Delegate to call on completion
+        /// @param in_progressDelegate - Download Progress Delegate
+        //----------------------------------------------------------------
+        void StartPackageDownload(const std::string& in_url, u64 in_offset, const Delegate& in_completiondelegate, const DownloadProgressDelegate& in_progressDelegate);
         //----------------------------------------------------------------
         /// Triggered when the manifest download has completed
         ///
@@ -96,14 +137,18 @@ namespace ChilliSource
         //----------------------------------------------------------------
         void OnContentManifestDownloadComplete(const HttpRequest* in_request, const HttpResponse& in_response);
         //----------------------------------------------------------------
-        /// Triggered when a package download has completed
+        /// Triggered when a package download has completed or flushed
         ///
         /// @author S Downie
         ///
-        /// @param Original request
+        /// @param The id of the package download
         /// @param Request response
         //----------------------------------------------------------------
-        void OnContentDownloadComplete(const HttpRequest* in_request, const HttpResponse& in_response);
+        void OnContentDownloadComplete(u32 in_downloadId, const HttpResponse& in_response);
+        //----------------------------------------------------------------
+        /// Reports the progress of each active package download.
+        //----------------------------------------------------------------
+        void OnDownloadProgressUpdate();
         
     private:
         
@@ -111,11 +156,12 @@ namespace ChilliSource
         
         std::string mstrAssetServerURL;
         Delegate mOnContentManifestDownloadCompleteDelegate;
-        Delegate mOnContentDownloadCompleteDelegate;
+        HttpRequest* m_manifestRequest = nullptr;
         
         HttpRequestSystem* mpHttpRequestSystem;
         
-        HttpRequest* mpCurrentRequest;
+        std::unordered_map<u32, PackageDownload> m_packageDownloads;
+        u32 m_nextPackageDownloadId = 0;
         
         TimerSPtr m_downloadProgressUpdateTimer;
         EventConnectionUPtr m_downloadProgressEventConnection;
@@ -47,6 +47,7 @@ namespace ChilliSource
     CS_FORWARDDECLARE_CLASS(HttpRequestSystem);
     CS_FORWARDDECLARE_CLASS(HttpRequest);
     CS_FORWARDDECLARE_CLASS(HttpResponse);
+    CS_FORWARDDECLARE_CLASS(HttpResponseCache);
     //--------------------------------------------------
     /// IAP
     //--------------------------------------------------
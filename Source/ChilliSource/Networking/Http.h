@@ -34,5 +34,6 @@
 #include <ChilliSource/Networking/Http/HttpRequest.h>
 #include <ChilliSource/Networking/Http/HttpRequestSystem.h>
 #include <ChilliSource/Networking/Http/HttpResponse.h>
+#include <ChilliSource/Networking/Http/HttpResponseCache.h>
 
 #endif
@@ -28,15 +28,13 @@
 
 #include <ChilliSource/Networking/Http/HttpRequestSystem.h>
 
-#ifdef CS_TARGETPLATFORM_IOS
+#if defined(CS_ENABLE_POSIXHTTP)
+#include <CSBackend/Networking/POSIX/Http/HttpRequestSystem.h>
+#elif defined(CS_TARGETPLATFORM_IOS)
 #include <CSBackend/Platform/iOS/Networking/Http/HttpRequestSystem.h>
-#endif
-
-#ifdef CS_TARGETPLATFORM_ANDROID
+#elif defined(CS_TARGETPLATFORM_ANDROID)
 #include <CSBackend/Platform/Android/Main/JNI/Networking/Http/HttpRequestSystem.h>
-#endif
-
-#ifdef CS_TARGETPLATFORM_WINDOWS
+#elif defined(CS_TARGETPLATFORM_WINDOWS)
 #include <CSBackend/Platform/Windows/Networking/Http/HttpRequestSystem.h>
 #endif
 
@@ -48,16 +46,17 @@ namespace ChilliSource
     //-------------------------------------------------------
     HttpRequestSystemUPtr HttpRequestSystem::Create()
     {
-#ifdef CS_TARGETPLATFORM_IOS
+#if defined(CS_ENABLE_POSIXHTTP)
+        return HttpRequestSystemUPtr(new CSBackend::POSIX::HttpRequestSystem());
+#elif defined(CS_TARGETPLATFORM_IOS)
         return HttpRequestSystemUPtr(new CSBackend::iOS::HttpRequestSystem());
-#endif
-#ifdef CS_TARGETPLATFORM_ANDROID
+#elif defined(CS_TARGETPLATFORM_ANDROID)
         return HttpRequestSystemUPtr(new CSBackend::Android::HttpRequestSystem());
-#endif
-#ifdef CS_TARGETPLATFORM_WINDOWS
+#elif defined(CS_TARGETPLATFORM_WINDOWS)
         return HttpRequestSystemUPtr(new CSBackend::Windows::HttpRequestSystem());
-#endif
+#else
         return nullptr;
+#endif
     }
     //--------------------------------------------------------------------------------------------------
     /// @author S Downie
@@ -28,6 +28,8 @@
 
 #include <ChilliSource/Networking/Http/HttpResponse.h>
 
+#include <ChilliSource/Core/String/StringUtils.h>
+
 #include <limits>
 
 namespace ChilliSource
@@ -42,6 +44,14 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
+    HttpResponse::HttpResponse(Result in_result, u32 in_code, const std::string& in_data, const ParamDictionary& in_headers)
+    : m_data(in_data), m_result(in_result), m_code(in_code), m_headers(in_headers)
+    {
+        CS_ASSERT(m_data.size() < static_cast<std::string::size_type>(std::numeric_limits<u32>::max()), "Response data is too large. Cannot exceed "
+                  + ToString(std::numeric_limits<u32>::max()) + " bytes.");
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
     HttpResponse::Result HttpResponse::GetResult() const
     {
         return m_result;
@@ -70,4 +80,36 @@ namespace ChilliSource
     {
         return m_code;
     }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    const ParamDictionary& HttpResponse::GetHeaders() const
+    {
+        return m_headers;
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    bool HttpResponse::TryGetHeader(const std::string& in_name, std::string& out_value) const
+    {
+        if (m_headers.TryGetValue(in_name, out_value) == true)
+        {
+            return true;
+        }
+        
+        std::string name = in_name;
+        StringUtils::ToLowerCase(name);
+        
+        for (const auto& header : m_headers)
+        {
+            std::string headerName = header.first;
+            StringUtils::ToLowerCase(headerName);
+            
+            if (headerName == name)
+            {
+                out_value = header.second;
+                return true;
+            }
+        }
+        
+        return false;
+    }
 }
@@ -30,6 +30,7 @@
 #define _CHILLISOURCE_NETWORKING_HTTP_HTTPRESPONSE_H_
 
 #include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Container/ParamDictionary.h>
 
 namespace ChilliSource
 {
@@ -53,7 +54,8 @@ namespace ChilliSource
             k_completed,    //The request completed (response data is available)
             k_failed,       //The request failed (no response data available)
             k_timeout,      //The request timed out (no response data available)
-            k_flushed       //The request buffer is full and has been flushed. (response data is partial and more will follow)
+            k_flushed,      //The request buffer is full and has been flushed. (response data is partial and more will follow)
+            k_unsupported   //The request was not made as the url scheme is not supported by the backend (no response data available)
         };
         //----------------------------------------------------------------------------------------
         /// Constructor
@@ -66,6 +68,15 @@ namespace ChilliSource
         //----------------------------------------------------------------------------------------
         HttpResponse(Result in_result, u32 in_responseCode, const std::string& in_data);
         //----------------------------------------------------------------------------------------
+        /// Constructor
+        ///
+        /// @param Result
+        /// @param Response code
+        /// @param Response data
+        /// @param Response headers
+        //----------------------------------------------------------------------------------------
+        HttpResponse(Result in_result, u32 in_responseCode, const std::string& in_data, const ParamDictionary& in_headers);
+        //----------------------------------------------------------------------------------------
         /// @author S Downie
         ///
         /// @return The result of the request (determines whether data is available)
@@ -96,12 +107,28 @@ namespace ChilliSource
         /// @return HTTP response code (i.e. 200 = OK).
         //----------------------------------------------------------------------------------------
         u32 GetCode() const;
+        //----------------------------------------------------------------------------------------
+        /// @return The response headers. These are only provided with the final response of a
+        /// request, not with flushed responses, and may be empty if the request failed.
+        //----------------------------------------------------------------------------------------
+        const ParamDictionary& GetHeaders() const;
+        //----------------------------------------------------------------------------------------
+        /// Looks up a response header. Header names are case insensitive, so this should be
+        /// used in preference to querying the headers directly.
+        ///
+        /// @param The header name.
+        /// @param [Out] The header value, if found.
+        ///
+        /// @return Whether the header was found.
+        //----------------------------------------------------------------------------------------
+        bool TryGetHeader(const std::string& in_name, std::string& out_value) const;
         
     private:
         
         const std::string m_data;
         const Result m_result;
         const u32 m_code;
+        const ParamDictionary m_headers;
     };
 }
 
@@ -0,0 +1,788 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Networking/Http/HttpResponseCache.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Cryptographic/HashCRC32.h>
+#include <ChilliSource/Core/Cryptographic/HashMD5.h>
+#include <ChilliSource/Core/File/FileSystem.h>
+#include <ChilliSource/Core/String/StringUtils.h>
+#include <ChilliSource/Core/Threading/TaskScheduler.h>
+#include <ChilliSource/Networking/Http/HttpResponse.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace ChilliSource
+{
+    namespace
+    {
+        const std::string k_directoryPath = "HttpCache/";
+        const std::string k_fileExtension = ".cache";
+        const std::string k_tempFileExtension = ".tmp";
+        
+        const u32 k_entryId = 0x43485343; //"CSHC"
+        const u32 k_formatVersion = 1;
+        const u32 k_entryHeaderSize = 4 * sizeof(u32);
+        
+        //--------------------------------------------------------------------------------------------------
+        /// Reads primitives from a block of data, failing rather than reading past the end of it.
+        //--------------------------------------------------------------------------------------------------
+        class EntryReader final
+        {
+        public:
+            EntryReader(const u8* in_data, u32 in_size)
+                : m_data(in_data), m_remaining(in_size)
+            {
+            }
+            
+            template <typename TType> bool Read(TType& out_value)
+            {
+                if (m_remaining < sizeof(TType))
+                {
+                    return false;
+                }
+                
+                memcpy(&out_value, m_data, sizeof(TType));
+                m_data += sizeof(TType);
+                m_remaining -= sizeof(TType);
+                return true;
+            }
+            
+            bool ReadString(std::string& out_value)
+            {
+                u32 length = 0;
+                if (!Read(length) || length > m_remaining)
+                {
+                    return false;
+                }
+                
+                out_value.assign(reinterpret_cast<const s8*>(m_data), length);
+                m_data += length;
+                m_remaining -= length;
+                return true;
+            }
+            
+        private:
+            const u8* m_data;
+            u32 m_remaining;
+        };
+        //--------------------------------------------------------------------------------------------------
+        /// Appends the bytes of the given primitive to the output data.
+        ///
+        /// @param The value to write.
+        /// @param [Out] The data to append to.
+        //--------------------------------------------------------------------------------------------------
+        template <typename TType> void WritePrimitive(TType in_value, std::vector<u8>& out_data)
+        {
+            const u8* bytes = reinterpret_cast<const u8*>(&in_value);
+            out_data.insert(out_data.end(), bytes, bytes + sizeof(TType));
+        }
+        //--------------------------------------------------------------------------------------------------
+        /// Appends the given string, prefixed by its length, to the output data.
+        ///
+        /// @param The value to write.
+        /// @param [Out] The data to append to.
+        //--------------------------------------------------------------------------------------------------
+        void WriteString(const std::string& in_value, std::vector<u8>& out_data)
+        {
+            WritePrimitive(u32(in_value.size()), out_data);
+            out_data.insert(out_data.end(), in_value.begin(), in_value.end());
+        }
+        //--------------------------------------------------------------------------------------------------
+        /// @param URL
+        ///
+        /// @return The path of the file in which the response for the given url is cached.
+        //--------------------------------------------------------------------------------------------------
+        std::string GetEntryFilePath(const std::string& in_url)
+        {
+            return k_directoryPath + HashMD5::GenerateHexHashCode(in_url) + k_fileExtension;
+        }
+        //--------------------------------------------------------------------------------------------------
+        /// @param The headers.
+        ///
+        /// @return A copy of the headers with lower case names, so they can be looked up directly.
+        //--------------------------------------------------------------------------------------------------
+        ParamDictionary NormaliseHeaders(const ParamDictionary& in_headers)
+        {
+            ParamDictionary output;
+            for (const auto& header : in_headers)
+            {
+                std::string name = header.first;
+                StringUtils::ToLowerCase(name);
+                output.SetValue(name, header.second);
+            }
+            
+            return output;
+        }
+        //--------------------------------------------------------------------------------------------------
+        /// Overwrites the stored headers with those in a 304 response, as described in RFC 7234.
+        ///
+        /// @param The updated headers.
+        /// @param [In/Out] The stored headers.
+        //--------------------------------------------------------------------------------------------------
+        void MergeHeaders(const ParamDictionary& in_updatedHeaders, ParamDictionary& inout_headers)
+        {
+            for (const auto& updatedHeader : in_updatedHeaders)
+            {
+                std::string updatedName = updatedHeader.first;
+                StringUtils::ToLowerCase(updatedName);
+                
+                for (auto it = inout_headers.begin(); it != inout_headers.end();)
+                {
+                    std::string name = it->first;
+                    StringUtils::ToLowerCase(name);
+                    it = (name == updatedName) ? inout_headers.erase(it) : std::next(it);
+                }
+                
+                inout_headers.SetValue(updatedHeader.first, updatedHeader.second);
+            }
+        }
+        //--------------------------------------------------------------------------------------------------
+        /// Splits a Cache-Control header into its directives. Names are lower case and values have any
+        /// quotes removed.
+        ///
+        /// @param The header value.
+        ///
+        /// @return The directives.
+        //--------------------------------------------------------------------------------------------------
+        ParamDictionary ParseCacheControl(const std::string& in_cacheControl)
+        {
+            ParamDictionary output;
+            for (auto directive : StringUtils::Split(in_cacheControl, ","))
+            {
+                StringUtils::Trim(directive);
+                
+                auto separator = directive.find('=');
+                std::string name = directive.substr(0, separator);
+                std::string value = (separator != std::string::npos) ? directive.substr(separator + 1) : "";
+                StringUtils::Trim(name);
+                StringUtils::Trim(value);
+                StringUtils::ToLowerCase(name);
+                
+                if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+                {
+                    value = value.substr(1, value.size() - 2);
+                }
+                
+                output.SetValue(name, value);
+            }
+            
+            return output;
+        }
+        //--------------------------------------------------------------------------------------------------
+        /// Parses a HTTP date in the preferred RFC 7231 format, e.g. "Sun, 06 Nov 1994 08:49:37 GMT".
+        ///
+        /// @param The date string.
+        /// @param [Out] The date in seconds since the epoch.
+        ///
+        /// @return Whether the date could be parsed.
+        //--------------------------------------------------------------------------------------------------
+        bool ParseHttpDate(const std::string& in_date, TimeIntervalSecs& out_time)
+        {
+            const char* k_months[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+            
+            char monthName[4] = {};
+            s32 day = 0, year = 0, hours = 0, minutes = 0, seconds = 0;
+            if (sscanf(in_date.c_str(), "%*3s, %2d %3s %4d %2d:%2d:%2d", &day, monthName, &year, &hours, &minutes, &seconds) != 6)
+            {
+                return false;
+            }
+            
+            s32 month = 0;
+            while (month < 12 && strcmp(k_months[month], monthName) != 0)
+            {
+                ++month;
+            }
+            
+            if (month == 12 || year < 1970)
+            {
+                return false;
+            }
+            
+            //Days since the epoch of a proleptic Gregorian date, computed from March based years.
+            s32 marchYear = (month < 2) ? year - 1 : year;
+            s32 era = marchYear / 400;
+            s32 yearOfEra = marchYear - era * 400;
+            s32 dayOfYear = (153 * (month < 2 ? month + 10 : month - 2) + 2) / 5 + day - 1;
+            s32 dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+            s64 days = s64(era) * 146097 + dayOfEra - 719468;
+            
+            out_time = TimeIntervalSecs(days * 86400 + hours * 3600 + minutes * 60 + seconds);
+            return true;
+        }
+        //--------------------------------------------------------------------------------------------------
+        /// Reads and validates a cache entry file.
+        ///
+        /// @param URL the entry is expected to be for.
+        /// @param The file path.
+        ///
+        /// @return The entry, or null if the file didn't exist or was invalid.
+        //--------------------------------------------------------------------------------------------------
+        template <typename TEntry> std::unique_ptr<TEntry> ReadEntry(const std::string& in_url, const std::string& in_filePath)
+        {
+            auto fileSystem = Application::Get()->GetFileSystem();
+            if (!fileSystem->DoesFileExist(StorageLocation::k_cache, in_filePath))
+            {
+                return nullptr;
+            }
+            
+            auto fileStream = fileSystem->CreateBinaryInputStream(StorageLocation::k_cache, in_filePath);
+            if (fileStream == nullptr)
+            {
+                return nullptr;
+            }
+            
+            u32 size = u32(fileStream->GetLength());
+            std::unique_ptr<u8[]> data(new u8[size]);
+            fileStream->Read(data.get(), size);
+            fileStream.reset();
+            
+            EntryReader reader(data.get(), size);
+            u32 id = 0, version = 0, checksum = 0, payloadSize = 0;
+            if (!reader.Read(id) || !reader.Read(version) || !reader.Read(checksum) || !reader.Read(payloadSize) || id != k_entryId || version != k_formatVersion ||
+                payloadSize != size - k_entryHeaderSize || HashCRC32::GenerateHashCode(reinterpret_cast<const s8*>(data.get() + k_entryHeaderSize), payloadSize) != checksum)
+            {
+                return nullptr;
+            }
+            
+            std::unique_ptr<TEntry> entry(new TEntry());
+            u8 isRevalidationRequired = 0;
+            u32 numHeaders = 0;
+            bool success = reader.ReadString(entry->m_url) && reader.ReadString(entry->m_eTag) && reader.ReadString(entry->m_lastModified) && reader.Read(entry->m_storedTime) &&
+                reader.Read(entry->m_freshnessSecs) && reader.Read(isRevalidationRequired) && reader.Read(entry->m_responseCode) && reader.Read(numHeaders);
+            
+            for (u32 i = 0; success && i < numHeaders; ++i)
+            {
+                std::string name, value;
+                success = reader.ReadString(name) && reader.ReadString(value);
+                entry->m_responseHeaders.SetValue(name, value);
+            }
+            
+            //Different urls can, in theory, share a file name, so a mismatched url is treated as a miss.
+            if (!success || !reader.ReadString(entry->m_body) || entry->m_url != in_url)
+            {
+                return nullptr;
+            }
+            
+            entry->m_isRevalidationRequired = (isRevalidationRequired != 0);
+            return entry;
+        }
+    }
+    
+    //--------------------------------------------------------------------------------------------------
+    /// A request which was served from the cache. It holds the response until it is delivered on the
+    /// next update.
+    //--------------------------------------------------------------------------------------------------
+    class HttpResponseCache::CachedRequest final : public HttpRequest
+    {
+    public:
+        CachedRequest(const std::string& in_url, const ParamDictionary& in_headers, const Delegate& in_delegate, const Entry& in_entry)
+            : m_url(in_url), m_headers(in_headers), m_delegate(in_delegate), m_responseCode(in_entry.m_responseCode), m_responseHeaders(in_entry.m_responseHeaders), m_body(in_entry.m_body)
+        {
+        }
+        
+        Type GetType() const override
+        {
+            return Type::k_get;
+        }
+        
+        const std::string& GetUrl() const override
+        {
+            return m_url;
+        }
+        
+        const std::string& GetBody() const override
+        {
+            return m_requestBody;
+        }
+        
+        const ParamDictionary& GetHeaders() const override
+        {
+            return m_headers;
+        }
+        
+        u64 GetExpectedSize() const override
+        {
+            return m_body.size();
+        }
+        
+        u64 GetDownloadedBytes() const override
+        {
+            return m_body.size();
+        }
+        
+        void Cancel() override
+        {
+            m_isCancelled = true;
+        }
+        
+        void Deliver()
+        {
+            if (m_isCancelled == false)
+            {
+                m_delegate(this, HttpResponse(HttpResponse::Result::k_completed, m_responseCode, m_body, m_responseHeaders));
+            }
+        }
+        
+    private:
+        const std::string m_url;
+        const std::string m_requestBody;
+        const ParamDictionary m_headers;
+        const Delegate m_delegate;
+        const u32 m_responseCode;
+        const ParamDictionary m_responseHeaders;
+        const std::string m_body;
+        bool m_isCancelled = false;
+    };
+    
+    CS_DEFINE_NAMEDTYPE(HttpResponseCache);
+    
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    HttpResponseCacheUPtr HttpResponseCache::Create(u32 in_maxEntrySize)
+    {
+        return HttpResponseCacheUPtr(new HttpResponseCache(in_maxEntrySize));
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    HttpResponseCache::HttpResponseCache(u32 in_maxEntrySize)
+        : m_maxEntrySize(in_maxEntrySize)
+    {
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    bool HttpResponseCache::IsA(InterfaceIDType in_interfaceId) const
+    {
+        return (HttpResponseCache::InterfaceID == in_interfaceId);
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    HttpRequest* HttpResponseCache::MakeGetRequest(const std::string& in_url, const HttpRequest::Delegate& in_delegate, u32 in_timeoutSecs)
+    {
+        return MakeGetRequest(in_url, ParamDictionary(), in_delegate, in_timeoutSecs);
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    HttpRequest* HttpResponseCache::MakeGetRequest(const std::string& in_url, const ParamDictionary& in_headers, const HttpRequest::Delegate& in_delegate, u32 in_timeoutSecs)
+    {
+        CS_ASSERT(Application::Get()->GetTaskScheduler()->IsMainThread() == true, "Http requests can currently only be made on the main thread");
+        CS_ASSERT(in_delegate != nullptr, "Cannot make an http request with a null delegate");
+        CS_ASSERT(m_httpRequestSystem != nullptr, "The response cache requires the HttpRequestSystem.");
+        
+        ++m_stats.m_numRequests;
+        
+        auto normalisedHeaders = NormaliseHeaders(in_headers);
+        if (normalisedHeaders.HasKey("if-none-match") || normalisedHeaders.HasKey("if-modified-since"))
+        {
+            ++m_stats.m_numMisses;
+            return m_httpRequestSystem->MakeGetRequest(in_url, in_headers, in_delegate, in_timeoutSecs);
+        }
+        
+        auto entry = FindEntry(in_url);
+        if (entry != nullptr && IsFresh(*entry) == true)
+        {
+            ++m_stats.m_numFreshHits;
+            m_stats.m_numBytesServed += entry->m_body.size();
+            
+            m_cachedRequests.push_back(std::unique_ptr<CachedRequest>(new CachedRequest(in_url, in_headers, in_delegate, *entry)));
+            return m_cachedRequests.back().get();
+        }
+        
+        auto headers = in_headers;
+        if (entry != nullptr)
+        {
+            if (entry->m_eTag.empty() == false)
+            {
+                headers.SetValue("If-None-Match", entry->m_eTag);
+            }
+            
+            if (entry->m_lastModified.empty() == false)
+            {
+                headers.SetValue("If-Modified-Since", entry->m_lastModified);
+            }
+        }
+        
+        auto isFlushed = std::make_shared<bool>(false);
+        return m_httpRequestSystem->MakeGetRequest(in_url, headers, [=](const HttpRequest* in_request, const HttpResponse& in_response)
+        {
+            OnResponse(in_url, in_delegate, *isFlushed, in_request, in_response);
+        }, in_timeoutSecs);
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    void HttpResponseCache::Remove(const std::string& in_url)
+    {
+        auto it = m_entries.find(in_url);
+        if (it != m_entries.end() && it->second == nullptr)
+        {
+            return;
+        }
+        
+        m_entries[in_url] = nullptr;
+        
+        WriteJob writeJob;
+        writeJob.m_filePath = GetEntryFilePath(in_url);
+        QueueWrite(std::move(writeJob));
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    void HttpResponseCache::Clear()
+    {
+        WaitForWrites();
+        
+        m_entries.clear();
+        
+        auto fileSystem = Application::Get()->GetFileSystem();
+        if (fileSystem->DoesDirectoryExist(StorageLocation::k_cache, k_directoryPath))
+        {
+            fileSystem->DeleteDirectory(StorageLocation::k_cache, k_directoryPath);
+        }
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    const HttpResponseCache::Stats& HttpResponseCache::GetStats() const
+    {
+        return m_stats;
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    void HttpResponseCache::ResetStats()
+    {
+        m_stats = Stats();
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    HttpResponseCache::Entry* HttpResponseCache::FindEntry(const std::string& in_url)
+    {
+        auto it = m_entries.find(in_url);
+        if (it != m_entries.end())
+        {
+            return it->second.get();
+        }
+        
+        auto filePath = GetEntryFilePath(in_url);
+        auto entry = ReadEntry<Entry>(in_url, filePath);
+        
+        auto output = entry.get();
+        m_entries.emplace(in_url, std::move(entry));
+        return output;
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    bool HttpResponseCache::IsFresh(const Entry& in_entry) const
+    {
+        if (in_entry.m_isRevalidationRequired == true)
+        {
+            return false;
+        }
+        
+        //A clock which has gone backwards can't be trusted to judge the age of the entry.
+        auto now = Application::Get()->GetSystemTime();
+        return (now >= in_entry.m_storedTime && now - in_entry.m_storedTime < in_entry.m_freshnessSecs);
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    bool HttpResponseCache::ApplyCachingHeaders(Entry& inout_entry) const
+    {
+        auto headers = NormaliseHeaders(inout_entry.m_responseHeaders);
+        auto now = Application::Get()->GetSystemTime();
+        
+        std::string vary;
+        if (headers.TryGetValue("vary", vary) == true)
+        {
+            //The cache is keyed on url alone, so can't store responses which vary on request headers.
+            StringUtils::ToLowerCase(vary);
+            StringUtils::Trim(vary);
+            if (vary.empty() == false && vary != "accept-encoding")
+            {
+                return false;
+            }
+        }
+        
+        std::string cacheControlValue;
+        bool hasCacheControl = headers.TryGetValue("cache-control", cacheControlValue);
+        auto cacheControl = ParseCacheControl(cacheControlValue);
+        if (cacheControl.HasKey("no-store") == true)
+        {
+            return false;
+        }
+        
+        inout_entry.m_isRevalidationRequired = cacheControl.HasKey("no-cache");
+        if (hasCacheControl == false)
+        {
+            std::string pragma;
+            headers.TryGetValue("pragma", pragma);
+            StringUtils::ToLowerCase(pragma);
+            inout_entry.m_isRevalidationRequired = (pragma.find("no-cache") != std::string::npos);
+        }
+        
+        //Freshness comes from max-age, or failing that the difference between Expires and Date, so that it is independent of the local clock.
+        std::string value;
+        s64 freshnessSecs = 0;
+        if (cacheControl.TryGetValue("max-age", value) == true)
+        {
+            freshnessSecs = strtoll(value.c_str(), nullptr, 10);
+        }
+        else if (headers.TryGetValue("expires", value) == true)
+        {
+            TimeIntervalSecs expires = 0, date = now;
+            std::string dateValue;
+            if (ParseHttpDate(value, expires) == true && (headers.TryGetValue("date", dateValue) == false || ParseHttpDate(dateValue, date) == true))
+            {
+                freshnessSecs = s64(expires) - s64(date);
+            }
+        }
+        
+        if (headers.TryGetValue("age", value) == true)
+        {
+            freshnessSecs -= strtoll(value.c_str(), nullptr, 10);
+        }
+        
+        inout_entry.m_freshnessSecs = u64(std::max(freshnessSecs, s64(0)));
+        inout_entry.m_storedTime = now;
+        
+        inout_entry.m_eTag.clear();
+        inout_entry.m_lastModified.clear();
+        headers.TryGetValue("etag", inout_entry.m_eTag);
+        headers.TryGetValue("last-modified", inout_entry.m_lastModified);
+        
+        return (inout_entry.m_freshnessSecs > 0 || inout_entry.m_eTag.empty() == false || inout_entry.m_lastModified.empty() == false);
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    void HttpResponseCache::OnResponse(const std::string& in_url, const HttpRequest::Delegate& in_delegate, bool& inout_isFlushed, const HttpRequest* in_request, const HttpResponse& in_response)
+    {
+        if (in_response.GetResult() == HttpResponse::Result::k_flushed)
+        {
+            //The full body will never be available so this request can't be cached.
+            inout_isFlushed = true;
+            in_delegate(in_request, in_response);
+            return;
+        }
+        
+        auto entry = FindEntry(in_url);
+        if (in_response.GetResult() == HttpResponse::Result::k_completed && inout_isFlushed == false)
+        {
+            if (in_response.GetCode() == HttpResponseCode::k_notModified && entry != nullptr)
+            {
+                ++m_stats.m_numRevalidatedHits;
+                m_stats.m_numBytesServed += entry->m_body.size();
+                
+                MergeHeaders(in_response.GetHeaders(), entry->m_responseHeaders);
+                HttpResponse response(HttpResponse::Result::k_completed, entry->m_responseCode, entry->m_body, entry->m_responseHeaders);
+                
+                if (ApplyCachingHeaders(*entry) == true)
+                {
+                    SaveEntry(*entry);
+                }
+                else
+                {
+                    Remove(in_url);
+                }
+                
+                in_delegate(in_request, response);
+                return;
+            }
+            
+            if (in_response.GetCode() == HttpResponseCode::k_ok)
+            {
+                std::unique_ptr<Entry> newEntry(new Entry());
+                newEntry->m_url = in_url;
+                newEntry->m_responseCode = in_response.GetCode();
+                newEntry->m_responseHeaders = in_response.GetHeaders();
+                
+                if (in_response.GetDataSize() <= m_maxEntrySize && ApplyCachingHeaders(*newEntry) == true)
+                {
+                    newEntry->m_body = in_response.GetDataAsString();
+                    SaveEntry(*newEntry);
+                    m_entries[in_url] = std::move(newEntry);
+                }
+                else if (entry != nullptr)
+                {
+                    Remove(in_url);
+                }
+            }
+        }
+        
+        ++m_stats.m_numMisses;
+        in_delegate(in_request, in_response);
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    void HttpResponseCache::SaveEntry(const Entry& in_entry)
+    {
+        std::vector<u8> payload;
+        payload.reserve(in_entry.m_body.size() + 256);
+        
+        WriteString(in_entry.m_url, payload);
+        WriteString(in_entry.m_eTag, payload);
+        WriteString(in_entry.m_lastModified, payload);
+        WritePrimitive(in_entry.m_storedTime, payload);
+        WritePrimitive(in_entry.m_freshnessSecs, payload);
+        WritePrimitive(u8(in_entry.m_isRevalidationRequired ? 1 : 0), payload);
+        WritePrimitive(in_entry.m_responseCode, payload);
+        WritePrimitive(u32(in_entry.m_responseHeaders.size()), payload);
+        for (const auto& header : in_entry.m_responseHeaders)
+        {
+            WriteString(header.first, payload);
+            WriteString(header.second, payload);
+        }
+        WriteString(in_entry.m_body, payload);
+        
+        WriteJob writeJob;
+        writeJob.m_filePath = GetEntryFilePath(in_entry.m_url);
+        writeJob.m_data.reserve(k_entryHeaderSize + payload.size());
+        WritePrimitive(k_entryId, writeJob.m_data);
+        WritePrimitive(k_formatVersion, writeJob.m_data);
+        WritePrimitive(HashCRC32::GenerateHashCode(reinterpret_cast<const s8*>(payload.data()), u32(payload.size())), writeJob.m_data);
+        WritePrimitive(u32(payload.size()), writeJob.m_data);
+        writeJob.m_data.insert(writeJob.m_data.end(), payload.begin(), payload.end());
+        
+        QueueWrite(std::move(writeJob));
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    void HttpResponseCache::QueueWrite(WriteJob in_writeJob)
+    {
+        std::unique_lock<std::mutex> lock(m_writeMutex);
+        m_writeJobs.push_back(std::move(in_writeJob));
+        
+        //The task scheduler can't be used once the application is being destroyed, so writes are performed inline.
+        if (m_isDestroyed == true)
+        {
+            lock.unlock();
+            ProcessWrites();
+            return;
+        }
+        
+        //File tasks aren't run in the order they're scheduled, so a single task works through the queue to keep writes to the same entry in order.
+        if (m_isWriteScheduled == false)
+        {
+            m_isWriteScheduled = true;
+            Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_file, [=](const TaskContext&)
+            {
+                ProcessWrites();
+            });
+        }
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    void HttpResponseCache::ProcessWrites()
+    {
+        auto fileSystem = Application::Get()->GetFileSystem();
+        
+        while (true)
+        {
+            std::unique_lock<std::mutex> lock(m_writeMutex);
+            if (m_writeJobs.empty() == true)
+            {
+                m_isWriteScheduled = false;
+                m_writeCondition.notify_all();
+                return;
+            }
+            
+            auto writeJob = std::move(m_writeJobs.front());
+            m_writeJobs.pop_front();
+            lock.unlock();
+            
+            if (writeJob.m_data.empty() == true)
+            {
+                if (fileSystem->DoesFileExist(StorageLocation::k_cache, writeJob.m_filePath))
+                {
+                    fileSystem->DeleteFile(StorageLocation::k_cache, writeJob.m_filePath);
+                }
+                continue;
+            }
+            
+            //Entries are written to a temporary file then moved into place so a partially written entry is never read.
+            fileSystem->CreateDirectoryPath(StorageLocation::k_cache, k_directoryPath);
+            
+            auto tempFilePath = writeJob.m_filePath + k_tempFileExtension;
+            auto fileStream = fileSystem->CreateBinaryOutputStream(StorageLocation::k_cache, tempFilePath);
+            if (fileStream == nullptr)
+            {
+                CS_LOG_ERROR("Http Response Cache: Failed to open '" + tempFilePath + "' for writing.");
+                continue;
+            }
+            
+            fileStream->Write(writeJob.m_data.data(), writeJob.m_data.size());
+            fileStream.reset();
+            
+            if (!fileSystem->RenameFile(StorageLocation::k_cache, tempFilePath, writeJob.m_filePath))
+            {
+                CS_LOG_ERROR("Http Response Cache: Failed to write '" + writeJob.m_filePath + "'.");
+            }
+        }
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    void HttpResponseCache::WaitForWrites()
+    {
+        std::unique_lock<std::mutex> lock(m_writeMutex);
+        m_writeCondition.wait(lock, [this]() { return m_isWriteScheduled == false; });
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    void HttpResponseCache::OnInit()
+    {
+        m_httpRequestSystem = Application::Get()->GetSystem<HttpRequestSystem>();
+        CS_ASSERT(m_httpRequestSystem != nullptr, "The response cache requires the HttpRequestSystem.");
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    void HttpResponseCache::OnUpdate(f32 in_timeSinceLastUpdate)
+    {
+        //Delegates may make further requests, which will be delivered next update.
+        auto cachedRequests = std::move(m_cachedRequests);
+        m_cachedRequests.clear();
+        
+        for (const auto& cachedRequest : cachedRequests)
+        {
+            cachedRequest->Deliver();
+        }
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    void HttpResponseCache::OnDestroy()
+    {
+        //The task scheduler has already been destroyed, dropping any pending write task, so the queue is drained here instead.
+        std::unique_lock<std::mutex> lock(m_writeMutex);
+        m_isDestroyed = true;
+        m_isWriteScheduled = true;
+        lock.unlock();
+        
+        ProcessWrites();
+        
+        m_cachedRequests.clear();
+        m_entries.clear();
+    }
+    //--------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------
+    HttpResponseCache::~HttpResponseCache()
+    {
+    }
+}
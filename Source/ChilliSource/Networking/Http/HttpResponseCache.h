@@ -0,0 +1,254 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_NETWORKING_HTTP_HTTPRESPONSECACHE_H_
+#define _CHILLISOURCE_NETWORKING_HTTP_HTTPRESPONSECACHE_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Container/ParamDictionary.h>
+#include <ChilliSource/Core/System/AppSystem.h>
+#include <ChilliSource/Networking/Http/HttpRequest.h>
+#include <ChilliSource/Networking/Http/HttpRequestSystem.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ChilliSource
+{
+    //--------------------------------------------------------------------------------------------------
+    /// An opt-in, on-disk cache of GET responses which sits in front of the HttpRequestSystem. It is
+    /// intended for small resources which are requested repeatedly, such as news feeds, remote config
+    /// or leaderboards.
+    ///
+    /// Responses are cached in the cache storage location according to their Cache-Control, Expires,
+    /// ETag and Last-Modified headers. A request for a cached response which is still fresh is served
+    /// locally; a request for a stale one is sent as a conditional GET, and if the server replies 304
+    /// Not Modified the cached body is delivered with a 200 response code as though it had been
+    /// downloaded again.
+    ///
+    /// Requests must be made through the cache rather than the HttpRequestSystem to make use of it.
+    /// Requests that set their own conditional headers, or responses which are flushed because the
+    /// HttpRequestSystem has a max buffer size, bypass the cache.
+    //--------------------------------------------------------------------------------------------------
+    class HttpResponseCache final : public AppSystem
+    {
+    public:
+        CS_DECLARE_NAMEDTYPE(HttpResponseCache);
+        CS_DECLARE_NOCOPY(HttpResponseCache);
+        //--------------------------------------------------------------------------------------------------
+        /// Running totals of how requests made through the cache were handled.
+        //--------------------------------------------------------------------------------------------------
+        struct Stats
+        {
+            u32 m_numRequests = 0;
+            u32 m_numFreshHits = 0;
+            u32 m_numRevalidatedHits = 0;
+            u32 m_numMisses = 0;
+            u64 m_numBytesServed = 0;
+        };
+        //--------------------------------------------------------------------------------------------------
+        /// Creates a new instance of the system. This should be created after the HttpRequestSystem.
+        ///
+        /// @param The largest response body, in bytes, that will be cached.
+        ///
+        /// @return The new instance.
+        //--------------------------------------------------------------------------------------------------
+        static HttpResponseCacheUPtr Create(u32 in_maxEntrySize = k_defaultMaxEntrySize);
+        //--------------------------------------------------------------------------------------------------
+        /// @param Interface ID
+        ///
+        /// @return Whether object if of argument type
+        //--------------------------------------------------------------------------------------------------
+        bool IsA(InterfaceIDType in_interfaceId) const override;
+        //--------------------------------------------------------------------------------------------------
+        /// Issues an Http GET request, or serves it from the cache if a fresh response is available.
+        /// In either case the delegate is called on the main thread, no sooner than the next update.
+        ///
+        /// @param URL
+        /// @param Delegate that is called on request completed. Completion can be failure as well as success
+        /// @param Request timeout in seconds
+        ///
+        /// @return A pointer to the request, which is only valid until the delegate has been called.
+        //--------------------------------------------------------------------------------------------------
+        HttpRequest* MakeGetRequest(const std::string& in_url, const HttpRequest::Delegate& in_delegate, u32 in_timeoutSecs = HttpRequestSystem::k_defaultTimeoutSecs);
+        //--------------------------------------------------------------------------------------------------
+        /// Issues an Http GET request, or serves it from the cache if a fresh response is available.
+        /// In either case the delegate is called on the main thread, no sooner than the next update.
+        ///
+        /// @param URL
+        /// @param Key value headers to attach to the request
+        /// @param Delegate that is called on request completed. Completion can be failure as well as success
+        /// @param Request timeout in seconds
+        ///
+        /// @return A pointer to the request, which is only valid until the delegate has been called.
+        //--------------------------------------------------------------------------------------------------
+        HttpRequest* MakeGetRequest(const std::string& in_url, const ParamDictionary& in_headers, const HttpRequest::Delegate& in_delegate, u32 in_timeoutSecs = HttpRequestSystem::k_defaultTimeoutSecs);
+        //--------------------------------------------------------------------------------------------------
+        /// Removes the cached response for the given url, if there is one.
+        ///
+        /// @param URL
+        //--------------------------------------------------------------------------------------------------
+        void Remove(const std::string& in_url);
+        //--------------------------------------------------------------------------------------------------
+        /// Removes all cached responses.
+        //--------------------------------------------------------------------------------------------------
+        void Clear();
+        //--------------------------------------------------------------------------------------------------
+        /// @return The running totals of how requests have been handled.
+        //--------------------------------------------------------------------------------------------------
+        const Stats& GetStats() const;
+        //--------------------------------------------------------------------------------------------------
+        /// Resets the running totals.
+        //--------------------------------------------------------------------------------------------------
+        void ResetStats();
+        //--------------------------------------------------------------------------------------------------
+        /// Destructor
+        //--------------------------------------------------------------------------------------------------
+        ~HttpResponseCache();
+        
+    private:
+        static const u32 k_defaultMaxEntrySize = 512 * 1024;
+        
+        class CachedRequest;
+        
+        //--------------------------------------------------------------------------------------------------
+        /// A cached response and the information required to determine whether it is fresh and to
+        /// revalidate it.
+        //--------------------------------------------------------------------------------------------------
+        struct Entry
+        {
+            std::string m_url;
+            std::string m_eTag;
+            std::string m_lastModified;
+            TimeIntervalSecs m_storedTime = 0;
+            u64 m_freshnessSecs = 0;
+            bool m_isRevalidationRequired = false;
+            u32 m_responseCode = 0;
+            ParamDictionary m_responseHeaders;
+            std::string m_body;
+        };
+        //--------------------------------------------------------------------------------------------------
+        /// A pending write to disk. An empty data block removes the entry file.
+        //--------------------------------------------------------------------------------------------------
+        struct WriteJob
+        {
+            std::string m_filePath;
+            std::vector<u8> m_data;
+        };
+        //--------------------------------------------------------------------------------------------------
+        /// @param The largest response body that will be cached.
+        //--------------------------------------------------------------------------------------------------
+        HttpResponseCache(u32 in_maxEntrySize);
+        //--------------------------------------------------------------------------------------------------
+        /// Looks up the cached entry for the given url, reading it from disk the first time the url is
+        /// requested this session.
+        ///
+        /// @param URL
+        ///
+        /// @return The entry, or null if there is none.
+        //--------------------------------------------------------------------------------------------------
+        Entry* FindEntry(const std::string& in_url);
+        //--------------------------------------------------------------------------------------------------
+        /// @param The entry.
+        ///
+        /// @return Whether the entry can be served without revalidation.
+        //--------------------------------------------------------------------------------------------------
+        bool IsFresh(const Entry& in_entry) const;
+        //--------------------------------------------------------------------------------------------------
+        /// Updates the caching information in the given entry from its response headers.
+        ///
+        /// @param [Out] The entry.
+        ///
+        /// @return Whether the response is worth storing: it must not be marked no-store, and must be
+        /// either fresh for some time or have a validator for revalidation.
+        //--------------------------------------------------------------------------------------------------
+        bool ApplyCachingHeaders(Entry& inout_entry) const;
+        //--------------------------------------------------------------------------------------------------
+        /// Called when a request made on behalf of the cache completes. Updates the cache then calls
+        /// the original delegate.
+        ///
+        /// @param URL
+        /// @param The original delegate.
+        /// @param [In/Out] Whether a response for the request has already been flushed.
+        /// @param The request.
+        /// @param The response.
+        //--------------------------------------------------------------------------------------------------
+        void OnResponse(const std::string& in_url, const HttpRequest::Delegate& in_delegate, bool& inout_isFlushed, const HttpRequest* in_request, const HttpResponse& in_response);
+        //--------------------------------------------------------------------------------------------------
+        /// Queues the given entry to be written to disk.
+        ///
+        /// @param The entry.
+        //--------------------------------------------------------------------------------------------------
+        void SaveEntry(const Entry& in_entry);
+        //--------------------------------------------------------------------------------------------------
+        /// Queues a write to disk, in order with all other writes, on a file task. Once the system has
+        /// been destroyed the write is performed immediately instead.
+        ///
+        /// @param The write.
+        //--------------------------------------------------------------------------------------------------
+        void QueueWrite(WriteJob in_writeJob);
+        //--------------------------------------------------------------------------------------------------
+        /// Performs queued writes until there are none left. This is called on a file task, or on the
+        /// calling thread once the system has been destroyed.
+        //--------------------------------------------------------------------------------------------------
+        void ProcessWrites();
+        //--------------------------------------------------------------------------------------------------
+        /// Blocks until all queued writes have been performed.
+        //--------------------------------------------------------------------------------------------------
+        void WaitForWrites();
+        //--------------------------------------------------------------------------------------------------
+        /// Gets the HttpRequestSystem.
+        //--------------------------------------------------------------------------------------------------
+        void OnInit() override;
+        //--------------------------------------------------------------------------------------------------
+        /// Delivers the responses of requests served from the cache.
+        ///
+        /// @param Time since last update in seconds
+        //--------------------------------------------------------------------------------------------------
+        void OnUpdate(f32 in_timeSinceLastUpdate) override;
+        //--------------------------------------------------------------------------------------------------
+        /// Performs pending writes on the calling thread and discards undelivered requests.
+        //--------------------------------------------------------------------------------------------------
+        void OnDestroy() override;
+        
+        const u32 m_maxEntrySize;
+        
+        HttpRequestSystem* m_httpRequestSystem = nullptr;
+        Stats m_stats;
+        
+        std::unordered_map<std::string, std::unique_ptr<Entry>> m_entries;
+        std::vector<std::unique_ptr<CachedRequest>> m_cachedRequests;
+        
+        std::mutex m_writeMutex;
+        std::condition_variable m_writeCondition;
+        std::deque<WriteJob> m_writeJobs;
+        bool m_isWriteScheduled = false;
+        bool m_isDestroyed = false;
+    };
+}
+
+#endif
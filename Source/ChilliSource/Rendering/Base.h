@@ -35,6 +35,7 @@
 #include <ChilliSource/Rendering/Base/AspectRatioUtils.h>
 #include <ChilliSource/Rendering/Base/BlendMode.h>
 #include <ChilliSource/Rendering/Base/CameraRenderPassGroup.h>
+#include <ChilliSource/Rendering/Base/CanvasDrawList.h>
 #include <ChilliSource/Rendering/Base/CanvasDrawMode.h>
 #include <ChilliSource/Rendering/Base/CanvasMaterialPool.h>
 #include <ChilliSource/Rendering/Base/CanvasRenderer.h>
@@ -55,9 +56,11 @@
 #include <ChilliSource/Rendering/Base/RenderLayer.h>
 #include <ChilliSource/Rendering/Base/RenderObject.h>
 #include <ChilliSource/Rendering/Base/RenderPass.h>
+#include <ChilliSource/Rendering/Base/RenderPassLightBinner.h>
 #include <ChilliSource/Rendering/Base/RenderPassObject.h>
 #include <ChilliSource/Rendering/Base/RenderPassObjectSorter.h>
 #include <ChilliSource/Rendering/Base/RenderPassVisibilityChecker.h>
+#include <ChilliSource/Rendering/Base/RenderPipelineStats.h>
 #include <ChilliSource/Rendering/Base/RenderSnapshot.h>
 #include <ChilliSource/Rendering/Base/SizePolicy.h>
 #include <ChilliSource/Rendering/Base/StencilOp.h>
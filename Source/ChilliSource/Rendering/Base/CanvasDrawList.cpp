@@ -0,0 +1,125 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Rendering/Base/CanvasDrawList.h>
+
+#include <ChilliSource/Rendering/Texture/Texture.h>
+
+#include <cmath>
+#include <limits>
+
+namespace ChilliSource
+{
+    //------------------------------------------------------------------------------
+    void CanvasDrawList::Clear() noexcept
+    {
+        m_commands.clear();
+        m_sprites.clear();
+        m_drawLists.clear();
+        
+        m_hasBounds = false;
+        m_boundsMin = Vector2::k_zero;
+        m_boundsMax = Vector2::k_zero;
+    }
+    
+    //------------------------------------------------------------------------------
+    void CanvasDrawList::AddSprite(Sprite sprite) noexcept
+    {
+        CS_ASSERT(m_sprites.size() < std::numeric_limits<u32>::max(), "Too many sprites in canvas draw list.");
+        
+        //The anchor can shift the sprite by up to its full size in either direction, so the local extents
+        //are conservatively expanded to account for this rather than resolving the anchor.
+        Vector3 localMin(sprite.m_localPosition.x - std::abs(sprite.m_localSize.x), sprite.m_localPosition.y - std::abs(sprite.m_localSize.y), 0.0f);
+        Vector3 localMax(sprite.m_localPosition.x + std::abs(sprite.m_localSize.x), sprite.m_localPosition.y + std::abs(sprite.m_localSize.y), 0.0f);
+        
+        Vector3 corners[] =
+        {
+            Vector3(localMin.x, localMin.y, 0.0f) * sprite.m_worldMatrix,
+            Vector3(localMax.x, localMin.y, 0.0f) * sprite.m_worldMatrix,
+            Vector3(localMin.x, localMax.y, 0.0f) * sprite.m_worldMatrix,
+            Vector3(localMax.x, localMax.y, 0.0f) * sprite.m_worldMatrix
+        };
+        
+        Vector2 min = corners[0].XY();
+        Vector2 max = corners[0].XY();
+        for (const auto& corner : corners)
+        {
+            min.Min(corner.XY());
+            max.Max(corner.XY());
+        }
+        
+        ExpandBounds(min, max);
+        
+        m_commands.push_back(Command{CommandType::k_sprite, u32(m_sprites.size())});
+        m_sprites.push_back(std::move(sprite));
+    }
+    
+    //------------------------------------------------------------------------------
+    void CanvasDrawList::AddIncrementClipMask() noexcept
+    {
+        m_commands.push_back(Command{CommandType::k_incrementClipMask, 0});
+    }
+    
+    //------------------------------------------------------------------------------
+    void CanvasDrawList::AddDecrementClipMask() noexcept
+    {
+        m_commands.push_back(Command{CommandType::k_decrementClipMask, 0});
+    }
+    
+    //------------------------------------------------------------------------------
+    void CanvasDrawList::AddDrawList(const CanvasDrawList* drawList) noexcept
+    {
+        CS_ASSERT(drawList != this, "A canvas draw list cannot reference itself.");
+        CS_ASSERT(m_drawLists.size() < std::numeric_limits<u32>::max(), "Too many draw list references in canvas draw list.");
+        
+        m_commands.push_back(Command{CommandType::k_drawList, u32(m_drawLists.size())});
+        m_drawLists.push_back(drawList);
+    }
+    
+    //------------------------------------------------------------------------------
+    void CanvasDrawList::ExpandBounds(const CanvasDrawList& drawList) noexcept
+    {
+        if (drawList.m_hasBounds)
+        {
+            ExpandBounds(drawList.m_boundsMin, drawList.m_boundsMax);
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    void CanvasDrawList::ExpandBounds(const Vector2& min, const Vector2& max) noexcept
+    {
+        if (m_hasBounds)
+        {
+            m_boundsMin.Min(min);
+            m_boundsMax.Max(max);
+        }
+        else
+        {
+            m_hasBounds = true;
+            m_boundsMin = min;
+            m_boundsMax = max;
+        }
+    }
+}
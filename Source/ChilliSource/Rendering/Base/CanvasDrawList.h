@@ -0,0 +1,176 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#ifndef _CHILLISOURCE_RENDERING_BASE_CANVASDRAWLIST_H_
+#define _CHILLISOURCE_RENDERING_BASE_CANVASDRAWLIST_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Base/Colour.h>
+#include <ChilliSource/Core/Math/Matrix4.h>
+#include <ChilliSource/Core/Math/Vector2.h>
+#include <ChilliSource/Core/Math/Vector3.h>
+#include <ChilliSource/Rendering/Base/AlignmentAnchors.h>
+#include <ChilliSource/Rendering/Base/CanvasDrawMode.h>
+#include <ChilliSource/Rendering/Texture/UVs.h>
+
+#include <vector>
+
+namespace ChilliSource
+{
+    /// A retained list of the sprites issued to the CanvasRenderer while it was being
+    /// recorded. Once recorded the list can be re-issued to the CanvasRenderer each frame
+    /// without regenerating any of the contained sprites. This is used by the UI system to
+    /// avoid rebuilding widget hierarchies which have not changed since the previous frame.
+    ///
+    /// Draw lists can contain references to other draw lists, allowing a hierarchy of
+    /// lists to be built which mirrors the widget hierarchy. As such a draw list must not be
+    /// destroyed while another recorded draw list still references it.
+    ///
+    /// Clip mask changes are recorded relative to the clip mask value at the point the list
+    /// is issued, meaning a list can be safely re-issued under a different clip mask.
+    ///
+    /// The screen space bounds of all sprites in the list, including those in referenced
+    /// lists, are also stored so that entirely offscreen lists can be skipped as a whole.
+    ///
+    /// This is not thread-safe and should only be used on the main thread.
+    ///
+    class CanvasDrawList final
+    {
+    public:
+        CS_DECLARE_NOCOPY(CanvasDrawList);
+        
+        CanvasDrawList() = default;
+        
+        /// @return Whether or not the list contains any sprites, clip mask changes or
+        ///     references to other lists.
+        ///
+        bool IsEmpty() const noexcept { return m_commands.empty(); }
+        
+        /// @return Whether or not the list has valid bounds. This will be false if no
+        ///     sprites have been added to the list, or any list it references.
+        ///
+        bool HasBounds() const noexcept { return m_hasBounds; }
+        
+        /// @return The minimum of the screen space bounds of all sprites in the list.
+        ///
+        const Vector2& GetBoundsMin() const noexcept { return m_boundsMin; }
+        
+        /// @return The maximum of the screen space bounds of all sprites in the list.
+        ///
+        const Vector2& GetBoundsMax() const noexcept { return m_boundsMax; }
+        
+        /// Removes all contents from the list.
+        ///
+        void Clear() noexcept;
+        
+    private:
+        friend class CanvasRenderer;
+        
+        /// The type of a command in the list.
+        ///
+        enum class CommandType
+        {
+            k_sprite,
+            k_incrementClipMask,
+            k_decrementClipMask,
+            k_drawList
+        };
+        
+        /// A single command in the list. The index refers to the sprite or draw list
+        /// vector, depending on the type of command.
+        ///
+        struct Command
+        {
+            CommandType m_type;
+            u32 m_index;
+        };
+        
+        /// The fully resolved description of a single sprite. This contains everything
+        /// required to generate the sprite's render object, other than the material which
+        /// depends on the clip mask at the point it is issued.
+        ///
+        struct Sprite
+        {
+            CanvasDrawMode m_drawMode;
+            TextureCSPtr m_texture;
+            Vector3 m_localPosition;
+            Vector2 m_localSize;
+            UVs m_uvs;
+            Colour m_colour;
+            AlignmentAnchor m_alignmentAnchor;
+            Matrix4 m_worldMatrix;
+        };
+        
+        /// Adds a new sprite to the list, expanding the bounds to encompass it.
+        ///
+        /// @param sprite
+        ///     The sprite to add.
+        ///
+        void AddSprite(Sprite sprite) noexcept;
+        
+        /// Adds a clip mask increment to the list.
+        ///
+        void AddIncrementClipMask() noexcept;
+        
+        /// Adds a clip mask decrement to the list.
+        ///
+        void AddDecrementClipMask() noexcept;
+        
+        /// Adds a reference to another draw list. The bounds of this list are not expanded,
+        /// this should be done separately via ExpandBounds() once the referenced list is
+        /// complete.
+        ///
+        /// @param drawList
+        ///     The list to reference. Must not be this list.
+        ///
+        void AddDrawList(const CanvasDrawList* drawList) noexcept;
+        
+        /// Expands the bounds of this list to encompass the given list.
+        ///
+        /// @param drawList
+        ///     The list whose bounds should be encompassed.
+        ///
+        void ExpandBounds(const CanvasDrawList& drawList) noexcept;
+        
+        /// Expands the bounds of this list to encompass the given area.
+        ///
+        /// @param min
+        ///     The minimum of the area to encompass.
+        /// @param max
+        ///     The maximum of the area to encompass.
+        ///
+        void ExpandBounds(const Vector2& min, const Vector2& max) noexcept;
+        
+        std::vector<Command> m_commands;
+        std::vector<Sprite> m_sprites;
+        std::vector<const CanvasDrawList*> m_drawLists;
+        
+        bool m_hasBounds = false;
+        Vector2 m_boundsMin;
+        Vector2 m_boundsMax;
+    };
+}
+
+#endif
@@ -36,46 +36,95 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
     CanvasMaterialPool::CanvasMaterialPool(MaterialFactory* materialFactory, const std::string& materialNamePrefix, const MaterialSetupDelegate& materialSetupDelegate)
-        : m_materialFactory(materialFactory), m_materialNamePrefix(materialNamePrefix), m_materialSetupDelegate(materialSetupDelegate)
+        : m_materialSetupDelegate(materialSetupDelegate), m_materialNamePrefix(materialNamePrefix), m_materialFactory(materialFactory)
     {
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
     MaterialCSPtr CanvasMaterialPool::GetMaterial(const TextureCSPtr& in_texture, s32 stencilRef)
     {
-        auto it = m_associations.find(std::make_tuple(in_texture.get(), stencilRef));
+        auto key = std::make_tuple(in_texture.get(), stencilRef);
+        
+        auto it = m_associations.find(key);
         if(it != m_associations.end())
         {
-            return it->second;
+            auto& pooledMaterial = m_materials[it->second];
+            if (pooledMaterial.m_lastUsedFrame != m_currentFrame)
+            {
+                pooledMaterial.m_lastUsedFrame = m_currentFrame;
+                pooledMaterial.m_material->SetLoadState(Resource::LoadState::k_loaded);
+            }
+            
+            return pooledMaterial.m_material;
         }
         
-        if (m_nextMaterial >= m_materials.size())
-        {
-            auto material = m_materialFactory->CreateCustom(m_materialNamePrefix + ToString(m_materials.size()));
-            m_materialSetupDelegate(material.get());
-            m_materials.push_back(material);
-            CS_ASSERT(m_nextMaterial < m_materials.size(), "We've added a new material yet we still don't have enough - something has gone wrong.");
-        }
+        auto index = AcquireFreeMaterial();
+        auto& pooledMaterial = m_materials[index];
         
-        auto material = m_materials[m_nextMaterial++];
+        auto& material = pooledMaterial.m_material;
+        material->RemoveAllTextures();
         material->AddTexture(in_texture);
         material->SetStencilTestFunc(material->GetStencilTestFunc(), stencilRef, material->GetStencilTestFuncMask());
         material->SetLoadState(Resource::LoadState::k_loaded);
         
-        m_associations.emplace(std::make_tuple(in_texture.get(), stencilRef), material);
+        pooledMaterial.m_key = key;
+        pooledMaterial.m_hasKey = true;
+        pooledMaterial.m_lastUsedFrame = m_currentFrame;
+        
+        m_associations.emplace(key, index);
         return material;
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
     void CanvasMaterialPool::Clear()
     {
-        m_nextMaterial = 0;
-        m_associations.clear();
+        for (auto& pooledMaterial : m_materials)
+        {
+            if (pooledMaterial.m_lastUsedFrame != m_currentFrame)
+            {
+                if (pooledMaterial.m_hasKey)
+                {
+                    m_associations.erase(pooledMaterial.m_key);
+                    pooledMaterial.m_hasKey = false;
+                    pooledMaterial.m_material->RemoveAllTextures();
+                }
+                
+                pooledMaterial.m_material->SetLoadState(Resource::LoadState::k_loading);
+            }
+        }
         
-        for (auto& material : m_materials)
+        ++m_currentFrame;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    u32 CanvasMaterialPool::AcquireFreeMaterial()
+    {
+        u32 freeIndex = u32(m_materials.size());
+        for (u32 i = 0; i < m_materials.size(); ++i)
+        {
+            const auto& pooledMaterial = m_materials[i];
+            if (pooledMaterial.m_lastUsedFrame != m_currentFrame && (freeIndex == m_materials.size() || pooledMaterial.m_lastUsedFrame < m_materials[freeIndex].m_lastUsedFrame))
+            {
+                freeIndex = i;
+            }
+        }
+        
+        if (freeIndex == m_materials.size())
         {
-            material->SetLoadState(Resource::LoadState::k_loading);
-            material->RemoveAllTextures();
+            PooledMaterial pooledMaterial;
+            pooledMaterial.m_material = m_materialFactory->CreateCustom(m_materialNamePrefix + ToString(m_materials.size()));
+            m_materialSetupDelegate(pooledMaterial.m_material.get());
+            m_materials.push_back(std::move(pooledMaterial));
+            return freeIndex;
         }
+        
+        auto& pooledMaterial = m_materials[freeIndex];
+        if (pooledMaterial.m_hasKey)
+        {
+            m_associations.erase(pooledMaterial.m_key);
+            pooledMaterial.m_hasKey = false;
+        }
+        
+        return freeIndex;
     }
 }
@@ -44,6 +44,10 @@ namespace ChilliSource
     /// ensuring objects with the same values can be rendered as part of the same batch.
     /// Materials can be re-used for different textures in subsequent frames.
     ///
+    /// Associations between textures and materials persist for a frame after they were
+    /// last used, so that content which is drawn every frame keeps the same material and
+    /// doesn't need its render material group rebuilt.
+    ///
     class CanvasMaterialPool final
     {
     public:
@@ -67,9 +71,10 @@ namespace ChilliSource
         //------------------------------------------------------------------------------
         MaterialCSPtr GetMaterial(const TextureCSPtr& texture, s32 stencilRef);
         //------------------------------------------------------------------------------
-        /// Clears all associations between textures and materials, ensuring the
-        /// the materials no longer reference the previously associated texture.
-        /// After this is called the materials can be re-used for other textures.
+        /// Ends the current frame. Materials which were requested this frame keep
+        /// their texture association so they can be returned again next frame without
+        /// being rebuilt. Materials which were not requested release their texture
+        /// and can be re-used for other textures.
         ///
         /// @author Ian Copland
         //------------------------------------------------------------------------------
@@ -80,7 +85,7 @@ namespace ChilliSource
         // Unique identifier for canvas materials (texture and stencil mask)
         using Key = std::tuple<const Texture*, s32>;
         
-        struct KeyHash : public std::unary_function<Key, std::size_t>
+        struct KeyHash
         {
             /// Custom hashing functor for the Key tuple.
             ///
@@ -94,12 +99,31 @@ namespace ChilliSource
             }
         };
         
+        /// A single pooled material and the texture and stencil ref it is currently
+        /// associated with.
+        ///
+        struct PooledMaterial
+        {
+            MaterialSPtr m_material;
+            Key m_key;
+            bool m_hasKey = false;
+            u32 m_lastUsedFrame = 0;
+        };
+        
+        /// Finds the least recently used material which hasn't been requested this
+        /// frame, creating a new one if all are in use. Any existing association the
+        /// material had is removed.
+        ///
+        /// @return The index of the free material.
+        ///
+        u32 AcquireFreeMaterial();
+        
         MaterialSetupDelegate m_materialSetupDelegate;
         std::string m_materialNamePrefix;
         MaterialFactory* m_materialFactory = nullptr;
-        u32 m_nextMaterial = 0;
-        std::vector<MaterialSPtr> m_materials;
-        std::unordered_map<Key, MaterialCSPtr, KeyHash> m_associations;
+        u32 m_currentFrame = 1;
+        std::vector<PooledMaterial> m_materials;
+        std::unordered_map<Key, u32, KeyHash> m_associations;
     };
 }
 
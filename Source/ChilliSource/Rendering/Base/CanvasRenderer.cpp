@@ -766,24 +766,79 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------------------
     //----------------------------------------------------------------------------
-    void CanvasRenderer::DrawBox(CanvasDrawMode drawMode, const Matrix3& transform, const Vector2& size, const Vector2& offset, const TextureCSPtr& texture, const UVs& uvs, const Colour& colour, AlignmentAnchor anchor)
+    void CanvasRenderer::IncrementClipMask() noexcept
     {
-        MaterialCSPtr material;
+        ++m_clipMaskCount;
         
-        switch (drawMode)
+        if (m_recordingDrawLists.empty() == false)
         {
-            case CanvasDrawMode::k_standard:
-                material = m_screenMaterialPool->GetMaterial(texture, m_clipMaskCount);
-                break;
-            case CanvasDrawMode::k_mask:
-                material = m_screenMaskMaterialPool->GetMaterial(texture, m_clipMaskCount);
-                break;
-            case CanvasDrawMode::k_maskOnly:
-                material = m_maskMaterialPool->GetMaterial(texture, m_clipMaskCount);
-                break;
+            m_recordingDrawLists.back()->AddIncrementClipMask();
         }
-
-        AddSpriteRenderObject(m_currentRenderSnapshot, m_currentFrameAllocator, Vector3(offset, 0.0f), size, uvs, colour, anchor, Convert2DTransformTo3D(transform), material, m_nextPriority++);
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    void CanvasRenderer::DecrementClipMask() noexcept
+    {
+        --m_clipMaskCount;
+        
+        if (m_recordingDrawLists.empty() == false)
+        {
+            m_recordingDrawLists.back()->AddDecrementClipMask();
+        }
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    void CanvasRenderer::BeginDrawList(CanvasDrawList* drawList) noexcept
+    {
+        CS_ASSERT(drawList != nullptr, "Cannot record into a null draw list.");
+        CS_ASSERT(std::find(m_recordingDrawLists.begin(), m_recordingDrawLists.end(), drawList) == m_recordingDrawLists.end(), "Draw list is already being recorded.");
+        
+        drawList->Clear();
+        
+        if (m_recordingDrawLists.empty() == false)
+        {
+            m_recordingDrawLists.back()->AddDrawList(drawList);
+        }
+        
+        m_recordingDrawLists.push_back(drawList);
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    void CanvasRenderer::EndDrawList() noexcept
+    {
+        CS_ASSERT(m_recordingDrawLists.empty() == false, "No draw list is being recorded.");
+        
+        auto drawList = m_recordingDrawLists.back();
+        m_recordingDrawLists.pop_back();
+        
+        if (m_recordingDrawLists.empty() == false)
+        {
+            m_recordingDrawLists.back()->ExpandBounds(*drawList);
+        }
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    bool CanvasRenderer::IsRecordingDrawList() const noexcept
+    {
+        return (m_recordingDrawLists.empty() == false);
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    void CanvasRenderer::DrawList(const CanvasDrawList& drawList) noexcept
+    {
+        if (m_recordingDrawLists.empty() == false)
+        {
+            m_recordingDrawLists.back()->AddDrawList(&drawList);
+            m_recordingDrawLists.back()->ExpandBounds(drawList);
+        }
+        
+        ReplayDrawList(drawList);
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    void CanvasRenderer::DrawBox(CanvasDrawMode drawMode, const Matrix3& transform, const Vector2& size, const Vector2& offset, const TextureCSPtr& texture, const UVs& uvs, const Colour& colour, AlignmentAnchor anchor)
+    {
+        AddSprite(CanvasDrawList::Sprite{drawMode, texture, Vector3(offset, 0.0f), size, uvs, colour, anchor, Convert2DTransformTo3D(transform)});
     }
     //----------------------------------------------------------------------------
     //----------------------------------------------------------------------------
@@ -854,15 +909,12 @@ namespace ChilliSource
     //----------------------------------------------------------------------------
     void CanvasRenderer::DrawText(const std::vector<DisplayCharacterInfo>& characters, const Matrix3& transform, const Colour& colour, const TextureCSPtr& texture)
     {
-        auto material = m_screenMaterialPool->GetMaterial(texture, m_clipMaskCount);
-
         Matrix4 matTransform = Convert2DTransformTo3D(transform);
-        Matrix4 matTransformedLocal;
 
         for (const auto& character : characters)
         {
-            matTransformedLocal = Matrix4::CreateTranslation(Vector3(character.m_position, 0.0f)) * matTransform;
-            AddSpriteRenderObject(m_currentRenderSnapshot, m_currentFrameAllocator, Vector3::k_zero, character.m_packedImageSize, character.m_UVs, colour, AlignmentAnchor::k_topLeft, matTransformedLocal, material, m_nextPriority++);
+            Matrix4 matTransformedLocal = Matrix4::CreateTranslation(Vector3(character.m_position, 0.0f)) * matTransform;
+            AddSprite(CanvasDrawList::Sprite{CanvasDrawMode::k_standard, texture, Vector3::k_zero, character.m_packedImageSize, character.m_UVs, colour, AlignmentAnchor::k_topLeft, matTransformedLocal});
         }
     }
     //----------------------------------------------------------------------------
@@ -883,6 +935,8 @@ namespace ChilliSource
             
             activeUICanvas->Draw(this);
             
+            CS_ASSERT(m_recordingDrawLists.empty(), "Canvas draw list recording was not ended.");
+            
             m_currentRenderSnapshot = nullptr;
             
             m_screenMaterialPool->Clear();
@@ -892,6 +946,76 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------------------
     //----------------------------------------------------------------------------
+    void CanvasRenderer::AddSprite(CanvasDrawList::Sprite sprite) noexcept
+    {
+        auto material = GetMaterial(sprite.m_drawMode, sprite.m_texture);
+        AddSpriteRenderObject(m_currentRenderSnapshot, m_currentFrameAllocator, sprite.m_localPosition, sprite.m_localSize, sprite.m_uvs, sprite.m_colour, sprite.m_alignmentAnchor,
+                              sprite.m_worldMatrix, material, m_nextPriority++);
+        
+        if (m_recordingDrawLists.empty() == false)
+        {
+            m_recordingDrawLists.back()->AddSprite(std::move(sprite));
+        }
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    void CanvasRenderer::ReplayDrawList(const CanvasDrawList& drawList) noexcept
+    {
+        const auto& canvasSize = m_screen->GetResolution();
+        
+        for (const auto& command : drawList.m_commands)
+        {
+            switch (command.m_type)
+            {
+                case CanvasDrawList::CommandType::k_sprite:
+                {
+                    const auto& sprite = drawList.m_sprites[command.m_index];
+                    auto material = GetMaterial(sprite.m_drawMode, sprite.m_texture);
+                    AddSpriteRenderObject(m_currentRenderSnapshot, m_currentFrameAllocator, sprite.m_localPosition, sprite.m_localSize, sprite.m_uvs, sprite.m_colour, sprite.m_alignmentAnchor,
+                                          sprite.m_worldMatrix, material, m_nextPriority++);
+                    break;
+                }
+                case CanvasDrawList::CommandType::k_incrementClipMask:
+                    ++m_clipMaskCount;
+                    break;
+                case CanvasDrawList::CommandType::k_decrementClipMask:
+                    --m_clipMaskCount;
+                    break;
+                case CanvasDrawList::CommandType::k_drawList:
+                {
+                    //Clip mask changes are always balanced within a list, so skipping an offscreen list is safe.
+                    const auto& childDrawList = *drawList.m_drawLists[command.m_index];
+                    if (childDrawList.HasBounds() && (childDrawList.GetBoundsMax().x < 0.0f || childDrawList.GetBoundsMax().y < 0.0f ||
+                        childDrawList.GetBoundsMin().x > canvasSize.x || childDrawList.GetBoundsMin().y > canvasSize.y))
+                    {
+                        break;
+                    }
+                    
+                    ReplayDrawList(childDrawList);
+                    break;
+                }
+            }
+        }
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    MaterialCSPtr CanvasRenderer::GetMaterial(CanvasDrawMode drawMode, const TextureCSPtr& texture) noexcept
+    {
+        switch (drawMode)
+        {
+            case CanvasDrawMode::k_standard:
+                return m_screenMaterialPool->GetMaterial(texture, m_clipMaskCount);
+            case CanvasDrawMode::k_mask:
+                return m_screenMaskMaterialPool->GetMaterial(texture, m_clipMaskCount);
+            case CanvasDrawMode::k_maskOnly:
+                return m_maskMaterialPool->GetMaterial(texture, m_clipMaskCount);
+        }
+        
+        CS_LOG_FATAL("Invalid canvas draw mode.");
+        return nullptr;
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
     void CanvasRenderer::OnDestroy()
     {
         m_screenMaterialPool->Clear();
@@ -32,6 +32,7 @@
 #include <ChilliSource/ChilliSource.h>
 #include <ChilliSource/Core/Math/Geometry/Shapes.h>
 #include <ChilliSource/Core/System/AppSystem.h>
+#include <ChilliSource/Rendering/Base/CanvasDrawList.h>
 #include <ChilliSource/Rendering/Base/CanvasMaterialPool.h>
 #include <ChilliSource/Rendering/Base/HorizontalTextJustification.h>
 #include <ChilliSource/Rendering/Base/VerticalTextJustification.h>
@@ -113,11 +114,42 @@ namespace ChilliSource
         /// this is the value that will be used. Generally it is incremented prior to
         /// rendering the contents of a clipping box and decremented afterwards
         ///
-        void IncrementClipMask() noexcept { ++m_clipMaskCount; }
+        void IncrementClipMask() noexcept;
         
         /// Decrement the clip mask
         ///
-        void DecrementClipMask() noexcept { --m_clipMaskCount; }
+        void DecrementClipMask() noexcept;
+        
+        /// Begins recording into the given draw list. All subsequent sprites and clip mask
+        /// changes are rendered as normal but are also added to the list, until EndDrawList()
+        /// is called. The list is cleared prior to recording.
+        ///
+        /// Recording can be nested, in which case the new list is referenced by the list
+        /// currently being recorded, rather than copied into it.
+        ///
+        /// @param drawList
+        ///     The list to record into. Must remain valid until EndDrawList() is called.
+        ///
+        void BeginDrawList(CanvasDrawList* drawList) noexcept;
+        
+        /// Ends recording into the draw list most recently passed to BeginDrawList().
+        ///
+        void EndDrawList() noexcept;
+        
+        /// @return Whether a draw list is currently being recorded.
+        ///
+        bool IsRecordingDrawList() const noexcept;
+        
+        /// Renders the contents of a previously recorded draw list. This is considerably
+        /// cheaper than re-issuing the original draw calls. Any referenced lists which are
+        /// entirely offscreen are skipped.
+        ///
+        /// If another list is currently being recorded, the given list is referenced by it.
+        ///
+        /// @param drawList
+        ///     The list to render.
+        ///
+        void DrawList(const CanvasDrawList& drawList) noexcept;
         
 
         /// Renders the given sprite box to the screen or as a mask
@@ -216,12 +248,39 @@ namespace ChilliSource
         //----------------------------------------------------------------------------
         void OnDestroy() override;
 
+        /// Adds a sprite to the current render snapshot, and to the draw list which is currently
+        /// being recorded, if there is one.
+        ///
+        /// @param sprite
+        ///     The sprite to add.
+        ///
+        void AddSprite(CanvasDrawList::Sprite sprite) noexcept;
+        
+        /// Renders the contents of the given draw list, recursing into any referenced draw lists
+        /// which are not offscreen.
+        ///
+        /// @param drawList
+        ///     The list to render.
+        ///
+        void ReplayDrawList(const CanvasDrawList& drawList) noexcept;
+        
+        /// @param drawMode
+        ///     The draw mode.
+        /// @param texture
+        ///     The texture.
+        ///
+        /// @return The material for the given draw mode and texture, using the current clip mask.
+        ///
+        MaterialCSPtr GetMaterial(CanvasDrawMode drawMode, const TextureCSPtr& texture) noexcept;
+
     private:
         IAllocator* m_currentFrameAllocator = nullptr;
         RenderSnapshot* m_currentRenderSnapshot = nullptr;
         u32 m_nextPriority = 0;
         
         s32 m_clipMaskCount = 0;
+        
+        std::vector<CanvasDrawList*> m_recordingDrawLists;
 
         CanvasMaterialPoolUPtr m_screenMaterialPool;
         CanvasMaterialPoolUPtr m_screenMaskMaterialPool;
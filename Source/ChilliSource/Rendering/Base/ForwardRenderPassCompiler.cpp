@@ -30,11 +30,14 @@
 #include <ChilliSource/Rendering/Base/RenderFrame.h>
 #include <ChilliSource/Rendering/Base/RenderObject.h>
 #include <ChilliSource/Rendering/Base/RenderPass.h>
+#include <ChilliSource/Rendering/Base/RenderPassLightBinner.h>
 #include <ChilliSource/Rendering/Base/RenderPassObject.h>
 #include <ChilliSource/Rendering/Base/RenderPassObjectSorter.h>
 #include <ChilliSource/Rendering/Base/RenderPassVisibilityChecker.h>
 #include <ChilliSource/Rendering/Model/RenderDynamicMesh.h>
 
+#include <algorithm>
+
 
 namespace ChilliSource
 {
@@ -138,172 +141,169 @@ namespace ChilliSource
             return k_reservedRenderPasses + numDirectionalLightPasses + numPointLightPasses;
         }
         
-        /// Filters the given list of objects to return only the objects which are a part of the requested
-        /// layer.
+        /// Filters the given list of objects to return the indices of only the objects which are a part
+        /// of the requested layer.
         ///
         /// @param renderLayer
         ///     The render layer to filter on.
         /// @param renderObjects
         ///     The list of render objects which should be filtered.
         ///
-        /// @return The list of render objects for the requested layer.
+        /// @return The indices of the render objects for the requested layer.
         ///
-        std::vector<RenderObject> GetLayerRenderObjects(RenderLayer renderLayer, const std::vector<RenderObject>& renderObjects) noexcept
+        std::vector<u32> GetLayerObjectIndices(RenderLayer renderLayer, const std::vector<RenderObject>& renderObjects) noexcept
         {
-            std::vector<RenderObject> layerRenderObjects;
+            std::vector<u32> layerObjectIndices;
+            layerObjectIndices.reserve(renderObjects.size());
             
-            for (const auto& renderObject : renderObjects)
+            for (u32 objectIndex = 0; objectIndex < u32(renderObjects.size()); ++objectIndex)
             {
-                if (renderObject.GetRenderLayer() == renderLayer)
+                if (renderObjects[objectIndex].GetRenderLayer() == renderLayer)
                 {
-                    layerRenderObjects.push_back(renderObject);
+                    layerObjectIndices.push_back(objectIndex);
                 }
             }
             
-            return layerRenderObjects;
+            return layerObjectIndices;
         }
         
-        /// Parses a list of RenderObjects and generates a list of RenderPassObjects for
-        /// each RenderObject that has a ShadowMap pass defined, and has shadow casting
-        /// enabled.
+        /// Generates a RenderPassObject for each of the given RenderObjects which has a material
+        /// defined for the requested pass.
         ///
         /// @param renderObjects
-        ///     A list of RenderObjects to parse
+        ///     The list of RenderObjects the indices refer to.
+        /// @param objectIndices
+        ///     The indices of the RenderObjects to parse.
+        /// @param passType
+        ///     The pass to generate RenderPassObjects for.
         ///
-        /// @return The collection of RenderPassObjects.
+        /// @return A collection of RenderPassObjects, one for each RenderObject with the pass.
         ///
-        std::vector<RenderPassObject> GetShadowMapRenderPassObjects(const std::vector<RenderObject>& renderObjects) noexcept
+        std::vector<RenderPassObject> GetRenderPassObjects(const std::vector<RenderObject>& renderObjects, const std::vector<u32>& objectIndices, RenderPasses passType) noexcept
         {
-            std::vector<RenderPassObject> baseRenderPassObjects;
+            std::vector<RenderPassObject> renderPassObjects;
+            renderPassObjects.reserve(objectIndices.size());
             
-            for (const auto& renderObject : renderObjects)
+            for (auto objectIndex : objectIndices)
             {
-                if (renderObject.ShouldCastShadows())
+                const auto& renderObject = renderObjects[objectIndex];
+                auto renderMaterial = renderObject.GetRenderMaterialGroup()->GetRenderMaterial(GetVertexFormat(renderObject), static_cast<u32>(passType));
+                
+                if (renderMaterial)
                 {
-                    auto renderMaterial = renderObject.GetRenderMaterialGroup()->GetRenderMaterial(GetVertexFormat(renderObject), static_cast<u32>(RenderPasses::k_shadowMap));
-                    
-                    if (renderMaterial)
-                    {
-                        baseRenderPassObjects.push_back(ConvertToRenderPassObject(renderObject, renderMaterial));
-                    }
+                    renderPassObjects.push_back(ConvertToRenderPassObject(renderObject, renderMaterial));
                 }
             }
             
-            return baseRenderPassObjects;
+            return renderPassObjects;
         }
         
-        /// Parses a list of RenderObjects and generates a list of RenderPassObjects for
-        /// each RenderObject that has a Base pass defined.
-        ///
-        /// @param renderObjects
-        ///     A list of RenderObjects to parse
+        /// @param directionalRenderLight
+        ///     The directional light.
         ///
-        /// @return A collection of RenderPassObjects, one for each RenderObject Base pass
+        /// @return The pass used for the given directional light, which depends on whether or not
+        ///     it casts shadows.
         ///
-        std::vector<RenderPassObject> GetBaseRenderPassObjects(const std::vector<RenderObject>& renderObjects) noexcept
+        RenderPasses GetDirectionalLightPass(const DirectionalRenderLight& directionalRenderLight) noexcept
+        {
+            return directionalRenderLight.GetShadowMapTarget() ? RenderPasses::k_directionalLightShadows : RenderPasses::k_directionalLight;
+        }
+        
+        /// Checks whether or not the shadow cast by an object with the given bounding sphere could
+        /// fall within the given view frustum. The sphere is extruded along the light direction
+        /// by the given distance and rejected only if the extruded volume is entirely outside one
+        /// of the frustum planes.
+        ///
+        /// @param boundingSphere
+        ///     The bounding sphere of the shadow caster.
+        /// @param lightDirection
+        ///     The direction of the light.
+        /// @param extrusionDistance
+        ///     The distance the shadow can extend along the light direction.
+        /// @param viewFrustum
+        ///     The frustum of the camera the scene is viewed with.
+        ///
+        /// @return Whether or not the shadow could be visible.
+        ///
+        bool IsShadowPotentiallyVisible(const Sphere& boundingSphere, const Vector3& lightDirection, f32 extrusionDistance, const Frustum& viewFrustum) noexcept
         {
-            std::vector<RenderPassObject> baseRenderPassObjects;
+            const Plane* planes[] = { &viewFrustum.mLeftClipPlane, &viewFrustum.mRightClipPlane, &viewFrustum.mTopClipPlane, &viewFrustum.mBottomClipPlane,
+                &viewFrustum.mNearClipPlane, &viewFrustum.mFarClipPlane };
             
-            for (const auto& renderObject : renderObjects)
+            Vector3 extrudedOrigin = boundingSphere.vOrigin + lightDirection * extrusionDistance;
+            for (const auto plane : planes)
             {
-                auto renderMaterial = renderObject.GetRenderMaterialGroup()->GetRenderMaterial(GetVertexFormat(renderObject), static_cast<u32>(RenderPasses::k_base));
-                
-                if (renderMaterial)
+                if (plane->DistanceFromPoint(boundingSphere.vOrigin) < -boundingSphere.fRadius && plane->DistanceFromPoint(extrudedOrigin) < -boundingSphere.fRadius)
                 {
-                    baseRenderPassObjects.push_back(ConvertToRenderPassObject(renderObject, renderMaterial));
+                    return false;
                 }
             }
             
-            return baseRenderPassObjects;
+            return true;
         }
         
-        /// Parses a list of RenderObjects and generates a list of RenderPassObjects for
-        /// each RenderObject that has either a DirectionalLight or DirectionalLightShadows
-        /// pass defined, depending on the type of directional light.
+        /// Gathers the shadow casting objects in the given render frame which are within the shadow
+        /// volume of the given light. Unless shadow map caching is enabled for the light, casters are
+        /// also culled if their shadow, extruded to the far end of the shadow volume, cannot fall
+        /// within the view of the scene camera.
         ///
-        /// @param renderObjects
-        ///     A list of RenderObjects to parse
+        /// @param taskContext
+        ///     Context to manage any spawned tasks
+        /// @param renderFrame
+        ///     Current frame data
+        /// @param lightCamera
+        ///     The camera describing the shadow volume of the light.
         /// @param directionalRenderLight
-        ///     The directional light to get objects for.
+        ///     The directional light the shadow map is being built for.
         ///
-        /// @return A collection of RenderPassObjects, one for each RenderObject Directional pass
+        /// @return The indices of the shadow casters in the render frame's list of render objects.
         ///
-        std::vector<RenderPassObject> GetDirectionalLightRenderPassObjects(const std::vector<RenderObject>& renderObjects, const DirectionalRenderLight& directionalRenderLight) noexcept
+        std::vector<u32> GetShadowCasterObjectIndices(const TaskContext& taskContext, const RenderFrame& renderFrame, const RenderCamera& lightCamera,
+                                                      const DirectionalRenderLight& directionalRenderLight) noexcept
         {
-            RenderPasses passType = RenderPasses::k_directionalLight;
-            if (directionalRenderLight.GetShadowMapTarget())
-            {
-                passType = RenderPasses::k_directionalLightShadows;
-            }
-            
-            std::vector<RenderPassObject> renderPassObjects;
+            const auto& renderObjects = renderFrame.GetRenderObjects();
             
-            for (const auto& renderObject : renderObjects)
+            std::vector<u32> casterObjectIndices;
+            casterObjectIndices.reserve(renderObjects.size());
+            for (u32 objectIndex = 0; objectIndex < u32(renderObjects.size()); ++objectIndex)
             {
-                auto renderMaterial = renderObject.GetRenderMaterialGroup()->GetRenderMaterial(GetVertexFormat(renderObject), static_cast<u32>(passType));
-                
-                if (renderMaterial)
+                const auto& renderObject = renderObjects[objectIndex];
+                if (renderObject.GetRenderLayer() == RenderLayer::k_standard && renderObject.ShouldCastShadows())
                 {
-                    renderPassObjects.push_back(ConvertToRenderPassObject(renderObject, renderMaterial));
+                    casterObjectIndices.push_back(objectIndex);
                 }
             }
             
-            return renderPassObjects;
-        }
-        
-        /// Parses a list of RenderObjects and generates a list of RenderPassObjects for
-        /// each RenderObject that has a PointLight pass defined, and is within the range
-        /// of influence of the given light.
-        ///
-        /// @param renderObjects
-        ///     A list of RenderObjects to parse
-        /// @param pointRenderLight
-        ///     The render light to get objects for.
-        ///
-        /// @return A collection of RenderPassObjects for the render light pass.
-        ///
-        std::vector<RenderPassObject> GetPointLightRenderPassObjects(const std::vector<RenderObject>& renderObjects, const PointRenderLight& pointRenderLight) noexcept
-        {
-            Sphere pointLightBoundingSphere(pointRenderLight.GetPosition(), pointRenderLight.GetRangeOfInfluence());
-            
-            std::vector<RenderPassObject> renderPassObjects;
+            auto visibleCasterObjectIndices = RenderPassVisibilityChecker::CalculateVisibleObjectIndices(taskContext, lightCamera, renderObjects, casterObjectIndices);
+            if (directionalRenderLight.IsShadowMapCachingEnabled())
+            {
+                return visibleCasterObjectIndices;
+            }
             
-            for (const auto& renderObject : renderObjects)
+            const auto& lightFarPlane = lightCamera.GetFrustrum().mFarClipPlane;
+            const auto& lightDirection = directionalRenderLight.GetDirection();
+            f32 farPlaneApproachRate = -Vector3::DotProduct(lightFarPlane.mvNormal, lightDirection);
+            if (farPlaneApproachRate <= 0.0f)
             {
-                auto renderMaterial = renderObject.GetRenderMaterialGroup()->GetRenderMaterial(GetVertexFormat(renderObject), static_cast<u32>(RenderPasses::k_pointLight));
-                
-                if (renderMaterial && pointLightBoundingSphere.Contains(renderObject.GetBoundingSphere()))
-                {
-                    renderPassObjects.push_back(ConvertToRenderPassObject(renderObject, renderMaterial));
-                }
+                return visibleCasterObjectIndices;
             }
             
-            return renderPassObjects;
-        }
-        
-        /// Parses a list of RenderObjects and generates a list of RenderPassObjects for
-        /// each RenderObject that has a Transparent pass defined.
-        ///
-        /// @param renderObjects
-        ///     A list of RenderObjects to parse
-        ///
-        /// @return A collection of RenderPassObjects, one for each RenderObject Transparent pass
-        ///
-        std::vector<RenderPassObject> GetTransparentRenderPassObjects(const std::vector<RenderObject>& renderObjects) noexcept
-        {
-            std::vector<RenderPassObject> transparentRenderPassObjects;
+            const auto& viewFrustum = renderFrame.GetRenderCamera().GetFrustrum();
             
-            for (const auto& renderObject : renderObjects)
+            std::vector<u32> shadowCasterObjectIndices;
+            shadowCasterObjectIndices.reserve(visibleCasterObjectIndices.size());
+            for (auto objectIndex : visibleCasterObjectIndices)
             {
-                auto renderMaterial = renderObject.GetRenderMaterialGroup()->GetRenderMaterial(GetVertexFormat(renderObject), static_cast<u32>(RenderPasses::k_transparent));
+                const auto& boundingSphere = renderObjects[objectIndex].GetBoundingSphere();
+                f32 extrusionDistance = std::max(0.0f, lightFarPlane.DistanceFromPoint(boundingSphere.vOrigin) / farPlaneApproachRate);
                 
-                if (renderMaterial)
+                if (IsShadowPotentiallyVisible(boundingSphere, lightDirection, extrusionDistance, viewFrustum))
                 {
-                    transparentRenderPassObjects.push_back(ConvertToRenderPassObject(renderObject, renderMaterial));
+                    shadowCasterObjectIndices.push_back(objectIndex);
                 }
             }
             
-            return transparentRenderPassObjects;
+            return shadowCasterObjectIndices;
         }
         
         /// Gather all render objects in the frame that are to be renderered into the default RenderTarget
@@ -319,8 +319,9 @@ namespace ChilliSource
         ///
         CameraRenderPassGroup CompleSceneCameraRenderPassGroup(const TaskContext& taskContext, const RenderFrame& renderFrame) noexcept
         {
-            auto standardRenderObjects = GetLayerRenderObjects(RenderLayer::k_standard, renderFrame.GetRenderObjects());
-            auto visibleStandardRenderObjects = RenderPassVisibilityChecker::CalculateVisibleObjects(taskContext, renderFrame.GetRenderCamera(), standardRenderObjects);
+            const auto& renderObjects = renderFrame.GetRenderObjects();
+            auto standardObjectIndices = GetLayerObjectIndices(RenderLayer::k_standard, renderObjects);
+            auto visibleObjectIndices = RenderPassVisibilityChecker::CalculateVisibleObjectIndices(taskContext, renderFrame.GetRenderCamera(), renderObjects, standardObjectIndices);
             
             u32 numPasses = CalcNumScenePasses(renderFrame);
             std::vector<RenderPass> renderPasses(numPasses);
@@ -329,9 +330,9 @@ namespace ChilliSource
             
             // Base pass
             u32 basePassIndex = nextPassIndex++;
-            tasks.push_back([=, &renderPasses, &renderFrame, &visibleStandardRenderObjects](const TaskContext& innerTaskContext)
+            tasks.push_back([=, &renderPasses, &renderFrame, &renderObjects, &visibleObjectIndices](const TaskContext&)
             {
-                auto renderPassObjects = GetBaseRenderPassObjects(visibleStandardRenderObjects);
+                auto renderPassObjects = GetRenderPassObjects(renderObjects, visibleObjectIndices, RenderPasses::k_base);
                 RenderPassObjectSorter::OpaqueSort(renderFrame.GetRenderCamera(), renderPassObjects);
                 renderPasses[basePassIndex] = RenderPass(renderFrame.GetAmbientRenderLight(), std::move(renderPassObjects));
             });
@@ -340,21 +341,24 @@ namespace ChilliSource
             for (const auto& directionalLight : renderFrame.GetDirectionalRenderLights())
             {
                 u32 directionLightPassIndex = nextPassIndex++;
-                tasks.push_back([=, &renderPasses, &renderFrame, &visibleStandardRenderObjects, &directionalLight](const TaskContext& innerTaskContext)
+                tasks.push_back([=, &renderPasses, &renderFrame, &renderObjects, &visibleObjectIndices, &directionalLight](const TaskContext&)
                 {
-                    auto renderPassObjects = GetDirectionalLightRenderPassObjects(visibleStandardRenderObjects, directionalLight);
+                    auto renderPassObjects = GetRenderPassObjects(renderObjects, visibleObjectIndices, GetDirectionalLightPass(directionalLight));
                     RenderPassObjectSorter::OpaqueSort(renderFrame.GetRenderCamera(), renderPassObjects);
                     renderPasses[directionLightPassIndex] = RenderPass(directionalLight, std::move(renderPassObjects));
                 });
             }
             
             // Point light pass
-            for (const auto& pointLight : renderFrame.GetPointRenderLights())
+            auto pointLightObjects = RenderPassLightBinner::CalculatePointLightObjects(renderFrame.GetPointRenderLights(), renderObjects, visibleObjectIndices);
+            for (u32 pointLightIndex = 0; pointLightIndex < u32(renderFrame.GetPointRenderLights().size()); ++pointLightIndex)
             {
+                const auto& pointLight = renderFrame.GetPointRenderLights()[pointLightIndex];
+                const auto& objectIndices = pointLightObjects[pointLightIndex];
                 u32 pointLightPassIndex = nextPassIndex++;
-                tasks.push_back([=, &renderPasses, &renderFrame, &visibleStandardRenderObjects, &pointLight](const TaskContext& innerTaskContext)
+                tasks.push_back([=, &renderPasses, &renderFrame, &renderObjects, &pointLight, &objectIndices](const TaskContext&)
                 {
-                    auto renderPassObjects = GetPointLightRenderPassObjects(visibleStandardRenderObjects, pointLight);
+                    auto renderPassObjects = GetRenderPassObjects(renderObjects, objectIndices, RenderPasses::k_pointLight);
                     RenderPassObjectSorter::OpaqueSort(renderFrame.GetRenderCamera(), renderPassObjects);
                     renderPasses[pointLightPassIndex] = RenderPass(pointLight, std::move(renderPassObjects));
                 });
@@ -362,9 +366,9 @@ namespace ChilliSource
             
             // Transparent pass
             u32 transparentPassIndex = nextPassIndex++;
-            tasks.push_back([=, &renderPasses, &renderFrame, &visibleStandardRenderObjects](const TaskContext& innerTaskContext)
+            tasks.push_back([=, &renderPasses, &renderFrame, &renderObjects, &visibleObjectIndices](const TaskContext&)
             {
-                auto renderPassObjects = GetTransparentRenderPassObjects(visibleStandardRenderObjects);
+                auto renderPassObjects = GetRenderPassObjects(renderObjects, visibleObjectIndices, RenderPasses::k_transparent);
                 RenderPassObjectSorter::TransparentSort(renderFrame.GetRenderCamera(), renderPassObjects);
                 renderPasses[transparentPassIndex] = RenderPass(renderFrame.GetAmbientRenderLight(), std::move(renderPassObjects));
             });
@@ -392,11 +396,12 @@ namespace ChilliSource
             auto projMatrix = Matrix4::CreateOrthographicProjectionLH(0, f32(renderFrame.GetResolution().x), 0, f32(renderFrame.GetResolution().y), k_near, k_far);
             RenderCamera uiCamera(Matrix4::k_identity, projMatrix, Quaternion::k_identity);
             
-            auto uiRenderObjects = GetLayerRenderObjects(RenderLayer::k_ui, renderFrame.GetRenderObjects());
-            auto visibleUIRenderObjects = RenderPassVisibilityChecker::CalculateVisibleObjects(taskContext, uiCamera, uiRenderObjects);
+            const auto& renderObjects = renderFrame.GetRenderObjects();
+            auto uiObjectIndices = GetLayerObjectIndices(RenderLayer::k_ui, renderObjects);
+            auto visibleUIObjectIndices = RenderPassVisibilityChecker::CalculateVisibleObjectIndices(taskContext, uiCamera, renderObjects, uiObjectIndices);
             
-            auto uiRenderPassObjects = GetTransparentRenderPassObjects(visibleUIRenderObjects);
-            CS_ASSERT(visibleUIRenderObjects.size() == uiRenderPassObjects.size(), "Invalid number of render pass objects in transparent pass. All render objects in the UI layer should have a transparent material.");
+            auto uiRenderPassObjects = GetRenderPassObjects(renderObjects, visibleUIObjectIndices, RenderPasses::k_transparent);
+            CS_ASSERT(visibleUIObjectIndices.size() == uiRenderPassObjects.size(), "Invalid number of render pass objects in transparent pass. All render objects in the UI layer should have a transparent material.");
             
             RenderPassObjectSorter::PrioritySort(uiRenderPassObjects);
             
@@ -453,33 +458,28 @@ namespace ChilliSource
             }
         }
         
-        /// Gather all render objects in the frame that are to be renderered into a shadow RenderTarget
-        /// into a TargetRenderPassGroup.
+        /// Compiles the given shadow casters into a TargetRenderPassGroup for the shadow map of the
+        /// given light.
         ///
-        /// @param taskContext
-        ///     Context to manage any spawned tasks
-        /// @param renderFrame
-        ///     Current frame data
+        /// @param lightCamera
+        ///     The camera describing the shadow volume of the light.
         /// @param directionalRenderLight
         ///     The directional light that should have a shadow map built for it.
+        /// @param renderPassObjects
+        ///     The shadow map render pass objects for each shadow caster.
         ///
         /// @return The TargetRenderPassGroup
         ///
-        TargetRenderPassGroup CompileShadowMapTargetRenderPassGroup(const TaskContext& taskContext, const RenderFrame& renderFrame, const DirectionalRenderLight& directionalRenderLight) noexcept
+        TargetRenderPassGroup CompileShadowMapTargetRenderPassGroup(const RenderCamera& lightCamera, const DirectionalRenderLight& directionalRenderLight, std::vector<RenderPassObject> renderPassObjects) noexcept
         {
             CS_ASSERT(directionalRenderLight.GetShadowMapTarget(), "Cannot compile shadow map target with light that has no shadow map target.");
             
-            RenderCamera camera(directionalRenderLight.GetLightWorldMatrix(), directionalRenderLight.GetLightProjectionMatrix(), directionalRenderLight.GetLightOrientation());
-            
-            auto standardRenderObjects = GetLayerRenderObjects(RenderLayer::k_standard, renderFrame.GetRenderObjects());
-            auto visibleStandardRenderObjects = RenderPassVisibilityChecker::CalculateVisibleObjects(taskContext, renderFrame.GetRenderCamera(), standardRenderObjects);
-            auto renderPassObjects = GetShadowMapRenderPassObjects(visibleStandardRenderObjects);
-            RenderPassObjectSorter::OpaqueSort(renderFrame.GetRenderCamera(), renderPassObjects);
+            RenderPassObjectSorter::OpaqueSort(lightCamera, renderPassObjects);
             RenderPass renderPass(std::move(renderPassObjects));
             
             std::vector<RenderPass> renderPasses;
             renderPasses.push_back(std::move(renderPass));
-            CameraRenderPassGroup cameraRenderPassGroup(camera, std::move(renderPasses));
+            CameraRenderPassGroup cameraRenderPassGroup(lightCamera, std::move(renderPasses));
             
             std::vector<CameraRenderPassGroup> cameraRenderPassGroups;
             cameraRenderPassGroups.push_back(std::move(cameraRenderPassGroup));
@@ -497,6 +497,7 @@ namespace ChilliSource
         }
         
         std::vector<TargetRenderPassGroup> targetRenderPassGroups(numTargets);
+        std::vector<u8> isTargetCompiled(numTargets, 1);
         std::vector<Task> tasks;
         u32 nextPassIndex = 0;
         
@@ -508,9 +509,20 @@ namespace ChilliSource
                 if (directionalRenderLight.GetShadowMapTarget())
                 {
                     u32 shadowPassIndex = nextPassIndex++;
-                    tasks.push_back([=, &targetRenderPassGroups, &renderFrame, &directionalRenderLight](const TaskContext& innerTaskContext)
+                    tasks.push_back([=, &targetRenderPassGroups, &isTargetCompiled, &renderFrame, &directionalRenderLight](const TaskContext& innerTaskContext)
                     {
-                        targetRenderPassGroups[shadowPassIndex] = CompileShadowMapTargetRenderPassGroup(innerTaskContext, renderFrame, directionalRenderLight);
+                        RenderCamera lightCamera(directionalRenderLight.GetLightWorldMatrix(), directionalRenderLight.GetLightProjectionMatrix(), directionalRenderLight.GetLightOrientation());
+                        
+                        auto shadowCasterObjectIndices = GetShadowCasterObjectIndices(innerTaskContext, renderFrame, lightCamera, directionalRenderLight);
+                        auto renderPassObjects = GetRenderPassObjects(renderFrame.GetRenderObjects(), shadowCasterObjectIndices, RenderPasses::k_shadowMap);
+                        
+                        if (directionalRenderLight.IsShadowMapCachingEnabled() && TryUseCachedShadowMap(directionalRenderLight, renderPassObjects))
+                        {
+                            isTargetCompiled[shadowPassIndex] = 0;
+                            return;
+                        }
+                        
+                        targetRenderPassGroups[shadowPassIndex] = CompileShadowMapTargetRenderPassGroup(lightCamera, directionalRenderLight, std::move(renderPassObjects));
                     });
                 }
             }
@@ -525,6 +537,114 @@ namespace ChilliSource
         
         taskContext.ProcessChildTasks(tasks);
         
-        return targetRenderPassGroups;
+        RemoveUnusedShadowMapCacheEntries();
+        
+        //Remove the targets for cached shadow maps, which don't need to be rendered this frame.
+        std::vector<TargetRenderPassGroup> compiledTargetRenderPassGroups;
+        compiledTargetRenderPassGroups.reserve(numTargets);
+        for (u32 i = 0; i < numTargets; ++i)
+        {
+            if (isTargetCompiled[i] != 0)
+            {
+                compiledTargetRenderPassGroups.push_back(std::move(targetRenderPassGroups[i]));
+            }
+        }
+        
+        return compiledTargetRenderPassGroups;
+    }
+    
+    //------------------------------------------------------------------------------
+    void ForwardRenderPassCompiler::InvalidateCachedTargets() noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_shadowMapCacheMutex);
+        m_shadowMapCache.clear();
+    }
+    
+    //------------------------------------------------------------------------------
+    bool ForwardRenderPassCompiler::TryUseCachedShadowMap(const DirectionalRenderLight& directionalRenderLight, const std::vector<RenderPassObject>& renderPassObjects) noexcept
+    {
+        //Dynamic meshes and skinned animations are rebuilt from the frame allocator every frame, so
+        //their pointers can't identify their contents between frames. Shadow maps with such casters
+        //are always re-rendered.
+        bool hasFrameAllocatedCasters = false;
+        
+        std::vector<ShadowCasterState> casterStates;
+        casterStates.reserve(renderPassObjects.size());
+        for (const auto& renderPassObject : renderPassObjects)
+        {
+            if (renderPassObject.GetRenderDynamicMesh() || renderPassObject.GetRenderSkinnedAnimation())
+            {
+                hasFrameAllocatedCasters = true;
+                break;
+            }
+            
+            ShadowCasterState casterState;
+            casterState.m_renderMaterial = renderPassObject.GetRenderMaterial();
+            casterState.m_renderMesh = renderPassObject.GetRenderMesh();
+            casterState.m_worldMatrix = renderPassObject.GetWorldMatrix();
+            casterStates.push_back(casterState);
+        }
+        
+        if (hasFrameAllocatedCasters)
+        {
+            std::unique_lock<std::mutex> lock(m_shadowMapCacheMutex);
+            
+            auto& entry = m_shadowMapCache[directionalRenderLight.GetShadowMapTarget()];
+            entry.m_lightWorldMatrix = directionalRenderLight.GetLightWorldMatrix();
+            entry.m_lightProjectionMatrix = directionalRenderLight.GetLightProjectionMatrix();
+            entry.m_casterStates.clear();
+            entry.m_isValid = false;
+            entry.m_isInUse = true;
+            
+            return false;
+        }
+        
+        std::unique_lock<std::mutex> lock(m_shadowMapCacheMutex);
+        
+        auto entryIt = m_shadowMapCache.find(directionalRenderLight.GetShadowMapTarget());
+        if (entryIt != m_shadowMapCache.end())
+        {
+            auto& entry = entryIt->second;
+            entry.m_isInUse = true;
+            
+            if (entry.m_isValid && entry.m_lightWorldMatrix == directionalRenderLight.GetLightWorldMatrix() && entry.m_lightProjectionMatrix == directionalRenderLight.GetLightProjectionMatrix() && entry.m_casterStates == casterStates)
+            {
+                return true;
+            }
+        }
+        
+        auto& entry = m_shadowMapCache[directionalRenderLight.GetShadowMapTarget()];
+        entry.m_lightWorldMatrix = directionalRenderLight.GetLightWorldMatrix();
+        entry.m_lightProjectionMatrix = directionalRenderLight.GetLightProjectionMatrix();
+        entry.m_casterStates = std::move(casterStates);
+        entry.m_isValid = true;
+        entry.m_isInUse = true;
+        
+        return false;
+    }
+    
+    //------------------------------------------------------------------------------
+    void ForwardRenderPassCompiler::RemoveUnusedShadowMapCacheEntries() noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_shadowMapCacheMutex);
+        
+        for (auto it = m_shadowMapCache.begin(); it != m_shadowMapCache.end();)
+        {
+            if (it->second.m_isInUse == false)
+            {
+                it = m_shadowMapCache.erase(it);
+            }
+            else
+            {
+                it->second.m_isInUse = false;
+                ++it;
+            }
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    bool ForwardRenderPassCompiler::ShadowCasterState::operator==(const ShadowCasterState& other) const noexcept
+    {
+        return m_renderMaterial == other.m_renderMaterial && m_renderMesh == other.m_renderMesh && m_worldMatrix == other.m_worldMatrix;
     }
 }
@@ -30,6 +30,9 @@
 #include <ChilliSource/Rendering/Base/IRenderPassCompiler.h>
 #include <ChilliSource/Rendering/Base/CameraRenderPassGroup.h>
 
+#include <mutex>
+#include <unordered_map>
+
 namespace ChilliSource
 {
     /// Compiles the RenderPasses required when forward rendering. See ForwardRenderPasses.h for more
@@ -41,6 +44,10 @@ namespace ChilliSource
     /// by a TargetRenderPassGroup, which groups passes based on the framebuffer they are targetting.
     /// All this is processed in a series of background tasks.
     ///
+    /// Shadow maps for directional lights with shadow map caching enabled are only compiled when the
+    /// light or the shadow casters within its shadow volume have changed since the shadow map was
+    /// last rendered; otherwise the target is omitted and the previous contents are reused.
+    ///
     class ForwardRenderPassCompiler final : public IRenderPassCompiler
     {
     public:
@@ -55,6 +62,61 @@ namespace ChilliSource
         /// @return The list of target render pass groups
         ///
         std::vector<TargetRenderPassGroup> CompileTargetRenderPassGroups(const TaskContext& taskContext, std::vector<RenderFrame>&& renderFrames) noexcept override;
+        
+        /// Discards all cached shadow map state, ensuring every shadow map is re-rendered next frame.
+        ///
+        void InvalidateCachedTargets() noexcept override;
+        
+    private:
+        /// The state of a single shadow caster when a cached shadow map was rendered. Only casters
+        /// with a static mesh are described; a shadow map with dynamic mesh or skinned animation
+        /// casters is never cached.
+        ///
+        struct ShadowCasterState final
+        {
+            /// @param other
+            ///     The state to compare with.
+            ///
+            /// @return Whether or not the two states describe the same caster in the same position.
+            ///
+            bool operator==(const ShadowCasterState& other) const noexcept;
+            
+            const RenderMaterial* m_renderMaterial = nullptr;
+            const RenderMesh* m_renderMesh = nullptr;
+            Matrix4 m_worldMatrix;
+        };
+        
+        /// The state of the light and shadow casters when a cached shadow map was rendered.
+        ///
+        struct ShadowMapCacheEntry final
+        {
+            Matrix4 m_lightWorldMatrix;
+            Matrix4 m_lightProjectionMatrix;
+            std::vector<ShadowCasterState> m_casterStates;
+            bool m_isValid = false;
+            bool m_isInUse = false;
+        };
+        
+        /// Checks whether the cached contents of the shadow map for the given light are still valid
+        /// for the given shadow casters. If not, the cache entry is updated to describe the shadow
+        /// map which is about to be rendered. This is thread-safe.
+        ///
+        /// @param directionalRenderLight
+        ///     The light, which must have shadow map caching enabled.
+        /// @param renderPassObjects
+        ///     The shadow map render pass objects for the current shadow casters.
+        ///
+        /// @return Whether or not the previously rendered shadow map can be used.
+        ///
+        bool TryUseCachedShadowMap(const DirectionalRenderLight& directionalRenderLight, const std::vector<RenderPassObject>& renderPassObjects) noexcept;
+        
+        /// Removes cache entries for shadow maps which were not used since this was last called.
+        /// This ensures an entry cannot outlive its shadow map target.
+        ///
+        void RemoveUnusedShadowMapCacheEntries() noexcept;
+        
+        std::mutex m_shadowMapCacheMutex;
+        std::unordered_map<const RenderTargetGroup*, ShadowMapCacheEntry> m_shadowMapCache;
     };
 }
 
@@ -98,4 +98,21 @@ namespace ChilliSource
         
         CS_LOG_FATAL("Cannot push an allocator that is not owned by this queue");
     }
+    
+    //------------------------------------------------------------------------------
+    std::size_t FrameAllocatorQueue::GetReservedSize(const IAllocator* allocator) noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        for (auto& pagedLinearAllocator : m_allocators)
+        {
+            if (pagedLinearAllocator.get() == allocator)
+            {
+                return pagedLinearAllocator->GetNumPages() * pagedLinearAllocator->GetPageSize();
+            }
+        }
+        
+        CS_LOG_FATAL("Cannot query an allocator that is not owned by this queue");
+        return 0;
+    }
 }
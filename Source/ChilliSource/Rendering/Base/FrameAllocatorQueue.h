@@ -75,6 +75,18 @@ namespace ChilliSource
         ///
         void Push(IAllocator* allocator) noexcept;
         
+        /// Calculates the amount of memory currently reserved by the given allocator. This
+        /// should only be called by the thread which currently has ownership of the allocator.
+        ///
+        /// If the given allocator didn't originate from this queue then this will assert.
+        ///
+        /// @param allocator
+        ///     The allocator which should be queried.
+        ///
+        /// @return The reserved size in bytes.
+        ///
+        std::size_t GetReservedSize(const IAllocator* allocator) noexcept;
+        
     private:
         std::mutex m_mutex;
         std::condition_variable m_condition;
@@ -53,6 +53,11 @@ namespace ChilliSource
         ///
         virtual std::vector<TargetRenderPassGroup> CompileTargetRenderPassGroups(const TaskContext& taskContext, std::vector<RenderFrame>&& renderFrame) noexcept = 0;
         
+        /// Discards any state cached between frames which assumes the contents of render targets
+        /// are retained, for example when the render context has been lost and restored.
+        ///
+        virtual void InvalidateCachedTargets() noexcept = 0;
+        
         virtual ~IRenderPassCompiler() noexcept {};
         
     };
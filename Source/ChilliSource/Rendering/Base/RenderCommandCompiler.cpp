@@ -28,13 +28,17 @@
 #include <ChilliSource/Rendering/Base/CameraRenderPassGroup.h>
 #include <ChilliSource/Rendering/Base/RenderPass.h>
 #include <ChilliSource/Rendering/Base/TargetRenderPassGroup.h>
+#include <ChilliSource/Rendering/Material/RenderMaterial.h>
 #include <ChilliSource/Rendering/Model/SmallMeshBatcher.h>
 #include <ChilliSource/Rendering/Target/RenderTargetGroup.h>
+#include <ChilliSource/Rendering/Texture/RenderTexture.h>
 
 namespace ChilliSource
 {
     namespace
     {
+        constexpr u32 k_minInstancesPerDraw = 2;
+        
         /// An container for the current cached state of a render command list.
         ///
         struct RenderCommandListStateCache final
@@ -212,6 +216,11 @@ namespace ChilliSource
                 cache.m_skinnedAnimation = nullptr;
                 
                 renderCommandList->AddApplyMaterialCommand(cache.m_material);
+                
+                for (const auto& renderTexture : cache.m_material->GetRenderTextures2D())
+                {
+                    renderTexture->SetRendered();
+                }
             }
         }
         
@@ -286,17 +295,86 @@ namespace ChilliSource
             }
         }
         
+        /// Calculates the number of consecutive render pass objects, starting at the given index,
+        /// that share the same static mesh and material, and therefore could be rendered with a
+        /// single instanced draw. Objects which are animated or dynamic cannot be instanced, in
+        /// which case this will return 1.
+        ///
+        /// @param renderPassObjects
+        ///     The list of render pass objects.
+        /// @param startIndex
+        ///     The index of the first object in the run.
+        ///
+        /// @return The length of the run.
+        ///
+        u32 CalcInstanceRunLength(const std::vector<RenderPassObject>& renderPassObjects, std::size_t startIndex) noexcept
+        {
+            const auto& first = renderPassObjects[startIndex];
+            if (first.GetType() != RenderPassObject::Type::k_static)
+            {
+                return 1;
+            }
+            
+            u32 length = 1;
+            for (auto i = startIndex + 1; i < renderPassObjects.size(); ++i)
+            {
+                const auto& renderPassObject = renderPassObjects[i];
+                if (renderPassObject.GetType() != RenderPassObject::Type::k_static || renderPassObject.GetRenderMesh() != first.GetRenderMesh() ||
+                    renderPassObject.GetRenderMaterial() != first.GetRenderMaterial())
+                {
+                    break;
+                }
+                
+                ++length;
+            }
+            
+            return length;
+        }
+        
+        /// Calculates the number of world matrices needed to render all runs of instanceable
+        /// objects in the given render pass.
+        ///
+        /// @param renderPass
+        ///     The render pass.
+        ///
+        /// @return The number of world matrices required.
+        ///
+        u32 CalcNumInstancedObjects(const RenderPass& renderPass) noexcept
+        {
+            const auto& renderPassObjects = renderPass.GetRenderPassObjects();
+            
+            u32 count = 0;
+            for (std::size_t i = 0; i < renderPassObjects.size();)
+            {
+                auto runLength = CalcInstanceRunLength(renderPassObjects, i);
+                if (runLength >= k_minInstancesPerDraw)
+                {
+                    count += runLength;
+                }
+                
+                i += runLength;
+            }
+            
+            return count;
+        }
+        
         /// Compiles the render commands for the given render pass. The render pass must contain
         /// render pass objects otherwise this will assert.
         ///
+        /// Runs of consecutive objects which share the same static mesh and material are
+        /// rendered with a single render instances command, provided storage for their world
+        /// matrices has been supplied.
+        ///
         /// @param renderPass
         ///     The render pass.
         /// @param renderCommandList
         ///     The render command list to add the commands to.
-        /// @param renderFrameData
-        ///     Container for all allocations which must live until the end of the frame.
+        /// @param instanceWorldMatrices
+        ///     Frame allocated storage for the world matrices of instanced objects. This must be
+        ///     large enough to hold CalcNumInstancedObjects() matrices, or null if instancing
+        ///     shouldn't be used for the pass.
         ///
-        void CompileRenderCommandsForPass(const RenderPass& renderPass, RenderCommandList* renderCommandList) noexcept
+        void CompileRenderCommandsForPass(const RenderPass& renderPass, RenderCommandList* renderCommandList, Matrix4* instanceWorldMatrices) noexcept
         {
             AddApplyLightCommand(renderPass, renderCommandList);
             
@@ -306,8 +384,10 @@ namespace ChilliSource
             RenderCommandListStateCache cache;
             SmallMeshBatcher batcher(renderCommandList);
             
-            for (const auto& renderPassObject : renderPassObjects)
+            for (std::size_t i = 0; i < renderPassObjects.size(); ++i)
             {
+                const auto& renderPassObject = renderPassObjects[i];
+                
                 AddApplyMaterialCommand(renderPassObject, renderCommandList, cache, batcher);
                 
                 if (SmallMeshBatcher::CanBatch(renderPassObject))
@@ -323,7 +403,24 @@ namespace ChilliSource
                     
                     AddApplyMeshCommand(renderPassObject, renderCommandList, cache);
                     AddApplySkinnedAnimationCommand(renderPassObject, renderCommandList, cache);
-                    renderCommandList->AddRenderInstanceCommand(renderPassObject.GetWorldMatrix());
+                    
+                    auto runLength = instanceWorldMatrices ? CalcInstanceRunLength(renderPassObjects, i) : 1;
+                    if (runLength >= k_minInstancesPerDraw)
+                    {
+                        for (u32 j = 0; j < runLength; ++j)
+                        {
+                            instanceWorldMatrices[j] = renderPassObjects[i + j].GetWorldMatrix();
+                        }
+                        
+                        renderCommandList->AddRenderInstancesCommand(instanceWorldMatrices, runLength);
+                        
+                        instanceWorldMatrices += runLength;
+                        i += runLength - 1;
+                    }
+                    else
+                    {
+                        renderCommandList->AddRenderInstanceCommand(renderPassObject.GetWorldMatrix());
+                    }
                 }
                 
             }
@@ -362,9 +459,18 @@ namespace ChilliSource
                         if (renderPass.GetRenderPassObjects().size() > 0)
                         {
                             auto renderCommandList = renderCommandBuffer->GetRenderCommandList(currentList++);
-                            tasks.push_back([=, &renderPass, &renderCommandBuffer](const TaskContext& innerTaskContext)
+                            
+                            // The frame allocator isn't thread-safe so storage for instance data is allocated up front.
+                            Matrix4* instanceWorldMatrices = nullptr;
+                            auto numInstancedObjects = CalcNumInstancedObjects(renderPass);
+                            if (numInstancedObjects > 0 && numInstancedObjects <= renderCommandBuffer->GetMaxWorldMatrices())
+                            {
+                                instanceWorldMatrices = renderCommandBuffer->AllocateWorldMatrices(numInstancedObjects);
+                            }
+                            
+                            tasks.push_back([=, &renderPass, &renderCommandBuffer](const TaskContext&)
                             {
-                                CompileRenderCommandsForPass(renderPass, renderCommandList);
+                                CompileRenderCommandsForPass(renderPass, renderCommandList, instanceWorldMatrices);
                             });
                         }
                     }
@@ -384,6 +490,6 @@ namespace ChilliSource
             taskContext.ProcessChildTasks(tasks);
         }
         
-        return std::move(renderCommandBuffer);
+        return renderCommandBuffer;
     }
 }
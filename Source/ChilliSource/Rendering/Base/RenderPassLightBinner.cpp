@@ -0,0 +1,233 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Rendering/Base/RenderPassLightBinner.h>
+
+#include <ChilliSource/Core/Math/Geometry/ShapeIntersection.h>
+#include <ChilliSource/Rendering/Base/RenderObject.h>
+#include <ChilliSource/Rendering/Lighting/PointRenderLight.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ChilliSource
+{
+    namespace
+    {
+        constexpr u32 k_maxCellsPerAxis = 16;
+        
+        /// A coarse uniform grid fitted around a set of bounding spheres. Cell contents are
+        /// stored in a single contiguous list, with each cell described by an offset into it.
+        ///
+        class LightGrid final
+        {
+        public:
+            /// Builds the grid from the given render objects and bins the given lights into it.
+            ///
+            /// @param pointRenderLights
+            ///     The lights to bin.
+            /// @param renderObjects
+            ///     The collection of render objects the indices refer to.
+            /// @param objectIndices
+            ///     The indices of the render objects the grid should be fitted around.
+            ///
+            LightGrid(const std::vector<PointRenderLight>& pointRenderLights, const std::vector<RenderObject>& renderObjects, const std::vector<u32>& objectIndices) noexcept
+            {
+                CS_ASSERT(objectIndices.size() > 0, "Cannot build a light grid without any render objects.");
+                
+                m_min = renderObjects[objectIndices[0]].GetBoundingSphere().vOrigin;
+                Vector3 max = m_min;
+                for (auto objectIndex : objectIndices)
+                {
+                    const auto& sphere = renderObjects[objectIndex].GetBoundingSphere();
+                    m_min = Vector3::Min(m_min, sphere.vOrigin - Vector3(sphere.fRadius, sphere.fRadius, sphere.fRadius));
+                    max = Vector3::Max(max, sphere.vOrigin + Vector3(sphere.fRadius, sphere.fRadius, sphere.fRadius));
+                }
+                
+                u32 cellsPerAxis = std::max(1u, std::min(k_maxCellsPerAxis, u32(std::cbrt(f32(objectIndices.size())))));
+                Vector3 extents = max - m_min;
+                m_numCells = Integer3(s32(extents.x > 0.0f ? cellsPerAxis : 1), s32(extents.y > 0.0f ? cellsPerAxis : 1), s32(extents.z > 0.0f ? cellsPerAxis : 1));
+                m_cellSize = Vector3(extents.x > 0.0f ? extents.x / m_numCells.x : 1.0f, extents.y > 0.0f ? extents.y / m_numCells.y : 1.0f, extents.z > 0.0f ? extents.z / m_numCells.z : 1.0f);
+                
+                //Count the lights in each cell, then convert the counts to offsets and fill the cells.
+                m_cellOffsets.resize(m_numCells.x * m_numCells.y * m_numCells.z + 1, 0);
+                for (const auto& pointRenderLight : pointRenderLights)
+                {
+                    ForEachCell(Sphere(pointRenderLight.GetPosition(), pointRenderLight.GetRangeOfInfluence()), [this](u32 cellIndex)
+                    {
+                        ++m_cellOffsets[cellIndex + 1];
+                    });
+                }
+                
+                for (std::size_t i = 1; i < m_cellOffsets.size(); ++i)
+                {
+                    m_cellOffsets[i] += m_cellOffsets[i - 1];
+                }
+                
+                m_cellLights.resize(m_cellOffsets.back());
+                std::vector<u32> cellFill(m_cellOffsets.begin(), m_cellOffsets.end() - 1);
+                for (u32 lightIndex = 0; lightIndex < u32(pointRenderLights.size()); ++lightIndex)
+                {
+                    const auto& pointRenderLight = pointRenderLights[lightIndex];
+                    ForEachCell(Sphere(pointRenderLight.GetPosition(), pointRenderLight.GetRangeOfInfluence()), [this, &cellFill, lightIndex](u32 cellIndex)
+                    {
+                        m_cellLights[cellFill[cellIndex]++] = lightIndex;
+                    });
+                }
+            }
+            
+            /// Calls the given function with the index of each cell the given sphere overlaps. If
+            /// the sphere is entirely outside of the grid, the function is not called.
+            ///
+            /// @param sphere
+            ///     The sphere.
+            /// @param function
+            ///     The function to call for each overlapped cell.
+            ///
+            template <typename TFunction> void ForEachCell(const Sphere& sphere, const TFunction& function) const noexcept
+            {
+                Integer3 minCell, maxCell;
+                if (CalcCellRange(sphere, minCell, maxCell) == false)
+                {
+                    return;
+                }
+                
+                for (s32 z = minCell.z; z <= maxCell.z; ++z)
+                {
+                    for (s32 y = minCell.y; y <= maxCell.y; ++y)
+                    {
+                        for (s32 x = minCell.x; x <= maxCell.x; ++x)
+                        {
+                            function(u32(x + m_numCells.x * (y + m_numCells.y * z)));
+                        }
+                    }
+                }
+            }
+            
+            /// @param cellIndex
+            ///     The index of the cell.
+            ///
+            /// @return A pointer to the first light index in the given cell.
+            ///
+            const u32* GetCellLightsBegin(u32 cellIndex) const noexcept { return m_cellLights.data() + m_cellOffsets[cellIndex]; }
+            
+            /// @param cellIndex
+            ///     The index of the cell.
+            ///
+            /// @return A pointer to one past the last light index in the given cell.
+            ///
+            const u32* GetCellLightsEnd(u32 cellIndex) const noexcept { return m_cellLights.data() + m_cellOffsets[cellIndex + 1]; }
+            
+        private:
+            /// Calculates the range of cells overlapped by the axis aligned bounds of the given
+            /// sphere.
+            ///
+            /// @param sphere
+            ///     The sphere.
+            /// @param out_minCell
+            ///     (Out) The minimum cell on each axis.
+            /// @param out_maxCell
+            ///     (Out) The maximum cell on each axis.
+            ///
+            /// @return Whether or not the sphere overlaps the grid.
+            ///
+            bool CalcCellRange(const Sphere& sphere, Integer3& out_minCell, Integer3& out_maxCell) const noexcept
+            {
+                Vector3 cellMin = (sphere.vOrigin - Vector3(sphere.fRadius, sphere.fRadius, sphere.fRadius) - m_min) / m_cellSize;
+                Vector3 cellMax = (sphere.vOrigin + Vector3(sphere.fRadius, sphere.fRadius, sphere.fRadius) - m_min) / m_cellSize;
+                
+                if (cellMax.x < 0.0f || cellMax.y < 0.0f || cellMax.z < 0.0f || cellMin.x > f32(m_numCells.x) || cellMin.y > f32(m_numCells.y) || cellMin.z > f32(m_numCells.z))
+                {
+                    return false;
+                }
+                
+                out_minCell = Integer3(ClampCell(cellMin.x, m_numCells.x), ClampCell(cellMin.y, m_numCells.y), ClampCell(cellMin.z, m_numCells.z));
+                out_maxCell = Integer3(ClampCell(cellMax.x, m_numCells.x), ClampCell(cellMax.y, m_numCells.y), ClampCell(cellMax.z, m_numCells.z));
+                return true;
+            }
+            
+            /// @param cellCoord
+            ///     The unclamped cell space coordinate.
+            /// @param numCells
+            ///     The number of cells on the axis.
+            ///
+            /// @return The index of the cell containing the coordinate, clamped to the grid.
+            ///
+            static s32 ClampCell(f32 cellCoord, s32 numCells) noexcept
+            {
+                return std::max(0, std::min(numCells - 1, s32(std::floor(cellCoord))));
+            }
+            
+            Vector3 m_min;
+            Vector3 m_cellSize;
+            Integer3 m_numCells;
+            std::vector<u32> m_cellOffsets;
+            std::vector<u32> m_cellLights;
+        };
+    }
+    
+    //------------------------------------------------------------------------------
+    std::vector<std::vector<u32>> RenderPassLightBinner::CalculatePointLightObjects(const std::vector<PointRenderLight>& pointRenderLights, const std::vector<RenderObject>& renderObjects,
+                                                                                    const std::vector<u32>& objectIndices) noexcept
+    {
+        std::vector<std::vector<u32>> lightObjects(pointRenderLights.size());
+        if (pointRenderLights.empty() || objectIndices.empty())
+        {
+            return lightObjects;
+        }
+        
+        LightGrid grid(pointRenderLights, renderObjects, objectIndices);
+        
+        //An object can overlap several cells containing the same light, so track the last object each light was tested against.
+        constexpr u32 k_noObject = std::numeric_limits<u32>::max();
+        std::vector<u32> lastTestedObject(pointRenderLights.size(), k_noObject);
+        
+        for (auto objectIndex : objectIndices)
+        {
+            const auto& objectSphere = renderObjects[objectIndex].GetBoundingSphere();
+            grid.ForEachCell(objectSphere, [&](u32 cellIndex)
+            {
+                for (auto it = grid.GetCellLightsBegin(cellIndex); it != grid.GetCellLightsEnd(cellIndex); ++it)
+                {
+                    u32 lightIndex = *it;
+                    if (lastTestedObject[lightIndex] == objectIndex)
+                    {
+                        continue;
+                    }
+                    lastTestedObject[lightIndex] = objectIndex;
+                    
+                    const auto& pointRenderLight = pointRenderLights[lightIndex];
+                    if (ShapeIntersection::Intersects(Sphere(pointRenderLight.GetPosition(), pointRenderLight.GetRangeOfInfluence()), objectSphere))
+                    {
+                        lightObjects[lightIndex].push_back(objectIndex);
+                    }
+                }
+            });
+        }
+        
+        return lightObjects;
+    }
+}
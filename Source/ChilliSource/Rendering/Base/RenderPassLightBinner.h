@@ -0,0 +1,60 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#ifndef _CHILLISOURCE_RENDERING_BASE_RENDERPASSLIGHTBINNER_H_
+#define _CHILLISOURCE_RENDERING_BASE_RENDERPASSLIGHTBINNER_H_
+
+#include <ChilliSource/ChilliSource.h>
+
+#include <vector>
+
+namespace ChilliSource
+{
+    /// Collection of functions for assigning lights to the render objects they affect.
+    ///
+    namespace RenderPassLightBinner
+    {
+        /// Calculates which of the given render objects are within the range of influence of
+        /// each of the given point lights. Rather than testing every light against every object,
+        /// the lights are first binned into a coarse uniform grid fitted around the objects. Each
+        /// object then only tests against the lights in the grid cells it overlaps, giving the
+        /// light lists for all objects in a single pass.
+        ///
+        /// @param pointRenderLights
+        ///     The point lights.
+        /// @param renderObjects
+        ///     The collection of render objects the indices refer to.
+        /// @param objectIndices
+        ///     The indices of the render objects which should be assigned to lights.
+        ///
+        /// @return For each point light, the indices of the render objects within its range of
+        ///     influence, in the same order as they appear in objectIndices.
+        ///
+        std::vector<std::vector<u32>> CalculatePointLightObjects(const std::vector<PointRenderLight>& pointRenderLights, const std::vector<RenderObject>& renderObjects,
+                                                                 const std::vector<u32>& objectIndices) noexcept;
+    }
+}
+
+#endif
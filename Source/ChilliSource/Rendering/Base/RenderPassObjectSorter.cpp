@@ -26,51 +26,113 @@
 
 #include <ChilliSource/Rendering/Camera/RenderCamera.h>
 
+#include <algorithm>
+
 namespace ChilliSource
 {
+    namespace
+    {
+        /// The values a render pass object is sorted on, calculated once per object rather than
+        /// on every comparison.
+        ///
+        struct SortKey final
+        {
+            const RenderMaterial* m_renderMaterial;
+            const RenderMesh* m_renderMesh;
+            f32 m_depth;
+            u32 m_index;
+        };
+        
+        /// Builds the sort keys for the given render pass objects.
+        ///
+        /// @param camera
+        ///     The camera the depth of each object should be calculated relative to.
+        /// @param renderPassObjects
+        ///     The render pass objects.
+        ///
+        /// @return The sort keys, in the same order as the render pass objects.
+        ///
+        std::vector<SortKey> BuildSortKeys(const RenderCamera& camera, const std::vector<RenderPassObject>& renderPassObjects) noexcept
+        {
+            std::vector<SortKey> sortKeys;
+            sortKeys.reserve(renderPassObjects.size());
+            
+            for (u32 i = 0; i < u32(renderPassObjects.size()); ++i)
+            {
+                const auto& renderPassObject = renderPassObjects[i];
+                Matrix4 wvp = renderPassObject.GetWorldMatrix() * camera.GetViewProjectionMatrix();
+                sortKeys.push_back(SortKey { renderPassObject.GetRenderMaterial(), renderPassObject.GetRenderMesh(), wvp.GetTranslation().z, i });
+            }
+            
+            return sortKeys;
+        }
+        
+        /// Reorders the given render pass objects into the order described by the given sorted keys.
+        ///
+        /// @param sortKeys
+        ///     The sorted keys.
+        /// @param renderPassObjects
+        ///     The render pass objects to reorder.
+        ///
+        void ApplySortKeys(const std::vector<SortKey>& sortKeys, std::vector<RenderPassObject>& renderPassObjects) noexcept
+        {
+            std::vector<RenderPassObject> sortedRenderPassObjects;
+            sortedRenderPassObjects.reserve(renderPassObjects.size());
+            
+            for (const auto& sortKey : sortKeys)
+            {
+                sortedRenderPassObjects.push_back(renderPassObjects[sortKey.m_index]);
+            }
+            
+            renderPassObjects = std::move(sortedRenderPassObjects);
+        }
+    }
+    
     //------------------------------------------------------------------------------
     void RenderPassObjectSorter::OpaqueSort(const RenderCamera& camera, std::vector<RenderPassObject>& renderPassObjects) noexcept
     {
-        std::sort(renderPassObjects.begin(), renderPassObjects.end(), [&camera](const RenderPassObject& a, const RenderPassObject& b)
+        auto sortKeys = BuildSortKeys(camera, renderPassObjects);
+        
+        std::sort(sortKeys.begin(), sortKeys.end(), [](const SortKey& a, const SortKey& b)
         {
-            if (a.GetRenderMaterial() == b.GetRenderMaterial())
+            if (a.m_renderMaterial == b.m_renderMaterial)
             {
-                Matrix4 wvpA = a.GetWorldMatrix() * camera.GetViewProjectionMatrix();
-                Matrix4 wvpB = b.GetWorldMatrix() * camera.GetViewProjectionMatrix();
-                
-                if (wvpA.GetTranslation().z == wvpB.GetTranslation().z)
+                if (a.m_depth == b.m_depth)
                 {
-                    return (a.GetRenderMesh() < b.GetRenderMesh());
+                    return (a.m_renderMesh < b.m_renderMesh);
                 }
                 else
                 {
-                    return (wvpA.GetTranslation().z > wvpB.GetTranslation().z);
+                    return (a.m_depth > b.m_depth);
                 }
             }
             else
             {
-                return (a.GetRenderMaterial() < b.GetRenderMaterial());
+                return (a.m_renderMaterial < b.m_renderMaterial);
             }
         });
+        
+        ApplySortKeys(sortKeys, renderPassObjects);
     }
     
     //------------------------------------------------------------------------------
     void RenderPassObjectSorter::TransparentSort(const RenderCamera& camera, std::vector<RenderPassObject>& renderPassObjects) noexcept
     {
-        std::sort(renderPassObjects.begin(), renderPassObjects.end(), [&camera](const RenderPassObject& a, const RenderPassObject& b)
+        auto sortKeys = BuildSortKeys(camera, renderPassObjects);
+        
+        std::sort(sortKeys.begin(), sortKeys.end(), [](const SortKey& a, const SortKey& b)
         {
-            Matrix4 wvpA = a.GetWorldMatrix() * camera.GetViewProjectionMatrix();
-            Matrix4 wvpB = b.GetWorldMatrix() * camera.GetViewProjectionMatrix();
-            
-            if (wvpA.GetTranslation().z == wvpB.GetTranslation().z)
+            if (a.m_depth == b.m_depth)
             {
-                return (a.GetRenderMesh() < b.GetRenderMesh());
+                return (a.m_renderMesh < b.m_renderMesh);
             }
             else
             {
-                return (wvpA.GetTranslation().z > wvpB.GetTranslation().z);
+                return (a.m_depth > b.m_depth);
             }
         });
+        
+        ApplySortKeys(sortKeys, renderPassObjects);
     }
     
     //------------------------------------------------------------------------------
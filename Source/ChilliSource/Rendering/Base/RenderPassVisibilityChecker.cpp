@@ -31,6 +31,8 @@
 #include <ChilliSource/Rendering/Base/RenderObject.h>
 #include <ChilliSource/Rendering/Base/RenderPassObject.h>
 
+#include <algorithm>
+
 namespace ChilliSource
 {
     namespace
@@ -48,7 +50,7 @@ namespace ChilliSource
         std::vector<Task> tasks;
         for (u32 taskIndex = 0; taskIndex < numTasks; ++taskIndex)
         {
-            tasks.push_back([=, &camera, &renderObjects, &visibleObjectsMutex, &visibleRenderObjects](const TaskContext& innerTaskContext)
+            tasks.push_back([=, &camera, &renderObjects, &visibleObjectsMutex, &visibleRenderObjects](const TaskContext&)
             {
                 std::vector<RenderObject> taskVisibleObjects;
                 for(u32 objectIndex = 0; objectIndex < k_objectsPerVisibilityBatch; ++objectIndex)
@@ -76,4 +78,50 @@ namespace ChilliSource
         
         return visibleRenderObjects;
     }
+    
+    //------------------------------------------------------------------------------
+    std::vector<u32> RenderPassVisibilityChecker::CalculateVisibleObjectIndices(const TaskContext& taskContext, const RenderCamera& camera, const std::vector<RenderObject>& renderObjects, const std::vector<u32>& objectIndices) noexcept
+    {
+        //Each batch writes its results into its own range of the output, which is then compacted in order.
+        std::vector<u32> visibleObjectIndices(objectIndices.size());
+        u32 numTasks = 1 + (u32(objectIndices.size()) / k_objectsPerVisibilityBatch);
+        std::vector<u32> numVisiblePerTask(numTasks, 0);
+        
+        std::vector<Task> tasks;
+        for (u32 taskIndex = 0; taskIndex < numTasks; ++taskIndex)
+        {
+            tasks.push_back([=, &camera, &renderObjects, &objectIndices, &visibleObjectIndices, &numVisiblePerTask](const TaskContext&)
+            {
+                u32 batchStart = taskIndex * k_objectsPerVisibilityBatch;
+                u32 batchEnd = std::min(batchStart + k_objectsPerVisibilityBatch, u32(objectIndices.size()));
+                
+                u32 numVisible = 0;
+                for (u32 index = batchStart; index < batchEnd; ++index)
+                {
+                    u32 objectIndex = objectIndices[index];
+                    if (camera.GetFrustrum().SphereCullTest(renderObjects[objectIndex].GetBoundingSphere()))
+                    {
+                        visibleObjectIndices[batchStart + numVisible++] = objectIndex;
+                    }
+                }
+                
+                numVisiblePerTask[taskIndex] = numVisible;
+            });
+        }
+        
+        taskContext.ProcessChildTasks(tasks);
+        
+        u32 numVisible = 0;
+        for (u32 taskIndex = 0; taskIndex < numTasks; ++taskIndex)
+        {
+            u32 batchStart = taskIndex * k_objectsPerVisibilityBatch;
+            for (u32 i = 0; i < numVisiblePerTask[taskIndex]; ++i)
+            {
+                visibleObjectIndices[numVisible++] = visibleObjectIndices[batchStart + i];
+            }
+        }
+        visibleObjectIndices.resize(numVisible);
+        
+        return visibleObjectIndices;
+    }
 } 
@@ -51,6 +51,23 @@ namespace ChilliSource
         /// @return Collection of visible RenderObjects
         ///
         std::vector<RenderObject> CalculateVisibleObjects(const TaskContext& taskContext, const RenderCamera& camera, const std::vector<RenderObject>& renderObjects) noexcept;
+        
+        /// Checks the visibility of a subset of the given RenderObjects, identified by their indices,
+        /// and returns the indices of those which are within the passed camera's view frustrum. This
+        /// avoids copying RenderObjects, and the order of the given indices is preserved.
+        ///
+        /// @param taskContext
+        ///     Context to manage any spawned tasks
+        /// @param camera
+        ///     The camera who will decide the objects visibility
+        /// @param renderObjects
+        ///     The collection of RenderObjects the indices refer to.
+        /// @param objectIndices
+        ///     The indices of the RenderObjects whos visibility is to be checked.
+        ///
+        /// @return The indices of the visible RenderObjects.
+        ///
+        std::vector<u32> CalculateVisibleObjectIndices(const TaskContext& taskContext, const RenderCamera& camera, const std::vector<RenderObject>& renderObjects, const std::vector<u32>& objectIndices) noexcept;
     }
 }
 
@@ -0,0 +1,79 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Rendering/Base/RenderPipelineStats.h>
+
+#include <json/json.h>
+
+namespace ChilliSource
+{
+    namespace
+    {
+        const char k_stageNames[static_cast<std::size_t>(RenderPipelineStats::Stage::k_total)][24] =
+        {
+            "CompileRenderFrame",
+            "CompileRenderPasses",
+            "CompileRenderCommands",
+            "ProcessRenderCommands"
+        };
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderPipelineStats::SetStageTime(Stage stage, f64 timeMicroS) noexcept
+    {
+        CS_ASSERT(stage != Stage::k_total, "Invalid render pipeline stage.");
+        
+        m_stageTimes[static_cast<std::size_t>(stage)] = timeMicroS;
+    }
+    
+    //------------------------------------------------------------------------------
+    f64 RenderPipelineStats::GetStageTime(Stage stage) const noexcept
+    {
+        CS_ASSERT(stage != Stage::k_total, "Invalid render pipeline stage.");
+        
+        return m_stageTimes[static_cast<std::size_t>(stage)];
+    }
+    
+    //------------------------------------------------------------------------------
+    Json::Value RenderPipelineStats::ToJson() const noexcept
+    {
+        Json::Value stageTimes(Json::objectValue);
+        for (std::size_t i = 0; i < m_stageTimes.size(); ++i)
+        {
+            stageTimes[k_stageNames[i]] = m_stageTimes[i];
+        }
+        
+        Json::Value output(Json::objectValue);
+        output["StageTimesMicroS"] = stageTimes;
+        output["NumRenderFrames"] = Json::UInt(m_numRenderFrames);
+        output["NumRenderObjects"] = Json::UInt(m_numRenderObjects);
+        output["NumRenderPasses"] = Json::UInt(m_numRenderPasses);
+        output["NumRenderPassObjects"] = Json::UInt(m_numRenderPassObjects);
+        output["NumRenderCommands"] = Json::UInt(m_numRenderCommands);
+        output["FrameAllocatorSize"] = Json::UInt64(m_frameAllocatorSize);
+        
+        return output;
+    }
+}
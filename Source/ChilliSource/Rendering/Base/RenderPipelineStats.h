@@ -0,0 +1,148 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#ifndef _CHILLISOURCE_RENDERING_BASE_RENDERPIPELINESTATS_H_
+#define _CHILLISOURCE_RENDERING_BASE_RENDERPIPELINESTATS_H_
+
+#include <ChilliSource/ChilliSource.h>
+
+#include <json/forwards.h>
+
+#include <array>
+
+namespace ChilliSource
+{
+    /// A container for timing and allocation statistics gathered for a single frame as it
+    /// passes through the render pipeline. This allows regressions in the individual stages of
+    /// the pipeline to be tracked over time; the statistics can be output in a machine readable
+    /// (json) format for this purpose.
+    ///
+    /// See Renderer.h for more information on the stages of the render pipeline.
+    ///
+    /// This is not thread-safe.
+    ///
+    class RenderPipelineStats final
+    {
+    public:
+        /// The stages of the render pipeline which are timed.
+        ///
+        enum class Stage
+        {
+            k_compileRenderFrame,
+            k_compileRenderPasses,
+            k_compileRenderCommands,
+            k_processRenderCommands,
+            k_total
+        };
+        
+        /// Sets the time taken to process the given stage of the pipeline.
+        ///
+        /// @param stage
+        ///     The stage of the pipeline.
+        /// @param timeMicroS
+        ///     The time taken in microseconds.
+        ///
+        void SetStageTime(Stage stage, f64 timeMicroS) noexcept;
+        
+        /// @param stage
+        ///     The stage of the pipeline.
+        ///
+        /// @return The time taken to process the given stage in microseconds.
+        ///
+        f64 GetStageTime(Stage stage) const noexcept;
+        
+        /// @param numRenderFrames
+        ///     The number of render frames processed, including offscreen frames.
+        ///
+        void SetNumRenderFrames(u32 numRenderFrames) noexcept { m_numRenderFrames = numRenderFrames; }
+        
+        /// @return The number of render frames processed, including offscreen frames.
+        ///
+        u32 GetNumRenderFrames() const noexcept { return m_numRenderFrames; }
+        
+        /// @param numRenderObjects
+        ///     The number of render objects in all frames.
+        ///
+        void SetNumRenderObjects(u32 numRenderObjects) noexcept { m_numRenderObjects = numRenderObjects; }
+        
+        /// @return The number of render objects in all frames.
+        ///
+        u32 GetNumRenderObjects() const noexcept { return m_numRenderObjects; }
+        
+        /// @param numRenderPasses
+        ///     The number of non-empty render passes that were compiled.
+        ///
+        void SetNumRenderPasses(u32 numRenderPasses) noexcept { m_numRenderPasses = numRenderPasses; }
+        
+        /// @return The number of non-empty render passes that were compiled.
+        ///
+        u32 GetNumRenderPasses() const noexcept { return m_numRenderPasses; }
+        
+        /// @param numRenderPassObjects
+        ///     The number of render pass objects in all render passes.
+        ///
+        void SetNumRenderPassObjects(u32 numRenderPassObjects) noexcept { m_numRenderPassObjects = numRenderPassObjects; }
+        
+        /// @return The number of render pass objects in all render passes.
+        ///
+        u32 GetNumRenderPassObjects() const noexcept { return m_numRenderPassObjects; }
+        
+        /// @param numRenderCommands
+        ///     The number of render commands in the render command buffer.
+        ///
+        void SetNumRenderCommands(u32 numRenderCommands) noexcept { m_numRenderCommands = numRenderCommands; }
+        
+        /// @return The number of render commands in the render command buffer.
+        ///
+        u32 GetNumRenderCommands() const noexcept { return m_numRenderCommands; }
+        
+        /// @param frameAllocatorSize
+        ///     The amount of memory, in bytes, reserved by the frame allocator during the frame.
+        ///
+        void SetFrameAllocatorSize(std::size_t frameAllocatorSize) noexcept { m_frameAllocatorSize = frameAllocatorSize; }
+        
+        /// @return The amount of memory, in bytes, reserved by the frame allocator during the frame.
+        ///
+        std::size_t GetFrameAllocatorSize() const noexcept { return m_frameAllocatorSize; }
+        
+        /// Converts the statistics to json, allowing them to be output in a machine readable
+        /// format.
+        ///
+        /// @return The json representation of the statistics.
+        ///
+        Json::Value ToJson() const noexcept;
+        
+    private:
+        std::array<f64, static_cast<std::size_t>(Stage::k_total)> m_stageTimes {{ 0.0, 0.0, 0.0, 0.0 }};
+        u32 m_numRenderFrames = 0;
+        u32 m_numRenderObjects = 0;
+        u32 m_numRenderPasses = 0;
+        u32 m_numRenderPassObjects = 0;
+        u32 m_numRenderCommands = 0;
+        std::size_t m_frameAllocatorSize = 0;
+    };
+}
+
+#endif
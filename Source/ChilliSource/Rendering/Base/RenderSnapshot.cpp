@@ -28,8 +28,8 @@ namespace ChilliSource
 {
     //------------------------------------------------------------------------------
     RenderSnapshot::RenderSnapshot(const RenderTargetGroup* renderTarget, const Integer2& resolution, const Colour& clearColour, const RenderCamera& in_renderCamera) noexcept
-        : m_offscreenRenderTarget(renderTarget), m_resolution(resolution), m_clearColour(clearColour), m_renderCamera(in_renderCamera), m_preRenderCommandList(new RenderCommandList()), m_postRenderCommandList(new RenderCommandList()),
-          m_renderFrameData()
+        : m_resolution(resolution), m_clearColour(clearColour), m_renderCamera(in_renderCamera), m_preRenderCommandList(new RenderCommandList()), m_postRenderCommandList(new RenderCommandList()),
+          m_renderFrameData(), m_offscreenRenderTarget(renderTarget)
     {
     }
     
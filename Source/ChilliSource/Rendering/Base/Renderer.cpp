@@ -26,10 +26,13 @@
 
 #include <ChilliSource/Core/Base/Application.h>
 #include <ChilliSource/Core/Threading/TaskScheduler.h>
+#include <ChilliSource/Core/Time/PerformanceTimer.h>
 #include <ChilliSource/Rendering/Base/ForwardRenderPassCompiler.h>
 #include <ChilliSource/Rendering/Base/RenderCommandCompiler.h>
 #include <ChilliSource/Rendering/Base/RenderCommandBufferManager.h>
 #include <ChilliSource/Rendering/Base/RenderFrameCompiler.h>
+#include <ChilliSource/Rendering/Base/TargetRenderPassGroup.h>
+#include <ChilliSource/Rendering/RenderCommand/RenderCommandList.h>
 
 namespace ChilliSource
 {
@@ -56,6 +59,53 @@ namespace ChilliSource
             
             return RenderFrameCompiler::CompileRenderFrame(offscreenTarget, resolution, clearColour, renderCamera, renderAmbientLights, renderDirectionalLights, renderPointLights, renderObjects);
         }
+        
+        /// Counts the non-empty render passes and render pass objects in the given target render
+        /// pass groups, and stores the results in the given stats.
+        ///
+        /// @param targetRenderPassGroups
+        ///     The target render pass groups.
+        /// @param stats
+        ///     [Out] The stats to populate.
+        ///
+        void CountRenderPassStats(const std::vector<TargetRenderPassGroup>& targetRenderPassGroups, RenderPipelineStats& stats) noexcept
+        {
+            u32 numRenderPasses = 0;
+            u32 numRenderPassObjects = 0;
+            for (const auto& targetRenderPassGroup : targetRenderPassGroups)
+            {
+                for (const auto& cameraRenderPassGroup : targetRenderPassGroup.GetRenderCameraGroups())
+                {
+                    for (const auto& renderPass : cameraRenderPassGroup.GetRenderPasses())
+                    {
+                        if (renderPass.GetRenderPassObjects().size() > 0)
+                        {
+                            ++numRenderPasses;
+                            numRenderPassObjects += u32(renderPass.GetRenderPassObjects().size());
+                        }
+                    }
+                }
+            }
+            
+            stats.SetNumRenderPasses(numRenderPasses);
+            stats.SetNumRenderPassObjects(numRenderPassObjects);
+        }
+        
+        /// @param renderCommandBuffer
+        ///     The render command buffer.
+        ///
+        /// @return The total number of render commands in the given buffer.
+        ///
+        u32 CountRenderCommands(const RenderCommandBuffer* renderCommandBuffer) noexcept
+        {
+            u32 numRenderCommands = 0;
+            for (const auto& renderCommandList : renderCommandBuffer->GetQueue())
+            {
+                numRenderCommands += u32(renderCommandList->GetOrderedList().size());
+            }
+            
+            return numRenderCommands;
+        }
     }
     
     //------------------------------------------------------------------------------
@@ -96,6 +146,10 @@ namespace ChilliSource
         
         taskScheduler->ScheduleTask(TaskType::k_small, [=](const TaskContext& taskContext)
         {
+            RenderPipelineStats stats;
+            PerformanceTimer timer;
+            timer.Start();
+            
             std::vector<RenderFrame> renderFrames(m_currentOffscreenSnapshots.size());
             std::vector<RenderFrameData> renderFramesData(m_currentOffscreenSnapshots.size());
             
@@ -119,9 +173,40 @@ namespace ChilliSource
             auto renderFrame = CompileRenderFrame(m_currentMainSnapshot);
             renderFrames.push_back(std::move(renderFrame));
             
+            timer.Stop();
+            stats.SetStageTime(RenderPipelineStats::Stage::k_compileRenderFrame, timer.GetTimeTakenMicroS());
+            timer.Start();
+            
+            u32 numRenderFrames = u32(renderFrames.size());
+            u32 numRenderObjects = 0;
+            for (const auto& frame : renderFrames)
+            {
+                numRenderObjects += u32(frame.GetRenderObjects().size());
+            }
+            
             auto targetRenderPassGroups = m_renderPassCompiler->CompileTargetRenderPassGroups(taskContext, std::move(renderFrames));
+            
+            timer.Stop();
+            stats.SetStageTime(RenderPipelineStats::Stage::k_compileRenderPasses, timer.GetTimeTakenMicroS());
+            timer.Start();
+            
             auto renderCommandBuffer = RenderCommandCompiler::CompileRenderCommands(taskContext, std::move(frameAllocator), targetRenderPassGroups, std::move(preRenderCommandList), std::move(postRenderCommandList), std::move(renderFramesData));
             
+            timer.Stop();
+            stats.SetStageTime(RenderPipelineStats::Stage::k_compileRenderCommands, timer.GetTimeTakenMicroS());
+            
+            CountRenderPassStats(targetRenderPassGroups, stats);
+            stats.SetNumRenderFrames(numRenderFrames);
+            stats.SetNumRenderObjects(numRenderObjects);
+            stats.SetNumRenderCommands(CountRenderCommands(renderCommandBuffer.get()));
+            stats.SetFrameAllocatorSize(m_frameAllocatorQueue.GetReservedSize(frameAllocator));
+            
+            {
+                std::unique_lock<std::mutex> lock(m_pipelineStatsMutex);
+                stats.SetStageTime(RenderPipelineStats::Stage::k_processRenderCommands, m_pipelineStats.GetStageTime(RenderPipelineStats::Stage::k_processRenderCommands));
+                m_pipelineStats = stats;
+            }
+            
             m_commandRecycleSystem->WaitThenPushCommandBuffer(std::move(renderCommandBuffer));
             
             EndRenderPrep();
@@ -132,14 +217,31 @@ namespace ChilliSource
     void Renderer::ProcessRenderCommandBuffer() noexcept
     {
         auto renderCommandBuffer = m_commandRecycleSystem->WaitThenPopCommandBuffer();
+        
+        PerformanceTimer timer;
+        timer.Start();
+        
         m_renderCommandProcessor->Process(renderCommandBuffer.get());
         
+        timer.Stop();
+        {
+            std::unique_lock<std::mutex> lock(m_pipelineStatsMutex);
+            m_pipelineStats.SetStageTime(RenderPipelineStats::Stage::k_processRenderCommands, timer.GetTimeTakenMicroS());
+        }
+        
         auto allocator = renderCommandBuffer->GetFrameAllocator();
         renderCommandBuffer.reset();
         
         m_frameAllocatorQueue.Push(allocator);
     }
     
+    //------------------------------------------------------------------------------
+    RenderPipelineStats Renderer::GetPipelineStats() const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_pipelineStatsMutex);
+        return m_pipelineStats;
+    }
+    
     //------------------------------------------------------------------------------
     void Renderer::WaitThenStartRenderPrep() noexcept
     {
@@ -179,6 +281,7 @@ namespace ChilliSource
         {
 #ifdef CS_TARGETPLATFORM_ANDROID
             m_renderCommandProcessor->Restore();
+            m_renderPassCompiler->InvalidateCachedTargets();
 #endif
         }
         
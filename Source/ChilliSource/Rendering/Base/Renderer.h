@@ -30,6 +30,7 @@
 #include <ChilliSource/Rendering/Base/IRenderCommandProcessor.h>
 #include <ChilliSource/Rendering/Base/IRenderPassCompiler.h>
 #include <ChilliSource/Rendering/Base/FrameAllocatorQueue.h>
+#include <ChilliSource/Rendering/Base/RenderPipelineStats.h>
 #include <ChilliSource/Rendering/Base/RenderSnapshot.h>
 #include <ChilliSource/Rendering/RenderCommand/RenderCommandBuffer.h>
 
@@ -134,6 +135,16 @@ namespace ChilliSource
         ///
         FrameAllocatorQueue& GetFrameAllocatorQueue() noexcept { return m_frameAllocatorQueue; }
         
+        /// Returns the timing and allocation statistics for the most recently rendered frame. The
+        /// render preparation stages and the render command processing stage run in parallel, so
+        /// the processing time reported is that of the previous render command buffer.
+        ///
+        /// This is thread-safe.
+        ///
+        /// @return The statistics for the most recent frame.
+        ///
+        RenderPipelineStats GetPipelineStats() const noexcept;
+        
     private:
         friend class Application;
         friend class LifecycleManager;
@@ -189,6 +200,9 @@ namespace ChilliSource
         std::vector<RenderSnapshot> m_currentOffscreenSnapshots;
         
         RenderCommandBufferManager* m_commandRecycleSystem = nullptr;
+        
+        mutable std::mutex m_pipelineStatsMutex;
+        RenderPipelineStats m_pipelineStats;
     };
 }
 
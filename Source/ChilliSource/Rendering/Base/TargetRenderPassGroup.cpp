@@ -29,7 +29,7 @@ namespace ChilliSource
 {
     //------------------------------------------------------------------------------
     TargetRenderPassGroup::TargetRenderPassGroup(const Integer2& resolution, const Colour& clearColour, std::vector<CameraRenderPassGroup> cameraRenderPassGroups) noexcept
-        : m_resolution(resolution), m_renderCameraGroups(std::move(cameraRenderPassGroups)), m_clearColour(clearColour)
+        : m_resolution(resolution), m_clearColour(clearColour), m_renderCameraGroups(std::move(cameraRenderPassGroups))
     {
     }
     
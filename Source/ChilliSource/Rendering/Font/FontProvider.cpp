@@ -126,6 +126,7 @@ namespace ChilliSource
             if (in_chunk != nullptr && in_chunk->GetSize() % k_glyphInfoSize == 0)
             {
                 const u32 numGlyphs = in_chunk->GetSize() / k_glyphInfoSize;
+                out_desc.m_frames.reserve(numGlyphs);
                 for (u32 i = 0; i < numGlyphs; ++i)
                 {
                     Font::Frame frame;
@@ -38,6 +38,7 @@ namespace ChilliSource
     //------------------------------------------------------------
     /// Base
     //------------------------------------------------------------
+    CS_FORWARDDECLARE_CLASS(CanvasDrawList);
     CS_FORWARDDECLARE_CLASS(CanvasMaterialPool);
     CS_FORWARDDECLARE_CLASS(CanvasRenderer);
     CS_FORWARDDECLARE_CLASS(IRenderCommandProcessor);
@@ -52,6 +53,7 @@ namespace ChilliSource
     CS_FORWARDDECLARE_CLASS(RenderObject);
     CS_FORWARDDECLARE_CLASS(RenderPass);
     CS_FORWARDDECLARE_CLASS(RenderPassObject);
+    CS_FORWARDDECLARE_CLASS(RenderPipelineStats);
     CS_FORWARDDECLARE_CLASS(RenderSnapshot);
     CS_FORWARDDECLARE_CLASS(TargetRenderPassGroup);
     CS_FORWARDDECLARE_CLASS(CameraRenderPassGroup);
@@ -112,6 +114,7 @@ namespace ChilliSource
     CS_FORWARDDECLARE_CLASS(MeshDesc);
     CS_FORWARDDECLARE_CLASS(Model);
     CS_FORWARDDECLARE_CLASS(ModelDesc);
+    CS_FORWARDDECLARE_CLASS(ModelResourceOptions);
     CS_FORWARDDECLARE_CLASS(PrimitiveModelFactory);
     CS_FORWARDDECLARE_CLASS(RenderDynamicMesh);
     CS_FORWARDDECLARE_CLASS(RenderMesh);
@@ -124,6 +127,7 @@ namespace ChilliSource
     CS_FORWARDDECLARE_CLASS(SkinnedAnimation);
     CS_FORWARDDECLARE_CLASS(SkinnedAnimationGroup);
     CS_FORWARDDECLARE_CLASS(SmallMeshBatcher);
+    CS_FORWARDDECLARE_CLASS(StaticModelBatcher);
     CS_FORWARDDECLARE_CLASS(StaticModelComponent);
     CS_FORWARDDECLARE_CLASS(VertexFormat);
     enum class IndexFormat;
@@ -204,6 +208,7 @@ namespace ChilliSource
     CS_FORWARDDECLARE_CLASS(RenderCommandBufferManager);
     CS_FORWARDDECLARE_CLASS(RenderCommandList);
     CS_FORWARDDECLARE_CLASS(RenderInstanceRenderCommand);
+    CS_FORWARDDECLARE_CLASS(RenderInstancesRenderCommand);
     CS_FORWARDDECLARE_CLASS(UnloadMaterialGroupRenderCommand);
     CS_FORWARDDECLARE_CLASS(UnloadMeshRenderCommand);
     CS_FORWARDDECLARE_CLASS(UnloadShaderRenderCommand);
@@ -241,6 +246,7 @@ namespace ChilliSource
     CS_FORWARDDECLARE_CLASS(TextureAtlasProvider);
     CS_FORWARDDECLARE_CLASS(TextureDesc);
     CS_FORWARDDECLARE_CLASS(TextureProvider);
+    CS_FORWARDDECLARE_CLASS(TextureResourceOptions);
     CS_FORWARDDECLARE_CLASS(UVs);
     enum class TextureFilterMode;
     enum class TextureType;
@@ -25,7 +25,7 @@
 #include <ChilliSource/Rendering/Lighting/DirectionalLightComponent.h>
 
 #include <ChilliSource/Core/Base/Application.h>
-#include <ChilliSource/Core/Delegate/MakeDelegate.h>
+#include <ChilliSource/Core/Delegate/MakeInlineDelegate.h>
 #include <ChilliSource/Core/Image/ImageCompression.h>
 #include <ChilliSource/Core/Image/ImageFormat.h>
 #include <ChilliSource/Core/Resource/ResourcePool.h>
@@ -155,7 +155,7 @@ namespace ChilliSource
         
         m_direction = Vector3::Rotate(Vector3::k_unitPositiveZ, transform.GetWorldOrientation());
         
-        m_transformChangedConnection = transform.GetTransformChangedEvent().OpenConnection(MakeDelegate(this, &DirectionalLightComponent::OnEntityTransformChanged));
+        m_transformChangedConnection = transform.GetQueuedTransformChangedEvent().OpenConnection(MakeInlineDelegate(this, &DirectionalLightComponent::OnEntityTransformChanged));
     }
     
     //------------------------------------------------------------------------------
@@ -174,7 +174,7 @@ namespace ChilliSource
             const auto& transform = GetEntity()->GetTransform();
             auto worldMatrix = transform.GetWorldTransform();
             auto orientation = transform.GetWorldOrientation();
-            renderSnapshot.AddDirectionalRenderLight(DirectionalRenderLight(GetFinalColour(), m_direction, worldMatrix, m_lightProjection, orientation, m_shadowTolerance, m_shadowMapTarget->GetRenderTargetGroup()));
+            renderSnapshot.AddDirectionalRenderLight(DirectionalRenderLight(GetFinalColour(), m_direction, worldMatrix, m_lightProjection, orientation, m_shadowTolerance, m_shadowMapTarget->GetRenderTargetGroup(), m_isShadowMapCachingEnabled));
         }
         else
         {
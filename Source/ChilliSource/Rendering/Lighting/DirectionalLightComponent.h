@@ -123,6 +123,18 @@ namespace ChilliSource
         ///
         void SetShadowVolume(f32 width, f32 height, f32 near, f32 far) noexcept;
         
+        /// Sets whether or not the shadow map should be cached. When enabled the shadow map is only
+        /// re-rendered when the light or any of the shadow casters within its shadow volume change,
+        /// which is much cheaper for scenes in which most shadow casters are static. As the cached
+        /// shadow map doesn't depend on the camera, casters are only culled against the shadow
+        /// volume rather than also against the area visible to the camera. This is disabled by
+        /// default.
+        ///
+        /// @param enabled
+        ///     Whether or not shadow map caching is enabled.
+        ///
+        void SetShadowMapCachingEnabled(bool enabled) noexcept { m_isShadowMapCachingEnabled = enabled; }
+        
         /// @return The colour of the directional light.
         ///
         const Colour& GetColour() const noexcept { return m_colour; }
@@ -142,6 +154,11 @@ namespace ChilliSource
         ///
         f32 GetShadowTolerance() const noexcept { return m_shadowTolerance; }
         
+        /// @return Whether or not the shadow map is only re-rendered when the light or any of the
+        ///     shadow casters within its shadow volume change.
+        ///
+        bool IsShadowMapCachingEnabled() const noexcept { return m_isShadowMapCachingEnabled; }
+        
         /// Cleans up shadow textures if required.
         ///
         ~DirectionalLightComponent() noexcept;
@@ -160,7 +177,9 @@ namespace ChilliSource
         ///
         void OnAddedToScene() noexcept override;
         
-        /// Triggered when the entity transform changes, updating the light view matrix.
+        /// Triggered once per frame, after the application has updated, if the entity transform
+        /// changed during the frame, updating the cached light direction. This listens to the queued
+        /// transform changed event, as the value is only needed when the render snapshot is taken.
         ///
         void OnEntityTransformChanged() noexcept;
         
@@ -184,6 +203,7 @@ namespace ChilliSource
         Colour m_colour;
         f32 m_intensity;
         f32 m_shadowTolerance = 0.0f;
+        bool m_isShadowMapCachingEnabled = false;
         
         Vector3 m_direction;
         Matrix4 m_lightProjection;
@@ -72,9 +72,12 @@ namespace ChilliSource
         ///     The tolerence used to judge if an object is in shadow.
         /// @param shadowMapTarget
         ///     The render target group which should be used for the shadow map.
+        /// @param isShadowMapCachingEnabled
+        ///     Whether or not the shadow map should only be re-rendered when the light or the shadow
+        ///     casters within its shadow volume change.
         ///
         DirectionalRenderLight(const Colour& colour, const Vector3& direction, const Matrix4& lightWorldMatrix, const Matrix4& lightProjectionMatrix, const Quaternion& lightOrientation,
-                               f32 shadowTolerance, const RenderTargetGroup* shadowMapTarget) noexcept;
+                               f32 shadowTolerance, const RenderTargetGroup* shadowMapTarget, bool isShadowMapCachingEnabled) noexcept;
         
         /// @return The colour of the light.
         ///
@@ -105,6 +108,11 @@ namespace ChilliSource
         ///
         const RenderTargetGroup* GetShadowMapTarget() const noexcept { return m_shadowMapTarget; }
         
+        /// @return Whether or not the shadow map should only be re-rendered when the light or the
+        ///     shadow casters within its shadow volume change.
+        ///
+        bool IsShadowMapCachingEnabled() const noexcept { return m_isShadowMapCachingEnabled; }
+        
     private:
         Colour m_colour;
         Vector3 m_direction;
@@ -113,6 +121,7 @@ namespace ChilliSource
         Quaternion m_lightOrientation;
         f32 m_shadowTolerance = 0.0f;
         const RenderTargetGroup* m_shadowMapTarget = nullptr;
+        bool m_isShadowMapCachingEnabled = false;
     };
 }
 
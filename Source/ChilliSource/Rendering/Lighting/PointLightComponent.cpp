@@ -28,7 +28,7 @@
 
 #include <ChilliSource/Rendering/Lighting/PointLightComponent.h>
 
-#include <ChilliSource/Core/Delegate/MakeDelegate.h>
+#include <ChilliSource/Core/Delegate/MakeInlineDelegate.h>
 #include <ChilliSource/Core/Entity/Entity.h>
 #include <ChilliSource/Rendering/Base/RenderSnapshot.h>
 #include <ChilliSource/Rendering/Lighting/PointRenderLight.h>
@@ -95,7 +95,7 @@ namespace ChilliSource
         
         m_lightPosition = transform.GetWorldPosition();
         
-        m_transformChangedConnection = transform.GetTransformChangedEvent().OpenConnection(MakeDelegate(this, &PointLightComponent::OnEntityTransformChanged));
+        m_transformChangedConnection = transform.GetQueuedTransformChangedEvent().OpenConnection(MakeInlineDelegate(this, &PointLightComponent::OnEntityTransformChanged));
     }
     
     //------------------------------------------------------------------------------
@@ -133,7 +133,9 @@ namespace ChilliSource
         ///
         void OnAddedToScene() noexcept override;
         
-        /// Triggered when the entity transform changes, updating the light view matrix.
+        /// Triggered once per frame, after the application has updated, if the entity transform
+        /// changed during the frame, updating the cached light position. This listens to the queued
+        /// transform changed event, as the value is only needed when the render snapshot is taken.
         ///
         void OnEntityTransformChanged() noexcept;
         
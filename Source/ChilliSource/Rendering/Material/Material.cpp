@@ -40,8 +40,56 @@
 #include <ChilliSource/Rendering/Texture/Texture.h>
 #include <ChilliSource/Rendering/Texture/Cubemap.h>
 
+#include <algorithm>
+
 namespace ChilliSource
 {
+    namespace
+    {
+        //----------------------------------------------------------
+        /// Appends the raw bytes of the given value to the content
+        /// key. This must only be used with types that have no
+        /// padding.
+        ///
+        /// @param in_value - The value to append.
+        /// @param out_key - [Out] The key to append to.
+        //----------------------------------------------------------
+        template <typename TValueType> void AppendToKey(const TValueType& in_value, std::string& out_key) noexcept
+        {
+            out_key.append(reinterpret_cast<const char*>(&in_value), sizeof(TValueType));
+        }
+        //----------------------------------------------------------
+        /// Appends the given shader variables to the content key in
+        /// name order, so that materials with the same variables
+        /// produce the same key regardless of map ordering.
+        ///
+        /// @param in_variables - The shader variables.
+        /// @param out_key - [Out] The key to append to.
+        //----------------------------------------------------------
+        template <typename TValueType> void AppendVariablesToKey(const std::unordered_map<std::string, TValueType>& in_variables, std::string& out_key) noexcept
+        {
+            std::vector<const std::pair<const std::string, TValueType>*> sortedVariables;
+            sortedVariables.reserve(in_variables.size());
+            for (const auto& variable : in_variables)
+            {
+                sortedVariables.push_back(&variable);
+            }
+            
+            std::sort(sortedVariables.begin(), sortedVariables.end(), [](const std::pair<const std::string, TValueType>* in_a, const std::pair<const std::string, TValueType>* in_b)
+            {
+                return in_a->first < in_b->first;
+            });
+            
+            AppendToKey(u32(sortedVariables.size()), out_key);
+            for (const auto& variable : sortedVariables)
+            {
+                AppendToKey(u32(variable->first.size()), out_key);
+                out_key.append(variable->first);
+                AppendToKey(variable->second, out_key);
+            }
+        }
+    }
+    
     CS_DEFINE_NAMEDTYPE(Material);
 
     //----------------------------------------------------------
@@ -53,10 +101,11 @@ namespace ChilliSource
     //------------------------------------------------
     //------------------------------------------------
     Material::Material() noexcept
-    :   m_srcBlendMode(BlendMode::k_one), m_dstBlendMode(BlendMode::k_oneMinusSourceAlpha),
-        m_depthTestFunc(TestFunc::k_lessEqual),
+    :   m_depthTestFunc(TestFunc::k_lessEqual),
+        m_srcBlendMode(BlendMode::k_one), m_dstBlendMode(BlendMode::k_oneMinusSourceAlpha),
         m_cullFace(CullFace::k_back),
-        m_stencilPassOp(StencilOp::k_keep), m_stencilFailOp(StencilOp::k_keep), m_stencilDepthFailOp(StencilOp::k_keep)
+        m_stencilFailOp(StencilOp::k_keep), m_stencilDepthFailOp(StencilOp::k_keep), m_stencilPassOp(StencilOp::k_keep),
+        m_stencilTestFunc(TestFunc::k_always)
     {
         m_renderMaterialGroupManager = Application::Get()->GetSystem<RenderMaterialGroupManager>();
         CS_ASSERT(m_renderMaterialGroupManager, "RenderMaterialGroupManager is required.");
@@ -168,7 +217,10 @@ namespace ChilliSource
     //----------------------------------------------------------
     void Material::SetTransparencyEnabled(bool in_enable) noexcept
     {
-        m_isCacheValid = m_isAlphaBlendingEnabled != in_enable;
+        if (m_isAlphaBlendingEnabled != in_enable || m_isDepthWriteEnabled == in_enable)
+        {
+            m_isCacheValid = false;
+        }
         
         m_isAlphaBlendingEnabled = in_enable;
         m_isDepthWriteEnabled = !in_enable;
@@ -183,7 +235,10 @@ namespace ChilliSource
     //----------------------------------------------------------
     void Material::SetColourWriteEnabled(bool in_enable) noexcept
     {
-        m_isCacheValid = m_isColWriteEnabled != in_enable;
+        if (m_isColWriteEnabled != in_enable)
+        {
+            m_isCacheValid = false;
+        }
         
         m_isColWriteEnabled = in_enable;
     }
@@ -199,7 +254,10 @@ namespace ChilliSource
     {
         CS_ASSERT(m_isAlphaBlendingEnabled == false, "Cannot enable depth write on transparent object");
         
-        m_isCacheValid = m_isDepthWriteEnabled != in_enable;
+        if (m_isDepthWriteEnabled != in_enable)
+        {
+            m_isCacheValid = false;
+        }
         
         m_isDepthWriteEnabled = in_enable;
     }
@@ -213,7 +271,10 @@ namespace ChilliSource
     //----------------------------------------------------------
     void Material::SetDepthTestEnabled(bool in_enable) noexcept
     {
-        m_isCacheValid = m_isDepthTestEnabled != in_enable;
+        if (m_isDepthTestEnabled != in_enable)
+        {
+            m_isCacheValid = false;
+        }
         
         m_isDepthTestEnabled = in_enable;
     }
@@ -227,7 +288,10 @@ namespace ChilliSource
     //----------------------------------------------------------
     void Material::SetFaceCullingEnabled(bool in_enable) noexcept
     {
-        m_isCacheValid = m_isFaceCullingEnabled != in_enable;
+        if (m_isFaceCullingEnabled != in_enable)
+        {
+            m_isCacheValid = false;
+        }
         
         m_isFaceCullingEnabled = in_enable;
     }
@@ -259,6 +323,8 @@ namespace ChilliSource
         m_stencilFailOp = stencilFail;
         m_stencilDepthFailOp = depthFail;
         m_stencilPassOp = pass;
+        
+        m_isCacheValid = false;
     }
     //----------------------------------------------------------
     //----------------------------------------------------------
@@ -267,12 +333,16 @@ namespace ChilliSource
         m_stencilTestFunc = testFunc;
         m_stencilTestFuncRef = ref;
         m_stencilTestFuncMask = mask;
+        
+        m_isCacheValid = false;
     }
     //----------------------------------------------------------
     //----------------------------------------------------------
     void Material::SetCullFace(CullFace in_cullFace) noexcept
     {
         m_cullFace = in_cullFace;
+        
+        m_isCacheValid = false;
     }
     //----------------------------------------------------------
     //----------------------------------------------------------
@@ -432,6 +502,13 @@ namespace ChilliSource
             m_isCacheValid = true;
             m_isVariableCacheValid = true;
             
+            auto contentKey = BuildRenderMaterialGroupKey();
+            m_renderMaterialGroup = m_renderMaterialGroupManager->AcquireSharedRenderMaterialGroup(contentKey);
+            if (m_renderMaterialGroup)
+            {
+                return m_renderMaterialGroup;
+            }
+            
             switch (m_shadingType)
             {
                 case MaterialShadingType::k_unlit:
@@ -447,12 +524,79 @@ namespace ChilliSource
                     CS_LOG_FATAL("Invalid shading type.");
                     
             }
+            
+            m_renderMaterialGroupManager->AddSharedRenderMaterialGroup(contentKey, m_renderMaterialGroup);
         }
         
         return m_renderMaterialGroup;
     }
     //----------------------------------------------------------
     //----------------------------------------------------------
+    std::string Material::BuildRenderMaterialGroupKey() const noexcept
+    {
+        std::string key;
+        key.reserve(256);
+        
+        AppendToKey(m_shadingType, key);
+        
+        AppendToKey(u32(m_cachedRenderTextures.size()), key);
+        for (const auto& renderTexture : m_cachedRenderTextures)
+        {
+            AppendToKey(renderTexture, key);
+        }
+        AppendToKey(u32(m_cubemaps.size()), key);
+        
+        AppendToKey(m_isAlphaBlendingEnabled, key);
+        AppendToKey(m_isColWriteEnabled, key);
+        AppendToKey(m_isDepthWriteEnabled, key);
+        AppendToKey(m_isDepthTestEnabled, key);
+        AppendToKey(m_isFaceCullingEnabled, key);
+        AppendToKey(m_isStencilTestEnabled, key);
+        AppendToKey(m_depthTestFunc, key);
+        AppendToKey(m_srcBlendMode, key);
+        AppendToKey(m_dstBlendMode, key);
+        AppendToKey(m_stencilFailOp, key);
+        AppendToKey(m_stencilDepthFailOp, key);
+        AppendToKey(m_stencilPassOp, key);
+        AppendToKey(m_stencilTestFunc, key);
+        AppendToKey(m_stencilTestFuncRef, key);
+        AppendToKey(m_stencilTestFuncMask, key);
+        AppendToKey(m_cullFace, key);
+        
+        AppendToKey(m_emissive, key);
+        AppendToKey(m_ambient, key);
+        AppendToKey(m_diffuse, key);
+        AppendToKey(m_specular, key);
+        
+        if (m_shadingType == MaterialShadingType::k_custom)
+        {
+            AppendToKey(m_customShaderFallbackType, key);
+            
+            AppendToKey(m_customShaderVertexFormat.GetNumElements(), key);
+            for (u32 i = 0; i < m_customShaderVertexFormat.GetNumElements(); ++i)
+            {
+                AppendToKey(m_customShaderVertexFormat.GetElement(i), key);
+            }
+            
+            AppendToKey(u32(m_customShaders.size()), key);
+            for (const auto& shader : m_customShaders)
+            {
+                AppendToKey(shader.first->GetRenderShader(), key);
+                AppendToKey(shader.second, key);
+            }
+            
+            AppendVariablesToKey(m_floatVars, key);
+            AppendVariablesToKey(m_vec2Vars, key);
+            AppendVariablesToKey(m_vec3Vars, key);
+            AppendVariablesToKey(m_vec4Vars, key);
+            AppendVariablesToKey(m_mat4Vars, key);
+            AppendVariablesToKey(m_colourVars, key);
+        }
+        
+        return key;
+    }
+    //----------------------------------------------------------
+    //----------------------------------------------------------
     void Material::CreateUnlitRenderMaterialGroup() const noexcept
     {
         CS_ASSERT(!m_renderMaterialGroup, "Render material group must be null.");
@@ -243,11 +243,11 @@ namespace ChilliSource
         /// @param in_enable
         ///     Whether to turn stencil testing on or off
         ///
-        void SetStencilTestEnabled(bool in_enable) noexcept { m_isStencilTestEnabled = in_enable; }
+        void SetStencilTestEnabled(bool in_enable) noexcept { m_isCacheValid = m_isCacheValid && m_isStencilTestEnabled == in_enable; m_isStencilTestEnabled = in_enable; }
         
         /// @param Function that handles comparing depth values for pass/fail testing
         ///
-        void SetDepthTestFunc(TestFunc testFunc) noexcept { m_depthTestFunc = testFunc; }
+        void SetDepthTestFunc(TestFunc testFunc) noexcept { m_isCacheValid = m_isCacheValid && m_depthTestFunc == testFunc; m_depthTestFunc = testFunc; }
         
         /// @return Function that handles comparing depth values for pass/fail testing
         ///
@@ -511,6 +511,17 @@ namespace ChilliSource
         //----------------------------------------------------------
         Material() noexcept;
         //----------------------------------------------------------
+        /// Builds a key which uniquely describes the content of the
+        /// render material group this material requires: the
+        /// shading type, shaders, render textures, render state,
+        /// colours and shader variables. Materials with equal keys
+        /// share a single render material group. The cached render
+        /// textures must be up to date before this is called.
+        ///
+        /// @return The content key.
+        //----------------------------------------------------------
+        std::string BuildRenderMaterialGroupKey() const noexcept;
+        //----------------------------------------------------------
         /// Generates an unlit render material group using the
         /// current material setting. If any of the settings are
         /// not allowed in an unlit render material group then this
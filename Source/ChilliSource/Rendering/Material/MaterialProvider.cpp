@@ -30,6 +30,9 @@
 
 #include <ChilliSource/Core/Base/Application.h>
 #include <ChilliSource/Core/Base/Colour.h>
+#include <ChilliSource/Core/File/CSBinaryChunk.h>
+#include <ChilliSource/Core/File/CSBinaryInputStream.h>
+#include <ChilliSource/Core/String/ToString.h>
 #include <ChilliSource/Core/String/StringParser.h>
 #include <ChilliSource/Core/Threading/TaskScheduler.h>
 #include <ChilliSource/Core/Resource/ResourcePool.h>
@@ -45,11 +48,56 @@
 #include <ChilliSource/Rendering/Texture/TextureResourceOptions.h>
 #include <ChilliSource/Rendering/Texture/TextureType.h>
 
+#include <algorithm>
+
 namespace ChilliSource
 {
     namespace
     {
         const std::string k_materialExtension("csmaterial");
+        const std::string k_binaryMaterialExtension("csmaterialbin");
+        const u32 k_binaryFileFormatId = 2;
+        const u32 k_binaryFileFormatVersion = 1;
+        
+        const u32 k_matlChunkSize = 4 + 8 + 4 * 4 * 4;
+        
+        const u32 k_matlDepthWriteFlag = 1 << 0;
+        const u32 k_matlDepthTestFlag = 1 << 1;
+        const u32 k_matlTransparencyFlag = 1 << 2;
+        const u32 k_matlCullingFlag = 1 << 3;
+        const u32 k_matlBlendFuncFlag = 1 << 4;
+        const u32 k_matlCullFaceFlag = 1 << 5;
+        const u32 k_matlDepthTestFuncFlag = 1 << 6;
+        const u32 k_matlLightingFlag = 1 << 7;
+        const u32 k_matlEmissiveFlag = 1 << 8;
+        const u32 k_matlAmbientFlag = 1 << 9;
+        const u32 k_matlDiffuseFlag = 1 << 10;
+        
+        const u8 k_shaderVarFloat = 0;
+        const u8 k_shaderVarVec2 = 1;
+        const u8 k_shaderVarVec3 = 2;
+        const u8 k_shaderVarVec4 = 3;
+        const u8 k_shaderVarColour = 4;
+        const u8 k_shaderVarMatrix = 5;
+        
+        //----------------------------------------------------------------------------
+        /// Binary materials store enum values as indices into these tables. The
+        /// order is part of the file format and must match compile_material.py,
+        /// so it must not change without bumping the format version.
+        //----------------------------------------------------------------------------
+        const BlendMode k_binaryBlendModes[] = { BlendMode::k_zero, BlendMode::k_one, BlendMode::k_sourceCol, BlendMode::k_oneMinusSourceCol, BlendMode::k_sourceAlpha,
+            BlendMode::k_oneMinusSourceAlpha, BlendMode::k_destAlpha, BlendMode::k_oneMinusDestAlpha };
+        const TestFunc k_binaryDepthTestFuncs[] = { TestFunc::k_never, TestFunc::k_less, TestFunc::k_lessEqual, TestFunc::k_greater, TestFunc::k_greaterEqual,
+            TestFunc::k_equal, TestFunc::k_notEqual, TestFunc::k_always };
+        const CullFace k_binaryCullFaces[] = { CullFace::k_front, CullFace::k_back };
+        const TextureWrapMode k_binaryWrapModes[] = { TextureWrapMode::k_clamp, TextureWrapMode::k_repeat };
+        const TextureFilterMode k_binaryFilterModes[] = { TextureFilterMode::k_nearest, TextureFilterMode::k_bilinear };
+        const MaterialShadingType k_binaryShadingTypes[] = { MaterialShadingType::k_unlit, MaterialShadingType::k_blinn, MaterialShadingType::k_custom };
+        const RenderPasses k_binaryRenderPasses[] = { RenderPasses::k_shadowMap, RenderPasses::k_base, RenderPasses::k_directionalLight, RenderPasses::k_directionalLightShadows,
+            RenderPasses::k_pointLight, RenderPasses::k_transparent };
+        const TextureType k_binaryTextureTypes[] = { TextureType::k_texture, TextureType::k_cubemap };
+        const StorageLocation k_binaryStorageLocations[] = { StorageLocation::k_package, StorageLocation::k_saveData, StorageLocation::k_cache, StorageLocation::k_DLC,
+            StorageLocation::k_root, StorageLocation::k_chilliSource, StorageLocation::k_none };
         
         //----------------------------------------------------------------------------
         /// The resource types supported by materials
@@ -643,6 +691,495 @@ namespace ChilliSource
             }
         }
         //----------------------------------------------------------------------------
+        /// Reads a value from a binary material chunk, checking that the chunk has
+        /// enough data remaining first.
+        ///
+        /// @param in_chunk - The chunk to read from.
+        /// @param out_value - [Out] The value. This is only set if successful.
+        ///
+        /// @return Whether or not the value could be read.
+        //----------------------------------------------------------------------------
+        template <typename TType> bool ReadBinaryValue(CSBinaryChunk* in_chunk, TType& out_value) noexcept
+        {
+            if (in_chunk->GetSize() - in_chunk->GetReadPosition() < sizeof(TType))
+            {
+                CS_LOG_ERROR("Unexpected end of chunk in binary material.");
+                return false;
+            }
+            
+            out_value = in_chunk->Read<TType>();
+            return true;
+        }
+        //----------------------------------------------------------------------------
+        /// Reads an enum value which has been stored in a binary material as an
+        /// index into the given table.
+        ///
+        /// @param in_chunk - The chunk to read from.
+        /// @param in_table - The table the index refers to.
+        /// @param in_typeName - The name of the enum type, used for error messages.
+        /// @param out_value - [Out] The enum value. This is only set if successful.
+        ///
+        /// @return Whether or not a valid value could be read.
+        //----------------------------------------------------------------------------
+        template <typename TEnum, u32 TSize> bool ReadBinaryEnum(CSBinaryChunk* in_chunk, const TEnum (&in_table)[TSize], const std::string& in_typeName, TEnum& out_value) noexcept
+        {
+            u8 index = 0;
+            if (ReadBinaryValue(in_chunk, index) == false)
+            {
+                return false;
+            }
+            
+            if (index >= TSize)
+            {
+                CS_LOG_ERROR("Invalid " + in_typeName + " in binary material: " + ToString(u32(index)));
+                return false;
+            }
+            
+            out_value = in_table[index];
+            return true;
+        }
+        //----------------------------------------------------------------------------
+        /// Reads a length prefixed UTF-8 string from a binary material chunk.
+        ///
+        /// @param in_chunk - The chunk to read from.
+        /// @param out_string - [Out] The string. This is only set if successful.
+        ///
+        /// @return Whether or not the string could be read.
+        //----------------------------------------------------------------------------
+        bool ReadBinaryString(CSBinaryChunk* in_chunk, std::string& out_string) noexcept
+        {
+            u32 length = 0;
+            if (ReadBinaryValue(in_chunk, length) == false)
+            {
+                return false;
+            }
+            
+            if (in_chunk->GetSize() - in_chunk->GetReadPosition() < length)
+            {
+                CS_LOG_ERROR("Invalid string length in binary material: " + ToString(length));
+                return false;
+            }
+            
+            out_string.assign(reinterpret_cast<const s8*>(in_chunk->Read(length)), length);
+            return true;
+        }
+        //----------------------------------------------------------------------------
+        /// Reads a vertex format from a binary material chunk. Vertex formats are
+        /// not an enum so can't be stored in a lookup table in the same way as the
+        /// other types.
+        ///
+        /// @param in_chunk - The chunk to read from.
+        /// @param out_vertexFormat - [Out] The vertex format. This is only set if
+        /// successful.
+        ///
+        /// @return Whether or not a valid vertex format could be read.
+        //----------------------------------------------------------------------------
+        bool ReadBinaryVertexFormat(CSBinaryChunk* in_chunk, VertexFormat& out_vertexFormat) noexcept
+        {
+            u8 index = 0;
+            if (ReadBinaryValue(in_chunk, index) == false)
+            {
+                return false;
+            }
+            
+            switch (index)
+            {
+                case 0:
+                    out_vertexFormat = VertexFormat::k_sprite;
+                    return true;
+                case 1:
+                    out_vertexFormat = VertexFormat::k_staticMesh;
+                    return true;
+                case 2:
+                    out_vertexFormat = VertexFormat::k_animatedMesh;
+                    return true;
+                default:
+                    CS_LOG_ERROR("Invalid vertex format in binary material: " + ToString(u32(index)));
+                    return false;
+            }
+        }
+        //----------------------------------------------------------------------------
+        /// Reads a series of floats from a binary material chunk.
+        ///
+        /// @param in_chunk - The chunk to read from.
+        /// @param in_numValues - The number of values to read.
+        /// @param out_values - [Out] The values. Must have room for the requested
+        /// number of values.
+        ///
+        /// @return Whether or not the values could be read.
+        //----------------------------------------------------------------------------
+        bool ReadBinaryFloats(CSBinaryChunk* in_chunk, u32 in_numValues, f32* out_values) noexcept
+        {
+            for (u32 i = 0; i < in_numValues; ++i)
+            {
+                if (ReadBinaryValue(in_chunk, out_values[i]) == false)
+                {
+                    return false;
+                }
+            }
+            
+            return true;
+        }
+        //----------------------------------------------------------------------------
+        /// Reads a colour from a binary material chunk.
+        ///
+        /// @param in_chunk - The chunk to read from.
+        /// @param out_colour - [Out] The colour. This is only set if successful.
+        ///
+        /// @return Whether or not the colour could be read.
+        //----------------------------------------------------------------------------
+        bool ReadBinaryColour(CSBinaryChunk* in_chunk, Colour& out_colour) noexcept
+        {
+            f32 values[4];
+            if (ReadBinaryFloats(in_chunk, 4, values) == false)
+            {
+                return false;
+            }
+            
+            out_colour = Colour(values[0], values[1], values[2], values[3]);
+            return true;
+        }
+        //----------------------------------------------------------------------------
+        /// Reads the MATL chunk of a binary material. This contains everything
+        /// described by the RenderStates, BlendFunc, Culling, DepthTestFunc and
+        /// Lighting elements of the XML format, resolved to their final values. Each
+        /// setter is only called if the equivalent element was present in the
+        /// source file so the material defaults are preserved.
+        ///
+        /// @param in_chunk - The MATL chunk.
+        /// @param out_material - [Out] The material to populate.
+        ///
+        /// @return Whether or not the read was successful.
+        //----------------------------------------------------------------------------
+        bool ReadMATLChunk(CSBinaryChunk* in_chunk, Material* out_material) noexcept
+        {
+            if (in_chunk->GetSize() != k_matlChunkSize)
+            {
+                return false;
+            }
+            
+            //the chunk size is fixed, so only the enum values need validating.
+            u32 flags = in_chunk->Read<u32>();
+            
+            MaterialShadingType shadingType;
+            if (ReadBinaryEnum(in_chunk, k_binaryShadingTypes, "shading type", shadingType) == false)
+            {
+                return false;
+            }
+            out_material->SetShadingType(shadingType);
+            
+            u8 renderStates = in_chunk->Read<u8>();
+            if ((flags & k_matlDepthWriteFlag) != 0)
+            {
+                out_material->SetDepthWriteEnabled((renderStates & k_matlDepthWriteFlag) != 0);
+            }
+            if ((flags & k_matlDepthTestFlag) != 0)
+            {
+                out_material->SetDepthTestEnabled((renderStates & k_matlDepthTestFlag) != 0);
+            }
+            if ((flags & k_matlTransparencyFlag) != 0)
+            {
+                out_material->SetTransparencyEnabled((renderStates & k_matlTransparencyFlag) != 0);
+            }
+            if ((flags & k_matlCullingFlag) != 0)
+            {
+                out_material->SetFaceCullingEnabled((renderStates & k_matlCullingFlag) != 0);
+            }
+            
+            BlendMode srcBlendMode, dstBlendMode;
+            CullFace cullFace;
+            TestFunc depthTestFunc;
+            if (ReadBinaryEnum(in_chunk, k_binaryBlendModes, "blend mode", srcBlendMode) == false || ReadBinaryEnum(in_chunk, k_binaryBlendModes, "blend mode", dstBlendMode) == false ||
+                ReadBinaryEnum(in_chunk, k_binaryCullFaces, "cull face", cullFace) == false || ReadBinaryEnum(in_chunk, k_binaryDepthTestFuncs, "depth test func", depthTestFunc) == false)
+            {
+                return false;
+            }
+            
+            if ((flags & k_matlBlendFuncFlag) != 0)
+            {
+                out_material->SetBlendModes(srcBlendMode, dstBlendMode);
+            }
+            if ((flags & k_matlCullFaceFlag) != 0)
+            {
+                out_material->SetCullFace(cullFace);
+            }
+            if ((flags & k_matlDepthTestFuncFlag) != 0)
+            {
+                out_material->SetDepthTestFunc(depthTestFunc);
+            }
+            
+            //padding
+            in_chunk->Read<u16>();
+            
+            Colour emissive, ambient, diffuse, specular;
+            ReadBinaryColour(in_chunk, emissive);
+            ReadBinaryColour(in_chunk, ambient);
+            ReadBinaryColour(in_chunk, diffuse);
+            ReadBinaryColour(in_chunk, specular);
+            if ((flags & k_matlLightingFlag) != 0)
+            {
+                if ((flags & k_matlEmissiveFlag) != 0)
+                {
+                    out_material->SetEmissive(emissive);
+                }
+                if ((flags & k_matlAmbientFlag) != 0)
+                {
+                    out_material->SetAmbient(ambient);
+                }
+                if ((flags & k_matlDiffuseFlag) != 0)
+                {
+                    out_material->SetDiffuse(diffuse);
+                }
+                out_material->SetSpecular(specular);
+            }
+            
+            return true;
+        }
+        //----------------------------------------------------------------------------
+        /// Reads a single shader variable from the SHDR chunk of a binary material
+        /// and applies it to the material.
+        ///
+        /// @param in_chunk - The SHDR chunk.
+        /// @param out_material - [Out] The material to populate.
+        ///
+        /// @return Whether or not the read was successful.
+        //----------------------------------------------------------------------------
+        bool ReadBinaryShaderVar(CSBinaryChunk* in_chunk, Material* out_material) noexcept
+        {
+            u8 type = 0;
+            std::string name;
+            if (ReadBinaryValue(in_chunk, type) == false || ReadBinaryString(in_chunk, name) == false)
+            {
+                return false;
+            }
+            
+            f32 values[16];
+            switch (type)
+            {
+                case k_shaderVarFloat:
+                {
+                    if (ReadBinaryFloats(in_chunk, 1, values) == false)
+                    {
+                        return false;
+                    }
+                    out_material->SetShaderVar(name, values[0]);
+                    return true;
+                }
+                case k_shaderVarVec2:
+                {
+                    if (ReadBinaryFloats(in_chunk, 2, values) == false)
+                    {
+                        return false;
+                    }
+                    out_material->SetShaderVar(name, Vector2(values[0], values[1]));
+                    return true;
+                }
+                case k_shaderVarVec3:
+                {
+                    if (ReadBinaryFloats(in_chunk, 3, values) == false)
+                    {
+                        return false;
+                    }
+                    out_material->SetShaderVar(name, Vector3(values[0], values[1], values[2]));
+                    return true;
+                }
+                case k_shaderVarVec4:
+                {
+                    if (ReadBinaryFloats(in_chunk, 4, values) == false)
+                    {
+                        return false;
+                    }
+                    out_material->SetShaderVar(name, Vector4(values[0], values[1], values[2], values[3]));
+                    return true;
+                }
+                case k_shaderVarColour:
+                {
+                    if (ReadBinaryFloats(in_chunk, 4, values) == false)
+                    {
+                        return false;
+                    }
+                    out_material->SetShaderVar(name, Colour(values[0], values[1], values[2], values[3]));
+                    return true;
+                }
+                case k_shaderVarMatrix:
+                {
+                    if (ReadBinaryFloats(in_chunk, 16, values) == false)
+                    {
+                        return false;
+                    }
+                    Matrix4 matrix;
+                    std::copy(values, values + 16, matrix.m);
+                    out_material->SetShaderVar(name, matrix);
+                    return true;
+                }
+                default:
+                {
+                    CS_LOG_ERROR("Invalid shader var type in binary material: " + ToString(u32(type)));
+                    return false;
+                }
+            }
+        }
+        //----------------------------------------------------------------------------
+        /// Reads the optional SHDR chunk of a binary material. This contains the
+        /// custom shader file paths and their variables.
+        ///
+        /// @param in_chunk - The SHDR chunk.
+        /// @param out_shaderFiles - [Out] The shader files to populate.
+        /// @param out_material - [Out] The material to populate.
+        ///
+        /// @return Whether or not the read was successful.
+        //----------------------------------------------------------------------------
+        bool ReadSHDRChunk(CSBinaryChunk* in_chunk, std::vector<MaterialProvider::ShaderDesc>& out_shaderFiles, Material* out_material) noexcept
+        {
+            if (out_material->GetShadingType() != MaterialShadingType::k_custom)
+            {
+                CS_LOG_ERROR("Only custom materials can have shaders.");
+                return false;
+            }
+            
+            VertexFormat vertexFormat;
+            MaterialShadingType fallbackType;
+            u32 numShaders = 0;
+            if (ReadBinaryVertexFormat(in_chunk, vertexFormat) == false || ReadBinaryEnum(in_chunk, k_binaryShadingTypes, "shading type", fallbackType) == false ||
+                ReadBinaryValue(in_chunk, numShaders) == false)
+            {
+                return false;
+            }
+            out_material->PrepCustomShaders(vertexFormat, fallbackType);
+            
+            for (u32 i = 0; i < numShaders; ++i)
+            {
+                MaterialProvider::ShaderDesc desc;
+                u32 numVars = 0;
+                if (ReadBinaryEnum(in_chunk, k_binaryStorageLocations, "storage location", desc.m_location) == false || ReadBinaryEnum(in_chunk, k_binaryRenderPasses, "render pass", desc.m_pass) == false ||
+                    ReadBinaryString(in_chunk, desc.m_filePath) == false || ReadBinaryValue(in_chunk, numVars) == false)
+                {
+                    return false;
+                }
+                out_shaderFiles.push_back(desc);
+                
+                for (u32 j = 0; j < numVars; ++j)
+                {
+                    if (ReadBinaryShaderVar(in_chunk, out_material) == false)
+                    {
+                        return false;
+                    }
+                }
+            }
+            
+            return true;
+        }
+        //----------------------------------------------------------------------------
+        /// Reads the TEXR chunk of a binary material. This contains the texture
+        /// and cubemap file paths along with their load options.
+        ///
+        /// @param in_chunk - The TEXR chunk.
+        /// @param out_textureFiles - [Out] The texture files to populate.
+        ///
+        /// @return Whether or not the read was successful.
+        //----------------------------------------------------------------------------
+        bool ReadTEXRChunk(CSBinaryChunk* in_chunk, std::vector<MaterialProvider::TextureDesc>& out_textureFiles) noexcept
+        {
+            u32 numTextures = 0;
+            if (ReadBinaryValue(in_chunk, numTextures) == false)
+            {
+                return false;
+            }
+            
+            for (u32 i = 0; i < numTextures; ++i)
+            {
+                MaterialProvider::TextureDesc desc;
+                u8 shouldMipMap = 0;
+                if (ReadBinaryEnum(in_chunk, k_binaryStorageLocations, "storage location", desc.m_location) == false || ReadBinaryEnum(in_chunk, k_binaryTextureTypes, "texture type", desc.m_type) == false ||
+                    ReadBinaryValue(in_chunk, shouldMipMap) == false || ReadBinaryEnum(in_chunk, k_binaryFilterModes, "filter mode", desc.m_filterMode) == false ||
+                    ReadBinaryEnum(in_chunk, k_binaryWrapModes, "wrap mode", desc.m_wrapModeU) == false || ReadBinaryEnum(in_chunk, k_binaryWrapModes, "wrap mode", desc.m_wrapModeV) == false ||
+                    ReadBinaryString(in_chunk, desc.m_filePath) == false)
+                {
+                    return false;
+                }
+                desc.m_shouldMipMap = (shouldMipMap != 0);
+                out_textureFiles.push_back(desc);
+            }
+            
+            return true;
+        }
+        //----------------------------------------------------------------------------
+        /// Builds the material from a binary material file, as produced by
+        /// compile_material.py.
+        ///
+        /// @param in_stream - The binary input stream.
+        /// @param in_filePath - The file path, used for error messages.
+        /// @param out_shaderFiles - [Out] The shader files to populate.
+        /// @param out_textureFiles - [Out] The texture files to populate.
+        /// @param out_material - [Out] The material to populate.
+        ///
+        /// @return Whether or not the material was successfully built.
+        //----------------------------------------------------------------------------
+        bool BuildMaterialFromBinary(CSBinaryInputStream& in_stream, const std::string& in_filePath, std::vector<MaterialProvider::ShaderDesc>& out_shaderFiles,
+                                     std::vector<MaterialProvider::TextureDesc>& out_textureFiles, Material* out_material) noexcept
+        {
+            if (in_stream.IsValid() == false || in_stream.GetFileFormatId() != k_binaryFileFormatId || in_stream.GetFileFormatVersion() != k_binaryFileFormatVersion)
+            {
+                CS_LOG_ERROR("Unsupported binary material format in file: " + in_filePath);
+                return false;
+            }
+            
+            CSBinaryChunkUPtr chunk = in_stream.ReadChunk("MATL");
+            if (chunk == nullptr || ReadMATLChunk(chunk.get(), out_material) == false)
+            {
+                CS_LOG_ERROR("Could not read MATL chunk in binary material file: " + in_filePath);
+                return false;
+            }
+            
+            chunk = in_stream.ReadChunk("SHDR");
+            if (chunk != nullptr && ReadSHDRChunk(chunk.get(), out_shaderFiles, out_material) == false)
+            {
+                CS_LOG_ERROR("Could not read SHDR chunk in binary material file: " + in_filePath);
+                return false;
+            }
+            
+            chunk = in_stream.ReadChunk("TEXR");
+            if (chunk == nullptr || ReadTEXRChunk(chunk.get(), out_textureFiles) == false)
+            {
+                CS_LOG_ERROR("Could not read TEXR chunk in binary material file: " + in_filePath);
+                return false;
+            }
+            
+            return true;
+        }
+        //----------------------------------------------------------------------------
+        /// Builds the material from the root element of an XML material file.
+        ///
+        /// @param in_rootElement - The root element.
+        /// @param out_shaderFiles - [Out] The shader files to populate.
+        /// @param out_textureFiles - [Out] The texture files to populate.
+        /// @param out_material - [Out] The material to populate.
+        ///
+        /// @return Whether or not the material was successfully built.
+        //----------------------------------------------------------------------------
+        bool BuildMaterialFromXML(XML::Node* in_rootElement, std::vector<MaterialProvider::ShaderDesc>& out_shaderFiles,
+                                  std::vector<MaterialProvider::TextureDesc>& out_textureFiles, Material* out_material)
+        {
+            if(in_rootElement == nullptr || XMLUtils::GetName(in_rootElement) != "Material")
+            {
+                return false;
+            }
+            
+            std::string materialType = XMLUtils::GetAttributeValue<std::string>(in_rootElement, "type", "Static");
+            out_material->SetShadingType(ConvertStringToShadingType(materialType));
+            
+            ParseRenderStates(in_rootElement, out_material);
+            ParseAlphaBlendFunction(in_rootElement, out_material);
+            ParseCullFunction(in_rootElement, out_material);
+            ParseDepthTestFunction(in_rootElement, out_material);
+            ParseSurface(in_rootElement, out_material);
+            
+            ParseShaders(in_rootElement, out_shaderFiles, out_material);
+            ParseTextures(in_rootElement, out_textureFiles);
+            
+            return true;
+        }
+        //----------------------------------------------------------------------------
         /// Load the resource from the given descs at the given index. On
         /// completion this will recursively kick off the next load if one
         /// is required, otherwise will call the delegate
@@ -795,11 +1332,11 @@ namespace ChilliSource
     //----------------------------------------------------------------------------
     bool MaterialProvider::CanCreateResourceWithFileExtension(const std::string& in_extension) const
     {
-        return in_extension == k_materialExtension;
+        return (in_extension == k_materialExtension || in_extension == k_binaryMaterialExtension);
     }
     //----------------------------------------------------------------------------
     //----------------------------------------------------------------------------
-    void MaterialProvider::CreateResourceFromFile(StorageLocation in_location, const std::string& in_filePath, const IResourceOptionsBaseCSPtr& in_options, const ResourceSPtr& out_resource)
+    void MaterialProvider::CreateResourceFromFile(StorageLocation in_location, const std::string& in_filePath, const IResourceOptionsBaseCSPtr&, const ResourceSPtr& out_resource)
     {
         std::vector<ShaderDesc> shaderFiles;
         std::vector<TextureDesc> textureFiles;
@@ -870,7 +1407,7 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------------------
     //----------------------------------------------------------------------------
-    void MaterialProvider::CreateResourceFromFileAsync(StorageLocation in_location, const std::string& in_filePath, const IResourceOptionsBaseCSPtr& in_options, const ResourceProvider::AsyncLoadDelegate& in_delegate, const ResourceSPtr& out_resource)
+    void MaterialProvider::CreateResourceFromFileAsync(StorageLocation in_location, const std::string& in_filePath, const IResourceOptionsBaseCSPtr&, const ResourceProvider::AsyncLoadDelegate& in_delegate, const ResourceSPtr& out_resource)
     {
         Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_file, [=](const TaskContext&) noexcept
         {
@@ -933,27 +1470,14 @@ namespace ChilliSource
                                                  std::vector<TextureDesc>& out_textureFiles,
                                                 Material* out_material)
     {
-        //Load the XML file
-        XMLUPtr xml = XMLUtils::ReadDocument(in_location, in_filePath);
-        XML::Node* rootElement = XMLUtils::GetFirstChildElement(xml->GetDocument());
-        
-        if(rootElement == nullptr || XMLUtils::GetName(rootElement) != "Material")
+        if (StringUtils::EndsWith(in_filePath, "." + k_binaryMaterialExtension) == true)
         {
-            return false;
+            CSBinaryInputStream stream(in_location, in_filePath);
+            return BuildMaterialFromBinary(stream, in_filePath, out_shaderFiles, out_textureFiles, out_material);
         }
         
-        std::string materialType = XMLUtils::GetAttributeValue<std::string>(rootElement, "type", "Static");
-        out_material->SetShadingType(ConvertStringToShadingType(materialType));
-
-        ParseRenderStates(rootElement, out_material);
-        ParseAlphaBlendFunction(rootElement, out_material);
-        ParseCullFunction(rootElement, out_material);
-        ParseDepthTestFunction(rootElement, out_material);
-        ParseSurface(rootElement, out_material);
-        
-        ParseShaders(rootElement, out_shaderFiles, out_material);
-        ParseTextures(rootElement, out_textureFiles);
-        
-        return true;
+        //Load the XML file
+        XMLUPtr xml = XMLUtils::ReadDocument(in_location, in_filePath);
+        return BuildMaterialFromXML(XMLUtils::GetFirstChildElement(xml->GetDocument()), out_shaderFiles, out_textureFiles, out_material);
     }
 }
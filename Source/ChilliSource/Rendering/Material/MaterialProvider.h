@@ -37,7 +37,9 @@
 namespace ChilliSource
 {
     //-------------------------------------------------------------------------
-    /// Factory for creating material resources from material files
+    /// Factory for creating material resources from material files. Materials
+    /// can be loaded from either XML (.csmaterial) or the compiled binary form
+    /// (.csmaterialbin) produced by Tools/Scripts/compile_material.py.
     ///
     /// @author S Downie
     //-------------------------------------------------------------------------
@@ -155,7 +157,8 @@ namespace ChilliSource
         //----------------------------------------------------------------------------
         void BuildMaterialTask(StorageLocation in_location, const std::string& in_filePath, const ResourceProvider::AsyncLoadDelegate& in_delegate, const ResourceSPtr& out_resource);
         //----------------------------------------------------------------------------
-        /// Build Material From File
+        /// Build Material From File. The format is chosen from the file
+        /// extension.
         ///
         /// @param The storage location to load from
         /// @param File path
@@ -39,7 +39,7 @@ namespace ChilliSource
             m_isTransparencyEnabled(isTransparencyEnabled), m_isColourWriteEnabled(isColourWriteEnabled), m_isDepthWriteEnabled(isDepthWriteEnabled), m_isDepthTestEnabled(isDepthTestEnabled), m_isFaceCullingEnabled(isFaceCullingEnabled), m_isStencilTestEnabled(isStencilTestEnabled),
             m_depthTestFunc(depthTestFunc),
             m_sourceBlendMode(sourceBlendMode), m_destinationBlendMode(destinationBlendMode),
-            m_stencilFailOp(stencilFailOp), m_stencilDepthFailOp(stencilDepthFailOp), m_stencilPassOp(stencilPassOp), m_stencilTestFunc(stencilTestFunc), m_stencilTestFuncRef(stencilRef), m_stencilTestFuncMask(stencilMask),
+            m_stencilFailOp(stencilFailOp), m_stencilDepthFailOp(stencilDepthFailOp), m_stencilPassOp(stencilPassOp), m_stencilTestFuncRef(stencilRef), m_stencilTestFuncMask(stencilMask), m_stencilTestFunc(stencilTestFunc),
             m_cullFace(cullFace), m_emissiveColour(emissiveColour), m_ambientColour(ambientColour), m_diffuseColour(diffuseColour), m_specularColour(specularColour), m_renderShaderVariables(std::move(renderShaderVariables))
     {
     }
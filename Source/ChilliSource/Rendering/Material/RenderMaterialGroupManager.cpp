@@ -40,16 +40,69 @@ namespace ChilliSource
         return RenderMaterialGroupManagerUPtr(new ForwardRenderMaterialGroupManager());
     }
     
+    //------------------------------------------------------------------------------
+    const RenderMaterialGroup* RenderMaterialGroupManager::AcquireSharedRenderMaterialGroup(const std::string& contentKey) noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        auto it = m_sharedRenderMaterialGroups.find(contentKey);
+        if (it == m_sharedRenderMaterialGroups.end())
+        {
+            return nullptr;
+        }
+        
+        auto infoIt = m_sharedRenderMaterialGroupInfos.find(it->second);
+        CS_ASSERT(infoIt != m_sharedRenderMaterialGroupInfos.end(), "Shared RenderMaterialGroup has no info.");
+        
+        ++infoIt->second.m_referenceCount;
+        ++m_numSharedHitsThisFrame;
+        
+        return it->second;
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderMaterialGroupManager::AddSharedRenderMaterialGroup(const std::string& contentKey, const RenderMaterialGroup* renderMaterialGroup) noexcept
+    {
+        CS_ASSERT(renderMaterialGroup, "Cannot share a null RenderMaterialGroup.");
+        
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        CS_ASSERT(m_sharedRenderMaterialGroupInfos.find(renderMaterialGroup) == m_sharedRenderMaterialGroupInfos.end(), "RenderMaterialGroup is already shared.");
+        
+        if (m_sharedRenderMaterialGroups.emplace(contentKey, renderMaterialGroup).second)
+        {
+            SharedRenderMaterialGroupInfo info;
+            info.m_contentKey = contentKey;
+            info.m_referenceCount = 1;
+            m_sharedRenderMaterialGroupInfos.emplace(renderMaterialGroup, std::move(info));
+        }
+    }
+    
     //------------------------------------------------------------------------------
     void RenderMaterialGroupManager::DestroyRenderMaterialGroup(const RenderMaterialGroup* renderMaterial) noexcept
     {
         std::unique_lock<std::mutex> lock(m_mutex);
         
+        auto infoIt = m_sharedRenderMaterialGroupInfos.find(renderMaterial);
+        if (infoIt != m_sharedRenderMaterialGroupInfos.end())
+        {
+            CS_ASSERT(infoIt->second.m_referenceCount > 0, "Shared RenderMaterialGroup has already been released.");
+            
+            if (--infoIt->second.m_referenceCount > 0)
+            {
+                return;
+            }
+            
+            m_sharedRenderMaterialGroups.erase(infoIt->second.m_contentKey);
+            m_sharedRenderMaterialGroupInfos.erase(infoIt);
+        }
+        
         for (auto it = m_renderMaterialGroups.begin(); it != m_renderMaterialGroups.end(); ++it)
         {
             if (it->get() == renderMaterial)
             {
                 m_pendingUnloadCommands.push_back(std::move(*it));
+                ++m_numDestroyedThisFrame;
                 
                 it->swap(m_renderMaterialGroups.back());
                 m_renderMaterialGroups.pop_back();
@@ -67,10 +120,43 @@ namespace ChilliSource
         
         m_pendingLoadCommands.push_back(renderMaterialGroup.get());
         m_renderMaterialGroups.push_back(std::move(renderMaterialGroup));
+        ++m_numCreatedThisFrame;
+    }
+    
+    //------------------------------------------------------------------------------
+    u32 RenderMaterialGroupManager::GetNumRenderMaterialGroups() const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        return u32(m_renderMaterialGroups.size());
+    }
+    
+    //------------------------------------------------------------------------------
+    u32 RenderMaterialGroupManager::GetNumRenderMaterialGroupsCreatedLastFrame() const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        return m_numCreatedLastFrame;
     }
     
     //------------------------------------------------------------------------------
-    void RenderMaterialGroupManager::OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) noexcept
+    u32 RenderMaterialGroupManager::GetNumRenderMaterialGroupsDestroyedLastFrame() const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        return m_numDestroyedLastFrame;
+    }
+    
+    //------------------------------------------------------------------------------
+    u32 RenderMaterialGroupManager::GetNumSharedRenderMaterialGroupHitsLastFrame() const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        return m_numSharedHitsLastFrame;
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderMaterialGroupManager::OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator*) noexcept
     {
         if(targetType == TargetType::k_main)
         {
@@ -90,6 +176,13 @@ namespace ChilliSource
                 postRenderCommandList->AddUnloadMaterialGroupCommand(std::move(unloadCommand));
             }
             m_pendingUnloadCommands.clear();
+            
+            m_numCreatedLastFrame = m_numCreatedThisFrame;
+            m_numDestroyedLastFrame = m_numDestroyedThisFrame;
+            m_numSharedHitsLastFrame = m_numSharedHitsThisFrame;
+            m_numCreatedThisFrame = 0;
+            m_numDestroyedThisFrame = 0;
+            m_numSharedHitsThisFrame = 0;
         }
     }
     
@@ -97,5 +190,6 @@ namespace ChilliSource
     RenderMaterialGroupManager::~RenderMaterialGroupManager() noexcept
     {
         CS_ASSERT(m_renderMaterialGroups.size() == 0, "Render material groups have not been correctly released.");
+        CS_ASSERT(m_sharedRenderMaterialGroupInfos.size() == 0, "Shared render material groups have not been correctly released.");
     }
 }
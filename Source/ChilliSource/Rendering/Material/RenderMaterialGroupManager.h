@@ -30,6 +30,8 @@
 #include <ChilliSource/Rendering/Material/RenderMaterialGroup.h>
 
 #include <mutex>
+#include <string>
+#include <unordered_map>
 
 namespace ChilliSource
 {
@@ -42,6 +44,11 @@ namespace ChilliSource
     /// On deletion an UnloadMaterialRenderCommand is queued for each RenderMaterialand given ownership of the
     /// RenderMesh. The RenderMesh is then deleted once the command has been processed.
     ///
+    /// Material groups can optionally be shared between materials with identical content. A
+    /// group registered with a content key is reference counted: each call to
+    /// AcquireSharedRenderMaterialGroup() must be balanced by a call to DestroyRenderMaterialGroup(),
+    /// and the unload command is only queued once the last reference has been released.
+    ///
     /// This is thread-safe and can be called from any thread. If it is called on a background
     /// thread, care needs to be taken to ensure any created RenderMeshes are not used prior
     /// to being loaded.
@@ -188,15 +195,59 @@ namespace ChilliSource
                                                                    CullFace cullFace, const Colour& emissiveColour, const Colour& ambientColour, const Colour& diffuseColour, const Colour& specularColour,
                                                                    RenderShaderVariablesUPtr renderShaderVariables) noexcept = 0;
         
+        /// Looks up a RenderMaterialGroup which was previously registered with the given content
+        /// key. If one exists its reference count is incremented and it is returned. The returned
+        /// group should be released with DestroyRenderMaterialGroup() like any other.
+        ///
+        /// @param contentKey
+        ///     A key which uniquely describes the shading type, shaders, textures and render
+        ///     state of the material group.
+        ///
+        /// @return The shared material group, or null if no group with the key exists.
+        ///
+        const RenderMaterialGroup* AcquireSharedRenderMaterialGroup(const std::string& contentKey) noexcept;
+        
+        /// Registers a newly created RenderMaterialGroup under the given content key, allowing it
+        /// to be acquired by other materials with identical content. The caller holds the first
+        /// reference. If a group is already registered with the key, the new group is left
+        /// unshared.
+        ///
+        /// @param contentKey
+        ///     A key which uniquely describes the content of the material group.
+        /// @param renderMaterialGroup
+        ///     The material group to share. This must have been created by this manager.
+        ///
+        void AddSharedRenderMaterialGroup(const std::string& contentKey, const RenderMaterialGroup* renderMaterialGroup) noexcept;
+        
         /// Removes the RenderMaterialGroup from the manager and queues an UnloadMaterialGroupRenderCommand
         /// for the next Render Snapshot stage in the render pipeline. The render command is given ownership
         /// of the RenderMaterialGroup, ensuring it won't be destroyed until it is no longer used.
         ///
+        /// If the group is shared, this releases a single reference and the group is only removed once
+        /// all references have been released.
+        ///
         /// @param renderMaterialGroup
         ///     The RenderMaterialGroup which should be destroyed.
         ///
         void DestroyRenderMaterialGroup(const RenderMaterialGroup* renderMaterial) noexcept;
         
+        /// @return The number of RenderMaterialGroups currently owned by the manager.
+        ///
+        u32 GetNumRenderMaterialGroups() const noexcept;
+        
+        /// @return The number of RenderMaterialGroups which were created during the last frame.
+        ///
+        u32 GetNumRenderMaterialGroupsCreatedLastFrame() const noexcept;
+        
+        /// @return The number of RenderMaterialGroups which were destroyed during the last frame.
+        ///
+        u32 GetNumRenderMaterialGroupsDestroyedLastFrame() const noexcept;
+        
+        /// @return The number of times an existing shared RenderMaterialGroup was acquired instead
+        ///     of creating a new one during the last frame.
+        ///
+        u32 GetNumSharedRenderMaterialGroupHitsLastFrame() const noexcept;
+        
         virtual ~RenderMaterialGroupManager() noexcept;
         
     protected:
@@ -231,10 +282,27 @@ namespace ChilliSource
         ///
         void OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) noexcept override;
         
-        std::mutex m_mutex;
+        /// Describes a material group which has been registered for sharing.
+        ///
+        struct SharedRenderMaterialGroupInfo
+        {
+            std::string m_contentKey;
+            u32 m_referenceCount = 0;
+        };
+        
+        mutable std::mutex m_mutex;
         std::vector<RenderMaterialGroupUPtr> m_renderMaterialGroups;
+        std::unordered_map<std::string, const RenderMaterialGroup*> m_sharedRenderMaterialGroups;
+        std::unordered_map<const RenderMaterialGroup*, SharedRenderMaterialGroupInfo> m_sharedRenderMaterialGroupInfos;
         std::vector<RenderMaterialGroup*> m_pendingLoadCommands;
         std::vector<RenderMaterialGroupUPtr> m_pendingUnloadCommands;
+        
+        u32 m_numCreatedThisFrame = 0;
+        u32 m_numDestroyedThisFrame = 0;
+        u32 m_numSharedHitsThisFrame = 0;
+        u32 m_numCreatedLastFrame = 0;
+        u32 m_numDestroyedLastFrame = 0;
+        u32 m_numSharedHitsLastFrame = 0;
     };
 }
 
@@ -38,6 +38,7 @@
 #include <ChilliSource/Rendering/Model/MeshDesc.h>
 #include <ChilliSource/Rendering/Model/Model.h>
 #include <ChilliSource/Rendering/Model/ModelDesc.h>
+#include <ChilliSource/Rendering/Model/ModelResourceOptions.h>
 #include <ChilliSource/Rendering/Model/PolygonType.h>
 #include <ChilliSource/Rendering/Model/PrimitiveModelFactory.h>
 #include <ChilliSource/Rendering/Model/RenderDynamicMesh.h>
@@ -50,6 +51,7 @@
 #include <ChilliSource/Rendering/Model/SkinnedAnimation.h>
 #include <ChilliSource/Rendering/Model/SkinnedAnimationGroup.h>
 #include <ChilliSource/Rendering/Model/SmallMeshBatcher.h>
+#include <ChilliSource/Rendering/Model/StaticModelBatcher.h>
 #include <ChilliSource/Rendering/Model/StaticModelComponent.h>
 #include <ChilliSource/Rendering/Model/VertexFormat.h>
 
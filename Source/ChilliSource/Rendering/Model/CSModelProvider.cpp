@@ -32,6 +32,7 @@
 #include <ChilliSource/Core/Threading/TaskScheduler.h>
 #include <ChilliSource/Rendering/Model/Model.h>
 #include <ChilliSource/Rendering/Model/ModelDesc.h>
+#include <ChilliSource/Rendering/Model/ModelResourceOptions.h>
 #include <ChilliSource/Rendering/Model/IndexFormat.h>
 #include <ChilliSource/Rendering/Model/PolygonType.h>
 
@@ -441,6 +442,16 @@ namespace ChilliSource
 
             return true;
         }
+        //----------------------------------------------------------------------------
+        /// @param The options the model is being loaded with. May be null.
+        ///
+        /// @return Whether or not the model should keep a copy of its mesh data in
+        /// main memory.
+        //----------------------------------------------------------------------------
+        bool ShouldRetainMeshData(const IResourceOptionsBaseCSPtr& in_options)
+        {
+            return in_options && static_cast<const ModelResourceOptions*>(in_options.get())->ShouldRetainMeshData();
+        }
     }
     
     CS_DEFINE_NAMEDTYPE(CSModelProvider);
@@ -483,7 +494,7 @@ namespace ChilliSource
             return;
         }
         
-        modelResource->Build(std::move(modelDesc));
+        modelResource->Build(std::move(modelDesc), ShouldRetainMeshData(in_options));
         modelResource->SetLoadState(Resource::LoadState::k_loaded);
     }
     //----------------------------------------------------------------------------
@@ -497,12 +508,12 @@ namespace ChilliSource
         //Load model as task
         Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_file, [=](const TaskContext&) noexcept
         {
-            LoadMeshDataTask(in_location, in_filePath, in_delegate, meshResource);
+            LoadMeshDataTask(in_location, in_filePath, in_options, in_delegate, meshResource);
         });
     }
     //----------------------------------------------------------------------------
     //----------------------------------------------------------------------------
-    void CSModelProvider::LoadMeshDataTask(StorageLocation in_location, const std::string& in_filePath, const AsyncLoadDelegate& in_delegate, const ModelSPtr& out_resource)
+    void CSModelProvider::LoadMeshDataTask(StorageLocation in_location, const std::string& in_filePath, const IResourceOptionsBaseCSPtr& in_options, const AsyncLoadDelegate& in_delegate, const ModelSPtr& out_resource)
     {
         //read the mesh data into a MoStaticDeclaration
         ModelDescSPtr modelDesc(new ModelDesc());
@@ -518,7 +529,7 @@ namespace ChilliSource
         //start a main thread task for loading the data into a mesh
         Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_large, [=](const TaskContext&) noexcept
         {
-            out_resource->Build(std::move(*modelDesc));
+            out_resource->Build(std::move(*modelDesc), ShouldRetainMeshData(in_options));
             out_resource->SetLoadState(Resource::LoadState::k_loaded);
             
            in_delegate(out_resource);
@@ -30,10 +30,36 @@
 #include <ChilliSource/Rendering/Model/RenderMeshManager.h>
 
 #include <algorithm>
+#include <cstring>
 
 namespace ChilliSource
 {
     CS_DEFINE_NAMEDTYPE(Model);
+    
+    namespace
+    {
+        /// Creates a copy of the given data buffer.
+        ///
+        /// @param data
+        ///     The data to copy. May be null.
+        /// @param dataSize
+        ///     The size of the data.
+        ///
+        /// @return The copy, or null if there is no data.
+        ///
+        std::unique_ptr<const u8[]> CopyData(const u8* data, u32 dataSize) noexcept
+        {
+            if (!data || dataSize == 0)
+            {
+                return nullptr;
+            }
+            
+            std::unique_ptr<u8[]> copy(new u8[dataSize]);
+            memcpy(copy.get(), data, dataSize);
+            
+            return std::unique_ptr<const u8[]>(std::move(copy));
+        }
+    }
 
     //------------------------------------------------------------------------------
     ModelUPtr Model::Create() noexcept
@@ -48,7 +74,7 @@ namespace ChilliSource
     }
     
     //------------------------------------------------------------------------------
-    void Model::Build(ModelDesc modelDesc) noexcept
+    void Model::Build(ModelDesc modelDesc, bool shouldRetainMeshData) noexcept
     {
         DestroyRenderMeshes();
         
@@ -75,9 +101,19 @@ namespace ChilliSource
             auto indexDataSize = meshDesc.GetNumIndices() * GetIndexSize(meshDesc.GetIndexFormat());
             auto inverseBindPoseMatrices = meshDesc.ClaimInverseBindPoseMatrices();
             
+            if (shouldRetainMeshData)
+            {
+                m_vertexData.push_back(CopyData(vertexData.get(), vertexDataSize));
+                m_indexData.push_back(CopyData(indexData.get(), indexDataSize));
+                
+                m_memoryUsage += vertexDataSize + indexDataSize;
+            }
+            
             auto renderMesh = renderMeshManager->CreateRenderMesh(poylgonType, vertexFormat, indexFormat, numVertices, numIndices, boundingSphere, std::move(vertexData), vertexDataSize, std::move(indexData), indexDataSize,
                                                                   modelDesc.ShouldBackupData(), std::move(inverseBindPoseMatrices));
             m_renderMeshes.push_back(renderMesh);
+            
+            m_memoryUsage += vertexDataSize + indexDataSize;
         }
     }
     
@@ -155,6 +191,33 @@ namespace ChilliSource
         return m_renderMeshes[index];
     }
     
+    //------------------------------------------------------------------------------
+    bool Model::HasMeshData() const noexcept
+    {
+        CS_ASSERT(GetLoadState() == LoadState::k_loaded, "Cannot access a model before it is loaded.");
+        CS_ASSERT(m_renderMeshes.size() > 0, "Cannot access a model which has not been built.");
+        
+        return m_vertexData.size() == m_renderMeshes.size();
+    }
+    
+    //------------------------------------------------------------------------------
+    const u8* Model::GetVertexData(u32 index) const noexcept
+    {
+        CS_ASSERT(HasMeshData(), "Cannot access mesh data which was not retained.");
+        CS_ASSERT(index < m_vertexData.size(), "Index is out of bounds.");
+        
+        return m_vertexData[index].get();
+    }
+    
+    //------------------------------------------------------------------------------
+    const u8* Model::GetIndexData(u32 index) const noexcept
+    {
+        CS_ASSERT(HasMeshData(), "Cannot access mesh data which was not retained.");
+        CS_ASSERT(index < m_indexData.size(), "Index is out of bounds.");
+        
+        return m_indexData[index].get();
+    }
+    
     //------------------------------------------------------------------------------
     void Model::DestroyRenderMeshes() noexcept
     {
@@ -165,6 +228,15 @@ namespace ChilliSource
         }
         m_renderMeshes.clear();
         m_meshNames.clear();
+        m_vertexData.clear();
+        m_indexData.clear();
+        m_memoryUsage = 0;
+    }
+    
+    //------------------------------------------------------------------------------
+    u64 Model::GetMemoryUsage() const noexcept
+    {
+        return m_memoryUsage;
     }
     
     //------------------------------------------------------------------------------
@@ -59,8 +59,11 @@ namespace ChilliSource
         ///
         /// @param modelDesc
         ///     The model description. Can only be used once to build a model.
+        /// @param shouldRetainMeshData
+        ///     (Optional) Whether or not a copy of the vertex and index data of each mesh should be
+        ///     kept in main memory. Defaults to false.
         ///
-        void Build(ModelDesc modelDesc) noexcept;
+        void Build(ModelDesc modelDesc, bool shouldRetainMeshData = false) noexcept;
         
         /// This must not be called until the model is built and loaded.
         ///
@@ -121,6 +124,43 @@ namespace ChilliSource
         ///
         const RenderMesh* GetRenderMesh(u32 index) const noexcept;
         
+        /// This must not be called until the model is built and loaded.
+        ///
+        /// @return Whether or not the vertex and index data of each mesh has been kept in main
+        ///     memory.
+        ///
+        bool HasMeshData() const noexcept;
+        
+        /// Looks up the vertex data of the mesh with the given index. This will assert if the index
+        /// is out of bounds or if the mesh data was not retained when the model was built. The layout
+        /// of the data is described by the vertex format of the RenderMesh.
+        ///
+        /// This must not be called until the model is built and loaded.
+        ///
+        /// @param index
+        ///     The index of the mesh.
+        ///
+        /// @return The vertex data.
+        ///
+        const u8* GetVertexData(u32 index) const noexcept;
+        
+        /// Looks up the index data of the mesh with the given index. This will assert if the index
+        /// is out of bounds or if the mesh data was not retained when the model was built.
+        ///
+        /// This must not be called until the model is built and loaded.
+        ///
+        /// @param index
+        ///     The index of the mesh.
+        ///
+        /// @return The index data, or null if the mesh is not indexed.
+        ///
+        const u8* GetIndexData(u32 index) const noexcept;
+        
+        /// @return An estimate of the memory used by the vertex and index data of all meshes in the
+        ///     model in bytes.
+        ///
+        u64 GetMemoryUsage() const noexcept override;
+        
         ~Model() noexcept;
         
     private:
@@ -142,9 +182,12 @@ namespace ChilliSource
 
         std::vector<std::string> m_meshNames;
         std::vector<const RenderMesh*> m_renderMeshes;
+        std::vector<std::unique_ptr<const u8[]>> m_vertexData;
+        std::vector<std::unique_ptr<const u8[]>> m_indexData;
         Skeleton m_skeleton;
         AABB m_aabb;
         Sphere m_boundingSphere;
+        u64 m_memoryUsage = 0;
     };
 }
 
@@ -0,0 +1,74 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_RENDERING_MODEL_MODELRESOURCEOPTIONS_H_
+#define _CHILLISOURCE_RENDERING_MODEL_MODELRESOURCEOPTIONS_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Resource/IResourceOptions.h>
+#include <ChilliSource/Rendering/Model/Model.h>
+
+namespace ChilliSource
+{
+    /// Custom options for loading a model.
+    ///
+    /// This is immutable and therefore thread-safe.
+    ///
+    class ModelResourceOptions final : public IResourceOptions<Model>
+    {
+    public:
+        ModelResourceOptions() = default;
+        
+        /// Creates a new instance with the given options.
+        ///
+        /// @param shouldRetainMeshData
+        ///     Whether or not a copy of the vertex and index data of each mesh should be kept in
+        ///     main memory after the model has been built. This is required for models which will
+        ///     be merged by the StaticModelBatcher.
+        ///
+        ModelResourceOptions(bool shouldRetainMeshData) noexcept;
+        
+        /// @return A unique hash based on the currently set options.
+        ///
+        u32 GenerateHash() const override;
+        
+        /// @return Whether or not the mesh data should be kept in main memory after the model has
+        ///     been built.
+        ///
+        bool ShouldRetainMeshData() const noexcept { return m_options.m_shouldRetainMeshData; }
+        
+    private:
+        /// The options for loading models. These are held in a struct to more easily allow
+        /// hashing of the data.
+        ///
+        struct Options final
+        {
+            bool m_shouldRetainMeshData = false;
+        };
+        
+        Options m_options;
+    };
+}
+
+#endif
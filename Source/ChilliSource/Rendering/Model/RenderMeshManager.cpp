@@ -89,7 +89,7 @@ namespace ChilliSource
     }
 
     //------------------------------------------------------------------------------
-    void RenderMeshManager::OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) noexcept
+    void RenderMeshManager::OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator*) noexcept
     {
         if(targetType == TargetType::k_main)
         {
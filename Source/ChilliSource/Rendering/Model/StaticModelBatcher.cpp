@@ -0,0 +1,344 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Rendering/Model/StaticModelBatcher.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Entity/Entity.h>
+#include <ChilliSource/Core/Math/Matrix4.h>
+#include <ChilliSource/Core/Math/Geometry/Shapes.h>
+#include <ChilliSource/Core/Resource/ResourcePool.h>
+#include <ChilliSource/Core/String/ToString.h>
+#include <ChilliSource/Core/Threading/TaskScheduler.h>
+#include <ChilliSource/Rendering/Material/Material.h>
+#include <ChilliSource/Rendering/Model/IndexFormat.h>
+#include <ChilliSource/Rendering/Model/MeshDesc.h>
+#include <ChilliSource/Rendering/Model/Model.h>
+#include <ChilliSource/Rendering/Model/ModelDesc.h>
+#include <ChilliSource/Rendering/Model/PolygonType.h>
+#include <ChilliSource/Rendering/Model/RenderMesh.h>
+#include <ChilliSource/Rendering/Model/StaticModelComponent.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace ChilliSource
+{
+    namespace
+    {
+        constexpr u32 k_maxVerticesPerMesh = std::numeric_limits<u16>::max();
+        
+        u32 g_nextBatchIndex = 0;
+        
+        /// Finds the offset of the first element of the given type in the vertex format.
+        ///
+        /// @param vertexFormat
+        ///     The vertex format.
+        /// @param elementType
+        ///     The element type to look for.
+        ///
+        /// @return The offset of the element, or -1 if the format doesn't contain it.
+        ///
+        s32 FindElementOffset(const VertexFormat& vertexFormat, VertexFormat::ElementType elementType) noexcept
+        {
+            for (u32 i = 0; i < vertexFormat.GetNumElements(); ++i)
+            {
+                if (vertexFormat.GetElement(i) == elementType)
+                {
+                    return s32(vertexFormat.GetElementOffset(i));
+                }
+            }
+            
+            return -1;
+        }
+        
+        /// Calculates whether or not the given mesh of the given model can be merged.
+        ///
+        /// @param model
+        ///     The model.
+        /// @param meshIndex
+        ///     The index of the mesh in the model.
+        ///
+        /// @return Whether or not the mesh can be merged.
+        ///
+        bool CanMerge(const Model* model, u32 meshIndex) noexcept
+        {
+            if (!model->HasMeshData())
+            {
+                return false;
+            }
+            
+            auto renderMesh = model->GetRenderMesh(meshIndex);
+            const auto& vertexFormat = renderMesh->GetVertexFormat();
+            
+            return (renderMesh->GetPolygonType() == PolygonType::k_triangle && renderMesh->GetIndexFormat() == IndexFormat::k_short && renderMesh->GetNumVertices() <= k_maxVerticesPerMesh &&
+                    FindElementOffset(vertexFormat, VertexFormat::ElementType::k_position4) >= 0 && FindElementOffset(vertexFormat, VertexFormat::ElementType::k_weight4) < 0 &&
+                    FindElementOffset(vertexFormat, VertexFormat::ElementType::k_jointIndex4) < 0);
+        }
+        
+        /// @param renderMesh
+        ///     The render mesh.
+        ///
+        /// @return The number of indices that the mesh will contribute to a merged mesh. Meshes
+        ///     without indices are given one index per vertex.
+        ///
+        u32 GetNumMergedIndices(const RenderMesh* renderMesh) noexcept
+        {
+            return renderMesh->GetNumIndices() > 0 ? renderMesh->GetNumIndices() : renderMesh->GetNumVertices();
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    StaticModelBatcher::StaticModelBatcher(f32 clusterSize) noexcept
+        : m_clusterSize(clusterSize)
+    {
+        CS_ASSERT(m_clusterSize > 0.0f, "Cluster size must be greater than zero.");
+    }
+    
+    //------------------------------------------------------------------------------
+    void StaticModelBatcher::Add(StaticModelComponent* component) noexcept
+    {
+        CS_ASSERT(component, "Cannot add null component.");
+        CS_ASSERT(component->GetEntity(), "Component must be attached to an entity.");
+        
+        const auto& model = component->GetModel();
+        
+        // If any one mesh cannot be merged the whole component is left alone, otherwise
+        // the remaining meshes would be rendered twice.
+        for (u32 meshIndex = 0; meshIndex < model->GetNumMeshes(); ++meshIndex)
+        {
+            if (!CanMerge(model.get(), meshIndex))
+            {
+                m_numRejectedSourceMeshes += model->GetNumMeshes();
+                return;
+            }
+        }
+        
+        const auto& origin = component->GetBoundingSphere().vOrigin;
+        ClusterKey clusterKey(s32(std::floor(origin.x / m_clusterSize)), s32(std::floor(origin.y / m_clusterSize)), s32(std::floor(origin.z / m_clusterSize)), component->IsShadowCastingEnabled());
+        auto& meshGroups = m_clusters[clusterKey];
+        
+        for (u32 meshIndex = 0; meshIndex < model->GetNumMeshes(); ++meshIndex)
+        {
+            const auto& material = component->GetMaterialForMesh(meshIndex);
+            const auto& vertexFormat = model->GetRenderMesh(meshIndex)->GetVertexFormat();
+            
+            auto it = std::find_if(meshGroups.begin(), meshGroups.end(), [&](const MeshGroup& meshGroup)
+            {
+                return meshGroup.m_material == material && meshGroup.m_vertexFormat == vertexFormat;
+            });
+            
+            if (it == meshGroups.end())
+            {
+                MeshGroup meshGroup;
+                meshGroup.m_material = material;
+                meshGroup.m_vertexFormat = vertexFormat;
+                meshGroups.push_back(std::move(meshGroup));
+                it = meshGroups.end() - 1;
+            }
+            
+            it->m_sourceMeshes.push_back(SourceMesh { component, meshIndex });
+        }
+        
+        m_components.push_back(component);
+    }
+    
+    //------------------------------------------------------------------------------
+    void StaticModelBatcher::AddRecursive(Entity* entity) noexcept
+    {
+        CS_ASSERT(entity, "Cannot add null entity.");
+        
+        std::vector<StaticModelComponent*> components;
+        entity->GetComponentsRecursive(components);
+        
+        for (auto component : components)
+        {
+            Add(component);
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    EntityUPtr StaticModelBatcher::Build() noexcept
+    {
+        CS_ASSERT(Application::Get()->GetTaskScheduler()->IsMainThread(), "Static batches must be built on the main thread.");
+        
+        m_report = Report();
+        m_report.m_numRejectedSourceMeshes = m_numRejectedSourceMeshes;
+        m_report.m_numClusters = u32(m_clusters.size());
+        
+        auto resourcePool = Application::Get()->GetResourcePool();
+        auto rootEntity = Entity::Create();
+        rootEntity->SetName("StaticBatches");
+        
+        for (const auto& cluster : m_clusters)
+        {
+            std::vector<MeshDesc> meshDescs;
+            std::vector<MaterialCSPtr> materials;
+            Vector3 clusterMin(std::numeric_limits<f32>::infinity(), std::numeric_limits<f32>::infinity(), std::numeric_limits<f32>::infinity());
+            Vector3 clusterMax = -clusterMin;
+            
+            for (const auto& meshGroup : cluster.second)
+            {
+                const auto& vertexFormat = meshGroup.m_vertexFormat;
+                auto positionOffset = FindElementOffset(vertexFormat, VertexFormat::ElementType::k_position4);
+                auto normalOffset = FindElementOffset(vertexFormat, VertexFormat::ElementType::k_normal3);
+                
+                std::size_t batchStart = 0;
+                while (batchStart < meshGroup.m_sourceMeshes.size())
+                {
+                    // Gather as many source meshes as will fit within the range of a 16-bit index.
+                    u32 numVertices = 0;
+                    u32 numIndices = 0;
+                    auto batchEnd = batchStart;
+                    while (batchEnd < meshGroup.m_sourceMeshes.size())
+                    {
+                        const auto& sourceMesh = meshGroup.m_sourceMeshes[batchEnd];
+                        auto renderMesh = sourceMesh.m_component->GetModel()->GetRenderMesh(sourceMesh.m_meshIndex);
+                        if (numVertices + renderMesh->GetNumVertices() > k_maxVerticesPerMesh)
+                        {
+                            break;
+                        }
+                        
+                        numVertices += renderMesh->GetNumVertices();
+                        numIndices += GetNumMergedIndices(renderMesh);
+                        ++batchEnd;
+                    }
+                    
+                    std::unique_ptr<u8[]> vertexData(new u8[numVertices * vertexFormat.GetSize()]);
+                    std::unique_ptr<u8[]> indexData(new u8[numIndices * GetIndexSize(IndexFormat::k_short)]);
+                    auto indices = reinterpret_cast<u16*>(indexData.get());
+                    
+                    Vector3 meshMin(std::numeric_limits<f32>::infinity(), std::numeric_limits<f32>::infinity(), std::numeric_limits<f32>::infinity());
+                    Vector3 meshMax = -meshMin;
+                    
+                    u32 vertexOffset = 0;
+                    u32 indexOffset = 0;
+                    for (auto i = batchStart; i < batchEnd; ++i)
+                    {
+                        const auto& sourceMesh = meshGroup.m_sourceMeshes[i];
+                        const auto& model = sourceMesh.m_component->GetModel();
+                        auto renderMesh = model->GetRenderMesh(sourceMesh.m_meshIndex);
+                        const auto& worldMatrix = sourceMesh.m_component->GetEntity()->GetTransform().GetWorldTransform();
+                        auto normalMatrix = Matrix4::Transpose(Matrix4::Inverse(worldMatrix));
+                        
+                        auto vertices = vertexData.get() + vertexOffset * vertexFormat.GetSize();
+                        memcpy(vertices, model->GetVertexData(sourceMesh.m_meshIndex), renderMesh->GetNumVertices() * vertexFormat.GetSize());
+                        
+                        for (u32 vertexIndex = 0; vertexIndex < renderMesh->GetNumVertices(); ++vertexIndex)
+                        {
+                            auto vertex = vertices + vertexIndex * vertexFormat.GetSize();
+                            
+                            f32 position[4];
+                            memcpy(position, vertex + positionOffset, sizeof(position));
+                            auto worldPosition = Vector4(position[0], position[1], position[2], 1.0f) * worldMatrix;
+                            position[0] = worldPosition.x;
+                            position[1] = worldPosition.y;
+                            position[2] = worldPosition.z;
+                            memcpy(vertex + positionOffset, position, sizeof(position));
+                            
+                            meshMin = Vector3::Min(meshMin, worldPosition.XYZ());
+                            meshMax = Vector3::Max(meshMax, worldPosition.XYZ());
+                            
+                            if (normalOffset >= 0)
+                            {
+                                f32 normal[3];
+                                memcpy(normal, vertex + normalOffset, sizeof(normal));
+                                auto worldNormal = Vector3::Normalise((Vector4(normal[0], normal[1], normal[2], 0.0f) * normalMatrix).XYZ());
+                                normal[0] = worldNormal.x;
+                                normal[1] = worldNormal.y;
+                                normal[2] = worldNormal.z;
+                                memcpy(vertex + normalOffset, normal, sizeof(normal));
+                            }
+                        }
+                        
+                        auto sourceIndices = reinterpret_cast<const u16*>(model->GetIndexData(sourceMesh.m_meshIndex));
+                        auto numSourceIndices = GetNumMergedIndices(renderMesh);
+                        for (u32 index = 0; index < numSourceIndices; ++index)
+                        {
+                            indices[indexOffset + index] = u16(vertexOffset + (sourceIndices ? sourceIndices[index] : index));
+                        }
+                        
+                        // Mirroring transforms flip the winding order, so restore it.
+                        if (worldMatrix.Determinant() < 0.0f)
+                        {
+                            for (u32 index = 0; index + 2 < numSourceIndices; index += 3)
+                            {
+                                std::swap(indices[indexOffset + index + 1], indices[indexOffset + index + 2]);
+                            }
+                        }
+                        
+                        vertexOffset += renderMesh->GetNumVertices();
+                        indexOffset += numSourceIndices;
+                    }
+                    
+                    AABB aabb((meshMin + meshMax) * 0.5f, meshMax - meshMin);
+                    Sphere boundingSphere(aabb.Centre(), aabb.GetSize().Length() * 0.5f);
+                    
+                    meshDescs.push_back(MeshDesc("StaticBatch" + ToString(u32(meshDescs.size())), PolygonType::k_triangle, vertexFormat, IndexFormat::k_short, aabb, boundingSphere, numVertices, numIndices,
+                                                 std::unique_ptr<const u8[]>(std::move(vertexData)), std::unique_ptr<const u8[]>(std::move(indexData))));
+                    materials.push_back(meshGroup.m_material);
+                    
+                    clusterMin = Vector3::Min(clusterMin, meshMin);
+                    clusterMax = Vector3::Max(clusterMax, meshMax);
+                    
+                    m_report.m_numMergedSourceMeshes += u32(batchEnd - batchStart);
+                    ++m_report.m_numBatchedMeshes;
+                    
+                    batchStart = batchEnd;
+                }
+            }
+            
+            AABB clusterAABB((clusterMin + clusterMax) * 0.5f, clusterMax - clusterMin);
+            Sphere clusterBoundingSphere(clusterAABB.Centre(), clusterAABB.GetSize().Length() * 0.5f);
+            
+            auto model = resourcePool->CreateResource<Model>("_StaticBatch(" + ToString(g_nextBatchIndex++) + ")");
+            model->Build(ModelDesc(std::move(meshDescs), clusterAABB, clusterBoundingSphere));
+            model->SetLoadState(Resource::LoadState::k_loaded);
+            
+            StaticModelComponentSPtr component(new StaticModelComponent(model, materials));
+            component->SetShadowCastingEnabled(std::get<3>(cluster.first));
+            
+            auto entity = Entity::Create();
+            entity->SetName(model->GetName());
+            entity->AddComponent(component);
+            rootEntity->AddEntity(std::move(entity));
+        }
+        
+        for (auto component : m_components)
+        {
+            component->SetVisible(false);
+        }
+        
+        CS_LOG_VERBOSE("Static batching merged " + ToString(m_report.m_numMergedSourceMeshes) + " meshes into " + ToString(m_report.m_numBatchedMeshes) + " across " + ToString(m_report.m_numClusters) +
+                       " clusters, saving " + ToString(m_report.GetNumDrawCallsSaved()) + " draw calls. " + ToString(m_report.m_numRejectedSourceMeshes) + " meshes could not be merged.");
+        
+        m_clusters.clear();
+        m_components.clear();
+        m_numRejectedSourceMeshes = 0;
+        
+        return rootEntity;
+    }
+}
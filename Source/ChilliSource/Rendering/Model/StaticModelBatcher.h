@@ -0,0 +1,142 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_RENDERING_MODEL_STATICMODELBATCHER_H_
+#define _CHILLISOURCE_RENDERING_MODEL_STATICMODELBATCHER_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Rendering/Model/VertexFormat.h>
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace ChilliSource
+{
+    /// An opt-in step for merging the meshes of StaticModelComponents which will never move into
+    /// a smaller number of larger meshes. This reduces the number of render objects, visibility
+    /// tests and draw calls needed to render scenes built from many small pieces of static
+    /// geometry.
+    ///
+    /// Meshes are grouped into spatial clusters, each a cube of the requested size in world space,
+    /// so the merged meshes can still be culled effectively. Within a cluster, meshes which share
+    /// the same material and vertex format are transformed into world space and merged into a
+    /// single RenderMesh, with its own bounding sphere. Each cluster is output as an entity with
+    /// a StaticModelComponent, and the source components are hidden.
+    ///
+    /// Only models which were loaded with their mesh data retained (see ModelResourceOptions)
+    /// can be merged. Components using any other model are left untouched.
+    ///
+    /// This is not thread-safe and must only be used on the main thread.
+    ///
+    class StaticModelBatcher final
+    {
+    public:
+        CS_DECLARE_NOCOPY(StaticModelBatcher);
+        
+        static constexpr f32 k_defaultClusterSize = 32.0f;
+        
+        /// A summary of the result of building batches. This describes the number of source
+        /// meshes which were merged, the number of merged meshes they were merged into, the
+        /// number of source meshes which couldn't be merged and the number of spatial clusters.
+        ///
+        struct Report final
+        {
+            u32 m_numMergedSourceMeshes = 0;
+            u32 m_numBatchedMeshes = 0;
+            u32 m_numRejectedSourceMeshes = 0;
+            u32 m_numClusters = 0;
+            
+            /// @return The number of draw calls saved by merging meshes.
+            ///
+            u32 GetNumDrawCallsSaved() const noexcept { return m_numMergedSourceMeshes - m_numBatchedMeshes; }
+        };
+        
+        /// Creates a new batcher with the given cluster size.
+        ///
+        /// @param clusterSize
+        ///     (Optional) The world space size of each spatial cluster. Larger clusters result in
+        ///     fewer draw calls but coarser culling.
+        ///
+        StaticModelBatcher(f32 clusterSize = k_defaultClusterSize) noexcept;
+        
+        /// Adds the given component to the batch. The component must be attached to an entity
+        /// which is in the scene, and should never move after this is called. If the component
+        /// cannot be merged it will be left untouched and will be counted in the report as rejected.
+        ///
+        /// @param component
+        ///     The component which should be merged.
+        ///
+        void Add(StaticModelComponent* component) noexcept;
+        
+        /// Adds all StaticModelComponents in the given entity and all of its descendants to the
+        /// batch.
+        ///
+        /// @param entity
+        ///     The entity.
+        ///
+        void AddRecursive(Entity* entity) noexcept;
+        
+        /// Merges all added components, creating a new Model for each spatial cluster via the
+        /// RenderMeshManager, then hides the source components. The batcher is reset, ready to
+        /// be used again, after this is called.
+        ///
+        /// @return An entity containing a child entity for each spatial cluster. This should be
+        ///     added to the scene in place of the source components.
+        ///
+        EntityUPtr Build() noexcept;
+        
+        /// @return A report describing the result of the last call to Build().
+        ///
+        const Report& GetReport() const noexcept { return m_report; }
+        
+    private:
+        /// A single mesh from a source component.
+        ///
+        struct SourceMesh final
+        {
+            StaticModelComponent* m_component;
+            u32 m_meshIndex;
+        };
+        
+        /// A group of source meshes in a cluster which share the same material and vertex format.
+        ///
+        struct MeshGroup final
+        {
+            MaterialCSPtr m_material;
+            VertexFormat m_vertexFormat;
+            std::vector<SourceMesh> m_sourceMeshes;
+        };
+        
+        using ClusterKey = std::tuple<s32, s32, s32, bool>;
+        
+        f32 m_clusterSize;
+        std::map<ClusterKey, std::vector<MeshGroup>> m_clusters;
+        std::vector<StaticModelComponent*> m_components;
+        u32 m_numRejectedSourceMeshes = 0;
+        Report m_report;
+    };
+}
+
+#endif
@@ -338,6 +338,11 @@ namespace ChilliSource
         CS_ASSERT(m_model->GetLoadState() == Resource::LoadState::k_loaded, "Cannot use a model that hasn't been loaded yet.");
         CS_ASSERT(m_model->GetNumMeshes() == m_materials.size(), "Invalid number of materials.");
         
+        if (!m_isVisible)
+        {
+            return;
+        }
+        
         for (u32 index = 0; index < m_model->GetNumMeshes(); ++index)
         {
             CS_ASSERT(m_materials[index]->GetLoadState() == Resource::LoadState::k_loaded, "Cannot use a material that hasn't been loaded yet.");
@@ -45,6 +45,7 @@ namespace ChilliSource
     namespace
     {
         const std::string k_fileExtension = "csparticle";
+        const std::string k_binaryFileExtension = "csparticlebin";
         //-----------------------------------------------------------------
         /// A delegate called when one of the asynchronous loading stages 
         /// has completed.
@@ -242,6 +243,28 @@ namespace ChilliSource
             }
         }
         //-----------------------------------------------------------------
+        /// Reads the json root of either a CSParticle json file or its
+        /// compiled binary json equivalent, depending on the extension.
+        ///
+        /// @param The storage location of the file.
+        /// @param The file path.
+        /// @param [Out] The json root.
+        ///
+        /// @return Whether or not the file could be read.
+        //-----------------------------------------------------------------
+        bool ReadCSParticleJson(StorageLocation in_storageLocation, const std::string& in_filePath, Json::Value& out_jsonRoot)
+        {
+            std::string lowerFilePath = in_filePath;
+            StringUtils::ToLowerCase(lowerFilePath);
+            
+            if (StringUtils::EndsWith(lowerFilePath, "." + k_binaryFileExtension) == true)
+            {
+                return JsonUtils::ReadBinaryJson(in_storageLocation, in_filePath, out_jsonRoot);
+            }
+            
+            return JsonUtils::ReadJson(in_storageLocation, in_filePath, out_jsonRoot);
+        }
+        //-----------------------------------------------------------------
         /// Reads the CSParticle json file and populates the particle effect.
         ///
         /// This is not thread safe and must be run on the main thread.
@@ -260,7 +283,7 @@ namespace ChilliSource
             const ParticleEmitterDefFactory* in_emitterDefFactory, const ParticleAffectorDefFactory* in_affectorDefFactory, const ParticleEffectSPtr& out_particleEffect)
         {
             Json::Value jsonRoot;
-            if (JsonUtils::ReadJson(in_storageLocation, in_filePath, jsonRoot) == false)
+            if (ReadCSParticleJson(in_storageLocation, in_filePath, jsonRoot) == false)
             {
                 out_particleEffect->SetLoadState(Resource::LoadState::k_failed);
                 return;
@@ -413,7 +436,7 @@ namespace ChilliSource
             const ParticleEffectSPtr& out_particleEffect)
         {
             Json::Value jsonRoot;
-            if (JsonUtils::ReadJson(in_storageLocation, in_filePath, jsonRoot) == false)
+            if (ReadCSParticleJson(in_storageLocation, in_filePath, jsonRoot) == false)
             {
                 out_particleEffect->SetLoadState(Resource::LoadState::k_failed);
                 Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_mainThread, [=](const TaskContext&) noexcept
@@ -467,7 +490,7 @@ namespace ChilliSource
     {
         std::string lowerExtension = in_extension;
         StringUtils::ToLowerCase(lowerExtension);
-        return (lowerExtension == k_fileExtension);
+        return (lowerExtension == k_fileExtension || lowerExtension == k_binaryFileExtension);
     }
     //-----------------------------------------------------------------
     //-----------------------------------------------------------------
@@ -36,7 +36,9 @@ namespace ChilliSource
 {
     //-------------------------------------------------------------------------
     /// A resource provider which creates Particle Effect resources from
-    /// CSParticle files.
+    /// CSParticle files. These can either be json (.csparticle) or the
+    /// compiled binary json equivalent (.csparticlebin), produced by
+    /// Tools/Scripts/compile_json.py.
     ///
     /// @author Ian Copland
     //-------------------------------------------------------------------------
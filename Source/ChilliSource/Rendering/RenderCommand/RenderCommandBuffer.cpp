@@ -50,4 +50,23 @@ namespace ChilliSource
         
         return m_renderCommandLists[slotIndex].get();
     }
-}
\ No newline at end of file
+    
+    //------------------------------------------------------------------------------
+    Matrix4* RenderCommandBuffer::AllocateWorldMatrices(u32 numWorldMatrices) noexcept
+    {
+        CS_ASSERT(numWorldMatrices > 0, "Cannot allocate zero world matrices.");
+        CS_ASSERT(numWorldMatrices <= GetMaxWorldMatrices(), "Too many world matrices requested.");
+        
+        auto worldMatrices = MakeUniqueArray<Matrix4>(*m_frameAllocator, numWorldMatrices);
+        auto output = worldMatrices.get();
+        m_worldMatrices.push_back(std::move(worldMatrices));
+        
+        return output;
+    }
+    
+    //------------------------------------------------------------------------------
+    u32 RenderCommandBuffer::GetMaxWorldMatrices() const noexcept
+    {
+        return u32(m_frameAllocator->GetMaxAllocationSize() / sizeof(Matrix4));
+    }
+}
@@ -26,6 +26,8 @@
 #define _CHILLISOURCE_RENDERING_RENDERCOMMAND_RENDERCOMMANDQUEUE_H_
 
 #include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Math/Matrix4.h>
+#include <ChilliSource/Core/Memory/UniquePtr.h>
 #include <ChilliSource/Rendering/Base/RenderFrameData.h>
 #include <ChilliSource/Rendering/Model/RenderDynamicMesh.h>
 #include <ChilliSource/Rendering/Model/RenderSkinnedAnimation.h>
@@ -83,11 +85,31 @@ namespace ChilliSource
         ///
         const std::vector<const RenderCommandList*>& GetQueue() const noexcept { return m_queue; }
         
+        /// Allocates an array of world matrices from the frame allocator which will persist
+        /// for as long as the buffer exists. This is used to store per-instance data for
+        /// instanced render commands.
+        ///
+        /// Unlike the rest of the buffer, this must not be called while other threads are
+        /// populating render command lists as the frame allocator is not thread-safe.
+        ///
+        /// @param numWorldMatrices
+        ///     The number of world matrices to allocate. Must not exceed GetMaxWorldMatrices().
+        ///
+        /// @return The allocated world matrices.
+        ///
+        Matrix4* AllocateWorldMatrices(u32 numWorldMatrices) noexcept;
+        
+        /// @return The maximum number of world matrices that can be allocated in a single call
+        ///     to AllocateWorldMatrices().
+        ///
+        u32 GetMaxWorldMatrices() const noexcept;
+        
     private:
         std::vector<RenderDynamicMeshAUPtr> m_renderDynamicMeshes;
         std::vector<RenderSkinnedAnimationAUPtr> m_renderSkinnedAnimations;
         std::vector<const RenderCommandList*> m_queue;
         std::vector<RenderCommandListUPtr> m_renderCommandLists; //TODO: This should be changed to a pool.
+        std::vector<UniquePtr<Matrix4[]>> m_worldMatrices;
         const std::vector<RenderFrameData> m_renderFramesData;
         IAllocator* m_frameAllocator;
     };
@@ -43,6 +43,7 @@
 #include <ChilliSource/Rendering/RenderCommand/Commands/LoadTextureRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/LoadCubemapRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/RenderInstanceRenderCommand.h>
+#include <ChilliSource/Rendering/RenderCommand/Commands/RenderInstancesRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/RestoreMeshRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/RestoreRenderTargetGroupCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/RestoreTextureRenderCommand.h>
@@ -253,6 +254,15 @@ namespace ChilliSource
         m_renderCommands.push_back(std::move(renderCommand));
     }
     
+    //------------------------------------------------------------------------------
+    void RenderCommandList::AddRenderInstancesCommand(const Matrix4* worldMatrices, u32 numInstances) noexcept
+    {
+        RenderCommandUPtr renderCommand(new RenderInstancesRenderCommand(worldMatrices, numInstances));
+        
+        m_orderedCommands.push_back(renderCommand.get());
+        m_renderCommands.push_back(std::move(renderCommand));
+    }
+    
     //------------------------------------------------------------------------------
     void RenderCommandList::AddEndCommand() noexcept
     {
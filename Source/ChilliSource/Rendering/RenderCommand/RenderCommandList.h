@@ -246,6 +246,16 @@ namespace ChilliSource
         ///
         void AddRenderInstanceCommand(const Matrix4& worldMatrix) noexcept;
         
+        /// Creates and adds a new render instances command to the render command list.
+        ///
+        /// @param worldMatrices
+        ///     The world matrices of each instance. This must persist until the end of the
+        ///     frame, so is typically allocated from the frame allocator.
+        /// @param numInstances
+        ///     The number of instances.
+        ///
+        void AddRenderInstancesCommand(const Matrix4* worldMatrices, u32 numInstances) noexcept;
+        
         /// Creates and adds a new end command to the render command list.
         ///
         void AddEndCommand() noexcept;
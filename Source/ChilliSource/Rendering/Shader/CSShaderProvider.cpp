@@ -221,14 +221,14 @@ namespace ChilliSource
     }
     
     //------------------------------------------------------------------------------
-    void CSShaderProvider::CreateResourceFromFile(StorageLocation location, const std::string& filePath, const IResourceOptionsBaseCSPtr& options, const ResourceSPtr& resource) noexcept
+    void CSShaderProvider::CreateResourceFromFile(StorageLocation location, const std::string& filePath, const IResourceOptionsBaseCSPtr&, const ResourceSPtr& resource) noexcept
     {
         ShaderSPtr shaderResource = std::static_pointer_cast<Shader>(resource);
         LoadShader(location, filePath, nullptr, shaderResource);
     }
     
     //------------------------------------------------------------------------------
-    void CSShaderProvider::CreateResourceFromFileAsync(StorageLocation location, const std::string& filePath, const IResourceOptionsBaseCSPtr& options, const ResourceProvider::AsyncLoadDelegate& delegate, const ResourceSPtr& resource) noexcept
+    void CSShaderProvider::CreateResourceFromFileAsync(StorageLocation location, const std::string& filePath, const IResourceOptionsBaseCSPtr&, const ResourceProvider::AsyncLoadDelegate& delegate, const ResourceSPtr& resource) noexcept
     {
         ShaderSPtr shaderResource = std::static_pointer_cast<Shader>(resource);
         LoadShader(location, filePath, delegate, shaderResource);
@@ -82,7 +82,7 @@ namespace ChilliSource
     }
     
     //------------------------------------------------------------------------------
-    void RenderShaderManager::OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) noexcept
+    void RenderShaderManager::OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator*) noexcept
     {
         if(targetType == TargetType::k_main)
         {
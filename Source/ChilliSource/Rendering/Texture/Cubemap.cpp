@@ -55,6 +55,13 @@ namespace ChilliSource
         
         m_restoreTextureDataEnabled = textureDesc.IsRestoreTextureDataEnabled();
         
+        //The data size is per face. Mipmaps generated by the render system add a third on top of the base level.
+        m_memoryUsage = u64(dataSize) * 6;
+        if (textureDesc.IsMipmappingEnabled() && textureDesc.GetImageCompression() == ImageCompression::k_none)
+        {
+            m_memoryUsage += m_memoryUsage / 3;
+        }
+        
         m_renderTexture = renderTextureManager->CreateCubemap(std::move(textureData), dataSize, textureDesc.GetDimensions(), textureDesc.GetImageFormat(), textureDesc.GetImageCompression(),
                                                               textureDesc.GetFilterMode(), textureDesc.GetWrapModeS(), textureDesc.GetWrapModeT(), textureDesc.IsMipmappingEnabled(), m_restoreTextureDataEnabled);
     }
@@ -140,6 +147,12 @@ namespace ChilliSource
         return m_renderTexture;
     }
     
+    //------------------------------------------------------------------------------
+    u64 Cubemap::GetMemoryUsage() const noexcept
+    {
+        return m_memoryUsage;
+    }
+    
     //------------------------------------------------------------------------------
     void Cubemap::DestroyRenderTexture() noexcept
     {
@@ -150,6 +163,7 @@ namespace ChilliSource
             
             renderTextureManager->DestroyRenderTexture(m_renderTexture);
             m_renderTexture = nullptr;
+            m_memoryUsage = 0;
         }
     }
     
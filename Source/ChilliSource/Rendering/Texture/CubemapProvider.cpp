@@ -140,7 +140,7 @@ namespace ChilliSource
         //Load the actual images
         std::array<ImageSPtr, 6> images;
         
-        for(auto i=0; i<imagePaths.size(); ++i)
+        for(u32 i=0; i<imagePaths.size(); ++i)
         {
             std::string fileName;
             std::string fileExtension;
@@ -191,7 +191,7 @@ namespace ChilliSource
             auto options = static_cast<const CubemapResourceOptions*>(in_options.get());
             
             std::array<std::unique_ptr<const u8[]>, 6> textureData;
-            for(auto i=0; i<images.size(); ++i)
+            for(u32 i=0; i<images.size(); ++i)
             {
                 textureData[i] = std::move(images[i]->MoveData());
             }
@@ -213,7 +213,7 @@ namespace ChilliSource
                  auto options = static_cast<const CubemapResourceOptions*>(in_options.get());
                  
                  std::array<std::unique_ptr<const u8[]>, 6> textureData;
-                 for(auto i=0; i<images.size(); ++i)
+                 for(u32 i=0; i<images.size(); ++i)
                  {
                      textureData[i] = std::move(images[i]->MoveData());
                  }
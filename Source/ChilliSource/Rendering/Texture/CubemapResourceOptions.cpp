@@ -41,7 +41,9 @@ namespace ChilliSource
     //-------------------------------------------------------
     u32 CubemapResourceOptions::GenerateHash() const
     {
-        return HashCRC32::GenerateHashCode((const s8*)&m_options, sizeof(Options));
+        //The fields are hashed individually as the padding in Options is uninitialised.
+        const u32 fields[] = { u32(m_options.m_wrapModeS), u32(m_options.m_wrapModeT), u32(m_options.m_filterMode), u32(m_options.m_hasMipMaps) };
+        return HashCRC32::GenerateHashCode((const s8*)fields, sizeof(fields));
     }
     //-------------------------------------------------------
     //-------------------------------------------------------
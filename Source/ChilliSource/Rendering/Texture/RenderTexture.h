@@ -32,6 +32,8 @@
 #include <ChilliSource/Rendering/Texture/TextureFilterMode.h>
 #include <ChilliSource/Rendering/Texture/TextureWrapMode.h>
 
+#include <atomic>
+
 namespace ChilliSource
 {
     /// A standard-layout container for all information needed by the renderer pertaining
@@ -41,7 +43,8 @@ namespace ChilliSource
     /// data.
     ///
     /// This is immutable and therefore thread-safe, aside from the extra data pointer
-    /// which should only be accessed on the render thread.
+    /// which should only be accessed on the render thread, and the atomic rendered
+    /// flag.
     ///
     class RenderTexture final
     {
@@ -93,6 +96,16 @@ namespace ChilliSource
         ///
         void SetExtraData(void* extraData) noexcept { m_extraData = extraData; }
         
+        /// @return Whether or not the texture has been used by a material in a compiled render
+        ///     command list since it was created. This can be called from any thread.
+        ///
+        bool HasBeenRendered() const noexcept { return m_hasBeenRendered.load(std::memory_order_relaxed); }
+        
+        /// Flags that the texture has been used by a material in a compiled render command list.
+        /// This can be called from any thread.
+        ///
+        void SetRendered() const noexcept { m_hasBeenRendered.store(true, std::memory_order_relaxed); }
+        
     private:
         friend class RenderTextureManager;
         
@@ -126,6 +139,7 @@ namespace ChilliSource
         bool m_isMipmapped;
         bool m_shouldBackupData = true;
         void* m_extraData = nullptr;
+        mutable std::atomic<bool> m_hasBeenRendered { false };
     };
 }
 
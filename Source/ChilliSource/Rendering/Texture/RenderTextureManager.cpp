@@ -114,7 +114,7 @@ namespace ChilliSource
     }
     
     //------------------------------------------------------------------------------
-    void RenderTextureManager::OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) noexcept
+    void RenderTextureManager::OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator*) noexcept
     {
         if(targetType == TargetType::k_main)
         {
@@ -55,6 +55,13 @@ namespace ChilliSource
         
         m_restoreTextureDataEnabled = textureDesc.IsRestoreTextureDataEnabled();
         
+        //Mipmaps generated by the render system add a third on top of the base level.
+        m_memoryUsage = textureDataSize;
+        if (textureDesc.IsMipmappingEnabled() && textureDesc.GetImageCompression() == ImageCompression::k_none)
+        {
+            m_memoryUsage += textureDataSize / 3;
+        }
+        
         m_renderTexture = renderTextureManager->CreateTexture2D(std::move(textureData), textureDataSize, textureDesc.GetDimensions(), textureDesc.GetImageFormat(), textureDesc.GetImageCompression(),
                                                                     textureDesc.GetFilterMode(), textureDesc.GetWrapModeS(), textureDesc.GetWrapModeT(), textureDesc.IsMipmappingEnabled(), m_restoreTextureDataEnabled);
     }
@@ -140,6 +147,12 @@ namespace ChilliSource
         return m_renderTexture;
     }
     
+    //------------------------------------------------------------------------------
+    u64 Texture::GetMemoryUsage() const noexcept
+    {
+        return m_memoryUsage;
+    }
+    
     //------------------------------------------------------------------------------
     void Texture::DestroyRenderTexture() noexcept
     {
@@ -150,6 +163,7 @@ namespace ChilliSource
             
             renderTextureManager->DestroyRenderTexture(m_renderTexture);
             m_renderTexture = nullptr;
+            m_memoryUsage = 0;
         }
     }
     
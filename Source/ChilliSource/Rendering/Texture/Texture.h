@@ -105,6 +105,11 @@ namespace ChilliSource
         ///
         const RenderTexture* GetRenderTexture() const noexcept;
         
+        /// @return An estimate of the memory used by the texture in bytes, including any mipmaps
+        ///     generated by the render system.
+        ///
+        u64 GetMemoryUsage() const noexcept override;
+        
         ~Texture() noexcept;
         
     private:
@@ -125,6 +130,7 @@ namespace ChilliSource
         
         const RenderTexture* m_renderTexture = nullptr;
         bool m_restoreTextureDataEnabled = false;
+        u64 m_memoryUsage = 0;
     };
 }
 
@@ -31,12 +31,106 @@
 #include <ChilliSource/Core/Base/Application.h>
 #include <ChilliSource/Core/Image/Image.h>
 #include <ChilliSource/Core/Threading/TaskScheduler.h>
+#include <ChilliSource/Rendering/Texture/RenderTexture.h>
 #include <ChilliSource/Rendering/Texture/Texture.h>
 #include <ChilliSource/Rendering/Texture/TextureDesc.h>
 #include <ChilliSource/Rendering/Texture/TextureResourceOptions.h>
 
+#include <algorithm>
+
 namespace ChilliSource
 {
+    namespace
+    {
+        //----------------------------------------------------------------------------
+        /// Halves the dimensions of the image the given number of times using a box
+        /// filter. Only uncompressed images with 8-bit channels are supported.
+        ///
+        /// @param The image to downsample.
+        /// @param The number of mip levels to drop.
+        ///
+        /// @return Whether or not the image was downsampled.
+        //----------------------------------------------------------------------------
+        bool DownsampleImage(Image* in_image, u32 in_numLevels)
+        {
+            if(in_numLevels == 0 || in_image->GetCompression() != ImageCompression::k_none)
+            {
+                return false;
+            }
+            
+            u32 bytesPerPixel = 0;
+            switch(in_image->GetFormat())
+            {
+                case ImageFormat::k_RGBA8888:
+                    bytesPerPixel = 4;
+                    break;
+                case ImageFormat::k_RGB888:
+                    bytesPerPixel = 3;
+                    break;
+                case ImageFormat::k_LumA88:
+                    bytesPerPixel = 2;
+                    break;
+                case ImageFormat::k_Lum8:
+                    bytesPerPixel = 1;
+                    break;
+                default:
+                    return false;
+            }
+            
+            u32 width = in_image->GetWidth();
+            u32 height = in_image->GetHeight();
+            const u8* source = in_image->GetData();
+            Image::ImageDataUPtr data;
+            
+            u32 numLevels = 0;
+            for(; numLevels < in_numLevels && (width > 1 || height > 1); ++numLevels)
+            {
+                u32 newWidth = std::max(width / 2, 1u);
+                u32 newHeight = std::max(height / 2, 1u);
+                Image::ImageDataUPtr newData(new u8[newWidth * newHeight * bytesPerPixel]);
+                
+                u8* destination = newData.get();
+                for(u32 y = 0; y < newHeight; ++y)
+                {
+                    const u8* row0 = source + std::min(y * 2, height - 1) * width * bytesPerPixel;
+                    const u8* row1 = source + std::min(y * 2 + 1, height - 1) * width * bytesPerPixel;
+                    
+                    for(u32 x = 0; x < newWidth; ++x)
+                    {
+                        u32 column0 = std::min(x * 2, width - 1) * bytesPerPixel;
+                        u32 column1 = std::min(x * 2 + 1, width - 1) * bytesPerPixel;
+                        
+                        for(u32 channel = 0; channel < bytesPerPixel; ++channel)
+                        {
+                            u32 sum = row0[column0 + channel] + row0[column1 + channel] + row1[column0 + channel] + row1[column1 + channel];
+                            *destination++ = u8((sum + 2) / 4);
+                        }
+                    }
+                }
+                
+                data = std::move(newData);
+                source = data.get();
+                width = newWidth;
+                height = newHeight;
+            }
+            
+            if(numLevels == 0)
+            {
+                return false;
+            }
+            
+            Image::Descriptor desc;
+            desc.m_width = width;
+            desc.m_height = height;
+            desc.m_dataSize = width * height * bytesPerPixel;
+            desc.m_compression = in_image->GetCompression();
+            desc.m_format = in_image->GetFormat();
+            in_image->Build(desc, std::move(data));
+            
+            return true;
+        }
+    }
+    
     CS_DEFINE_NAMEDTYPE(TextureProvider);
     
     const IResourceOptionsBaseCSPtr TextureProvider::s_defaultOptions(std::make_shared<TextureResourceOptions>());
@@ -110,10 +204,33 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------------------
     //----------------------------------------------------------------------------
-    void TextureProvider::LoadTexture(StorageLocation in_location, const std::string& in_filePath, const IResourceOptionsBaseCSPtr& in_options, const ResourceProvider::AsyncLoadDelegate& in_delegate, const ResourceSPtr& out_resource)
+    void TextureProvider::OnUpdate(f32)
+    {
+        for(auto it = m_streamedTextures.begin(); it != m_streamedTextures.end(); /*NO INCREMENT*/)
+        {
+            ResourceSPtr resource = it->m_texture.lock();
+            if(resource == nullptr)
+            {
+                it = m_streamedTextures.erase(it);
+                continue;
+            }
+            
+            auto texture = static_cast<const Texture*>(resource.get());
+            if(texture->GetLoadState() == Resource::LoadState::k_loaded && texture->GetRenderTexture()->HasBeenRendered() == true)
+            {
+                LoadFullResolutionTexture(*it);
+                it = m_streamedTextures.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    ImageSPtr TextureProvider::LoadImage(StorageLocation in_location, const std::string& in_filePath) const
     {
-        CS_ASSERT(in_options != nullptr, "Options for texture load cannot be null");
-        
         std::string fileName;
         std::string fileExtension;
         StringUtils::SplitBaseFilename(in_filePath, fileName, fileExtension);
@@ -131,24 +248,92 @@ namespace ChilliSource
         if(imageProvider == nullptr)
         {
             CS_LOG_ERROR("Cannot find provider for " + in_filePath);
-            out_resource->SetLoadState(Resource::LoadState::k_failed);
-            if(in_delegate != nullptr)
-            {
-                Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_mainThread, [=](const TaskContext&) noexcept
-                {
-                    in_delegate(out_resource);
-                });
-            }
-            return;
+            return nullptr;
         }
         
         ResourceSPtr imageResource(Image::Create());
         imageProvider->CreateResourceFromFile(in_location, in_filePath, nullptr, imageResource);
-        ImageSPtr image(std::static_pointer_cast<Image>(imageResource));
         
-        if(image->GetLoadState() == Resource::LoadState::k_failed)
+        if(imageResource->GetLoadState() == Resource::LoadState::k_failed)
         {
             CS_LOG_ERROR("Failed to load image " + in_filePath);
+            return nullptr;
+        }
+        
+        return std::static_pointer_cast<Image>(imageResource);
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    void TextureProvider::AddStreamedTexture(const ResourceSPtr& in_texture, StorageLocation in_location, const std::string& in_filePath, const IResourceOptionsBaseCSPtr& in_options)
+    {
+        CS_ASSERT(Application::Get()->GetTaskScheduler()->IsMainThread() == true, "Streamed textures must be added on the main thread.");
+        
+        for(const auto& streamedTexture : m_streamedTextures)
+        {
+            if(streamedTexture.m_texture.lock() == in_texture)
+            {
+                return;
+            }
+        }
+        
+        StreamedTexture streamedTexture;
+        streamedTexture.m_texture = in_texture;
+        streamedTexture.m_location = in_location;
+        streamedTexture.m_filePath = in_filePath;
+        streamedTexture.m_options = in_options;
+        m_streamedTextures.push_back(streamedTexture);
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    void TextureProvider::BuildTexture(Texture* in_texture, Image* in_image, const TextureResourceOptions* in_options) const
+    {
+        TextureDesc desc(Integer2(in_image->GetWidth(), in_image->GetHeight()), in_image->GetFormat(), in_image->GetCompression(), false);
+        desc.SetFilterMode(in_options->GetFilterMode());
+        desc.SetWrapModeS(in_options->GetWrapModeS());
+        desc.SetWrapModeT(in_options->GetWrapModeT());
+        desc.SetMipmappingEnabled(in_options->IsMipMapsEnabled());
+        
+        in_texture->Build(Texture::DataUPtr(in_image->MoveData()), in_image->GetDataSize(), desc);
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    void TextureProvider::LoadFullResolutionTexture(const StreamedTexture& in_streamedTexture)
+    {
+        std::weak_ptr<Resource> weakTexture = in_streamedTexture.m_texture;
+        StorageLocation location = in_streamedTexture.m_location;
+        std::string filePath = in_streamedTexture.m_filePath;
+        IResourceOptionsBaseCSPtr options = in_streamedTexture.m_options;
+        
+        Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_file, [=](const TaskContext&) noexcept
+        {
+            ImageSPtr image = LoadImage(location, filePath);
+            if(image == nullptr)
+            {
+                return;
+            }
+            
+            Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_mainThread, [=](const TaskContext&) noexcept
+            {
+                //The texture may have been released or reloaded while the image was loading.
+                ResourceSPtr resource = weakTexture.lock();
+                if(resource == nullptr || resource->GetLoadState() != Resource::LoadState::k_loaded)
+                {
+                    return;
+                }
+                
+                BuildTexture(static_cast<Texture*>(resource.get()), image.get(), static_cast<const TextureResourceOptions*>(options.get()));
+            });
+        });
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    void TextureProvider::LoadTexture(StorageLocation in_location, const std::string& in_filePath, const IResourceOptionsBaseCSPtr& in_options, const ResourceProvider::AsyncLoadDelegate& in_delegate, const ResourceSPtr& out_resource)
+    {
+        CS_ASSERT(in_options != nullptr, "Options for texture load cannot be null");
+        
+        ImageSPtr image = LoadImage(in_location, in_filePath);
+        if(image == nullptr)
+        {
             out_resource->SetLoadState(Resource::LoadState::k_failed);
             if(in_delegate != nullptr)
             {
@@ -160,38 +345,33 @@ namespace ChilliSource
             return;
         }
         
+        auto options = static_cast<const TextureResourceOptions*>(in_options.get());
+        bool isStreamed = DownsampleImage(image.get(), options->GetStreamedMipLevels());
+        
         if(in_delegate == nullptr)
         {
-            auto texture = static_cast<Texture*>(out_resource.get());
-            auto options = static_cast<const TextureResourceOptions*>(in_options.get());
+            BuildTexture(static_cast<Texture*>(out_resource.get()), image.get(), options);
+            out_resource->SetLoadState(Resource::LoadState::k_loaded);
             
-            TextureDesc desc(Integer2(image->GetWidth(), image->GetHeight()), image->GetFormat(), image->GetCompression(), false);
-            desc.SetFilterMode(options->GetFilterMode());
-            desc.SetWrapModeS(options->GetWrapModeS());
-            desc.SetWrapModeT(options->GetWrapModeT());
-            desc.SetMipmappingEnabled(options->IsMipMapsEnabled());
-
-            texture->Build(Texture::DataUPtr(image->MoveData()), image->GetDataSize(), desc);
-            texture->SetLoadState(Resource::LoadState::k_loaded);
+            if(isStreamed == true)
+            {
+                AddStreamedTexture(out_resource, in_location, in_filePath, in_options);
+            }
         }
         else
         {
             Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_mainThread, [=](const TaskContext&) noexcept
             {
-                auto texture = static_cast<Texture*>(out_resource.get());
-                auto options = static_cast<const TextureResourceOptions*>(in_options.get());
-
-                TextureDesc desc(Integer2(image->GetWidth(), image->GetHeight()), image->GetFormat(), image->GetCompression(), false);
-                desc.SetFilterMode(options->GetFilterMode());
-                desc.SetWrapModeS(options->GetWrapModeS());
-                desc.SetWrapModeT(options->GetWrapModeT());
-                desc.SetMipmappingEnabled(options->IsMipMapsEnabled());
-
-                texture->Build(Texture::DataUPtr(image->MoveData()), image->GetDataSize(), desc);
-                texture->SetLoadState(Resource::LoadState::k_loaded);
+                BuildTexture(static_cast<Texture*>(out_resource.get()), image.get(), static_cast<const TextureResourceOptions*>(in_options.get()));
+                out_resource->SetLoadState(Resource::LoadState::k_loaded);
+                
+                if(isStreamed == true)
+                {
+                    AddStreamedTexture(out_resource, in_location, in_filePath, in_options);
+                }
+                
                 in_delegate(out_resource);
             });
         }
     }
 }
-
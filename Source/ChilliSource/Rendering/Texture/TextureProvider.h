@@ -107,6 +107,13 @@ namespace ChilliSource
         /// @retrun Default options for texture loading
         //----------------------------------------------------
         IResourceOptionsBaseCSPtr GetDefaultOptions() const override;
+        //----------------------------------------------------------------------------
+        /// Checks whether any textures that were loaded at reduced resolution have
+        /// been rendered and, if so, reloads them at full resolution.
+        ///
+        /// @param Time since last update in seconds
+        //----------------------------------------------------------------------------
+        void OnUpdate(f32 in_deltaTime) override;
         
     private:
         friend class Application;
@@ -125,6 +132,53 @@ namespace ChilliSource
         //----------------------------------------------------------------------------
         TextureProvider() = default;
         //----------------------------------------------------------------------------
+        /// A texture which was loaded at reduced resolution and is waiting to be
+        /// rendered before it is reloaded at full resolution.
+        //----------------------------------------------------------------------------
+        struct StreamedTexture
+        {
+            std::weak_ptr<Resource> m_texture;
+            StorageLocation m_location;
+            std::string m_filePath;
+            IResourceOptionsBaseCSPtr m_options;
+        };
+        //----------------------------------------------------------------------------
+        /// Loads an image using the image provider that supports its file extension.
+        /// This can be called from any thread.
+        ///
+        /// @param Location to load from
+        /// @param File path
+        ///
+        /// @return The loaded image, or null if it failed to load.
+        //----------------------------------------------------------------------------
+        ImageSPtr LoadImage(StorageLocation in_location, const std::string& in_filePath) const;
+        //----------------------------------------------------------------------------
+        /// Starts tracking a texture that was loaded at reduced resolution. Must be
+        /// called on the main thread.
+        ///
+        /// @param The texture.
+        /// @param Location the texture was loaded from
+        /// @param File path
+        /// @param Options the texture was loaded with
+        //----------------------------------------------------------------------------
+        void AddStreamedTexture(const ResourceSPtr& in_texture, StorageLocation in_location, const std::string& in_filePath, const IResourceOptionsBaseCSPtr& in_options);
+        //----------------------------------------------------------------------------
+        /// Builds the texture from the given image. This must be called on the main
+        /// thread.
+        ///
+        /// @param The texture to build.
+        /// @param The image. Its data is moved into the texture.
+        /// @param The texture options.
+        //----------------------------------------------------------------------------
+        void BuildTexture(Texture* in_texture, Image* in_image, const TextureResourceOptions* in_options) const;
+        //----------------------------------------------------------------------------
+        /// Reloads the image for a streamed texture on a background thread and
+        /// rebuilds the texture at full resolution on the main thread.
+        ///
+        /// @param The streamed texture.
+        //----------------------------------------------------------------------------
+        void LoadFullResolutionTexture(const StreamedTexture& in_streamedTexture);
+        //----------------------------------------------------------------------------
         /// Does the heavy lifting for the 2 create methods. The building of the texture
         /// is always done on the main thread
         ///
@@ -141,6 +195,7 @@ namespace ChilliSource
     private:
         
         std::vector<ResourceProvider*> m_imageProviders;
+        std::vector<StreamedTexture> m_streamedTextures;
         static const IResourceOptionsBaseCSPtr s_defaultOptions;
     };
 }
@@ -43,9 +43,18 @@ namespace ChilliSource
     }
     //-------------------------------------------------------
     //-------------------------------------------------------
+    TextureResourceOptions::TextureResourceOptions(bool in_mipmaps, TextureFilterMode in_filter, TextureWrapMode in_wrapS, TextureWrapMode in_wrapT, u32 in_streamedMipLevels)
+    : TextureResourceOptions(in_mipmaps, in_filter, in_wrapS, in_wrapT)
+    {
+        m_options.m_streamedMipLevels = in_streamedMipLevels;
+    }
+    //-------------------------------------------------------
+    //-------------------------------------------------------
     u32 TextureResourceOptions::GenerateHash() const
     {
-        return HashCRC32::GenerateHashCode((const s8*)&m_options, sizeof(Options));
+        //The fields are hashed individually as the padding in Options is uninitialised.
+        const u32 fields[] = { u32(m_options.m_wrapModeS), u32(m_options.m_wrapModeT), u32(m_options.m_filterMode), m_options.m_streamedMipLevels, u32(m_options.m_hasMipMaps) };
+        return HashCRC32::GenerateHashCode((const s8*)fields, sizeof(fields));
     }
     //-------------------------------------------------------
     //-------------------------------------------------------
@@ -71,5 +80,11 @@ namespace ChilliSource
     {
         return m_options.m_filterMode;
     }
+    //-------------------------------------------------------
+    //-------------------------------------------------------
+    u32 TextureResourceOptions::GetStreamedMipLevels() const
+    {
+        return m_options.m_streamedMipLevels;
+    }
 }
 
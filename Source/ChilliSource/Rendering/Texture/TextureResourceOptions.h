@@ -72,6 +72,19 @@ namespace ChilliSource
         /// and RGB565 textures.
         //-------------------------------------------------------
         TextureResourceOptions(bool in_mipmaps, TextureFilterMode in_filter, TextureWrapMode in_wrapS, TextureWrapMode in_wrapT);
+        /// Constructor
+        ///
+        /// @param MipMaps enabled
+        /// @param Filter mode
+        /// @param Wrap mode S
+        /// @param Wrap mode T
+        /// @param The number of mip levels to drop when the texture is
+        /// first loaded, halving the dimensions for each level. The
+        /// texture is reloaded at full resolution the first time it
+        /// is rendered. This only applies to uncompressed RGBA8888,
+        /// RGB888, LumA88 and Lum8 textures; others are always
+        /// loaded at full resolution.
+        TextureResourceOptions(bool in_mipmaps, TextureFilterMode in_filter, TextureWrapMode in_wrapS, TextureWrapMode in_wrapT, u32 in_streamedMipLevels);
         //-------------------------------------------------------
         /// Generate a unique hash based on the
         /// currently set options
@@ -106,6 +119,10 @@ namespace ChilliSource
         /// @return Filter mode to create texture with
         //-------------------------------------------------------
         TextureFilterMode GetFilterMode() const;
+        /// @return The number of mip levels dropped when the
+        /// texture is first loaded. Zero if the texture is loaded
+        /// at full resolution.
+        u32 GetStreamedMipLevels() const;
         
     private:
         
@@ -120,6 +137,7 @@ namespace ChilliSource
             TextureWrapMode m_wrapModeS = TextureWrapMode::k_clamp;
             TextureWrapMode m_wrapModeT = TextureWrapMode::k_clamp;
             TextureFilterMode m_filterMode = TextureFilterMode::k_bilinear;
+            u32 m_streamedMipLevels = 0;
             bool m_hasMipMaps = false;
         };
         
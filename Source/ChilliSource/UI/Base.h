@@ -42,5 +42,6 @@
 #include <ChilliSource/UI/Base/WidgetTemplate.h>
 #include <ChilliSource/UI/Base/WidgetTemplateProvider.h>
 #include <ChilliSource/UI/Base/WidgetFactory.h>
+#include <ChilliSource/UI/Base/WidgetPool.h>
 
 #endif
\ No newline at end of file
@@ -35,6 +35,7 @@
 #include <ChilliSource/Core/Math/Vector4.h>
 #include <ChilliSource/Core/String/StringUtils.h>
 #include <ChilliSource/UI/Base/PropertyTypes.h>
+#include <ChilliSource/UI/Base/Widget.h>
 
 namespace ChilliSource
 {
@@ -87,12 +88,18 @@ namespace ChilliSource
         
         m_propertyRegistrationComplete = true;
         
-        for (const auto& key : in_properties.GetKeys())
+        in_properties.ForEachValue([this](const std::string& in_name, const IProperty* in_property)
         {
-            if (in_properties.HasValue(key) == true)
-            {
-                SetProperty(key, in_properties.GetPropertyObject(key));
-            }
+            SetProperty(in_name, in_property);
+        });
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void UIComponent::InvalidateDrawList()
+    {
+        if (m_widget != nullptr)
+        {
+            m_widget->InvalidateDrawList();
         }
     }
     //----------------------------------------------------------------
@@ -121,4 +128,22 @@ namespace ChilliSource
         
         it->second->Set(in_property);
     }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    IProperty* UIComponent::GetPropertyObject(const std::string& in_propertyName)
+    {
+        CS_ASSERT(m_propertyRegistrationComplete == true, "Cannot get a property on a UIComponent prior to property registration completion.");
+        
+        std::string lowerPropertyName = in_propertyName;
+        StringUtils::ToLowerCase(lowerPropertyName);
+        
+        auto it = m_properties.find(lowerPropertyName);
+        if(it == m_properties.end())
+        {
+            CS_LOG_FATAL("Cannot find property with name '" + in_propertyName + "' in UIComponent.");
+            return nullptr;
+        }
+        
+        return it->second.get();
+    }
 }
\ No newline at end of file
@@ -123,6 +123,23 @@ namespace ChilliSource
         //----------------------------------------------------------------
         void SetProperty(const std::string& in_propertyName, const char* in_propertyValue);
         //----------------------------------------------------------------
+        /// Resolves the property with the given name to a handle which can
+        /// be used to repeatedly get and set the property without the
+        /// string processing and lookups performed by GetProperty() and
+        /// SetProperty(). This should be preferred when a property is
+        /// accessed frequently, for example by tweens or data bindings.
+        ///
+        /// If there is no property with the given name or it is not of
+        /// the requested type the app is considered to be in an
+        /// irrecoverable state and will terminate.
+        ///
+        /// @param The name of the property. This is case insensitive.
+        ///
+        /// @return The property handle. This remains valid for the
+        /// lifetime of the component.
+        //----------------------------------------------------------------
+        template <typename TPropertyType> Property<TPropertyType>* GetPropertyHandle(const std::string& in_propertyName);
+        //----------------------------------------------------------------
         /// Destructor
         ///
         /// @author Ian Copland
@@ -171,6 +188,15 @@ namespace ChilliSource
         //----------------------------------------------------------------
         void ApplyRegisteredProperties(const PropertyMap& in_properties);
         //----------------------------------------------------------------
+        /// Flags the draw list of the owning widget as out of date. This
+        /// must be called whenever any state which affects how the
+        /// component draws changes, otherwise a widget which retains its
+        /// draw list will continue to render the previously recorded one.
+        /// See Widget::SetDrawListRetained(). This does nothing if the
+        /// component has not yet been added to a widget.
+        //----------------------------------------------------------------
+        void InvalidateDrawList();
+        //----------------------------------------------------------------
         /// A method which is called when all components owned by the parent
         /// widget have been created and added. Inheriting classes should use
         /// this for any required initialisation.
@@ -212,7 +238,7 @@ namespace ChilliSource
         ///
         /// @param The delta time since the last update.
         //----------------------------------------------------------------
-        virtual void OnUpdate(f32 in_deltaTime) {}
+        virtual void OnUpdate(f32) {}
         //----------------------------------------------------------------
         /// This is called during the draw event whenever the application
         /// is active and the owning widget in on the canvas. This should
@@ -225,19 +251,19 @@ namespace ChilliSource
         /// @param The final screen space size.
         /// @param The final colour.
         //----------------------------------------------------------------
-        virtual void OnDraw(CanvasRenderer* in_renderer, const Matrix3& in_transform, const Vector2& in_absSize, const Colour& in_absColour) {}
+        virtual void OnDraw(CanvasRenderer*, const Matrix3&, const Vector2&, const Colour&) {}
         //----------------------------------------------------------------
         /// Called prior to the widget drawing its children
         ///
         /// @param The canvas renderer.
         //----------------------------------------------------------------
-        virtual void OnPreDrawChildren(CanvasRenderer* in_renderer) {}
+        virtual void OnPreDrawChildren(CanvasRenderer*) {}
         //----------------------------------------------------------------
         /// Called after the widget draws its children
         ///
         /// @param The canvas renderer.
         //----------------------------------------------------------------
-        virtual void OnPostDrawChildren(CanvasRenderer* in_renderer) {}
+        virtual void OnPostDrawChildren(CanvasRenderer*) {}
         //----------------------------------------------------------------
         /// This is called when the application is backgrounded while the
         /// owning widget is on the canvas. This will also be called when
@@ -294,6 +320,15 @@ namespace ChilliSource
         /// @param The property used to set the value.
         //----------------------------------------------------------------
         void SetProperty(const std::string& in_propertyName, const IProperty* in_property);
+        //----------------------------------------------------------------
+        /// If there is no property with the given name the app will be
+        /// considered to be in an irrecoverable state and will terminate.
+        ///
+        /// @param The property name. This is case insensitive.
+        ///
+        /// @return The property with the given name.
+        //----------------------------------------------------------------
+        IProperty* GetPropertyObject(const std::string& in_propertyName);
 
         bool m_propertyRegistrationComplete = false;
         std::unordered_map<std::string, IPropertyUPtr> m_properties;
@@ -338,6 +373,12 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
+    template <typename TPropertyType> Property<TPropertyType>* UIComponent::GetPropertyHandle(const std::string& in_propertyName)
+    {
+        return CS_SMARTCAST(Property<TPropertyType>*, GetPropertyObject(in_propertyName), "Incorrect type for property with name: " + in_propertyName);
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
     template <typename TPropertyType> void UIComponent::RegisterProperty(const PropertyType<TPropertyType>* in_propertyType, const std::string& in_name, std::function<TPropertyType()>&& in_getter, std::function<void(TPropertyType)>&& in_setter)
     {
         CS_ASSERT(m_propertyRegistrationComplete == false, "UIComponent properties cannot be registered after property registration completion.");
@@ -61,6 +61,11 @@ namespace ChilliSource
         const char k_properyNameInputEnabled[] = "inputenabled";
         const char k_properyNameInputConsumeEnabled[] = "inputconsumeenabled";
         const char k_properyNameSizePolicy[] = "sizepolicy";
+        const char k_properyNameRetainDrawList[] = "retaindrawlist";
+        
+        //The distance the input bounds of each widget are expanded by, ensuring floating point error
+        //can never cause a pointer to be ignored by a widget which contains it.
+        const f32 k_inputBoundsTolerance = 1.0f;
         
         const std::vector<PropertyMap::PropertyDesc> k_propertyDescs =
         {
@@ -79,6 +84,7 @@ namespace ChilliSource
             {PropertyTypes::Bool(), k_properyNameInputEnabled},
             {PropertyTypes::Bool(), k_properyNameInputConsumeEnabled},
             {PropertyTypes::SizePolicy(), k_properyNameSizePolicy},
+            {PropertyTypes::Bool(), k_properyNameRetainDrawList},
         };
         
         //----------------------------------------------------------------------------------------
@@ -122,7 +128,7 @@ namespace ChilliSource
             ///
             /// @return Original size
             //----------------------------------------------------------
-            Vector2 UseOriginalSize(const Vector2& in_originalSize, const Vector2& in_preferredSize)
+            Vector2 UseOriginalSize(const Vector2& in_originalSize, const Vector2&)
             {
                 return in_originalSize;
             }
@@ -138,7 +144,7 @@ namespace ChilliSource
             ///
             /// @return Preferred size
             //----------------------------------------------------------
-            Vector2 UsePreferredSize(const Vector2& in_originalSize, const Vector2& in_preferredSize)
+            Vector2 UsePreferredSize(const Vector2&, const Vector2& in_preferredSize)
             {
                 return in_preferredSize;
             }
@@ -263,6 +269,7 @@ namespace ChilliSource
         m_baseProperties.emplace(k_properyNameInputEnabled, PropertyTypes::Bool()->CreateProperty(MakeDelegate(this, &Widget::IsInputEnabled), MakeDelegate(this, &Widget::SetInputEnabled)));
         m_baseProperties.emplace(k_properyNameInputConsumeEnabled, PropertyTypes::Bool()->CreateProperty(MakeDelegate(this, &Widget::IsInputConsumeEnabled), MakeDelegate(this, &Widget::SetInputConsumeEnabled)));
         m_baseProperties.emplace(k_properyNameSizePolicy, PropertyTypes::SizePolicy()->CreateProperty(MakeDelegate(this, &Widget::GetSizePolicy), MakeDelegate(this, &Widget::SetSizePolicy)));
+        m_baseProperties.emplace(k_properyNameRetainDrawList, PropertyTypes::Bool()->CreateProperty(MakeDelegate(this, &Widget::IsDrawListRetained), MakeDelegate(this, &Widget::SetDrawListRetained)));
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
@@ -301,6 +308,9 @@ namespace ChilliSource
             m_internalChildren.push_back(std::move(widget));
             widgetRaw->m_parent = this;
             
+            OffsetNumTrackingWidgets(s32(widgetRaw->m_numTrackingWidgets));
+            InvalidateInputBounds();
+            
             if (m_canvas != nullptr)
             {
                 widgetRaw->SetCanvas(m_canvas);
@@ -349,13 +359,10 @@ namespace ChilliSource
     //----------------------------------------------------------------------------------------
     void Widget::InitPropertyValues(const PropertyMap& in_propertyMap)
     {
-        for (const auto& key : in_propertyMap.GetKeys())
+        in_propertyMap.ForEachValue([this](const std::string& in_name, const IProperty* in_property)
         {
-            if (in_propertyMap.HasValue(key) == true)
-            {
-                SetProperty(key, in_propertyMap.GetPropertyObject(key));
-            }
-        }
+            SetProperty(in_name, in_property);
+        });
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
@@ -633,6 +640,9 @@ namespace ChilliSource
     void Widget::SetColour(const Colour& in_colour)
     {
         m_localColour = Colour::Clamp(in_colour);
+        
+        InvalidateDrawList();
+        InvalidateChildDrawLists();
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
@@ -644,7 +654,12 @@ namespace ChilliSource
     //----------------------------------------------------------------------------------------
     void Widget::SetVisible(bool in_visible)
     {
-        m_isVisible = in_visible;
+        if (m_isVisible != in_visible)
+        {
+            m_isVisible = in_visible;
+            
+            InvalidateDrawList();
+        }
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
@@ -660,6 +675,17 @@ namespace ChilliSource
         
         m_isInputEnabled = in_input;
         
+        if (wasEnabled != m_isInputEnabled)
+        {
+            //The cached bounds of a widget without input may be left invalid while its parent's are valid, so
+            //the parent must be invalidated directly.
+            m_isInputBoundsCacheValid = false;
+            if (m_parent != nullptr)
+            {
+                m_parent->InvalidateInputBounds();
+            }
+        }
+        
         if (m_canvas != nullptr)
         {
             if (wasEnabled == false && m_isInputEnabled == true)
@@ -701,6 +727,10 @@ namespace ChilliSource
         m_children.push_back(in_widget);
         in_widget->m_parent = this;
         
+        OffsetNumTrackingWidgets(s32(in_widget->m_numTrackingWidgets));
+        InvalidateInputBounds();
+        InvalidateDrawList();
+        
         if (m_canvas != nullptr)
         {
             in_widget->SetCanvas(m_canvas);
@@ -721,8 +751,13 @@ namespace ChilliSource
                     (*it)->SetCanvas(nullptr);
                 }
                 
+                OffsetNumTrackingWidgets(-s32(in_widget->m_numTrackingWidgets));
+                
                 (*it)->m_parent = nullptr;
                 m_children.erase(it);
+                
+                InvalidateInputBounds();
+                InvalidateDrawList();
                 return;
             }
         }
@@ -905,6 +940,8 @@ namespace ChilliSource
     {
         CS_ASSERT(m_parent != nullptr, "Widget has no parent to rearrange from");
         
+        m_parent->InvalidateDrawList();
+        
         s32 length = static_cast<s32>(m_parent->m_children.size()) - 1;
         for(s32 i=0; i<length; ++i)
         {
@@ -920,6 +957,8 @@ namespace ChilliSource
     {
         CS_ASSERT(m_parent != nullptr, "Widget has no parent to rearrange from");
         
+        m_parent->InvalidateDrawList();
+        
         s32 length = static_cast<s32>(m_parent->m_children.size()) - 1;
         for(s32 i=0; i<length; ++i)
         {
@@ -936,6 +975,8 @@ namespace ChilliSource
     {
         CS_ASSERT(m_parent != nullptr, "Widget has no parent to rearrange from");
         
+        m_parent->InvalidateDrawList();
+        
         auto length = m_parent->m_children.size();
         for(std::size_t i = 1; i < length; ++i)
         {
@@ -952,6 +993,8 @@ namespace ChilliSource
     {
         CS_ASSERT(m_parent != nullptr, "Widget has no parent to rearrange from");
         
+        m_parent->InvalidateDrawList();
+        
         auto length = m_parent->m_children.size();
         for(std::size_t i = 1; i < length; ++i)
         {
@@ -1315,6 +1358,34 @@ namespace ChilliSource
         
         CS_LOG_FATAL("Invalid property name for Widget: " + in_propertyName);
     }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    IProperty* Widget::GetPropertyObject(const std::string& in_propertyName)
+    {
+        std::string lowerName = in_propertyName;
+        StringUtils::ToLowerCase(lowerName);
+        
+        auto basePropIt = m_baseProperties.find(lowerName);
+        if(basePropIt != m_baseProperties.end())
+        {
+            return basePropIt->second.get();
+        }
+        
+        auto componentPropIt = m_componentPropertyLinks.find(lowerName);
+        if(componentPropIt != m_componentPropertyLinks.end())
+        {
+            return componentPropIt->second.first->GetPropertyObject(componentPropIt->second.second);
+        }
+        
+        auto childPropIt = m_childPropertyLinks.find(lowerName);
+        if(childPropIt != m_childPropertyLinks.end())
+        {
+            return childPropIt->second.first->GetPropertyObject(childPropIt->second.second);
+        }
+        
+        CS_LOG_FATAL("Invalid property name for Widget: " + in_propertyName);
+        return nullptr;
+    }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
     void Widget::UpdateContainedPointer(const Pointer& in_pointer)
@@ -1326,12 +1397,18 @@ namespace ChilliSource
         
         if (wasContained == false && isContained == true)
         {
+            bool wasTracking = IsTrackingPointers();
             m_containedPointers.insert(in_pointer.GetId());
+            UpdatePointerTracking(wasTracking);
+            
             m_moveEnteredEvent.NotifyConnections(this, in_pointer);
         }
         else if (wasContained == true && isContained == false)
         {
+            bool wasTracking = IsTrackingPointers();
             m_containedPointers.erase(pointerIdIt);
+            UpdatePointerTracking(wasTracking);
+            
             m_moveExitedEvent.NotifyConnections(this, in_pointer);
         }
     }
@@ -1342,7 +1419,10 @@ namespace ChilliSource
         auto pointerIdIt = m_containedPointers.find(in_pointer.GetId());
         if (pointerIdIt != m_containedPointers.end())
         {
+            bool wasTracking = IsTrackingPointers();
             m_containedPointers.erase(pointerIdIt);
+            UpdatePointerTracking(wasTracking);
+            
             m_moveExitedEvent.NotifyConnections(this, in_pointer);
         }
     }
@@ -1372,6 +1452,126 @@ namespace ChilliSource
     {
         return (m_containedPointers.find(in_pointer.GetId()) != m_containedPointers.end());
     }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    bool Widget::IsTrackingPointers() const
+    {
+        return (m_containedPointers.empty() == false || m_pressedInput.empty() == false);
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    void Widget::UpdatePointerTracking(bool in_wasTracking)
+    {
+        bool isTracking = IsTrackingPointers();
+        if (in_wasTracking == false && isTracking == true)
+        {
+            OffsetNumTrackingWidgets(1);
+        }
+        else if (in_wasTracking == true && isTracking == false)
+        {
+            OffsetNumTrackingWidgets(-1);
+        }
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    void Widget::OffsetNumTrackingWidgets(s32 in_offset)
+    {
+        if (in_offset == 0)
+        {
+            return;
+        }
+        
+        for (auto widget = this; widget != nullptr; widget = widget->m_parent)
+        {
+            CS_ASSERT(s32(widget->m_numTrackingWidgets) + in_offset >= 0, "Number of tracking widgets cannot be negative.");
+            widget->m_numTrackingWidgets = u32(s32(widget->m_numTrackingWidgets) + in_offset);
+        }
+    }
+    //------------------------------------------------------------------------------
+    /// A widget's cached input bounds can only be valid if those of all its input
+    /// enabled children are, so the walk can stop at the first ancestor which is
+    /// already invalid.
+    //------------------------------------------------------------------------------
+    void Widget::InvalidateInputBounds()
+    {
+        for (auto widget = this; widget != nullptr && widget->m_isInputBoundsCacheValid == true; widget = widget->m_parent)
+        {
+            widget->m_isInputBoundsCacheValid = false;
+        }
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    void Widget::UpdateInputBounds() const
+    {
+        if (m_isInputBoundsCacheValid == true)
+        {
+            return;
+        }
+        
+        //Transform the corners of the box used by Contains() into screen space.
+        Vector2 finalSize = GetFinalSize();
+        Vector2 halfSize = finalSize * 0.5f;
+        Vector2 centre = GetAnchorPoint(AlignmentAnchor::k_middleCentre, finalSize);
+        Matrix3 finalTransform = GetFinalTransform();
+        
+        const Vector2 corners[] =
+        {
+            (centre + Vector2(-halfSize.x, -halfSize.y)) * finalTransform,
+            (centre + Vector2(halfSize.x, -halfSize.y)) * finalTransform,
+            (centre + Vector2(-halfSize.x, halfSize.y)) * finalTransform,
+            (centre + Vector2(halfSize.x, halfSize.y)) * finalTransform
+        };
+        
+        Vector2 boundsMin = corners[0];
+        Vector2 boundsMax = corners[0];
+        for (const auto& corner : corners)
+        {
+            boundsMin.Min(corner);
+            boundsMax.Max(corner);
+        }
+        
+        boundsMin -= Vector2(k_inputBoundsTolerance, k_inputBoundsTolerance);
+        boundsMax += Vector2(k_inputBoundsTolerance, k_inputBoundsTolerance);
+        
+        //Children that don't have input enabled will ignore all pointer events so they don't contribute.
+        for (const auto& child : m_internalChildren)
+        {
+            if (child->m_isInputEnabled == true)
+            {
+                child->UpdateInputBounds();
+                boundsMin.Min(child->m_cachedInputBoundsMin);
+                boundsMax.Max(child->m_cachedInputBoundsMax);
+            }
+        }
+        
+        for (const auto& child : m_children)
+        {
+            if (child->m_isInputEnabled == true)
+            {
+                child->UpdateInputBounds();
+                boundsMin.Min(child->m_cachedInputBoundsMin);
+                boundsMax.Max(child->m_cachedInputBoundsMax);
+            }
+        }
+        
+        m_cachedInputBoundsMin = boundsMin;
+        m_cachedInputBoundsMax = boundsMax;
+        m_isInputBoundsCacheValid = true;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    bool Widget::CanIgnorePointer(const Pointer& in_pointer) const
+    {
+        if (m_numTrackingWidgets > 0)
+        {
+            return false;
+        }
+        
+        UpdateInputBounds();
+        
+        const Vector2& position = in_pointer.GetPosition();
+        return (position.x < m_cachedInputBoundsMin.x || position.y < m_cachedInputBoundsMin.y || position.x > m_cachedInputBoundsMax.x || position.y > m_cachedInputBoundsMax.y);
+    }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
     void Widget::OnParentTransformChanged()
@@ -1392,19 +1592,15 @@ namespace ChilliSource
             component->OnResume();
         }
         
-        m_internalChildren.lock();
         for(auto& child : m_internalChildren)
         {
             child->OnResume();
         }
-        m_internalChildren.unlock();
         
-        m_children.lock();
         for(auto& child : m_children)
         {
             child->OnResume();
         }
-        m_children.unlock();
         
         ForceLayout();
     }
@@ -1417,19 +1613,15 @@ namespace ChilliSource
             component->OnForeground();
         }
         
-        m_internalChildren.lock();
         for(auto& child : m_internalChildren)
         {
             child->OnForeground();
         }
-        m_internalChildren.unlock();
         
-        m_children.lock();
         for(auto& child : m_children)
         {
             child->OnForeground();
         }
-        m_children.unlock();
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
@@ -1440,19 +1632,15 @@ namespace ChilliSource
             component->OnUpdate(in_timeSinceLastUpdate);
         }
         
-        m_internalChildren.lock();
         for(auto& child : m_internalChildren)
         {
             child->OnUpdate(in_timeSinceLastUpdate);
         }
-        m_internalChildren.unlock();
         
-        m_children.lock();
         for(auto& child : m_children)
         {
             child->OnUpdate(in_timeSinceLastUpdate);
         }
-        m_children.unlock();
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
@@ -1463,6 +1651,19 @@ namespace ChilliSource
             return;
         }
         
+        //Widgets below a retained widget are always recorded, as the retained list references theirs.
+        bool isRetained = m_isDrawListRetained || in_renderer->IsRecordingDrawList();
+        if (isRetained == true)
+        {
+            if (m_isDrawListValid == true)
+            {
+                in_renderer->DrawList(m_drawList);
+                return;
+            }
+            
+            in_renderer->BeginDrawList(&m_drawList);
+        }
+        
         Vector2 finalSize(GetFinalSize());
         
         if (ShouldCull(GetFinalPositionOfCentre(), finalSize, m_screen->GetResolution()) == false)
@@ -1478,42 +1679,58 @@ namespace ChilliSource
             component->OnPreDrawChildren(in_renderer);
         }
         
-        m_internalChildren.lock();
         for(auto& child : m_internalChildren)
         {
             child->OnDraw(in_renderer);
         }
-        m_internalChildren.unlock();
         
-        m_children.lock();
         for(auto& child : m_children)
         {
             child->OnDraw(in_renderer);
         }
-        m_children.unlock();
         
         for (auto& component : m_components)
         {
             component->OnPostDrawChildren(in_renderer);
         }
+        
+        if (isRetained == true)
+        {
+            in_renderer->EndDrawList();
+        }
+        
+        //A list is never left valid after an immediate mode draw, as changes may not have invalidated it.
+        m_isDrawListValid = isRetained;
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    void Widget::InvalidateChildDrawLists()
+    {
+        for(auto& child : m_internalChildren)
+        {
+            child->m_isDrawListValid = false;
+            child->InvalidateChildDrawLists();
+        }
+        
+        for(auto& child : m_children)
+        {
+            child->m_isDrawListValid = false;
+            child->InvalidateChildDrawLists();
+        }
     }
     //----------------------------------------------------------------------------------------
     //----------------------------------------------------------------------------------------
     void Widget::OnBackground()
     {
-        m_children.lock();
         for(auto& child : m_children)
         {
             child->OnBackground();
         }
-        m_children.unlock();
         
-        m_internalChildren.lock();
         for(auto& child : m_internalChildren)
         {
             child->OnBackground();
         }
-        m_internalChildren.unlock();
         
         for (const auto& component : m_components)
         {
@@ -1531,19 +1748,15 @@ namespace ChilliSource
             RemoveAllContainedPointers();
         }
         
-        m_children.lock();
         for(auto& child : m_children)
         {
             child->OnSuspend();
         }
-        m_children.unlock();
         
-        m_internalChildren.lock();
         for(auto& child : m_internalChildren)
         {
             child->OnSuspend();
         }
-        m_internalChildren.unlock();
         
         for (const auto& component : m_components)
         {
@@ -1557,6 +1770,9 @@ namespace ChilliSource
         m_isLocalTransformCacheValid = false;
         m_isLocalSizeCacheValid = false;
         
+        InvalidateInputBounds();
+        InvalidateDrawList();
+        
         if(m_canvas != nullptr)
         {
             if(m_layoutComponent != nullptr)
@@ -1582,24 +1798,48 @@ namespace ChilliSource
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
+    void Widget::SetDrawListRetained(bool in_retained)
+    {
+        m_isDrawListRetained = in_retained;
+        
+        InvalidateDrawList();
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    bool Widget::IsDrawListRetained() const
+    {
+        return m_isDrawListRetained;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    void Widget::InvalidateDrawList()
+    {
+        //The parent chain is always walked in full, as widgets which were hidden or not on the canvas when
+        //their parent was last drawn can be out of date even when their parent's draw list is valid.
+        for (auto widget = this; widget != nullptr; widget = widget->m_parent)
+        {
+            widget->m_isDrawListValid = false;
+        }
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
     void Widget::OnPointerAdded(const Pointer& in_pointer, f64 in_timestamp)
     {
         if(m_isInputEnabled == false)
             return;
         
-        m_children.lock();
+        if(CanIgnorePointer(in_pointer) == true)
+            return;
+        
         for(auto it = m_children.rbegin(); it != m_children.rend(); ++it)
         {
             (*it)->OnPointerAdded(in_pointer, in_timestamp);
         }
-        m_children.unlock();
         
-        m_internalChildren.lock();
         for(auto it = m_internalChildren.rbegin(); it != m_internalChildren.rend(); ++it)
         {
             (*it)->OnPointerAdded(in_pointer, in_timestamp);
         }
-        m_internalChildren.unlock();
         
         UpdateContainedPointer(in_pointer);
     }
@@ -1613,37 +1853,35 @@ namespace ChilliSource
         if(m_isInputEnabled == false)
             return;
         
-        m_children.lock();
+        if(CanIgnorePointer(in_pointer) == true)
+            return;
+        
         for(auto it = m_children.rbegin(); it != m_children.rend(); ++it)
         {
             (*it)->OnPointerDown(in_pointer, in_timestamp, in_inputType, in_filter);
             
             if(in_filter.IsFiltered() == true)
             {
-                m_children.unlock();
                 return;
             }
         }
-        m_children.unlock();
         
-        m_internalChildren.lock();
         for(auto it = m_internalChildren.rbegin(); it != m_internalChildren.rend(); ++it)
         {
             (*it)->OnPointerDown(in_pointer, in_timestamp, in_inputType, in_filter);
             
             if(in_filter.IsFiltered() == true)
             {
-                m_internalChildren.unlock();
                 return;
             }
         }
-        m_internalChildren.unlock();
         
         UpdateContainedPointer(in_pointer);
         if(IsContainedPointer(in_pointer) == true)
         {
             //Track the input that is down on the widget as
             //this will effect how we trigger the release events
+            bool wasTracking = IsTrackingPointers();
             auto it = m_pressedInput.find(in_pointer.GetId());
             if (it != m_pressedInput.end())
             {
@@ -1654,6 +1892,7 @@ namespace ChilliSource
                 std::set<Pointer::InputType> inputTypeSet = { in_inputType };
                 m_pressedInput.emplace(in_pointer.GetId(), inputTypeSet);
             }
+            UpdatePointerTracking(wasTracking);
             
             m_pressedInsideEvent.NotifyConnections(this, in_pointer, in_inputType);
             
@@ -1672,19 +1911,18 @@ namespace ChilliSource
         if(m_isInputEnabled == false)
             return;
         
-        m_children.lock();
+        if(CanIgnorePointer(in_pointer) == true)
+            return;
+        
         for(auto it = m_children.rbegin(); it != m_children.rend(); ++it)
         {
             (*it)->OnPointerMoved(in_pointer, in_timestamp);
         }
-        m_children.unlock();
         
-        m_internalChildren.lock();
         for(auto it = m_internalChildren.rbegin(); it != m_internalChildren.rend(); ++it)
         {
             (*it)->OnPointerMoved(in_pointer, in_timestamp);
         }
-        m_internalChildren.unlock();
         
         bool containsPrevious = IsContainedPointer(in_pointer);
         UpdateContainedPointer(in_pointer);
@@ -1716,19 +1954,18 @@ namespace ChilliSource
         if(m_isInputEnabled == false)
             return;
         
-        m_children.lock();
+        if(CanIgnorePointer(in_pointer) == true)
+            return;
+        
         for(auto it = m_children.rbegin(); it != m_children.rend(); ++it)
         {
             (*it)->OnPointerUp(in_pointer, in_timestamp, in_inputType);
         }
-        m_children.unlock();
         
-        m_internalChildren.lock();
         for(auto it = m_internalChildren.rbegin(); it != m_internalChildren.rend(); ++it)
         {
             (*it)->OnPointerUp(in_pointer, in_timestamp, in_inputType);
         }
-        m_internalChildren.unlock();
         
         UpdateContainedPointer(in_pointer);
         auto itPressedInput = m_pressedInput.find(in_pointer.GetId());
@@ -1740,7 +1977,9 @@ namespace ChilliSource
                 itPressedInput->second.erase(itPressedInputType);
                 if (itPressedInput->second.empty() == true)
                 {
+                    bool wasTracking = IsTrackingPointers();
                     m_pressedInput.erase(itPressedInput);
+                    UpdatePointerTracking(wasTracking);
                 }
 
                 if(IsContainedPointer(in_pointer) == true)
@@ -1761,19 +2000,18 @@ namespace ChilliSource
         if(m_isInputEnabled == false)
             return;
         
-        m_children.lock();
+        if(CanIgnorePointer(in_pointer) == true)
+            return;
+        
         for(auto it = m_children.rbegin(); it != m_children.rend(); ++it)
         {
             (*it)->OnPointerRemoved(in_pointer, in_timestamp);
         }
-        m_children.unlock();
         
-        m_internalChildren.lock();
         for(auto it = m_internalChildren.rbegin(); it != m_internalChildren.rend(); ++it)
         {
             (*it)->OnPointerRemoved(in_pointer, in_timestamp);
         }
-        m_internalChildren.unlock();
         
         RemoveContainedPointer(in_pointer);
     }
@@ -41,6 +41,7 @@
 #include <ChilliSource/Input/Base/InputFilter.h>
 #include <ChilliSource/Input/Pointer/Pointer.h>
 #include <ChilliSource/Rendering/Base/AlignmentAnchors.h>
+#include <ChilliSource/Rendering/Base/CanvasDrawList.h>
 #include <ChilliSource/Rendering/Base/SizePolicy.h>
 #include <ChilliSource/UI/Base/UIComponent.h>
 #include <ChilliSource/UI/Base/PropertyLink.h>
@@ -101,6 +102,9 @@ namespace ChilliSource
     /// 'UseWidthMaintainingAspect', 'UseHeightMaintainingAspect', 'FitMaintainingAspect',
     /// 'FillMaintainingAspect'
     ///
+    /// "RetainDrawList": A boolean describing whether or not the widget and it's children are
+    /// drawn from a retained draw list rather than in immediate mode. See SetDrawListRetained().
+    ///
     /// @author S Downie
     //----------------------------------------------------------------------------------------
     class Widget final
@@ -819,6 +823,21 @@ namespace ChilliSource
         //----------------------------------------------------------------------------------------
         template<typename TType> TType GetProperty(const std::string& in_name) const;
         //----------------------------------------------------------------------------------------
+        /// Resolves the property with the given name to a handle which can be used to repeatedly
+        /// get and set the property without the string processing and lookups performed by
+        /// GetProperty() and SetProperty(). Links to component and child widget properties are
+        /// resolved to the underlying property. This should be preferred when a property is
+        /// accessed frequently, for example by tweens or data bindings.
+        ///
+        /// If no property exists with the name, or it is not of the requested type, then it
+        /// will assert.
+        ///
+        /// @param Name. This is case insensitive.
+        ///
+        /// @return The property handle. This remains valid for the lifetime of the widget.
+        //----------------------------------------------------------------------------------------
+        template<typename TType> Property<TType>* GetPropertyHandle(const std::string& in_name);
+        //----------------------------------------------------------------------------------------
         /// Performs a calculation to check if the given position is within the OOBB
         /// of the widget
         ///
@@ -849,6 +868,43 @@ namespace ChilliSource
         /// @author Ian Copland
         //------------------------------------------------------------------------------
         void ForceLayout();
+        //------------------------------------------------------------------------------
+        /// Sets whether or not the widget retains its draw list. By default widgets are
+        /// drawn in immediate mode: every component is asked to draw every frame.
+        ///
+        /// A widget which retains its draw list records the sprites generated while
+        /// drawing itself and everything below it, and re-issues them each frame until
+        /// the list is invalidated. This applies to the whole hierarchy below the widget,
+        /// regardless of the setting on its descendants, and is considerably cheaper for
+        /// large, mostly static hierarchies.
+        ///
+        /// In exchange, anything which affects how a retained widget or its descendants
+        /// draw must invalidate the draw list. Changes made through the widget and the
+        /// engine's components do so automatically, but a component which draws state
+        /// that can change without it knowing, for example one that animates in OnDraw(),
+        /// or code which modifies a drawable through a pointer kept from an earlier call
+        /// to DrawableUIComponent::GetDrawable(), must call InvalidateDrawList() itself.
+        /// Widgets containing such components should be left in immediate mode.
+        ///
+        /// @param Whether or not the widget retains its draw list.
+        //------------------------------------------------------------------------------
+        void SetDrawListRetained(bool in_retained);
+        //------------------------------------------------------------------------------
+        /// @return Whether or not the widget itself retains its draw list. See
+        /// SetDrawListRetained() for details.
+        //------------------------------------------------------------------------------
+        bool IsDrawListRetained() const;
+        //------------------------------------------------------------------------------
+        /// Flags the draw list of this widget, and every widget above it, as out of date,
+        /// ensuring they are rebuilt the next time they are rendered. This only has an
+        /// effect on widgets which are drawn from a retained draw list; see
+        /// SetDrawListRetained().
+        ///
+        /// Changes to the widget's own properties invalidate the draw list automatically.
+        /// Components should call this, usually via UIComponent::InvalidateDrawList(),
+        /// whenever any state which affects how they draw changes.
+        //------------------------------------------------------------------------------
+        void InvalidateDrawList();
         //----------------------------------------------------------------------------------------
         /// Destructor. Sends the OnDestroy event to all components.
         ///
@@ -858,6 +914,7 @@ namespace ChilliSource
     private:
         friend class Canvas;
         friend class WidgetFactory;
+        friend class WidgetPool;
         //----------------------------------------------------------------------------------------
         /// Constructor that builds the widget from the given definition. The default properties
         /// of a widget are described in the class documentation.
@@ -1037,6 +1094,15 @@ namespace ChilliSource
         /// @param The property used to set the value.
         //----------------------------------------------------------------------------------------
         void SetProperty(const std::string& in_propertyName, const IProperty* in_property);
+        //----------------------------------------------------------------------------------------
+        /// Resolves the property with the given name, following any links to component or child
+        /// widget properties. If no property exists with the name then it will assert.
+        ///
+        /// @param The property name. This is case insensitive.
+        ///
+        /// @return The resolved property.
+        //----------------------------------------------------------------------------------------
+        IProperty* GetPropertyObject(const std::string& in_propertyName);
         //------------------------------------------------------------------------------
         /// Checks the given pointer and updates the contained pointer set accordingly.
         /// If the pointer has changed state a pointer entered or exited event will be
@@ -1096,6 +1162,50 @@ namespace ChilliSource
         /// @return Whether or not the pointer is within the bounds.
         //------------------------------------------------------------------------------
         bool IsContainedPointer(const Pointer& in_pointer);
+        //------------------------------------------------------------------------------
+        /// @return Whether or not this widget currently contains any pointers or has
+        /// any pointers pressed on it, and therefore needs to receive pointer events
+        /// regardless of where the pointer is.
+        //------------------------------------------------------------------------------
+        bool IsTrackingPointers() const;
+        //------------------------------------------------------------------------------
+        /// Updates the number of tracking widgets in this widget's subtree and those
+        /// of its ancestors if the tracking state has changed. This should be called
+        /// whenever the contained pointer set or pressed input changes.
+        ///
+        /// @param in_wasTracking - Whether or not this widget was tracking pointers
+        /// prior to the change.
+        //------------------------------------------------------------------------------
+        void UpdatePointerTracking(bool in_wasTracking);
+        //------------------------------------------------------------------------------
+        /// Applies the given offset to the number of tracking widgets in the subtree of
+        /// this widget and all of its ancestors.
+        ///
+        /// @param in_offset - The offset to apply.
+        //------------------------------------------------------------------------------
+        void OffsetNumTrackingWidgets(s32 in_offset);
+        //------------------------------------------------------------------------------
+        /// Invalidates the cached screen space input bounds of this widget and all of
+        /// its ancestors. This should be called whenever the final transform or size
+        /// of the widget changes, or the set of input enabled children changes.
+        //------------------------------------------------------------------------------
+        void InvalidateInputBounds();
+        //------------------------------------------------------------------------------
+        /// Calculates the screen space axis aligned bounds of this widget and all of
+        /// its input enabled descendants if the cached bounds are invalid.
+        //------------------------------------------------------------------------------
+        void UpdateInputBounds() const;
+        //------------------------------------------------------------------------------
+        /// Checks whether pointer events for the given pointer can be ignored by this
+        /// widget and all of its descendants. This is the case when the pointer is
+        /// outside of the input bounds and no widget in the subtree is tracking
+        /// pointers, as none of the pointer event handlers would have any effect.
+        ///
+        /// @param in_pointer - The pointer to check.
+        ///
+        /// @return Whether or not the pointer can be ignored.
+        //------------------------------------------------------------------------------
+        bool CanIgnorePointer(const Pointer& in_pointer) const;
         //----------------------------------------------------------------------------------------
         /// Called when the parent transform changes forcing this to update its caches
         ///
@@ -1127,7 +1237,10 @@ namespace ChilliSource
         //----------------------------------------------------------------------------------------
         void OnUpdate(f32 in_timeSinceLastUpdate);
         //----------------------------------------------------------------------------------------
-        /// Tells any components or child widgets to draw.
+        /// Tells any components or child widgets to draw. If the widget, or any widget
+        /// above it, retains its draw list then the draw is recorded, and if nothing in
+        /// the hierarchy has changed since the last draw the recorded list is re-issued
+        /// instead.
         ///
         /// @author S Downie
         ///
@@ -1135,6 +1248,12 @@ namespace ChilliSource
         //----------------------------------------------------------------------------------------
         void OnDraw(CanvasRenderer* in_renderer);
         //----------------------------------------------------------------------------------------
+        /// Flags the draw lists of all widgets below this one as out of date. This is
+        /// required when changes to this widget affect the appearance of its children, for
+        /// example when its colour changes.
+        //----------------------------------------------------------------------------------------
+        void InvalidateChildDrawLists();
+        //----------------------------------------------------------------------------------------
         /// Backgrounds the widget, its components and its children. This is called when the widget
         /// is removed from the canvas and every time the state that owns the canvas is backgrounded
         /// while the widget is attached.
@@ -1208,6 +1327,7 @@ namespace ChilliSource
         
         std::unordered_map<Pointer::Id, std::set<Pointer::InputType>> m_pressedInput;
         std::unordered_set<Pointer::Id> m_containedPointers;
+        u32 m_numTrackingWidgets = 0;
         
         Event<InputDelegate> m_pressedInsideEvent;
         Event<InputDelegate> m_releasedInsideEvent;
@@ -1256,6 +1376,14 @@ namespace ChilliSource
         mutable bool m_isLocalTransformCacheValid = false;
         mutable bool m_isLocalSizeCacheValid = false;
         mutable bool m_isParentSizeCacheValid = false;
+        mutable bool m_isInputBoundsCacheValid = false;
+        
+        mutable Vector2 m_cachedInputBoundsMin;
+        mutable Vector2 m_cachedInputBoundsMax;
+        
+        CanvasDrawList m_drawList;
+        bool m_isDrawListRetained = false;
+        bool m_isDrawListValid = false;
 
         Screen* m_screen = nullptr;
         PointerSystem* m_pointerSystem = nullptr;
@@ -1340,6 +1468,12 @@ namespace ChilliSource
         CS_LOG_FATAL("Invalid property name for Widget: " + in_name);
         return TType();
     }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    template<typename TType> Property<TType>* Widget::GetPropertyHandle(const std::string& in_name)
+    {
+        return CS_SMARTCAST(Property<TType>*, GetPropertyObject(in_name), "Incorrect type for property with name: " + in_name);
+    }
 }
 
 #endif
@@ -48,6 +48,7 @@ namespace ChilliSource
     namespace
     {
         const std::string k_extension("csuidef");
+        const std::string k_binaryExtension("csuidefbin");
         
         const char k_widgetNameKey[] = "Name";
         
@@ -422,7 +423,9 @@ namespace ChilliSource
             
             //read the json
             Json::Value root;
-            if (JsonUtils::ReadJson(in_storageLocation, in_filepath, root) == false)
+            bool isBinary = StringUtils::EndsWith(in_filepath, "." + k_binaryExtension);
+            bool readSuccessful = isBinary ? JsonUtils::ReadBinaryJson(in_storageLocation, in_filepath, root) : JsonUtils::ReadJson(in_storageLocation, in_filepath, root);
+            if (readSuccessful == false)
             {
                 CS_LOG_ERROR("Cannot read widget def file: " + in_filepath);
                 out_resource->SetLoadState(Resource::LoadState::k_failed);
@@ -524,17 +527,17 @@ namespace ChilliSource
     //-------------------------------------------------------
     bool WidgetDefProvider::CanCreateResourceWithFileExtension(const std::string& in_extension) const
     {
-        return (in_extension == k_extension);
+        return (in_extension == k_extension || in_extension == k_binaryExtension);
     }
     //-------------------------------------------------------
     //-------------------------------------------------------
-    void WidgetDefProvider::CreateResourceFromFile(StorageLocation in_storageLocation, const std::string& in_filepath, const IResourceOptionsBaseCSPtr& in_options, const ResourceSPtr& out_resource)
+    void WidgetDefProvider::CreateResourceFromFile(StorageLocation in_storageLocation, const std::string& in_filepath, const IResourceOptionsBaseCSPtr&, const ResourceSPtr& out_resource)
     {
         LoadDesc(in_storageLocation, in_filepath, nullptr, out_resource);
     }
     //----------------------------------------------------
     //----------------------------------------------------
-    void WidgetDefProvider::CreateResourceFromFileAsync(StorageLocation in_storageLocation, const std::string& in_filepath, const IResourceOptionsBaseCSPtr& in_options, const AsyncLoadDelegate& in_delegate, const ResourceSPtr& out_resource)
+    void WidgetDefProvider::CreateResourceFromFileAsync(StorageLocation, const std::string&, const IResourceOptionsBaseCSPtr&, const AsyncLoadDelegate&, const ResourceSPtr&)
     {
         //TODO: Async support.
         CS_LOG_FATAL("Asynchronous loading of Widget Def is currently not supported. Feature coming soon!");
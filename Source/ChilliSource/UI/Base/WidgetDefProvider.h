@@ -36,7 +36,10 @@ namespace ChilliSource
 {
     //-------------------------------------------------------------
     /// A resource provider that creates widget descriptions for
-    /// file
+    /// file. Both json (.csuidef) and compiled binary json
+    /// (.csuidefbin) files are supported; the latter can be
+    /// generated using Tools/Scripts/compile_json.py and is
+    /// considerably faster to load.
     ///
     /// @author S Downie
     //-------------------------------------------------------------
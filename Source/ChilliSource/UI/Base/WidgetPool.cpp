@@ -0,0 +1,220 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/UI/Base/WidgetPool.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Container/Property/IPropertyType.h>
+#include <ChilliSource/UI/Base/Widget.h>
+#include <ChilliSource/UI/Base/WidgetDef.h>
+#include <ChilliSource/UI/Base/WidgetDesc.h>
+#include <ChilliSource/UI/Base/WidgetFactory.h>
+#include <ChilliSource/UI/Base/WidgetTemplate.h>
+
+namespace ChilliSource
+{
+    //--------------------------------------------------------------------------
+    //--------------------------------------------------------------------------
+    WidgetPool::WidgetPool(const WidgetDefCSPtr& in_widgetDef, u32 in_initialSize)
+        : m_widgetDef(in_widgetDef)
+    {
+        CS_ASSERT(m_widgetDef != nullptr, "Cannot create a widget pool with a null widget def.");
+        
+        Reserve(in_initialSize);
+    }
+    //--------------------------------------------------------------------------
+    //--------------------------------------------------------------------------
+    WidgetPool::WidgetPool(const WidgetTemplateCSPtr& in_widgetTemplate, u32 in_initialSize)
+        : m_widgetTemplate(in_widgetTemplate)
+    {
+        CS_ASSERT(m_widgetTemplate != nullptr, "Cannot create a widget pool with a null widget template.");
+        
+        Reserve(in_initialSize);
+    }
+    //--------------------------------------------------------------------------
+    //--------------------------------------------------------------------------
+    void WidgetPool::Reserve(u32 in_numWidgets)
+    {
+        m_freeWidgets.reserve(in_numWidgets);
+        while (m_freeWidgets.size() < in_numWidgets)
+        {
+            m_freeWidgets.push_back(CreateWidget());
+        }
+    }
+    //--------------------------------------------------------------------------
+    //--------------------------------------------------------------------------
+    WidgetSPtr WidgetPool::Acquire()
+    {
+        WidgetSPtr widget;
+        if (m_freeWidgets.empty() == false)
+        {
+            widget = std::move(m_freeWidgets.back());
+            m_freeWidgets.pop_back();
+        }
+        else
+        {
+            widget = CreateWidget();
+        }
+        
+        m_acquiredWidgets.insert(widget.get());
+        return widget;
+    }
+    //--------------------------------------------------------------------------
+    //--------------------------------------------------------------------------
+    void WidgetPool::Release(const WidgetSPtr& in_widget)
+    {
+        CS_ASSERT(in_widget != nullptr, "Cannot release a null widget.");
+        
+        auto it = m_acquiredWidgets.find(in_widget.get());
+        CS_ASSERT(it != m_acquiredWidgets.end(), "Cannot release a widget which was not acquired from this pool.");
+        m_acquiredWidgets.erase(it);
+        
+        if (in_widget->GetParent() != nullptr)
+        {
+            in_widget->RemoveFromParent();
+        }
+        
+        u32 stateIndex = 0;
+        ResetRecursive(in_widget.get(), stateIndex);
+        CS_ASSERT(stateIndex == m_resetStates.size(), "Released widget hierarchy does not match the hierarchy it was created with.");
+        
+        m_freeWidgets.push_back(in_widget);
+    }
+    //--------------------------------------------------------------------------
+    //--------------------------------------------------------------------------
+    u32 WidgetPool::GetNumFreeWidgets() const
+    {
+        return u32(m_freeWidgets.size());
+    }
+    //--------------------------------------------------------------------------
+    //--------------------------------------------------------------------------
+    void WidgetPool::Clear()
+    {
+        m_freeWidgets.clear();
+        m_freeWidgets.shrink_to_fit();
+    }
+    //--------------------------------------------------------------------------
+    //--------------------------------------------------------------------------
+    WidgetSPtr WidgetPool::CreateWidget()
+    {
+        auto widgetFactory = Application::Get()->GetWidgetFactory();
+        
+        WidgetSPtr widget;
+        if (m_widgetDef != nullptr)
+        {
+            widget = widgetFactory->Create(m_widgetDef);
+        }
+        else
+        {
+            widget = widgetFactory->Create(m_widgetTemplate);
+        }
+        
+        if (m_resetStates.empty() == true)
+        {
+            if (m_widgetDef != nullptr)
+            {
+                //A widget created directly from a definition is given the definition's default properties and no external children.
+                WidgetDesc rootDesc(m_widgetDef->GetTypeName(), m_widgetDef->GetDefaultProperties(), std::vector<WidgetDesc>());
+                BuildResetStatesRecursive(widget.get(), m_widgetDef, rootDesc);
+                m_resetStates.front().m_descProperties = &m_widgetDef->GetDefaultProperties();
+            }
+            else
+            {
+                const auto& rootDesc = m_widgetTemplate->GetWidgetDesc();
+                BuildResetStatesRecursive(widget.get(), widgetFactory->GetDefinition(rootDesc.GetType()), rootDesc);
+            }
+        }
+        
+        return widget;
+    }
+    //--------------------------------------------------------------------------
+    //--------------------------------------------------------------------------
+    void WidgetPool::BuildResetStatesRecursive(const Widget* in_widget, const WidgetDefCSPtr& in_widgetDef, const WidgetDesc& in_widgetDesc)
+    {
+        CS_ASSERT(in_widgetDef != nullptr, "Invalid widget def type in widget pool.");
+        
+        ResetState state;
+        state.m_descProperties = &in_widgetDesc.GetProperties();
+        state.m_numInternalChildren = u32(in_widget->m_internalChildren.size());
+        state.m_numChildren = u32(in_widget->m_children.size());
+        
+        state.m_baseProperties.reserve(in_widget->m_baseProperties.size());
+        for (const auto& baseProperty : in_widget->m_baseProperties)
+        {
+            IPropertyUPtr value = baseProperty.second->GetType()->CreateProperty();
+            value->Set(baseProperty.second.get());
+            state.m_baseProperties.push_back(std::make_pair(baseProperty.first, std::move(value)));
+        }
+        
+        m_resetStates.push_back(std::move(state));
+        
+        auto widgetFactory = Application::Get()->GetWidgetFactory();
+        
+        const auto& internalChildDescs = in_widgetDef->GetChildDescs();
+        CS_ASSERT(internalChildDescs.size() == in_widget->m_internalChildren.size(), "Widget internal children do not match its definition.");
+        u32 index = 0;
+        for (const auto& internalChild : in_widget->m_internalChildren)
+        {
+            const auto& childDesc = internalChildDescs[index++];
+            BuildResetStatesRecursive(internalChild.get(), widgetFactory->GetDefinition(childDesc.GetType()), childDesc);
+        }
+        
+        const auto& childDescs = in_widgetDesc.GetChildDescs();
+        CS_ASSERT(childDescs.size() == in_widget->m_children.size(), "Widget children do not match its description.");
+        index = 0;
+        for (const auto& child : in_widget->m_children)
+        {
+            const auto& childDesc = childDescs[index++];
+            BuildResetStatesRecursive(child.get(), widgetFactory->GetDefinition(childDesc.GetType()), childDesc);
+        }
+    }
+    //--------------------------------------------------------------------------
+    //--------------------------------------------------------------------------
+    void WidgetPool::ResetRecursive(Widget* in_widget, u32& io_stateIndex) const
+    {
+        CS_ASSERT(io_stateIndex < m_resetStates.size(), "Released widget hierarchy does not match the hierarchy it was created with.");
+        
+        const auto& state = m_resetStates[io_stateIndex++];
+        CS_ASSERT(state.m_numInternalChildren == in_widget->m_internalChildren.size(), "Released widget hierarchy does not match the hierarchy it was created with.");
+        CS_ASSERT(state.m_numChildren == in_widget->m_children.size(), "Released widget hierarchy does not match the hierarchy it was created with.");
+        
+        //internal children are reset first as the widget's own description can override their properties via property links.
+        for (const auto& internalChild : in_widget->m_internalChildren)
+        {
+            ResetRecursive(internalChild.get(), io_stateIndex);
+        }
+        
+        for (const auto& baseProperty : state.m_baseProperties)
+        {
+            in_widget->m_baseProperties.find(baseProperty.first)->second->Set(baseProperty.second.get());
+        }
+        in_widget->InitPropertyValues(*state.m_descProperties);
+        
+        for (const auto& child : in_widget->m_children)
+        {
+            ResetRecursive(child.get(), io_stateIndex);
+        }
+    }
+}
@@ -0,0 +1,157 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#ifndef _CHILLISOURCE_UI_BASE_WIDGETPOOL_H_
+#define _CHILLISOURCE_UI_BASE_WIDGETPOOL_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Container/Property/IProperty.h>
+
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace ChilliSource
+{
+    //--------------------------------------------------------------------------
+    /// A pool of widgets which were all created from the same widget def or
+    /// template. Building a widget from a definition requires creating all of
+    /// its components, internal children and property links, which is costly
+    /// for UI that is frequently created and destroyed, such as list entries.
+    /// The pool instead recycles released widgets.
+    ///
+    /// When a widget is released it is removed from its parent and its base
+    /// properties, and those of its internal and external children, are reset
+    /// to the values they had when created. The properties described in the
+    /// definition or template are then re-applied. Any state held by
+    /// components which cannot be set through a property, and any event
+    /// connections made to the widget, are the responsibility of the user and
+    /// should be cleared prior to release. External children added or removed
+    /// after creation must also be restored before release.
+    ///
+    /// A widget pool is not thread-safe and should only be used on the main
+    /// thread.
+    //--------------------------------------------------------------------------
+    class WidgetPool final
+    {
+    public:
+        CS_DECLARE_NOCOPY(WidgetPool);
+        //----------------------------------------------------------------------
+        /// Constructor. Creates a pool of widgets built from the given
+        /// definition.
+        ///
+        /// @param The widget def resource.
+        /// @param [Optional] The number of widgets to create up front.
+        /// Defaults to 0.
+        //----------------------------------------------------------------------
+        WidgetPool(const WidgetDefCSPtr& in_widgetDef, u32 in_initialSize = 0);
+        //----------------------------------------------------------------------
+        /// Constructor. Creates a pool of widgets built from the given
+        /// template.
+        ///
+        /// @param The widget template resource.
+        /// @param [Optional] The number of widgets to create up front.
+        /// Defaults to 0.
+        //----------------------------------------------------------------------
+        WidgetPool(const WidgetTemplateCSPtr& in_widgetTemplate, u32 in_initialSize = 0);
+        //----------------------------------------------------------------------
+        /// Creates new widgets until the pool contains at least the given
+        /// number of free widgets.
+        ///
+        /// @param The number of free widgets.
+        //----------------------------------------------------------------------
+        void Reserve(u32 in_numWidgets);
+        //----------------------------------------------------------------------
+        /// Takes a widget from the pool, creating a new one if there are no
+        /// free widgets. The widget will have no parent.
+        ///
+        /// @return The widget.
+        //----------------------------------------------------------------------
+        WidgetSPtr Acquire();
+        //----------------------------------------------------------------------
+        /// Resets the given widget and returns it to the pool. The widget must
+        /// have been acquired from this pool and must not be used by the
+        /// caller afterwards.
+        ///
+        /// @param The widget to release.
+        //----------------------------------------------------------------------
+        void Release(const WidgetSPtr& in_widget);
+        //----------------------------------------------------------------------
+        /// @return The number of widgets which can currently be acquired
+        /// without creating a new widget.
+        //----------------------------------------------------------------------
+        u32 GetNumFreeWidgets() const;
+        //----------------------------------------------------------------------
+        /// Destroys all free widgets. Widgets which are currently acquired are
+        /// unaffected, but can still be released back into the pool.
+        //----------------------------------------------------------------------
+        void Clear();
+        
+    private:
+        //----------------------------------------------------------------------
+        /// The state a single widget in the hierarchy is reset to on release.
+        //----------------------------------------------------------------------
+        struct ResetState
+        {
+            std::vector<std::pair<std::string, IPropertyUPtr>> m_baseProperties;
+            const PropertyMap* m_descProperties = nullptr;
+            u32 m_numInternalChildren = 0;
+            u32 m_numChildren = 0;
+        };
+        //----------------------------------------------------------------------
+        /// Creates a new widget from the definition or template. If this is
+        /// the first widget created, the reset states are built from it.
+        ///
+        /// @return The new widget.
+        //----------------------------------------------------------------------
+        WidgetSPtr CreateWidget();
+        //----------------------------------------------------------------------
+        /// Records the reset state of the given newly created widget and all
+        /// its children, in the order they will be visited by ResetRecursive.
+        ///
+        /// @param The widget.
+        /// @param The definition the widget was built from.
+        /// @param The description the widget was built from.
+        //----------------------------------------------------------------------
+        void BuildResetStatesRecursive(const Widget* in_widget, const WidgetDefCSPtr& in_widgetDef, const WidgetDesc& in_widgetDesc);
+        //----------------------------------------------------------------------
+        /// Resets the given widget and all its children to the recorded
+        /// state.
+        ///
+        /// @param The widget.
+        /// @param [In/Out] The index of the next reset state.
+        //----------------------------------------------------------------------
+        void ResetRecursive(Widget* in_widget, u32& io_stateIndex) const;
+        
+        WidgetDefCSPtr m_widgetDef;
+        WidgetTemplateCSPtr m_widgetTemplate;
+        std::vector<ResetState> m_resetStates;
+        std::vector<WidgetSPtr> m_freeWidgets;
+        std::unordered_set<const Widget*> m_acquiredWidgets;
+    };
+}
+
+#endif
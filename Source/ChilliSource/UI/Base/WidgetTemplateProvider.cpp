@@ -44,6 +44,7 @@ namespace ChilliSource
     namespace
     {
         const std::string k_extension("csui");
+        const std::string k_binaryExtension("csuibin");
         
         //-------------------------------------------------------
         /// Performs the heavy lifting for loading a UI
@@ -59,7 +60,9 @@ namespace ChilliSource
         void LoadDesc(StorageLocation in_storageLocation, const std::string& in_filepath, const ResourceProvider::AsyncLoadDelegate& in_delegate, const ResourceSPtr& out_resource)
         {
             Json::Value root;
-            if (JsonUtils::ReadJson(in_storageLocation, in_filepath, root) == false)
+            bool isBinary = StringUtils::EndsWith(in_filepath, "." + k_binaryExtension);
+            bool readSuccessful = isBinary ? JsonUtils::ReadBinaryJson(in_storageLocation, in_filepath, root) : JsonUtils::ReadJson(in_storageLocation, in_filepath, root);
+            if (readSuccessful == false)
             {
                 CS_LOG_ERROR("Cannot read widget file: " + in_filepath);
                 out_resource->SetLoadState(Resource::LoadState::k_failed);
@@ -117,17 +120,17 @@ namespace ChilliSource
     //-------------------------------------------------------
     bool WidgetTemplateProvider::CanCreateResourceWithFileExtension(const std::string& in_extension) const
     {
-        return (in_extension == k_extension);
+        return (in_extension == k_extension || in_extension == k_binaryExtension);
     }
     //-------------------------------------------------------
     //-------------------------------------------------------
-    void WidgetTemplateProvider::CreateResourceFromFile(StorageLocation in_storageLocation, const std::string& in_filepath, const IResourceOptionsBaseCSPtr& in_options, const ResourceSPtr& out_resource)
+    void WidgetTemplateProvider::CreateResourceFromFile(StorageLocation in_storageLocation, const std::string& in_filepath, const IResourceOptionsBaseCSPtr&, const ResourceSPtr& out_resource)
     {
         LoadDesc(in_storageLocation, in_filepath, nullptr, out_resource);
     }
     //----------------------------------------------------
     //----------------------------------------------------
-    void WidgetTemplateProvider::CreateResourceFromFileAsync(StorageLocation in_storageLocation, const std::string& in_filepath, const IResourceOptionsBaseCSPtr& in_options, const AsyncLoadDelegate& in_delegate, const ResourceSPtr& out_resource)
+    void WidgetTemplateProvider::CreateResourceFromFileAsync(StorageLocation, const std::string&, const IResourceOptionsBaseCSPtr&, const AsyncLoadDelegate&, const ResourceSPtr&)
     {
         //TODO: Async support.
         CS_LOG_FATAL("Asynchronous loading of Widget Templates is currently not supported. Feature coming soon!");
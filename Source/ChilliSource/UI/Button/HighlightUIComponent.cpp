@@ -187,7 +187,7 @@ namespace ChilliSource
     }
     //-------------------------------------------------------------------
     //-------------------------------------------------------------------
-    void HighlightUIComponent::OnPressedInside(Widget* in_widget, const Pointer& in_pointer, Pointer::InputType in_inputType)
+    void HighlightUIComponent::OnPressedInside(Widget*, const Pointer& in_pointer, Pointer::InputType in_inputType)
     {
         if (in_inputType == Pointer::GetDefaultInputType())
         {
@@ -205,7 +205,7 @@ namespace ChilliSource
     }
     //-------------------------------------------------------------------
     //-------------------------------------------------------------------
-    void HighlightUIComponent::OnMoveEntered(Widget* in_widget, const Pointer& in_pointer)
+    void HighlightUIComponent::OnMoveEntered(Widget*, const Pointer& in_pointer)
     {
         if (VectorUtils::Contains(m_activePointerIds, in_pointer.GetId()) == true)
         {
@@ -221,7 +221,7 @@ namespace ChilliSource
     }
     //-------------------------------------------------------------------
     //-------------------------------------------------------------------
-    void HighlightUIComponent::OnMoveExited(Widget* in_widget, const Pointer& in_pointer)
+    void HighlightUIComponent::OnMoveExited(Widget*, const Pointer& in_pointer)
     {
         if (VectorUtils::Contains(m_activePointerIds, in_pointer.GetId()) == true)
         {
@@ -237,7 +237,7 @@ namespace ChilliSource
     }
     //-------------------------------------------------------------------
     //-------------------------------------------------------------------
-    void HighlightUIComponent::OnReleasedInside(Widget* in_widget, const Pointer& in_pointer, Pointer::InputType in_inputType)
+    void HighlightUIComponent::OnReleasedInside(Widget*, const Pointer& in_pointer, Pointer::InputType)
     {
         if (VectorUtils::Contains(m_activePointerIds, in_pointer.GetId()) == true)
         {
@@ -254,7 +254,7 @@ namespace ChilliSource
     }
     //-------------------------------------------------------------------
     //-------------------------------------------------------------------
-    void HighlightUIComponent::OnReleasedOutside(Widget* in_widget, const Pointer& in_pointer, Pointer::InputType in_inputType)
+    void HighlightUIComponent::OnReleasedOutside(Widget*, const Pointer& in_pointer, Pointer::InputType)
     {
         if (VectorUtils::Contains(m_activePointerIds, in_pointer.GetId()) == true)
         {
@@ -367,7 +367,7 @@ namespace ChilliSource
     }
     //-------------------------------------------------------------------
     //-------------------------------------------------------------------
-    void ToggleHighlightUIComponent::OnPressedInside(Widget* in_widget, const Pointer& in_pointer, Pointer::InputType in_inputType)
+    void ToggleHighlightUIComponent::OnPressedInside(Widget*, const Pointer& in_pointer, Pointer::InputType in_inputType)
     {
         if (in_inputType == Pointer::GetDefaultInputType())
         {
@@ -385,7 +385,7 @@ namespace ChilliSource
     }
     //-------------------------------------------------------------------
     //-------------------------------------------------------------------
-    void ToggleHighlightUIComponent::OnMoveEntered(Widget* in_widget, const Pointer& in_pointer)
+    void ToggleHighlightUIComponent::OnMoveEntered(Widget*, const Pointer& in_pointer)
     {
         if (VectorUtils::Contains(m_activePointerIds, in_pointer.GetId()) == true)
         {
@@ -401,7 +401,7 @@ namespace ChilliSource
     }
     //-------------------------------------------------------------------
     //-------------------------------------------------------------------
-    void ToggleHighlightUIComponent::OnMoveExited(Widget* in_widget, const Pointer& in_pointer)
+    void ToggleHighlightUIComponent::OnMoveExited(Widget*, const Pointer& in_pointer)
     {
         if (VectorUtils::Contains(m_activePointerIds, in_pointer.GetId()) == true)
         {
@@ -417,7 +417,7 @@ namespace ChilliSource
     }
     //-------------------------------------------------------------------
     //-------------------------------------------------------------------
-    void ToggleHighlightUIComponent::OnReleasedInside(Widget* in_widget, const Pointer& in_pointer, Pointer::InputType in_inputType)
+    void ToggleHighlightUIComponent::OnReleasedInside(Widget*, const Pointer& in_pointer, Pointer::InputType)
     {
         if (VectorUtils::Contains(m_activePointerIds, in_pointer.GetId()) == true)
         {
@@ -435,7 +435,7 @@ namespace ChilliSource
     }
     //-------------------------------------------------------------------
     //-------------------------------------------------------------------
-    void ToggleHighlightUIComponent::OnReleasedOutside(Widget* in_widget, const Pointer& in_pointer, Pointer::InputType in_inputType)
+    void ToggleHighlightUIComponent::OnReleasedOutside(Widget*, const Pointer& in_pointer, Pointer::InputType)
     {
         if (VectorUtils::Contains(m_activePointerIds, in_pointer.GetId()) == true)
         {
@@ -72,6 +72,9 @@ namespace ChilliSource
     //-------------------------------------------------------------------
     UIDrawable* DrawableUIComponent::GetDrawable()
     {
+        //The drawable is likely to be modified via the returned pointer, so the draw list must be rebuilt.
+        InvalidateDrawList();
+        
         return m_drawable.get();
     }
     //-------------------------------------------------------------------
@@ -91,6 +94,8 @@ namespace ChilliSource
         {
             m_drawable = m_drawableDef->CreateDrawable();
         }
+        
+        InvalidateDrawList();
     }
     //-------------------------------------------------------------------
     //-------------------------------------------------------------------
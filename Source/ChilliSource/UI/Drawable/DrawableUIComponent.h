@@ -84,7 +84,11 @@ namespace ChilliSource
         ///
         /// @return The drawable object that performs the rendering. This
         /// can be used to directly change properties such as the UVs and
-        /// colour of the rendered image.
+        /// colour of the rendered image. As such, calling this invalidates
+        /// the draw list of the owning widget; prefer the const overload
+        /// when the drawable will not be modified. If the owning widget
+        /// retains its draw list the returned pointer should not be kept
+        /// and modified later, as that will not invalidate the list.
         //-------------------------------------------------------------------
         UIDrawable* GetDrawable();
         //-------------------------------------------------------------------
@@ -150,7 +150,7 @@ namespace ChilliSource
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     NinePatchUIDrawableDef::NinePatchUIDrawableDef(const TextureCSPtr& in_texture, const Vector4& in_insets, const Colour& in_colour, const UVs& in_uvs)
-    : m_texture(in_texture), m_insets(in_insets), m_colour(in_colour), m_uvs(in_uvs), m_drawMode(CanvasDrawMode::k_standard)
+    : m_texture(in_texture), m_uvs(in_uvs), m_colour(in_colour), m_insets(in_insets), m_drawMode(CanvasDrawMode::k_standard)
     {
         CS_ASSERT(m_texture != nullptr, "The texture cannot be null in a Nine-Patch UIDrawable Def.");
     }
@@ -158,7 +158,7 @@ namespace ChilliSource
     //--------------------------------------------------------------
     NinePatchUIDrawableDef::NinePatchUIDrawableDef(const TextureCSPtr& in_texture, const TextureAtlasCSPtr& in_atlas, const std::string& in_atlasId, const Vector4& in_insets,
                                                const Colour& in_colour, const UVs& in_uvs)
-    : m_texture(in_texture), m_atlas(in_atlas), m_atlasId(in_atlasId), m_insets(in_insets), m_colour(in_colour), m_uvs(in_uvs), m_drawMode(CanvasDrawMode::k_standard)
+    : m_texture(in_texture), m_atlas(in_atlas), m_atlasId(in_atlasId), m_uvs(in_uvs), m_colour(in_colour), m_insets(in_insets), m_drawMode(CanvasDrawMode::k_standard)
     {
         CS_ASSERT(m_texture != nullptr, "The texture cannot be null in a Nine-Patch UIDrawable Def.");
         CS_ASSERT(m_atlas != nullptr, "Cannot specify a null texture atlas in a Nine-Patch UIDrawable Def. Use the texture only constructor instead.");
@@ -147,14 +147,14 @@ namespace ChilliSource
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     StandardUIDrawableDef::StandardUIDrawableDef(const TextureCSPtr& in_texture, const Colour& in_colour, const UVs& in_uvs)
-    : m_texture(in_texture), m_colour(in_colour), m_uvs(in_uvs), m_drawMode(CanvasDrawMode::k_standard)
+    : m_texture(in_texture), m_uvs(in_uvs), m_colour(in_colour), m_drawMode(CanvasDrawMode::k_standard)
     {
         CS_ASSERT(m_texture != nullptr, "The texture cannot be null in a Standard UIDrawable Def.");
     }
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     StandardUIDrawableDef::StandardUIDrawableDef(const TextureCSPtr& in_texture, const TextureAtlasCSPtr& in_atlas, const std::string& in_atlasId, const Colour& in_colour, const UVs& in_uvs)
-    : m_texture(in_texture), m_atlas(in_atlas), m_atlasId(in_atlasId), m_colour(in_colour), m_uvs(in_uvs), m_drawMode(CanvasDrawMode::k_standard)
+    : m_texture(in_texture), m_atlas(in_atlas), m_atlasId(in_atlasId), m_uvs(in_uvs), m_colour(in_colour), m_drawMode(CanvasDrawMode::k_standard)
     {
         CS_ASSERT(m_texture != nullptr, "The texture cannot be null in a Standard UIDrawable Def.");
         CS_ASSERT(m_atlas != nullptr, "Cannot specify a null texture atlas in a Standard UIDrawable Def. Use the texture only constructor instead.");
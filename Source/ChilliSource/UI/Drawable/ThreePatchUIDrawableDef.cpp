@@ -190,7 +190,7 @@ namespace ChilliSource
     //--------------------------------------------------------------
     //--------------------------------------------------------------
     ThreePatchUIDrawableDef::ThreePatchUIDrawableDef(const TextureCSPtr& in_texture, const Vector2& in_insets, ThreePatchUIDrawable::Direction in_direction, const Colour& in_colour, const UVs& in_uvs)
-    : m_texture(in_texture), m_insets(in_insets), m_direction(in_direction), m_colour(in_colour), m_uvs(in_uvs), m_drawMode(CanvasDrawMode::k_standard)
+    : m_texture(in_texture), m_uvs(in_uvs), m_colour(in_colour), m_insets(in_insets), m_direction(in_direction), m_drawMode(CanvasDrawMode::k_standard)
     {
         CS_ASSERT(m_texture != nullptr, "The texture cannot be null in a Three-Patch UIDrawable Def.");
     }
@@ -198,7 +198,7 @@ namespace ChilliSource
     //--------------------------------------------------------------
     ThreePatchUIDrawableDef::ThreePatchUIDrawableDef(const TextureCSPtr& in_texture, const TextureAtlasCSPtr& in_atlas, const std::string& in_atlasId, const Vector2& in_insets, ThreePatchUIDrawable::Direction in_direction,
                                                  const Colour& in_colour, const UVs& in_uvs)
-    : m_texture(in_texture), m_atlas(in_atlas), m_atlasId(in_atlasId), m_insets(in_insets), m_direction(in_direction), m_colour(in_colour), m_uvs(in_uvs), m_drawMode(CanvasDrawMode::k_standard)
+    : m_texture(in_texture), m_atlas(in_atlas), m_atlasId(in_atlasId), m_uvs(in_uvs), m_colour(in_colour), m_insets(in_insets), m_direction(in_direction), m_drawMode(CanvasDrawMode::k_standard)
     {
         CS_ASSERT(m_texture != nullptr, "The texture cannot be null in a Three-Patch UIDrawable Def.");
         CS_ASSERT(m_atlas != nullptr, "Cannot specify a null texture atlas in a Three-Patch UIDrawable Def. Use the texture only constructor instead.");
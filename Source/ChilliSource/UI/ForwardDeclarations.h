@@ -48,6 +48,7 @@ namespace ChilliSource
     CS_FORWARDDECLARE_CLASS(WidgetDesc);
     CS_FORWARDDECLARE_CLASS(WidgetDefProvider);
     CS_FORWARDDECLARE_CLASS(WidgetFactory);
+    CS_FORWARDDECLARE_CLASS(WidgetPool);
     CS_FORWARDDECLARE_CLASS(WidgetTemplate);
     CS_FORWARDDECLARE_CLASS(WidgetTemplateProvider);
     //---------------------------------------------------------
@@ -163,7 +163,7 @@ namespace ChilliSource
     bool EditableTextUIComponent::OnTextChanged(const std::string& newText) noexcept
     {
         // Make sure text is within set size, otherwise reject.
-        if (newText.size() > m_maxCharacters)
+        if (newText.size() > std::string::size_type(m_maxCharacters))
         {
             return false;
         }
@@ -191,7 +191,7 @@ namespace ChilliSource
     }
 
     //-----------------------------------------------------------
-    void EditableTextUIComponent::OnReleasedInside(Widget* widget, const Pointer& pointer, Pointer::InputType inputType) noexcept
+    void EditableTextUIComponent::OnReleasedInside(Widget*, const Pointer&, Pointer::InputType) noexcept
     {
         // Toggle activation status when element is pressed.
         if (m_active)
@@ -205,7 +205,7 @@ namespace ChilliSource
     }
 
     //-----------------------------------------------------------
-    void EditableTextUIComponent::OnReleasedOutside(Widget* widget, const Pointer& pointer, Pointer::InputType inputType) noexcept
+    void EditableTextUIComponent::OnReleasedOutside(Widget*, const Pointer&, Pointer::InputType) noexcept
     {
         // If user presses outside of element, defocus and deactivate.
         if (m_active)
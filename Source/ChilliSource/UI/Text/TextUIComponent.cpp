@@ -223,6 +223,7 @@ namespace ChilliSource
         m_font = in_font;
         
         m_invalidateCache = true;
+        InvalidateDrawList();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
@@ -248,6 +249,7 @@ namespace ChilliSource
         }
         
         m_invalidateCache = true;
+        InvalidateDrawList();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
@@ -266,6 +268,7 @@ namespace ChilliSource
         }
         
         m_invalidateCache = true;
+        InvalidateDrawList();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
@@ -276,6 +279,7 @@ namespace ChilliSource
         ReplaceVariables(m_localisedText->GetText(in_localisedTextId), in_params, in_imageData);
         
         m_invalidateCache = true;
+        InvalidateDrawList();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
@@ -285,6 +289,7 @@ namespace ChilliSource
         m_text = in_text;
         
         m_invalidateCache = true;
+        InvalidateDrawList();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
@@ -293,12 +298,14 @@ namespace ChilliSource
         ReplaceVariables(in_text, {}, in_imageData);
         
         m_invalidateCache = true;
+        InvalidateDrawList();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
     void TextUIComponent::SetTextColour(const Colour& in_textColour)
     {
         m_textColour = in_textColour;
+        InvalidateDrawList();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
@@ -307,6 +314,7 @@ namespace ChilliSource
         m_textProperties.m_horizontalJustification = in_horizontalJustification;
         
         m_invalidateCache = true;
+        InvalidateDrawList();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
@@ -315,6 +323,7 @@ namespace ChilliSource
         m_textProperties.m_verticalJustification = in_verticalJustification;
         
         m_invalidateCache = true;
+        InvalidateDrawList();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
@@ -323,6 +332,7 @@ namespace ChilliSource
         m_textProperties.m_absCharSpacingOffset = in_offset;
         
         m_invalidateCache = true;
+        InvalidateDrawList();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
@@ -331,6 +341,7 @@ namespace ChilliSource
         m_textProperties.m_absLineSpacingOffset = in_offset;
         
         m_invalidateCache = true;
+        InvalidateDrawList();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
@@ -339,6 +350,7 @@ namespace ChilliSource
         m_textProperties.m_lineSpacingScale = in_scale;
         
         m_invalidateCache = true;
+        InvalidateDrawList();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
@@ -349,6 +361,7 @@ namespace ChilliSource
         m_textProperties.m_maxNumLines = in_numLines;
         
         m_invalidateCache = true;
+        InvalidateDrawList();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
@@ -357,6 +370,7 @@ namespace ChilliSource
         m_textProperties.m_textScale = in_scale;
         
         m_invalidateCache = true;
+        InvalidateDrawList();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
@@ -365,6 +379,7 @@ namespace ChilliSource
         m_textProperties.m_minTextScale = in_scale;
         
         m_invalidateCache = true;
+        InvalidateDrawList();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
@@ -373,6 +388,7 @@ namespace ChilliSource
         m_textProperties.m_shouldAutoScale = in_enable;
         
         m_invalidateCache = true;
+        InvalidateDrawList();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
@@ -411,7 +427,7 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
     std::string TextUIComponent::AddIcon(const FontCSPtr& in_font, const TextIconDictionary& in_iconDictionary, const std::string& in_iconName, const Font::CharacterInfo& in_spaceInfo,
-                                       const Font::CharacterInfo& in_markerInfo, u32& out_index, std::vector<TextIconIndex>& out_iconIndices)
+                                       const Font::CharacterInfo&, u32& out_index, std::vector<TextIconIndex>& out_iconIndices)
     {
         std::string iconText;
         
@@ -490,7 +506,7 @@ namespace ChilliSource
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
-    void TextUIComponent::OnDraw(CanvasRenderer* in_renderer, const Matrix3& in_transform, const Vector2& in_absSize, const Colour& in_absColour)
+    void TextUIComponent::OnDraw(CanvasRenderer* in_renderer, const Matrix3& in_transform, const Vector2& in_absSize, const Colour&)
     {
         if (m_cachedSize != in_absSize)
         {
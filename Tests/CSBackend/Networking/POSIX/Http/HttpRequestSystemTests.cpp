@@ -0,0 +1,462 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <CSBackend/Networking/POSIX/Http/HttpRequest.h>
+#include <CSBackend/Networking/POSIX/Http/HttpRequestSystem.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Base/DeviceInfo.h>
+#include <ChilliSource/Core/Base/LifecycleManager.h>
+#include <ChilliSource/Core/Base/RenderInfo.h>
+#include <ChilliSource/Core/Base/ScreenInfo.h>
+#include <ChilliSource/Core/Base/SystemInfo.h>
+#include <ChilliSource/Core/Container/ParamDictionary.h>
+#include <ChilliSource/Core/Math/Vector2.h>
+#include <ChilliSource/Core/Threading/TaskScheduler.h>
+#include <ChilliSource/Networking/Http/HttpResponse.h>
+
+#include <LocalHttpServer.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <thread>
+
+namespace
+{
+    using namespace ChilliSource;
+    using ChilliSource::Test::LocalHttpServer;
+    
+    /// A minimal application which only creates the http request system.
+    ///
+    class TestApplication final : public Application
+    {
+    public:
+        TestApplication() noexcept
+            : Application(SystemInfoCUPtr(new SystemInfo(DeviceInfo("Host", "Host", "Host", "", "en_GB", "en", "", 4), ScreenInfo(Vector2(1.0f, 1.0f), 1.0f, 1.0f, {}),
+                RenderInfo(false, false, false, false, 1024, 8), "1.0")))
+        {
+        }
+        
+        HttpRequestSystem* GetHttpRequestSystem() noexcept { return m_httpRequestSystem; }
+        
+    private:
+        void CreateSystems() noexcept override
+        {
+            m_httpRequestSystem = CreateSystem<HttpRequestSystem>();
+        }
+        
+        void OnInit() noexcept override {}
+        void PushInitialState() noexcept override {}
+        void OnDestroy() noexcept override {}
+        
+        HttpRequestSystem* m_httpRequestSystem = nullptr;
+    };
+    
+    /// A response delivered to a request delegate, along with the metrics of the request and
+    /// whether it was delivered on the main thread.
+    ///
+    struct DeliveredResponse final
+    {
+        HttpResponse::Result m_result;
+        u32 m_code;
+        std::string m_data;
+        ParamDictionary m_headers;
+        CSBackend::POSIX::HttpRequest::Metrics m_metrics;
+        bool m_isMainThread;
+    };
+    
+    /// Runs the POSIX http request system in a stepped application against a local server, with
+    /// the handler for each test set before the first request.
+    ///
+    class HttpRequestSystemTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            m_server.reset(new LocalHttpServer([this](const LocalHttpServer::Request& request)
+            {
+                return m_handler(request);
+            }));
+            
+            m_application.reset(new TestApplication());
+            m_lifecycleManager.reset(new LifecycleManager(m_application.get()));
+            m_httpRequestSystem = m_application->GetHttpRequestSystem();
+        }
+        
+        void TearDown() override
+        {
+            m_lifecycleManager.reset();
+            m_application.reset();
+            m_server.reset();
+        }
+        
+        /// @return A delegate which records every response delivered for a request.
+        ///
+        HttpRequest::Delegate RecordResponses()
+        {
+            return [this](const HttpRequest* request, const HttpResponse& response)
+            {
+                auto posixRequest = static_cast<const CSBackend::POSIX::HttpRequest*>(request);
+                DeliveredResponse delivered { response.GetResult(), response.GetCode(), response.GetDataAsString(), response.GetHeaders(), posixRequest->GetMetrics(),
+                    Application::Get()->GetTaskScheduler()->IsMainThread() };
+                m_responses.push_back(delivered);
+            };
+        }
+        
+        /// Steps the application until the given condition is met, failing the test if it takes
+        /// more than a few seconds.
+        ///
+        void UpdateUntil(const std::function<bool()>& condition)
+        {
+            auto start = std::chrono::steady_clock::now();
+            while (condition() == false)
+            {
+                ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(10)) << "Timed out waiting for the http request system.";
+                
+                m_lifecycleManager->SystemUpdate();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        
+        /// Steps the application until the given number of final (not flushed) responses have
+        /// been delivered.
+        ///
+        void UpdateUntilCompleted(u32 numRequests)
+        {
+            UpdateUntil([=]()
+            {
+                u32 numCompleted = 0;
+                for (const auto& response : m_responses)
+                {
+                    numCompleted += (response.m_result != HttpResponse::Result::k_flushed) ? 1 : 0;
+                }
+                return numCompleted >= numRequests;
+            });
+        }
+        
+        LocalHttpServer::Handler m_handler = [](const LocalHttpServer::Request&) { return LocalHttpServer::Response(); };
+        std::unique_ptr<LocalHttpServer> m_server;
+        std::unique_ptr<TestApplication> m_application;
+        std::unique_ptr<LifecycleManager> m_lifecycleManager;
+        HttpRequestSystem* m_httpRequestSystem = nullptr;
+        std::vector<DeliveredResponse> m_responses;
+    };
+    
+    /// @return A body of the given size which is not a repeated single byte.
+    ///
+    std::string CreateBody(u32 size)
+    {
+        std::string body(size, ' ');
+        for (u32 i = 0; i < size; ++i)
+        {
+            body[i] = char('a' + (i % 26));
+        }
+        return body;
+    }
+    
+    /// Checks that a GET receives the status, body and headers of a Content-Length framed response,
+    /// and that the delegate is called on the main thread.
+    ///
+    TEST_F(HttpRequestSystemTest, GetRequestReceivesResponse)
+    {
+        m_handler = [](const LocalHttpServer::Request& request)
+        {
+            LocalHttpServer::Response response;
+            response.m_headers.push_back(std::make_pair("X-Test", "value"));
+            response.m_body = "Hello from " + request.m_path;
+            return response;
+        };
+        
+        m_httpRequestSystem->MakeGetRequest(m_server->GetUrl("/hello?a=1"), RecordResponses());
+        UpdateUntilCompleted(1);
+        
+        ASSERT_EQ(1u, m_responses.size());
+        EXPECT_EQ(HttpResponse::Result::k_completed, m_responses[0].m_result);
+        EXPECT_EQ(200u, m_responses[0].m_code);
+        EXPECT_EQ("Hello from /hello?a=1", m_responses[0].m_data);
+        EXPECT_EQ("value", m_responses[0].m_headers.GetValue("X-Test"));
+        EXPECT_TRUE(m_responses[0].m_isMainThread);
+        
+        auto requests = m_server->GetRequests();
+        ASSERT_EQ(1u, requests.size());
+        EXPECT_EQ("GET", requests[0].m_method);
+        EXPECT_EQ("127.0.0.1:" + std::to_string(m_server->GetPort()), requests[0].m_headers["host"]);
+    }
+    
+    /// Checks that a POST sends its body and headers.
+    ///
+    TEST_F(HttpRequestSystemTest, PostRequestSendsBody)
+    {
+        ParamDictionary headers;
+        headers.SetValue("Content-Type", "application/json");
+        
+        m_httpRequestSystem->MakePostRequest(m_server->GetUrl("/post"), "{\"key\":\"value\"}", headers, RecordResponses());
+        UpdateUntilCompleted(1);
+        
+        auto requests = m_server->GetRequests();
+        ASSERT_EQ(1u, requests.size());
+        EXPECT_EQ("POST", requests[0].m_method);
+        EXPECT_EQ("{\"key\":\"value\"}", requests[0].m_body);
+        EXPECT_EQ("application/json", requests[0].m_headers["content-type"]);
+        EXPECT_EQ(HttpResponse::Result::k_completed, m_responses[0].m_result);
+    }
+    
+    /// Checks that consecutive requests to the same server reuse the pooled keep-alive connection.
+    ///
+    TEST_F(HttpRequestSystemTest, ConsecutiveRequestsReuseConnection)
+    {
+        for (u32 i = 0; i < 3; ++i)
+        {
+            m_httpRequestSystem->MakeGetRequest(m_server->GetUrl("/" + std::to_string(i)), RecordResponses());
+            UpdateUntilCompleted(i + 1);
+        }
+        
+        ASSERT_EQ(3u, m_responses.size());
+        EXPECT_FALSE(m_responses[0].m_metrics.m_isConnectionReused);
+        EXPECT_TRUE(m_responses[1].m_metrics.m_isConnectionReused);
+        EXPECT_TRUE(m_responses[2].m_metrics.m_isConnectionReused);
+        EXPECT_EQ(1u, m_server->GetNumConnections());
+    }
+    
+    /// Checks that a connection the server closes is not reused.
+    ///
+    TEST_F(HttpRequestSystemTest, ClosedConnectionIsNotReused)
+    {
+        m_handler = [](const LocalHttpServer::Request&)
+        {
+            LocalHttpServer::Response response;
+            response.m_isKeepAlive = false;
+            return response;
+        };
+        
+        m_httpRequestSystem->MakeGetRequest(m_server->GetUrl("/"), RecordResponses());
+        UpdateUntilCompleted(1);
+        m_httpRequestSystem->MakeGetRequest(m_server->GetUrl("/"), RecordResponses());
+        UpdateUntilCompleted(2);
+        
+        EXPECT_EQ(HttpResponse::Result::k_completed, m_responses[1].m_result);
+        EXPECT_FALSE(m_responses[1].m_metrics.m_isConnectionReused);
+        EXPECT_EQ(2u, m_server->GetNumConnections());
+    }
+    
+    /// Checks that chunked and close delimited bodies are decoded.
+    ///
+    TEST_F(HttpRequestSystemTest, ChunkedAndCloseDelimitedBodiesAreDecoded)
+    {
+        auto body = CreateBody(10000);
+        m_handler = [=](const LocalHttpServer::Request& request)
+        {
+            LocalHttpServer::Response response;
+            response.m_body = body;
+            response.m_chunkSize = 777;
+            response.m_framing = (request.m_path == "/chunked") ? LocalHttpServer::Framing::k_chunked : LocalHttpServer::Framing::k_closeDelimited;
+            return response;
+        };
+        
+        m_httpRequestSystem->MakeGetRequest(m_server->GetUrl("/chunked"), RecordResponses());
+        UpdateUntilCompleted(1);
+        m_httpRequestSystem->MakeGetRequest(m_server->GetUrl("/close"), RecordResponses());
+        UpdateUntilCompleted(2);
+        
+        ASSERT_EQ(2u, m_responses.size());
+        for (const auto& response : m_responses)
+        {
+            EXPECT_EQ(HttpResponse::Result::k_completed, response.m_result);
+            EXPECT_EQ(body, response.m_data);
+        }
+    }
+    
+    /// Checks that with a max buffer size the body is streamed to the delegate in flushed
+    /// responses, followed by a final response with the remainder.
+    ///
+    TEST_F(HttpRequestSystemTest, BodyIsFlushedWhenMaxBufferSizeIsReached)
+    {
+        const u32 k_bufferSize = 4096;
+        auto body = CreateBody(k_bufferSize * 3 + 100);
+        m_handler = [=](const LocalHttpServer::Request&)
+        {
+            LocalHttpServer::Response response;
+            response.m_body = body;
+            response.m_framing = LocalHttpServer::Framing::k_chunked;
+            return response;
+        };
+        
+        m_httpRequestSystem->SetMaxBufferSize(k_bufferSize);
+        m_httpRequestSystem->MakeGetRequest(m_server->GetUrl("/large"), RecordResponses());
+        UpdateUntilCompleted(1);
+        
+        ASSERT_EQ(4u, m_responses.size());
+        
+        std::string received;
+        for (u32 i = 0; i < 3; ++i)
+        {
+            EXPECT_EQ(HttpResponse::Result::k_flushed, m_responses[i].m_result);
+            EXPECT_EQ(200u, m_responses[i].m_code);
+            EXPECT_GE(m_responses[i].m_data.size(), k_bufferSize);
+            received += m_responses[i].m_data;
+        }
+        
+        EXPECT_EQ(HttpResponse::Result::k_completed, m_responses[3].m_result);
+        received += m_responses[3].m_data;
+        EXPECT_EQ(body, received);
+    }
+    
+    /// Checks that redirects are followed, with the final response delivered and the body of the
+    /// redirect discarded.
+    ///
+    TEST_F(HttpRequestSystemTest, RedirectIsFollowed)
+    {
+        m_handler = [](const LocalHttpServer::Request& request)
+        {
+            LocalHttpServer::Response response;
+            if (request.m_path == "/old")
+            {
+                response.m_code = 302;
+                response.m_headers.push_back(std::make_pair("Location", "/new"));
+                response.m_body = "Moved";
+            }
+            else
+            {
+                response.m_body = "New";
+            }
+            return response;
+        };
+        
+        m_httpRequestSystem->MakeGetRequest(m_server->GetUrl("/old"), RecordResponses());
+        UpdateUntilCompleted(1);
+        
+        EXPECT_EQ(HttpResponse::Result::k_completed, m_responses[0].m_result);
+        EXPECT_EQ(200u, m_responses[0].m_code);
+        EXPECT_EQ("New", m_responses[0].m_data);
+        EXPECT_EQ(1u, m_responses[0].m_metrics.m_numRedirects);
+        EXPECT_EQ(1u, m_server->GetNumConnections());
+    }
+    
+    /// Checks that non-2xx responses are delivered as completed with their status code and body.
+    ///
+    TEST_F(HttpRequestSystemTest, ErrorStatusIsDelivered)
+    {
+        m_handler = [](const LocalHttpServer::Request&)
+        {
+            LocalHttpServer::Response response;
+            response.m_code = 404;
+            response.m_body = "Missing";
+            return response;
+        };
+        
+        m_httpRequestSystem->MakeGetRequest(m_server->GetUrl("/missing"), RecordResponses());
+        UpdateUntilCompleted(1);
+        
+        EXPECT_EQ(HttpResponse::Result::k_completed, m_responses[0].m_result);
+        EXPECT_EQ(404u, m_responses[0].m_code);
+        EXPECT_EQ("Missing", m_responses[0].m_data);
+    }
+    
+    /// Checks that https urls, whether requested directly or redirected to, fail as unsupported
+    /// without anything being sent.
+    ///
+    TEST_F(HttpRequestSystemTest, HttpsRequestIsUnsupported)
+    {
+        m_handler = [](const LocalHttpServer::Request&)
+        {
+            LocalHttpServer::Response response;
+            response.m_code = 301;
+            response.m_headers.push_back(std::make_pair("Location", "https://127.0.0.1/secure"));
+            return response;
+        };
+        
+        m_httpRequestSystem->MakeGetRequest("https://127.0.0.1:" + std::to_string(m_server->GetPort()) + "/", RecordResponses());
+        UpdateUntilCompleted(1);
+        
+        EXPECT_EQ(HttpResponse::Result::k_unsupported, m_responses[0].m_result);
+        EXPECT_EQ(0u, m_responses[0].m_code);
+        EXPECT_EQ(0u, m_server->GetNumConnections());
+        
+        m_httpRequestSystem->MakeGetRequest(m_server->GetUrl("/insecure"), RecordResponses());
+        UpdateUntilCompleted(2);
+        
+        EXPECT_EQ(HttpResponse::Result::k_unsupported, m_responses[1].m_result);
+        EXPECT_EQ(1u, m_server->GetRequests().size());
+    }
+    
+    /// Checks that a server which stops responding causes the request to time out.
+    ///
+    TEST_F(HttpRequestSystemTest, UnresponsiveServerTimesOut)
+    {
+        m_handler = [](const LocalHttpServer::Request&)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2500));
+            return LocalHttpServer::Response();
+        };
+        
+        m_httpRequestSystem->MakeGetRequest(m_server->GetUrl("/slow"), RecordResponses(), 1);
+        UpdateUntilCompleted(1);
+        
+        EXPECT_EQ(HttpResponse::Result::k_timeout, m_responses[0].m_result);
+    }
+    
+    /// Checks that a cancelled request never calls its delegate.
+    ///
+    TEST_F(HttpRequestSystemTest, CancelledRequestIsNotDelivered)
+    {
+        m_handler = [](const LocalHttpServer::Request&)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            return LocalHttpServer::Response();
+        };
+        
+        auto request = m_httpRequestSystem->MakeGetRequest(m_server->GetUrl("/cancel"), RecordResponses());
+        request->Cancel();
+        m_httpRequestSystem->MakeGetRequest(m_server->GetUrl("/after"), RecordResponses());
+        UpdateUntilCompleted(1);
+        
+        ASSERT_EQ(1u, m_responses.size());
+        EXPECT_EQ(HttpResponse::Result::k_completed, m_responses[0].m_result);
+    }
+    
+    /// Checks that reachability is determined off the main thread and delivered on it in a later
+    /// update. Whether the host is reachable depends on its network interfaces, so the value isn't
+    /// checked.
+    ///
+    TEST_F(HttpRequestSystemTest, ReachabilityIsDeliveredOnMainThread)
+    {
+        u32 numCalls = 0;
+        bool isMainThread = false;
+        m_httpRequestSystem->CheckReachability([&](bool)
+        {
+            ++numCalls;
+            isMainThread = Application::Get()->GetTaskScheduler()->IsMainThread();
+        });
+        
+        EXPECT_EQ(0u, numCalls);
+        
+        UpdateUntil([&]() { return numCalls > 0; });
+        
+        EXPECT_EQ(1u, numCalls);
+        EXPECT_TRUE(isMainThread);
+    }
+}
@@ -0,0 +1,306 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <CSBackend/Rendering/OpenGL/Base/RenderCommandProcessor.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Math/Geometry/Shapes.h>
+#include <ChilliSource/Core/Math/Matrix4.h>
+#include <ChilliSource/Core/Memory/PagedLinearAllocator.h>
+#include <ChilliSource/Rendering/Base/BlendMode.h>
+#include <ChilliSource/Rendering/Base/CullFace.h>
+#include <ChilliSource/Rendering/Base/StencilOp.h>
+#include <ChilliSource/Rendering/Base/TestFunc.h>
+#include <ChilliSource/Rendering/Material/RenderMaterial.h>
+#include <ChilliSource/Rendering/Model/RenderMesh.h>
+#include <ChilliSource/Rendering/Model/RenderMeshManager.h>
+#include <ChilliSource/Rendering/RenderCommand/RenderCommandBuffer.h>
+#include <ChilliSource/Rendering/RenderCommand/RenderCommandList.h>
+#include <ChilliSource/Rendering/Shader/RenderShader.h>
+#include <ChilliSource/Rendering/Shader/RenderShaderManager.h>
+
+#include <GLRecorder.h>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    using namespace ChilliSource;
+    namespace GLRecorder = ChilliSource::Test::GLRecorder;
+    using GLRecorder::Call;
+    
+    constexpr u32 k_numInstances = 5;
+    constexpr u32 k_numQuadVertices = 4;
+    constexpr u32 k_numQuadIndices = 6;
+    
+    /// A minimal application which only exists to own the systems created by a test.
+    ///
+    class TestApplication final : public Application
+    {
+    public:
+        TestApplication() noexcept : Application(nullptr) {}
+        
+    private:
+        void CreateSystems() noexcept override {}
+        void OnInit() noexcept override {}
+        void PushInitialState() noexcept override {}
+        void OnDestroy() noexcept override {}
+    };
+    
+    /// Reads the vertex and fragment GLSL source from the given stock .csshader.
+    ///
+    /// @param fileName
+    ///     The name of the shader in CSResources/Shaders.
+    /// @param [Out] vertexShader
+    ///     The vertex shader source.
+    /// @param [Out] fragmentShader
+    ///     The fragment shader source.
+    ///
+    void ReadStockShader(const std::string& fileName, std::string& vertexShader, std::string& fragmentShader)
+    {
+        std::ifstream file(std::string(CS_TEST_RESOURCES_DIR) + "/Shaders/" + fileName);
+        ASSERT_TRUE(file.good()) << "Cannot open " << fileName;
+        
+        std::stringstream contents;
+        contents << file.rdbuf();
+        auto source = contents.str();
+        
+        auto fragmentStart = source.find("FragmentShader");
+        ASSERT_NE(std::string::npos, fragmentStart);
+        
+        vertexShader = source.substr(0, fragmentStart);
+        fragmentShader = source.substr(fragmentStart);
+    }
+    
+    /// Processes the render commands for a frame which loads a quad and the given stock shader, then
+    /// draws the quad at a series of positions with a single RenderInstances command, recording
+    /// the GL calls made.
+    ///
+    class RenderCommandProcessorTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            m_renderShaderManager = m_application.CreateSystem<RenderShaderManager>();
+            m_renderMeshManager = m_application.CreateSystem<RenderMeshManager>();
+            
+            for (u32 i = 0; i < k_numInstances; ++i)
+            {
+                m_worldMatrices[i] = Matrix4::CreateTranslation(Vector3(f32(i), 2.0f, 3.0f));
+            }
+        }
+        
+        void TearDown() override
+        {
+            m_renderCommandProcessor.reset();
+            m_renderMaterial.reset();
+            
+            if (m_renderMesh)
+            {
+                m_renderMeshManager->DestroyRenderMesh(m_renderMesh);
+            }
+            if (m_renderShader)
+            {
+                m_renderShaderManager->DestroyRenderShader(m_renderShader);
+            }
+        }
+        
+        /// Resets the GL stub to look like a context with the given version and extensions, and
+        /// processes a frame which loads the given shader and the quad.
+        ///
+        void LoadResources(const std::string& glVersion, const std::string& glExtensions, const std::string& shaderFileName)
+        {
+            GLRecorder::Reset(glVersion, glExtensions);
+            
+            std::string vertexShader, fragmentShader;
+            ReadStockShader(shaderFileName, vertexShader, fragmentShader);
+            
+            m_renderShader = m_renderShaderManager->CreateRenderShader(vertexShader, fragmentShader);
+            m_renderMesh = m_renderMeshManager->CreateRenderMesh(PolygonType::k_triangle, VertexFormat::k_staticMesh, IndexFormat::k_short, k_numQuadVertices, k_numQuadIndices,
+                                                                 Sphere(Vector3::k_zero, 1.0f), nullptr, 0, nullptr, 0, false);
+            
+            m_renderMaterial.reset(new RenderMaterial(m_renderShader, std::vector<const RenderTexture*>(), std::vector<const RenderTexture*>(), false, true, true, true, true, false,
+                                                      TestFunc::k_lessEqual, BlendMode::k_one, BlendMode::k_zero, StencilOp::k_keep, StencilOp::k_keep, StencilOp::k_keep, TestFunc::k_always, 0, 0xff,
+                                                      CullFace::k_back, Colour::k_white, Colour::k_black, Colour::k_white, Colour::k_black, nullptr));
+            
+            auto vertexDataSize = k_numQuadVertices * VertexFormat::k_staticMesh.GetSize();
+            auto indexDataSize = k_numQuadIndices * u32(sizeof(u16));
+            std::unique_ptr<const u8[]> vertexData(new u8[vertexDataSize]());
+            std::unique_ptr<const u8[]> indexData(new u8[indexDataSize]());
+            
+            m_renderCommandProcessor.reset(new CSBackend::OpenGL::RenderCommandProcessor());
+            
+            RenderCommandBuffer renderCommandBuffer(1, &m_frameAllocator, std::vector<RenderFrameData>());
+            auto renderCommandList = renderCommandBuffer.GetRenderCommandList(0);
+            renderCommandList->AddLoadShaderCommand(const_cast<RenderShader*>(m_renderShader), vertexShader, fragmentShader);
+            renderCommandList->AddLoadMeshCommand(const_cast<RenderMesh*>(m_renderMesh), std::move(vertexData), vertexDataSize, std::move(indexData), indexDataSize);
+            m_renderCommandProcessor->Process(&renderCommandBuffer);
+        }
+        
+        /// Processes a frame which draws the quad once per world matrix, then returns the calls made.
+        ///
+        const std::vector<Call>& RenderInstances()
+        {
+            GLRecorder::ClearCalls();
+            
+            RenderCommandBuffer renderCommandBuffer(1, &m_frameAllocator, std::vector<RenderFrameData>());
+            auto renderCommandList = renderCommandBuffer.GetRenderCommandList(0);
+            renderCommandList->AddBeginCommand(Integer2(640, 480), Colour::k_black);
+            renderCommandList->AddApplyCameraCommand(Vector3::k_zero, Matrix4::k_identity, Matrix4::k_identity);
+            renderCommandList->AddApplyMaterialCommand(m_renderMaterial.get());
+            renderCommandList->AddApplyMeshCommand(m_renderMesh);
+            renderCommandList->AddRenderInstancesCommand(m_worldMatrices, k_numInstances);
+            renderCommandList->AddEndCommand();
+            m_renderCommandProcessor->Process(&renderCommandBuffer);
+            
+            return GLRecorder::GetCalls();
+        }
+        
+        /// @return The location the GL stub assigned to the per-instance world matrix attribute.
+        ///
+        GLuint GetInstanceAttributeLocation() const
+        {
+            // The stub lays attributes out in declaration order: a_position, a_texCoord, then
+            // a_instanceWorldMat.
+            return 2;
+        }
+        
+        TestApplication m_application;
+        PagedLinearAllocator m_frameAllocator;
+        RenderShaderManager* m_renderShaderManager = nullptr;
+        RenderMeshManager* m_renderMeshManager = nullptr;
+        const RenderShader* m_renderShader = nullptr;
+        const RenderMesh* m_renderMesh = nullptr;
+        std::unique_ptr<RenderMaterial> m_renderMaterial;
+        std::unique_ptr<CSBackend::OpenGL::RenderCommandProcessor> m_renderCommandProcessor;
+        Matrix4 m_worldMatrices[k_numInstances];
+    };
+    
+    /// Checks that a GLES 3.0 context draws all instances with a single instanced draw call, uploading
+    /// the world matrices once and resetting the attribute divisors afterwards.
+    ///
+    TEST_F(RenderCommandProcessorTest, InstancedShaderIsDrawnWithOneCallOnGLES3)
+    {
+        LoadResources("OpenGL ES 3.0", "", "Static-UnlitInstanced.csshader");
+        RenderInstances();
+        
+        EXPECT_EQ(0u, GLRecorder::CountCalls("glDrawElements"));
+        
+        auto draws = GLRecorder::GetCalls("glDrawElementsInstanced");
+        ASSERT_EQ(1u, draws.size());
+        EXPECT_EQ(GL_TRIANGLES, draws[0].m_args[0]);
+        EXPECT_EQ(s64(k_numQuadIndices), draws[0].m_args[1]);
+        EXPECT_EQ(s64(k_numInstances), draws[0].m_args[3]);
+        
+        auto uploads = GLRecorder::GetCalls("glBufferData");
+        ASSERT_EQ(1u, uploads.size());
+        EXPECT_EQ(s64(sizeof(Matrix4) * k_numInstances), uploads[0].m_args[1]);
+        
+        auto divisors = GLRecorder::GetCalls("glVertexAttribDivisor");
+        ASSERT_EQ(8u, divisors.size());
+        for (u32 i = 0; i < 4; ++i)
+        {
+            EXPECT_EQ(s64(GetInstanceAttributeLocation() + i), divisors[i].m_args[0]);
+            EXPECT_EQ(1, divisors[i].m_args[1]);
+            EXPECT_EQ(s64(GetInstanceAttributeLocation() + i), divisors[4 + i].m_args[0]);
+            EXPECT_EQ(0, divisors[4 + i].m_args[1]);
+        }
+    }
+    
+    /// Checks that GLES 2.0 drivers exposing GL_EXT_instanced_arrays also use instanced drawing.
+    ///
+    TEST_F(RenderCommandProcessorTest, InstancedShaderIsDrawnWithOneCallWithExtension)
+    {
+        LoadResources("OpenGL ES 2.0", "GL_OES_rgb8_rgba8 GL_EXT_instanced_arrays", "Static-UnlitInstanced.csshader");
+        RenderInstances();
+        
+        EXPECT_EQ(1u, GLRecorder::CountCalls("glDrawElementsInstanced"));
+        EXPECT_EQ(0u, GLRecorder::CountCalls("glDrawElements"));
+    }
+    
+    /// Checks that without instancing support the instanced shader is drawn once per instance, with
+    /// the world matrix supplied as a constant attribute value.
+    ///
+    TEST_F(RenderCommandProcessorTest, InstancedShaderFallsBackToConstantAttributeWithoutSupport)
+    {
+        LoadResources("OpenGL ES 2.0", "GL_OES_rgb8_rgba8", "Static-UnlitInstanced.csshader");
+        RenderInstances();
+        
+        EXPECT_EQ(0u, GLRecorder::CountCalls("glDrawElementsInstanced"));
+        EXPECT_EQ(k_numInstances, GLRecorder::CountCalls("glDrawElements"));
+        
+        auto attributes = GLRecorder::GetCalls("glVertexAttrib4fv");
+        ASSERT_EQ(4 * k_numInstances, attributes.size());
+        for (u32 instance = 0; instance < k_numInstances; ++instance)
+        {
+            for (u32 column = 0; column < 4; ++column)
+            {
+                const auto& attribute = attributes[instance * 4 + column];
+                EXPECT_EQ(s64(GetInstanceAttributeLocation() + column), attribute.m_args[0]);
+                for (u32 row = 0; row < 4; ++row)
+                {
+                    EXPECT_EQ(m_worldMatrices[instance].m[column * 4 + row], attribute.m_floats[row]);
+                }
+            }
+        }
+    }
+    
+    /// Checks that shaders which don't declare the per-instance attribute are drawn once per instance
+    /// even when instancing is supported.
+    ///
+    TEST_F(RenderCommandProcessorTest, StandardShaderIsDrawnPerInstance)
+    {
+        LoadResources("OpenGL ES 3.0", "", "Static-Unlit.csshader");
+        RenderInstances();
+        
+        EXPECT_EQ(0u, GLRecorder::CountCalls("glDrawElementsInstanced"));
+        EXPECT_EQ(0u, GLRecorder::CountCalls("glVertexAttrib4fv"));
+        EXPECT_EQ(k_numInstances, GLRecorder::CountCalls("glDrawElements"));
+    }
+    
+    /// Checks that the instance buffer is created once and reused, then recreated after the context
+    /// has been lost.
+    ///
+    TEST_F(RenderCommandProcessorTest, InstanceBufferIsRecreatedAfterContextLoss)
+    {
+        LoadResources("OpenGL ES 3.0", "", "Static-UnlitInstanced.csshader");
+        
+        RenderInstances();
+        EXPECT_EQ(1u, GLRecorder::CountCalls("glGenBuffers"));
+        
+        RenderInstances();
+        EXPECT_EQ(0u, GLRecorder::CountCalls("glGenBuffers"));
+        
+        m_renderCommandProcessor->Invalidate();
+        m_renderCommandProcessor->Restore();
+        
+        RenderInstances();
+        EXPECT_EQ(1u, GLRecorder::CountCalls("glGenBuffers"));
+        EXPECT_EQ(1u, GLRecorder::CountCalls("glDrawElementsInstanced"));
+    }
+}
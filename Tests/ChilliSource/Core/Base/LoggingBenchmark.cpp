@@ -0,0 +1,279 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Base/Logging.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Base/DeviceInfo.h>
+#include <ChilliSource/Core/Base/LifecycleManager.h>
+#include <ChilliSource/Core/Base/RenderInfo.h>
+#include <ChilliSource/Core/Base/ScreenInfo.h>
+#include <ChilliSource/Core/Base/SystemInfo.h>
+#include <ChilliSource/Core/Math/Vector2.h>
+#include <ChilliSource/Core/Threading/TaskContext.h>
+#include <ChilliSource/Core/Threading/TaskPool.h>
+#include <ChilliSource/Core/Threading/TaskType.h>
+
+#include <json/json.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// Benchmarks the engine's asynchronous logging with a range of thread counts. Each thread is a
+// task pool thread which logs a fixed number of formatted messages as fast as it can, so the
+// threads contend on the message queue. The time taken for every task to finish logging is
+// reported, along with the time until the writer thread has output every message.
+//
+// Messages are written to stderr by the Android log stub, so stderr is redirected to a log file
+// while each run is measured. The log file is then checked to make sure no messages were lost.
+// Configure with CMAKE_BUILD_TYPE=Release for meaningful timings.
+//
+//   LoggingBenchmark [--messages <count per thread>] [--threads <count,count,...>] [--log <file>] [--output <file.json>]
+//
+// A table is printed for reading, and the full results are written as JSON for tracking over
+// time if an output file is given.
+
+namespace
+{
+    using namespace ChilliSource;
+    
+    constexpr u32 k_defaultNumMessages = 50000;
+    const char k_defaultLogFilePath[] = "LoggingBenchmark.log";
+    const char k_messagePrefix[] = "[Chilli Source] Message ";
+    
+    /// A minimal application with only the default systems. The application creates and
+    /// destroys the logger.
+    ///
+    class BenchmarkApplication final : public Application
+    {
+    public:
+        BenchmarkApplication() noexcept
+            : Application(SystemInfoCUPtr(new SystemInfo(DeviceInfo("Host", "Host", "Host", "", "en_GB", "en", "", 4), ScreenInfo(Vector2(1.0f, 1.0f), 1.0f, 1.0f, {}),
+                RenderInfo(false, false, false, false, 1024, 8), "1.0")))
+        {
+        }
+        
+    private:
+        void CreateSystems() noexcept override {}
+        void OnInit() noexcept override {}
+        void PushInitialState() noexcept override {}
+        void OnDestroy() noexcept override {}
+    };
+    
+    /// The results of a single run.
+    ///
+    struct RunResult final
+    {
+        u32 m_numThreads = 0;
+        f64 m_logMs = 0.0;
+        f64 m_totalMs = 0.0;
+        bool m_isComplete = false;
+    };
+    
+    /// @return The number of benchmark messages in the given log file.
+    ///
+    u32 CountMessages(const std::string& logFilePath)
+    {
+        std::ifstream file(logFilePath);
+        
+        u32 count = 0;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.compare(0, sizeof(k_messagePrefix) - 1, k_messagePrefix) == 0)
+            {
+                ++count;
+            }
+        }
+        
+        return count;
+    }
+    
+    /// Logs the given number of messages from each of the given number of threads, with stderr
+    /// redirected to the given log file.
+    ///
+    /// @return The time taken for the threads to log the messages and for them to be output,
+    /// and whether every message was output.
+    ///
+    RunResult Run(u32 numThreads, u32 numMessages, const std::string& logFilePath) noexcept
+    {
+        //The calling thread also processes tasks while it waits for them.
+        TaskPool taskPool(TaskType::k_small, numThreads - 1);
+        
+        std::vector<Task> tasks;
+        for (u32 thread = 0; thread < numThreads; ++thread)
+        {
+            tasks.push_back([=](const TaskContext&)
+            {
+                for (u32 message = 0; message < numMessages; ++message)
+                {
+                    CS_LOG_VERBOSE_FMT("Message %u from thread %u", message, thread);
+                }
+            });
+        }
+        
+        RunResult result;
+        result.m_numThreads = numThreads;
+        
+        std::fflush(stderr);
+        int stderrFileDescriptor = dup(fileno(stderr));
+        if (stderrFileDescriptor < 0 || std::freopen(logFilePath.c_str(), "w", stderr) == nullptr)
+        {
+            return result;
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        taskPool.AddTasksAndYield(tasks);
+        std::chrono::duration<f64, std::milli> logElapsed = std::chrono::steady_clock::now() - start;
+        Logging::Get()->Flush();
+        std::chrono::duration<f64, std::milli> totalElapsed = std::chrono::steady_clock::now() - start;
+        
+        std::fflush(stderr);
+        dup2(stderrFileDescriptor, fileno(stderr));
+        close(stderrFileDescriptor);
+        
+        result.m_logMs = logElapsed.count();
+        result.m_totalMs = totalElapsed.count();
+        result.m_isComplete = (CountMessages(logFilePath) == numThreads * numMessages);
+        return result;
+    }
+    
+    /// Parses a comma separated list of thread counts.
+    ///
+    /// @return Whether the list was valid.
+    ///
+    bool ParseThreadCounts(const std::string& list, std::vector<u32>& out_threadCounts)
+    {
+        std::vector<u32> threadCounts;
+        std::size_t start = 0;
+        while (start <= list.size())
+        {
+            std::size_t end = list.find(',', start);
+            if (end == std::string::npos)
+            {
+                end = list.size();
+            }
+            
+            int count = std::atoi(list.substr(start, end - start).c_str());
+            if (count <= 0)
+            {
+                return false;
+            }
+            threadCounts.push_back(u32(count));
+            start = end + 1;
+        }
+        
+        out_threadCounts = threadCounts;
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    u32 numMessages = k_defaultNumMessages;
+    std::vector<u32> threadCounts = { 1, 2, 4, 8 };
+    std::string logFilePath = k_defaultLogFilePath;
+    std::string outputFilePath;
+    
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        bool hasValue = (i + 1 < argc);
+        
+        if (argument == "--messages" && hasValue && std::atoi(argv[i + 1]) > 0)
+        {
+            numMessages = u32(std::atoi(argv[++i]));
+        }
+        else if (argument == "--threads" && hasValue && ParseThreadCounts(argv[i + 1], threadCounts))
+        {
+            ++i;
+        }
+        else if (argument == "--log" && hasValue)
+        {
+            logFilePath = argv[++i];
+        }
+        else if (argument == "--output" && hasValue)
+        {
+            outputFilePath = argv[++i];
+        }
+        else
+        {
+            std::fprintf(stderr, "Usage: %s [--messages <count per thread>] [--threads <count,count,...>] [--log <file>] [--output <file.json>]\n", argv[0]);
+            return 1;
+        }
+    }
+    
+    BenchmarkApplication application;
+    LifecycleManager lifecycleManager(&application);
+    
+    std::printf("Time for each thread to log %u messages, and for every message to be output.\n\n", numMessages);
+    std::printf("%7s %12s %14s %12s %14s\n", "Threads", "Log (ms)", "Logged/s", "Total (ms)", "Output/s");
+    
+    Json::Value runs(Json::arrayValue);
+    bool isValid = true;
+    for (auto numThreads : threadCounts)
+    {
+        auto result = Run(numThreads, numMessages, logFilePath);
+        f64 numTotalMessages = f64(numThreads) * numMessages;
+        f64 loggedPerSecond = (result.m_logMs > 0.0) ? numTotalMessages / (result.m_logMs / 1000.0) : 0.0;
+        f64 outputPerSecond = (result.m_totalMs > 0.0) ? numTotalMessages / (result.m_totalMs / 1000.0) : 0.0;
+        std::printf("%7u %12.3f %14.0f %12.3f %14.0f\n", numThreads, result.m_logMs, loggedPerSecond, result.m_totalMs, outputPerSecond);
+        
+        if (result.m_isComplete == false)
+        {
+            std::fprintf(stderr, "Not every message logged by %u threads was written to '%s'.\n", numThreads, logFilePath.c_str());
+            isValid = false;
+        }
+        
+        Json::Value run(Json::objectValue);
+        run["NumThreads"] = Json::UInt(numThreads);
+        run["LogMs"] = result.m_logMs;
+        run["TotalMs"] = result.m_totalMs;
+        run["LoggedPerSecond"] = loggedPerSecond;
+        run["OutputPerSecond"] = outputPerSecond;
+        runs.append(run);
+    }
+    
+    if (outputFilePath.empty() == false)
+    {
+        Json::Value output(Json::objectValue);
+        output["NumMessages"] = Json::UInt(numMessages);
+        output["Runs"] = runs;
+        
+        std::ofstream file(outputFilePath);
+        file << Json::StyledWriter().write(output);
+        if (file.good() == false)
+        {
+            std::fprintf(stderr, "Could not write the results to '%s'.\n", outputFilePath.c_str());
+            return 1;
+        }
+    }
+    
+    return isValid ? 0 : 1;
+}
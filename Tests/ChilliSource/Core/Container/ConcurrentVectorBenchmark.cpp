@@ -0,0 +1,358 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Container/concurrent_vector.h>
+
+#include <json/json.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Benchmarks iterating a concurrent_vector, as the widget tree does each frame, against the
+// previous implementation, which locked a recursive mutex on every dereference and increment.
+// Each scenario is run with each requested number of reader threads. The readers repeatedly
+// iterate a vector of widget-sized elements; in the contended scenario a writer thread
+// continually adds and removes elements at the same time. The time per element is measured per
+// reader, so it only stays flat as readers are added while there is a core for each of them.
+// Configure with CMAKE_BUILD_TYPE=Release for meaningful timings.
+//
+//   ConcurrentVectorBenchmark [--duration <ms>] [--threads <count,count,...>] [--output <file.json>]
+//
+// A table is printed for reading, and the full results are written as JSON for tracking over
+// time if an output file is given.
+
+namespace
+{
+    using namespace ChilliSource;
+    
+    constexpr u32 k_defaultDurationMs = 500;
+    constexpr u32 k_numElements = 1000;
+    
+    /// A reduced copy of the concurrent_vector this replaced: the elements are stored by value
+    /// and iterators lock the vector's recursive mutex on every dereference and increment.
+    ///
+    template <typename TType> class LockingVector final
+    {
+    public:
+        class iterator final
+        {
+        public:
+            iterator(LockingVector* in_vector, std::size_t in_index)
+                : m_vector(in_vector), m_index(in_index)
+            {
+            }
+            
+            iterator& operator++()
+            {
+                std::unique_lock<std::recursive_mutex> scopedLock(m_vector->m_mutex);
+                ++m_index;
+                return *this;
+            }
+            
+            TType& operator*()
+            {
+                std::unique_lock<std::recursive_mutex> scopedLock(m_vector->m_mutex);
+                return m_vector->m_objects[m_index];
+            }
+            
+            bool operator!=(const iterator& in_toCompare)
+            {
+                std::unique_lock<std::recursive_mutex> scopedLock(m_vector->m_mutex);
+                return std::min(m_index, m_vector->m_objects.size()) != std::min(in_toCompare.m_index, m_vector->m_objects.size());
+            }
+            
+        private:
+            LockingVector* m_vector;
+            std::size_t m_index;
+        };
+        
+        void push_back(const TType& in_object)
+        {
+            std::unique_lock<std::recursive_mutex> scopedLock(m_mutex);
+            m_objects.push_back(in_object);
+        }
+        
+        void erase_front()
+        {
+            std::unique_lock<std::recursive_mutex> scopedLock(m_mutex);
+            m_objects.erase(m_objects.begin());
+        }
+        
+        iterator begin()
+        {
+            return iterator(this, 0);
+        }
+        
+        iterator end()
+        {
+            std::unique_lock<std::recursive_mutex> scopedLock(m_mutex);
+            return iterator(this, m_objects.size());
+        }
+        
+    private:
+        std::vector<TType> m_objects;
+        std::recursive_mutex m_mutex;
+    };
+    
+    /// Adapts the concurrent vector to the interface used by the benchmark.
+    ///
+    template <typename TType> class SnapshotVector final
+    {
+    public:
+        using iterator = typename concurrent_vector<TType>::iterator;
+        
+        void push_back(const TType& in_object)
+        {
+            m_vector.push_back(in_object);
+        }
+        
+        void erase_front()
+        {
+            m_vector.erase(m_vector.begin());
+        }
+        
+        iterator begin()
+        {
+            return m_vector.begin();
+        }
+        
+        iterator end()
+        {
+            return m_vector.end();
+        }
+        
+    private:
+        concurrent_vector<TType> m_vector;
+    };
+    
+    /// An element the size of a widget pointer and the data read from it while iterating.
+    ///
+    struct Element final
+    {
+        void* m_widget;
+        u32 m_value;
+    };
+    
+    /// The results of a single run.
+    ///
+    struct RunResult final
+    {
+        u32 m_numReaders = 0;
+        f64 m_nsPerElement = 0.0;
+        u64 m_numWrites = 0;
+    };
+    
+    /// Runs the given number of readers over a vector for the given duration, optionally with a
+    /// writer adding and removing elements at the same time.
+    ///
+    /// @return The mean time taken to visit each element, across all readers, and the number of
+    /// writes made.
+    ///
+    template <typename TVector> RunResult Run(u32 numReaders, bool isContended, u32 durationMs)
+    {
+        TVector vector;
+        for (u32 i = 0; i < k_numElements; ++i)
+        {
+            vector.push_back(Element{ nullptr, i });
+        }
+        
+        std::atomic<bool> isRunning(true);
+        std::atomic<u64> numElementsVisited(0);
+        std::atomic<u64> numWrites(0);
+        std::atomic<u64> checksum(0);
+        
+        std::vector<std::thread> threads;
+        for (u32 i = 0; i < numReaders; ++i)
+        {
+            threads.emplace_back([&]()
+            {
+                u64 numVisited = 0;
+                u64 sum = 0;
+                while (isRunning)
+                {
+                    for (auto it = vector.begin(); it != vector.end(); ++it)
+                    {
+                        sum += (*it).m_value;
+                        ++numVisited;
+                    }
+                }
+                numElementsVisited += numVisited;
+                checksum += sum;
+            });
+        }
+        
+        if (isContended)
+        {
+            threads.emplace_back([&]()
+            {
+                u32 value = k_numElements;
+                while (isRunning)
+                {
+                    vector.push_back(Element{ nullptr, value++ });
+                    vector.erase_front();
+                    numWrites += 2;
+                }
+            });
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+        isRunning = false;
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        std::chrono::duration<f64, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        
+        RunResult result;
+        result.m_numReaders = numReaders;
+        result.m_nsPerElement = (numElementsVisited > 0) ? elapsed.count() * numReaders / f64(numElementsVisited) : 0.0;
+        result.m_numWrites = numWrites;
+        return result;
+    }
+    
+    /// Parses a comma separated list of thread counts.
+    ///
+    /// @return Whether the list was valid.
+    ///
+    bool ParseThreadCounts(const std::string& list, std::vector<u32>& out_threadCounts)
+    {
+        std::vector<u32> threadCounts;
+        std::size_t start = 0;
+        while (start <= list.size())
+        {
+            std::size_t end = list.find(',', start);
+            if (end == std::string::npos)
+            {
+                end = list.size();
+            }
+            
+            int count = std::atoi(list.substr(start, end - start).c_str());
+            if (count <= 0)
+            {
+                return false;
+            }
+            threadCounts.push_back(u32(count));
+            start = end + 1;
+        }
+        
+        out_threadCounts = threadCounts;
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    u32 durationMs = k_defaultDurationMs;
+    std::vector<u32> threadCounts = { 1, 2, 4 };
+    std::string outputFilePath;
+    
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        bool hasValue = (i + 1 < argc);
+        
+        if (argument == "--duration" && hasValue && std::atoi(argv[i + 1]) > 0)
+        {
+            durationMs = u32(std::atoi(argv[++i]));
+        }
+        else if (argument == "--threads" && hasValue && ParseThreadCounts(argv[i + 1], threadCounts))
+        {
+            ++i;
+        }
+        else if (argument == "--output" && hasValue)
+        {
+            outputFilePath = argv[++i];
+        }
+        else
+        {
+            std::fprintf(stderr, "Usage: %s [--duration <ms>] [--threads <count,count,...>] [--output <file.json>]\n", argv[0]);
+            return 1;
+        }
+    }
+    
+    std::printf("Mean time (ns) to visit each of %u elements, per reader, over %u ms.\n\n", k_numElements, durationMs);
+    std::printf("%-12s %7s %14s %14s %14s\n", "Scenario", "Readers", "Locking (ns)", "Snapshot (ns)", "Writes");
+    
+    Json::Value scenarios(Json::arrayValue);
+    bool isValid = true;
+    for (bool isContended : { false, true })
+    {
+        const char* name = isContended ? "Contended" : "Uncontended";
+        
+        Json::Value runs(Json::arrayValue);
+        for (auto numReaders : threadCounts)
+        {
+            RunResult locking = Run<LockingVector<Element>>(numReaders, isContended, durationMs);
+            RunResult snapshot = Run<SnapshotVector<Element>>(numReaders, isContended, durationMs);
+            std::printf("%-12s %7u %14.2f %14.2f %14llu\n", name, numReaders, locking.m_nsPerElement, snapshot.m_nsPerElement, (unsigned long long)snapshot.m_numWrites);
+            
+            //every reader must have managed at least one pass over the vector.
+            if (locking.m_nsPerElement <= 0.0 || snapshot.m_nsPerElement <= 0.0)
+            {
+                std::fprintf(stderr, "Scenario '%s' with %u readers did not iterate.\n", name, numReaders);
+                isValid = false;
+            }
+            
+            Json::Value run(Json::objectValue);
+            run["NumReaders"] = Json::UInt(numReaders);
+            run["LockingNsPerElement"] = locking.m_nsPerElement;
+            run["SnapshotNsPerElement"] = snapshot.m_nsPerElement;
+            run["LockingNumWrites"] = Json::UInt64(locking.m_numWrites);
+            run["SnapshotNumWrites"] = Json::UInt64(snapshot.m_numWrites);
+            runs.append(run);
+        }
+        
+        Json::Value scenario(Json::objectValue);
+        scenario["Name"] = name;
+        scenario["Runs"] = runs;
+        scenarios.append(scenario);
+    }
+    
+    if (outputFilePath.empty() == false)
+    {
+        Json::Value output(Json::objectValue);
+        output["DurationMs"] = Json::UInt(durationMs);
+        output["NumElements"] = Json::UInt(k_numElements);
+        output["Scenarios"] = scenarios;
+        
+        std::ofstream file(outputFilePath);
+        file << Json::StyledWriter().write(output);
+        if (file.good() == false)
+        {
+            std::fprintf(stderr, "Could not write the results to '%s'.\n", outputFilePath.c_str());
+            return 1;
+        }
+    }
+    
+    return isValid ? 0 : 1;
+}
@@ -0,0 +1,298 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Container/concurrent_vector.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace ChilliSource;
+    
+    /// @return A vector containing the integers in [0, count).
+    ///
+    concurrent_vector<int> CreateVector(int count)
+    {
+        concurrent_vector<int> vector;
+        for (int i = 0; i < count; ++i)
+        {
+            vector.push_back(i);
+        }
+        return vector;
+    }
+    
+    /// @return The contents of the given vector, in order.
+    ///
+    std::vector<int> ToVector(const concurrent_vector<int>& vector)
+    {
+        std::vector<int> output;
+        for (auto it = vector.begin(); it != vector.end(); ++it)
+        {
+            output.push_back(*it);
+        }
+        return output;
+    }
+    
+    /// Elements added while iterating are not seen by the iteration, but are by the next.
+    ///
+    TEST(ConcurrentVectorTest, IterationDoesNotSeeAdditions)
+    {
+        auto vector = CreateVector(5);
+        
+        std::vector<int> iterated;
+        for (auto it = vector.begin(); it != vector.end(); ++it)
+        {
+            iterated.push_back(*it);
+            vector.push_back(*it + 5);
+        }
+        
+        EXPECT_EQ(std::vector<int>({ 0, 1, 2, 3, 4 }), iterated);
+        EXPECT_EQ(10u, vector.size());
+        EXPECT_EQ(std::vector<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }), ToVector(vector));
+    }
+    
+    /// Elements removed ahead of an iterator are skipped by it, including by iterators which
+    /// were created before the removal.
+    ///
+    TEST(ConcurrentVectorTest, IterationSkipsRemovals)
+    {
+        auto vector = CreateVector(10);
+        
+        std::vector<int> iterated;
+        auto otherIt = vector.begin();
+        for (auto it = vector.begin(); it != vector.end(); ++it)
+        {
+            iterated.push_back(*it);
+            if (*it == 2)
+            {
+                vector.erase(vector.begin() + 3);
+                vector.erase(vector.begin() + 6);
+            }
+        }
+        
+        EXPECT_EQ(std::vector<int>({ 0, 1, 2, 4, 5, 6, 8, 9 }), iterated);
+        EXPECT_EQ(8u, vector.size());
+        
+        std::vector<int> otherIterated;
+        for (; otherIt != vector.end(); ++otherIt)
+        {
+            otherIterated.push_back(*otherIt);
+        }
+        EXPECT_EQ(iterated, otherIterated);
+    }
+    
+    /// Erasing the current element returns an iterator to the next one, in both directions.
+    ///
+    TEST(ConcurrentVectorTest, EraseWhileIterating)
+    {
+        auto vector = CreateVector(10);
+        for (auto it = vector.begin(); it != vector.end();)
+        {
+            it = (*it % 2 == 0) ? vector.erase(it) : it + 1;
+        }
+        EXPECT_EQ(std::vector<int>({ 1, 3, 5, 7, 9 }), ToVector(vector));
+        
+        std::vector<int> reverseIterated;
+        for (auto it = vector.rbegin(); it != vector.rend();)
+        {
+            reverseIterated.push_back(*it);
+            it = (*it > 4) ? vector.erase(it) : it + 1;
+        }
+        EXPECT_EQ(std::vector<int>({ 9, 7, 5, 3, 1 }), reverseIterated);
+        EXPECT_EQ(std::vector<int>({ 1, 3 }), ToVector(vector));
+        EXPECT_EQ(2u, vector.size());
+    }
+    
+    /// Erasing an element twice, through two iterators, only removes it once.
+    ///
+    TEST(ConcurrentVectorTest, EraseIsIdempotent)
+    {
+        auto vector = CreateVector(3);
+        auto firstIt = vector.begin() + 1;
+        auto secondIt = vector.begin() + 1;
+        
+        vector.erase(firstIt);
+        vector.erase(secondIt);
+        
+        EXPECT_EQ(std::vector<int>({ 0, 2 }), ToVector(vector));
+        EXPECT_EQ(2u, vector.size());
+    }
+    
+    /// Clearing while iterating ends the iteration, and elements added afterwards are only seen
+    /// by new iterators.
+    ///
+    TEST(ConcurrentVectorTest, ClearWhileIterating)
+    {
+        auto vector = CreateVector(5);
+        
+        std::vector<int> iterated;
+        for (auto it = vector.begin(); it != vector.end(); ++it)
+        {
+            iterated.push_back(*it);
+            if (*it == 1)
+            {
+                vector.clear();
+                vector.push_back(10);
+            }
+        }
+        
+        EXPECT_EQ(std::vector<int>({ 0, 1 }), iterated);
+        EXPECT_EQ(std::vector<int>({ 10 }), ToVector(vector));
+    }
+    
+    /// Striding an iterator counts only the elements which haven't been removed.
+    ///
+    TEST(ConcurrentVectorTest, StrideSkipsRemovals)
+    {
+        auto vector = CreateVector(6);
+        auto it = vector.begin();
+        vector.erase(vector.begin() + 1);
+        vector.erase(vector.begin() + 1);
+        
+        EXPECT_EQ(3, *(it + 1));
+        EXPECT_EQ(5, *(it + 3));
+        EXPECT_TRUE(it + 4 == vector.end());
+    }
+    
+    /// An iterator keeps walking the elements of a vector which has since been moved from, and
+    /// copying a vector while iterating doesn't include removed elements.
+    ///
+    TEST(ConcurrentVectorTest, MoveAndCopyWhileIterating)
+    {
+        auto vector = CreateVector(4);
+        auto it = vector.begin();
+        vector.erase(vector.begin() + 2);
+        
+        concurrent_vector<int> copy(vector);
+        concurrent_vector<int> moved(std::move(vector));
+        
+        EXPECT_EQ(std::vector<int>({ 0, 1, 3 }), ToVector(copy));
+        EXPECT_EQ(std::vector<int>({ 0, 1, 3 }), ToVector(moved));
+        EXPECT_TRUE(vector.empty());
+        
+        std::vector<int> iterated;
+        for (; it != moved.end(); ++it)
+        {
+            iterated.push_back(*it);
+        }
+        EXPECT_EQ(std::vector<int>({ 0, 1, 3 }), iterated);
+    }
+    
+    /// While one thread holds the lock, other threads can't modify the vector, but the locking
+    /// thread can.
+    ///
+    TEST(ConcurrentVectorTest, LockBlocksOtherThreads)
+    {
+        auto vector = CreateVector(1);
+        std::atomic<bool> isPushed(false);
+        
+        vector.lock();
+        
+        std::thread thread([&]()
+        {
+            vector.push_back(2);
+            isPushed = true;
+        });
+        
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_FALSE(isPushed);
+        
+        vector.push_back(1);
+        EXPECT_EQ(2u, vector.size());
+        
+        vector.unlock();
+        thread.join();
+        
+        EXPECT_TRUE(isPushed);
+        EXPECT_EQ(std::vector<int>({ 0, 1, 2 }), ToVector(vector));
+    }
+    
+    /// Threads iterating while another thread adds and removes elements must always see the
+    /// elements in the order they were added.
+    ///
+    TEST(ConcurrentVectorTest, IterateWhileModifyingOnOtherThreads)
+    {
+        const int k_numWrites = 20000;
+        
+        concurrent_vector<int> vector;
+        std::atomic<bool> isWriting(true);
+        std::atomic<int> numErrors(0);
+        
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 3; ++i)
+        {
+            readers.emplace_back([&]()
+            {
+                while (isWriting)
+                {
+                    int previous = -1;
+                    for (auto it = vector.begin(); it != vector.end(); ++it)
+                    {
+                        //the writer only removes odd values, once the value after them has been added.
+                        if (*it <= previous)
+                        {
+                            ++numErrors;
+                        }
+                        previous = *it;
+                    }
+                }
+            });
+        }
+        
+        for (int i = 0; i < k_numWrites; ++i)
+        {
+            vector.push_back(i);
+            if (i % 2 == 0 && i > 0)
+            {
+                for (auto it = vector.begin(); it != vector.end(); ++it)
+                {
+                    if (*it == i - 1)
+                    {
+                        vector.erase(it);
+                        break;
+                    }
+                }
+            }
+            
+            if (vector.size() > 64)
+            {
+                vector.erase(vector.begin());
+            }
+        }
+        
+        isWriting = false;
+        for (auto& reader : readers)
+        {
+            reader.join();
+        }
+        
+        EXPECT_EQ(0, numErrors);
+        EXPECT_EQ(vector.size(), ToVector(vector).size());
+    }
+}
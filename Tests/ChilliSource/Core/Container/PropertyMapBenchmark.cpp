@@ -0,0 +1,254 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Container/Property/PropertyMap.h>
+
+#include <ChilliSource/Core/Container/Property/PropertyTypes.h>
+#include <ChilliSource/Core/String/InternedString.h>
+#include <ChilliSource/Core/String/StringUtils.h>
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Benchmarks looking up properties in a PropertyMap in each of the ways widgets do, and interning
+// and copying the names, against a reduced copy of the previous implementation: an unordered_map
+// keyed on the lower case name, which lower cased every name looked up and copied every key when
+// the map was copied. Each case is run over the same number of operations, cycling through every
+// property in a map the size of a typical widget's. Configure with CMAKE_BUILD_TYPE=Release for
+// meaningful timings.
+//
+//   PropertyMapBenchmark [--properties <count>] [--operations <count>] [--output <file.json>]
+//
+// A table is printed for reading, and the full results are written as JSON for tracking over
+// time if an output file is given.
+
+namespace
+{
+    using namespace ChilliSource;
+    
+    constexpr u32 k_defaultNumProperties = 24;
+    constexpr u32 k_defaultNumOperations = 2000000;
+    
+    /// A reduced copy of the PropertyMap this replaced: the properties are held in an
+    /// unordered_map keyed on their lower case names.
+    ///
+    class UnorderedPropertyMap final
+    {
+    public:
+        UnorderedPropertyMap(const std::vector<PropertyMap::PropertyDesc>& descs)
+        {
+            for (const auto& desc : descs)
+            {
+                std::string lowerCaseName = desc.m_name;
+                StringUtils::ToLowerCase(lowerCaseName);
+                m_properties.emplace(lowerCaseName, desc.m_type->CreateProperty());
+            }
+        }
+        
+        UnorderedPropertyMap(const UnorderedPropertyMap& other)
+        {
+            for (const auto& property : other.m_properties)
+            {
+                auto copy = property.second->GetType()->CreateProperty();
+                copy->Set(property.second.get());
+                m_properties.emplace(property.first, std::move(copy));
+            }
+        }
+        
+        const IProperty* GetPropertyObject(const std::string& name) const
+        {
+            std::string lowerCaseName = name;
+            StringUtils::ToLowerCase(lowerCaseName);
+            
+            auto it = m_properties.find(lowerCaseName);
+            return (it != m_properties.end()) ? it->second.get() : nullptr;
+        }
+        
+    private:
+        std::unordered_map<std::string, IPropertyUPtr> m_properties;
+    };
+    
+    /// A benchmarked operation. The operation is given the index of the property to use, and
+    /// returns whether it succeeded. Operations which are much slower than a lookup, such as
+    /// copying a map, are performed fewer times.
+    ///
+    struct Case final
+    {
+        const char* m_name;
+        u32 m_operationsDivisor;
+        std::function<bool(u32)> m_operation;
+    };
+    
+    /// The results of a single case.
+    ///
+    struct CaseResult final
+    {
+        f64 m_totalMs = 0.0;
+        f64 m_nsPerOperation = 0.0;
+        bool m_isValid = true;
+    };
+    
+    /// Performs the given operation the given number of times, cycling through the properties.
+    ///
+    /// @return The time taken, and whether every operation succeeded.
+    ///
+    CaseResult Run(const Case& benchmarkCase, u32 numProperties, u32 numOperations) noexcept
+    {
+        CaseResult result;
+        
+        auto start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < numOperations; ++i)
+        {
+            if (benchmarkCase.m_operation(i % numProperties) == false)
+            {
+                result.m_isValid = false;
+            }
+        }
+        std::chrono::duration<f64, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        
+        result.m_totalMs = elapsed.count();
+        result.m_nsPerOperation = result.m_totalMs * 1000000.0 / numOperations;
+        return result;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    u32 numProperties = k_defaultNumProperties;
+    u32 numOperations = k_defaultNumOperations;
+    std::string outputFilePath;
+    
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        bool hasValue = (i + 1 < argc);
+        
+        if (argument == "--properties" && hasValue && std::atoi(argv[i + 1]) > 0)
+        {
+            numProperties = u32(std::atoi(argv[++i]));
+        }
+        else if (argument == "--operations" && hasValue && std::atoi(argv[i + 1]) > 0)
+        {
+            numOperations = u32(std::atoi(argv[++i]));
+        }
+        else if (argument == "--output" && hasValue)
+        {
+            outputFilePath = argv[++i];
+        }
+        else
+        {
+            std::fprintf(stderr, "Usage: %s [--properties <count>] [--operations <count>] [--output <file.json>]\n", argv[0]);
+            return 1;
+        }
+    }
+    
+    std::vector<PropertyMap::PropertyDesc> descs;
+    std::vector<std::string> names;
+    std::vector<std::string> lowerCaseNames;
+    std::vector<std::string> upperCaseNames;
+    std::vector<InternedString> internedNames;
+    for (u32 i = 0; i < numProperties; ++i)
+    {
+        names.push_back("BenchmarkProperty" + ToString(i));
+        descs.push_back({ PropertyTypes::Float(), names.back() });
+        
+        lowerCaseNames.push_back(names.back());
+        StringUtils::ToLowerCase(lowerCaseNames.back());
+        upperCaseNames.push_back(names.back());
+        StringUtils::ToUpperCase(upperCaseNames.back());
+    }
+    
+    PropertyMap propertyMap(descs);
+    UnorderedPropertyMap unorderedPropertyMap(descs);
+    for (const auto& name : names)
+    {
+        internedNames.push_back(InternedString(name));
+    }
+    
+    InternedString internedName;
+    const Case cases[] =
+    {
+        { "LookupByName", 1, [&](u32 index) { return propertyMap.GetPropertyObject(names[index]) != nullptr; } },
+        { "LookupByLowerCaseName", 1, [&](u32 index) { return propertyMap.GetPropertyObject(lowerCaseNames[index]) != nullptr; } },
+        { "LookupByUpperCaseName", 1, [&](u32 index) { return propertyMap.GetPropertyObject(upperCaseNames[index]) != nullptr; } },
+        { "LookupByInternedString", 1, [&](u32 index) { return propertyMap.GetPropertyObject(internedNames[index]) != nullptr; } },
+        { "UnorderedLookupByName", 1, [&](u32 index) { return unorderedPropertyMap.GetPropertyObject(names[index]) != nullptr; } },
+        { "InternExistingString", 1, [&](u32 index) { return InternedString(names[index]) == internedNames[index]; } },
+        { "TryGetInternedString", 1, [&](u32 index) { return InternedString::TryGet(names[index], internedName) && internedName == internedNames[index]; } },
+        { "CopyMap", 100, [&](u32) { PropertyMap copy(propertyMap); return copy.HasKey(internedNames[0]); } },
+        { "UnorderedCopyMap", 100, [&](u32) { UnorderedPropertyMap copy(unorderedPropertyMap); return copy.GetPropertyObject(names[0]) != nullptr; } },
+    };
+    
+    std::printf("Time per operation on a map of %u properties, over %u operations.\n\n", numProperties, numOperations);
+    std::printf("%-24s %12s %12s\n", "Case", "Total (ms)", "ns/op");
+    
+    Json::Value caseResults(Json::arrayValue);
+    bool isValid = true;
+    for (const auto& benchmarkCase : cases)
+    {
+        u32 numCaseOperations = std::max(numOperations / benchmarkCase.m_operationsDivisor, 1u);
+        
+        auto result = Run(benchmarkCase, numProperties, numCaseOperations);
+        std::printf("%-24s %12.3f %12.1f\n", benchmarkCase.m_name, result.m_totalMs, result.m_nsPerOperation);
+        
+        if (result.m_isValid == false)
+        {
+            std::fprintf(stderr, "Case '%s' failed to find a property.\n", benchmarkCase.m_name);
+            isValid = false;
+        }
+        
+        Json::Value caseResult(Json::objectValue);
+        caseResult["Name"] = benchmarkCase.m_name;
+        caseResult["NumOperations"] = Json::UInt(numCaseOperations);
+        caseResult["TotalMs"] = result.m_totalMs;
+        caseResult["NsPerOperation"] = result.m_nsPerOperation;
+        caseResults.append(caseResult);
+    }
+    
+    if (outputFilePath.empty() == false)
+    {
+        Json::Value output(Json::objectValue);
+        output["NumProperties"] = Json::UInt(numProperties);
+        output["Cases"] = caseResults;
+        
+        std::ofstream file(outputFilePath);
+        file << Json::StyledWriter().write(output);
+        if (file.good() == false)
+        {
+            std::fprintf(stderr, "Could not write the results to '%s'.\n", outputFilePath.c_str());
+            return 1;
+        }
+    }
+    
+    return isValid ? 0 : 1;
+}
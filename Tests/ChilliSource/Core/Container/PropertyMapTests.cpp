@@ -0,0 +1,242 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Container/Property/PropertyMap.h>
+
+#include <ChilliSource/Core/Container/Property/PropertyTypes.h>
+#include <ChilliSource/Core/String/InternedString.h>
+#include <ChilliSource/Core/String/StringUtils.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// PropertyMapCollisionTests runs these tests with interned string hashes reduced to two bits, so
+// that most names in a map share a hash with another, and the lookup has to tell them apart by
+// comparing the names.
+
+namespace
+{
+    using namespace ChilliSource;
+    
+    constexpr u32 k_numGeneratedProperties = 200;
+    
+    /// @return The names of the given number of generated properties, in mixed case and in an
+    /// order which is neither alphabetical nor the order they'll be interned in.
+    ///
+    std::vector<std::string> CreateNames(u32 count)
+    {
+        std::vector<std::string> names;
+        for (u32 i = 0; i < count; ++i)
+        {
+            names.push_back("GeneratedProperty" + ToString((i * 7919) % count));
+        }
+        return names;
+    }
+    
+    /// @return A property map with an unsigned integer property for each of the given names.
+    ///
+    PropertyMap CreatePropertyMap(const std::vector<std::string>& names)
+    {
+        std::vector<PropertyMap::PropertyDesc> descs;
+        for (const auto& name : names)
+        {
+            descs.push_back({ PropertyTypes::UInt(), name });
+        }
+        return PropertyMap(descs);
+    }
+    
+    /// Sets each property in the map to its index in the given names.
+    ///
+    void SetIndices(PropertyMap& propertyMap, const std::vector<std::string>& names)
+    {
+        for (u32 i = 0; i < names.size(); ++i)
+        {
+            propertyMap.SetProperty(names[i], i);
+        }
+    }
+    
+    /// Properties are found by their declared name, their lower case name and by names in any
+    /// other case, as strings or interned strings.
+    ///
+    TEST(PropertyMapTest, LookupIsCaseInsensitive)
+    {
+        auto propertyMap = CreatePropertyMap({ "ColourTint", "alpha", "SIZE" });
+        propertyMap.SetProperty("ColourTint", 1u);
+        propertyMap.SetProperty("alpha", 2u);
+        propertyMap.SetProperty("SIZE", 3u);
+        
+        for (const auto& name : { "ColourTint", "colourtint", "COLOURTINT", "cOLOURtINT" })
+        {
+            EXPECT_EQ(1u, propertyMap.GetProperty<u32>(name)) << name;
+            EXPECT_EQ(1u, propertyMap.GetProperty<u32>(InternedString(name))) << name;
+        }
+        
+        for (const auto& name : { "alpha", "Alpha", "ALPHA" })
+        {
+            EXPECT_EQ(2u, propertyMap.GetProperty<u32>(name)) << name;
+            EXPECT_EQ(2u, propertyMap.GetProperty<u32>(InternedString(name))) << name;
+        }
+        
+        for (const auto& name : { "SIZE", "size", "Size" })
+        {
+            EXPECT_EQ(3u, propertyMap.GetProperty<u32>(name)) << name;
+            EXPECT_EQ(3u, propertyMap.GetProperty<u32>(InternedString(name))) << name;
+        }
+    }
+    
+    /// Names which aren't in the map aren't found, whether or not they've been interned, and
+    /// looking them up by string doesn't intern them.
+    ///
+    TEST(PropertyMapTest, MissingNamesAreNotFound)
+    {
+        auto propertyMap = CreatePropertyMap({ "Position", "Rotation" });
+        
+        auto numInternedStrings = InternedString::GetNumInternedStrings();
+        EXPECT_FALSE(propertyMap.HasKey("PropertyMapTestMissingName"));
+        EXPECT_FALSE(propertyMap.HasKey("propertymaptestmissingname"));
+        EXPECT_FALSE(propertyMap.HasKey("Positio"));
+        EXPECT_FALSE(propertyMap.HasKey("Positions"));
+        EXPECT_FALSE(propertyMap.HasKey(""));
+        EXPECT_EQ(numInternedStrings, InternedString::GetNumInternedStrings());
+        
+        InternedString missingName;
+        EXPECT_FALSE(InternedString::TryGet("PropertyMapTestMissingName", missingName));
+        
+        EXPECT_FALSE(propertyMap.HasKey(InternedString("PropertyMapTestMissingName")));
+        EXPECT_FALSE(propertyMap.HasKey(InternedString("PROPERTYMAPTESTMISSINGNAME")));
+        EXPECT_FALSE(propertyMap.HasKey(InternedString()));
+    }
+    
+    /// Looking a property up by interned string finds the same property as looking it up by
+    /// string, for every property in a large map.
+    ///
+    TEST(PropertyMapTest, LookupByIdMatchesLookupByName)
+    {
+        auto names = CreateNames(k_numGeneratedProperties);
+        auto propertyMap = CreatePropertyMap(names);
+        SetIndices(propertyMap, names);
+        
+        for (u32 i = 0; i < names.size(); ++i)
+        {
+            std::string lowerCaseName = names[i];
+            StringUtils::ToLowerCase(lowerCaseName);
+            std::string upperCaseName = names[i];
+            StringUtils::ToUpperCase(upperCaseName);
+            
+            for (const auto& name : { names[i], lowerCaseName, upperCaseName })
+            {
+                ASSERT_TRUE(propertyMap.HasKey(name)) << name;
+                EXPECT_EQ(i, propertyMap.GetProperty<u32>(name)) << name;
+                EXPECT_EQ(i, propertyMap.GetProperty<u32>(InternedString(name))) << name;
+                EXPECT_EQ(propertyMap.GetPropertyObject(name), propertyMap.GetPropertyObject(InternedString(name))) << name;
+            }
+        }
+    }
+    
+    /// Properties are found regardless of the order they are declared in, so the lookup tables
+    /// are kept sorted as properties are added.
+    ///
+    TEST(PropertyMapTest, LookupIsIndependentOfDeclarationOrder)
+    {
+        auto names = CreateNames(k_numGeneratedProperties);
+        
+        auto reversedNames = names;
+        std::reverse(reversedNames.begin(), reversedNames.end());
+        auto sortedNames = names;
+        std::sort(sortedNames.begin(), sortedNames.end());
+        
+        for (const auto& declaredNames : { names, reversedNames, sortedNames })
+        {
+            auto propertyMap = CreatePropertyMap(declaredNames);
+            SetIndices(propertyMap, declaredNames);
+            
+            for (u32 i = 0; i < declaredNames.size(); ++i)
+            {
+                EXPECT_EQ(i, propertyMap.GetProperty<u32>(declaredNames[i]));
+                EXPECT_EQ(i, propertyMap.GetProperty<u32>(InternedString(declaredNames[i])));
+            }
+        }
+    }
+    
+    /// Copies and moves of a property map keep their lookups, and copies have their own values.
+    ///
+    TEST(PropertyMapTest, CopiesAndMovesKeepLookups)
+    {
+        auto names = CreateNames(k_numGeneratedProperties);
+        auto propertyMap = CreatePropertyMap(names);
+        SetIndices(propertyMap, names);
+        
+        PropertyMap copy(propertyMap);
+        PropertyMap assigned;
+        assigned = propertyMap;
+        copy.SetProperty(names[0], 1000u);
+        
+        PropertyMap moved(std::move(assigned));
+        EXPECT_FALSE(assigned.HasKey(names[0]));
+        
+        for (u32 i = 0; i < names.size(); ++i)
+        {
+            EXPECT_EQ(i, propertyMap.GetProperty<u32>(InternedString(names[i])));
+            EXPECT_EQ(i, moved.GetProperty<u32>(names[i]));
+            EXPECT_EQ(i, moved.GetProperty<u32>(InternedString(names[i])));
+            EXPECT_EQ((i == 0) ? 1000u : i, copy.GetProperty<u32>(InternedString(names[i])));
+        }
+    }
+    
+#if defined(CS_INTERNEDSTRING_HASH_MASK)
+    /// The names in a map with colliding hashes are told apart, in every case.
+    ///
+    TEST(PropertyMapTest, NamesWithTheSameHashAreDistinguished)
+    {
+        auto names = CreateNames(k_numGeneratedProperties);
+        
+        std::unordered_map<std::size_t, std::vector<std::string>> namesByHash;
+        for (const auto& name : names)
+        {
+            namesByHash[InternedString::CalculateHash(name)].push_back(name);
+        }
+        ASSERT_LT(namesByHash.size(), names.size());
+        
+        for (const auto& hashNames : namesByHash)
+        {
+            auto propertyMap = CreatePropertyMap(hashNames.second);
+            SetIndices(propertyMap, hashNames.second);
+            
+            for (u32 i = 0; i < hashNames.second.size(); ++i)
+            {
+                std::string lowerCaseName = hashNames.second[i];
+                StringUtils::ToLowerCase(lowerCaseName);
+                
+                EXPECT_EQ(i, propertyMap.GetProperty<u32>(hashNames.second[i]));
+                EXPECT_EQ(i, propertyMap.GetProperty<u32>(lowerCaseName));
+                EXPECT_EQ(i, propertyMap.GetProperty<u32>(InternedString(hashNames.second[i])));
+            }
+        }
+    }
+#endif
+}
@@ -0,0 +1,389 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/File/AppDataStore.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Base/DeviceInfo.h>
+#include <ChilliSource/Core/Base/LifecycleManager.h>
+#include <ChilliSource/Core/Base/RenderInfo.h>
+#include <ChilliSource/Core/Base/ScreenInfo.h>
+#include <ChilliSource/Core/Base/SystemInfo.h>
+#include <ChilliSource/Core/Container/ParamDictionary.h>
+#include <ChilliSource/Core/Container/ParamDictionarySerialiser.h>
+#include <ChilliSource/Core/Cryptographic/AESEncrypt.h>
+#include <ChilliSource/Core/File/FileSystem.h>
+#include <ChilliSource/Core/Math/Vector2.h>
+#include <ChilliSource/Core/String/ToString.h>
+#include <ChilliSource/Core/Threading/TaskScheduler.h>
+#include <ChilliSource/Core/XML/XMLUtils.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    using namespace ChilliSource;
+    
+    const char k_snapshotFilename[] = "App.adb";
+    const char k_tempSnapshotFilename[] = "App.adb.tmp";
+    const char k_journalFilename[] = "App.adj";
+    const char k_legacyFilename[] = "App.ads";
+    const char k_privateKey[] = "aV0r71^jX01}pXMk";
+    
+    /// A minimal application with only the default systems, which include the app data store.
+    ///
+    class TestApplication final : public Application
+    {
+    public:
+        TestApplication() noexcept
+            : Application(SystemInfoCUPtr(new SystemInfo(DeviceInfo("Host", "Host", "Host", "", "en_GB", "en", "", 4), ScreenInfo(Vector2(1.0f, 1.0f), 1.0f, 1.0f, {}),
+                RenderInfo(false, false, false, false, 1024, 8), "1.0")))
+        {
+        }
+        
+    private:
+        void CreateSystems() noexcept override {}
+        void OnInit() noexcept override {}
+        void PushInitialState() noexcept override {}
+        void OnDestroy() noexcept override {}
+    };
+    
+    /// @return The contents of the file at the given absolute path.
+    ///
+    std::string ReadFile(const std::string& filePath)
+    {
+        std::ifstream file(filePath, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    
+    /// Replaces the contents of the file at the given absolute path.
+    ///
+    void WriteFile(const std::string& filePath, const std::string& contents)
+    {
+        std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+        file.write(contents.data(), contents.size());
+    }
+    
+    /// @return Whether a file or directory exists at the given absolute path.
+    ///
+    bool DoesPathExist(const std::string& path)
+    {
+        struct stat pathStat;
+        return (stat(path.c_str(), &pathStat) == 0);
+    }
+    
+    /// Runs the app data store in an application which can be restarted, so that the data is
+    /// reloaded from disk. The save data is removed after each test.
+    ///
+    class AppDataStoreTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            Start();
+            m_saveDataPath = Application::Get()->GetFileSystem()->GetAbsolutePathToStorageLocation(StorageLocation::k_saveData);
+        }
+        
+        void TearDown() override
+        {
+            Stop();
+            
+            for (auto filename : { k_snapshotFilename, k_tempSnapshotFilename, k_journalFilename, k_legacyFilename })
+            {
+                std::remove(GetSaveDataFilePath(filename).c_str());
+            }
+        }
+        
+        /// Creates the application, which loads the app data store from disk.
+        ///
+        void Start()
+        {
+            m_application.reset(new TestApplication());
+            m_lifecycleManager.reset(new LifecycleManager(m_application.get()));
+        }
+        
+        /// Destroys the application. As in the engine the app data store saves any unsaved changes
+        /// when it is destroyed.
+        ///
+        void Stop()
+        {
+            m_lifecycleManager.reset();
+            m_application.reset();
+        }
+        
+        /// Destroys and recreates the application.
+        ///
+        void Restart()
+        {
+            Stop();
+            Start();
+        }
+        
+        /// @return The app data store.
+        ///
+        AppDataStore* GetAppDataStore()
+        {
+            return m_application->GetSystem<AppDataStore>();
+        }
+        
+        /// @return The absolute path to the given file in the save data storage location.
+        ///
+        std::string GetSaveDataFilePath(const std::string& filename) const
+        {
+            return m_saveDataPath + filename;
+        }
+        
+        /// Saves a string value for each key in the given range, saving after each one, so that
+        /// each is written as a separate journal frame until the journal is compacted.
+        ///
+        void SaveValues(u32 firstKey, u32 numKeys)
+        {
+            for (u32 i = firstKey; i < firstKey + numKeys; ++i)
+            {
+                GetAppDataStore()->SetValue("Key" + ToString(i), std::string(100, char('a' + i % 26)));
+                GetAppDataStore()->Save();
+            }
+        }
+        
+        /// Checks that the values saved by SaveValues() are present.
+        ///
+        void ExpectValues(u32 firstKey, u32 numKeys)
+        {
+            for (u32 i = firstKey; i < firstKey + numKeys; ++i)
+            {
+                std::string value;
+                EXPECT_TRUE(GetAppDataStore()->TryGetValue("Key" + ToString(i), value)) << "Key" << i;
+                EXPECT_EQ(std::string(100, char('a' + i % 26)), value) << "Key" << i;
+            }
+        }
+        
+        std::unique_ptr<TestApplication> m_application;
+        std::unique_ptr<LifecycleManager> m_lifecycleManager;
+        std::string m_saveDataPath;
+    };
+    
+    /// Values of every type, and erasures, must survive a reload.
+    ///
+    TEST_F(AppDataStoreTest, SavesAndReloads)
+    {
+        AppDataStore* appDataStore = GetAppDataStore();
+        appDataStore->SetValue("String", "Value");
+        appDataStore->SetValue("Bool", true);
+        appDataStore->SetValue("U32", u32(4000000000u));
+        appDataStore->SetValue("S32", s32(-7));
+        appDataStore->SetValue("U64", u64(1) << 40);
+        appDataStore->SetValue("S64", -(s64(1) << 40));
+        appDataStore->SetValue("F32", 1.5f);
+        appDataStore->SetValue("Erased", "Value");
+        appDataStore->Save();
+        
+        EXPECT_TRUE(appDataStore->Erase("Erased"));
+        appDataStore->SetValue("String", "Changed");
+        appDataStore->Save();
+        
+        Restart();
+        appDataStore = GetAppDataStore();
+        
+        std::string stringValue;
+        bool boolValue = false;
+        u32 u32Value = 0;
+        s32 s32Value = 0;
+        u64 u64Value = 0;
+        s64 s64Value = 0;
+        f32 f32Value = 0.0f;
+        EXPECT_TRUE(appDataStore->TryGetValue("String", stringValue));
+        EXPECT_TRUE(appDataStore->TryGetValue("Bool", boolValue));
+        EXPECT_TRUE(appDataStore->TryGetValue("U32", u32Value));
+        EXPECT_TRUE(appDataStore->TryGetValue("S32", s32Value));
+        EXPECT_TRUE(appDataStore->TryGetValue("U64", u64Value));
+        EXPECT_TRUE(appDataStore->TryGetValue("S64", s64Value));
+        EXPECT_TRUE(appDataStore->TryGetValue("F32", f32Value));
+        EXPECT_EQ("Changed", stringValue);
+        EXPECT_TRUE(boolValue);
+        EXPECT_EQ(4000000000u, u32Value);
+        EXPECT_EQ(-7, s32Value);
+        EXPECT_EQ(u64(1) << 40, u64Value);
+        EXPECT_EQ(-(s64(1) << 40), s64Value);
+        EXPECT_EQ(1.5f, f32Value);
+        EXPECT_FALSE(appDataStore->Contains("Erased"));
+    }
+    
+    /// A journal frame which was interrupted while being written must be discarded without
+    /// affecting the frames before it, and the next save must write a new snapshot.
+    ///
+    TEST_F(AppDataStoreTest, DiscardsTruncatedJournalFrame)
+    {
+        SaveValues(0, 3);
+        
+        std::string journal = ReadFile(GetSaveDataFilePath(k_journalFilename));
+        ASSERT_GT(journal.size(), 3u);
+        WriteFile(GetSaveDataFilePath(k_journalFilename), journal.substr(0, journal.size() - 3));
+        
+        Restart();
+        
+        ExpectValues(0, 2);
+        EXPECT_FALSE(GetAppDataStore()->Contains("Key2"));
+        
+        SaveValues(3, 1);
+        EXPECT_TRUE(DoesPathExist(GetSaveDataFilePath(k_snapshotFilename)));
+        EXPECT_FALSE(DoesPathExist(GetSaveDataFilePath(k_journalFilename)));
+        
+        Restart();
+        
+        ExpectValues(0, 2);
+        ExpectValues(3, 1);
+    }
+    
+    /// A journal frame which fails its checksum must be discarded in the same way.
+    ///
+    TEST_F(AppDataStoreTest, DiscardsCorruptJournalFrame)
+    {
+        SaveValues(0, 3);
+        
+        std::string journal = ReadFile(GetSaveDataFilePath(k_journalFilename));
+        ASSERT_FALSE(journal.empty());
+        journal.back() ^= 0x5a;
+        WriteFile(GetSaveDataFilePath(k_journalFilename), journal);
+        
+        Restart();
+        
+        ExpectValues(0, 2);
+        EXPECT_FALSE(GetAppDataStore()->Contains("Key2"));
+    }
+    
+    /// A corrupt snapshot must be discarded rather than partially loaded, and the store must be
+    /// usable afterwards.
+    ///
+    TEST_F(AppDataStoreTest, DiscardsCorruptSnapshot)
+    {
+        GetAppDataStore()->Clear();
+        SaveValues(0, 3);
+        ASSERT_TRUE(DoesPathExist(GetSaveDataFilePath(k_snapshotFilename)));
+        
+        std::string snapshot = ReadFile(GetSaveDataFilePath(k_snapshotFilename));
+        snapshot[snapshot.size() / 2] ^= 0x5a;
+        WriteFile(GetSaveDataFilePath(k_snapshotFilename), snapshot);
+        
+        Restart();
+        
+        for (u32 i = 0; i < 3; ++i)
+        {
+            EXPECT_FALSE(GetAppDataStore()->Contains("Key" + ToString(i)));
+        }
+        
+        SaveValues(3, 1);
+        
+        Restart();
+        
+        ExpectValues(3, 1);
+    }
+    
+    /// Data in the legacy XML format must be loaded, then replaced by a snapshot on the next save.
+    ///
+    TEST_F(AppDataStoreTest, MigratesLegacyFile)
+    {
+        ParamDictionary dictionary;
+        dictionary.SetValue("String", "Value");
+        dictionary.SetValue("Number", "42");
+        
+        XML::Document document;
+        XML::Node* rootNode = document.allocate_node(rapidxml::node_type::node_element);
+        document.append_node(rootNode);
+        ParamDictionarySerialiser::ToXml(dictionary, rootNode);
+        
+        auto encrypted = AESEncrypt::EncryptString(XMLUtils::ToString(&document), k_privateKey);
+        WriteFile(GetSaveDataFilePath(k_legacyFilename), std::string(reinterpret_cast<const char*>(encrypted.m_data.get()), encrypted.m_size));
+        
+        Restart();
+        
+        std::string stringValue;
+        u32 numberValue = 0;
+        EXPECT_TRUE(GetAppDataStore()->TryGetValue("String", stringValue));
+        EXPECT_TRUE(GetAppDataStore()->TryGetValue("Number", numberValue));
+        EXPECT_EQ("Value", stringValue);
+        EXPECT_EQ(42u, numberValue);
+        
+        GetAppDataStore()->Save();
+        EXPECT_TRUE(DoesPathExist(GetSaveDataFilePath(k_snapshotFilename)));
+        EXPECT_FALSE(DoesPathExist(GetSaveDataFilePath(k_legacyFilename)));
+        
+        Restart();
+        
+        EXPECT_TRUE(GetAppDataStore()->TryGetValue("String", stringValue));
+        EXPECT_TRUE(GetAppDataStore()->TryGetValue("Number", numberValue));
+        EXPECT_EQ("Value", stringValue);
+        EXPECT_EQ(42u, numberValue);
+    }
+    
+    /// Once the journal grows large enough it is compacted into a snapshot. Frames written after
+    /// that must be replayed on top of the snapshot.
+    ///
+    TEST_F(AppDataStoreTest, ReloadsAfterCompaction)
+    {
+        const u32 k_numKeys = 250;
+        
+        SaveValues(0, k_numKeys);
+        ASSERT_TRUE(DoesPathExist(GetSaveDataFilePath(k_snapshotFilename)));
+        ASSERT_TRUE(DoesPathExist(GetSaveDataFilePath(k_journalFilename)));
+        
+        Restart();
+        
+        ExpectValues(0, k_numKeys);
+    }
+    
+    /// If a snapshot fails to replace the previous one, the records it contained and any journal
+    /// frames queued after it must still be readable with the previous snapshot.
+    ///
+    TEST_F(AppDataStoreTest, KeepsChangesAfterFailedSnapshot)
+    {
+        SaveValues(0, 1);
+        
+        //a directory where the snapshot should be causes the rename which replaces it to fail.
+        ASSERT_EQ(0, mkdir(GetSaveDataFilePath(k_snapshotFilename).c_str(), 0777));
+        
+        //saving from a file task queues both jobs before either is written.
+        Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_file, [=](const TaskContext&)
+        {
+            GetAppDataStore()->SetValue("Large", std::string(32 * 1024, 'x'));
+            GetAppDataStore()->Save();
+            SaveValues(1, 1);
+        });
+        
+        Stop();
+        ASSERT_EQ(0, rmdir(GetSaveDataFilePath(k_snapshotFilename).c_str()));
+        Start();
+        
+        std::string largeValue;
+        EXPECT_TRUE(GetAppDataStore()->TryGetValue("Large", largeValue));
+        EXPECT_EQ(32u * 1024u, largeValue.size());
+        EXPECT_EQ(std::string::npos, largeValue.find_first_not_of('x'));
+        ExpectValues(0, 2);
+    }
+}
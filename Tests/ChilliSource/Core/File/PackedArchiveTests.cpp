@@ -0,0 +1,376 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/File/PackedArchive.h>
+
+#include <ChilliSource/Core/File/FileStream/IBinaryInputStream.h>
+#include <ChilliSource/Core/File/FileStream/ITextInputStream.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+namespace
+{
+    using namespace ChilliSource;
+    
+    const u32 k_headerSize = 24;
+    const u32 k_entrySize = 32;
+    const u32 k_storedSizeOffset = 24;
+    
+    const std::vector<std::string> k_filePaths = { "Empty.txt", "Short.txt", "Text.txt", "Textures/Fonts/Font.txt", "Textures/Image.png" };
+    
+    /// @param filePath
+    ///     The absolute path to the file.
+    ///
+    /// @return The contents of the file.
+    ///
+    std::string ReadFileContents(const std::string& filePath)
+    {
+        std::ifstream file(filePath, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    
+    /// @param filePath
+    ///     The path to the file within the test archive.
+    ///
+    /// @return The contents of the file the archive was built from.
+    ///
+    std::string ReadFixture(const std::string& filePath)
+    {
+        return ReadFileContents(std::string(CS_TEST_PACKED_ARCHIVE_DIR) + "/" + filePath);
+    }
+    
+    /// @param archive
+    ///     The archive.
+    /// @param filePath
+    ///     The path to the file within the archive.
+    ///
+    /// @return Whether or not the file could be read from the archive and matches the file it
+    ///     was built from.
+    ///
+    bool ReadMatchesFixture(const PackedArchive& archive, const std::string& filePath)
+    {
+        u32 size = 0;
+        auto contents = archive.ReadFile(filePath, size);
+        return (contents && std::string(reinterpret_cast<const char*>(contents.get()), size) == ReadFixture(filePath));
+    }
+    
+    /// @param data
+    ///     The data.
+    /// @param offset
+    ///     The offset of the little endian value within the data.
+    ///
+    /// @return The value.
+    ///
+    u32 GetU32(const std::string& data, u32 offset)
+    {
+        u32 value = 0;
+        for (u32 i = 0; i < 4; ++i)
+        {
+            value |= u32(u8(data[offset + i])) << (i * 8);
+        }
+        return value;
+    }
+    
+    /// @param data
+    ///     [Out] The data.
+    /// @param offset
+    ///     The offset of the little endian value within the data.
+    /// @param value
+    ///     The value to write.
+    ///
+    void SetU32(std::string& data, u32 offset, u32 value)
+    {
+        for (u32 i = 0; i < 4; ++i)
+        {
+            data[offset + i] = char((value >> (i * 8)) & 0xff);
+        }
+    }
+    
+    /// Opens the archive built by pack_archive.py, and writes modified copies of it for the tests
+    /// of embedded and corrupt archives.
+    ///
+    class PackedArchiveTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            m_archiveData = ReadFileContents(CS_TEST_PACKED_ARCHIVE);
+            ASSERT_GT(m_archiveData.size(), k_headerSize);
+            
+            m_archive.reset(new PackedArchive(CS_TEST_PACKED_ARCHIVE));
+            ASSERT_TRUE(m_archive->IsValid());
+        }
+        
+        void TearDown() override
+        {
+            if (!m_writtenFilePath.empty())
+            {
+                std::remove(m_writtenFilePath.c_str());
+            }
+        }
+        
+        /// @param data
+        ///     The contents of the file.
+        ///
+        /// @return The absolute path to a temporary file containing the given data.
+        ///
+        std::string WriteFile(const std::string& data)
+        {
+            m_writtenFilePath = ::testing::TempDir() + "PackedArchiveTest.cspack";
+            std::ofstream file(m_writtenFilePath, std::ios::binary | std::ios::trunc);
+            file.write(data.data(), std::streamsize(data.size()));
+            return m_writtenFilePath;
+        }
+        
+        /// @param filePath
+        ///     The path to the file within the archive.
+        ///
+        /// @return The offset of the file's index entry within the archive.
+        ///
+        u32 GetEntryOffset(const std::string& filePath) const
+        {
+            u32 numEntries = GetU32(m_archiveData, 8);
+            u32 pathTableOffset = k_headerSize + numEntries * k_entrySize;
+            for (u32 i = 0; i < numEntries; ++i)
+            {
+                u32 entryOffset = k_headerSize + i * k_entrySize;
+                if (m_archiveData.compare(pathTableOffset + GetU32(m_archiveData, entryOffset + 4), GetU32(m_archiveData, entryOffset + 8), filePath) == 0)
+                {
+                    return entryOffset;
+                }
+            }
+            
+            ADD_FAILURE() << "No index entry for '" << filePath << "'.";
+            return 0;
+        }
+        
+        std::string m_archiveData;
+        std::unique_ptr<PackedArchive> m_archive;
+        std::string m_writtenFilePath;
+    };
+    
+    TEST_F(PackedArchiveTest, ReadsStoredAndCompressedFiles)
+    {
+        for (const auto& filePath : k_filePaths)
+        {
+            EXPECT_TRUE(ReadMatchesFixture(*m_archive, filePath)) << filePath;
+        }
+        
+        //Text compresses well, a three character file would grow and the png extension is excluded from compression.
+        PackedArchive::FileInfo fileInfo;
+        ASSERT_TRUE(m_archive->TryGetFileInfo("Text.txt", fileInfo));
+        EXPECT_TRUE(fileInfo.m_isCompressed);
+        EXPECT_LT(fileInfo.m_size, fileInfo.m_uncompressedSize);
+        
+        ASSERT_TRUE(m_archive->TryGetFileInfo("Short.txt", fileInfo));
+        EXPECT_FALSE(fileInfo.m_isCompressed);
+        EXPECT_EQ(3u, fileInfo.m_size);
+        
+        ASSERT_TRUE(m_archive->TryGetFileInfo("Textures/Image.png", fileInfo));
+        EXPECT_FALSE(fileInfo.m_isCompressed);
+        EXPECT_EQ(0u, fileInfo.m_offset % 16);
+        
+        std::vector<std::string> extractedFilePaths;
+        EXPECT_TRUE(m_archive->ExtractFiles(k_filePaths, [&](const std::string& filePath, std::unique_ptr<const u8[]> contents, u32 size)
+        {
+            extractedFilePaths.push_back(filePath);
+            return std::string(reinterpret_cast<const char*>(contents.get()), size) == ReadFixture(filePath);
+        }));
+        EXPECT_EQ(k_filePaths, extractedFilePaths);
+    }
+    
+    TEST_F(PackedArchiveTest, ReadsEmptyFile)
+    {
+        u32 size = 1;
+        auto contents = m_archive->ReadFile("Empty.txt", size);
+        EXPECT_NE(nullptr, contents);
+        EXPECT_EQ(0u, size);
+        
+        EXPECT_NE(nullptr, m_archive->CreateBinaryInputStream("Empty.txt"));
+        EXPECT_NE(nullptr, m_archive->CreateTextInputStream("Empty.txt"));
+    }
+    
+    TEST_F(PackedArchiveTest, LooksUpFilesAndDirectories)
+    {
+        EXPECT_TRUE(m_archive->DoesFileExist("Text.txt"));
+        EXPECT_TRUE(m_archive->DoesFileExist("Textures/Fonts/Font.txt"));
+        EXPECT_TRUE(m_archive->DoesFileExist("Textures\\Fonts\\Font.txt"));
+        EXPECT_FALSE(m_archive->DoesFileExist("Textures"));
+        EXPECT_FALSE(m_archive->DoesFileExist("Missing.txt"));
+        EXPECT_FALSE(m_archive->DoesFileExist("text.txt"));
+        
+        EXPECT_TRUE(m_archive->DoesDirectoryExist("Textures"));
+        EXPECT_TRUE(m_archive->DoesDirectoryExist("Textures/Fonts/"));
+        EXPECT_FALSE(m_archive->DoesDirectoryExist("Text.txt"));
+        EXPECT_FALSE(m_archive->DoesDirectoryExist("Missing"));
+        
+        u32 size = 0;
+        EXPECT_EQ(nullptr, m_archive->ReadFile("Missing.txt", size));
+        EXPECT_EQ(nullptr, m_archive->ReadFile("Textures", size));
+        EXPECT_EQ(nullptr, m_archive->CreateTextInputStream("Missing.txt"));
+        
+        PackedArchive::FileInfo fileInfo;
+        EXPECT_FALSE(m_archive->TryGetFileInfo("Missing.txt", fileInfo));
+    }
+    
+    TEST_F(PackedArchiveTest, ListsDirectoryContents)
+    {
+        auto filePaths = m_archive->GetFilePaths("", true);
+        std::sort(filePaths.begin(), filePaths.end());
+        EXPECT_EQ(k_filePaths, filePaths);
+        
+        EXPECT_EQ(std::vector<std::string>({ "Image.png" }), m_archive->GetFilePaths("Textures", false));
+        
+        filePaths = m_archive->GetFilePaths("Textures/", true);
+        std::sort(filePaths.begin(), filePaths.end());
+        EXPECT_EQ(std::vector<std::string>({ "Fonts/Font.txt", "Image.png" }), filePaths);
+        
+        EXPECT_EQ(std::vector<std::string>({ "Textures/" }), m_archive->GetDirectoryPaths("", false));
+        
+        auto directoryPaths = m_archive->GetDirectoryPaths("", true);
+        std::sort(directoryPaths.begin(), directoryPaths.end());
+        EXPECT_EQ(std::vector<std::string>({ "Textures/", "Textures/Fonts/" }), directoryPaths);
+        
+        EXPECT_TRUE(m_archive->GetFilePaths("Missing", true).empty());
+    }
+    
+    TEST_F(PackedArchiveTest, ReadsEmbeddedArchive)
+    {
+        const u64 k_archiveOffset = 1000;
+        auto filePath = WriteFile(std::string(k_archiveOffset, 'x') + m_archiveData);
+        
+        PackedArchive embeddedArchive(filePath, k_archiveOffset);
+        ASSERT_TRUE(embeddedArchive.IsValid());
+        for (const auto& archiveFilePath : k_filePaths)
+        {
+            EXPECT_TRUE(ReadMatchesFixture(embeddedArchive, archiveFilePath)) << archiveFilePath;
+        }
+        
+        //The file info offset is within the containing file, so stored data can be read from it directly.
+        PackedArchive::FileInfo fileInfo;
+        ASSERT_TRUE(embeddedArchive.TryGetFileInfo("Textures/Image.png", fileInfo));
+        EXPECT_EQ(ReadFixture("Textures/Image.png"), ReadFileContents(filePath).substr(std::size_t(fileInfo.m_offset), fileInfo.m_size));
+        
+        EXPECT_FALSE(PackedArchive(filePath).IsValid());
+        EXPECT_FALSE(PackedArchive(filePath, k_archiveOffset + m_archiveData.size()).IsValid());
+    }
+    
+    TEST_F(PackedArchiveTest, ReadsConcurrently)
+    {
+        const u32 k_numThreads = 8;
+        const u32 k_numIterations = 200;
+        
+        std::atomic<u32> numFailures(0);
+        std::vector<std::thread> threads;
+        for (u32 i = 0; i < k_numThreads; ++i)
+        {
+            threads.emplace_back([&]()
+            {
+                for (u32 iteration = 0; iteration < k_numIterations; ++iteration)
+                {
+                    for (const auto& filePath : k_filePaths)
+                    {
+                        if (!ReadMatchesFixture(*m_archive, filePath))
+                        {
+                            ++numFailures;
+                        }
+                    }
+                }
+            });
+        }
+        
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        
+        EXPECT_EQ(0u, numFailures.load());
+    }
+    
+    TEST_F(PackedArchiveTest, RejectsCorruptHeader)
+    {
+        auto data = m_archiveData;
+        data[0] = 'X';
+        EXPECT_FALSE(PackedArchive(WriteFile(data)).IsValid());
+        
+        data = m_archiveData;
+        SetU32(data, 4, 2);
+        EXPECT_FALSE(PackedArchive(WriteFile(data)).IsValid());
+        
+        data = m_archiveData;
+        SetU32(data, 8, 0xffffffff);
+        EXPECT_FALSE(PackedArchive(WriteFile(data)).IsValid());
+        
+        EXPECT_FALSE(PackedArchive(WriteFile(m_archiveData.substr(0, k_headerSize - 1))).IsValid());
+        EXPECT_FALSE(PackedArchive("/ChilliSourceTests/Missing.cspack").IsValid());
+    }
+    
+    TEST_F(PackedArchiveTest, RejectsTruncatedIndex)
+    {
+        EXPECT_FALSE(PackedArchive(WriteFile(m_archiveData.substr(0, k_headerSize + 2 * k_entrySize + 5))).IsValid());
+        
+        //Cutting the file off part way through the data leaves the index intact, but it refers to data past the end.
+        EXPECT_FALSE(PackedArchive(WriteFile(m_archiveData.substr(0, m_archiveData.size() - 1))).IsValid());
+    }
+    
+    TEST_F(PackedArchiveTest, RejectsCorruptIndex)
+    {
+        auto data = m_archiveData;
+        SetU32(data, GetEntryOffset("Text.txt") + k_storedSizeOffset, u32(data.size()));
+        EXPECT_FALSE(PackedArchive(WriteFile(data)).IsValid());
+        
+        data = m_archiveData;
+        SetU32(data, GetEntryOffset("Text.txt") + 8, 0x10000);
+        EXPECT_FALSE(PackedArchive(WriteFile(data)).IsValid());
+        
+        data = m_archiveData;
+        std::swap_ranges(data.begin() + k_headerSize, data.begin() + k_headerSize + k_entrySize, data.begin() + k_headerSize + k_entrySize);
+        EXPECT_FALSE(PackedArchive(WriteFile(data)).IsValid());
+    }
+    
+    TEST_F(PackedArchiveTest, FailsToReadCorruptCompressedData)
+    {
+        PackedArchive::FileInfo fileInfo;
+        ASSERT_TRUE(m_archive->TryGetFileInfo("Text.txt", fileInfo));
+        ASSERT_TRUE(fileInfo.m_isCompressed);
+        
+        auto data = m_archiveData;
+        std::memset(&data[std::size_t(fileInfo.m_offset)], 0xff, fileInfo.m_size / 2);
+        
+        PackedArchive corruptArchive(WriteFile(data));
+        ASSERT_TRUE(corruptArchive.IsValid());
+        
+        u32 size = 0;
+        EXPECT_EQ(nullptr, corruptArchive.ReadFile("Text.txt", size));
+        EXPECT_TRUE(ReadMatchesFixture(corruptArchive, "Textures/Image.png"));
+    }
+}
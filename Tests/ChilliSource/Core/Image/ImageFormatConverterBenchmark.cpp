@@ -0,0 +1,304 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Image/ImageFormatConverter.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Base/DeviceInfo.h>
+#include <ChilliSource/Core/Base/LifecycleManager.h>
+#include <ChilliSource/Core/Base/RenderInfo.h>
+#include <ChilliSource/Core/Base/ScreenInfo.h>
+#include <ChilliSource/Core/Base/SystemInfo.h>
+#include <ChilliSource/Core/Image/ImageCompression.h>
+#include <ChilliSource/Core/Math/Vector2.h>
+#include <ChilliSource/Core/Resource/ResourcePool.h>
+#include <ChilliSource/Core/Threading/TaskContext.h>
+#include <ChilliSource/Core/Threading/TaskPool.h>
+#include <ChilliSource/Core/Threading/TaskType.h>
+
+#include "ImageFormatConverterReference.h"
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Benchmarks converting a large RGBA8888 image to each of the formats ImageFormatConverter
+// supports, as done when textures are loaded with a reduced colour depth. Each conversion is run
+// through the task based entry point with each requested thread count, and the median time is
+// reported. The output of each conversion is checked against the per-pixel reference.
+//
+// ImageFormatConverterScalarBenchmark is the same benchmark built without the SIMD kernels, so
+// the two tables can be compared. Configure with CMAKE_BUILD_TYPE=Release for meaningful timings.
+//
+//   ImageFormatConverterBenchmark [--size <pixels>] [--iterations <count>] [--threads <count,count,...>] [--output <file.json>]
+//
+// A table is printed for reading, and the full results are written as JSON for tracking over
+// time if an output file is given.
+
+namespace
+{
+    using namespace ChilliSource;
+    using ImageFormatConverter::Dithering;
+    
+    constexpr u32 k_defaultSize = 2048;
+    constexpr u32 k_defaultNumIterations = 20;
+    constexpr u32 k_numWarmUpIterations = 2;
+    
+#if defined(CS_IMAGEFORMATCONVERTER_DISABLE_SIMD)
+    constexpr bool k_isSimd = false;
+#else
+    constexpr bool k_isSimd = true;
+#endif
+    
+    /// A conversion from RGBA8888 to another format.
+    ///
+    struct Conversion final
+    {
+        const char* m_name;
+        ImageFormat m_format;
+        Dithering m_dithering;
+        void (*m_convert)(const TaskContext& taskContext, Image* image, Dithering dithering);
+    };
+    
+    const Conversion k_conversions[] =
+    {
+        { "RGB888", ImageFormat::k_RGB888, Dithering::k_none, [](const TaskContext& taskContext, Image* image, Dithering) { ImageFormatConverter::RGBA8888ToRGB888(taskContext, image); } },
+        { "RGBA4444", ImageFormat::k_RGBA4444, Dithering::k_none, [](const TaskContext& taskContext, Image* image, Dithering dithering) { ImageFormatConverter::RGBA8888ToRGBA4444(taskContext, image, dithering); } },
+        { "RGBA4444Dithered", ImageFormat::k_RGBA4444, Dithering::k_ordered, [](const TaskContext& taskContext, Image* image, Dithering dithering) { ImageFormatConverter::RGBA8888ToRGBA4444(taskContext, image, dithering); } },
+        { "RGB565", ImageFormat::k_RGB565, Dithering::k_none, [](const TaskContext& taskContext, Image* image, Dithering dithering) { ImageFormatConverter::RGBA8888ToRGB565(taskContext, image, dithering); } },
+        { "RGB565Dithered", ImageFormat::k_RGB565, Dithering::k_ordered, [](const TaskContext& taskContext, Image* image, Dithering dithering) { ImageFormatConverter::RGBA8888ToRGB565(taskContext, image, dithering); } },
+        { "LumA88", ImageFormat::k_LumA88, Dithering::k_none, [](const TaskContext& taskContext, Image* image, Dithering) { ImageFormatConverter::RGBA8888ToLumA88(taskContext, image); } },
+        { "Lum8", ImageFormat::k_Lum8, Dithering::k_none, [](const TaskContext& taskContext, Image* image, Dithering) { ImageFormatConverter::RGBA8888ToLum8(taskContext, image); } },
+    };
+    
+    /// A minimal application with only the default systems, which include the resource pool the
+    /// image is created through.
+    ///
+    class BenchmarkApplication final : public Application
+    {
+    public:
+        BenchmarkApplication() noexcept
+            : Application(SystemInfoCUPtr(new SystemInfo(DeviceInfo("Host", "Host", "Host", "", "en_GB", "en", "", 4), ScreenInfo(Vector2(1.0f, 1.0f), 1.0f, 1.0f, {}),
+                RenderInfo(false, false, false, false, 1024, 8), "1.0")))
+        {
+        }
+        
+    private:
+        void CreateSystems() noexcept override {}
+        void OnInit() noexcept override {}
+        void PushInitialState() noexcept override {}
+        void OnDestroy() noexcept override {}
+    };
+    
+    /// The results of a single run.
+    ///
+    struct RunResult final
+    {
+        u32 m_numThreads = 0;
+        f64 m_medianMs = 0.0;
+        bool m_isCorrect = false;
+    };
+    
+    /// Converts a copy of the given square RGBA8888 image data for the given number of
+    /// iterations, after a few unmeasured iterations. Only the conversion itself is timed.
+    ///
+    /// @return The median time taken, and whether the output matched the reference.
+    ///
+    RunResult Run(Image* image, const Conversion& conversion, const std::vector<u8>& data, const std::vector<u8>& expected, u32 size, u32 numThreads, u32 numIterations) noexcept
+    {
+        //The calling thread also processes tasks while it waits for them.
+        TaskPool taskPool(TaskType::k_small, numThreads - 1);
+        TaskContext taskContext(TaskType::k_small, &taskPool);
+        
+        Image::Descriptor desc;
+        desc.m_compression = ImageCompression::k_none;
+        desc.m_format = ImageFormat::k_RGBA8888;
+        desc.m_width = size;
+        desc.m_height = size;
+        desc.m_dataSize = u32(data.size());
+        
+        RunResult result;
+        result.m_numThreads = numThreads;
+        
+        std::vector<f64> times;
+        for (u32 iteration = 0; iteration < k_numWarmUpIterations + numIterations; ++iteration)
+        {
+            Image::ImageDataUPtr imageData(new u8[data.size()]);
+            std::memcpy(imageData.get(), data.data(), data.size());
+            image->Build(desc, std::move(imageData));
+            
+            auto start = std::chrono::steady_clock::now();
+            conversion.m_convert(taskContext, image, conversion.m_dithering);
+            std::chrono::duration<f64, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            
+            if (iteration >= k_numWarmUpIterations)
+            {
+                times.push_back(elapsed.count());
+            }
+        }
+        
+        std::sort(times.begin(), times.end());
+        result.m_medianMs = times[times.size() / 2];
+        result.m_isCorrect = (image->GetDataSize() == expected.size() && std::equal(expected.begin(), expected.end(), image->GetData()));
+        return result;
+    }
+    
+    /// Parses a comma separated list of thread counts.
+    ///
+    /// @return Whether the list was valid.
+    ///
+    bool ParseThreadCounts(const std::string& list, std::vector<u32>& out_threadCounts)
+    {
+        std::vector<u32> threadCounts;
+        std::size_t start = 0;
+        while (start <= list.size())
+        {
+            std::size_t end = list.find(',', start);
+            if (end == std::string::npos)
+            {
+                end = list.size();
+            }
+            
+            int count = std::atoi(list.substr(start, end - start).c_str());
+            if (count <= 0)
+            {
+                return false;
+            }
+            threadCounts.push_back(u32(count));
+            start = end + 1;
+        }
+        
+        out_threadCounts = threadCounts;
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    u32 size = k_defaultSize;
+    u32 numIterations = k_defaultNumIterations;
+    std::vector<u32> threadCounts = { 1, 2, 4 };
+    std::string outputFilePath;
+    
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        bool hasValue = (i + 1 < argc);
+        
+        if (argument == "--size" && hasValue && std::atoi(argv[i + 1]) > 0)
+        {
+            size = u32(std::atoi(argv[++i]));
+        }
+        else if (argument == "--iterations" && hasValue && std::atoi(argv[i + 1]) > 0)
+        {
+            numIterations = u32(std::atoi(argv[++i]));
+        }
+        else if (argument == "--threads" && hasValue && ParseThreadCounts(argv[i + 1], threadCounts))
+        {
+            ++i;
+        }
+        else if (argument == "--output" && hasValue)
+        {
+            outputFilePath = argv[++i];
+        }
+        else
+        {
+            std::fprintf(stderr, "Usage: %s [--size <pixels>] [--iterations <count>] [--threads <count,count,...>] [--output <file.json>]\n", argv[0]);
+            return 1;
+        }
+    }
+    
+    BenchmarkApplication application;
+    LifecycleManager lifecycleManager(&application);
+    auto image = Application::Get()->GetResourcePool()->CreateResource<Image>("ImageFormatConverterBenchmark");
+    
+    std::vector<u8> data(size * size * 4);
+    u32 seed = 1;
+    for (auto& value : data)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        value = u8(seed >> 24);
+    }
+    
+    std::printf("Median time to convert a %ux%u RGBA8888 image %s SIMD, over %u iterations.\n\n", size, size, k_isSimd ? "with" : "without", numIterations);
+    std::printf("%-18s %7s %12s %12s\n", "Conversion", "Threads", "Time (ms)", "MPixels/s");
+    
+    Json::Value conversions(Json::arrayValue);
+    bool isValid = true;
+    for (const auto& conversion : k_conversions)
+    {
+        auto expected = ImageFormatConverterReference::Convert(conversion.m_format, data.data(), size, size, conversion.m_dithering);
+        
+        Json::Value runs(Json::arrayValue);
+        for (auto numThreads : threadCounts)
+        {
+            auto result = Run(image.get(), conversion, data, expected, size, numThreads, numIterations);
+            f64 megapixelsPerSecond = (result.m_medianMs > 0.0) ? f64(size) * size / (result.m_medianMs * 1000.0) : 0.0;
+            std::printf("%-18s %7u %12.3f %12.1f\n", conversion.m_name, numThreads, result.m_medianMs, megapixelsPerSecond);
+            
+            if (result.m_isCorrect == false)
+            {
+                std::fprintf(stderr, "Conversion '%s' with %u threads did not match the reference.\n", conversion.m_name, numThreads);
+                isValid = false;
+            }
+            
+            Json::Value run(Json::objectValue);
+            run["NumThreads"] = Json::UInt(numThreads);
+            run["MedianMs"] = result.m_medianMs;
+            run["MegapixelsPerSecond"] = megapixelsPerSecond;
+            runs.append(run);
+        }
+        
+        Json::Value conversionResults(Json::objectValue);
+        conversionResults["Name"] = conversion.m_name;
+        conversionResults["Runs"] = runs;
+        conversions.append(conversionResults);
+    }
+    
+    if (outputFilePath.empty() == false)
+    {
+        Json::Value output(Json::objectValue);
+        output["Size"] = Json::UInt(size);
+        output["NumIterations"] = Json::UInt(numIterations);
+        output["Simd"] = k_isSimd;
+        output["Conversions"] = conversions;
+        
+        std::ofstream file(outputFilePath);
+        file << Json::StyledWriter().write(output);
+        if (file.good() == false)
+        {
+            std::fprintf(stderr, "Could not write the results to '%s'.\n", outputFilePath.c_str());
+            return 1;
+        }
+    }
+    
+    return isValid ? 0 : 1;
+}
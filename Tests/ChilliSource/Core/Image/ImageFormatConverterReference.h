@@ -0,0 +1,155 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_TESTS_CORE_IMAGE_IMAGEFORMATCONVERTERREFERENCE_H
+#define _CHILLISOURCE_TESTS_CORE_IMAGE_IMAGEFORMATCONVERTERREFERENCE_H
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Image/ImageFormat.h>
+#include <ChilliSource/Core/Image/ImageFormatConverter.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace ChilliSource
+{
+    /// A plain per-pixel implementation of the conversions from RGBA8888 performed by
+    /// ImageFormatConverter, written directly from the definition of each format. The SIMD
+    /// kernels and the block-wise dithering must produce exactly the same output.
+    ///
+    namespace ImageFormatConverterReference
+    {
+        /// @param format
+        ///     The output format.
+        ///
+        /// @return The number of bytes per output pixel.
+        ///
+        inline u32 GetBytesPerPixel(ImageFormat format) noexcept
+        {
+            switch (format)
+            {
+                case ImageFormat::k_RGB888:
+                    return 3;
+                case ImageFormat::k_RGBA4444:
+                case ImageFormat::k_RGB565:
+                case ImageFormat::k_LumA88:
+                    return 2;
+                case ImageFormat::k_Lum8:
+                    return 1;
+                default:
+                    CS_LOG_FATAL("Unsupported reference conversion.");
+                    return 0;
+            }
+        }
+        
+        /// Converts RGBA8888 image data to the given format one pixel at a time. Ordered
+        /// dithering adds the 4x4 Bayer threshold for each pixel, scaled to the quantisation
+        /// step of each colour channel, before the channel is truncated.
+        ///
+        /// @param format
+        ///     The output format.
+        /// @param source
+        ///     The RGBA8888 image data.
+        /// @param width
+        ///     The width of the image in pixels.
+        /// @param height
+        ///     The height of the image in pixels.
+        /// @param dithering
+        ///     The dithering to apply. Only the 16-bit formats are dithered.
+        ///
+        /// @return The converted image data.
+        ///
+        inline std::vector<u8> Convert(ImageFormat format, const u8* source, u32 width, u32 height, ImageFormatConverter::Dithering dithering) noexcept
+        {
+            const u8 k_bayerMatrix[4][4] =
+            {
+                { 0, 8, 2, 10 },
+                { 12, 4, 14, 6 },
+                { 3, 11, 1, 9 },
+                { 15, 7, 13, 5 }
+            };
+            
+            bool isDithered = (dithering == ImageFormatConverter::Dithering::k_ordered && (format == ImageFormat::k_RGBA4444 || format == ImageFormat::k_RGB565));
+            u32 channelBits[3] = { 4, 4, 4 };
+            if (format == ImageFormat::k_RGB565)
+            {
+                channelBits[0] = 5;
+                channelBits[1] = 6;
+                channelBits[2] = 5;
+            }
+            
+            u32 bytesPerPixel = GetBytesPerPixel(format);
+            std::vector<u8> output(width * height * bytesPerPixel);
+            for (u32 y = 0; y < height; ++y)
+            {
+                for (u32 x = 0; x < width; ++x)
+                {
+                    const u8* pixel = source + (y * width + x) * 4;
+                    u32 r = pixel[0], g = pixel[1], b = pixel[2], a = pixel[3];
+                    if (isDithered)
+                    {
+                        u32 threshold = k_bayerMatrix[y % 4][x % 4];
+                        r = std::min(r + (threshold >> (channelBits[0] - 4)), 255u);
+                        g = std::min(g + (threshold >> (channelBits[1] - 4)), 255u);
+                        b = std::min(b + (threshold >> (channelBits[2] - 4)), 255u);
+                    }
+                    
+                    u8* out = output.data() + (y * width + x) * bytesPerPixel;
+                    u16 value = 0;
+                    switch (format)
+                    {
+                        case ImageFormat::k_RGB888:
+                            out[0] = u8(r);
+                            out[1] = u8(g);
+                            out[2] = u8(b);
+                            break;
+                        case ImageFormat::k_RGBA4444:
+                            value = u16(((r >> 4) << 12) | ((g >> 4) << 8) | ((b >> 4) << 4) | (a >> 4));
+                            out[0] = u8(value & 0xff);
+                            out[1] = u8(value >> 8);
+                            break;
+                        case ImageFormat::k_RGB565:
+                            value = u16(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+                            out[0] = u8(value & 0xff);
+                            out[1] = u8(value >> 8);
+                            break;
+                        case ImageFormat::k_LumA88:
+                            out[0] = u8(r);
+                            out[1] = u8(a);
+                            break;
+                        case ImageFormat::k_Lum8:
+                            out[0] = u8(r);
+                            break;
+                        default:
+                            break;
+                    }
+                }
+            }
+            
+            return output;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,267 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Image/ImageFormatConverter.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Base/DeviceInfo.h>
+#include <ChilliSource/Core/Base/LifecycleManager.h>
+#include <ChilliSource/Core/Base/RenderInfo.h>
+#include <ChilliSource/Core/Base/ScreenInfo.h>
+#include <ChilliSource/Core/Base/SystemInfo.h>
+#include <ChilliSource/Core/Image/ImageCompression.h>
+#include <ChilliSource/Core/Math/Vector2.h>
+#include <ChilliSource/Core/Resource/ResourcePool.h>
+#include <ChilliSource/Core/Threading/TaskContext.h>
+#include <ChilliSource/Core/Threading/TaskPool.h>
+#include <ChilliSource/Core/Threading/TaskType.h>
+
+#include "ImageFormatConverterReference.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+namespace
+{
+    using namespace ChilliSource;
+    using ImageFormatConverter::Dithering;
+    
+    /// Widths which leave every possible remainder after the 8 and 16 pixel SIMD blocks, and
+    /// which cross the 256 pixel blocks that dithered rows are converted in.
+    ///
+    const std::vector<u32> k_widths = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 31, 32, 33, 47, 63, 255, 256, 257, 259, 517 };
+    const std::vector<u32> k_heights = { 1, 2, 3, 5 };
+    
+    /// A conversion from RGBA8888 to another format, through each of ImageFormatConverter's
+    /// entry points.
+    ///
+    struct Conversion final
+    {
+        const char* m_name;
+        ImageFormat m_format;
+        Dithering m_dithering;
+        void (*m_convertImage)(Image* image, Dithering dithering);
+        void (*m_convertImageWithTasks)(const TaskContext& taskContext, Image* image, Dithering dithering);
+        ImageFormatConverter::ImageBuffer (*m_convertBuffer)(const u8* data, u32 dataSize, u32 width, Dithering dithering);
+    };
+    
+    const Conversion k_conversions[] =
+    {
+        { "RGB888", ImageFormat::k_RGB888, Dithering::k_none,
+            [](Image* image, Dithering) { ImageFormatConverter::RGBA8888ToRGB888(image); },
+            [](const TaskContext& taskContext, Image* image, Dithering) { ImageFormatConverter::RGBA8888ToRGB888(taskContext, image); },
+            [](const u8* data, u32 dataSize, u32, Dithering) { return ImageFormatConverter::RGBA8888ToRGB888(data, dataSize); } },
+        { "RGBA4444", ImageFormat::k_RGBA4444, Dithering::k_none,
+            [](Image* image, Dithering dithering) { ImageFormatConverter::RGBA8888ToRGBA4444(image, dithering); },
+            [](const TaskContext& taskContext, Image* image, Dithering dithering) { ImageFormatConverter::RGBA8888ToRGBA4444(taskContext, image, dithering); },
+            [](const u8* data, u32 dataSize, u32 width, Dithering dithering) { return ImageFormatConverter::RGBA8888ToRGBA4444(data, dataSize, width, dithering); } },
+        { "RGBA4444Dithered", ImageFormat::k_RGBA4444, Dithering::k_ordered,
+            [](Image* image, Dithering dithering) { ImageFormatConverter::RGBA8888ToRGBA4444(image, dithering); },
+            [](const TaskContext& taskContext, Image* image, Dithering dithering) { ImageFormatConverter::RGBA8888ToRGBA4444(taskContext, image, dithering); },
+            [](const u8* data, u32 dataSize, u32 width, Dithering dithering) { return ImageFormatConverter::RGBA8888ToRGBA4444(data, dataSize, width, dithering); } },
+        { "RGB565", ImageFormat::k_RGB565, Dithering::k_none,
+            [](Image* image, Dithering dithering) { ImageFormatConverter::RGBA8888ToRGB565(image, dithering); },
+            [](const TaskContext& taskContext, Image* image, Dithering dithering) { ImageFormatConverter::RGBA8888ToRGB565(taskContext, image, dithering); },
+            [](const u8* data, u32 dataSize, u32 width, Dithering dithering) { return ImageFormatConverter::RGBA8888ToRGB565(data, dataSize, width, dithering); } },
+        { "RGB565Dithered", ImageFormat::k_RGB565, Dithering::k_ordered,
+            [](Image* image, Dithering dithering) { ImageFormatConverter::RGBA8888ToRGB565(image, dithering); },
+            [](const TaskContext& taskContext, Image* image, Dithering dithering) { ImageFormatConverter::RGBA8888ToRGB565(taskContext, image, dithering); },
+            [](const u8* data, u32 dataSize, u32 width, Dithering dithering) { return ImageFormatConverter::RGBA8888ToRGB565(data, dataSize, width, dithering); } },
+        { "LumA88", ImageFormat::k_LumA88, Dithering::k_none,
+            [](Image* image, Dithering) { ImageFormatConverter::RGBA8888ToLumA88(image); },
+            [](const TaskContext& taskContext, Image* image, Dithering) { ImageFormatConverter::RGBA8888ToLumA88(taskContext, image); },
+            [](const u8* data, u32 dataSize, u32, Dithering) { return ImageFormatConverter::RGBA8888ToLumA88(data, dataSize); } },
+        { "Lum8", ImageFormat::k_Lum8, Dithering::k_none,
+            [](Image* image, Dithering) { ImageFormatConverter::RGBA8888ToLum8(image); },
+            [](const TaskContext& taskContext, Image* image, Dithering) { ImageFormatConverter::RGBA8888ToLum8(taskContext, image); },
+            [](const u8* data, u32 dataSize, u32, Dithering) { return ImageFormatConverter::RGBA8888ToLum8(data, dataSize); } },
+    };
+    
+    /// A minimal application with only the default systems, which include the resource pool the
+    /// test images are created through.
+    ///
+    class TestApplication final : public Application
+    {
+    public:
+        TestApplication() noexcept
+            : Application(SystemInfoCUPtr(new SystemInfo(DeviceInfo("Host", "Host", "Host", "", "en_GB", "en", "", 4), ScreenInfo(Vector2(1.0f, 1.0f), 1.0f, 1.0f, {}),
+                RenderInfo(false, false, false, false, 1024, 8), "1.0")))
+        {
+        }
+        
+    private:
+        void CreateSystems() noexcept override {}
+        void OnInit() noexcept override {}
+        void PushInitialState() noexcept override {}
+        void OnDestroy() noexcept override {}
+    };
+    
+    /// @param numPixels
+    ///     The number of pixels.
+    /// @param seed
+    ///     The seed for the pixel values.
+    ///
+    /// @return Pseudo-random RGBA8888 image data. Every fourth pixel is pure white so that the
+    ///     saturation of dithered channels is covered.
+    ///
+    std::vector<u8> CreateImageData(u32 numPixels, u32 seed)
+    {
+        std::vector<u8> data(numPixels * 4);
+        for (u32 i = 0; i < numPixels * 4; ++i)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            data[i] = ((i / 4) % 4 == 3) ? 255 : u8(seed >> 24);
+        }
+        return data;
+    }
+    
+    /// Runs each conversion through each of ImageFormatConverter's entry points, and checks the
+    /// output of the SIMD kernels built for the host matches the per-pixel reference.
+    ///
+    class ImageFormatConverterTest : public ::testing::TestWithParam<Conversion>
+    {
+    protected:
+        void SetUp() override
+        {
+            m_application.reset(new TestApplication());
+            m_lifecycleManager.reset(new LifecycleManager(m_application.get()));
+            m_image = Application::Get()->GetResourcePool()->CreateResource<Image>("ImageFormatConverterTest");
+        }
+        
+        void TearDown() override
+        {
+            m_image.reset();
+            m_lifecycleManager.reset();
+            m_application.reset();
+        }
+        
+        /// Rebuilds the test image with the given RGBA8888 data.
+        ///
+        void BuildImage(const std::vector<u8>& data, u32 width, u32 height)
+        {
+            Image::Descriptor desc;
+            desc.m_compression = ImageCompression::k_none;
+            desc.m_format = ImageFormat::k_RGBA8888;
+            desc.m_width = width;
+            desc.m_height = height;
+            desc.m_dataSize = u32(data.size());
+            
+            Image::ImageDataUPtr imageData(new u8[data.size()]);
+            std::memcpy(imageData.get(), data.data(), data.size());
+            m_image->Build(desc, std::move(imageData));
+        }
+        
+        /// @return Whether the test image has the given format and contents.
+        ///
+        ::testing::AssertionResult ImageMatches(ImageFormat format, u32 width, u32 height, const std::vector<u8>& expected) const
+        {
+            if (m_image->GetFormat() != format || m_image->GetWidth() != width || m_image->GetHeight() != height)
+            {
+                return ::testing::AssertionFailure() << "the image description is wrong";
+            }
+            return BufferMatches(m_image->GetData(), m_image->GetDataSize(), expected);
+        }
+        
+        /// @return Whether the buffer has the given contents, or the position of the first byte
+        ///     which doesn't.
+        ///
+        static ::testing::AssertionResult BufferMatches(const u8* data, u32 dataSize, const std::vector<u8>& expected)
+        {
+            if (dataSize != expected.size())
+            {
+                return ::testing::AssertionFailure() << "the size is " << dataSize << " rather than " << expected.size();
+            }
+            
+            auto mismatch = std::mismatch(expected.begin(), expected.end(), data);
+            if (mismatch.first != expected.end())
+            {
+                return ::testing::AssertionFailure() << "byte " << (mismatch.first - expected.begin()) << " is " << u32(*mismatch.second) << " rather than " << u32(*mismatch.first);
+            }
+            return ::testing::AssertionSuccess();
+        }
+        
+        std::unique_ptr<TestApplication> m_application;
+        std::unique_ptr<LifecycleManager> m_lifecycleManager;
+        std::shared_ptr<Image> m_image;
+    };
+    
+    TEST_P(ImageFormatConverterTest, ImageMatchesReference)
+    {
+        const auto& conversion = GetParam();
+        for (auto height : k_heights)
+        {
+            for (auto width : k_widths)
+            {
+                auto data = CreateImageData(width * height, width + height);
+                auto expected = ImageFormatConverterReference::Convert(conversion.m_format, data.data(), width, height, conversion.m_dithering);
+                
+                BuildImage(data, width, height);
+                conversion.m_convertImage(m_image.get(), conversion.m_dithering);
+                EXPECT_TRUE(ImageMatches(conversion.m_format, width, height, expected)) << width << "x" << height;
+            }
+        }
+    }
+    
+    TEST_P(ImageFormatConverterTest, UnalignedBufferMatchesReference)
+    {
+        const auto& conversion = GetParam();
+        for (auto height : k_heights)
+        {
+            for (auto width : k_widths)
+            {
+                //The SIMD kernels use unaligned loads and stores, so start the source off any natural alignment.
+                auto data = CreateImageData(width * height + 1, width * height);
+                const u8* source = data.data() + 3;
+                auto expected = ImageFormatConverterReference::Convert(conversion.m_format, source, width, height, conversion.m_dithering);
+                
+                auto buffer = conversion.m_convertBuffer(source, width * height * 4, width, conversion.m_dithering);
+                EXPECT_TRUE(BufferMatches(buffer.m_data.get(), buffer.m_size, expected)) << width << "x" << height;
+            }
+        }
+    }
+    
+    TEST_P(ImageFormatConverterTest, ImageSplitIntoTasksMatchesReference)
+    {
+        //Large enough to be split into several tasks, each of whole rows, with an odd width.
+        const u32 k_width = 517;
+        const u32 k_height = 300;
+        
+        TaskPool taskPool(TaskType::k_small, 1);
+        TaskContext taskContext(TaskType::k_small, &taskPool);
+        
+        const auto& conversion = GetParam();
+        auto data = CreateImageData(k_width * k_height, 7);
+        auto expected = ImageFormatConverterReference::Convert(conversion.m_format, data.data(), k_width, k_height, conversion.m_dithering);
+        
+        BuildImage(data, k_width, k_height);
+        conversion.m_convertImageWithTasks(taskContext, m_image.get(), conversion.m_dithering);
+        EXPECT_TRUE(ImageMatches(conversion.m_format, k_width, k_height, expected));
+    }
+    
+    INSTANTIATE_TEST_SUITE_P(Conversions, ImageFormatConverterTest, ::testing::ValuesIn(k_conversions), [](const ::testing::TestParamInfo<Conversion>& info)
+    {
+        return std::string(info.param.m_name);
+    });
+}
@@ -0,0 +1,100 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/String/InternedString.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unordered_set>
+
+namespace
+{
+    using namespace ChilliSource;
+    
+    /// Interning the same string twice gives the same entry, and different strings get
+    /// different ids.
+    ///
+    TEST(InternedStringTest, EqualStringsShareAnEntry)
+    {
+        InternedString first("InternedStringTestFirst");
+        InternedString second(std::string("InternedString") + "TestFirst");
+        InternedString other("InternedStringTestOther");
+        
+        EXPECT_EQ(first, second);
+        EXPECT_EQ(first.GetId(), second.GetId());
+        EXPECT_EQ(&first.GetString(), &second.GetString());
+        EXPECT_NE(first, other);
+        EXPECT_NE(first.GetId(), other.GetId());
+        EXPECT_EQ("InternedStringTestOther", other.GetString());
+        EXPECT_EQ(InternedString::CalculateHash("InternedStringTestOther"), other.GetHash());
+    }
+    
+    /// The empty string always has the id 0 and isn't added to the table.
+    ///
+    TEST(InternedStringTest, EmptyStringIsNotInterned)
+    {
+        auto numInternedStrings = InternedString::GetNumInternedStrings();
+        
+        InternedString empty("");
+        EXPECT_TRUE(empty.IsEmpty());
+        EXPECT_EQ(0u, empty.GetId());
+        EXPECT_EQ(InternedString(), empty);
+        EXPECT_EQ(InternedString::CalculateHash(""), empty.GetHash());
+        EXPECT_EQ(numInternedStrings, InternedString::GetNumInternedStrings());
+    }
+    
+    /// The table only grows when a new string is interned; looking strings up with TryGet()
+    /// never adds them.
+    ///
+    TEST(InternedStringTest, OnlyNewStringsAreAdded)
+    {
+        auto numInternedStrings = InternedString::GetNumInternedStrings();
+        
+        InternedString found;
+        EXPECT_FALSE(InternedString::TryGet("InternedStringTestLookedUp", found));
+        EXPECT_EQ(numInternedStrings, InternedString::GetNumInternedStrings());
+        
+        InternedString added("InternedStringTestLookedUp");
+        EXPECT_EQ(numInternedStrings + 1, InternedString::GetNumInternedStrings());
+        
+        InternedString("InternedStringTestLookedUp");
+        EXPECT_TRUE(InternedString::TryGet("InternedStringTestLookedUp", found));
+        EXPECT_EQ(added, found);
+        EXPECT_EQ(numInternedStrings + 1, InternedString::GetNumInternedStrings());
+    }
+    
+    /// Ids are unique for every string interned.
+    ///
+    TEST(InternedStringTest, IdsAreUnique)
+    {
+        std::unordered_set<u32> ids;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            InternedString internedString("InternedStringTestId" + std::to_string(i));
+            EXPECT_TRUE(ids.insert(internedString.GetId()).second);
+            EXPECT_NE(0u, internedString.GetId());
+        }
+    }
+}
@@ -0,0 +1,533 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Networking/ContentDownload/ContentManagementSystem.h>
+
+#include <CSBackend/Networking/POSIX/Http/HttpRequestSystem.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Base/DeviceInfo.h>
+#include <ChilliSource/Core/Base/LifecycleManager.h>
+#include <ChilliSource/Core/Base/RenderInfo.h>
+#include <ChilliSource/Core/Base/ScreenInfo.h>
+#include <ChilliSource/Core/Base/SystemInfo.h>
+#include <ChilliSource/Core/Cryptographic/BaseEncoding.h>
+#include <ChilliSource/Core/File/FileSystem.h>
+#include <ChilliSource/Core/Math/Vector2.h>
+#include <ChilliSource/Core/String/StringUtils.h>
+#include <ChilliSource/Networking/ContentDownload/MoContentDownloader.h>
+
+#include <LocalHttpServer.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+namespace
+{
+    using namespace ChilliSource;
+    using ChilliSource::Test::LocalHttpServer;
+    
+    const char k_tempDirectory[] = "_Temp-CMS/";
+    
+    /// A minimal application which creates the http request system and a content management
+    /// system which downloads from the given server url through a MoContentDownloader.
+    ///
+    class TestApplication final : public Application
+    {
+    public:
+        TestApplication(const std::string& manifestUrl) noexcept
+            : Application(SystemInfoCUPtr(new SystemInfo(DeviceInfo("Host", "Host", "Host", "", "en_GB", "en", "", 4), ScreenInfo(Vector2(1.0f, 1.0f), 1.0f, 1.0f, {}),
+                RenderInfo(false, false, false, false, 1024, 8), "1.0"))), m_manifestUrl(manifestUrl)
+        {
+        }
+        
+        HttpRequestSystem* GetHttpRequestSystem() noexcept { return m_httpRequestSystem; }
+        ContentManagementSystem* GetContentManagementSystem() noexcept { return m_contentManagementSystem; }
+        
+    private:
+        void CreateSystems() noexcept override
+        {
+            m_httpRequestSystem = CreateSystem<HttpRequestSystem>();
+            m_contentDownloader.reset(new MoContentDownloader(m_httpRequestSystem, m_manifestUrl, {}));
+            m_contentManagementSystem = CreateSystem<ContentManagementSystem>(m_contentDownloader.get());
+        }
+        
+        void OnInit() noexcept override {}
+        void PushInitialState() noexcept override {}
+        void OnDestroy() noexcept override {}
+        
+        const std::string m_manifestUrl;
+        HttpRequestSystem* m_httpRequestSystem = nullptr;
+        std::unique_ptr<MoContentDownloader> m_contentDownloader;
+        ContentManagementSystem* m_contentManagementSystem = nullptr;
+    };
+    
+    /// @return A package body of the given size which differs between seeds.
+    ///
+    std::string CreatePackageData(u32 size, u32 seed)
+    {
+        std::string data(size, ' ');
+        for (u32 i = 0; i < size; ++i)
+        {
+            data[i] = char((i * 31 + seed * 7) % 251);
+        }
+        return data;
+    }
+    
+    /// @return The checksum of the given data in the format used by the content manifest: the
+    /// lower case SHA1 hex string, base 64 encoded without the trailing '='.
+    ///
+    std::string CalculateChecksum(const std::string& data)
+    {
+        CSHA1 hash;
+        hash.Update(reinterpret_cast<const u8*>(data.data()), u32(data.size()));
+        hash.Final();
+        
+        u8 digest[20];
+        hash.GetHash(digest);
+        
+        const char k_hexDigits[] = "0123456789abcdef";
+        std::string hex;
+        for (u8 byte : digest)
+        {
+            hex += k_hexDigits[byte >> 4];
+            hex += k_hexDigits[byte & 0x0f];
+        }
+        
+        std::string checksum = BaseEncoding::Base64Encode(hex);
+        StringUtils::ChopTrailingChars(checksum, '=');
+        return checksum;
+    }
+    
+    /// Runs the content management system in a stepped application, downloading the manifest and
+    /// packages from a local server through the POSIX http backend.
+    ///
+    /// By default the server serves the manifest describing the packages in m_packages and the
+    /// packages themselves, honouring the Range header of resumed downloads.
+    ///
+    class ContentManagementSystemTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            m_server.reset(new LocalHttpServer([this](const LocalHttpServer::Request& request)
+            {
+                return m_handler(request);
+            }));
+            
+            m_application.reset(new TestApplication(m_server->GetUrl("/manifest")));
+            m_lifecycleManager.reset(new LifecycleManager(m_application.get()));
+            m_httpRequestSystem = m_application->GetHttpRequestSystem();
+            m_contentManagementSystem = m_application->GetContentManagementSystem();
+            m_fileSystem = Application::Get()->GetFileSystem();
+            
+            //The manifest is only requested if the network is reachable, which depends on the host.
+            bool isReachableReceived = false;
+            bool isReachable = false;
+            m_httpRequestSystem->CheckReachability([&](bool reachable)
+            {
+                isReachable = reachable;
+                isReachableReceived = true;
+            });
+            UpdateUntil([&]() { return isReachableReceived; });
+            if (isReachable == false)
+            {
+                GTEST_SKIP() << "The host has no active network interface.";
+            }
+        }
+        
+        void TearDown() override
+        {
+            m_fileSystem->DeleteDirectory(StorageLocation::k_DLC, "");
+            m_fileSystem->CreateDirectoryPath(StorageLocation::k_DLC, "");
+            
+            m_lifecycleManager.reset();
+            m_application.reset();
+            m_server.reset();
+        }
+        
+        /// @return The response for the content manifest describing m_packages.
+        ///
+        LocalHttpServer::Response CreateManifestResponse() const
+        {
+            LocalHttpServer::Response response;
+            response.m_body = "<Manifest DLCEnabled=\"true\" Timestamp=\"1\">";
+            for (const auto& package : m_packages)
+            {
+                response.m_body += "<Package ID=\"" + package.first + "\" URL=\"" + m_server->GetUrl("/" + package.first) + "\" Checksum=\"" + CalculateChecksum(package.second) +
+                    "\" Size=\"" + std::to_string(package.second.size()) + "\"><File Name=\"Content.txt\" Checksum=\"none\"/></Package>";
+            }
+            response.m_body += "</Manifest>";
+            return response;
+        }
+        
+        /// @return The response for the given request for a package, which is partial content if a
+        /// range is requested.
+        ///
+        LocalHttpServer::Response CreatePackageResponse(const LocalHttpServer::Request& request) const
+        {
+            LocalHttpServer::Response response;
+            
+            const std::string& data = m_packages.at(request.m_path.substr(1));
+            auto rangeIt = request.m_headers.find("range");
+            if (rangeIt != request.m_headers.end())
+            {
+                u64 offset = std::stoull(rangeIt->second.substr(std::string("bytes=").size()));
+                response.m_code = 206;
+                response.m_headers.push_back(std::make_pair("Content-Range", "bytes " + std::to_string(offset) + "-" + std::to_string(data.size() - 1) + "/" + std::to_string(data.size())));
+                response.m_body = data.substr(offset);
+            }
+            else
+            {
+                response.m_body = data;
+            }
+            
+            return response;
+        }
+        
+        /// @return The requests the server has received for packages.
+        ///
+        std::vector<LocalHttpServer::Request> GetPackageRequests() const
+        {
+            std::vector<LocalHttpServer::Request> packageRequests;
+            for (const auto& request : m_server->GetRequests())
+            {
+                if (request.m_path != "/manifest")
+                {
+                    packageRequests.push_back(request);
+                }
+            }
+            return packageRequests;
+        }
+        
+        /// Steps the application until the given condition is met, failing the test if it takes
+        /// more than a few seconds.
+        ///
+        void UpdateUntil(const std::function<bool()>& condition)
+        {
+            auto start = std::chrono::steady_clock::now();
+            while (condition() == false)
+            {
+                ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(10)) << "Timed out waiting for the content management system.";
+                
+                m_lifecycleManager->SystemUpdate();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        
+        /// Checks for updates and waits for the result.
+        ///
+        ContentManagementSystem::CheckForUpdatesResult CheckForUpdates()
+        {
+            bool isComplete = false;
+            auto result = ContentManagementSystem::CheckForUpdatesResult::k_checkFailed;
+            m_contentManagementSystem->CheckForUpdates([&](ContentManagementSystem::CheckForUpdatesResult checkResult)
+            {
+                result = checkResult;
+                isComplete = true;
+            });
+            UpdateUntil([&]() { return isComplete; });
+            return result;
+        }
+        
+        /// Downloads the available updates and waits for the result.
+        ///
+        ContentManagementSystem::Result DownloadUpdates()
+        {
+            bool isComplete = false;
+            auto result = ContentManagementSystem::Result::k_failed;
+            m_contentManagementSystem->DownloadUpdates([&](ContentManagementSystem::Result downloadResult)
+            {
+                result = downloadResult;
+                isComplete = true;
+            }, nullptr);
+            UpdateUntil([&]() { return isComplete; });
+            return result;
+        }
+        
+        /// @return The path of the temporary file the given package is downloaded to.
+        ///
+        std::string GetTempPackageFilePath(const std::string& packageId) const
+        {
+            return k_tempDirectory + packageId + ".packzip";
+        }
+        
+        /// @return The contents of the temporary file the given package has been downloaded to.
+        ///
+        std::string ReadTempPackage(const std::string& packageId) const
+        {
+            std::string contents;
+            m_fileSystem->ReadFile(StorageLocation::k_DLC, GetTempPackageFilePath(packageId), contents);
+            return contents;
+        }
+        
+        std::map<std::string, std::string> m_packages;
+        LocalHttpServer::Handler m_handler = [this](const LocalHttpServer::Request& request)
+        {
+            return (request.m_path == "/manifest") ? CreateManifestResponse() : CreatePackageResponse(request);
+        };
+        std::unique_ptr<LocalHttpServer> m_server;
+        std::unique_ptr<TestApplication> m_application;
+        std::unique_ptr<LifecycleManager> m_lifecycleManager;
+        HttpRequestSystem* m_httpRequestSystem = nullptr;
+        ContentManagementSystem* m_contentManagementSystem = nullptr;
+        FileSystem* m_fileSystem = nullptr;
+    };
+    
+    /// Checks that every package in the manifest is downloaded to its temporary file and validated.
+    ///
+    TEST_F(ContentManagementSystemTest, DownloadsPackages)
+    {
+        m_packages["PackageA"] = CreatePackageData(40 * 1024, 1);
+        m_packages["PackageB"] = CreatePackageData(1000, 2);
+        
+        ASSERT_EQ(ContentManagementSystem::CheckForUpdatesResult::k_available, CheckForUpdates());
+        ASSERT_EQ(ContentManagementSystem::Result::k_succeeded, DownloadUpdates());
+        
+        EXPECT_EQ(m_packages["PackageA"], ReadTempPackage("PackageA"));
+        EXPECT_EQ(m_packages["PackageB"], ReadTempPackage("PackageB"));
+        
+        auto requests = m_server->GetRequests();
+        ASSERT_EQ(3u, requests.size());
+        EXPECT_EQ("POST", requests[0].m_method);
+        EXPECT_EQ("/manifest", requests[0].m_path);
+    }
+    
+    /// Checks that packages larger than the http request system's buffer are streamed to disk as
+    /// they are flushed, and still validate.
+    ///
+    TEST_F(ContentManagementSystemTest, StreamsFlushedPackagesToDisk)
+    {
+        m_packages["PackageA"] = CreatePackageData(100 * 1024, 1);
+        m_packages["PackageB"] = CreatePackageData(70 * 1024 + 3, 2);
+        m_httpRequestSystem->SetMaxBufferSize(4 * 1024);
+        
+        ASSERT_EQ(ContentManagementSystem::CheckForUpdatesResult::k_available, CheckForUpdates());
+        ASSERT_EQ(ContentManagementSystem::Result::k_succeeded, DownloadUpdates());
+        
+        EXPECT_EQ(m_packages["PackageA"], ReadTempPackage("PackageA"));
+        EXPECT_EQ(m_packages["PackageB"], ReadTempPackage("PackageB"));
+    }
+    
+    /// Checks that no more than the maximum number of packages are downloaded at once, and that
+    /// the remaining packages are started as others complete.
+    ///
+    TEST_F(ContentManagementSystemTest, LimitsConcurrentDownloads)
+    {
+        for (u32 i = 0; i < 4; ++i)
+        {
+            m_packages["Package" + std::to_string(i)] = CreatePackageData(8 * 1024, i);
+        }
+        m_contentManagementSystem->SetMaxConcurrentDownloads(2);
+        
+        ASSERT_EQ(ContentManagementSystem::CheckForUpdatesResult::k_available, CheckForUpdates());
+        
+        //Package responses are held until released, so the number of requests received is the
+        //number of downloads in flight.
+        std::atomic<bool> isReleased(false);
+        m_handler = [&](const LocalHttpServer::Request& request)
+        {
+            if (request.m_path != "/manifest")
+            {
+                auto start = std::chrono::steady_clock::now();
+                while (isReleased == false && std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+            return CreatePackageResponse(request);
+        };
+        
+        bool isComplete = false;
+        auto result = ContentManagementSystem::Result::k_failed;
+        m_contentManagementSystem->DownloadUpdates([&](ContentManagementSystem::Result downloadResult)
+        {
+            result = downloadResult;
+            isComplete = true;
+        }, nullptr);
+        
+        UpdateUntil([&]() { return GetPackageRequests().size() >= 2; });
+        
+        auto waitStart = std::chrono::steady_clock::now();
+        UpdateUntil([&]() { return std::chrono::steady_clock::now() - waitStart > std::chrono::milliseconds(100); });
+        EXPECT_EQ(2u, GetPackageRequests().size());
+        
+        isReleased = true;
+        UpdateUntil([&]() { return isComplete; });
+        
+        ASSERT_EQ(ContentManagementSystem::Result::k_succeeded, result);
+        EXPECT_EQ(4u, GetPackageRequests().size());
+        for (const auto& package : m_packages)
+        {
+            EXPECT_EQ(package.second, ReadTempPackage(package.first));
+        }
+    }
+    
+    /// Checks that a partially downloaded package is resumed with a ranged request, and that the
+    /// existing data is included when the package is validated.
+    ///
+    TEST_F(ContentManagementSystemTest, ResumesPartialDownload)
+    {
+        m_packages["PackageA"] = CreatePackageData(40 * 1024, 1);
+        
+        ASSERT_EQ(ContentManagementSystem::CheckForUpdatesResult::k_available, CheckForUpdates());
+        m_fileSystem->WriteFile(StorageLocation::k_DLC, GetTempPackageFilePath("PackageA"), m_packages["PackageA"].substr(0, 10000));
+        
+        ASSERT_EQ(ContentManagementSystem::Result::k_succeeded, DownloadUpdates());
+        EXPECT_EQ(m_packages["PackageA"], ReadTempPackage("PackageA"));
+        
+        auto requests = GetPackageRequests();
+        ASSERT_EQ(1u, requests.size());
+        EXPECT_EQ("bytes=10000-", requests[0].m_headers["range"]);
+    }
+    
+    /// Checks that if the server ignores the range of a resumed download, the data which has
+    /// already been downloaded is skipped, including across flushes.
+    ///
+    TEST_F(ContentManagementSystemTest, ResumeSkipsDataWhenRangeIsIgnored)
+    {
+        m_packages["PackageA"] = CreatePackageData(40 * 1024, 1);
+        m_httpRequestSystem->SetMaxBufferSize(4 * 1024);
+        m_handler = [this](const LocalHttpServer::Request& request)
+        {
+            if (request.m_path == "/manifest")
+            {
+                return CreateManifestResponse();
+            }
+            
+            LocalHttpServer::Response response;
+            response.m_body = m_packages.at(request.m_path.substr(1));
+            return response;
+        };
+        
+        ASSERT_EQ(ContentManagementSystem::CheckForUpdatesResult::k_available, CheckForUpdates());
+        m_fileSystem->WriteFile(StorageLocation::k_DLC, GetTempPackageFilePath("PackageA"), m_packages["PackageA"].substr(0, 10000));
+        
+        ASSERT_EQ(ContentManagementSystem::Result::k_succeeded, DownloadUpdates());
+        EXPECT_EQ(m_packages["PackageA"], ReadTempPackage("PackageA"));
+    }
+    
+    /// Checks that a package which doesn't match its checksum fails the download and is removed
+    /// rather than being kept for resuming.
+    ///
+    TEST_F(ContentManagementSystemTest, CorruptPackageIsRemoved)
+    {
+        m_packages["PackageA"] = CreatePackageData(10 * 1024, 1);
+        
+        ASSERT_EQ(ContentManagementSystem::CheckForUpdatesResult::k_available, CheckForUpdates());
+        m_packages["PackageA"][100] ^= 0xff;
+        
+        EXPECT_EQ(ContentManagementSystem::Result::k_failed, DownloadUpdates());
+        EXPECT_FALSE(m_fileSystem->DoesFileExist(StorageLocation::k_DLC, GetTempPackageFilePath("PackageA")));
+    }
+    
+    /// Checks that an error status fails a package download without the error body being written
+    /// to the package, so a partial download can still be resumed later.
+    ///
+    TEST_F(ContentManagementSystemTest, ErrorStatusFailsDownloadWithoutWritingBody)
+    {
+        m_packages["PackageA"] = CreatePackageData(40 * 1024, 1);
+        
+        ASSERT_EQ(ContentManagementSystem::CheckForUpdatesResult::k_available, CheckForUpdates());
+        m_fileSystem->WriteFile(StorageLocation::k_DLC, GetTempPackageFilePath("PackageA"), m_packages["PackageA"].substr(0, 10000));
+        
+        m_handler = [](const LocalHttpServer::Request&)
+        {
+            LocalHttpServer::Response response;
+            response.m_code = 503;
+            response.m_body = "Service Unavailable";
+            return response;
+        };
+        
+        EXPECT_EQ(ContentManagementSystem::Result::k_failed, DownloadUpdates());
+        EXPECT_EQ(m_packages["PackageA"].substr(0, 10000), ReadTempPackage("PackageA"));
+        
+        //The partial package is resumed once the server recovers.
+        m_handler = [this](const LocalHttpServer::Request& request)
+        {
+            return CreatePackageResponse(request);
+        };
+        
+        EXPECT_EQ(ContentManagementSystem::Result::k_succeeded, DownloadUpdates());
+        EXPECT_EQ(m_packages["PackageA"], ReadTempPackage("PackageA"));
+    }
+    
+    /// Checks that an error status larger than the http request system's buffer, which is
+    /// flushed, fails a package download exactly once and leaves the partial package untouched.
+    ///
+    TEST_F(ContentManagementSystemTest, FlushedErrorStatusFailsDownloadOnce)
+    {
+        m_packages["PackageA"] = CreatePackageData(10 * 1024, 1);
+        m_httpRequestSystem->SetMaxBufferSize(1024);
+        
+        ASSERT_EQ(ContentManagementSystem::CheckForUpdatesResult::k_available, CheckForUpdates());
+        m_fileSystem->WriteFile(StorageLocation::k_DLC, GetTempPackageFilePath("PackageA"), m_packages["PackageA"].substr(0, 5000));
+        
+        m_handler = [](const LocalHttpServer::Request&)
+        {
+            LocalHttpServer::Response response;
+            response.m_code = 404;
+            response.m_body = std::string(16 * 1024, 'x');
+            return response;
+        };
+        
+        u32 numResults = 0;
+        auto result = ContentManagementSystem::Result::k_succeeded;
+        m_contentManagementSystem->DownloadUpdates([&](ContentManagementSystem::Result downloadResult)
+        {
+            result = downloadResult;
+            numResults++;
+        }, nullptr);
+        UpdateUntil([&]() { return numResults > 0; });
+        
+        //Any further responses for the request would arrive within a few updates.
+        auto waitStart = std::chrono::steady_clock::now();
+        UpdateUntil([&]() { return std::chrono::steady_clock::now() - waitStart > std::chrono::milliseconds(100); });
+        
+        EXPECT_EQ(1u, numResults);
+        EXPECT_EQ(ContentManagementSystem::Result::k_failed, result);
+        EXPECT_EQ(m_packages["PackageA"].substr(0, 5000), ReadTempPackage("PackageA"));
+    }
+    
+    /// Checks that an error status for the content manifest fails the update check rather than the
+    /// error body being parsed as a manifest.
+    ///
+    TEST_F(ContentManagementSystemTest, ErrorStatusFailsUpdateCheck)
+    {
+        m_handler = [](const LocalHttpServer::Request&)
+        {
+            LocalHttpServer::Response response;
+            response.m_code = 500;
+            response.m_body = "<Manifest DLCEnabled=\"true\"/>";
+            return response;
+        };
+        
+        EXPECT_EQ(ContentManagementSystem::CheckForUpdatesResult::k_checkFailed, CheckForUpdates());
+    }
+}
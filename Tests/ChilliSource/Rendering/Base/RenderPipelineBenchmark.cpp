@@ -0,0 +1,806 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Base/LifecycleManager.h>
+#include <ChilliSource/Core/Base/SystemInfo.h>
+#include <ChilliSource/Core/Math/Geometry/Shapes.h>
+#include <ChilliSource/Core/Math/MathUtils.h>
+#include <ChilliSource/Core/Math/Matrix4.h>
+#include <ChilliSource/Core/Memory/PagedLinearAllocator.h>
+#include <ChilliSource/Core/Threading/TaskContext.h>
+#include <ChilliSource/Core/Threading/TaskPool.h>
+#include <ChilliSource/Core/Threading/TaskType.h>
+#include <ChilliSource/Core/Time/PerformanceTimer.h>
+#include <ChilliSource/Rendering/Base/AlignmentAnchors.h>
+#include <ChilliSource/Rendering/Base/BlendMode.h>
+#include <ChilliSource/Rendering/Base/CullFace.h>
+#include <ChilliSource/Rendering/Base/ForwardRenderPassCompiler.h>
+#include <ChilliSource/Rendering/Base/RenderCapabilities.h>
+#include <ChilliSource/Rendering/Base/RenderCommandCompiler.h>
+#include <ChilliSource/Rendering/Base/RenderFrameCompiler.h>
+#include <ChilliSource/Rendering/Base/RenderFrameData.h>
+#include <ChilliSource/Rendering/Base/RenderObject.h>
+#include <ChilliSource/Rendering/Base/RenderPassVisibilityChecker.h>
+#include <ChilliSource/Rendering/Base/RenderPipelineStats.h>
+#include <ChilliSource/Rendering/Base/StencilOp.h>
+#include <ChilliSource/Rendering/Base/TestFunc.h>
+#include <ChilliSource/Rendering/Camera/RenderCamera.h>
+#include <ChilliSource/Rendering/Lighting/AmbientRenderLight.h>
+#include <ChilliSource/Rendering/Lighting/DirectionalRenderLight.h>
+#include <ChilliSource/Rendering/Lighting/PointRenderLight.h>
+#include <ChilliSource/Rendering/Material/RenderMaterialGroupManager.h>
+#include <ChilliSource/Rendering/Model/IndexFormat.h>
+#include <ChilliSource/Rendering/Model/PolygonType.h>
+#include <ChilliSource/Rendering/Model/RenderMeshManager.h>
+#include <ChilliSource/Rendering/RenderCommand/RenderCommandBuffer.h>
+#include <ChilliSource/Rendering/RenderCommand/RenderCommandList.h>
+#include <ChilliSource/Rendering/Shader/CSShaderProvider.h>
+#include <ChilliSource/Rendering/Shader/RenderShaderManager.h>
+#include <ChilliSource/Rendering/Sprite/SpriteMeshBuilder.h>
+#include <ChilliSource/Rendering/Texture/RenderTextureManager.h>
+#include <ChilliSource/Rendering/Texture/UVs.h>
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Benchmarks the CPU side of the forward render pipeline: the Compile Render Frame, Compile Render
+// Passes and Compile Render Commands stages. These cover the visibility checks, light binning,
+// pass sorting, small mesh batching and instancing. Each synthetic scene is compiled for a number
+// of frames with each requested thread count, and the median time and mean heap allocations of
+// each stage are reported. Processing the render commands needs a GL driver so isn't included.
+//
+// The scene camera's object lists, which the render passes are built from, are also measured on
+// their own: the objects in the standard layer and the visible objects among them. These are built
+// as indices into the frame's render objects, as the forward render pass compiler does, and by a
+// reduced copy of the previous implementation, which copied the render objects into each list.
+// The median time and mean heap allocations per frame of each are reported.
+//
+//   RenderPipelineBenchmark [--frames <count>] [--threads <count,count,...>] [--output <file.json>]
+//
+// A table is printed for reading, and the full results are written as JSON for tracking over
+// time if an output file is given.
+
+namespace
+{
+    std::atomic<std::uint64_t> g_numAllocations(0);
+    std::atomic<std::uint64_t> g_numAllocatedBytes(0);
+}
+
+// Every heap allocation, on any thread, is counted so the allocations made by each stage can be
+// reported.
+void* operator new(std::size_t size)
+{
+    ++g_numAllocations;
+    g_numAllocatedBytes += size;
+    
+    if (void* memory = std::malloc(size > 0 ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+    using namespace ChilliSource;
+    
+    constexpr u32 k_defaultNumFrames = 50;
+    constexpr u32 k_numWarmUpFrames = 3;
+    constexpr u32 k_numStaticMeshes = 4;
+    constexpr u32 k_numOpaqueMaterials = 8;
+    constexpr u32 k_numTransparentMaterials = 4;
+    constexpr u32 k_numStages = u32(RenderPipelineStats::Stage::k_processRenderCommands);
+    
+    const Integer2 k_resolution(1280, 720);
+    
+    /// The contents of a synthetic scene. Objects are scattered through a volume in front of the
+    /// camera which is larger than its view, so that some of them are culled. Sprites are always
+    /// transparent, whereas the given percentage of static objects are.
+    ///
+    struct SceneDesc final
+    {
+        const char* m_name;
+        u32 m_numStaticObjects;
+        u32 m_numSprites;
+        u32 m_numDirectionalLights;
+        u32 m_numPointLights;
+        u32 m_transparentPercent;
+    };
+    
+    const SceneDesc k_scenes[] =
+    {
+        { "StaticOpaque", 2000, 0, 1, 0, 0 },
+        { "StaticLit", 1000, 0, 2, 8, 0 },
+        { "Sprites", 0, 3000, 0, 0, 100 },
+        { "Mixed", 1000, 1000, 1, 4, 25 },
+    };
+    
+    /// The heap allocations made during a stage.
+    ///
+    struct AllocationCount final
+    {
+        std::uint64_t m_count = 0;
+        std::uint64_t m_bytes = 0;
+    };
+    
+    /// The median time and mean heap allocations per frame taken to build a scene's object lists.
+    ///
+    struct ObjectListResult final
+    {
+        f64 m_medianUs = 0.0;
+        AllocationCount m_allocations;
+    };
+    
+    /// The results of benchmarking a scene with a single thread count.
+    ///
+    struct RunResult final
+    {
+        u32 m_numThreads = 0;
+        RenderPipelineStats m_stats;
+        std::array<AllocationCount, k_numStages> m_allocations;
+        ObjectListResult m_indexLists;
+        ObjectListResult m_copiedLists;
+        bool m_areObjectListsEqual = true;
+    };
+    
+    /// Builds the scene camera's object lists as the forward render pass compiler does: the
+    /// indices of the objects in the standard layer, then of the visible objects among them.
+    ///
+    /// @return The number of visible objects.
+    ///
+    u32 BuildObjectIndexLists(const TaskContext& taskContext, const RenderFrame& renderFrame) noexcept
+    {
+        const auto& renderObjects = renderFrame.GetRenderObjects();
+        
+        std::vector<u32> standardObjectIndices;
+        standardObjectIndices.reserve(renderObjects.size());
+        for (u32 objectIndex = 0; objectIndex < u32(renderObjects.size()); ++objectIndex)
+        {
+            if (renderObjects[objectIndex].GetRenderLayer() == RenderLayer::k_standard)
+            {
+                standardObjectIndices.push_back(objectIndex);
+            }
+        }
+        
+        auto visibleObjectIndices = RenderPassVisibilityChecker::CalculateVisibleObjectIndices(taskContext, renderFrame.GetRenderCamera(), renderObjects, standardObjectIndices);
+        return u32(visibleObjectIndices.size());
+    }
+    
+    /// A reduced copy of how the scene camera's object lists were built before they held indices:
+    /// the objects in the standard layer were copied into a new list, and the visible objects among
+    /// them were copied into another.
+    ///
+    /// @return The number of visible objects.
+    ///
+    u32 BuildCopiedObjectLists(const TaskContext& taskContext, const RenderFrame& renderFrame) noexcept
+    {
+        std::vector<RenderObject> standardRenderObjects;
+        for (const auto& renderObject : renderFrame.GetRenderObjects())
+        {
+            if (renderObject.GetRenderLayer() == RenderLayer::k_standard)
+            {
+                standardRenderObjects.push_back(renderObject);
+            }
+        }
+        
+        auto visibleRenderObjects = RenderPassVisibilityChecker::CalculateVisibleObjects(taskContext, renderFrame.GetRenderCamera(), standardRenderObjects);
+        return u32(visibleRenderObjects.size());
+    }
+    
+    /// A minimal application which creates the systems needed to create the meshes and material
+    /// groups used in the scenes. Shadows aren't supported, so shadow map passes aren't compiled.
+    ///
+    class BenchmarkApplication final : public Application
+    {
+    public:
+        BenchmarkApplication() noexcept
+            : Application(SystemInfoCUPtr(new SystemInfo(DeviceInfo("Host", "Host", "Host", "", "en_GB", "en", "", 4), ScreenInfo(Vector2(f32(k_resolution.x), f32(k_resolution.y)), 1.0f, 1.0f, {}),
+                RenderInfo(false, false, false, false, 1024, 8), "1.0")))
+        {
+        }
+        
+        RenderMeshManager* GetRenderMeshManager() noexcept { return m_renderMeshManager; }
+        RenderMaterialGroupManager* GetRenderMaterialGroupManager() noexcept { return m_renderMaterialGroupManager; }
+        RenderTextureManager* GetRenderTextureManager() noexcept { return m_renderTextureManager; }
+    
+    private:
+        void CreateSystems() noexcept override
+        {
+            CreateSystem<RenderCapabilities>(RenderInfo(false, false, false, false, 1024, 8));
+            CreateSystem<RenderShaderManager>();
+            CreateSystem<CSShaderProvider>();
+            m_renderMeshManager = CreateSystem<RenderMeshManager>();
+            m_renderMaterialGroupManager = CreateSystem<RenderMaterialGroupManager>();
+            m_renderTextureManager = CreateSystem<RenderTextureManager>();
+        }
+        
+        void OnInit() noexcept override {}
+        void PushInitialState() noexcept override {}
+        void OnDestroy() noexcept override {}
+        
+        RenderMeshManager* m_renderMeshManager = nullptr;
+        RenderMaterialGroupManager* m_renderMaterialGroupManager = nullptr;
+        RenderTextureManager* m_renderTextureManager = nullptr;
+    };
+    
+    /// Builds the render objects for a scene each frame, and compiles them through the render
+    /// pipeline.
+    ///
+    class SceneBenchmark final
+    {
+    public:
+        /// Creates the meshes, texture and material groups shared by the objects in the scene.
+        ///
+        SceneBenchmark(BenchmarkApplication& application, const SceneDesc& sceneDesc) noexcept
+            : m_application(application), m_sceneDesc(sceneDesc)
+        {
+            std::unique_ptr<u8[]> textureData(new u8[4]);
+            std::fill(textureData.get(), textureData.get() + 4, u8(255));
+            m_renderTexture = m_application.GetRenderTextureManager()->CreateTexture2D(std::move(textureData), 4, Integer2(1, 1), ImageFormat::k_RGBA8888, ImageCompression::k_none,
+                                                                                       TextureFilterMode::k_bilinear, TextureWrapMode::k_clamp, TextureWrapMode::k_clamp, false, false);
+            
+            auto renderMeshManager = m_application.GetRenderMeshManager();
+            for (u32 i = 0; i < k_numStaticMeshes; ++i)
+            {
+                m_renderMeshes.push_back(renderMeshManager->CreateRenderMesh(PolygonType::k_triangle, VertexFormat::k_staticMesh, IndexFormat::k_short, 24, 36, Sphere(Vector3::k_zero, 1.0f),
+                                                                             nullptr, 0, nullptr, 0, false));
+            }
+            
+            auto renderMaterialGroupManager = m_application.GetRenderMaterialGroupManager();
+            for (u32 i = 0; i < k_numOpaqueMaterials; ++i)
+            {
+                Colour colour(f32(i) / k_numOpaqueMaterials, 0.5f, 0.5f, 1.0f);
+                m_opaqueRenderMaterialGroups.push_back(renderMaterialGroupManager->CreateBlinnRenderMaterialGroup(m_renderTexture, Colour::k_black, colour, colour, Colour::k_white));
+            }
+            for (u32 i = 0; i < k_numTransparentMaterials; ++i)
+            {
+                Colour colour(f32(i) / k_numTransparentMaterials, 0.5f, 0.5f, 1.0f);
+                m_transparentRenderMaterialGroups.push_back(renderMaterialGroupManager->CreateUnlitRenderMaterialGroup(m_renderTexture, true, true, false, true, true, false, TestFunc::k_lessEqual,
+                    BlendMode::k_sourceAlpha, BlendMode::k_oneMinusSourceAlpha, StencilOp::k_keep, StencilOp::k_keep, StencilOp::k_keep, TestFunc::k_always, 0, 0xff, CullFace::k_back, colour,
+                    Colour::k_white));
+            }
+            
+            u32 seed = 1;
+            for (u32 i = 0; i < m_sceneDesc.m_numStaticObjects; ++i)
+            {
+                auto renderMesh = m_renderMeshes[i % k_numStaticMeshes];
+                auto renderMaterialGroup = ChooseMaterialGroup(i, seed);
+                auto position = RandomPosition(seed);
+                auto worldMatrix = Matrix4::CreateTranslation(position);
+                
+                m_staticRenderObjects.push_back(RenderObject(renderMaterialGroup, renderMesh, worldMatrix, Sphere::Transform(renderMesh->GetBoundingSphere(), position, Vector3::k_one), false,
+                                                             RenderLayer::k_standard));
+            }
+            
+            for (u32 i = 0; i < m_sceneDesc.m_numSprites; ++i)
+            {
+                m_spriteMaterialGroups.push_back(m_transparentRenderMaterialGroups[i % k_numTransparentMaterials]);
+                m_spritePositions.push_back(RandomPosition(seed));
+            }
+            
+            for (u32 i = 0; i < m_sceneDesc.m_numDirectionalLights; ++i)
+            {
+                m_directionalRenderLights.push_back(DirectionalRenderLight(Colour::k_white, Vector3::Normalise(Vector3(f32(i) - 0.5f, -1.0f, 0.5f))));
+            }
+            for (u32 i = 0; i < m_sceneDesc.m_numPointLights; ++i)
+            {
+                m_pointRenderLights.push_back(PointRenderLight(Colour::k_white, RandomPosition(seed), Vector3(1.0f, 0.1f, 0.01f), 20.0f));
+            }
+            
+            auto cameraPosition = Vector3(0.0f, 0.0f, -50.0f);
+            auto viewMatrix = Matrix4::CreateLookAt(cameraPosition, Vector3::k_zero, Vector3::k_unitPositiveY);
+            auto projectionMatrix = Matrix4::CreatePerspectiveProjectionLH(MathUtils::k_pi / 3.0f, f32(k_resolution.x) / f32(k_resolution.y), 1.0f, 200.0f);
+            auto worldMatrix = Matrix4::Inverse(viewMatrix);
+            m_renderCamera = RenderCamera(worldMatrix, projectionMatrix, Quaternion(worldMatrix));
+        }
+        
+        /// Compiles the scene for the given number of frames with the given number of threads,
+        /// after a few unmeasured frames.
+        ///
+        /// @return The median stage times and mean allocations per frame.
+        ///
+        RunResult Run(u32 numThreads, u32 numFrames) noexcept
+        {
+            //The calling thread also processes tasks while it waits for them.
+            TaskPool taskPool(TaskType::k_small, numThreads - 1);
+            TaskContext taskContext(TaskType::k_small, &taskPool);
+            
+            std::array<std::vector<f64>, k_numStages> stageTimes;
+            std::vector<f64> indexListTimes;
+            std::vector<f64> copiedListTimes;
+            RunResult result;
+            result.m_numThreads = numThreads;
+            
+            for (u32 frame = 0; frame < k_numWarmUpFrames + numFrames; ++frame)
+            {
+                bool isMeasured = (frame >= k_numWarmUpFrames);
+                
+                RenderFrameData renderFrameData;
+                auto renderObjects = BuildRenderObjects(renderFrameData);
+                
+                std::array<f64, k_numStages> times;
+                std::array<AllocationCount, k_numStages> allocations;
+                PerformanceTimer timer;
+                
+                BeginStage(timer);
+                std::vector<RenderFrame> renderFrames;
+                renderFrames.push_back(RenderFrameCompiler::CompileRenderFrame(nullptr, k_resolution, Colour::k_black, m_renderCamera, { AmbientRenderLight(Colour(0.2f, 0.2f, 0.2f, 1.0f)) },
+                                                                               m_directionalRenderLights, m_pointRenderLights, renderObjects));
+                EndStage(timer, RenderPipelineStats::Stage::k_compileRenderFrame, times, allocations);
+                
+                u32 numRenderObjects = u32(renderFrames[0].GetRenderObjects().size());
+                
+                f64 indexListTime = 0.0;
+                AllocationCount indexListAllocations;
+                BeginStage(timer);
+                u32 numIndexListObjects = BuildObjectIndexLists(taskContext, renderFrames[0]);
+                EndMeasurement(timer, indexListTime, indexListAllocations);
+                
+                f64 copiedListTime = 0.0;
+                AllocationCount copiedListAllocations;
+                BeginStage(timer);
+                u32 numCopiedListObjects = BuildCopiedObjectLists(taskContext, renderFrames[0]);
+                EndMeasurement(timer, copiedListTime, copiedListAllocations);
+                
+                BeginStage(timer);
+                auto targetRenderPassGroups = m_renderPassCompiler.CompileTargetRenderPassGroups(taskContext, std::move(renderFrames));
+                EndStage(timer, RenderPipelineStats::Stage::k_compileRenderPasses, times, allocations);
+                
+                std::vector<RenderFrameData> renderFramesData;
+                renderFramesData.push_back(std::move(renderFrameData));
+                
+                BeginStage(timer);
+                auto renderCommandBuffer = RenderCommandCompiler::CompileRenderCommands(taskContext, &m_frameAllocator, targetRenderPassGroups, RenderCommandListUPtr(new RenderCommandList()),
+                                                                                        RenderCommandListUPtr(new RenderCommandList()), std::move(renderFramesData));
+                EndStage(timer, RenderPipelineStats::Stage::k_compileRenderCommands, times, allocations);
+                
+                if (isMeasured)
+                {
+                    for (u32 stage = 0; stage < k_numStages; ++stage)
+                    {
+                        stageTimes[stage].push_back(times[stage]);
+                        result.m_allocations[stage].m_count += allocations[stage].m_count;
+                        result.m_allocations[stage].m_bytes += allocations[stage].m_bytes;
+                    }
+                    
+                    result.m_stats.SetNumRenderFrames(1);
+                    result.m_stats.SetNumRenderObjects(numRenderObjects);
+                    CountRenderPasses(targetRenderPassGroups, result.m_stats);
+                    result.m_stats.SetNumRenderCommands(CountRenderCommands(renderCommandBuffer.get()));
+                    result.m_stats.SetFrameAllocatorSize(m_frameAllocator.GetNumPages() * m_frameAllocator.GetPageSize());
+                    
+                    indexListTimes.push_back(indexListTime);
+                    result.m_indexLists.m_allocations.m_count += indexListAllocations.m_count;
+                    result.m_indexLists.m_allocations.m_bytes += indexListAllocations.m_bytes;
+                    copiedListTimes.push_back(copiedListTime);
+                    result.m_copiedLists.m_allocations.m_count += copiedListAllocations.m_count;
+                    result.m_copiedLists.m_allocations.m_bytes += copiedListAllocations.m_bytes;
+                    result.m_areObjectListsEqual = result.m_areObjectListsEqual && (numIndexListObjects == numCopiedListObjects);
+                }
+                
+                renderCommandBuffer.reset();
+                m_frameAllocator.Reset();
+            }
+            
+            for (u32 stage = 0; stage < k_numStages; ++stage)
+            {
+                auto& times = stageTimes[stage];
+                std::sort(times.begin(), times.end());
+                result.m_stats.SetStageTime(RenderPipelineStats::Stage(stage), times[times.size() / 2]);
+                
+                result.m_allocations[stage].m_count /= numFrames;
+                result.m_allocations[stage].m_bytes /= numFrames;
+            }
+            
+            for (auto objectListResult : { std::make_pair(&result.m_indexLists, &indexListTimes), std::make_pair(&result.m_copiedLists, &copiedListTimes) })
+            {
+                auto& times = *objectListResult.second;
+                std::sort(times.begin(), times.end());
+                objectListResult.first->m_medianUs = times[times.size() / 2];
+                objectListResult.first->m_allocations.m_count /= numFrames;
+                objectListResult.first->m_allocations.m_bytes /= numFrames;
+            }
+            
+            return result;
+        }
+        
+        /// Destroys the meshes, texture and material groups.
+        ///
+        ~SceneBenchmark() noexcept
+        {
+            for (auto renderMesh : m_renderMeshes)
+            {
+                m_application.GetRenderMeshManager()->DestroyRenderMesh(renderMesh);
+            }
+            for (auto renderMaterialGroup : m_opaqueRenderMaterialGroups)
+            {
+                m_application.GetRenderMaterialGroupManager()->DestroyRenderMaterialGroup(renderMaterialGroup);
+            }
+            for (auto renderMaterialGroup : m_transparentRenderMaterialGroups)
+            {
+                m_application.GetRenderMaterialGroupManager()->DestroyRenderMaterialGroup(renderMaterialGroup);
+            }
+            m_application.GetRenderTextureManager()->DestroyRenderTexture(m_renderTexture);
+        }
+    
+    private:
+        /// @return A pseudo random value in the range [0, 1) from the given seed, which is
+        /// updated, so that every run generates the same scene.
+        ///
+        static f32 Random(u32& seed) noexcept
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return f32(seed >> 8) / f32(1u << 24);
+        }
+        
+        /// @return A pseudo random position in the volume the scene's objects are scattered through.
+        ///
+        static Vector3 RandomPosition(u32& seed) noexcept
+        {
+            auto x = (Random(seed) - 0.5f) * 120.0f;
+            auto y = (Random(seed) - 0.5f) * 80.0f;
+            auto z = Random(seed) * 100.0f;
+            return Vector3(x, y, z);
+        }
+        
+        /// @return The material group for the static object with the given index, which is
+        /// transparent for the scene's percentage of objects.
+        ///
+        const RenderMaterialGroup* ChooseMaterialGroup(u32 index, u32& seed) const noexcept
+        {
+            if (Random(seed) * 100.0f < f32(m_sceneDesc.m_transparentPercent))
+            {
+                return m_transparentRenderMaterialGroups[index % k_numTransparentMaterials];
+            }
+            
+            return m_opaqueRenderMaterialGroups[index % k_numOpaqueMaterials];
+        }
+        
+        /// Builds the render objects for a frame. As in the sprite component, a new mesh is built
+        /// in the frame allocator for each sprite every frame.
+        ///
+        /// @param renderFrameData
+        ///     [Out] The frame data which should own the sprite meshes.
+        ///
+        /// @return The render objects.
+        ///
+        std::vector<RenderObject> BuildRenderObjects(RenderFrameData& renderFrameData) noexcept
+        {
+            std::vector<RenderObject> renderObjects = m_staticRenderObjects;
+            
+            for (u32 i = 0; i < m_sceneDesc.m_numSprites; ++i)
+            {
+                auto renderDynamicMesh = SpriteMeshBuilder::Build(&m_frameAllocator, Vector3::k_zero, Vector2(2.0f, 2.0f), UVs(0.0f, 0.0f, 1.0f, 1.0f), Colour::k_white, AlignmentAnchor::k_middleCentre);
+                auto boundingSphere = Sphere::Transform(renderDynamicMesh->GetBoundingSphere(), m_spritePositions[i], Vector3::k_one);
+                renderObjects.push_back(RenderObject(m_spriteMaterialGroups[i], renderDynamicMesh.get(), Matrix4::CreateTranslation(m_spritePositions[i]), boundingSphere, false, RenderLayer::k_standard));
+                renderFrameData.AddRenderDynamicMesh(std::move(renderDynamicMesh));
+            }
+            
+            return renderObjects;
+        }
+        
+        /// Records the heap allocation counts and starts the timer at the beginning of a stage.
+        ///
+        void BeginStage(PerformanceTimer& timer) noexcept
+        {
+            m_stageStartAllocations.m_count = g_numAllocations;
+            m_stageStartAllocations.m_bytes = g_numAllocatedBytes;
+            timer.Start();
+        }
+        
+        /// Stops the timer and records the time taken and heap allocations made by the stage.
+        ///
+        void EndStage(PerformanceTimer& timer, RenderPipelineStats::Stage stage, std::array<f64, k_numStages>& times, std::array<AllocationCount, k_numStages>& allocations) noexcept
+        {
+            EndMeasurement(timer, times[u32(stage)], allocations[u32(stage)]);
+        }
+        
+        /// Stops the timer and records the time taken and heap allocations made since BeginStage().
+        ///
+        void EndMeasurement(PerformanceTimer& timer, f64& time, AllocationCount& allocations) noexcept
+        {
+            timer.Stop();
+            
+            time = timer.GetTimeTakenMicroS();
+            allocations.m_count = g_numAllocations - m_stageStartAllocations.m_count;
+            allocations.m_bytes = g_numAllocatedBytes - m_stageStartAllocations.m_bytes;
+        }
+        
+        /// Counts the non-empty render passes and the objects in them.
+        ///
+        static void CountRenderPasses(const std::vector<TargetRenderPassGroup>& targetRenderPassGroups, RenderPipelineStats& stats) noexcept
+        {
+            u32 numRenderPasses = 0;
+            u32 numRenderPassObjects = 0;
+            for (const auto& targetRenderPassGroup : targetRenderPassGroups)
+            {
+                for (const auto& cameraRenderPassGroup : targetRenderPassGroup.GetRenderCameraGroups())
+                {
+                    for (const auto& renderPass : cameraRenderPassGroup.GetRenderPasses())
+                    {
+                        if (renderPass.GetRenderPassObjects().size() > 0)
+                        {
+                            ++numRenderPasses;
+                            numRenderPassObjects += u32(renderPass.GetRenderPassObjects().size());
+                        }
+                    }
+                }
+            }
+            
+            stats.SetNumRenderPasses(numRenderPasses);
+            stats.SetNumRenderPassObjects(numRenderPassObjects);
+        }
+        
+        /// @return The total number of render commands in the given buffer.
+        ///
+        static u32 CountRenderCommands(const RenderCommandBuffer* renderCommandBuffer) noexcept
+        {
+            u32 numRenderCommands = 0;
+            for (const auto& renderCommandList : renderCommandBuffer->GetQueue())
+            {
+                numRenderCommands += u32(renderCommandList->GetOrderedList().size());
+            }
+            
+            return numRenderCommands;
+        }
+        
+        BenchmarkApplication& m_application;
+        const SceneDesc& m_sceneDesc;
+        
+        ForwardRenderPassCompiler m_renderPassCompiler;
+        PagedLinearAllocator m_frameAllocator;
+        AllocationCount m_stageStartAllocations;
+        
+        std::vector<const RenderMesh*> m_renderMeshes;
+        const RenderTexture* m_renderTexture = nullptr;
+        std::vector<const RenderMaterialGroup*> m_opaqueRenderMaterialGroups;
+        std::vector<const RenderMaterialGroup*> m_transparentRenderMaterialGroups;
+        
+        RenderCamera m_renderCamera;
+        std::vector<DirectionalRenderLight> m_directionalRenderLights;
+        std::vector<PointRenderLight> m_pointRenderLights;
+        std::vector<RenderObject> m_staticRenderObjects;
+        std::vector<const RenderMaterialGroup*> m_spriteMaterialGroups;
+        std::vector<Vector3> m_spritePositions;
+    };
+    
+    /// @return The name of the given stage, as used by RenderPipelineStats::ToJson().
+    ///
+    const char* GetStageName(u32 stage) noexcept
+    {
+        const char* k_stageNames[k_numStages] = { "CompileRenderFrame", "CompileRenderPasses", "CompileRenderCommands" };
+        return k_stageNames[stage];
+    }
+    
+    /// @return The JSON description of the given scene and its results.
+    ///
+    Json::Value ToJson(const SceneDesc& sceneDesc, const std::vector<RunResult>& results) noexcept
+    {
+        Json::Value runs(Json::arrayValue);
+        for (const auto& result : results)
+        {
+            Json::Value allocations(Json::objectValue);
+            for (u32 stage = 0; stage < k_numStages; ++stage)
+            {
+                allocations[GetStageName(stage)]["Count"] = Json::UInt64(result.m_allocations[stage].m_count);
+                allocations[GetStageName(stage)]["Bytes"] = Json::UInt64(result.m_allocations[stage].m_bytes);
+            }
+            
+            Json::Value objectLists(Json::objectValue);
+            for (auto objectListResult : { std::make_pair("Indices", &result.m_indexLists), std::make_pair("Copies", &result.m_copiedLists) })
+            {
+                objectLists[objectListResult.first]["MedianUs"] = objectListResult.second->m_medianUs;
+                objectLists[objectListResult.first]["Count"] = Json::UInt64(objectListResult.second->m_allocations.m_count);
+                objectLists[objectListResult.first]["Bytes"] = Json::UInt64(objectListResult.second->m_allocations.m_bytes);
+            }
+            
+            Json::Value run(Json::objectValue);
+            run["NumThreads"] = Json::UInt(result.m_numThreads);
+            run["Pipeline"] = result.m_stats.ToJson();
+            run["AllocationsPerFrame"] = allocations;
+            run["ObjectListsPerFrame"] = objectLists;
+            runs.append(run);
+        }
+        
+        Json::Value scene(Json::objectValue);
+        scene["Name"] = sceneDesc.m_name;
+        scene["NumStaticObjects"] = Json::UInt(sceneDesc.m_numStaticObjects);
+        scene["NumSprites"] = Json::UInt(sceneDesc.m_numSprites);
+        scene["NumDirectionalLights"] = Json::UInt(sceneDesc.m_numDirectionalLights);
+        scene["NumPointLights"] = Json::UInt(sceneDesc.m_numPointLights);
+        scene["TransparentPercent"] = Json::UInt(sceneDesc.m_transparentPercent);
+        scene["Runs"] = runs;
+        return scene;
+    }
+    
+    /// Prints a row of the results table for the given result.
+    ///
+    void PrintResult(const SceneDesc& sceneDesc, const RunResult& result) noexcept
+    {
+        std::printf("%-14s %7u", sceneDesc.m_name, result.m_numThreads);
+        for (u32 stage = 0; stage < k_numStages; ++stage)
+        {
+            std::printf(" %10.0f %8llu", result.m_stats.GetStageTime(RenderPipelineStats::Stage(stage)), (unsigned long long)result.m_allocations[stage].m_count);
+        }
+        std::printf(" %8u %8u\n", result.m_stats.GetNumRenderPasses(), result.m_stats.GetNumRenderCommands());
+    }
+    
+    /// Prints a row of the object list table for the given result.
+    ///
+    void PrintObjectListResult(const SceneDesc& sceneDesc, const RunResult& result) noexcept
+    {
+        std::printf("%-14s %7u", sceneDesc.m_name, result.m_numThreads);
+        for (const auto objectListResult : { &result.m_indexLists, &result.m_copiedLists })
+        {
+            std::printf(" %10.0f %10.1f", objectListResult->m_medianUs, f64(objectListResult->m_allocations.m_bytes) / 1024.0);
+        }
+        std::printf("\n");
+    }
+    
+    /// Parses a comma separated list of thread counts.
+    ///
+    /// @return Whether the list was valid.
+    ///
+    bool ParseThreadCounts(const std::string& list, std::vector<u32>& threadCounts) noexcept
+    {
+        threadCounts.clear();
+        
+        std::size_t start = 0;
+        while (start <= list.size())
+        {
+            auto end = std::min(list.find(',', start), list.size());
+            auto count = std::atoi(list.substr(start, end - start).c_str());
+            if (count < 1)
+            {
+                return false;
+            }
+            
+            threadCounts.push_back(u32(count));
+            start = end + 1;
+        }
+        
+        return (threadCounts.empty() == false);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    u32 numFrames = k_defaultNumFrames;
+    std::vector<u32> threadCounts = { 1, 2, 4 };
+    std::string outputFilePath;
+    
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        bool hasValue = (i + 1 < argc);
+        
+        if (argument == "--frames" && hasValue && std::atoi(argv[i + 1]) > 0)
+        {
+            numFrames = u32(std::atoi(argv[++i]));
+        }
+        else if (argument == "--threads" && hasValue && ParseThreadCounts(argv[i + 1], threadCounts))
+        {
+            ++i;
+        }
+        else if (argument == "--output" && hasValue)
+        {
+            outputFilePath = argv[++i];
+        }
+        else
+        {
+            std::fprintf(stderr, "Usage: %s [--frames <count>] [--threads <count,count,...>] [--output <file.json>]\n", argv[0]);
+            return 1;
+        }
+    }
+    
+    BenchmarkApplication application;
+    LifecycleManager lifecycleManager(&application);
+    
+    std::printf("Median time (us) and mean heap allocations per frame for each stage, over %u frames.\n\n", numFrames);
+    std::printf("%-14s %7s %19s %19s %19s %8s %8s\n", "Scene", "Threads", "Frame (us / allocs)", "Passes (us / allocs)", "Commands (us / allocs)", "Passes", "Commands");
+    
+    Json::Value scenes(Json::arrayValue);
+    std::vector<std::vector<RunResult>> sceneResults;
+    bool isValid = true;
+    for (const auto& sceneDesc : k_scenes)
+    {
+        SceneBenchmark sceneBenchmark(application, sceneDesc);
+        
+        sceneResults.push_back(std::vector<RunResult>());
+        auto& results = sceneResults.back();
+        for (auto numThreads : threadCounts)
+        {
+            results.push_back(sceneBenchmark.Run(numThreads, numFrames));
+            PrintResult(sceneDesc, results.back());
+            
+            //Every scene has visible objects, so must produce render passes and commands.
+            if (results.back().m_stats.GetNumRenderPasses() == 0 || results.back().m_stats.GetNumRenderCommands() == 0)
+            {
+                std::fprintf(stderr, "Scene '%s' did not compile any render commands.\n", sceneDesc.m_name);
+                isValid = false;
+            }
+            
+            if (results.back().m_areObjectListsEqual == false)
+            {
+                std::fprintf(stderr, "Scene '%s' has different visible objects in its index and copied object lists.\n", sceneDesc.m_name);
+                isValid = false;
+            }
+        }
+        
+        scenes.append(ToJson(sceneDesc, results));
+    }
+    
+    std::printf("\nMedian time (us) and mean heap allocated KB per frame to build the scene camera's object lists.\n\n");
+    std::printf("%-14s %7s %21s %21s\n", "Scene", "Threads", "Indices (us / KB)", "Copies (us / KB)");
+    for (u32 sceneIndex = 0; sceneIndex < sceneResults.size(); ++sceneIndex)
+    {
+        for (const auto& result : sceneResults[sceneIndex])
+        {
+            PrintObjectListResult(k_scenes[sceneIndex], result);
+        }
+    }
+    
+    if (outputFilePath.empty() == false)
+    {
+        Json::Value output(Json::objectValue);
+        output["NumFrames"] = Json::UInt(numFrames);
+        output["Scenes"] = scenes;
+        
+        std::ofstream file(outputFilePath);
+        file << Json::StyledWriter().write(output);
+        if (file.good() == false)
+        {
+            std::fprintf(stderr, "Could not write the results to '%s'.\n", outputFilePath.c_str());
+            return 1;
+        }
+    }
+    
+    return isValid ? 0 : 1;
+}
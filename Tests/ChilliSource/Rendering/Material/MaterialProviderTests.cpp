@@ -0,0 +1,224 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Rendering/Material/MaterialProvider.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Base/DeviceInfo.h>
+#include <ChilliSource/Core/Base/LifecycleManager.h>
+#include <ChilliSource/Core/Base/RenderInfo.h>
+#include <ChilliSource/Core/Base/ScreenInfo.h>
+#include <ChilliSource/Core/Base/SystemInfo.h>
+#include <ChilliSource/Core/File/FileSystem.h>
+#include <ChilliSource/Core/Image/CSImageProvider.h>
+#include <ChilliSource/Core/Math/Vector2.h>
+#include <ChilliSource/Core/Resource/ResourcePool.h>
+#include <ChilliSource/Rendering/Base/RenderCapabilities.h>
+#include <ChilliSource/Rendering/Material/Material.h>
+#include <ChilliSource/Rendering/Material/RenderMaterialGroupManager.h>
+#include <ChilliSource/Rendering/Shader/CSShaderProvider.h>
+#include <ChilliSource/Rendering/Shader/RenderShaderManager.h>
+#include <ChilliSource/Rendering/Texture/Cubemap.h>
+#include <ChilliSource/Rendering/Texture/CubemapProvider.h>
+#include <ChilliSource/Rendering/Texture/RenderTextureManager.h>
+#include <ChilliSource/Rendering/Texture/Texture.h>
+#include <ChilliSource/Rendering/Texture/TextureProvider.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+    using namespace ChilliSource;
+    
+    const char* const k_materialNames[] = { "Unlit", "Blinn", "Defaults", "Custom" };
+    
+    /// A minimal application which creates the material provider and everything it needs to load
+    /// the shaders and textures the test materials refer to. Shaders and textures are built through
+    /// the render managers, but nothing is rendered.
+    ///
+    class TestApplication final : public Application
+    {
+    public:
+        TestApplication() noexcept
+            : Application(SystemInfoCUPtr(new SystemInfo(DeviceInfo("Host", "Host", "Host", "", "en_GB", "en", "", 4), ScreenInfo(Vector2(1.0f, 1.0f), 1.0f, 1.0f, {}),
+                RenderInfo(false, false, false, false, 1024, 8), "1.0")))
+        {
+        }
+        
+    private:
+        void CreateSystems() noexcept override
+        {
+            CreateSystem<RenderCapabilities>(RenderInfo(false, false, false, false, 1024, 8));
+            CreateSystem<RenderShaderManager>();
+            CreateSystem<RenderTextureManager>();
+            CreateSystem<RenderMaterialGroupManager>();
+            CreateSystem<CSImageProvider>();
+            CreateSystem<CSShaderProvider>();
+            m_textureProvider = CreateSystem<TextureProvider>();
+            m_cubemapProvider = CreateSystem<CubemapProvider>();
+            CreateSystem<MaterialProvider>();
+        }
+        
+        /// The texture and cubemap providers are informed of the image providers once every
+        /// system has been created, as in the engine's application.
+        ///
+        void OnInit() noexcept override
+        {
+            m_textureProvider->PostCreate();
+            m_cubemapProvider->PostCreate();
+        }
+        
+        void PushInitialState() noexcept override {}
+        void OnDestroy() noexcept override {}
+        
+        TextureProvider* m_textureProvider = nullptr;
+        CubemapProvider* m_cubemapProvider = nullptr;
+    };
+    
+    /// Copies the file at the given absolute path into the package, which is read only through
+    /// the file system.
+    ///
+    /// @return Whether the file was copied.
+    ///
+    bool CopyToPackage(const std::string& filePath, const std::string& packageFilePath)
+    {
+        std::ifstream inputFile(filePath, std::ios::binary);
+        std::ofstream outputFile(Application::Get()->GetFileSystem()->GetAbsolutePathToStorageLocation(StorageLocation::k_package) + packageFilePath, std::ios::binary);
+        outputFile << inputFile.rdbuf();
+        return inputFile.good() && outputFile.good();
+    }
+    
+    /// Loads the XML test materials and the binary materials compiled from them by
+    /// compile_material.py, from the package.
+    ///
+    class MaterialProviderTest : public ::testing::TestWithParam<const char*>
+    {
+    protected:
+        void SetUp() override
+        {
+            m_application.reset(new TestApplication());
+            m_lifecycleManager.reset(new LifecycleManager(m_application.get()));
+            
+            for (const auto& materialName : k_materialNames)
+            {
+                std::string name(materialName);
+                ASSERT_TRUE(CopyToPackage(CS_TEST_MATERIALS_DIR "/" + name + ".csmaterial", name + ".csmaterial"));
+                ASSERT_TRUE(CopyToPackage(CS_TEST_COMPILED_MATERIALS_DIR "/" + name + ".csmaterialbin", name + ".csmaterialbin"));
+            }
+            ASSERT_TRUE(CopyToPackage(CS_TEST_MATERIALS_DIR "/Blank.cscubemap", "Blank.cscubemap"));
+        }
+        
+        void TearDown() override
+        {
+            m_lifecycleManager.reset();
+            m_application.reset();
+        }
+        
+        /// @return The material loaded from the given file in the package.
+        ///
+        MaterialCSPtr LoadMaterial(const std::string& filePath)
+        {
+            return Application::Get()->GetResourcePool()->LoadResource<Material>(StorageLocation::k_package, filePath);
+        }
+        
+        std::unique_ptr<TestApplication> m_application;
+        std::unique_ptr<LifecycleManager> m_lifecycleManager;
+    };
+    
+    /// The binary material must build the same material as the XML it was compiled from. The render
+    /// material group is shared between materials with the same content key, which covers every
+    /// property including the custom shaders and their variables, so both must have the same group.
+    ///
+    TEST_P(MaterialProviderTest, CompiledMaterialMatchesXML)
+    {
+        std::string name(GetParam());
+        auto xmlMaterial = LoadMaterial(name + ".csmaterial");
+        auto binaryMaterial = LoadMaterial(name + ".csmaterialbin");
+        ASSERT_TRUE(xmlMaterial != nullptr && binaryMaterial != nullptr);
+        ASSERT_EQ(Resource::LoadState::k_loaded, xmlMaterial->GetLoadState());
+        ASSERT_EQ(Resource::LoadState::k_loaded, binaryMaterial->GetLoadState());
+        ASSERT_NE(xmlMaterial, binaryMaterial);
+        
+        EXPECT_EQ(xmlMaterial->GetShadingType(), binaryMaterial->GetShadingType());
+        EXPECT_EQ(xmlMaterial->IsTransparencyEnabled(), binaryMaterial->IsTransparencyEnabled());
+        EXPECT_EQ(xmlMaterial->IsColourWriteEnabled(), binaryMaterial->IsColourWriteEnabled());
+        EXPECT_EQ(xmlMaterial->IsDepthWriteEnabled(), binaryMaterial->IsDepthWriteEnabled());
+        EXPECT_EQ(xmlMaterial->IsDepthTestEnabled(), binaryMaterial->IsDepthTestEnabled());
+        EXPECT_EQ(xmlMaterial->IsFaceCullingEnabled(), binaryMaterial->IsFaceCullingEnabled());
+        EXPECT_EQ(xmlMaterial->IsStencilTestEnabled(), binaryMaterial->IsStencilTestEnabled());
+        EXPECT_EQ(xmlMaterial->GetDepthTestFunc(), binaryMaterial->GetDepthTestFunc());
+        EXPECT_EQ(xmlMaterial->GetSourceBlendMode(), binaryMaterial->GetSourceBlendMode());
+        EXPECT_EQ(xmlMaterial->GetDestBlendMode(), binaryMaterial->GetDestBlendMode());
+        EXPECT_EQ(xmlMaterial->GetStencilFailOp(), binaryMaterial->GetStencilFailOp());
+        EXPECT_EQ(xmlMaterial->GetStencilDepthFailOp(), binaryMaterial->GetStencilDepthFailOp());
+        EXPECT_EQ(xmlMaterial->GetStencilPassOp(), binaryMaterial->GetStencilPassOp());
+        EXPECT_EQ(xmlMaterial->GetStencilTestFunc(), binaryMaterial->GetStencilTestFunc());
+        EXPECT_EQ(xmlMaterial->GetStencilTestFuncRef(), binaryMaterial->GetStencilTestFuncRef());
+        EXPECT_EQ(xmlMaterial->GetStencilTestFuncMask(), binaryMaterial->GetStencilTestFuncMask());
+        EXPECT_EQ(xmlMaterial->GetCullFace(), binaryMaterial->GetCullFace());
+        EXPECT_TRUE(xmlMaterial->GetEmissive() == binaryMaterial->GetEmissive());
+        EXPECT_TRUE(xmlMaterial->GetAmbient() == binaryMaterial->GetAmbient());
+        EXPECT_TRUE(xmlMaterial->GetDiffuse() == binaryMaterial->GetDiffuse());
+        EXPECT_TRUE(xmlMaterial->GetSpecular() == binaryMaterial->GetSpecular());
+        
+        //Textures are cached by file and options, so matching textures are the same resource.
+        ASSERT_EQ(xmlMaterial->GetNumTextures(), binaryMaterial->GetNumTextures());
+        for (u32 i = 0; i < xmlMaterial->GetNumTextures(); ++i)
+        {
+            EXPECT_EQ(xmlMaterial->GetTexture(i), binaryMaterial->GetTexture(i));
+        }
+        ASSERT_EQ(xmlMaterial->GetNumCubemaps(), binaryMaterial->GetNumCubemaps());
+        for (u32 i = 0; i < xmlMaterial->GetNumCubemaps(); ++i)
+        {
+            EXPECT_EQ(xmlMaterial->GetCubemap(i), binaryMaterial->GetCubemap(i));
+        }
+        
+        EXPECT_EQ(xmlMaterial->GetRenderMaterialGroup(), binaryMaterial->GetRenderMaterialGroup());
+    }
+    
+    INSTANTIATE_TEST_SUITE_P(TestMaterials, MaterialProviderTest, ::testing::ValuesIn(k_materialNames));
+    
+    /// Checks the comparison above can fail: each test material differs from the others, so each
+    /// must have its own render material group.
+    ///
+    TEST_F(MaterialProviderTest, DifferentMaterialsHaveDifferentGroups)
+    {
+        std::vector<MaterialCSPtr> materials;
+        std::vector<const RenderMaterialGroup*> renderMaterialGroups;
+        for (const auto& materialName : k_materialNames)
+        {
+            auto material = LoadMaterial(std::string(materialName) + ".csmaterial");
+            ASSERT_EQ(Resource::LoadState::k_loaded, material->GetLoadState());
+            materials.push_back(material);
+            
+            auto renderMaterialGroup = material->GetRenderMaterialGroup();
+            EXPECT_TRUE(std::find(renderMaterialGroups.begin(), renderMaterialGroups.end(), renderMaterialGroup) == renderMaterialGroups.end()) << materialName;
+            renderMaterialGroups.push_back(renderMaterialGroup);
+        }
+    }
+}
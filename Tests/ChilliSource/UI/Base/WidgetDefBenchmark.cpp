@@ -0,0 +1,318 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Base/LifecycleManager.h>
+#include <ChilliSource/Core/Base/SystemInfo.h>
+#include <ChilliSource/Core/File/FileSystem.h>
+#include <ChilliSource/Core/Resource/ResourcePool.h>
+#include <ChilliSource/Input/Pointer/PointerSystem.h>
+#include <ChilliSource/UI/Base/UIComponentFactory.h>
+#include <ChilliSource/UI/Base/Widget.h>
+#include <ChilliSource/UI/Base/WidgetDef.h>
+#include <ChilliSource/UI/Base/WidgetDefProvider.h>
+#include <ChilliSource/UI/Base/WidgetFactory.h>
+#include <ChilliSource/UI/Base/WidgetPool.h>
+
+#include <json/json.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <string>
+
+// Benchmarks loading the engine's widget definitions from JSON text and from the binary JSON
+// compiled by compile_json.py, and instantiating widgets from them through the widget factory
+// and through a widget pool. Each load reads and parses the file again, as the definition is
+// released from the resource pool afterwards. Widgets with text aren't instantiated, as fonts
+// can't be loaded without a renderer. Configure with CMAKE_BUILD_TYPE=Release for meaningful
+// timings.
+//
+//   WidgetDefBenchmark [--iterations <count>] [--output <file.json>]
+//
+// A table is printed for reading, and the full results are written as JSON for tracking over
+// time if an output file is given.
+
+namespace
+{
+    using namespace ChilliSource;
+    
+    constexpr u32 k_defaultNumIterations = 1000;
+    
+    /// A widget definition in CSResources/Widgets, and whether widgets can be instantiated
+    /// from it.
+    ///
+    struct DefDesc final
+    {
+        const char* m_name;
+        bool m_isInstantiated;
+    };
+    
+    const DefDesc k_defs[] =
+    {
+        { "Widget", true },
+        { "Image", true },
+        { "Layout", true },
+        { "HighlightButton", true },
+        { "ToggleButton", true },
+        { "HorizontalSlider", true },
+        { "VerticalSlider", true },
+        { "HorizontalFillProgressBar", true },
+        { "HorizontalStretchProgressBar", true },
+        { "VerticalFillProgressBar", true },
+        { "VerticalStretchProgressBar", true },
+        { "Label", false },
+        { "EditableLabel", false },
+    };
+    
+    /// A minimal application which creates the systems needed to load widget definitions and
+    /// create widgets from them.
+    ///
+    class BenchmarkApplication final : public Application
+    {
+    public:
+        BenchmarkApplication() noexcept
+            : Application(SystemInfoCUPtr(new SystemInfo(DeviceInfo("Host", "Host", "Host", "", "en_GB", "en", "", 4), ScreenInfo(Vector2(1280.0f, 720.0f), 1.0f, 1.0f, {}),
+                RenderInfo(false, false, false, false, 1024, 8), "1.0")))
+        {
+        }
+        
+    private:
+        void CreateSystems() noexcept override
+        {
+            CreateSystem<PointerSystem>();
+            CreateSystem<UIComponentFactory>();
+            CreateSystem<WidgetFactory>();
+            CreateSystem<WidgetDefProvider>();
+        }
+        
+        void OnInit() noexcept override {}
+        void PushInitialState() noexcept override {}
+        void OnDestroy() noexcept override {}
+    };
+    
+    /// The mean time of each operation on a single widget definition, in microseconds.
+    ///
+    struct DefResult final
+    {
+        f64 m_textLoadUs = 0.0;
+        f64 m_binaryLoadUs = 0.0;
+        f64 m_createUs = 0.0;
+        f64 m_poolAcquireUs = 0.0;
+        bool m_isValid = true;
+    };
+    
+    /// Copies the given file into the package storage location.
+    ///
+    /// @return Whether the file was copied.
+    ///
+    bool CopyToPackage(const std::string& filePath, const std::string& packageFilePath) noexcept
+    {
+        std::ifstream inputFile(filePath, std::ios::binary);
+        std::ofstream outputFile(Application::Get()->GetFileSystem()->GetAbsolutePathToStorageLocation(StorageLocation::k_package) + packageFilePath, std::ios::binary);
+        outputFile << inputFile.rdbuf();
+        return inputFile.good() && outputFile.good();
+    }
+    
+    /// Performs the given operation the given number of times.
+    ///
+    /// @return The mean time per operation in microseconds.
+    ///
+    f64 TimeOperation(u32 numIterations, const std::function<void()>& operation) noexcept
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < numIterations; ++i)
+        {
+            operation();
+        }
+        std::chrono::duration<f64, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        
+        return elapsed.count() / numIterations;
+    }
+    
+    /// Loads the widget definition from the package, and releases it from the resource pool
+    /// so that the next load reads it again.
+    ///
+    /// @return Whether the definition loaded.
+    ///
+    bool LoadAndRelease(const std::string& filePath) noexcept
+    {
+        auto resourcePool = Application::Get()->GetResourcePool();
+        
+        auto widgetDef = resourcePool->LoadResource<WidgetDef>(StorageLocation::k_package, filePath);
+        if (widgetDef == nullptr || widgetDef->GetLoadState() != Resource::LoadState::k_loaded)
+        {
+            return false;
+        }
+        
+        const Resource* resource = widgetDef.get();
+        widgetDef.reset();
+        resourcePool->Release(resource);
+        return true;
+    }
+    
+    /// Times loading, creating and pooling widgets of the given definition.
+    ///
+    DefResult Run(const DefDesc& defDesc, u32 numIterations) noexcept
+    {
+        DefResult result;
+        
+        std::string name(defDesc.m_name);
+        std::string textFilePath = name + ".csuidef";
+        std::string binaryFilePath = name + ".csuidefbin";
+        
+        result.m_textLoadUs = TimeOperation(numIterations, [&]()
+        {
+            result.m_isValid &= LoadAndRelease(textFilePath);
+        });
+        result.m_binaryLoadUs = TimeOperation(numIterations, [&]()
+        {
+            result.m_isValid &= LoadAndRelease(binaryFilePath);
+        });
+        
+        auto resourcePool = Application::Get()->GetResourcePool();
+        auto textDef = resourcePool->LoadResource<WidgetDef>(StorageLocation::k_package, textFilePath);
+        auto binaryDef = resourcePool->LoadResource<WidgetDef>(StorageLocation::k_package, binaryFilePath);
+        if (textDef == nullptr || binaryDef == nullptr || textDef->GetTypeName() != binaryDef->GetTypeName() || textDef->GetComponentDescs().size() != binaryDef->GetComponentDescs().size() ||
+            textDef->GetChildDescs().size() != binaryDef->GetChildDescs().size())
+        {
+            result.m_isValid = false;
+            return result;
+        }
+        
+        if (defDesc.m_isInstantiated)
+        {
+            auto widgetFactory = Application::Get()->GetWidgetFactory();
+            result.m_createUs = TimeOperation(numIterations, [&]()
+            {
+                auto widget = widgetFactory->Create(binaryDef);
+                result.m_isValid &= (widget != nullptr && widget->GetInternalWidgets().size() == binaryDef->GetChildDescs().size());
+            });
+            
+            WidgetPool widgetPool(binaryDef, 1);
+            result.m_poolAcquireUs = TimeOperation(numIterations, [&]()
+            {
+                auto widget = widgetPool.Acquire();
+                result.m_isValid &= (widget != nullptr && widget->GetInternalWidgets().size() == binaryDef->GetChildDescs().size());
+                widgetPool.Release(widget);
+            });
+        }
+        
+        return result;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    u32 numIterations = k_defaultNumIterations;
+    std::string outputFilePath;
+    
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        bool hasValue = (i + 1 < argc);
+        
+        if (argument == "--iterations" && hasValue && std::atoi(argv[i + 1]) > 0)
+        {
+            numIterations = u32(std::atoi(argv[++i]));
+        }
+        else if (argument == "--output" && hasValue)
+        {
+            outputFilePath = argv[++i];
+        }
+        else
+        {
+            std::fprintf(stderr, "Usage: %s [--iterations <count>] [--output <file.json>]\n", argv[0]);
+            return 1;
+        }
+    }
+    
+    BenchmarkApplication application;
+    LifecycleManager lifecycleManager(&application);
+    
+    for (const auto& defDesc : k_defs)
+    {
+        std::string name(defDesc.m_name);
+        if (CopyToPackage(CS_WIDGET_DEFS_DIR "/" + name + ".csuidef", name + ".csuidef") == false ||
+            CopyToPackage(CS_COMPILED_WIDGET_DEFS_DIR "/" + name + ".csuidefbin", name + ".csuidefbin") == false)
+        {
+            std::fprintf(stderr, "Could not copy the '%s' widget definition to the package.\n", defDesc.m_name);
+            return 1;
+        }
+    }
+    
+    std::printf("Mean time (us) per operation on each widget definition, over %u iterations.\n\n", numIterations);
+    std::printf("%-30s %12s %12s %12s %12s\n", "Widget", "Text load", "Binary load", "Create", "Pool acquire");
+    
+    Json::Value defResults(Json::arrayValue);
+    bool isValid = true;
+    for (const auto& defDesc : k_defs)
+    {
+        auto result = Run(defDesc, numIterations);
+        if (defDesc.m_isInstantiated)
+        {
+            std::printf("%-30s %12.2f %12.2f %12.2f %12.2f\n", defDesc.m_name, result.m_textLoadUs, result.m_binaryLoadUs, result.m_createUs, result.m_poolAcquireUs);
+        }
+        else
+        {
+            std::printf("%-30s %12.2f %12.2f %12s %12s\n", defDesc.m_name, result.m_textLoadUs, result.m_binaryLoadUs, "-", "-");
+        }
+        
+        if (result.m_isValid == false)
+        {
+            std::fprintf(stderr, "The '%s' widget definition failed to load or create a widget, or the text and binary definitions differ.\n", defDesc.m_name);
+            isValid = false;
+        }
+        
+        Json::Value defResult(Json::objectValue);
+        defResult["Name"] = defDesc.m_name;
+        defResult["TextLoadUs"] = result.m_textLoadUs;
+        defResult["BinaryLoadUs"] = result.m_binaryLoadUs;
+        if (defDesc.m_isInstantiated)
+        {
+            defResult["CreateUs"] = result.m_createUs;
+            defResult["PoolAcquireUs"] = result.m_poolAcquireUs;
+        }
+        defResults.append(defResult);
+    }
+    
+    if (outputFilePath.empty() == false)
+    {
+        Json::Value output(Json::objectValue);
+        output["NumIterations"] = Json::UInt(numIterations);
+        output["WidgetDefs"] = defResults;
+        
+        std::ofstream file(outputFilePath);
+        file << Json::StyledWriter().write(output);
+        if (file.good() == false)
+        {
+            std::fprintf(stderr, "Could not write the results to '%s'.\n", outputFilePath.c_str());
+            return 1;
+        }
+    }
+    
+    return isValid ? 0 : 1;
+}
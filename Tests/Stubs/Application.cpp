@@ -0,0 +1,192 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Core/Base/Application.h>
+
+#include <ChilliSource/Core/Base/Device.h>
+#include <ChilliSource/Core/Base/SystemInfo.h>
+#include <ChilliSource/Core/Base/Screen.h>
+#include <ChilliSource/Core/File/AppDataStore.h>
+#include <ChilliSource/Core/File/FileSystem.h>
+#include <ChilliSource/Core/File/TaggedFilePathResolver.h>
+#include <ChilliSource/Core/Resource/ResourcePool.h>
+#include <ChilliSource/Core/Resource/ResourceProvider.h>
+#include <ChilliSource/Core/Threading/TaskScheduler.h>
+#include <ChilliSource/Core/Time/CoreTimer.h>
+#include <ChilliSource/Rendering/Base/RenderSnapshot.h>
+
+#include <chrono>
+
+// Replaces the parts of Core/Base/Application.cpp that tests link against, so that a test can
+// derive a minimal application and use it to create the systems it needs without starting the
+// full engine. System creation is allowed for the lifetime of the application.
+//
+// A test which needs the systems to be initialised and updated drives the application through
+// the LifecycleManager in Stubs. This requires the application to have been given a system info,
+// as the core systems which don't depend on a device are created by default: the device, screen,
+// task scheduler, file system, resource pool, tagged file path resolver and app data store. As in
+// the engine, every resource provider the test creates is added to the resource pool. There is
+// never a state manager. The widget factory is found in Stubs/ApplicationUI.cpp instead, so that
+// only tests which use the UI need to link it.
+
+namespace ChilliSource
+{
+    Application* Application::s_application = nullptr;
+    
+    //------------------------------------------------------------------------------
+    Application* Application::Get() noexcept
+    {
+        return s_application;
+    }
+    
+    //------------------------------------------------------------------------------
+    Application::Application(ChilliSource::SystemInfoCUPtr systemInfo) noexcept
+        : m_systemInfo(std::move(systemInfo)), m_frameIndex(0), m_updateInterval(1.0f / 60.0f)
+    {
+        CS_ASSERT(s_application == nullptr, "Only one application can exist at a time.");
+        
+        s_application = this;
+        m_isSystemCreationAllowed = true;
+    }
+    
+    //------------------------------------------------------------------------------
+    TimeIntervalMs Application::GetSystemTimeInMilliseconds() const noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>((std::chrono::system_clock::now().time_since_epoch())).count();
+    }
+    
+    //------------------------------------------------------------------------------
+    StateManager* Application::GetStateManager() noexcept
+    {
+        return m_stateManager;
+    }
+    
+    //------------------------------------------------------------------------------
+    FileSystem* Application::GetFileSystem() noexcept
+    {
+        return m_fileSystem;
+    }
+    
+    //------------------------------------------------------------------------------
+    TaggedFilePathResolver* Application::GetTaggedFilePathResolver() noexcept
+    {
+        return m_taggedPathResolver;
+    }
+    
+    //------------------------------------------------------------------------------
+    ResourcePool* Application::GetResourcePool() noexcept
+    {
+        return m_resourcePool;
+    }
+    
+    //------------------------------------------------------------------------------
+    TaskScheduler* Application::GetTaskScheduler() noexcept
+    {
+        return m_taskScheduler;
+    }
+    
+    //------------------------------------------------------------------------------
+    const TaskScheduler* Application::GetTaskScheduler() const noexcept
+    {
+        return m_taskScheduler;
+    }
+    
+    //------------------------------------------------------------------------------
+    void Application::Init() noexcept
+    {
+        CS_ASSERT(m_systemInfo != nullptr, "Cannot initialise an application without a system info.");
+        
+        Logging::Create();
+        
+        CreateSystem<Device>(m_systemInfo->GetDeviceInfo());
+        m_screen = CreateSystem<Screen>(m_systemInfo->GetScreenInfo());
+        m_taskScheduler = CreateSystem<TaskScheduler>();
+        m_fileSystem = CreateSystem<FileSystem>();
+        m_resourcePool = CreateSystem<ResourcePool>();
+        m_taggedPathResolver = CreateSystem<TaggedFilePathResolver>();
+        CreateSystem<AppDataStore>();
+        
+        CreateSystems();
+        
+        for (const AppSystemUPtr& system : m_systems)
+        {
+            if (system->IsA(ResourceProvider::InterfaceID))
+            {
+                m_resourcePool->AddProvider(dynamic_cast<ResourceProvider*>(system.get()));
+            }
+        }
+        
+        for (const AppSystemUPtr& system : m_systems)
+        {
+            system->OnInit();
+        }
+        
+        OnInit();
+    }
+    
+    //------------------------------------------------------------------------------
+    void Application::Update(f32 deltaTime, TimeIntervalSecs timestamp) noexcept
+    {
+        m_currentAppTime = timestamp;
+        
+        CoreTimer::Update(deltaTime);
+        
+        for (const AppSystemUPtr& system : m_systems)
+        {
+            system->OnUpdate(deltaTime);
+        }
+        
+        m_taskScheduler->ExecuteMainThreadTasks();
+    }
+    
+    //------------------------------------------------------------------------------
+    void Application::Destroy() noexcept
+    {
+        m_taskScheduler->Destroy();
+        
+        OnDestroy();
+        
+        for (auto it = m_systems.rbegin(); it != m_systems.rend(); ++it)
+        {
+            (*it)->OnDestroy();
+        }
+        
+        m_resourcePool->Destroy();
+        
+        Logging::Destroy();
+    }
+    
+    //------------------------------------------------------------------------------
+    Application::~Application() noexcept
+    {
+        // Systems are destroyed in the reverse order to creation, as in the engine.
+        while (m_systems.empty() == false)
+        {
+            m_systems.pop_back();
+        }
+        
+        s_application = nullptr;
+    }
+}
@@ -0,0 +1,45 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Base/Application.h>
+
+#include <ChilliSource/UI/Base/WidgetFactory.h>
+
+// Replaces the parts of Core/Base/Application.cpp that the UI links against. These are kept out
+// of Stubs/Application.cpp so that tests which don't use the UI don't need to link it. The
+// widget factory is the one the test created, if any.
+
+namespace ChilliSource
+{
+    //------------------------------------------------------------------------------
+    WidgetFactory* Application::GetWidgetFactory() noexcept
+    {
+        if (m_widgetFactory == nullptr)
+        {
+            m_widgetFactory = GetSystem<WidgetFactory>();
+        }
+        
+        return m_widgetFactory;
+    }
+}
@@ -0,0 +1,412 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <CSBackend/Platform/Android/Main/JNI/Core/File/FileSystem.h>
+
+#include <ChilliSource/Core/String/StringUtils.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Replaces the Android file system in the tests, which reads the package from the APK through
+// JNI. The engine's own resources are read from CSResources in the repository. Every other
+// storage location, including the package, is a plain directory in a temporary directory which
+// is removed when the test process exits, so tests can put "bundled" files in the package
+// location by writing them to its absolute path.
+
+namespace CSBackend
+{
+    namespace Android
+    {
+        namespace
+        {
+            const char k_packagePath[] = "AppResources/";
+            const char k_saveDataPath[] = "SaveData/";
+            const char k_dlcPath[] = "DLC/";
+            const char k_cachePath[] = "Cache/";
+            
+            std::string g_storagePath;
+            
+            //------------------------------------------------------------------------------
+            bool CreateDirectory(const std::string& in_directoryPath)
+            {
+                return (mkdir(in_directoryPath.c_str(), 0777) == 0 || errno == EEXIST);
+            }
+            
+            //------------------------------------------------------------------------------
+            bool IsDirectory(const std::string& in_path, bool in_isDirectory)
+            {
+                struct stat itemStat;
+                return (stat(in_path.c_str(), &itemStat) == 0 && S_ISDIR(itemStat.st_mode) == in_isDirectory);
+            }
+            
+            //------------------------------------------------------------------------------
+            bool DeleteDirectory(const std::string& in_directoryPath)
+            {
+                std::string directoryPath = ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath);
+                DIR* directory = opendir(directoryPath.c_str());
+                if (directory == nullptr)
+                {
+                    return false;
+                }
+                
+                struct dirent* item;
+                while ((item = readdir(directory)) != nullptr)
+                {
+                    std::string itemName = item->d_name;
+                    if (itemName == "." || itemName == "..")
+                    {
+                        continue;
+                    }
+                    
+                    std::string itemPath = directoryPath + itemName;
+                    if (IsDirectory(itemPath, true) == true)
+                    {
+                        DeleteDirectory(itemPath);
+                    }
+                    else
+                    {
+                        unlink(itemPath.c_str());
+                    }
+                }
+                closedir(directory);
+                
+                return (rmdir(directoryPath.c_str()) == 0);
+            }
+            
+            //------------------------------------------------------------------------------
+            void GetPaths(std::vector<std::string>& out_paths, const std::string& in_directoryPath, bool in_searchForDirectories, bool in_recursive, const std::string& in_relativeParentDirectory = "")
+            {
+                std::string directoryPath = ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath);
+                std::string relativeParentDirectory = ChilliSource::StringUtils::StandardiseDirectoryPath(in_relativeParentDirectory);
+                
+                DIR* directory = opendir(directoryPath.c_str());
+                if (directory == nullptr)
+                {
+                    return;
+                }
+                
+                struct dirent* item;
+                while ((item = readdir(directory)) != nullptr)
+                {
+                    std::string itemName = item->d_name;
+                    if (itemName == "." || itemName == "..")
+                    {
+                        continue;
+                    }
+                    
+                    if (IsDirectory(directoryPath + itemName, true) == true)
+                    {
+                        std::string relativeItemPath = relativeParentDirectory + ChilliSource::StringUtils::StandardiseDirectoryPath(itemName);
+                        if (in_searchForDirectories == true)
+                        {
+                            out_paths.push_back(relativeItemPath);
+                        }
+                        
+                        if (in_recursive == true)
+                        {
+                            GetPaths(out_paths, directoryPath + itemName, in_searchForDirectories, true, relativeItemPath);
+                        }
+                    }
+                    else if (in_searchForDirectories == false)
+                    {
+                        out_paths.push_back(relativeParentDirectory + itemName);
+                    }
+                }
+                closedir(directory);
+            }
+            
+            //------------------------------------------------------------------------------
+            void DeleteStorage()
+            {
+                DeleteDirectory(g_storagePath);
+            }
+        }
+        
+        CS_DEFINE_NAMEDTYPE(FileSystem);
+        
+        //------------------------------------------------------------------------------
+        FileSystem::FileSystem()
+        {
+            if (g_storagePath.empty() == true)
+            {
+                char directoryPath[] = "/tmp/ChilliSourceTests.XXXXXX";
+                if (mkdtemp(directoryPath) == nullptr)
+                {
+                    CS_LOG_FATAL("File System: Could not create the test storage directory.");
+                }
+                
+                g_storagePath = ChilliSource::StringUtils::StandardiseDirectoryPath(directoryPath);
+                std::atexit(&DeleteStorage);
+            }
+            
+            m_storagePath = g_storagePath;
+            
+            for (auto storageLocation : { ChilliSource::StorageLocation::k_package, ChilliSource::StorageLocation::k_saveData, ChilliSource::StorageLocation::k_cache,
+                ChilliSource::StorageLocation::k_DLC })
+            {
+                CreateDirectory(GetAbsolutePathToStorageLocation(storageLocation));
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        bool FileSystem::IsA(ChilliSource::InterfaceIDType in_interfaceId) const
+        {
+            return (ChilliSource::FileSystem::InterfaceID == in_interfaceId || FileSystem::InterfaceID == in_interfaceId);
+        }
+        
+        //------------------------------------------------------------------------------
+        ChilliSource::ITextInputStreamUPtr FileSystem::CreateTextInputStream(ChilliSource::StorageLocation in_storageLocation, const std::string& in_filePath) const
+        {
+            auto storageLocation = in_storageLocation;
+            auto filePath = ChilliSource::StringUtils::StandardiseFilePath(in_filePath);
+            if (storageLocation == ChilliSource::StorageLocation::k_DLC && DoesFileExistInCachedDLC(in_filePath) == false)
+            {
+                storageLocation = ChilliSource::StorageLocation::k_package;
+                filePath = GetPackageDLCPath() + filePath;
+            }
+            
+            ChilliSource::ITextInputStreamUPtr stream(new ChilliSource::TextInputStream(GetAbsolutePathToStorageLocation(storageLocation) + filePath));
+            return (stream->IsValid() == true) ? std::move(stream) : nullptr;
+        }
+        
+        //------------------------------------------------------------------------------
+        ChilliSource::IBinaryInputStreamUPtr FileSystem::CreateBinaryInputStream(ChilliSource::StorageLocation in_storageLocation, const std::string& in_filePath) const
+        {
+            auto storageLocation = in_storageLocation;
+            auto filePath = ChilliSource::StringUtils::StandardiseFilePath(in_filePath);
+            if (storageLocation == ChilliSource::StorageLocation::k_DLC && DoesFileExistInCachedDLC(in_filePath) == false)
+            {
+                storageLocation = ChilliSource::StorageLocation::k_package;
+                filePath = GetPackageDLCPath() + filePath;
+            }
+            
+            ChilliSource::IBinaryInputStreamUPtr stream(new ChilliSource::BinaryInputStream(GetAbsolutePathToStorageLocation(storageLocation) + filePath));
+            return (stream->IsValid() == true) ? std::move(stream) : nullptr;
+        }
+        
+        //------------------------------------------------------------------------------
+        ChilliSource::TextOutputStreamUPtr FileSystem::CreateTextOutputStream(ChilliSource::StorageLocation in_storageLocation, const std::string& in_filePath, ChilliSource::FileWriteMode in_fileMode) const
+        {
+            CS_ASSERT(IsStorageLocationWritable(in_storageLocation), "File System: Trying to write to read only storage location.");
+            
+            ChilliSource::TextOutputStreamUPtr stream(new ChilliSource::TextOutputStream(GetAbsolutePathToStorageLocation(in_storageLocation) + in_filePath, in_fileMode));
+            return (stream->IsValid() == true) ? std::move(stream) : nullptr;
+        }
+        
+        //------------------------------------------------------------------------------
+        ChilliSource::BinaryOutputStreamUPtr FileSystem::CreateBinaryOutputStream(ChilliSource::StorageLocation in_storageLocation, const std::string& in_filePath, ChilliSource::FileWriteMode in_fileMode) const
+        {
+            CS_ASSERT(IsStorageLocationWritable(in_storageLocation), "File System: Trying to write to read only storage location.");
+            
+            ChilliSource::BinaryOutputStreamUPtr stream(new ChilliSource::BinaryOutputStream(GetAbsolutePathToStorageLocation(in_storageLocation) + in_filePath, in_fileMode));
+            return (stream->IsValid() == true) ? std::move(stream) : nullptr;
+        }
+        
+        //------------------------------------------------------------------------------
+        bool FileSystem::CreateDirectoryPath(ChilliSource::StorageLocation in_storageLocation, const std::string& in_directoryPath) const
+        {
+            CS_ASSERT(IsStorageLocationWritable(in_storageLocation) == true, "Cannot create directory in read-only storage location.");
+            
+            std::string path = GetAbsolutePathToStorageLocation(in_storageLocation);
+            for (const auto& section : ChilliSource::StringUtils::Split(ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath), "/"))
+            {
+                path += section + "/";
+                if (CSBackend::Android::CreateDirectory(path) == false)
+                {
+                    return false;
+                }
+            }
+            
+            return true;
+        }
+        
+        //------------------------------------------------------------------------------
+        bool FileSystem::CopyFile(ChilliSource::StorageLocation in_sourceStorageLocation, const std::string& in_sourceFilePath,
+                                  ChilliSource::StorageLocation in_destinationStorageLocation, const std::string& in_destinationFilePath) const
+        {
+            std::string contents;
+            return (ReadFile(in_sourceStorageLocation, in_sourceFilePath, contents) == true && WriteFile(in_destinationStorageLocation, in_destinationFilePath, contents) == true);
+        }
+        
+        //------------------------------------------------------------------------------
+        bool FileSystem::CopyDirectory(ChilliSource::StorageLocation in_sourceStorageLocation, const std::string& in_sourceDirectoryPath,
+                                       ChilliSource::StorageLocation in_destinationStorageLocation, const std::string& in_destinationDirectoryPath) const
+        {
+            std::string sourceDirectoryPath = ChilliSource::StringUtils::StandardiseDirectoryPath(in_sourceDirectoryPath);
+            std::string destinationDirectoryPath = ChilliSource::StringUtils::StandardiseDirectoryPath(in_destinationDirectoryPath);
+            
+            CreateDirectoryPath(in_destinationStorageLocation, destinationDirectoryPath);
+            for (const auto& directoryPath : GetDirectoryPaths(in_sourceStorageLocation, sourceDirectoryPath, true))
+            {
+                CreateDirectoryPath(in_destinationStorageLocation, destinationDirectoryPath + directoryPath);
+            }
+            
+            for (const auto& filePath : GetFilePaths(in_sourceStorageLocation, sourceDirectoryPath, true))
+            {
+                if (CopyFile(in_sourceStorageLocation, sourceDirectoryPath + filePath, in_destinationStorageLocation, destinationDirectoryPath + filePath) == false)
+                {
+                    return false;
+                }
+            }
+            
+            return true;
+        }
+        
+        //------------------------------------------------------------------------------
+        bool FileSystem::DeleteFile(ChilliSource::StorageLocation in_storageLocation, const std::string& in_filePath) const
+        {
+            CS_ASSERT(IsStorageLocationWritable(in_storageLocation) == true, "Cannot delete file from read-only storage location.");
+            
+            return (unlink((GetAbsolutePathToStorageLocation(in_storageLocation) + ChilliSource::StringUtils::StandardiseFilePath(in_filePath)).c_str()) == 0);
+        }
+        
+        //------------------------------------------------------------------------------
+        bool FileSystem::RenameFile(ChilliSource::StorageLocation in_storageLocation, const std::string& in_sourceFilePath, const std::string& in_destinationFilePath) const
+        {
+            CS_ASSERT(IsStorageLocationWritable(in_storageLocation) == true, "Cannot rename file in read-only storage location.");
+            
+            std::string storageLocationPath = GetAbsolutePathToStorageLocation(in_storageLocation);
+            return (rename((storageLocationPath + ChilliSource::StringUtils::StandardiseFilePath(in_sourceFilePath)).c_str(),
+                           (storageLocationPath + ChilliSource::StringUtils::StandardiseFilePath(in_destinationFilePath)).c_str()) == 0);
+        }
+        
+        //------------------------------------------------------------------------------
+        bool FileSystem::DeleteDirectory(ChilliSource::StorageLocation in_storageLocation, const std::string& in_directoryPath) const
+        {
+            CS_ASSERT(IsStorageLocationWritable(in_storageLocation), "Cannot delete directory from read-only storage location.");
+            
+            return CSBackend::Android::DeleteDirectory(GetAbsolutePathToStorageLocation(in_storageLocation) + ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath));
+        }
+        
+        //------------------------------------------------------------------------------
+        std::vector<std::string> FileSystem::GetFilePaths(ChilliSource::StorageLocation in_storageLocation, const std::string& in_directoryPath, bool in_recursive) const
+        {
+            std::string directoryPath = ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath);
+            
+            std::vector<std::string> filePaths;
+            if (in_storageLocation == ChilliSource::StorageLocation::k_DLC)
+            {
+                GetPaths(filePaths, GetAbsolutePathToStorageLocation(ChilliSource::StorageLocation::k_package) + GetPackageDLCPath() + directoryPath, false, in_recursive);
+            }
+            GetPaths(filePaths, GetAbsolutePathToStorageLocation(in_storageLocation) + directoryPath, false, in_recursive);
+            
+            std::sort(filePaths.begin(), filePaths.end());
+            filePaths.erase(std::unique(filePaths.begin(), filePaths.end()), filePaths.end());
+            return filePaths;
+        }
+        
+        //------------------------------------------------------------------------------
+        std::vector<std::string> FileSystem::GetDirectoryPaths(ChilliSource::StorageLocation in_storageLocation, const std::string& in_directoryPath, bool in_recursive) const
+        {
+            std::string directoryPath = ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath);
+            
+            std::vector<std::string> directoryPaths;
+            if (in_storageLocation == ChilliSource::StorageLocation::k_DLC)
+            {
+                GetPaths(directoryPaths, GetAbsolutePathToStorageLocation(ChilliSource::StorageLocation::k_package) + GetPackageDLCPath() + directoryPath, true, in_recursive);
+            }
+            GetPaths(directoryPaths, GetAbsolutePathToStorageLocation(in_storageLocation) + directoryPath, true, in_recursive);
+            
+            std::sort(directoryPaths.begin(), directoryPaths.end());
+            directoryPaths.erase(std::unique(directoryPaths.begin(), directoryPaths.end()), directoryPaths.end());
+            return directoryPaths;
+        }
+        
+        //------------------------------------------------------------------------------
+        bool FileSystem::DoesFileExist(ChilliSource::StorageLocation in_storageLocation, const std::string& in_filePath) const
+        {
+            if (in_storageLocation == ChilliSource::StorageLocation::k_DLC)
+            {
+                return (DoesFileExistInCachedDLC(in_filePath) || DoesFileExistInPackageDLC(in_filePath));
+            }
+            
+            return IsDirectory(GetAbsolutePathToStorageLocation(in_storageLocation) + ChilliSource::StringUtils::StandardiseFilePath(in_filePath), false);
+        }
+        
+        //------------------------------------------------------------------------------
+        bool FileSystem::DoesFileExistInCachedDLC(const std::string& in_filePath) const
+        {
+            return IsDirectory(GetAbsolutePathToStorageLocation(ChilliSource::StorageLocation::k_DLC) + ChilliSource::StringUtils::StandardiseFilePath(in_filePath), false);
+        }
+        
+        //------------------------------------------------------------------------------
+        bool FileSystem::DoesFileExistInPackageDLC(const std::string& in_filePath) const
+        {
+            return DoesFileExist(ChilliSource::StorageLocation::k_package, GetPackageDLCPath() + in_filePath);
+        }
+        
+        //------------------------------------------------------------------------------
+        bool FileSystem::DoesDirectoryExist(ChilliSource::StorageLocation in_storageLocation, const std::string& in_directoryPath) const
+        {
+            if (in_storageLocation == ChilliSource::StorageLocation::k_DLC)
+            {
+                return (DoesDirectoryExistInCachedDLC(in_directoryPath) || DoesDirectoryExistInPackageDLC(in_directoryPath));
+            }
+            
+            return IsDirectory(GetAbsolutePathToStorageLocation(in_storageLocation) + ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath), true);
+        }
+        
+        //------------------------------------------------------------------------------
+        bool FileSystem::DoesDirectoryExistInCachedDLC(const std::string& in_directoryPath) const
+        {
+            return IsDirectory(GetAbsolutePathToStorageLocation(ChilliSource::StorageLocation::k_DLC) + ChilliSource::StringUtils::StandardiseDirectoryPath(in_directoryPath), true);
+        }
+        
+        //------------------------------------------------------------------------------
+        bool FileSystem::DoesDirectoryExistInPackageDLC(const std::string& in_directoryPath) const
+        {
+            return DoesDirectoryExist(ChilliSource::StorageLocation::k_package, GetPackageDLCPath() + in_directoryPath);
+        }
+        
+        //------------------------------------------------------------------------------
+        std::string FileSystem::GetAbsolutePathToStorageLocation(ChilliSource::StorageLocation in_storageLocation) const
+        {
+            switch (in_storageLocation)
+            {
+                case ChilliSource::StorageLocation::k_package:
+                    return m_storagePath + k_packagePath;
+                case ChilliSource::StorageLocation::k_chilliSource:
+                    return ChilliSource::StringUtils::StandardiseDirectoryPath(CS_TEST_RESOURCES_DIR);
+                case ChilliSource::StorageLocation::k_saveData:
+                    return m_storagePath + k_saveDataPath;
+                case ChilliSource::StorageLocation::k_cache:
+                    return m_storagePath + k_cachePath;
+                case ChilliSource::StorageLocation::k_DLC:
+                    return m_storagePath + k_dlcPath;
+                case ChilliSource::StorageLocation::k_root:
+                    return "";
+                default:
+                    CS_LOG_FATAL("File System: Requested storage location that does not exist on this platform.");
+                    return "";
+            }
+        }
+    }
+}
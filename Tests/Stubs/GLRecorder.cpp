@@ -0,0 +1,380 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include "GLRecorder.h"
+
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+#include <EGL/egl.h>
+
+#include <cstring>
+#include <regex>
+#include <unordered_map>
+
+namespace ChilliSource
+{
+    namespace Test
+    {
+        namespace GLRecorder
+        {
+            namespace
+            {
+                struct Program final
+                {
+                    std::vector<GLuint> m_shaders;
+                    std::unordered_map<std::string, GLint> m_attributes;
+                    std::unordered_map<std::string, GLint> m_uniforms;
+                };
+
+                std::vector<Call> g_calls;
+                std::string g_version;
+                std::string g_extensions;
+                GLuint g_nextName = 1;
+                std::unordered_map<GLuint, std::string> g_shaderSources;
+                std::unordered_map<GLuint, Program> g_programs;
+
+                /// Records a call with the given integer and float arguments.
+                ///
+                void Record(const char* name, std::vector<std::int64_t> args = std::vector<std::int64_t>(), std::vector<float> floats = std::vector<float>())
+                {
+                    Call call;
+                    call.m_name = name;
+                    call.m_args = std::move(args);
+                    call.m_floats = std::move(floats);
+                    g_calls.push_back(std::move(call));
+                }
+
+                /// Assigns locations to the attributes and uniforms declared in the program's shaders.
+                ///
+                void LinkProgram(Program& program)
+                {
+                    const std::regex declaration("\\b(attribute|uniform)\\s+(?:(?:lowp|mediump|highp)\\s+)?(\\w+)\\s+(\\w+)\\s*;");
+
+                    GLint nextAttribute = 0;
+                    GLint nextUniform = 0;
+                    for (auto shader : program.m_shaders)
+                    {
+                        const auto& source = g_shaderSources[shader];
+                        for (std::sregex_iterator it(source.begin(), source.end(), declaration), end; it != end; ++it)
+                        {
+                            const auto& match = *it;
+                            if (match[1] == "attribute")
+                            {
+                                if (program.m_attributes.count(match[3]) == 0)
+                                {
+                                    program.m_attributes[match[3]] = nextAttribute;
+                                    nextAttribute += (match[2] == "mat4") ? 4 : 1;
+                                }
+                            }
+                            else if (program.m_uniforms.count(match[3]) == 0)
+                            {
+                                program.m_uniforms[match[3]] = nextUniform++;
+                            }
+                        }
+                    }
+                }
+
+                void GL_APIENTRY RecordVertexAttribDivisor(GLuint index, GLuint divisor)
+                {
+                    Record("glVertexAttribDivisor", { index, divisor });
+                }
+
+                void GL_APIENTRY RecordDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void*, GLsizei numInstances)
+                {
+                    Record("glDrawElementsInstanced", { mode, count, type, numInstances });
+                }
+
+                void GL_APIENTRY RecordDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei numInstances)
+                {
+                    Record("glDrawArraysInstanced", { mode, first, count, numInstances });
+                }
+
+                __eglMustCastToProperFunctionPointerType GetProcAddress(const char* name)
+                {
+                    // The recorded names drop any extension suffix so tests don't need to care which
+                    // entry points the backend picked.
+                    if (strcmp(name, "glVertexAttribDivisor") == 0 || strcmp(name, "glVertexAttribDivisorEXT") == 0)
+                    {
+                        return reinterpret_cast<__eglMustCastToProperFunctionPointerType>(&RecordVertexAttribDivisor);
+                    }
+                    if (strcmp(name, "glDrawElementsInstanced") == 0 || strcmp(name, "glDrawElementsInstancedEXT") == 0)
+                    {
+                        return reinterpret_cast<__eglMustCastToProperFunctionPointerType>(&RecordDrawElementsInstanced);
+                    }
+                    if (strcmp(name, "glDrawArraysInstanced") == 0 || strcmp(name, "glDrawArraysInstancedEXT") == 0)
+                    {
+                        return reinterpret_cast<__eglMustCastToProperFunctionPointerType>(&RecordDrawArraysInstanced);
+                    }
+                    return nullptr;
+                }
+
+                GLuint GenName()
+                {
+                    return g_nextName++;
+                }
+
+                void SetShaderSource(GLuint shader, const std::string& source)
+                {
+                    g_shaderSources[shader] = source;
+                }
+
+                Program& GetProgram(GLuint program)
+                {
+                    return g_programs[program];
+                }
+            }
+
+            //------------------------------------------------------------------------------
+            void Reset(const std::string& version, const std::string& extensions) noexcept
+            {
+                g_calls.clear();
+                g_version = version;
+                g_extensions = extensions;
+                g_nextName = 1;
+                g_shaderSources.clear();
+                g_programs.clear();
+            }
+
+            //------------------------------------------------------------------------------
+            void ClearCalls() noexcept
+            {
+                g_calls.clear();
+            }
+
+            //------------------------------------------------------------------------------
+            const std::vector<Call>& GetCalls() noexcept
+            {
+                return g_calls;
+            }
+
+            //------------------------------------------------------------------------------
+            std::vector<Call> GetCalls(const std::string& name) noexcept
+            {
+                std::vector<Call> output;
+                for (const auto& call : g_calls)
+                {
+                    if (call.m_name == name)
+                    {
+                        output.push_back(call);
+                    }
+                }
+                return output;
+            }
+
+            //------------------------------------------------------------------------------
+            std::size_t CountCalls(const std::string& name) noexcept
+            {
+                return GetCalls(name).size();
+            }
+
+        }
+    }
+}
+
+using namespace ChilliSource::Test::GLRecorder;
+
+//------------------------------------------------------------------------------
+EGLAPI __eglMustCastToProperFunctionPointerType EGLAPIENTRY eglGetProcAddress(const char* procname)
+{
+    return GetProcAddress(procname);
+}
+
+//------------------------------------------------------------------------------
+const GLubyte* GL_APIENTRY glGetString(GLenum name)
+{
+    switch (name)
+    {
+        case GL_VERSION:
+            return reinterpret_cast<const GLubyte*>(g_version.c_str());
+        case GL_EXTENSIONS:
+            return reinterpret_cast<const GLubyte*>(g_extensions.c_str());
+        default:
+            return reinterpret_cast<const GLubyte*>("");
+    }
+}
+
+//------------------------------------------------------------------------------
+void GL_APIENTRY glGetIntegerv(GLenum pname, GLint* data)
+{
+    switch (pname)
+    {
+        case GL_MAX_VERTEX_ATTRIBS:
+            *data = 16;
+            break;
+        case GL_MAX_TEXTURE_IMAGE_UNITS:
+        case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+            *data = 8;
+            break;
+        case GL_MAX_TEXTURE_SIZE:
+            *data = 4096;
+            break;
+        default:
+            *data = 0;
+            break;
+    }
+}
+
+GLenum GL_APIENTRY glGetError() { return GL_NO_ERROR; }
+GLenum GL_APIENTRY glCheckFramebufferStatus(GLenum) { return GL_FRAMEBUFFER_COMPLETE; }
+
+//------------------------------------------------------------------------------
+GLuint GL_APIENTRY glCreateShader(GLenum) { return GenName(); }
+void GL_APIENTRY glCompileShader(GLuint) {}
+void GL_APIENTRY glDeleteShader(GLuint) {}
+void GL_APIENTRY glGetShaderInfoLog(GLuint, GLsizei, GLsizei*, GLchar*) {}
+
+void GL_APIENTRY glShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length)
+{
+    std::string source;
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        source += (length && length[i] >= 0) ? std::string(string[i], length[i]) : std::string(string[i]);
+    }
+    SetShaderSource(shader, source);
+}
+
+void GL_APIENTRY glGetShaderiv(GLuint, GLenum pname, GLint* params)
+{
+    *params = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+}
+
+void GL_APIENTRY glGetShaderPrecisionFormat(GLenum, GLenum, GLint* range, GLint* precision)
+{
+    range[0] = 127;
+    range[1] = 127;
+    *precision = 23;
+}
+
+//------------------------------------------------------------------------------
+GLuint GL_APIENTRY glCreateProgram() { auto name = GenName(); GetProgram(name); return name; }
+void GL_APIENTRY glAttachShader(GLuint program, GLuint shader) { GetProgram(program).m_shaders.push_back(shader); }
+void GL_APIENTRY glDetachShader(GLuint, GLuint) {}
+void GL_APIENTRY glLinkProgram(GLuint program) { LinkProgram(GetProgram(program)); }
+void GL_APIENTRY glDeleteProgram(GLuint) {}
+void GL_APIENTRY glGetProgramInfoLog(GLuint, GLsizei, GLsizei*, GLchar*) {}
+void GL_APIENTRY glUseProgram(GLuint program) { Record("glUseProgram", { program }); }
+
+void GL_APIENTRY glGetProgramiv(GLuint, GLenum pname, GLint* params)
+{
+    *params = (pname == GL_LINK_STATUS) ? GL_TRUE : 0;
+}
+
+GLint GL_APIENTRY glGetAttribLocation(GLuint program, const GLchar* name)
+{
+    const auto& attributes = GetProgram(program).m_attributes;
+    auto it = attributes.find(name);
+    return (it != attributes.end()) ? it->second : -1;
+}
+
+GLint GL_APIENTRY glGetUniformLocation(GLuint program, const GLchar* name)
+{
+    const auto& uniforms = GetProgram(program).m_uniforms;
+    auto it = uniforms.find(name);
+    return (it != uniforms.end()) ? it->second : -1;
+}
+
+//------------------------------------------------------------------------------
+void GL_APIENTRY glUniform1i(GLint location, GLint v0) { Record("glUniform1i", { location, v0 }); }
+void GL_APIENTRY glUniform1f(GLint location, GLfloat v0) { Record("glUniform1f", { location }, { v0 }); }
+void GL_APIENTRY glUniform2fv(GLint location, GLsizei count, const GLfloat* value) { Record("glUniform2fv", { location, count }, std::vector<float>(value, value + 2 * count)); }
+void GL_APIENTRY glUniform3fv(GLint location, GLsizei count, const GLfloat* value) { Record("glUniform3fv", { location, count }, std::vector<float>(value, value + 3 * count)); }
+void GL_APIENTRY glUniform4fv(GLint location, GLsizei count, const GLfloat* value) { Record("glUniform4fv", { location, count }, std::vector<float>(value, value + 4 * count)); }
+
+void GL_APIENTRY glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+    Record("glUniformMatrix4fv", { location, count, transpose }, std::vector<float>(value, value + 16 * count));
+}
+
+//------------------------------------------------------------------------------
+void GL_APIENTRY glEnableVertexAttribArray(GLuint index) { Record("glEnableVertexAttribArray", { index }); }
+void GL_APIENTRY glDisableVertexAttribArray(GLuint index) { Record("glDisableVertexAttribArray", { index }); }
+void GL_APIENTRY glVertexAttrib4fv(GLuint index, const GLfloat* v) { Record("glVertexAttrib4fv", { index }, std::vector<float>(v, v + 4)); }
+
+void GL_APIENTRY glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)
+{
+    Record("glVertexAttribPointer", { index, size, type, normalized, stride, std::int64_t(reinterpret_cast<std::intptr_t>(pointer)) });
+}
+
+//------------------------------------------------------------------------------
+void GL_APIENTRY glGenBuffers(GLsizei n, GLuint* buffers)
+{
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        buffers[i] = GenName();
+        Record("glGenBuffers", { buffers[i] });
+    }
+}
+
+void GL_APIENTRY glDeleteBuffers(GLsizei n, const GLuint* buffers)
+{
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        Record("glDeleteBuffers", { buffers[i] });
+    }
+}
+
+void GL_APIENTRY glBindBuffer(GLenum target, GLuint buffer) { Record("glBindBuffer", { target, buffer }); }
+void GL_APIENTRY glBufferData(GLenum target, GLsizeiptr size, const void*, GLenum usage) { Record("glBufferData", { target, size, usage }); }
+void GL_APIENTRY glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void*) { Record("glBufferSubData", { target, offset, size }); }
+
+//------------------------------------------------------------------------------
+void GL_APIENTRY glDrawElements(GLenum mode, GLsizei count, GLenum type, const void*) { Record("glDrawElements", { mode, count, type }); }
+void GL_APIENTRY glDrawArrays(GLenum mode, GLint first, GLsizei count) { Record("glDrawArrays", { mode, first, count }); }
+
+//------------------------------------------------------------------------------
+void GL_APIENTRY glGenTextures(GLsizei n, GLuint* textures) { for (GLsizei i = 0; i < n; ++i) { textures[i] = GenName(); } }
+void GL_APIENTRY glDeleteTextures(GLsizei, const GLuint*) {}
+void GL_APIENTRY glActiveTexture(GLenum texture) { Record("glActiveTexture", { texture }); }
+void GL_APIENTRY glBindTexture(GLenum target, GLuint texture) { Record("glBindTexture", { target, texture }); }
+void GL_APIENTRY glTexParameteri(GLenum, GLenum, GLint) {}
+void GL_APIENTRY glTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*) {}
+void GL_APIENTRY glCompressedTexImage2D(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void*) {}
+void GL_APIENTRY glGenerateMipmap(GLenum) {}
+void GL_APIENTRY glReadPixels(GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, void*) {}
+
+//------------------------------------------------------------------------------
+void GL_APIENTRY glGenFramebuffers(GLsizei n, GLuint* framebuffers) { for (GLsizei i = 0; i < n; ++i) { framebuffers[i] = GenName(); } }
+void GL_APIENTRY glDeleteFramebuffers(GLsizei, const GLuint*) {}
+void GL_APIENTRY glBindFramebuffer(GLenum target, GLuint framebuffer) { Record("glBindFramebuffer", { target, framebuffer }); }
+void GL_APIENTRY glFramebufferTexture2D(GLenum, GLenum, GLenum, GLuint, GLint) {}
+void GL_APIENTRY glFramebufferRenderbuffer(GLenum, GLenum, GLenum, GLuint) {}
+void GL_APIENTRY glGenRenderbuffers(GLsizei n, GLuint* renderbuffers) { for (GLsizei i = 0; i < n; ++i) { renderbuffers[i] = GenName(); } }
+void GL_APIENTRY glDeleteRenderbuffers(GLsizei, const GLuint*) {}
+void GL_APIENTRY glBindRenderbuffer(GLenum, GLuint) {}
+void GL_APIENTRY glRenderbufferStorage(GLenum, GLenum, GLsizei, GLsizei) {}
+
+//------------------------------------------------------------------------------
+void GL_APIENTRY glViewport(GLint x, GLint y, GLsizei width, GLsizei height) { Record("glViewport", { x, y, width, height }); }
+void GL_APIENTRY glClear(GLbitfield mask) { Record("glClear", { mask }); }
+void GL_APIENTRY glClearColor(GLfloat, GLfloat, GLfloat, GLfloat) {}
+void GL_APIENTRY glColorMask(GLboolean, GLboolean, GLboolean, GLboolean) {}
+void GL_APIENTRY glDepthMask(GLboolean) {}
+void GL_APIENTRY glDepthFunc(GLenum) {}
+void GL_APIENTRY glEnable(GLenum cap) { Record("glEnable", { cap }); }
+void GL_APIENTRY glDisable(GLenum cap) { Record("glDisable", { cap }); }
+void GL_APIENTRY glBlendEquation(GLenum) {}
+void GL_APIENTRY glBlendFunc(GLenum, GLenum) {}
+void GL_APIENTRY glCullFace(GLenum) {}
+void GL_APIENTRY glStencilFunc(GLenum, GLint, GLuint) {}
+void GL_APIENTRY glStencilOp(GLenum, GLenum, GLenum) {}
@@ -0,0 +1,91 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_TESTS_STUBS_GLRECORDER_H_
+#define _CHILLISOURCE_TESTS_STUBS_GLRECORDER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ChilliSource
+{
+    namespace Test
+    {
+        /// A stand-in for the OpenGL ES 2.0 and EGL libraries which records every call made by the
+        /// OpenGL backend rather than rendering anything. Each call is stored with its integer and
+        /// float arguments so tests can check what the backend asked the driver to do.
+        ///
+        /// Shader compilation and linking always succeed. Attribute and uniform locations are only
+        /// handed out for names declared in the source of a program's attached shaders, with four
+        /// consecutive attribute locations reserved for each mat4 attribute, mirroring how a real
+        /// driver lays out matrix attributes.
+        ///
+        namespace GLRecorder
+        {
+            /// A single recorded call.
+            ///
+            struct Call final
+            {
+                std::string m_name;
+                std::vector<std::int64_t> m_args;
+                std::vector<float> m_floats;
+            };
+
+            /// Clears the recorded calls and all objects created through the stub, and sets the
+            /// strings reported for GL_VERSION and GL_EXTENSIONS.
+            ///
+            /// @param version
+            ///     The GL_VERSION string.
+            /// @param extensions
+            ///     The GL_EXTENSIONS string.
+            ///
+            void Reset(const std::string& version = "OpenGL ES 2.0", const std::string& extensions = "") noexcept;
+
+            /// Clears the recorded calls, keeping any objects created through the stub.
+            ///
+            void ClearCalls() noexcept;
+
+            /// @return All calls recorded since the last reset, in order.
+            ///
+            const std::vector<Call>& GetCalls() noexcept;
+
+            /// @param name
+            ///     The GL function name, for example "glDrawElements".
+            ///
+            /// @return All recorded calls to the given function, in order.
+            ///
+            std::vector<Call> GetCalls(const std::string& name) noexcept;
+
+            /// @param name
+            ///     The GL function name.
+            ///
+            /// @return The number of recorded calls to the given function.
+            ///
+            std::size_t CountCalls(const std::string& name) noexcept;
+        }
+    }
+}
+
+#endif
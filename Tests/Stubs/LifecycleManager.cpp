@@ -0,0 +1,71 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Core/Base/LifecycleManager.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Threading/TaskScheduler.h>
+
+// Replaces Core/Base/LifecycleManager.cpp in the tests. Rather than running the application on a
+// main thread owned by the manager, the application is initialised and destroyed immediately on
+// the calling thread, which becomes the main thread. As there is no main thread loop, each call to
+// SystemUpdate() executes the system thread tasks and then updates the application once, so that
+// a test can step the application a frame at a time.
+
+namespace ChilliSource
+{
+    //------------------------------------------------------------------------------
+    LifecycleManager::LifecycleManager(Application* application) noexcept
+        : m_application(application), m_targetLifecycleState(LifecycleState::k_initialised)
+    {
+        m_initTime = std::chrono::system_clock::now();
+        m_lastUpdateTime = m_initTime;
+        
+        m_application->Init();
+        
+        m_currentLifecycleState = LifecycleState::k_initialised;
+        m_initialised = true;
+    }
+    
+    //------------------------------------------------------------------------------
+    void LifecycleManager::SystemUpdate() noexcept
+    {
+        m_application->GetTaskScheduler()->ExecuteSystemThreadTasks();
+        
+        auto timeNow = std::chrono::system_clock::now();
+        std::chrono::duration<f32> deltaTime = timeNow - m_lastUpdateTime;
+        std::chrono::duration<double> runningTime = timeNow - m_initTime;
+        
+        m_lastUpdateTime = timeNow;
+        
+        m_application->Update(deltaTime.count(), TimeIntervalSecs(runningTime.count()));
+    }
+    
+    //------------------------------------------------------------------------------
+    LifecycleManager::~LifecycleManager() noexcept
+    {
+        m_application->Destroy();
+    }
+}
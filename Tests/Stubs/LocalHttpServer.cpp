@@ -0,0 +1,365 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include "LocalHttpServer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace ChilliSource
+{
+    namespace Test
+    {
+        namespace
+        {
+            const s32 k_pollIntervalMS = 50;
+
+#ifdef MSG_NOSIGNAL
+            const s32 k_sendFlags = MSG_NOSIGNAL;
+#else
+            const s32 k_sendFlags = 0;
+#endif
+
+            /// @return The reason phrase sent with the given status code.
+            ///
+            std::string GetReasonPhrase(u32 code) noexcept
+            {
+                switch (code)
+                {
+                    case 200: return "OK";
+                    case 204: return "No Content";
+                    case 206: return "Partial Content";
+                    case 301: return "Moved Permanently";
+                    case 302: return "Found";
+                    case 304: return "Not Modified";
+                    case 404: return "Not Found";
+                    case 416: return "Range Not Satisfiable";
+                    case 500: return "Internal Server Error";
+                    case 503: return "Service Unavailable";
+                    default: return "Status";
+                }
+            }
+
+            /// Writes all of the given data to the socket.
+            ///
+            /// @return Whether the data was written.
+            ///
+            bool WriteAll(s32 socket, const std::string& data) noexcept
+            {
+                std::size_t offset = 0;
+                while (offset < data.size())
+                {
+                    auto written = send(socket, data.data() + offset, data.size() - offset, k_sendFlags);
+                    if (written <= 0)
+                    {
+                        return false;
+                    }
+                    offset += std::size_t(written);
+                }
+                return true;
+            }
+
+            /// Reads from the socket into the buffer until it contains at least the given number
+            /// of bytes.
+            ///
+            /// @return Whether the data was read. This is false if the connection was closed or
+            ///     the server is stopping.
+            ///
+            bool ReadUntilSize(s32 socket, const std::atomic<bool>& isStopping, std::string& buffer, std::size_t size) noexcept
+            {
+                while (buffer.size() < size)
+                {
+                    if (isStopping == true)
+                    {
+                        return false;
+                    }
+
+                    pollfd pollDesc = { socket, POLLIN, 0 };
+                    auto pollResult = poll(&pollDesc, 1, k_pollIntervalMS);
+                    if (pollResult < 0)
+                    {
+                        return false;
+                    }
+                    if (pollResult == 0)
+                    {
+                        continue;
+                    }
+
+                    char data[4096];
+                    auto received = recv(socket, data, sizeof(data), 0);
+                    if (received <= 0)
+                    {
+                        return false;
+                    }
+                    buffer.append(data, std::size_t(received));
+                }
+                return true;
+            }
+
+            /// Reads from the socket into the buffer until it contains the end of a request head.
+            ///
+            /// @return The position of the end of the head, or npos if the connection was closed
+            ///     or the server is stopping.
+            ///
+            std::size_t ReadHead(s32 socket, const std::atomic<bool>& isStopping, std::string& buffer) noexcept
+            {
+                auto headEnd = buffer.find("\r\n\r\n");
+                while (headEnd == std::string::npos)
+                {
+                    if (ReadUntilSize(socket, isStopping, buffer, buffer.size() + 1) == false)
+                    {
+                        return std::string::npos;
+                    }
+                    headEnd = buffer.find("\r\n\r\n");
+                }
+                return headEnd;
+            }
+
+            /// Parses the request line and headers of a request head.
+            ///
+            void ParseHead(const std::string& head, LocalHttpServer::Request& request) noexcept
+            {
+                auto lineEnd = head.find("\r\n");
+                auto requestLine = head.substr(0, lineEnd);
+                auto methodEnd = requestLine.find(' ');
+                auto pathEnd = requestLine.find(' ', methodEnd + 1);
+                request.m_method = requestLine.substr(0, methodEnd);
+                request.m_path = requestLine.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+
+                while (lineEnd != std::string::npos)
+                {
+                    auto lineStart = lineEnd + 2;
+                    lineEnd = head.find("\r\n", lineStart);
+                    auto line = head.substr(lineStart, lineEnd == std::string::npos ? std::string::npos : lineEnd - lineStart);
+
+                    auto separator = line.find(':');
+                    if (separator == std::string::npos)
+                    {
+                        continue;
+                    }
+
+                    auto name = line.substr(0, separator);
+                    std::transform(name.begin(), name.end(), name.begin(), [](char c) { return char(std::tolower(c)); });
+                    auto valueStart = line.find_first_not_of(' ', separator + 1);
+                    request.m_headers[name] = (valueStart == std::string::npos) ? "" : line.substr(valueStart);
+                }
+            }
+
+            /// @return The given response serialised, with the head and framed body.
+            ///
+            std::string Serialise(const LocalHttpServer::Response& response) noexcept
+            {
+                std::string output = "HTTP/1.1 " + std::to_string(response.m_code) + " " + GetReasonPhrase(response.m_code) + "\r\n";
+                for (const auto& header : response.m_headers)
+                {
+                    output += header.first + ": " + header.second + "\r\n";
+                }
+
+                if (response.m_isKeepAlive == false || response.m_framing == LocalHttpServer::Framing::k_closeDelimited)
+                {
+                    output += "Connection: close\r\n";
+                }
+
+                switch (response.m_framing)
+                {
+                    case LocalHttpServer::Framing::k_contentLength:
+                    {
+                        output += "Content-Length: " + std::to_string(response.m_body.size()) + "\r\n\r\n";
+                        output += response.m_body;
+                        break;
+                    }
+                    case LocalHttpServer::Framing::k_chunked:
+                    {
+                        output += "Transfer-Encoding: chunked\r\n\r\n";
+
+                        char sizeLine[32];
+                        for (std::size_t offset = 0; offset < response.m_body.size(); offset += response.m_chunkSize)
+                        {
+                            auto chunk = response.m_body.substr(offset, response.m_chunkSize);
+                            std::snprintf(sizeLine, sizeof(sizeLine), "%zx\r\n", chunk.size());
+                            output += sizeLine + chunk + "\r\n";
+                        }
+                        output += "0\r\n\r\n";
+                        break;
+                    }
+                    case LocalHttpServer::Framing::k_closeDelimited:
+                    {
+                        output += "\r\n";
+                        output += response.m_body;
+                        break;
+                    }
+                }
+
+                return output;
+            }
+        }
+
+        //------------------------------------------------------------------------------
+        LocalHttpServer::LocalHttpServer(const Handler& handler) noexcept
+            : m_handler(handler), m_isStopping(false)
+        {
+            m_listenSocket = s32(socket(AF_INET, SOCK_STREAM, 0));
+            CS_ASSERT(m_listenSocket >= 0, "Cannot create the local http server socket.");
+
+            s32 reuse = 1;
+            setsockopt(m_listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+            sockaddr_in address;
+            std::memset(&address, 0, sizeof(address));
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            address.sin_port = 0;
+
+            auto bindResult = bind(m_listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+            CS_ASSERT(bindResult == 0, "Cannot bind the local http server socket.");
+            auto listenResult = listen(m_listenSocket, 16);
+            CS_ASSERT(listenResult == 0, "Cannot listen on the local http server socket.");
+
+            socklen_t addressLength = sizeof(address);
+            getsockname(m_listenSocket, reinterpret_cast<sockaddr*>(&address), &addressLength);
+            m_port = ntohs(address.sin_port);
+
+            m_acceptThread = std::thread(&LocalHttpServer::AcceptConnections, this);
+        }
+
+        //------------------------------------------------------------------------------
+        std::string LocalHttpServer::GetUrl(const std::string& path) const noexcept
+        {
+            return "http://127.0.0.1:" + std::to_string(m_port) + path;
+        }
+
+        //------------------------------------------------------------------------------
+        u16 LocalHttpServer::GetPort() const noexcept
+        {
+            return m_port;
+        }
+
+        //------------------------------------------------------------------------------
+        std::vector<LocalHttpServer::Request> LocalHttpServer::GetRequests() const noexcept
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            return m_requests;
+        }
+
+        //------------------------------------------------------------------------------
+        u32 LocalHttpServer::GetNumConnections() const noexcept
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            return m_numConnections;
+        }
+
+        //------------------------------------------------------------------------------
+        void LocalHttpServer::AcceptConnections() noexcept
+        {
+            while (m_isStopping == false)
+            {
+                pollfd pollDesc = { m_listenSocket, POLLIN, 0 };
+                if (poll(&pollDesc, 1, k_pollIntervalMS) <= 0)
+                {
+                    continue;
+                }
+
+                auto connection = s32(accept(m_listenSocket, nullptr, nullptr));
+                if (connection < 0)
+                {
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(m_mutex);
+                auto connectionIndex = m_numConnections++;
+                m_connectionThreads.push_back(std::thread(&LocalHttpServer::ServeConnection, this, connection, connectionIndex));
+            }
+        }
+
+        //------------------------------------------------------------------------------
+        void LocalHttpServer::ServeConnection(s32 socket, u32 connectionIndex) noexcept
+        {
+            std::string buffer;
+            while (m_isStopping == false)
+            {
+                auto headEnd = ReadHead(socket, m_isStopping, buffer);
+                if (headEnd == std::string::npos)
+                {
+                    break;
+                }
+
+                Request request;
+                request.m_connectionIndex = connectionIndex;
+                ParseHead(buffer.substr(0, headEnd), request);
+                buffer.erase(0, headEnd + 4);
+
+                auto contentLength = request.m_headers.find("content-length");
+                if (contentLength != request.m_headers.end())
+                {
+                    auto bodySize = std::size_t(std::strtoull(contentLength->second.c_str(), nullptr, 10));
+                    if (ReadUntilSize(socket, m_isStopping, buffer, bodySize) == false)
+                    {
+                        break;
+                    }
+                    request.m_body = buffer.substr(0, bodySize);
+                    buffer.erase(0, bodySize);
+                }
+
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_requests.push_back(request);
+                lock.unlock();
+
+                std::unique_lock<std::mutex> handlerLock(m_handlerMutex);
+                auto response = m_handler(request);
+                handlerLock.unlock();
+
+                if (WriteAll(socket, Serialise(response)) == false || response.m_isKeepAlive == false || response.m_framing == Framing::k_closeDelimited)
+                {
+                    break;
+                }
+            }
+
+            close(socket);
+        }
+
+        //------------------------------------------------------------------------------
+        LocalHttpServer::~LocalHttpServer() noexcept
+        {
+            m_isStopping = true;
+            m_acceptThread.join();
+
+            close(m_listenSocket);
+
+            for (auto& thread : m_connectionThreads)
+            {
+                thread.join();
+            }
+        }
+    }
+}
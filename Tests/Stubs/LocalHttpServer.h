@@ -0,0 +1,154 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#ifndef _CHILLISOURCE_TESTS_STUBS_LOCALHTTPSERVER_H_
+#define _CHILLISOURCE_TESTS_STUBS_LOCALHTTPSERVER_H_
+
+#include <ChilliSource/ChilliSource.h>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ChilliSource
+{
+    namespace Test
+    {
+        /// A minimal HTTP/1.1 server on the loopback interface which stands in for a remote server
+        /// in tests. Each request is passed to a handler which describes the response, and every
+        /// request received is recorded along with the connection it arrived on so that tests can
+        /// check how connections were used.
+        ///
+        /// Connections are kept alive unless the response says otherwise. Request bodies must be
+        /// framed by Content-Length. Requests are handled one at a time, so a slow handler holds up
+        /// every connection.
+        ///
+        class LocalHttpServer final
+        {
+        public:
+            CS_DECLARE_NOCOPY(LocalHttpServer);
+
+            /// A received request. Header names are lower case.
+            ///
+            struct Request final
+            {
+                std::string m_method;
+                std::string m_path;
+                std::unordered_map<std::string, std::string> m_headers;
+                std::string m_body;
+                u32 m_connectionIndex = 0;
+            };
+
+            /// How the body of a response is framed.
+            ///
+            enum class Framing
+            {
+                k_contentLength,
+                k_chunked,
+                k_closeDelimited
+            };
+
+            /// The response to send to a request.
+            ///
+            struct Response final
+            {
+                u32 m_code = 200;
+                std::vector<std::pair<std::string, std::string>> m_headers;
+                std::string m_body;
+                Framing m_framing = Framing::k_contentLength;
+                u32 m_chunkSize = 1024;
+                bool m_isKeepAlive = true;
+            };
+
+            using Handler = std::function<Response(const Request&)>;
+
+            /// Starts listening on an ephemeral port of 127.0.0.1.
+            ///
+            /// @param handler
+            ///     Called on a server thread for each request received.
+            ///
+            LocalHttpServer(const Handler& handler) noexcept;
+
+            /// @param path
+            ///     The path, beginning with a slash.
+            ///
+            /// @return The http url of the given path on this server.
+            ///
+            std::string GetUrl(const std::string& path) const noexcept;
+
+            /// @return The port the server is listening on.
+            ///
+            u16 GetPort() const noexcept;
+
+            /// @return All requests received so far, in order.
+            ///
+            std::vector<Request> GetRequests() const noexcept;
+
+            /// @return The number of connections accepted so far.
+            ///
+            u32 GetNumConnections() const noexcept;
+
+            /// Stops listening, closes all connections and waits for the server threads to finish.
+            ///
+            ~LocalHttpServer() noexcept;
+
+        private:
+            /// Accepts connections until the server is stopped.
+            ///
+            void AcceptConnections() noexcept;
+
+            /// Reads requests from the given connection and responds to them until either side
+            /// closes it or the server is stopped.
+            ///
+            /// @param socket
+            ///     The connected socket.
+            /// @param connectionIndex
+            ///     The index of the connection, in the order accepted.
+            ///
+            void ServeConnection(s32 socket, u32 connectionIndex) noexcept;
+
+            const Handler m_handler;
+
+            s32 m_listenSocket = -1;
+            u16 m_port = 0;
+            std::atomic<bool> m_isStopping;
+            std::thread m_acceptThread;
+
+            mutable std::mutex m_mutex;
+            std::vector<std::thread> m_connectionThreads;
+            std::vector<Request> m_requests;
+            u32 m_numConnections = 0;
+
+            std::mutex m_handlerMutex;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,87 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Core/Base/Logging.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+// Replaces Core/Base/Logging.cpp in the tests, which depends on the Application and the file
+// system. Messages are written straight to stderr and fatal messages abort, failing the test.
+// The logger is created on first use, so that it can be used outside of an application, and
+// creating or destroying it with the application does nothing.
+
+namespace ChilliSource
+{
+    Logging* Logging::s_logging = nullptr;
+    
+    //------------------------------------------------------------------------------
+    Logging::Logging()
+        : m_logLevel(LogLevel::k_verbose), m_enqueuePosition(0), m_dequeuePosition(0)
+    {
+    }
+    
+    //------------------------------------------------------------------------------
+    void Logging::Create()
+    {
+    }
+    
+    //------------------------------------------------------------------------------
+    void Logging::Destroy()
+    {
+    }
+    
+    //------------------------------------------------------------------------------
+    Logging* Logging::Get()
+    {
+        static Logging logging;
+        return &logging;
+    }
+    
+    //------------------------------------------------------------------------------
+    void Logging::LogVerbose(std::string in_message)
+    {
+        fprintf(stderr, "[ChilliSource] %s\n", in_message.c_str());
+    }
+    
+    //------------------------------------------------------------------------------
+    void Logging::LogWarning(std::string in_message)
+    {
+        fprintf(stderr, "[ChilliSource] WARNING: %s\n", in_message.c_str());
+    }
+    
+    //------------------------------------------------------------------------------
+    void Logging::LogError(std::string in_message)
+    {
+        fprintf(stderr, "[ChilliSource] ERROR: %s\n", in_message.c_str());
+    }
+    
+    //------------------------------------------------------------------------------
+    void Logging::LogFatal(std::string in_message)
+    {
+        fprintf(stderr, "[ChilliSource] FATAL: %s\n", in_message.c_str());
+        abort();
+    }
+}
@@ -0,0 +1,74 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <CSBackend/Platform/Android/Main/JNI/Input/Pointer/PointerSystem.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Base/Screen.h>
+
+// Replaces the Android pointer system in the tests, which is told about touches through JNI.
+// Tests which need pointer input add the events to the pointer system directly.
+
+namespace CSBackend
+{
+    namespace Android
+    {
+        CS_DEFINE_NAMEDTYPE(PointerSystem);
+        
+        //------------------------------------------------------------------------------
+        bool PointerSystem::IsA(ChilliSource::InterfaceIDType in_interfaceId) const
+        {
+            return (ChilliSource::PointerSystem::InterfaceID == in_interfaceId || PointerSystem::InterfaceID == in_interfaceId);
+        }
+        
+        //------------------------------------------------------------------------------
+        void PointerSystem::OnTouchDown(s32, const ChilliSource::Vector2&)
+        {
+        }
+        
+        //------------------------------------------------------------------------------
+        void PointerSystem::OnTouchMoved(s32, const ChilliSource::Vector2&)
+        {
+        }
+        
+        //------------------------------------------------------------------------------
+        void PointerSystem::OnTouchUp(s32)
+        {
+        }
+        
+        //------------------------------------------------------------------------------
+        void PointerSystem::OnInit()
+        {
+            m_screen = ChilliSource::Application::Get()->GetSystem<ChilliSource::Screen>();
+            CS_ASSERT(m_screen != nullptr, "Cannot find required system for PointerSystem: Screen.");
+        }
+        
+        //------------------------------------------------------------------------------
+        void PointerSystem::OnDestroy()
+        {
+            RemoveAllPointers();
+            m_screen = nullptr;
+        }
+    }
+}
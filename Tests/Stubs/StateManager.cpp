@@ -0,0 +1,56 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/State/StateManager.h>
+
+#include <ChilliSource/Core/State/State.h>
+
+// Replaces the parts of Core/State/StateManager.cpp and Core/State/State.cpp that the canvas
+// renderer links against, so that UI tests don't need to link the scene and everything it
+// depends on. Tests never create a state manager or any states.
+
+namespace ChilliSource
+{
+    namespace
+    {
+        const StateSPtr k_nullState;
+    }
+    
+    //------------------------------------------------------------------------------
+    const StateSPtr& StateManager::GetActiveState() const
+    {
+        if (m_states.empty() == false)
+        {
+            return m_states.back();
+        }
+        
+        return k_nullState;
+    }
+    
+    //------------------------------------------------------------------------------
+    Canvas* State::GetUICanvas()
+    {
+        return m_canvas;
+    }
+}
@@ -0,0 +1,68 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Core/Threading/TaskPool.h>
+
+#include <ChilliSource/Core/Threading/TaskContext.h>
+#include <ChilliSource/Core/Threading/TaskType.h>
+
+// Replaces Core/Threading/TaskPool.cpp in the tests, which attaches its worker threads to the
+// Java VM on Android. No worker threads are started: tasks, and child tasks, are run in order
+// on the calling thread.
+
+namespace ChilliSource
+{
+    //------------------------------------------------------------------------------
+    TaskPool::TaskPool(TaskType in_taskType, u32 in_numThreads) noexcept
+        : m_numThreads(in_numThreads), m_taskContext(in_taskType, this), m_taskCountHeuristic(0), m_isFinished(false)
+    {
+    }
+    
+    //------------------------------------------------------------------------------
+    u32 TaskPool::GetNumThreads() const noexcept
+    {
+        return m_numThreads;
+    }
+    
+    //------------------------------------------------------------------------------
+    void TaskPool::AddTasks(const std::vector<Task>& in_tasks) noexcept
+    {
+        for (const auto& task : in_tasks)
+        {
+            task(m_taskContext);
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    void TaskPool::AddTasksAndYield(const std::vector<Task>& in_tasks) noexcept
+    {
+        AddTasks(in_tasks);
+    }
+    
+    //------------------------------------------------------------------------------
+    TaskPool::~TaskPool() noexcept
+    {
+    }
+}
@@ -0,0 +1,110 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2016 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <CSBackend/Platform/Android/Main/JNI/Input/TextEntry/TextEntry.h>
+
+// Replaces the Android text entry in the tests, which shows the keyboard through JNI. There is
+// no keyboard, so the text buffer only changes when it is set and the text entry is only
+// deactivated when asked to be.
+
+namespace CSBackend
+{
+    namespace Android
+    {
+        CS_DEFINE_NAMEDTYPE(TextEntry);
+        
+        //------------------------------------------------------------------------------
+        TextEntry::TextEntry()
+        {
+        }
+        
+        //------------------------------------------------------------------------------
+        bool TextEntry::IsA(ChilliSource::InterfaceIDType in_interfaceId) const
+        {
+            return (ChilliSource::TextEntry::InterfaceID == in_interfaceId || TextEntry::InterfaceID == in_interfaceId);
+        }
+        
+        //------------------------------------------------------------------------------
+        void TextEntry::Activate(const std::string& in_text, ChilliSource::TextEntryType, ChilliSource::TextEntryCapitalisation, const TextBufferChangedDelegate& in_changeDelegate, const TextInputDeactivatedDelegate& in_deactivateDelegate)
+        {
+            if (m_enabled == false)
+            {
+                m_textBufferChangedDelegate = in_changeDelegate;
+                m_textInputDeactivatedDelegate = in_deactivateDelegate;
+                m_text = in_text;
+                m_enabled = true;
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void TextEntry::Deactivate()
+        {
+            OnKeyboardDismissed();
+        }
+        
+        //------------------------------------------------------------------------------
+        bool TextEntry::IsActive() const
+        {
+            return m_enabled;
+        }
+        
+        //------------------------------------------------------------------------------
+        const std::string& TextEntry::GetTextBuffer() const
+        {
+            return m_text;
+        }
+        
+        //------------------------------------------------------------------------------
+        void TextEntry::SetTextBuffer(const std::string& in_text)
+        {
+            m_text = in_text;
+        }
+        
+        //------------------------------------------------------------------------------
+        void TextEntry::OnTextChanged(const std::string&)
+        {
+        }
+        
+        //------------------------------------------------------------------------------
+        void TextEntry::OnKeyboardDismissed()
+        {
+            if (m_enabled == true)
+            {
+                m_enabled = false;
+                
+                if (m_textInputDeactivatedDelegate != nullptr)
+                {
+                    auto delegate = m_textInputDeactivatedDelegate;
+                    m_textInputDeactivatedDelegate = nullptr;
+                    delegate();
+                }
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        TextEntry::~TextEntry()
+        {
+        }
+    }
+}
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+#
+#  The MIT License (MIT)
+#
+#  Copyright (c) 2016 Tag Games Limited
+#
+#  Permission is hereby granted, free of charge, to any person obtaining a copy
+#  of this software and associated documentation files (the "Software"), to deal
+#  in the Software without restriction, including without limitation the rights
+#  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+#  copies of the Software, and to permit persons to whom the Software is
+#  furnished to do so, subject to the following conditions:
+#
+#  The above copyright notice and this permission notice shall be included in
+#  all copies or substantial portions of the Software.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+#  THE SOFTWARE.
+#
+
+import sys
+import os
+import json
+import struct
+
+#----------------------------------------------------------------------
+# Compiles json text files to binary json, which can be read by the
+# engine without any text parsing. See JsonUtils::ParseBinaryJson().
+#
+# Given a single file the output path is the path of the binary json
+# file. Given a directory, all UI widget definitions (.csuidef), widget
+# templates (.csui) and particle effects (.csparticle) within it are
+# compiled to .csuidefbin, .csuibin and .csparticlebin files
+# respectively, mirroring the directory structure in the output
+# directory.
+#----------------------------------------------------------------------
+
+BINARY_JSON_MAGIC = b"CSBJ"
+BINARY_JSON_VERSION = 1
+
+# These must match the BinaryJsonType enum in JsonUtils.cpp
+TYPE_NULL = 0
+TYPE_FALSE = 1
+TYPE_TRUE = 2
+TYPE_INT = 3
+TYPE_UINT = 4
+TYPE_DOUBLE = 5
+TYPE_STRING = 6
+TYPE_ARRAY = 7
+TYPE_OBJECT = 8
+
+COMPILED_EXTENSIONS = { ".csuidef": ".csuidefbin", ".csui": ".csuibin", ".csparticle": ".csparticlebin" }
+
+#----------------------------------------------------------------------
+# Writes a length prefixed UTF-8 string.
+#
+# @param The output byte array.
+# @param The string.
+#----------------------------------------------------------------------
+def write_string(output, value):
+    encoded = value.encode("utf-8")
+    output += struct.pack("<I", len(encoded))
+    output += encoded
+
+#----------------------------------------------------------------------
+# Recursively writes the given json value as binary json.
+#
+# @param The output byte array.
+# @param The json value.
+#----------------------------------------------------------------------
+def write_value(output, value):
+    if value is None:
+        output += struct.pack("<B", TYPE_NULL)
+    elif value is True:
+        output += struct.pack("<B", TYPE_TRUE)
+    elif value is False:
+        output += struct.pack("<B", TYPE_FALSE)
+    elif isinstance(value, int) and -2**31 <= value < 2**31:
+        output += struct.pack("<Bi", TYPE_INT, value)
+    elif isinstance(value, int) and 0 <= value < 2**32:
+        output += struct.pack("<BI", TYPE_UINT, value)
+    elif isinstance(value, (int, float)):
+        output += struct.pack("<Bd", TYPE_DOUBLE, float(value))
+    elif isinstance(value, str):
+        output += struct.pack("<B", TYPE_STRING)
+        write_string(output, value)
+    elif isinstance(value, list):
+        output += struct.pack("<BI", TYPE_ARRAY, len(value))
+        for item in value:
+            write_value(output, item)
+    elif isinstance(value, dict):
+        output += struct.pack("<BI", TYPE_OBJECT, len(value))
+        for key, item in value.items():
+            write_string(output, key)
+            write_value(output, item)
+    else:
+        raise ValueError("Unsupported json value: " + repr(value))
+
+#----------------------------------------------------------------------
+# Compiles a single json file to binary json.
+#
+# @param The input json file path.
+# @param The output binary json file path.
+#----------------------------------------------------------------------
+def compile_file(input_path, output_path):
+    with open(input_path, "r", encoding="utf-8") as input_file:
+        root = json.load(input_file)
+
+    output = bytearray(BINARY_JSON_MAGIC)
+    output += struct.pack("<I", BINARY_JSON_VERSION)
+    write_value(output, root)
+
+    output_dir = os.path.dirname(output_path)
+    if len(output_dir) > 0:
+        os.makedirs(output_dir, exist_ok=True)
+
+    with open(output_path, "wb") as output_file:
+        output_file.write(output)
+
+#----------------------------------------------------------------------
+# Compiles all json resource files in the given directory tree.
+#
+# @param The input directory path.
+# @param The output directory path.
+#----------------------------------------------------------------------
+def compile_directory(input_dir, output_dir):
+    for dir_path, dir_names, file_names in os.walk(input_dir):
+        for file_name in file_names:
+            name, extension = os.path.splitext(file_name)
+            if extension in COMPILED_EXTENSIONS:
+                relative_dir = os.path.relpath(dir_path, input_dir)
+                output_path = os.path.join(output_dir, relative_dir, name + COMPILED_EXTENSIONS[extension])
+                compile_file(os.path.join(dir_path, file_name), output_path)
+
+#----------------------------------------------------------------------
+# The entry point into the script.
+#
+# @param The list of arguments.
+#----------------------------------------------------------------------
+def main(args):
+    if len(args) != 3:
+        print("ERROR: Usage: compile_json.py <input file or directory> <output file or directory>")
+        return
+
+    if os.path.isdir(args[1]):
+        compile_directory(args[1], args[2])
+    else:
+        compile_file(args[1], args[2])
+
+if __name__ == "__main__":
+    main(sys.argv)
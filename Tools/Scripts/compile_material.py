@@ -0,0 +1,385 @@
+#!/usr/bin/env python3
+#
+#  The MIT License (MIT)
+#
+#  Copyright (c) 2016 Tag Games Limited
+#
+#  Permission is hereby granted, free of charge, to any person obtaining a copy
+#  of this software and associated documentation files (the "Software"), to deal
+#  in the Software without restriction, including without limitation the rights
+#  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+#  copies of the Software, and to permit persons to whom the Software is
+#  furnished to do so, subject to the following conditions:
+#
+#  The above copyright notice and this permission notice shall be included in
+#  all copies or substantial portions of the Software.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+#  THE SOFTWARE.
+#
+
+import sys
+import os
+import struct
+import xml.etree.ElementTree as ElementTree
+
+#----------------------------------------------------------------------
+# Compiles XML material files (.csmaterial) to binary materials
+# (.csmaterialbin), which can be read by the engine without any XML
+# parsing. See MaterialProvider for the reader, which this must be kept
+# in sync with.
+#
+# Given a single file the output path is the path of the binary
+# material. Given a directory, all materials within it are compiled,
+# mirroring the directory structure in the output directory.
+#----------------------------------------------------------------------
+
+FILE_FORMAT_ID = 2
+FILE_FORMAT_VERSION = 1
+HEADER_SIZE = 20
+CHUNK_TABLE_ENTRY_SIZE = 12
+
+FLAG_DEPTH_WRITE = 1 << 0
+FLAG_DEPTH_TEST = 1 << 1
+FLAG_TRANSPARENCY = 1 << 2
+FLAG_CULLING = 1 << 3
+FLAG_BLEND_FUNC = 1 << 4
+FLAG_CULL_FACE = 1 << 5
+FLAG_DEPTH_TEST_FUNC = 1 << 6
+FLAG_LIGHTING = 1 << 7
+FLAG_EMISSIVE = 1 << 8
+FLAG_AMBIENT = 1 << 9
+FLAG_DIFFUSE = 1 << 10
+
+# Enums are stored as indices into these tables, so the order is part of
+# the file format.
+BLEND_MODES = ["zero", "one", "sourcecolour", "oneminussourcecolour", "sourcealpha", "oneminussourcealpha", "destalpha", "oneminusdestalpha"]
+DEPTH_TEST_FUNCS = ["never", "less", "lequal", "greater", "gequal", "equal", "notequal", "always"]
+CULL_FACES = ["front", "back"]
+WRAP_MODES = ["clamp", "repeat"]
+FILTER_MODES = ["nearest", "bilinear"]
+SHADING_TYPES = ["unlit", "blinn", "custom"]
+RENDER_PASSES = ["shadowmap", "base", "directionallight", "directionallightshadows", "pointlight", "transparent"]
+TEXTURE_TYPES = ["texture", "cubemap"]
+VERTEX_FORMATS = ["sprite", "staticmesh", "animatedmesh"]
+STORAGE_LOCATIONS = ["package", "savedata", "cache", "dlc", "root", "chillisource", "none"]
+SHADER_VAR_TYPES = ["Float", "Vec2", "Vec3", "Vec4", "Colour", "Matrix"]
+SHADER_VAR_SIZES = [1, 2, 3, 4, 4, 16]
+
+WHITE = [1.0, 1.0, 1.0, 1.0]
+DEFAULT_SPECULAR = [1.0, 1.0, 1.0, 0.0]
+ZERO = [0.0, 0.0, 0.0, 0.0]
+IDENTITY = [1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0]
+
+COMPILED_EXTENSIONS = { ".csmaterial": ".csmaterialbin" }
+
+#----------------------------------------------------------------------
+# @param The parent element.
+# @param The child element name.
+#
+# @return The first direct child element with the given name, or None.
+#----------------------------------------------------------------------
+def get_first_child(parent, name):
+    return parent.find(name) if parent is not None else None
+
+#----------------------------------------------------------------------
+# Converts the given string to an index into the given table. This is
+# case insensitive, matching the engine.
+#
+# @param The string value.
+# @param The lower case table of valid values.
+# @param The name of the type, used for error messages.
+#
+# @return The index.
+#----------------------------------------------------------------------
+def parse_enum(value, table, type_name):
+    if value.lower() not in table:
+        raise ValueError("Invalid " + type_name + ": " + value)
+    return table.index(value.lower())
+
+#----------------------------------------------------------------------
+# @param The string value.
+#
+# @return The boolean value, following the same rules as the engine's
+# ParseBool().
+#----------------------------------------------------------------------
+def parse_bool(value):
+    return value.startswith("true") or value.startswith("yes") or value.startswith("1")
+
+#----------------------------------------------------------------------
+# @param A whitespace separated list of floats.
+# @param The expected number of floats.
+#
+# @return The floats.
+#----------------------------------------------------------------------
+def parse_floats(value, count):
+    items = value.split()
+    if len(items) != count:
+        raise ValueError("Expected " + str(count) + " values but found " + str(len(items)) + ": " + value)
+    return [float(item) for item in items]
+
+#----------------------------------------------------------------------
+# Parses the colour in the value attribute of the given element. As in
+# the engine, a missing value is white and the alpha defaults to 1 if
+# only three components are given.
+#
+# @param The element.
+#
+# @return The colour as RGBA.
+#----------------------------------------------------------------------
+def parse_colour(element):
+    value = element.get("value")
+    if value is None:
+        return list(WHITE)
+    if len(value.split()) == 3:
+        return parse_floats(value, 3) + [1.0]
+    return parse_floats(value, 4)
+
+#----------------------------------------------------------------------
+# @param The output byte array.
+# @param The floats to write.
+#----------------------------------------------------------------------
+def write_floats(output, values):
+    for value in values:
+        output += struct.pack("<f", value)
+
+#----------------------------------------------------------------------
+# Writes a length prefixed UTF-8 string, without a null terminator.
+#
+# @param The output byte array.
+# @param The string.
+#----------------------------------------------------------------------
+def write_string(output, value):
+    encoded = value.encode("utf-8")
+    output += struct.pack("<I", len(encoded))
+    output += encoded
+
+#----------------------------------------------------------------------
+# Builds the MATL chunk. Flags record which elements were present in
+# the XML so the engine only overrides the material defaults that the
+# XML did.
+#
+# @param The root Material element.
+# @param The shading type string.
+#
+# @return The chunk data.
+#----------------------------------------------------------------------
+def build_matl_chunk(root, shading_type):
+    flags = 0
+    render_states = 0
+
+    render_states_el = get_first_child(root, "RenderStates")
+    if render_states_el is not None:
+        states = [(FLAG_DEPTH_WRITE, "DepthWrite", "true"), (FLAG_DEPTH_TEST, "DepthTest", "true"), (FLAG_TRANSPARENCY, "Transparency", "false"), (FLAG_CULLING, "Culling", "true")]
+        for state_flag, state_name, state_default in states:
+            state_el = get_first_child(render_states_el, state_name)
+            if state_el is not None:
+                flags |= state_flag
+                if parse_bool(state_el.get("enabled", state_default)):
+                    render_states |= state_flag
+
+    src_blend_mode = BLEND_MODES.index("one")
+    dst_blend_mode = BLEND_MODES.index("one")
+    blend_func_el = get_first_child(root, "BlendFunc")
+    if blend_func_el is not None:
+        flags |= FLAG_BLEND_FUNC
+        src_blend_mode = parse_enum(blend_func_el.get("src", "One"), BLEND_MODES, "blend mode")
+        dst_blend_mode = parse_enum(blend_func_el.get("dst", "One"), BLEND_MODES, "blend mode")
+
+    cull_face = 0
+    cull_face_el = get_first_child(root, "Culling")
+    if cull_face_el is not None:
+        flags |= FLAG_CULL_FACE
+        cull_face = parse_enum(cull_face_el.get("face", "Front"), CULL_FACES, "cull face")
+
+    depth_test_func = DEPTH_TEST_FUNCS.index("lequal")
+    depth_test_func_el = get_first_child(root, "DepthTestFunc")
+    if depth_test_func_el is not None:
+        flags |= FLAG_DEPTH_TEST_FUNC
+        depth_test_func = parse_enum(depth_test_func_el.get("func", "lequal"), DEPTH_TEST_FUNCS, "depth test func")
+
+    emissive = list(ZERO)
+    ambient = list(ZERO)
+    diffuse = list(ZERO)
+    specular = list(DEFAULT_SPECULAR)
+    lighting_el = get_first_child(root, "Lighting")
+    if lighting_el is not None:
+        flags |= FLAG_LIGHTING
+
+        emissive_el = get_first_child(lighting_el, "Emissive")
+        if emissive_el is not None:
+            flags |= FLAG_EMISSIVE
+            emissive = parse_colour(emissive_el)
+
+        ambient_el = get_first_child(lighting_el, "Ambient")
+        if ambient_el is not None:
+            flags |= FLAG_AMBIENT
+            ambient = parse_colour(ambient_el)
+
+        diffuse_el = get_first_child(lighting_el, "Diffuse")
+        if diffuse_el is not None:
+            flags |= FLAG_DIFFUSE
+            diffuse = parse_colour(diffuse_el)
+
+        specular_el = get_first_child(lighting_el, "Specular")
+        if specular_el is not None:
+            specular = parse_colour(specular_el)
+
+        shininess_el = get_first_child(lighting_el, "Shininess")
+        if shininess_el is not None:
+            specular[3] = float(shininess_el.get("value", "0"))
+
+    output = bytearray()
+    output += struct.pack("<I", flags)
+    output += struct.pack("<6BH", parse_enum(shading_type, SHADING_TYPES, "material type"), render_states, src_blend_mode, dst_blend_mode, cull_face, depth_test_func, 0)
+    write_floats(output, emissive)
+    write_floats(output, ambient)
+    write_floats(output, diffuse)
+    write_floats(output, specular)
+    return output
+
+#----------------------------------------------------------------------
+# Builds the SHDR chunk from the Shaders element.
+#
+# @param The Shaders element.
+#
+# @return The chunk data.
+#----------------------------------------------------------------------
+def build_shdr_chunk(shaders_el):
+    shader_els = shaders_el.findall("Shader")
+
+    output = bytearray()
+    output += struct.pack("<B", parse_enum(shaders_el.get("vertex-format", "StaticMesh"), VERTEX_FORMATS, "vertex format"))
+    output += struct.pack("<B", parse_enum(shaders_el.get("fallback-type", "Custom"), SHADING_TYPES, "fallback type"))
+    output += struct.pack("<I", len(shader_els))
+
+    for shader_el in shader_els:
+        output += struct.pack("<B", parse_enum(shader_el.get("location", "Package"), STORAGE_LOCATIONS, "storage location"))
+        output += struct.pack("<B", parse_enum(shader_el.get("pass", "Base"), RENDER_PASSES, "render pass"))
+        write_string(output, shader_el.get("file-name", ""))
+
+        # unknown var types are ignored by the XML parser, so they are skipped here too.
+        var_els = [var_el for var_el in shader_el.findall("Var") if var_el.get("type", "") in SHADER_VAR_TYPES]
+
+        output += struct.pack("<I", len(var_els))
+        for var_el in var_els:
+            var_type = SHADER_VAR_TYPES.index(var_el.get("type"))
+            output += struct.pack("<B", var_type)
+            write_string(output, var_el.get("name", ""))
+
+            if SHADER_VAR_TYPES[var_type] == "Colour":
+                write_floats(output, parse_colour(var_el))
+            elif var_el.get("value") is not None:
+                write_floats(output, parse_floats(var_el.get("value"), SHADER_VAR_SIZES[var_type]))
+            elif SHADER_VAR_TYPES[var_type] == "Matrix":
+                write_floats(output, IDENTITY)
+            else:
+                write_floats(output, [0.0] * SHADER_VAR_SIZES[var_type])
+
+    return output
+
+#----------------------------------------------------------------------
+# Builds the TEXR chunk from the Textures element.
+#
+# @param The Textures element. May be None.
+#
+# @return The chunk data.
+#----------------------------------------------------------------------
+def build_texr_chunk(textures_el):
+    texture_els = textures_el.findall("Texture") if textures_el is not None else []
+
+    output = bytearray()
+    output += struct.pack("<I", len(texture_els))
+
+    for texture_el in texture_els:
+        output += struct.pack("<B", parse_enum(texture_el.get("location", "Package"), STORAGE_LOCATIONS, "storage location"))
+        output += struct.pack("<B", parse_enum(texture_el.get("type", "Texture"), TEXTURE_TYPES, "texture type"))
+        output += struct.pack("<B", 1 if parse_bool(texture_el.get("mipmapped", "false")) else 0)
+        output += struct.pack("<B", parse_enum(texture_el.get("filter-mode", "Bilinear"), FILTER_MODES, "filter mode"))
+        output += struct.pack("<B", parse_enum(texture_el.get("wrap-mode-u", "Clamp"), WRAP_MODES, "wrap mode"))
+        output += struct.pack("<B", parse_enum(texture_el.get("wrap-mode-v", "Clamp"), WRAP_MODES, "wrap mode"))
+        write_string(output, texture_el.get("file-name", ""))
+
+    return output
+
+#----------------------------------------------------------------------
+# Compiles a single XML material to a binary material.
+#
+# @param The input material file path.
+# @param The output binary material file path.
+#----------------------------------------------------------------------
+def compile_file(input_path, output_path):
+    root = ElementTree.parse(input_path).getroot()
+    if root.tag != "Material":
+        raise ValueError("Material file '" + input_path + "' does not have a root Material element.")
+
+    shading_type = root.get("type", "Static")
+    chunks = [(b"MATL", build_matl_chunk(root, shading_type))]
+
+    shaders_el = get_first_child(root, "Shaders")
+    if shaders_el is not None:
+        if shading_type.lower() != "custom":
+            raise ValueError("Only custom materials can have shaders.")
+        chunks.append((b"SHDR", build_shdr_chunk(shaders_el)))
+
+    chunks.append((b"TEXR", build_texr_chunk(get_first_child(root, "Textures"))))
+
+    output = bytearray(b"CSCS")
+    output += struct.pack("<4I", 9999, FILE_FORMAT_ID, FILE_FORMAT_VERSION, len(chunks))
+
+    chunk_offset = HEADER_SIZE + len(chunks) * CHUNK_TABLE_ENTRY_SIZE
+    for chunk_id, chunk in chunks:
+        output += chunk_id
+        output += struct.pack("<2I", chunk_offset, len(chunk))
+        chunk_offset += len(chunk)
+
+    for chunk_id, chunk in chunks:
+        output += chunk
+
+    output_dir = os.path.dirname(output_path)
+    if len(output_dir) > 0:
+        os.makedirs(output_dir, exist_ok=True)
+
+    with open(output_path, "wb") as output_file:
+        output_file.write(output)
+
+#----------------------------------------------------------------------
+# Compiles all materials in the given directory tree.
+#
+# @param The input directory path.
+# @param The output directory path.
+#----------------------------------------------------------------------
+def compile_directory(input_dir, output_dir):
+    for dir_path, dir_names, file_names in os.walk(input_dir):
+        for file_name in file_names:
+            name, extension = os.path.splitext(file_name)
+            if extension in COMPILED_EXTENSIONS:
+                relative_dir = os.path.relpath(dir_path, input_dir)
+                output_path = os.path.join(output_dir, relative_dir, name + COMPILED_EXTENSIONS[extension])
+                compile_file(os.path.join(dir_path, file_name), output_path)
+
+#----------------------------------------------------------------------
+# The entry point into the script.
+#
+# @param The list of arguments.
+#
+# @return The exit code.
+#----------------------------------------------------------------------
+def main(args):
+    if len(args) != 3:
+        print("ERROR: Usage: compile_material.py <input file or directory> <output file or directory>")
+        return 1
+
+    if os.path.isdir(args[1]):
+        compile_directory(args[1], args[2])
+    else:
+        compile_file(args[1], args[2])
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
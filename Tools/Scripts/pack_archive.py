@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+#
+#  The MIT License (MIT)
+#
+#  Copyright (c) 2016 Tag Games Limited
+#
+#  Permission is hereby granted, free of charge, to any person obtaining a copy
+#  of this software and associated documentation files (the "Software"), to deal
+#  in the Software without restriction, including without limitation the rights
+#  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+#  copies of the Software, and to permit persons to whom the Software is
+#  furnished to do so, subject to the following conditions:
+#
+#  The above copyright notice and this permission notice shall be included in
+#  all copies or substantial portions of the Software.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+#  THE SOFTWARE.
+#
+
+import sys
+import os
+import struct
+import zlib
+
+#----------------------------------------------------------------------
+# Builds a packed archive (.cspack) from the contents of a directory,
+# which can be read by PackedArchive in the engine. The archive
+# contains a header, an index of entries sorted by the CRC32 hash of
+# their path, a path table and then the aligned file data. Files are
+# compressed with zlib unless their extension is listed as
+# uncompressed, or compression doesn't reduce their size.
+#
+# All values are little endian. This must be kept in sync with
+# PackedArchive.cpp.
+#----------------------------------------------------------------------
+
+MAGIC = b"CSPK"
+VERSION = 1
+HEADER_SIZE = 24
+ENTRY_SIZE = 32
+
+FLAG_DIRECTORY = 1 << 0
+FLAG_COMPRESSED = 1 << 1
+
+DEFAULT_ALIGNMENT = 16
+
+#----------------------------------------------------------------------
+# A single file or directory in the archive.
+#----------------------------------------------------------------------
+class Entry:
+    def __init__(self, path, file_path, flags):
+        self.path = path
+        self.file_path = file_path
+        self.path_hash = zlib.crc32(path.encode("utf-8")) & 0xffffffff
+        self.path_offset = 0
+        self.path_length = 0
+        self.flags = flags
+        self.data_offset = 0
+        self.stored_size = 0
+        self.uncompressed_size = 0
+
+#----------------------------------------------------------------------
+# Recursively adds an entry for each file and directory in the given
+# directory. Directory paths have a trailing slash.
+#
+# @param The directory to gather from.
+# @param The path of the directory relative to the input directory.
+# @param The list the entries are added to.
+#----------------------------------------------------------------------
+def gather_entries(directory, relative_path, entries):
+    for name in sorted(os.listdir(directory)):
+        file_path = os.path.join(directory, name)
+        if os.path.isdir(file_path):
+            entry = Entry(relative_path + name + "/", file_path, FLAG_DIRECTORY)
+            gather_entries(file_path, entry.path, entries)
+        else:
+            entry = Entry(relative_path + name, file_path, 0)
+        entries.append(entry)
+
+#----------------------------------------------------------------------
+# Reads the contents of the file for the given entry, compressing it
+# if appropriate. The entry's flags and uncompressed size are updated.
+#
+# @param The file entry.
+# @param The extensions which shouldn't be compressed.
+#
+# @return The data which should be stored in the archive.
+#----------------------------------------------------------------------
+def read_file_data(entry, uncompressed_extensions):
+    with open(entry.file_path, "rb") as input_file:
+        data = input_file.read()
+    entry.uncompressed_size = len(data)
+
+    if len(data) == 0 or entry.path.lower().endswith(tuple(uncompressed_extensions)):
+        return data
+
+    compressed = zlib.compress(data, 9)
+    if len(compressed) >= len(data):
+        return data
+
+    entry.flags |= FLAG_COMPRESSED
+    return compressed
+
+#----------------------------------------------------------------------
+# @param The value to align.
+# @param The alignment. Must be a power of two.
+#
+# @return The value rounded up to the next multiple of the alignment.
+#----------------------------------------------------------------------
+def align(value, alignment):
+    return (value + alignment - 1) & ~(alignment - 1)
+
+#----------------------------------------------------------------------
+# Builds a packed archive from the contents of the given directory.
+#
+# @param The input directory path.
+# @param The output archive file path.
+# @param The extensions which shouldn't be compressed, in lower case
+# with a leading full stop.
+# @param The alignment of each file's data within the archive.
+#----------------------------------------------------------------------
+def build_archive(input_dir, output_path, uncompressed_extensions, alignment):
+    entries = []
+    gather_entries(input_dir, "", entries)
+    entries.sort(key=lambda entry: (entry.path_hash, entry.path))
+
+    path_table = bytearray()
+    for entry in entries:
+        encoded = entry.path.encode("utf-8")
+        entry.path_offset = len(path_table)
+        entry.path_length = len(encoded)
+        path_table += encoded
+
+    data = bytearray()
+    data_start = align(HEADER_SIZE + len(entries) * ENTRY_SIZE + len(path_table), alignment)
+    for entry in entries:
+        if (entry.flags & FLAG_DIRECTORY) != 0:
+            continue
+
+        stored = read_file_data(entry, uncompressed_extensions)
+        data += bytes(align(len(data), alignment) - len(data))
+        entry.data_offset = data_start + len(data)
+        entry.stored_size = len(stored)
+        data += stored
+
+    output = bytearray(MAGIC)
+    output += struct.pack("<IIIII", VERSION, len(entries), alignment, len(path_table), 0)
+    for entry in entries:
+        output += struct.pack("<IIIIQII", entry.path_hash, entry.path_offset, entry.path_length, entry.flags, entry.data_offset, entry.stored_size, entry.uncompressed_size)
+    output += path_table
+    output += bytes(data_start - len(output))
+    output += data
+
+    output_dir = os.path.dirname(output_path)
+    if len(output_dir) > 0:
+        os.makedirs(output_dir, exist_ok=True)
+
+    with open(output_path, "wb") as output_file:
+        output_file.write(output)
+
+#----------------------------------------------------------------------
+# Parses a comma separated list of extensions. Each may optionally
+# have a leading full stop and surrounding whitespace.
+#
+# @param The extension list string.
+#
+# @return The list of lower case extensions with leading full stops.
+#----------------------------------------------------------------------
+def parse_extension_list(extension_list):
+    extensions = []
+    for extension in extension_list.split(","):
+        extension = extension.strip().lower()
+        if len(extension) > 0:
+            extensions.append(extension if extension.startswith(".") else "." + extension)
+    return extensions
+
+#----------------------------------------------------------------------
+# The entry point into the script.
+#
+# @param The list of arguments.
+#----------------------------------------------------------------------
+def main(args):
+    usage = "ERROR: Usage: pack_archive.py <input directory> <output file> [--uncompressedext <ext,...>] [--alignment <bytes>]"
+    if len(args) < 3 or len(args) % 2 == 0 or os.path.isdir(args[1]) == False:
+        print(usage)
+        return 1
+
+    uncompressed_extensions = []
+    alignment = DEFAULT_ALIGNMENT
+    for i in range(3, len(args), 2):
+        if args[i] == "--uncompressedext":
+            uncompressed_extensions = parse_extension_list(args[i + 1])
+        elif args[i] == "--alignment" and args[i + 1].isdigit() and int(args[i + 1]) > 0 and (int(args[i + 1]) & (int(args[i + 1]) - 1)) == 0:
+            alignment = int(args[i + 1])
+        else:
+            print(usage)
+            return 1
+
+    build_archive(args[1], args[2], uncompressed_extensions, alignment)
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))